@@ -0,0 +1,587 @@
+// bonding_failover.cpp - SRT 소켓 그룹(본딩) 무중단 전환 검증 (루프백)
+//
+// 플러그인의 본딩 모드(BondingMode = Broadcast / MainBackup)와 같은 방식으로
+// 송신 그룹이 링크 N개로 수신 리스너(groupconnect=1)에 접속한다. 링크마다 UDP 중계 스레드를 두고
+// 스트리밍 도중 링크 0(백업 모드에서는 가중치가 가장 높은 주 링크)의 중계를 막아서 끊는다.
+// 수신 측은 메시지마다 붙은 일련번호로 빠진 메시지와 도착 간격을 잰다.
+// --restore-at을 주면 막은 중계를 다시 열고, 송신 측이 플러그인처럼 빠진 링크를 다시 추가하는지 본다.
+//
+// 사용법:
+//   bonding_failover [옵션]
+//
+// 옵션:
+//   --mode=broadcast|backup  그룹 종류 (기본 broadcast)
+//   --links=N          링크 수 2~8 (기본 2)
+//   --port=P           수신 리스너 포트, 중계는 P+1..P+N (기본 9100)
+//   --duration=S       전체 송신 시간 (기본 20초)
+//   --break-at=S       링크 0을 끊는 시점 (기본 5초)
+//   --restore-at=S     링크 0을 되살리는 시점, 0이면 안 함 (기본 12초)
+//   --bitrate-kbps=K   송신 속도 (기본 4000, 1316바이트 메시지)
+//   --latency=MS       SRT 레이턴시 (기본 200)
+//   --stable-ms=MS     백업 모드 링크 안정성 타임아웃 SRTO_GROUPMINSTABLETIMEO (기본 60)
+//   --max-gap-ms=MS    허용하는 최대 도착 간격 (기본 100)
+//
+// 판정 (종료 코드 1):
+//   - 빠진 메시지가 있음 (일련번호 누락 = 전환 중 데이터 손실)
+//   - 수신 측 도착 간격이 --max-gap-ms를 넘음 (전환 중 화면 멈춤)
+//   - --restore-at 사용 시 종료 시점에 살아 있는 멤버가 링크 수보다 적음
+// 종료 코드 2: 잘못된 옵션, SRT가 본딩 없이 빌드됨(ENABLE_BONDING=OFF), 초기 연결 실패
+
+#include "srt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using UdpSocket = SOCKET;
+static const UdpSocket kInvalidUdp = INVALID_SOCKET;
+static void CloseUdp(UdpSocket s) { closesocket(s); }
+static int PollUdp(pollfd* fds, int n, int timeout_ms) { return WSAPoll(fds, (ULONG)n, timeout_ms); }
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using UdpSocket = int;
+static const UdpSocket kInvalidUdp = -1;
+static void CloseUdp(UdpSocket s) { close(s); }
+static int PollUdp(pollfd* fds, int n, int timeout_ms) { return poll(fds, (nfds_t)n, timeout_ms); }
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        bool backup = false;
+        int links = 2;
+        int port = 9100;
+        double duration_sec = 20.0;
+        double break_at_sec = 5.0;
+        double restore_at_sec = 12.0;
+        int bitrate_kbps = 4000;
+        int latency_ms = 200;
+        int stable_ms = 60;
+        double max_gap_ms = 100.0;
+    };
+
+    const int kMessageSize = 1316;
+
+    sockaddr_in Loopback(int port)
+    {
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)port);
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return sa;
+    }
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // ===== UDP 중계: 송신 멤버 <-> 중계 포트 <-> 수신 리스너 =====
+    // 링크마다 수신 측으로 나가는 소켓이 따로라 수신 측에서는 서로 다른 경로(멤버)로 보인다.
+    struct Relay
+    {
+        int listen_port = 0;
+        int target_port = 0;
+        std::atomic<bool> blackhole{false};
+        std::atomic<uint64_t> forwarded{0};
+        std::atomic<uint64_t> dropped{0};
+        UdpSocket front = kInvalidUdp;     // 송신 멤버가 보내는 곳
+        UdpSocket back = kInvalidUdp;      // 수신 리스너로 나가는 곳
+
+        bool Open()
+        {
+            front = socket(AF_INET, SOCK_DGRAM, 0);
+            back = socket(AF_INET, SOCK_DGRAM, 0);
+            if (front == kInvalidUdp || back == kInvalidUdp)
+                return false;
+            sockaddr_in local = Loopback(listen_port);
+            if (bind(front, (sockaddr*)&local, sizeof(local)) != 0)
+                return false;
+            sockaddr_in target = Loopback(target_port);
+            return connect(back, (sockaddr*)&target, sizeof(target)) == 0;
+        }
+
+        void Run(std::atomic<bool>& stop)
+        {
+            sockaddr_in peer;
+            memset(&peer, 0, sizeof(peer));
+            bool has_peer = false;
+            char buffer[2048];
+
+            while (!stop.load())
+            {
+                pollfd fds[2];
+                fds[0].fd = front;
+                fds[0].events = POLLIN;
+                fds[0].revents = 0;
+                fds[1].fd = back;
+                fds[1].events = POLLIN;
+                fds[1].revents = 0;
+                if (PollUdp(fds, 2, 50) <= 0)
+                    continue;
+
+                if (fds[0].revents & POLLIN)
+                {
+                    socklen_t len = sizeof(peer);
+                    const int n = (int)recvfrom(front, buffer, sizeof(buffer), 0, (sockaddr*)&peer, &len);
+                    has_peer = n > 0;
+                    if (n > 0 && !blackhole.load())
+                    {
+                        send(back, buffer, n, 0);
+                        forwarded++;
+                    }
+                    else if (n > 0)
+                        dropped++;
+                }
+                if (fds[1].revents & POLLIN)
+                {
+                    const int n = (int)recv(back, buffer, sizeof(buffer), 0);
+                    if (n > 0 && has_peer && !blackhole.load())
+                        sendto(front, buffer, n, 0, (sockaddr*)&peer, sizeof(peer));
+                }
+            }
+        }
+
+        void Close()
+        {
+            if (front != kInvalidUdp) CloseUdp(front);
+            if (back != kInvalidUdp) CloseUdp(back);
+            front = back = kInvalidUdp;
+        }
+    };
+
+    // ===== 수신: groupconnect 리스너가 그룹을 받아 일련번호 검사 =====
+    struct ReceiverResult
+    {
+        bool connected = false;
+        uint64_t messages = 0;
+        uint64_t missing = 0;
+        uint64_t duplicates = 0;
+        double max_gap_ms = 0.0;
+        double max_gap_at_sec = 0.0;
+        std::string error;
+    };
+
+    void SetLiveOptions(SRTSOCKET sock, const Options& opt)
+    {
+        int live = SRTT_LIVE;
+        srt_setsockopt(sock, 0, SRTO_TRANSTYPE, &live, sizeof(live));
+        int messageapi = 1;
+        srt_setsockopt(sock, 0, SRTO_MESSAGEAPI, &messageapi, sizeof(messageapi));
+        int latency = opt.latency_ms;
+        srt_setsockopt(sock, 0, SRTO_LATENCY, &latency, sizeof(latency));
+    }
+
+    void RunReceiver(SRTSOCKET listener, Clock::time_point start, std::atomic<bool>& stop, ReceiverResult& result)
+    {
+        // 그룹 연결이면 srt_accept가 그룹 id를 돌려줌 - 이후 멤버는 라이브러리가 알아서 합류
+        const int eid = srt_epoll_create();
+        const int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+        srt_epoll_add_usock(eid, listener, &events);
+        SRTSOCKET group = SRT_INVALID_SOCK;
+        while (!stop.load() && group == SRT_INVALID_SOCK)
+        {
+            SRT_EPOLL_EVENT ready[1];
+            if (srt_epoll_uwait(eid, ready, 1, 200) <= 0)
+                continue;  // 종료 플래그 확인 주기
+            group = srt_accept(listener, nullptr, nullptr);
+            if (group == SRT_INVALID_SOCK && srt_getlasterror(nullptr) != SRT_EASYNCRCV)
+            {
+                result.error = srt_getlasterror_str();
+                break;
+            }
+        }
+        srt_epoll_release(eid);
+        if (group == SRT_INVALID_SOCK)
+            return;
+        result.connected = true;
+
+        int rcvsyn = 1;  // 리스너의 논블로킹 설정을 물려받으므로 되돌림
+        srt_setsockopt(group, 0, SRTO_RCVSYN, &rcvsyn, sizeof(rcvsyn));
+        int rcvtimeo = 200;  // 종료 플래그 확인 주기
+        srt_setsockopt(group, 0, SRTO_RCVTIMEO, &rcvtimeo, sizeof(rcvtimeo));
+
+        uint64_t expected = 0;
+        bool first = true;
+        Clock::time_point last_arrival;
+        std::vector<char> buffer(kMessageSize);
+        while (!stop.load())
+        {
+            const int received = srt_recvmsg(group, buffer.data(), (int)buffer.size());
+            if (received == SRT_ERROR)
+            {
+                if (srt_getlasterror(nullptr) == SRT_EASYNCRCV)
+                    continue;
+                result.error = srt_getlasterror_str();
+                break;
+            }
+            if (received < 8)
+                continue;
+
+            uint64_t seq = 0;
+            memcpy(&seq, buffer.data(), sizeof(seq));
+            const Clock::time_point now = Clock::now();
+            if (!first)
+            {
+                const double gap_ms = std::chrono::duration<double, std::milli>(now - last_arrival).count();
+                if (gap_ms > result.max_gap_ms)
+                {
+                    result.max_gap_ms = gap_ms;
+                    result.max_gap_at_sec = std::chrono::duration<double>(now - start).count();
+                }
+            }
+            first = false;
+            last_arrival = now;
+
+            if (seq < expected)
+            {
+                result.duplicates++;
+                continue;
+            }
+            result.missing += seq - expected;
+            expected = seq + 1;
+            result.messages++;
+        }
+        srt_close(group);
+    }
+
+    // ===== 송신 그룹 =====
+    bool ConnectLinks(SRTSOCKET group, const Options& opt, const std::vector<int>& indices, bool verbose)
+    {
+        std::vector<SRT_SOCKGROUPCONFIG> targets;
+        for (int index : indices)
+        {
+            sockaddr_in remote = Loopback(opt.port + 1 + index);
+            SRT_SOCKGROUPCONFIG target = srt_prepare_endpoint(nullptr, (sockaddr*)&remote, sizeof(remote));
+            target.weight = opt.backup ? (uint16_t)(opt.links - index) : 0;  // 백업: 링크 0이 주 링크
+            target.token = index;
+            targets.push_back(target);
+        }
+        const int result = srt_connect_group(group, targets.data(), (int)targets.size());
+        if (verbose)
+        {
+            for (const SRT_SOCKGROUPCONFIG& target : targets)
+            {
+                if (target.errorcode != SRT_SUCCESS)
+                    printf("  link %d: %s\n", target.token, srt_strerror(target.errorcode, 0));
+            }
+        }
+        return result != SRT_ERROR;
+    }
+
+    const char* MemberStateName(SRT_MEMBERSTATUS state)
+    {
+        switch (state)
+        {
+            case SRT_GST_PENDING: return "pending";
+            case SRT_GST_IDLE: return "idle";
+            case SRT_GST_RUNNING: return "running";
+            case SRT_GST_BROKEN: return "broken";
+        }
+        return "?";
+    }
+
+    // 토큰(링크 인덱스)별로 살아 있는 멤버 표시
+    std::vector<bool> LiveLinks(SRTSOCKET group, const Options& opt, std::string* description)
+    {
+        std::vector<bool> live(opt.links, false);
+        SRT_SOCKGROUPDATA data[16];
+        size_t count = sizeof(data) / sizeof(data[0]);
+        if (srt_group_data(group, data, &count) == SRT_ERROR)
+            return live;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (data[i].token >= 0 && data[i].token < opt.links && data[i].memberstate != SRT_GST_BROKEN)
+                live[data[i].token] = true;
+            if (description)
+            {
+                char item[64];
+                snprintf(item, sizeof(item), "%s%d:%s", description->empty() ? "" : " ", data[i].token,
+                         MemberStateName(data[i].memberstate));
+                *description += item;
+            }
+        }
+        return live;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: bonding_failover [--mode=broadcast|backup] [--links=N] [--port=P] [--duration=S]"
+                     " [--break-at=S] [--restore-at=S] [--bitrate-kbps=K] [--latency=MS] [--stable-ms=MS]"
+                     " [--max-gap-ms=MS]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--mode=broadcast")
+            opt.backup = false;
+        else if (arg == "--mode=backup")
+            opt.backup = true;
+        else if (arg.rfind("--links=", 0) == 0)
+            opt.links = atoi(arg.c_str() + 8);
+        else if (arg.rfind("--port=", 0) == 0)
+            opt.port = atoi(arg.c_str() + 7);
+        else if (arg.rfind("--duration=", 0) == 0)
+            opt.duration_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--break-at=", 0) == 0)
+            opt.break_at_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--restore-at=", 0) == 0)
+            opt.restore_at_sec = atof(arg.c_str() + 13);
+        else if (arg.rfind("--bitrate-kbps=", 0) == 0)
+            opt.bitrate_kbps = atoi(arg.c_str() + 15);
+        else if (arg.rfind("--latency=", 0) == 0)
+            opt.latency_ms = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--stable-ms=", 0) == 0)
+            opt.stable_ms = atoi(arg.c_str() + 12);
+        else if (arg.rfind("--max-gap-ms=", 0) == 0)
+            opt.max_gap_ms = atof(arg.c_str() + 13);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (opt.links < 2 || opt.links > 8 || opt.bitrate_kbps <= 0 || opt.break_at_sec >= opt.duration_sec
+        || (opt.restore_at_sec > 0.0 && opt.restore_at_sec <= opt.break_at_sec))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    srt_startup();
+
+    // 수신 리스너
+    SRTSOCKET listener = srt_create_socket();
+    SetLiveOptions(listener, opt);
+    int groupconnect = 1;
+    srt_setsockopt(listener, 0, SRTO_GROUPCONNECT, &groupconnect, sizeof(groupconnect));
+    int rcvsyn = 0;  // accept 대기 중에도 종료 확인
+    srt_setsockopt(listener, 0, SRTO_RCVSYN, &rcvsyn, sizeof(rcvsyn));
+    sockaddr_in listen_addr = Loopback(opt.port);
+    if (srt_bind(listener, (sockaddr*)&listen_addr, sizeof(listen_addr)) == SRT_ERROR
+        || srt_listen(listener, opt.links) == SRT_ERROR)
+    {
+        std::cerr << "Listener: " << srt_getlasterror_str() << std::endl;
+        srt_cleanup();
+        return 2;
+    }
+
+    // 중계
+    std::atomic<bool> stop{false};
+    std::vector<Relay> relays(opt.links);
+    std::vector<std::thread> relay_threads;
+    for (int i = 0; i < opt.links; i++)
+    {
+        relays[i].listen_port = opt.port + 1 + i;
+        relays[i].target_port = opt.port;
+        if (!relays[i].Open())
+        {
+            std::cerr << "Relay " << i << ": cannot bind port " << relays[i].listen_port << std::endl;
+            stop = true;
+            for (std::thread& t : relay_threads)
+                t.join();
+            for (Relay& r : relays)
+                r.Close();
+            srt_close(listener);
+            srt_cleanup();
+            return 2;
+        }
+        relay_threads.emplace_back(&Relay::Run, &relays[i], std::ref(stop));
+    }
+
+    const Clock::time_point start = Clock::now();
+    ReceiverResult received;
+    std::atomic<bool> stop_receiver{false};
+    std::thread receiver(RunReceiver, listener, start, std::ref(stop_receiver), std::ref(received));
+
+    // 송신 그룹 - 블로킹 연결은 첫 멤버가 붙으면 반환
+    int exit_code = 0;
+    SRTSOCKET group = srt_create_group(opt.backup ? SRT_GTYPE_BACKUP : SRT_GTYPE_BROADCAST);
+    if (group == SRT_INVALID_SOCK)
+    {
+        std::cerr << "srt_create_group failed (SRT built without ENABLE_BONDING?): " << srt_getlasterror_str() << std::endl;
+        exit_code = 2;
+    }
+    else
+    {
+        SetLiveOptions(group, opt);
+        if (opt.backup)
+        {
+            int stable = opt.stable_ms;
+            srt_setsockopt(group, 0, SRTO_GROUPMINSTABLETIMEO, &stable, sizeof(stable));
+        }
+
+        std::vector<int> all;
+        for (int i = 0; i < opt.links; i++)
+            all.push_back(i);
+        printf("Connecting %d %s links via relays %d..%d -> listener %d\n", opt.links,
+               opt.backup ? "backup" : "broadcast", opt.port + 1, opt.port + opt.links, opt.port);
+        if (!ConnectLinks(group, opt, all, true))
+        {
+            std::cerr << "srt_connect_group failed: " << srt_getlasterror_str() << std::endl;
+            exit_code = 2;
+        }
+    }
+
+    uint64_t sent = 0;
+    int send_errors = 0;
+    std::string final_members;
+    std::vector<bool> final_live;
+    if (exit_code == 0)
+    {
+        // 송신 후 논블로킹 - 재추가가 송신 루프를 막지 않도록 (플러그인 워커와 같음)
+        int sndsyn = 0;
+        srt_setsockopt(group, 0, SRTO_SNDSYN, &sndsyn, sizeof(sndsyn));
+
+        const double interval_sec = kMessageSize * 8.0 / (opt.bitrate_kbps * 1000.0);
+        bool broken = false, restored = false;
+        double next_maintain = 1.0;
+        std::vector<char> message(kMessageSize, 0x47);
+        const Clock::time_point send_start = Clock::now();
+
+        while (true)
+        {
+            const double t = SecondsSince(send_start);
+            if (t >= opt.duration_sec)
+                break;
+
+            if (!broken && t >= opt.break_at_sec)
+            {
+                std::string members;
+                LiveLinks(group, opt, &members);
+                printf("[%6.2fs] break link 0 (members: %s)\n", t, members.c_str());
+                relays[0].blackhole = true;
+                broken = true;
+            }
+            if (!restored && opt.restore_at_sec > 0.0 && t >= opt.restore_at_sec)
+            {
+                std::string members;
+                LiveLinks(group, opt, &members);
+                printf("[%6.2fs] restore link 0 (members: %s)\n", t, members.c_str());
+                relays[0].blackhole = false;
+                restored = true;
+            }
+
+            // 빠진 링크 다시 추가 (플러그인 MaintainGroupLinks와 같은 규칙)
+            if (t >= next_maintain)
+            {
+                next_maintain = t + 1.0;
+                const std::vector<bool> live = LiveLinks(group, opt, nullptr);
+                std::vector<int> missing;
+                for (int i = 0; i < opt.links; i++)
+                {
+                    if (!live[i])
+                        missing.push_back(i);
+                }
+                if (!missing.empty())
+                    ConnectLinks(group, opt, missing, false);
+            }
+
+            memcpy(message.data(), &sent, sizeof(sent));
+            if (srt_sendmsg(group, message.data(), kMessageSize, -1, 0) == SRT_ERROR)
+            {
+                // 논블로킹 송신 버퍼 가득 - 이 메시지는 번호를 소비하지 않으므로 누락으로 안 잡힘
+                if (++send_errors <= 5)
+                    printf("[%6.2fs] send: %s\n", t, srt_getlasterror_str());
+            }
+            else
+            {
+                sent++;
+            }
+
+            const Clock::time_point next = send_start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>((double)(sent + send_errors) * interval_sec));
+            std::this_thread::sleep_until(next);
+        }
+
+        final_live = LiveLinks(group, opt, &final_members);
+
+        // 레이턴시 동안 남은 데이터가 배달되도록
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.latency_ms * 2 + 200));
+    }
+
+    stop_receiver = true;
+    receiver.join();
+    if (group != SRT_INVALID_SOCK)
+        srt_close(group);
+    srt_close(listener);
+    stop = true;
+    for (std::thread& t : relay_threads)
+        t.join();
+    for (Relay& r : relays)
+        r.Close();
+    srt_cleanup();
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+
+    if (exit_code != 0)
+        return exit_code;
+
+    // 결과
+    printf("\n%-6s %12s %12s\n", "relay", "forwarded", "dropped");
+    for (int i = 0; i < opt.links; i++)
+    {
+        printf("%-6d %12llu %12llu\n", i, (unsigned long long)relays[i].forwarded.load(),
+               (unsigned long long)relays[i].dropped.load());
+    }
+    printf("\nSent %llu messages (%d send errors), received %llu, missing %llu, duplicates %llu\n",
+           (unsigned long long)sent, send_errors, (unsigned long long)received.messages,
+           (unsigned long long)received.missing, (unsigned long long)received.duplicates);
+    printf("Max arrival gap %.1f ms at %.2fs (limit %.0f ms)\n", received.max_gap_ms, received.max_gap_at_sec, opt.max_gap_ms);
+    printf("Members at end: %s\n", final_members.c_str());
+
+    bool ok = true;
+    if (!received.connected || received.messages == 0)
+    {
+        printf("Receiver got no data (%s): %s\n", received.connected ? "group accepted" : "no group accepted",
+               received.error.c_str());
+        ok = false;
+    }
+    // 끝부분은 송신과 수신 종료 시점 차이로 덜 받을 수 있으므로 누락은 일련번호 구멍만 본다
+    if (received.missing > 0)
+        ok = false;
+    if (received.max_gap_ms > opt.max_gap_ms)
+        ok = false;
+    if (opt.restore_at_sec > 0.0 && std::count(final_live.begin(), final_live.end(), true) < opt.links)
+    {
+        printf("Link 0 was not re-added after restore\n");
+        ok = false;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
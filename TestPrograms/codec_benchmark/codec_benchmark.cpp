@@ -0,0 +1,322 @@
+// codec_benchmark.cpp - H.264 vs HEVC 비트 효율 비교
+//
+// 같은 캡처 시퀀스를 플러그인과 동일한 저지연 설정(B프레임 없음, 고정 GOP, zerolatency)으로
+// libx264 / libx265에 여러 CRF로 인코딩하고, 프레임당 비트와 PSNR/SSIM을 측정한 뒤
+// 같은 화질에서의 비트레이트 차이(Bjontegaard delta rate)를 출력한다.
+//
+// 사용법:
+//   codec_benchmark [옵션] <capture>       (ffmpeg가 읽을 수 있는 모든 입력: .y4m, .ts, .mp4 ...)
+//
+// 옵션:
+//   --frames=N      앞에서 N프레임만 사용 (기본 300)
+//   --gop=N         키프레임 간격 (기본 60, 플러그인 기본값)
+//   --preset=P      x264/x265 프리셋 (기본 veryfast)
+//   --crf=a,b,c,d   측정할 CRF 목록 (기본 20,24,28,32 - BD-rate에는 4개 이상 필요)
+//   --ffmpeg=PATH   ffmpeg 실행 파일 (기본: PATH의 ffmpeg)
+//   --keep          중간 결과 파일 보존
+//
+// ffmpeg 실행 파일이 필요하다 (libx264, libx265 포함 빌드).
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#define NULL_OUTPUT "NUL"
+#else
+#define NULL_OUTPUT "/dev/null"
+#endif
+
+namespace
+{
+    struct Options
+    {
+        std::string input;
+        std::string ffmpeg = "ffmpeg";
+        std::string preset = "veryfast";
+        int frames = 300;
+        int gop = 60;
+        std::vector<int> crfs = {20, 24, 28, 32};
+        bool keep = false;
+    };
+
+    struct RatePoint
+    {
+        int crf = 0;
+        double bits_per_frame = 0.0;
+        double psnr = 0.0;   // Y/U/V 평균 (dB)
+        double ssim = 0.0;   // All
+    };
+
+    struct Codec
+    {
+        const char* label;
+        const char* encoder;
+        const char* muxer;       // 원시 ES로 저장 (TS 오버헤드 제외)
+        const char* extension;
+        const char* params_flag;
+        const char* params;      // 플러그인 SetupCodecContext와 같은 저지연 옵션
+    };
+
+    const Codec Codecs[] = {
+        {"H.264", "libx264", "h264", "264", "-x264opts", "keyint=%d:min-keyint=%d:scenecut=0:bframes=0"},
+        {"HEVC", "libx265", "hevc", "265", "-x265-params",
+         "keyint=%d:min-keyint=%d:scenecut=0:bframes=0:rc-lookahead=0:repeat-headers=1:aud=1:log-level=error"},
+    };
+
+    // 명령 실행 후 stdout+stderr 전체를 반환
+    bool Run(const std::string& command, std::string& output)
+    {
+        FILE* pipe = popen((command + " 2>&1").c_str(), "r");
+        if (!pipe)
+            return false;
+
+        char buffer[4096];
+        output.clear();
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+            output.append(buffer, n);
+        return pclose(pipe) == 0;
+    }
+
+    long long FileSize(const std::string& path)
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+            return -1;
+        fseek(file, 0, SEEK_END);
+        const long long size = ftell(file);
+        fclose(file);
+        return size;
+    }
+
+    // ffmpeg 필터 로그에서 "key:값" 추출 (마지막 출현)
+    bool ParseValue(const std::string& log, const char* key, double& out)
+    {
+        const size_t pos = log.rfind(key);
+        if (pos == std::string::npos)
+            return false;
+        const char* p = log.c_str() + pos + strlen(key);
+        if (strncmp(p, "inf", 3) == 0)
+        {
+            out = 100.0;  // 무손실 구간
+            return true;
+        }
+        char* end = nullptr;
+        out = strtod(p, &end);
+        return end != p;
+    }
+
+    bool Measure(const Options& opt, const Codec& codec, int crf, RatePoint& point)
+    {
+        char params[256];
+        snprintf(params, sizeof(params), codec.params, opt.gop, opt.gop);
+
+        const std::string output = "bench_" + std::string(codec.encoder) + "_crf" + std::to_string(crf) + "." + codec.extension;
+        std::ostringstream encode;
+        encode << "\"" << opt.ffmpeg << "\" -hide_banner -y -i \"" << opt.input << "\" -frames:v " << opt.frames
+               << " -an -pix_fmt yuv420p -c:v " << codec.encoder << " -preset " << opt.preset
+               << " -tune zerolatency -crf " << crf << " -g " << opt.gop << " -bf 0 "
+               << codec.params_flag << " " << params << " -f " << codec.muxer << " \"" << output << "\"";
+
+        std::string log;
+        if (!Run(encode.str(), log))
+        {
+            std::cerr << "Encode failed (" << codec.encoder << ", crf " << crf << "):\n" << log << std::endl;
+            return false;
+        }
+
+        const long long bytes = FileSize(output);
+        if (bytes <= 0)
+            return false;
+        point.crf = crf;
+        point.bits_per_frame = bytes * 8.0 / opt.frames;
+
+        // 디코딩 결과와 원본 비교 (같은 프레임 수)
+        std::ostringstream compare;
+        compare << "\"" << opt.ffmpeg << "\" -hide_banner -i \"" << output << "\" -i \"" << opt.input << "\""
+                << " -frames:v " << opt.frames
+                << " -lavfi \"[0:v]format=yuv420p,split[d0][d1];[1:v]format=yuv420p,split[r0][r1];"
+                << "[d0][r0]psnr;[d1][r1]ssim\" -f null " << NULL_OUTPUT;
+
+        if (!Run(compare.str(), log) ||
+            !ParseValue(log, "average:", point.psnr) ||
+            !ParseValue(log, "All:", point.ssim))
+        {
+            std::cerr << "Quality measurement failed (" << codec.encoder << ", crf " << crf << "):\n" << log << std::endl;
+            return false;
+        }
+
+        if (!opt.keep)
+            remove(output.c_str());
+        return true;
+    }
+
+    // 최소제곱 3차 다항식 (x → y), 정규방정식 가우스 소거
+    bool FitCubic(const std::vector<double>& x, const std::vector<double>& y, double coeff[4])
+    {
+        double a[4][5] = {};
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            double powers[7] = {1.0};
+            for (int k = 1; k < 7; k++)
+                powers[k] = powers[k - 1] * x[i];
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = 0; c < 4; c++)
+                    a[r][c] += powers[r + c];
+                a[r][4] += powers[r] * y[i];
+            }
+        }
+
+        for (int col = 0; col < 4; col++)
+        {
+            int pivot = col;
+            for (int r = col + 1; r < 4; r++)
+                if (std::fabs(a[r][col]) > std::fabs(a[pivot][col]))
+                    pivot = r;
+            if (std::fabs(a[pivot][col]) < 1e-12)
+                return false;
+            for (int c = 0; c < 5; c++)
+                std::swap(a[col][c], a[pivot][c]);
+            for (int r = 0; r < 4; r++)
+            {
+                if (r == col)
+                    continue;
+                const double f = a[r][col] / a[col][col];
+                for (int c = col; c < 5; c++)
+                    a[r][c] -= f * a[col][c];
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+            coeff[i] = a[i][4] / a[i][i];
+        return true;
+    }
+
+    double IntegrateCubic(const double c[4], double lo, double hi)
+    {
+        auto antiderivative = [c](double x)
+        {
+            return c[0] * x + c[1] * x * x / 2 + c[2] * x * x * x / 3 + c[3] * x * x * x * x / 4;
+        };
+        return antiderivative(hi) - antiderivative(lo);
+    }
+
+    // Bjontegaard delta rate: 같은 화질에서 test가 anchor 대비 몇 % 비트를 쓰는지 (음수 = 절약)
+    bool BDRate(const std::vector<RatePoint>& anchor, const std::vector<RatePoint>& test,
+                double RatePoint::*quality, double& out_percent)
+    {
+        if (anchor.size() < 4 || test.size() < 4)
+            return false;
+
+        std::vector<double> qa, ra, qt, rt;
+        for (const RatePoint& p : anchor)
+        {
+            qa.push_back(p.*quality);
+            ra.push_back(std::log(p.bits_per_frame));
+        }
+        for (const RatePoint& p : test)
+        {
+            qt.push_back(p.*quality);
+            rt.push_back(std::log(p.bits_per_frame));
+        }
+
+        double ca[4], ct[4];
+        if (!FitCubic(qa, ra, ca) || !FitCubic(qt, rt, ct))
+            return false;
+
+        auto min_of = [](const std::vector<double>& v) { double m = v[0]; for (double d : v) m = d < m ? d : m; return m; };
+        auto max_of = [](const std::vector<double>& v) { double m = v[0]; for (double d : v) m = d > m ? d : m; return m; };
+        const double lo = std::fmax(min_of(qa), min_of(qt));
+        const double hi = std::fmin(max_of(qa), max_of(qt));
+        if (hi <= lo)
+            return false;  // 화질 구간이 겹치지 않음 - CRF 범위를 넓혀야 함
+
+        const double avg_diff = (IntegrateCubic(ct, lo, hi) - IntegrateCubic(ca, lo, hi)) / (hi - lo);
+        out_percent = (std::exp(avg_diff) - 1.0) * 100.0;
+        return true;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: codec_benchmark [--frames=N] [--gop=N] [--preset=P] [--crf=a,b,c,d] [--ffmpeg=PATH] [--keep] <capture>" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--frames=", 0) == 0)
+            opt.frames = atoi(arg.c_str() + 9);
+        else if (arg.rfind("--gop=", 0) == 0)
+            opt.gop = atoi(arg.c_str() + 6);
+        else if (arg.rfind("--preset=", 0) == 0)
+            opt.preset = arg.substr(9);
+        else if (arg.rfind("--ffmpeg=", 0) == 0)
+            opt.ffmpeg = arg.substr(9);
+        else if (arg.rfind("--crf=", 0) == 0)
+        {
+            opt.crfs.clear();
+            std::stringstream list(arg.substr(6));
+            std::string item;
+            while (std::getline(list, item, ','))
+                opt.crfs.push_back(atoi(item.c_str()));
+        }
+        else if (arg == "--keep")
+            opt.keep = true;
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+            opt.input = arg;
+    }
+
+    if (opt.input.empty() || opt.frames <= 0 || opt.crfs.empty())
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<RatePoint> results[2];
+    for (int c = 0; c < 2; c++)
+    {
+        for (int crf : opt.crfs)
+        {
+            RatePoint point;
+            if (!Measure(opt, Codecs[c], crf, point))
+                return 1;
+            results[c].push_back(point);
+
+            char line[160];
+            snprintf(line, sizeof(line), "%-6s crf %2d  %10.0f bits/frame  PSNR %6.2f dB  SSIM %.5f\n",
+                Codecs[c].label, crf, point.bits_per_frame, point.psnr, point.ssim);
+            std::cout << line << std::flush;
+        }
+    }
+
+    std::cout << "\nHEVC vs H.264 (" << opt.frames << " frames, preset " << opt.preset << ", GOP " << opt.gop << ")\n";
+    double delta = 0.0;
+    if (BDRate(results[0], results[1], &RatePoint::psnr, delta))
+        printf("  BD-rate @ equal PSNR: %+.1f %%\n", delta);
+    else
+        printf("  BD-rate @ equal PSNR: n/a (need >= 4 overlapping points)\n");
+    if (BDRate(results[0], results[1], &RatePoint::ssim, delta))
+        printf("  BD-rate @ equal SSIM: %+.1f %%\n", delta);
+    else
+        printf("  BD-rate @ equal SSIM: n/a (need >= 4 overlapping points)\n");
+
+    return 0;
+}
@@ -0,0 +1,316 @@
+// crypto_benchmark.cpp - SRT 패킷 암호화 비용 측정 (AES-CTR / AES-GCM)
+//
+// 번들 SRT의 OpenSSL EVP cryspr와 같은 방식으로 1316바이트 페이로드를 패킷 단위로 암호화해서
+// 목표 비트레이트(기본 50 Mbps)에서 송신 스레드가 암호화에 쓰는 CPU 비율을 계산한다.
+//
+//   cached      - 키 설정된 EVP 컨텍스트 하나를 재사용, 패킷마다 IV만 교체 (SRT가 실제로 하는 방식)
+//   per-packet  - 패킷마다 컨텍스트 생성 + 키 확장 (컨텍스트를 캐시하지 않았을 때의 비용, 비교용)
+//   PBKDF2      - 비밀번호 → 키 유도 (연결/재연결/리스너 구독자마다 한 번)
+//
+// 사용법:
+//   crypto_benchmark [옵션]
+//
+// 옵션:
+//   --bitrate=MBPS  목표 송신 비트레이트 (기본 50)
+//   --seconds=S     케이스당 측정 시간 - 목표 비트레이트로 S초 분량의 패킷을 최대 속도로 처리 (기본 5)
+//   --budget=PCT    cached 암호화가 목표 비트레이트에서 쓸 수 있는 한 코어 대비 CPU % (기본 5)
+//
+// 판정 (종료 코드 1):
+//   - 암호화 → 복호화 결과가 원문과 다름, 또는 GCM 태그 검증 실패
+//   - cached 케이스 중 하나라도 예산 초과
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int PAYLOAD_SIZE = 1316;      // TS 7개 = SRT 라이브 메시지 하나
+    constexpr int SRT_HEADER_SIZE = 16;     // GCM에서 AAD로 인증되는 SRT 헤더
+    constexpr int GCM_TAG_SIZE = 16;
+    constexpr int PBKDF2_ITERATIONS = 2048; // SRT haicrypt 기본값
+    constexpr int SALT_SIZE = 16;
+
+    struct Options
+    {
+        double bitrate_mbps = 50.0;
+        double seconds = 5.0;
+        double budget_percent = 5.0;
+    };
+
+    struct CipherCase
+    {
+        const char* name;
+        bool gcm;
+        int key_len;
+    };
+
+    const EVP_CIPHER* GetCipher(bool gcm, int keyLen)
+    {
+        switch (keyLen)
+        {
+            case 16: return gcm ? EVP_aes_128_gcm() : EVP_aes_128_ctr();
+            case 24: return gcm ? EVP_aes_192_gcm() : EVP_aes_192_ctr();
+            case 32: return gcm ? EVP_aes_256_gcm() : EVP_aes_256_ctr();
+            default: return nullptr;
+        }
+    }
+
+    // SRT와 같은 IV 구성: salt에 패킷 인덱스를 XOR (CTR 16바이트 - 마지막 2바이트는 블록 카운터, GCM 12바이트)
+    void MakeIV(const uint8_t* salt, uint32_t pki, bool gcm, uint8_t* iv)
+    {
+        const int ivLen = gcm ? 12 : 16;
+        memcpy(iv, salt, ivLen);
+        const int pos = gcm ? 8 : 10;
+        iv[pos + 0] ^= (uint8_t)(pki >> 24);
+        iv[pos + 1] ^= (uint8_t)(pki >> 16);
+        iv[pos + 2] ^= (uint8_t)(pki >> 8);
+        iv[pos + 3] ^= (uint8_t)pki;
+        if (!gcm)
+        {
+            iv[14] = 0;
+            iv[15] = 0;
+        }
+    }
+
+    // 키 확장이 끝난 컨텍스트를 들고 있다가 패킷마다 IV만 바꿔서 재사용
+    class PacketCipher
+    {
+    public:
+        ~PacketCipher()
+        {
+            if (ctx_)
+                EVP_CIPHER_CTX_free(ctx_);
+        }
+
+        bool Init(bool gcm, int keyLen, const uint8_t* key, const uint8_t* salt, bool encrypt)
+        {
+            gcm_ = gcm;
+            encrypt_ = encrypt;
+            memcpy(salt_, salt, SALT_SIZE);
+            ctx_ = EVP_CIPHER_CTX_new();
+            if (!ctx_)
+                return false;
+            return EVP_CipherInit_ex(ctx_, GetCipher(gcm, keyLen), nullptr, key, nullptr, encrypt ? 1 : 0) == 1;
+        }
+
+        // GCM: tag는 암호화면 출력, 복호화면 검증할 값
+        bool Process(uint32_t pki, const uint8_t* header, const uint8_t* in, int len, uint8_t* out, uint8_t* tag)
+        {
+            uint8_t iv[16];
+            MakeIV(salt_, pki, gcm_, iv);
+            if (EVP_CipherInit_ex(ctx_, nullptr, nullptr, nullptr, iv, -1) != 1)
+                return false;
+
+            int outLen = 0;
+            if (gcm_ && EVP_CipherUpdate(ctx_, nullptr, &outLen, header, SRT_HEADER_SIZE) != 1)
+                return false;
+            if (EVP_CipherUpdate(ctx_, out, &outLen, in, len) != 1)
+                return false;
+
+            if (gcm_ && !encrypt_ && EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, tag) != 1)
+                return false;
+
+            int finalLen = 0;
+            if (EVP_CipherFinal_ex(ctx_, out + outLen, &finalLen) != 1)
+                return false;  // GCM 복호화면 태그 불일치
+
+            if (gcm_ && encrypt_ && EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, tag) != 1)
+                return false;
+            return true;
+        }
+
+    private:
+        EVP_CIPHER_CTX* ctx_ = nullptr;
+        bool gcm_ = false;
+        bool encrypt_ = true;
+        uint8_t salt_[SALT_SIZE] = {0};
+    };
+
+    // 캐시하지 않는 경우: 패킷마다 컨텍스트 생성, 키 확장, 해제
+    bool EncryptUncached(bool gcm, int keyLen, const uint8_t* key, const uint8_t* salt, uint32_t pki,
+                         const uint8_t* header, const uint8_t* in, int len, uint8_t* out, uint8_t* tag)
+    {
+        PacketCipher cipher;
+        return cipher.Init(gcm, keyLen, key, salt, true) && cipher.Process(pki, header, in, len, out, tag);
+    }
+
+    struct CaseResult
+    {
+        double ns_per_packet = 0.0;
+        double cpu_percent = 0.0;      // 목표 비트레이트에서 한 코어 대비
+        double max_mbps = 0.0;         // 한 코어로 암호화할 수 있는 최대 페이로드 속도
+    };
+
+    CaseResult ToResult(double seconds, uint64_t packets, double packetsPerSecond)
+    {
+        CaseResult r;
+        r.ns_per_packet = seconds * 1e9 / (double)packets;
+        r.cpu_percent = r.ns_per_packet * packetsPerSecond / 1e9 * 100.0;
+        r.max_mbps = (double)packets * PAYLOAD_SIZE * 8.0 / seconds / 1e6;
+        return r;
+    }
+
+    double Elapsed(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 암호화 → 복호화 왕복 (GCM은 태그 검증, 변조한 패킷은 거부되어야 함)
+    bool VerifyRoundTrip(const CipherCase& c, const uint8_t* key, const uint8_t* salt,
+                         const uint8_t* header, const std::vector<uint8_t>& plain)
+    {
+        PacketCipher enc, dec;
+        if (!enc.Init(c.gcm, c.key_len, key, salt, true) || !dec.Init(c.gcm, c.key_len, key, salt, false))
+            return false;
+
+        std::vector<uint8_t> cipherText(PAYLOAD_SIZE), decoded(PAYLOAD_SIZE);
+        uint8_t tag[GCM_TAG_SIZE] = {0};
+        const uint32_t pki = 12345;
+        if (!enc.Process(pki, header, plain.data(), PAYLOAD_SIZE, cipherText.data(), tag))
+            return false;
+        if (!dec.Process(pki, header, cipherText.data(), PAYLOAD_SIZE, decoded.data(), tag))
+            return false;
+        if (memcmp(decoded.data(), plain.data(), PAYLOAD_SIZE) != 0)
+            return false;
+
+        if (c.gcm)
+        {
+            cipherText[100] ^= 0x01;
+            if (dec.Process(pki, header, cipherText.data(), PAYLOAD_SIZE, decoded.data(), tag))
+                return false;  // 변조를 못 잡음
+        }
+        return true;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: crypto_benchmark [--bitrate=MBPS] [--seconds=S] [--budget=PCT]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--bitrate=", 0) == 0)
+            opt.bitrate_mbps = atof(arg.c_str() + 10);
+        else if (arg.rfind("--seconds=", 0) == 0)
+            opt.seconds = atof(arg.c_str() + 10);
+        else if (arg.rfind("--budget=", 0) == 0)
+            opt.budget_percent = atof(arg.c_str() + 9);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (opt.bitrate_mbps <= 0.0 || opt.seconds <= 0.0 || opt.budget_percent <= 0.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    const double packetsPerSecond = opt.bitrate_mbps * 1e6 / 8.0 / PAYLOAD_SIZE;
+    const uint64_t packets = (uint64_t)(packetsPerSecond * opt.seconds) + 1;
+
+    printf("OpenSSL: %s\n", OpenSSL_version(OPENSSL_VERSION));
+    printf("Target: %.1f Mbps = %.0f packets/s x %d bytes, %llu packets per case, budget %.1f%% of one core\n\n",
+        opt.bitrate_mbps, packetsPerSecond, PAYLOAD_SIZE, (unsigned long long)packets, opt.budget_percent);
+
+    uint8_t key[32], salt[SALT_SIZE], header[SRT_HEADER_SIZE];
+    std::vector<uint8_t> plain(PAYLOAD_SIZE), out(PAYLOAD_SIZE);
+    RAND_bytes(key, sizeof(key));
+    RAND_bytes(salt, sizeof(salt));
+    RAND_bytes(header, sizeof(header));
+    RAND_bytes(plain.data(), PAYLOAD_SIZE);
+
+    const CipherCase cases[] = {
+        {"AES-128-CTR", false, 16},
+        {"AES-192-CTR", false, 24},
+        {"AES-256-CTR", false, 32},
+        {"AES-128-GCM", true, 16},
+        {"AES-192-GCM", true, 24},
+        {"AES-256-GCM", true, 32},
+    };
+
+    bool ok = true;
+    printf("%-12s %-11s %10s %9s %11s %s\n", "cipher", "context", "ns/pkt", "cpu%", "max Mbps", "");
+    for (const CipherCase& c : cases)
+    {
+        if (!VerifyRoundTrip(c, key, salt, header, plain))
+        {
+            printf("%-12s round trip FAILED\n", c.name);
+            ok = false;
+            continue;
+        }
+
+        uint8_t tag[GCM_TAG_SIZE];
+
+        // cached - 송신 스레드가 실제로 지불하는 비용
+        PacketCipher cipher;
+        if (!cipher.Init(c.gcm, c.key_len, key, salt, true))
+        {
+            printf("%-12s init FAILED\n", c.name);
+            ok = false;
+            continue;
+        }
+        for (uint32_t pki = 0; pki < 1000; pki++)
+            cipher.Process(pki, header, plain.data(), PAYLOAD_SIZE, out.data(), tag);  // 워밍업
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t n = 0; n < packets; n++)
+            cipher.Process((uint32_t)n, header, plain.data(), PAYLOAD_SIZE, out.data(), tag);
+        const CaseResult cached = ToResult(Elapsed(start), packets, packetsPerSecond);
+
+        const bool withinBudget = cached.cpu_percent <= opt.budget_percent;
+        if (!withinBudget)
+            ok = false;
+        printf("%-12s %-11s %10.0f %8.2f%% %11.0f %s\n", c.name, "cached",
+            cached.ns_per_packet, cached.cpu_percent, cached.max_mbps, withinBudget ? "" : "OVER BUDGET");
+
+        // per-packet - 비교용 (판정에 포함하지 않음)
+        start = std::chrono::steady_clock::now();
+        for (uint64_t n = 0; n < packets; n++)
+            EncryptUncached(c.gcm, c.key_len, key, salt, (uint32_t)n, header, plain.data(), PAYLOAD_SIZE, out.data(), tag);
+        const CaseResult uncached = ToResult(Elapsed(start), packets, packetsPerSecond);
+        printf("%-12s %-11s %10.0f %8.2f%% %11.0f (x%.1f)\n", c.name, "per-packet",
+            uncached.ns_per_packet, uncached.cpu_percent, uncached.max_mbps,
+            uncached.ns_per_packet / cached.ns_per_packet);
+    }
+
+    // 연결마다 한 번 - 재연결 지연과 리스너 모드 구독자 수락 비용
+    {
+        const char* passphrase = "benchmark-passphrase";
+        uint8_t derived[32];
+        const int iterations = 50;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            PKCS5_PBKDF2_HMAC_SHA1(passphrase, (int)strlen(passphrase), salt, 8, PBKDF2_ITERATIONS,
+                                   (int)sizeof(derived), derived);
+        }
+        printf("\nPBKDF2-SHA1 x%d (key derivation per connection): %.3f ms\n",
+            PBKDF2_ITERATIONS, Elapsed(start) * 1000.0 / iterations);
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+// listener_fanout.cpp - 리스너 모드 팬아웃 검증 (수신기 여러 개 동시 접속)
+//
+// 리스너 모드(ConnectionMode = Listener)로 스트리밍 중인 언리얼 인스턴스에
+// 수신기 N개를 동시에 caller로 접속시키고, 각 수신기가 받은 TS를 ts_analyzer로 검사한다.
+// 일부 수신기를 일부러 느리게 읽게 해서(--slow) 느린 구독자가 다른 구독자를 막지 않는지 확인한다.
+//
+// 사용법:
+//   listener_fanout [옵션] <host> <port>
+//
+// 옵션:
+//   --receivers=N   동시 수신기 수 (기본 16)
+//   --slow=K        그중 느린 수신기 수 (기본 0) - 메시지마다 --slow-delay-ms만큼 대기
+//   --slow-delay-ms=M  느린 수신기의 메시지당 대기 (기본 20)
+//   --duration=S    수신 시간 (기본 10초)
+//   --latency=MS    SRT 레이턴시 (기본 120)
+//
+// 판정 (종료 코드 1):
+//   - 정상 수신기 중 데이터를 못 받은 것이 있음
+//   - 정상 수신기에 1순위 에러(동기 손실, CC 에러, PAT/PMT 누락)가 있음
+//   - 정상 수신기끼리 받은 바이트가 10% 이상 차이남 (한 인코딩을 똑같이 받아야 함)
+// 느린 수신기는 키프레임 재동기화로 CC 에러가 생기는 것이 정상이라 통계만 출력한다.
+
+#include "ts_analyzer.h"
+#include "srt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#endif
+
+namespace
+{
+    struct Options
+    {
+        std::string host;
+        int port = 0;
+        int receivers = 16;
+        int slow = 0;
+        int slow_delay_ms = 20;
+        double duration_sec = 10.0;
+        int latency_ms = 120;
+    };
+
+    struct ReceiverResult
+    {
+        bool connected = false;
+        bool slow = false;
+        uint64_t bytes = 0;
+        uint64_t messages = 0;
+        double first_data_ms = -1.0;   // 접속 후 첫 데이터까지 (IDR 대기 포함)
+        ts::Report report;
+        std::string error;
+    };
+
+    void RunReceiver(const Options& opt, bool slow, std::atomic<bool>& stop, ReceiverResult& result)
+    {
+        result.slow = slow;
+
+        SRTSOCKET sock = srt_create_socket();
+        int live = SRTT_LIVE;
+        srt_setsockopt(sock, 0, SRTO_TRANSTYPE, &live, sizeof(live));
+        int messageapi = 1;  // 송신 측과 동일 - 수신 한 번에 1316바이트 메시지 하나
+        srt_setsockopt(sock, 0, SRTO_MESSAGEAPI, &messageapi, sizeof(messageapi));
+        int latency = opt.latency_ms;
+        srt_setsockopt(sock, 0, SRTO_LATENCY, &latency, sizeof(latency));
+        int rcvtimeo = 200;  // 종료 플래그 확인 주기
+        srt_setsockopt(sock, 0, SRTO_RCVTIMEO, &rcvtimeo, sizeof(rcvtimeo));
+
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)opt.port);
+        if (inet_pton(AF_INET, opt.host.c_str(), &sa.sin_addr) != 1)
+        {
+            result.error = "invalid host";
+            srt_close(sock);
+            return;
+        }
+
+        if (srt_connect(sock, (sockaddr*)&sa, sizeof(sa)) == SRT_ERROR)
+        {
+            result.error = srt_getlasterror_str();
+            srt_close(sock);
+            return;
+        }
+        result.connected = true;
+
+        ts::Analyzer analyzer;
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<char> buffer(1316);
+        while (!stop.load())
+        {
+            const int received = srt_recvmsg(sock, buffer.data(), (int)buffer.size());
+            if (received == SRT_ERROR)
+            {
+                if (srt_getlasterror(nullptr) == SRT_EASYNCRCV)
+                    continue;  // 타임아웃
+                result.error = srt_getlasterror_str();
+                break;
+            }
+            if (received == 0)
+                continue;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (result.first_data_ms < 0.0)
+                result.first_data_ms = std::chrono::duration<double, std::milli>(now - start).count();
+
+            const int64_t arrival = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count() * 27 / 1000;
+            analyzer.Feed((const uint8_t*)buffer.data(), (size_t)received, arrival);
+            result.bytes += (uint64_t)received;
+            result.messages++;
+
+            if (slow)
+                std::this_thread::sleep_for(std::chrono::milliseconds(opt.slow_delay_ms));
+        }
+
+        result.report = analyzer.Finish();
+        srt_close(sock);
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: listener_fanout [--receivers=N] [--slow=K] [--slow-delay-ms=M] [--duration=S] [--latency=MS] <host> <port>" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--receivers=", 0) == 0)
+            opt.receivers = atoi(arg.c_str() + 12);
+        else if (arg.rfind("--slow=", 0) == 0)
+            opt.slow = atoi(arg.c_str() + 7);
+        else if (arg.rfind("--slow-delay-ms=", 0) == 0)
+            opt.slow_delay_ms = atoi(arg.c_str() + 16);
+        else if (arg.rfind("--duration=", 0) == 0)
+            opt.duration_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--latency=", 0) == 0)
+            opt.latency_ms = atoi(arg.c_str() + 10);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+            positional.push_back(arg);
+    }
+
+    if (positional.size() != 2 || opt.receivers <= 0 || opt.slow < 0 || opt.slow >= opt.receivers)
+    {
+        PrintUsage();
+        return 2;
+    }
+    opt.host = positional[0];
+    opt.port = atoi(positional[1].c_str());
+
+    srt_startup();
+
+    std::atomic<bool> stop{false};
+    std::vector<ReceiverResult> results(opt.receivers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < opt.receivers; i++)
+    {
+        // 느린 수신기는 뒤쪽 번호 - 정상 수신기보다 늦게 붙는 것과 무관하게 판정
+        const bool slow = i >= opt.receivers - opt.slow;
+        threads.emplace_back(RunReceiver, std::cref(opt), slow, std::ref(stop), std::ref(results[i]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(opt.duration_sec));
+    stop = true;
+    for (std::thread& t : threads)
+        t.join();
+
+    srt_cleanup();
+
+    // 결과
+    bool ok = true;
+    uint64_t min_bytes = UINT64_MAX, max_bytes = 0;
+    printf("%-4s %-5s %12s %9s %10s %8s %8s %s\n", "#", "kind", "bytes", "kbps", "first(ms)", "P1", "CC", "error");
+    for (int i = 0; i < opt.receivers; i++)
+    {
+        const ReceiverResult& r = results[i];
+        const double kbps = r.report.duration_sec > 0.0 ? r.report.total_bitrate_kbps : 0.0;
+        printf("%-4d %-5s %12llu %9.0f %10.0f %8llu %8llu %s\n", i, r.slow ? "slow" : "fast",
+            (unsigned long long)r.bytes, kbps, r.first_data_ms,
+            (unsigned long long)r.report.errors.Priority1(),
+            (unsigned long long)r.report.errors.continuity_count_error,
+            r.error.c_str());
+
+        if (r.slow)
+            continue;
+
+        if (!r.connected || r.bytes == 0)
+        {
+            ok = false;
+            continue;
+        }
+        if (r.report.errors.Priority1() > 0)
+            ok = false;
+        min_bytes = std::min(min_bytes, r.bytes);
+        max_bytes = std::max(max_bytes, r.bytes);
+    }
+
+    // 정상 수신기는 같은 인코딩을 받으므로 접속 시점 차이(첫 IDR 대기) 정도만 차이나야 함
+    if (max_bytes > 0 && min_bytes != UINT64_MAX && (double)(max_bytes - min_bytes) > max_bytes * 0.1)
+    {
+        printf("\nFast receivers diverged: min %llu, max %llu bytes\n",
+            (unsigned long long)min_bytes, (unsigned long long)max_bytes);
+        ok = false;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
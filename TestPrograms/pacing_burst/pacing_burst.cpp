@@ -0,0 +1,652 @@
+// pacing_burst.cpp - 송신 페이싱 유무에 따른 순간 폭주(microburst) 크기 비교 (루프백)
+//
+// 플러그인 워커처럼 인코딩된 프레임 하나를 1316바이트 메시지로 나눠 보낸다. 프레임 크기는
+// GOP마다 I-프레임 하나가 P-프레임의 --iframe-factor배이고 평균은 --bitrate-kbps에 맞춘다.
+// 같은 스트림을 두 번 보낸다:
+//   unpaced - 플러그인 기본 동작. 프레임의 청크를 한꺼번에 보내고 SRT 송신 속도 상한도 기본값
+//   paced   - 플러그인 bEnablePacing과 같은 토큰 버킷으로 프레임을 창(프레임 간격 x --window) 안에 나눠 보내고
+//             SRTO_MAXBW=0, SRTO_INPUTBW=최고 속도, SRTO_OHEADBW=25 설정
+// 송신과 수신 리스너 사이의 UDP 중계가 SRT 데이터 패킷(재전송 포함) 도착 시각을 기록하고
+// --bin-us 구간마다 몇 개가 지나갔는지로 버스트 크기 분포를 구한다.
+//
+// 사용법:
+//   pacing_burst [옵션]
+//
+// 옵션:
+//   --port=P           수신 리스너 포트, 중계는 P+1(unpaced), P+2(paced) (기본 9200)
+//   --duration=S       단계별 송신 시간 (기본 5초)
+//   --fps=F            프레임 속도 (기본 30)
+//   --bitrate-kbps=K   평균 비트레이트 (기본 8000)
+//   --gop=N            키프레임 간격 (기본 30)
+//   --iframe-factor=X  I-프레임 / P-프레임 크기 비 (기본 8)
+//   --window=X         페이싱 창 = 프레임 간격 x X, 0.1~1.0 (기본 0.5, 플러그인 PacingWindowFraction)
+//   --burst-packets=N  토큰 버킷 깊이 (기본 8, 플러그인 PacingBurstPackets)
+//   --max-rate-mbps=M  페이서 최고 속도, 0이면 비트레이트의 8배 (기본 0, 플러그인 PacingMaxRateMbps)
+//   --latency=MS       SRT 레이턴시 (기본 200)
+//   --bin-us=US        버스트 집계 구간 (기본 1000)
+//   --max-ratio=X      paced 최대 버스트 / unpaced 최대 버스트 허용치 (기본 0.5)
+//
+// 판정 (종료 코드 1):
+//   - 어느 단계든 빠진 메시지가 있음 (일련번호 누락)
+//   - paced 구간당 최대 패킷 수가 unpaced의 --max-ratio배를 넘음
+//   - paced 프레임 전송 시간 p99가 프레임 간격을 넘음 (다음 프레임까지 밀림)
+// 종료 코드 2: 잘못된 옵션, 소켓/연결 실패
+
+#include "srt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using UdpSocket = SOCKET;
+static const UdpSocket kInvalidUdp = INVALID_SOCKET;
+static void CloseUdp(UdpSocket s) { closesocket(s); }
+static int PollUdp(pollfd* fds, int n, int timeout_ms) { return WSAPoll(fds, (ULONG)n, timeout_ms); }
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using UdpSocket = int;
+static const UdpSocket kInvalidUdp = -1;
+static void CloseUdp(UdpSocket s) { close(s); }
+static int PollUdp(pollfd* fds, int n, int timeout_ms) { return poll(fds, (nfds_t)n, timeout_ms); }
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        int port = 9200;
+        double duration_sec = 5.0;
+        double fps = 30.0;
+        int bitrate_kbps = 8000;
+        int gop = 30;
+        double iframe_factor = 8.0;
+        double window = 0.5;
+        int burst_packets = 8;
+        double max_rate_mbps = 0.0;
+        int latency_ms = 200;
+        int bin_us = 1000;
+        double max_ratio = 0.5;
+    };
+
+    const int kMessageSize = 1316;
+    const int kOverheadPercent = 25;  // 플러그인 SRTNetwork::PACING_OVERHEAD_PERCENT
+
+    sockaddr_in Loopback(int port)
+    {
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)port);
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return sa;
+    }
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // ===== 플러그인 SRTNetwork::TokenBucketPacer와 같은 규칙 =====
+    struct TokenBucketPacer
+    {
+        double rate = 0.0;
+        double max_rate = 0.0;
+        double burst = 0.0;
+        double depth = 0.0;
+        double tokens = 0.0;
+        double last_refill = 0.0;
+
+        void Reset(int burst_packets, double max_rate_bytes)
+        {
+            burst = (double)std::max(burst_packets, 1) * kMessageSize;
+            max_rate = std::max(max_rate_bytes, (double)kMessageSize);
+            rate = max_rate;
+            depth = burst;
+            tokens = burst;
+            last_refill = 0.0;
+        }
+
+        void Refill(double now)
+        {
+            if (last_refill > 0.0 && now > last_refill)
+                tokens = std::min(depth, tokens + (now - last_refill) * rate);
+            last_refill = now;
+        }
+
+        void BeginFrame(int bytes, double window_sec, double min_rate, double now)
+        {
+            Refill(now);
+            rate = std::min(std::max(bytes / std::max(window_sec, 0.001), std::min(min_rate, max_rate)), max_rate);
+            depth = std::max(burst, rate * 0.002);
+            tokens = std::min(tokens, depth);
+        }
+
+        int Acquire(int want, double now, double& wait_sec)
+        {
+            Refill(now);
+            const int packets = (int)(tokens / kMessageSize);
+            if (packets > 0)
+            {
+                wait_sec = 0.0;
+                return std::min(want, packets * kMessageSize);
+            }
+            wait_sec = (kMessageSize - tokens) / rate;
+            return 0;
+        }
+
+        void Consume(int bytes)
+        {
+            const int packets = (bytes + kMessageSize - 1) / kMessageSize;
+            tokens = std::max(0.0, tokens - (double)packets * kMessageSize);
+        }
+    };
+
+    // ===== UDP 중계: 송신 <-> 중계 포트 <-> 수신 리스너, 송신 쪽 데이터 패킷 도착 시각 기록 =====
+    struct Relay
+    {
+        int listen_port = 0;
+        int target_port = 0;
+        UdpSocket front = kInvalidUdp;     // 송신이 보내는 곳
+        UdpSocket back = kInvalidUdp;      // 수신 리스너로 나가는 곳
+        std::vector<int64_t> arrivals_us;  // 중계 스레드만 기록, 종료 후 읽음
+        Clock::time_point epoch;
+
+        bool Open()
+        {
+            front = socket(AF_INET, SOCK_DGRAM, 0);
+            back = socket(AF_INET, SOCK_DGRAM, 0);
+            if (front == kInvalidUdp || back == kInvalidUdp)
+                return false;
+            sockaddr_in local = Loopback(listen_port);
+            if (bind(front, (sockaddr*)&local, sizeof(local)) != 0)
+                return false;
+            sockaddr_in target = Loopback(target_port);
+            return connect(back, (sockaddr*)&target, sizeof(target)) == 0;
+        }
+
+        void Run(std::atomic<bool>& stop)
+        {
+            sockaddr_in peer;
+            memset(&peer, 0, sizeof(peer));
+            bool has_peer = false;
+            char buffer[2048];
+            arrivals_us.reserve(1 << 20);
+
+            while (!stop.load())
+            {
+                pollfd fds[2];
+                fds[0].fd = front;
+                fds[0].events = POLLIN;
+                fds[0].revents = 0;
+                fds[1].fd = back;
+                fds[1].events = POLLIN;
+                fds[1].revents = 0;
+                if (PollUdp(fds, 2, 50) <= 0)
+                    continue;
+
+                if (fds[0].revents & POLLIN)
+                {
+                    socklen_t len = sizeof(peer);
+                    const int n = (int)recvfrom(front, buffer, sizeof(buffer), 0, (sockaddr*)&peer, &len);
+                    has_peer = n > 0;
+                    if (n > 0)
+                    {
+                        // SRT 헤더 첫 비트 0 = 데이터 패킷 (1은 제어 패킷)
+                        if ((buffer[0] & 0x80) == 0)
+                        {
+                            arrivals_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                                Clock::now() - epoch).count());
+                        }
+                        send(back, buffer, n, 0);
+                    }
+                }
+                if (fds[1].revents & POLLIN)
+                {
+                    const int n = (int)recv(back, buffer, sizeof(buffer), 0);
+                    if (n > 0 && has_peer)
+                        sendto(front, buffer, n, 0, (sockaddr*)&peer, sizeof(peer));
+                }
+            }
+        }
+
+        void Close()
+        {
+            if (front != kInvalidUdp) CloseUdp(front);
+            if (back != kInvalidUdp) CloseUdp(back);
+            front = back = kInvalidUdp;
+        }
+    };
+
+    // ===== 수신: 연결 하나를 받아 일련번호 검사 =====
+    struct ReceiverResult
+    {
+        bool connected = false;
+        uint64_t messages = 0;
+        uint64_t missing = 0;
+        std::string error;
+    };
+
+    void SetLiveOptions(SRTSOCKET sock, const Options& opt)
+    {
+        int live = SRTT_LIVE;
+        srt_setsockopt(sock, 0, SRTO_TRANSTYPE, &live, sizeof(live));
+        int messageapi = 1;
+        srt_setsockopt(sock, 0, SRTO_MESSAGEAPI, &messageapi, sizeof(messageapi));
+        int latency = opt.latency_ms;
+        srt_setsockopt(sock, 0, SRTO_LATENCY, &latency, sizeof(latency));
+        // 플러그인 ApplyLiveStreamOptions와 같은 버퍼/윈도
+        int buffer = 1024 * 1024;
+        srt_setsockopt(sock, 0, SRTO_SNDBUF, &buffer, sizeof(buffer));
+        srt_setsockopt(sock, 0, SRTO_RCVBUF, &buffer, sizeof(buffer));
+        int fc = 1000;
+        srt_setsockopt(sock, 0, SRTO_FC, &fc, sizeof(fc));
+    }
+
+    void RunReceiver(SRTSOCKET listener, std::atomic<bool>& stop, ReceiverResult& result)
+    {
+        const int eid = srt_epoll_create();
+        const int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+        srt_epoll_add_usock(eid, listener, &events);
+        SRTSOCKET sock = SRT_INVALID_SOCK;
+        while (!stop.load() && sock == SRT_INVALID_SOCK)
+        {
+            SRT_EPOLL_EVENT ready[1];
+            if (srt_epoll_uwait(eid, ready, 1, 200) <= 0)
+                continue;  // 종료 플래그 확인 주기
+            sock = srt_accept(listener, nullptr, nullptr);
+            if (sock == SRT_INVALID_SOCK && srt_getlasterror(nullptr) != SRT_EASYNCRCV)
+            {
+                result.error = srt_getlasterror_str();
+                break;
+            }
+        }
+        srt_epoll_release(eid);
+        if (sock == SRT_INVALID_SOCK)
+            return;
+        result.connected = true;
+
+        int rcvsyn = 1;  // 리스너의 논블로킹 설정을 물려받으므로 되돌림
+        srt_setsockopt(sock, 0, SRTO_RCVSYN, &rcvsyn, sizeof(rcvsyn));
+        int rcvtimeo = 200;  // 종료 플래그 확인 주기
+        srt_setsockopt(sock, 0, SRTO_RCVTIMEO, &rcvtimeo, sizeof(rcvtimeo));
+
+        uint64_t expected = 0;
+        std::vector<char> buffer(kMessageSize);
+        while (!stop.load())
+        {
+            const int received = srt_recvmsg(sock, buffer.data(), (int)buffer.size());
+            if (received == SRT_ERROR)
+            {
+                if (srt_getlasterror(nullptr) == SRT_EASYNCRCV)
+                    continue;
+                break;  // 송신 측이 닫음
+            }
+            if (received < 8)
+                continue;
+
+            uint64_t seq = 0;
+            memcpy(&seq, buffer.data(), sizeof(seq));
+            if (seq < expected)
+                continue;
+            result.missing += seq - expected;
+            expected = seq + 1;
+            result.messages++;
+        }
+        srt_close(sock);
+    }
+
+    // ===== 단계 하나: 연결, 프레임 송신, 결과 수집 =====
+    struct PhaseResult
+    {
+        const char* name = "";
+        ReceiverResult received;
+        uint64_t frames = 0;
+        uint64_t messages_sent = 0;
+        std::vector<double> frame_span_ms;   // 프레임 첫 청크부터 마지막 청크 송신까지
+        std::vector<int> bins;               // 패킷이 있는 구간만
+        uint64_t packets = 0;
+        std::string error;
+    };
+
+    template <typename T>
+    T Percentile(std::vector<T> values, double p)
+    {
+        if (values.empty())
+            return T();
+        std::sort(values.begin(), values.end());
+        const size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+        return values[index];
+    }
+
+    // 평균 비트레이트를 유지하면서 GOP 첫 프레임을 I-프레임으로 (TS 패킷 단위로 올림)
+    void FrameSizes(const Options& opt, int& iframe_bytes, int& pframe_bytes)
+    {
+        const double average = opt.bitrate_kbps * 1000.0 / 8.0 / opt.fps;
+        const double p = opt.gop * average / (opt.iframe_factor + opt.gop - 1);
+        pframe_bytes = ((int)p + 187) / 188 * 188;
+        iframe_bytes = ((int)(p * opt.iframe_factor) + 187) / 188 * 188;
+        if (opt.gop == 1)
+            pframe_bytes = iframe_bytes;
+    }
+
+    double MaxRateBytes(const Options& opt)
+    {
+        return opt.max_rate_mbps > 0.0 ? opt.max_rate_mbps * 125000.0 : opt.bitrate_kbps * 125.0 * 8;
+    }
+
+    bool RunPhase(const Options& opt, bool paced, SRTSOCKET listener, int relay_port, PhaseResult& result)
+    {
+        result.name = paced ? "paced" : "unpaced";
+
+        std::atomic<bool> stop_receiver{false};
+        std::thread receiver(RunReceiver, listener, std::ref(stop_receiver), std::ref(result.received));
+
+        SRTSOCKET sock = srt_create_socket();
+        SetLiveOptions(sock, opt);
+        if (paced)
+        {
+            int64_t maxbw = 0;
+            int64_t inputbw = (int64_t)MaxRateBytes(opt);
+            int overhead = kOverheadPercent;
+            if (srt_setsockopt(sock, 0, SRTO_MAXBW, &maxbw, sizeof(maxbw)) == SRT_ERROR
+                || srt_setsockopt(sock, 0, SRTO_INPUTBW, &inputbw, sizeof(inputbw)) == SRT_ERROR
+                || srt_setsockopt(sock, 0, SRTO_OHEADBW, &overhead, sizeof(overhead)) == SRT_ERROR)
+            {
+                result.error = std::string("pacing options: ") + srt_getlasterror_str();
+            }
+        }
+        sockaddr_in remote = Loopback(relay_port);
+        if (result.error.empty() && srt_connect(sock, (sockaddr*)&remote, sizeof(remote)) == SRT_ERROR)
+            result.error = std::string("connect: ") + srt_getlasterror_str();
+
+        if (result.error.empty())
+        {
+            int iframe_bytes = 0, pframe_bytes = 0;
+            FrameSizes(opt, iframe_bytes, pframe_bytes);
+            const double interval = 1.0 / opt.fps;
+            const double min_rate = opt.bitrate_kbps * 125.0;
+
+            TokenBucketPacer pacer;
+            pacer.Reset(opt.burst_packets, MaxRateBytes(opt));
+
+            std::vector<char> frame((size_t)std::max(iframe_bytes, pframe_bytes), 0x47);
+            uint64_t seq = 0;
+            const Clock::time_point start = Clock::now();
+
+            for (uint64_t n = 0; ; n++)
+            {
+                const Clock::time_point due = start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(n * interval));
+                if (std::chrono::duration<double>(due - start).count() >= opt.duration_sec)
+                    break;
+                std::this_thread::sleep_until(due);
+
+                const int bytes = (n % opt.gop == 0) ? iframe_bytes : pframe_bytes;
+                const double frame_start = SecondsSince(start);
+                if (paced)
+                    pacer.BeginFrame(bytes, interval * opt.window, min_rate, frame_start);
+
+                // 플러그인 SendWithBackpressure: 페이서가 허락한 만큼 메시지로 나눠 보냄
+                int offset = 0;
+                while (offset < bytes && result.error.empty())
+                {
+                    int length = bytes - offset;
+                    if (paced)
+                    {
+                        double wait_sec = 0.0;
+                        const int allowed = pacer.Acquire(length, SecondsSince(start), wait_sec);
+                        if (allowed == 0)
+                        {
+                            std::this_thread::sleep_for(std::chrono::duration<double>(wait_sec));
+                            continue;
+                        }
+                        length = allowed;
+                    }
+                    for (int sent = 0; sent < length; sent += kMessageSize)
+                    {
+                        const int chunk = std::min(kMessageSize, length - sent);
+                        char* message = frame.data() + offset + sent;
+                        memcpy(message, &seq, sizeof(seq));
+                        if (srt_sendmsg(sock, message, chunk, -1, 0) == SRT_ERROR)
+                        {
+                            result.error = std::string("send: ") + srt_getlasterror_str();
+                            break;
+                        }
+                        seq++;
+                        result.messages_sent++;
+                    }
+                    if (paced)
+                        pacer.Consume(length);
+                    offset += length;
+                }
+                if (!result.error.empty())
+                    break;
+
+                result.frame_span_ms.push_back((SecondsSince(start) - frame_start) * 1000.0);
+                result.frames++;
+            }
+
+            // 레이턴시 동안 남은 데이터가 배달되도록
+            std::this_thread::sleep_for(std::chrono::milliseconds(opt.latency_ms * 2 + 200));
+        }
+
+        srt_close(sock);
+        stop_receiver = true;
+        receiver.join();
+        return result.error.empty();
+    }
+
+    void CollectBins(const std::vector<int64_t>& arrivals_us, int bin_us, PhaseResult& result)
+    {
+        result.packets = arrivals_us.size();
+        int64_t current = -1;
+        for (int64_t t : arrivals_us)
+        {
+            const int64_t bin = t / bin_us;
+            if (bin != current)
+            {
+                result.bins.push_back(0);
+                current = bin;
+            }
+            result.bins.back()++;
+        }
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: pacing_burst [--port=P] [--duration=S] [--fps=F] [--bitrate-kbps=K] [--gop=N]"
+                     " [--iframe-factor=X] [--window=X] [--burst-packets=N] [--max-rate-mbps=M] [--latency=MS]"
+                     " [--bin-us=US] [--max-ratio=X]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--port=", 0) == 0)
+            opt.port = atoi(arg.c_str() + 7);
+        else if (arg.rfind("--duration=", 0) == 0)
+            opt.duration_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--fps=", 0) == 0)
+            opt.fps = atof(arg.c_str() + 6);
+        else if (arg.rfind("--bitrate-kbps=", 0) == 0)
+            opt.bitrate_kbps = atoi(arg.c_str() + 15);
+        else if (arg.rfind("--gop=", 0) == 0)
+            opt.gop = atoi(arg.c_str() + 6);
+        else if (arg.rfind("--iframe-factor=", 0) == 0)
+            opt.iframe_factor = atof(arg.c_str() + 16);
+        else if (arg.rfind("--window=", 0) == 0)
+            opt.window = atof(arg.c_str() + 9);
+        else if (arg.rfind("--burst-packets=", 0) == 0)
+            opt.burst_packets = atoi(arg.c_str() + 16);
+        else if (arg.rfind("--max-rate-mbps=", 0) == 0)
+            opt.max_rate_mbps = atof(arg.c_str() + 16);
+        else if (arg.rfind("--latency=", 0) == 0)
+            opt.latency_ms = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--bin-us=", 0) == 0)
+            opt.bin_us = atoi(arg.c_str() + 9);
+        else if (arg.rfind("--max-ratio=", 0) == 0)
+            opt.max_ratio = atof(arg.c_str() + 12);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (opt.duration_sec <= 0.0 || opt.fps <= 0.0 || opt.bitrate_kbps <= 0 || opt.gop < 1 || opt.iframe_factor < 1.0
+        || opt.window < 0.1 || opt.window > 1.0 || opt.burst_packets < 1 || opt.max_rate_mbps < 0.0 || opt.bin_us <= 0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    srt_startup();
+
+    // 수신 리스너 - 단계마다 연결 하나씩
+    SRTSOCKET listener = srt_create_socket();
+    SetLiveOptions(listener, opt);
+    int rcvsyn = 0;  // accept 대기 중에도 종료 확인
+    srt_setsockopt(listener, 0, SRTO_RCVSYN, &rcvsyn, sizeof(rcvsyn));
+    sockaddr_in listen_addr = Loopback(opt.port);
+    if (srt_bind(listener, (sockaddr*)&listen_addr, sizeof(listen_addr)) == SRT_ERROR
+        || srt_listen(listener, 2) == SRT_ERROR)
+    {
+        std::cerr << "Listener: " << srt_getlasterror_str() << std::endl;
+        srt_cleanup();
+        return 2;
+    }
+
+    // 단계마다 중계를 따로 - 같은 출발 주소로 다시 연결하면 닫히는 중인 이전 연결과 겹칠 수 있음
+    const Clock::time_point epoch = Clock::now();
+    std::atomic<bool> stop{false};
+    std::vector<Relay> relays(2);
+    std::vector<std::thread> relay_threads;
+    for (int i = 0; i < 2; i++)
+    {
+        relays[i].listen_port = opt.port + 1 + i;
+        relays[i].target_port = opt.port;
+        relays[i].epoch = epoch;
+        if (!relays[i].Open())
+        {
+            std::cerr << "Relay " << i << ": cannot bind port " << relays[i].listen_port << std::endl;
+            stop = true;
+            for (std::thread& t : relay_threads)
+                t.join();
+            for (Relay& r : relays)
+                r.Close();
+            srt_close(listener);
+            srt_cleanup();
+            return 2;
+        }
+        relay_threads.emplace_back(&Relay::Run, &relays[i], std::ref(stop));
+    }
+
+    int iframe_bytes = 0, pframe_bytes = 0;
+    FrameSizes(opt, iframe_bytes, pframe_bytes);
+    printf("%.0f fps, %d kbps, GOP %d: I-frame %d bytes (%d msgs), P-frame %d bytes (%d msgs)\n",
+           opt.fps, opt.bitrate_kbps, opt.gop, iframe_bytes, (iframe_bytes + kMessageSize - 1) / kMessageSize,
+           pframe_bytes, (pframe_bytes + kMessageSize - 1) / kMessageSize);
+    printf("Pacing window %.1f ms, burst %d packets, max rate %.1f Mbps (SRT limit +%d%%)\n",
+           1000.0 / opt.fps * opt.window, opt.burst_packets, MaxRateBytes(opt) * 8.0 / 1e6, kOverheadPercent);
+
+    int exit_code = 0;
+    PhaseResult phases[2];
+    for (int i = 0; i < 2 && exit_code == 0; i++)
+    {
+        const bool paced = i == 1;
+        printf("Sending %s for %.1fs via relay %d -> listener %d\n", paced ? "paced" : "unpaced",
+               opt.duration_sec, opt.port + 1 + i, opt.port);
+        if (!RunPhase(opt, paced, listener, opt.port + 1 + i, phases[i]))
+        {
+            std::cerr << phases[i].name << ": " << phases[i].error << std::endl;
+            exit_code = 2;
+        }
+    }
+
+    srt_close(listener);
+    stop = true;
+    for (std::thread& t : relay_threads)
+        t.join();
+    for (Relay& r : relays)
+        r.Close();
+    srt_cleanup();
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+
+    if (exit_code != 0)
+        return exit_code;
+
+    // 결과
+    printf("\nPackets per %d us bin (bins with traffic)\n", opt.bin_us);
+    printf("%-8s %8s %8s %8s %6s %6s %6s %6s %12s %12s\n", "phase", "frames", "packets", "missing",
+           "p50", "p90", "p99", "max", "span p99 ms", "span max ms");
+    for (int i = 0; i < 2; i++)
+    {
+        PhaseResult& phase = phases[i];
+        CollectBins(relays[i].arrivals_us, opt.bin_us, phase);
+        printf("%-8s %8llu %8llu %8llu %6d %6d %6d %6d %12.2f %12.2f\n", phase.name,
+               (unsigned long long)phase.frames, (unsigned long long)phase.packets,
+               (unsigned long long)phase.received.missing, Percentile(phase.bins, 0.5), Percentile(phase.bins, 0.9),
+               Percentile(phase.bins, 0.99), Percentile(phase.bins, 1.0), Percentile(phase.frame_span_ms, 0.99),
+               Percentile(phase.frame_span_ms, 1.0));
+    }
+
+    bool ok = true;
+    for (const PhaseResult& phase : phases)
+    {
+        if (!phase.received.connected || phase.received.messages == 0)
+        {
+            printf("%s: receiver got no data: %s\n", phase.name, phase.received.error.c_str());
+            ok = false;
+        }
+        // 끝부분은 송신과 수신 종료 시점 차이로 덜 받을 수 있으므로 누락은 일련번호 구멍만 본다
+        if (phase.received.missing > 0)
+            ok = false;
+    }
+
+    const int unpaced_max = Percentile(phases[0].bins, 1.0);
+    const int paced_max = Percentile(phases[1].bins, 1.0);
+    const double interval_ms = 1000.0 / opt.fps;
+    printf("\nMax burst: paced %d / unpaced %d packets (limit x%.2f = %.1f)\n", paced_max, unpaced_max,
+           opt.max_ratio, unpaced_max * opt.max_ratio);
+    if (paced_max > unpaced_max * opt.max_ratio)
+        ok = false;
+    if (Percentile(phases[1].frame_span_ms, 0.99) > interval_ms)
+    {
+        printf("Paced frames spill into the next frame interval (%.1f ms)\n", interval_ms);
+        ok = false;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,1141 @@
+// srt_loadgen.cpp - 수신 서버 용량 시험용 부하 생성기 (SRT caller 연결 수백 개, 한 프로세스)
+//
+// TS 하나를 메모리에 올려 두고 연결마다 PCR 기준 실시간 속도로 반복 송출한다.
+// 연결은 스레드 몇 개에 나눠 SRT epoll(비동기 접속/에러 감시)로 다루고, 송신 일정은 스레드마다
+// 가장 이른 마감 시각까지만 기다린다. 반복할 때 PCR/PTS/DTS에 반복 길이를 더하고 CC를 이어 붙여
+// 수신 측에는 끊김 없는 하나의 스트림으로 보인다 (TS 버퍼는 모든 연결이 공유, 메시지마다 1316바이트 복사 후 수정).
+//
+// 입력:
+//   --file=<ts>      미리 인코딩한 TS (플러그인 녹화 파일 등). 첫 PCR PID의 PCR로 송신 시각을 정함
+//   (없으면)         합성 TS - PAT/PMT + H.264 PES(AUD + 더미 슬라이스), 프레임마다 PCR
+//                    I-프레임은 P-프레임의 --iframe-factor배, 평균은 --bitrate-kbps (디코딩은 안 되는 내용)
+//
+// 사용법:
+//   srt_loadgen [옵션] <host> <port>
+//
+// 옵션:
+//   --streams=N        동시 연결 수 (기본 100)
+//   --threads=N        송신 스레드 수 (기본 4)
+//   --duration=S       송신 시간 (기본 30초)
+//   --ramp=S           연결을 S초에 걸쳐 나눠 시작 (기본 0 = 한꺼번에)
+//   --latency=MS       SRT 레이턴시 (기본 120)
+//   --passphrase=P     SRT 암호
+//   --streamid=S       SRT Stream ID ("{n}"은 연결 번호로 바뀜)
+//   --burst            PCR 구간의 메시지를 구간 시작에 몰아 보냄 (플러그인 기본 동작처럼 프레임 단위 폭주)
+//                      기본은 PCR 사이를 바이트 위치로 보간해 고르게 보냄
+//   --bitrate-kbps=K   합성 TS 평균 비트레이트 (기본 8000)
+//   --fps=F            합성 TS 프레임 속도 (기본 30)
+//   --gop=N            합성 TS 키프레임 간격 (기본 30)
+//   --iframe-factor=X  합성 TS I-프레임 / P-프레임 크기 비 (기본 8)
+//   --sink             같은 프로세스에 <port> 루프백 리스너를 띄워 받아 버림 (수신 서버 없이 송신 측만 시험)
+//                      이때 프로세스 CPU에는 수신 측도 포함됨 - 송신 스레드 CPU는 따로 출력
+//   --interval=S       진행 상황 출력 간격 (기본 1초, 0이면 끔)
+//   --per-stream       연결별 결과 전체 출력 (기본은 재전송이 많은 10개만)
+//   --json             최종 결과를 JSON으로 출력
+//
+// 측정:
+//   처리량       모든 연결의 SRT 페이로드 송신량 / 경과 시간 (목표 = 입력 TS 비트레이트 x 연결 수)
+//   연결별       송신 Mbps, 재전송 비율, 손실 보고(NAK), 송신 측 드롭, RTT, 송신 버퍼가 차서 미룬 횟수
+//   CPU          프로세스 전체(SRT 내부 스레드 포함)와 송신 스레드만, 연결당 평균 (ms/s)
+//
+// 종료 코드: 0 = 모든 연결이 접속했고 송신 드롭 없음, 처리량이 목표의 95% 이상
+//            1 = 아님, 2 = 잘못된 옵션 / 입력 파일 / 소켓 오류
+
+#include "srt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const int kPacketSize = 188;
+    const int kPacketsPerMessage = 7;
+    const int kMessageSize = kPacketSize * kPacketsPerMessage;
+    const int64_t kPcrWrap = (1LL << 33) * 300;   // 27MHz
+    const int64_t kPtsWrap = 1LL << 33;           // 90kHz
+
+    struct Options
+    {
+        std::string host;
+        int port = 0;
+        std::string file;
+        int streams = 100;
+        int threads = 4;
+        double duration_sec = 30.0;
+        double ramp_sec = 0.0;
+        int latency_ms = 120;
+        std::string passphrase;
+        std::string streamid;
+        bool burst = false;
+        int bitrate_kbps = 8000;
+        double fps = 30.0;
+        int gop = 30;
+        double iframe_factor = 8.0;
+        bool sink = false;
+        double interval_sec = 1.0;
+        bool per_stream = false;
+        bool json = false;
+    };
+
+    std::atomic<bool> g_stop{false};
+
+    void OnSignal(int)
+    {
+        g_stop = true;
+    }
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    double ProcessCPUSeconds()
+    {
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return 0.0;
+        const uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+        const uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+        return (k + u) / 1e7;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#endif
+    }
+
+    double ThreadCPUSeconds()
+    {
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return 0.0;
+        const uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+        const uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+        return (k + u) / 1e7;
+#else
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+    }
+
+    // ===== 입력 TS와 송신 일정 =====
+
+    struct Source
+    {
+        std::vector<uint8_t> ts;               // 188바이트 정렬, 메시지 단위로 나눔
+        std::vector<int64_t> message_ns;       // 반복 시작 기준 메시지 송신 시각
+        int64_t loop_ns = 0;                   // 한 바퀴 길이
+        int64_t loop_27mhz = 0;                // 다음 바퀴의 PCR/PTS에 더할 값
+        double bitrate_kbps = 0.0;
+        std::string description;
+
+        size_t MessageCount() const { return message_ns.size(); }
+    };
+
+    int64_t ReadPcr(const uint8_t* p)
+    {
+        // adaptation_field가 있고 PCR_flag가 켜진 경우만 호출
+        const int64_t base = ((int64_t)p[6] << 25) | ((int64_t)p[7] << 17) | ((int64_t)p[8] << 9) |
+                             ((int64_t)p[9] << 1) | (p[10] >> 7);
+        const int64_t ext = ((p[10] & 0x01) << 8) | p[11];
+        return base * 300 + ext;
+    }
+
+    bool HasPcr(const uint8_t* p)
+    {
+        const int afc = (p[3] >> 4) & 0x03;
+        return (afc & 0x02) && p[4] >= 7 && (p[5] & 0x10);
+    }
+
+    // PCR이 있는 패킷 위치로 송신 시각 계산 - PCR 사이는 바이트 위치로 보간(기본) 또는 구간 시작(--burst)
+    bool BuildSchedule(Source& source, bool burst, std::string& error)
+    {
+        const size_t packets = source.ts.size() / kPacketSize;
+        int pcr_pid = -1;
+        std::vector<std::pair<size_t, int64_t>> pcrs;   // (패킷 번호, 27MHz, wrap 풀린 값)
+        int64_t wrap_base = 0;
+        for (size_t i = 0; i < packets; i++)
+        {
+            const uint8_t* p = source.ts.data() + i * kPacketSize;
+            const int pid = ((p[1] & 0x1F) << 8) | p[2];
+            if (!HasPcr(p) || (pcr_pid >= 0 && pid != pcr_pid))
+                continue;
+            pcr_pid = pid;
+            int64_t pcr = ReadPcr(p) + wrap_base;
+            if (!pcrs.empty() && pcr < pcrs.back().second - kPcrWrap / 2)
+            {
+                wrap_base += kPcrWrap;
+                pcr += kPcrWrap;
+            }
+            pcrs.emplace_back(i, pcr);
+        }
+        if (pcrs.size() < 2 || pcrs.back().second <= pcrs.front().second)
+        {
+            error = "input needs at least two increasing PCRs";
+            return false;
+        }
+
+        // 평균 패킷 간격 (첫 PCR 이전 / 마지막 PCR 이후 외삽, 반복 길이)
+        const double ns_per_packet = (pcrs.back().second - pcrs.front().second) / 27.0 * 1000.0 /
+                                     (double)(pcrs.back().first - pcrs.front().first);
+        auto packet_ns = [&](size_t packet)
+        {
+            auto next = std::upper_bound(pcrs.begin(), pcrs.end(), packet,
+                [](size_t value, const std::pair<size_t, int64_t>& entry) { return value < entry.first; });
+            if (next == pcrs.begin())
+                return -(double)(pcrs.front().first - packet) * ns_per_packet;
+            const auto& prev = *(next - 1);
+            const double prev_ns = (prev.second - pcrs.front().second) / 27.0 * 1000.0;
+            if (next == pcrs.end() || burst)
+                return prev_ns + (next == pcrs.end() ? (packet - prev.first) * ns_per_packet : 0.0);
+            const double next_ns = (next->second - pcrs.front().second) / 27.0 * 1000.0;
+            return prev_ns + (next_ns - prev_ns) * (packet - prev.first) / (double)(next->first - prev.first);
+        };
+
+        const double first_ns = packet_ns(0);
+        source.message_ns.clear();
+        for (size_t i = 0; i < packets; i += kPacketsPerMessage)
+            source.message_ns.push_back((int64_t)(packet_ns(i) - first_ns));
+
+        source.loop_ns = (int64_t)(packet_ns(packets) - first_ns);
+        source.loop_27mhz = source.loop_ns * 27 / 1000;
+        source.bitrate_kbps = source.ts.size() * 8.0 / (source.loop_ns / 1e9) / 1000.0;
+        return source.loop_ns > 0;
+    }
+
+    bool LoadFile(const std::string& path, Source& source, std::string& error)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        // 동기 바이트 기준으로 188바이트 패킷만 추림 (앞부분 쓰레기, 192바이트 M2TS는 지원 안 함)
+        source.ts.clear();
+        source.ts.reserve(data.size());
+        size_t pos = 0;
+        while (pos + kPacketSize <= data.size())
+        {
+            if (data[pos] != 0x47)
+            {
+                pos++;
+                continue;
+            }
+            source.ts.insert(source.ts.end(), data.begin() + pos, data.begin() + pos + kPacketSize);
+            pos += kPacketSize;
+        }
+        source.description = path;
+        std::replace(source.description.begin(), source.description.end(), '\\', '/');   // JSON 출력용
+        return true;
+    }
+
+    // ----- 합성 TS -----
+
+    uint32_t Crc32(const uint8_t* data, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc ^= (uint32_t)data[i] << 24;
+            for (int k = 0; k < 8; k++)
+                crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : crc << 1;
+        }
+        return crc;
+    }
+
+    class SyntheticWriter
+    {
+    public:
+        explicit SyntheticWriter(std::vector<uint8_t>& output) : out(output) {}
+
+        void WriteSection(int pid, std::vector<uint8_t> section)
+        {
+            const uint32_t crc = Crc32(section.data(), section.size());
+            for (int shift = 24; shift >= 0; shift -= 8)
+                section.push_back((uint8_t)(crc >> shift));
+            section.insert(section.begin(), 0);   // pointer_field
+            WritePayload(pid, section.data(), section.size(), true, -1);
+        }
+
+        // 첫 패킷에 PCR (pcr_27mhz >= 0이면)
+        void WritePayload(int pid, const uint8_t* data, size_t size, bool unit_start, int64_t pcr_27mhz)
+        {
+            bool first = true;
+            while (size > 0 || first)
+            {
+                uint8_t packet[kPacketSize];
+                packet[0] = 0x47;
+                packet[1] = (uint8_t)(((first && unit_start) ? 0x40 : 0) | ((pid >> 8) & 0x1F));
+                packet[2] = (uint8_t)(pid & 0xFF);
+                int offset = 4;
+                const bool pcr = first && pcr_27mhz >= 0;
+                const size_t room = kPacketSize - 4 - (pcr ? 8 : 0);
+                const size_t take = std::min(size, room);
+                const int stuffing = (int)(room - take);
+
+                if (pcr || stuffing > 0)
+                {
+                    // adaptation_field: PCR 또는 마지막 패킷의 스터핑 (length 바이트 자신은 제외)
+                    const int length = pcr ? 7 + stuffing : stuffing - 1;
+                    packet[3] = (uint8_t)(0x30 | (cc[pid] & 0x0F));
+                    packet[offset++] = (uint8_t)length;
+                    if (length > 0)
+                    {
+                        packet[offset++] = pcr ? 0x10 : 0x00;
+                        if (pcr)
+                        {
+                            const int64_t base = pcr_27mhz / 300;
+                            const int64_t ext = pcr_27mhz % 300;
+                            packet[offset++] = (uint8_t)(base >> 25);
+                            packet[offset++] = (uint8_t)(base >> 17);
+                            packet[offset++] = (uint8_t)(base >> 9);
+                            packet[offset++] = (uint8_t)(base >> 1);
+                            packet[offset++] = (uint8_t)(((base & 1) << 7) | 0x7E | (ext >> 8));
+                            packet[offset++] = (uint8_t)(ext & 0xFF);
+                        }
+                        memset(packet + offset, 0xFF, kPacketSize - offset - take);
+                        offset = kPacketSize - (int)take;
+                    }
+                }
+                else
+                {
+                    packet[3] = (uint8_t)(0x10 | (cc[pid] & 0x0F));
+                }
+                cc[pid] = (uint8_t)((cc[pid] + 1) & 0x0F);
+
+                memcpy(packet + offset, data, take);
+                out.insert(out.end(), packet, packet + kPacketSize);
+                data += take;
+                size -= take;
+                first = false;
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& out;
+        uint8_t cc[8192] = {0};
+    };
+
+    void WriteTimestamp(std::vector<uint8_t>& pes, int prefix, int64_t value)
+    {
+        pes.push_back((uint8_t)((prefix << 4) | ((value >> 29) & 0x0E) | 1));
+        pes.push_back((uint8_t)(value >> 22));
+        pes.push_back((uint8_t)(((value >> 14) & 0xFE) | 1));
+        pes.push_back((uint8_t)(value >> 7));
+        pes.push_back((uint8_t)(((value << 1) & 0xFE) | 1));
+    }
+
+    // GOP 단위 몇 초 분량 (반복해도 키프레임 간격이 유지되도록)
+    void BuildSynthetic(const Options& opt, Source& source)
+    {
+        const int video_pid = 0x100;
+        const int pmt_pid = 0x1000;
+        const double frame_bytes = opt.bitrate_kbps * 1000.0 / 8.0 / opt.fps * 0.97;   // TS/PES 오버헤드 여유
+        const double p_bytes = frame_bytes * opt.gop / (opt.iframe_factor + opt.gop - 1);
+        const int gops = std::max(1, (int)std::ceil(4.0 * opt.fps / opt.gop));
+        const int frames = gops * opt.gop;
+        const double frame_90k = 90000.0 / opt.fps;
+
+        source.ts.clear();
+        SyntheticWriter writer(source.ts);
+        std::vector<uint8_t> es, pes;
+        for (int f = 0; f < frames; f++)
+        {
+            const bool key = (f % opt.gop) == 0;
+            const int64_t pcr_90k = (int64_t)std::llround(f * frame_90k);
+            if (key || f % std::max(1, (int)(opt.fps / 10)) == 0)
+            {
+                writer.WriteSection(0, {0x00, 0xB0, 13, 0x00, 0x01, 0xC1, 0x00, 0x00, 0x00, 0x01,
+                                        (uint8_t)(0xE0 | (pmt_pid >> 8)), (uint8_t)(pmt_pid & 0xFF)});
+                writer.WriteSection(pmt_pid, {0x02, 0xB0, 18, 0x00, 0x01, 0xC1, 0x00, 0x00,
+                                              (uint8_t)(0xE0 | (video_pid >> 8)), (uint8_t)(video_pid & 0xFF), 0xF0, 0x00,
+                                              0x1B, (uint8_t)(0xE0 | (video_pid >> 8)), (uint8_t)(video_pid & 0xFF), 0xF0, 0x00});
+            }
+
+            // AUD + 슬라이스 (IDR 5 / non-IDR 1), 내용은 시작 코드가 생기지 않는 바이트
+            const size_t size = (size_t)std::max(64.0, key ? p_bytes * opt.iframe_factor : p_bytes);
+            es.assign({0x00, 0x00, 0x00, 0x01, 0x09, 0xF0, 0x00, 0x00, 0x00, 0x01, (uint8_t)(key ? 0x65 : 0x41)});
+            for (size_t i = es.size(); i < size; i++)
+                es.push_back((uint8_t)(0x80 | ((i * 31 + f) & 0x7F)));
+
+            const int64_t dts = pcr_90k + 9000;   // 100ms 디코딩 여유
+            pes.assign({0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0xC0, 10});
+            WriteTimestamp(pes, 3, dts);
+            WriteTimestamp(pes, 1, dts);
+            pes.insert(pes.end(), es.begin(), es.end());
+            writer.WritePayload(video_pid, pes.data(), pes.size(), true, pcr_90k * 300);
+        }
+
+        char description[128];
+        snprintf(description, sizeof(description), "synthetic H.264 %d kbps %.0f fps gop %d", opt.bitrate_kbps, opt.fps, opt.gop);
+        source.description = description;
+    }
+
+    // ===== 연결 =====
+
+    enum class State
+    {
+        Waiting,      // 램프 시작 전
+        Connecting,
+        Sending,
+        Failed,
+        Closed
+    };
+
+    struct Stream
+    {
+        int index = 0;
+        SRTSOCKET sock = SRT_INVALID_SOCK;
+        State state = State::Waiting;
+        int64_t start_at_ns = 0;      // 접속 시작 (램프)
+        int64_t origin_ns = 0;        // 첫 메시지 송신 시각 (반복 시작 기준)
+        size_t next_message = 0;
+        int64_t loop = 0;
+        uint64_t stalls = 0;          // 송신 버퍼가 차서 다음 차례로 미룬 횟수
+        std::string error;
+        uint8_t cc[8192];             // PID별 연속성 카운터 (반복해도 이어지도록 다시 씀)
+        uint8_t cc_valid[8192];
+
+        // 종료 시 SRT 통계
+        uint64_t bytes_sent = 0;
+        int64_t packets_sent = 0;
+        int64_t packets_retrans = 0;
+        int64_t packets_loss = 0;
+        int64_t packets_drop = 0;
+        double rtt_ms = 0.0;
+        double seconds = 0.0;
+    };
+
+    void AddToTimestamp(uint8_t* p, int64_t add_90k)
+    {
+        int64_t value = ((int64_t)((p[0] >> 1) & 0x07) << 30) | ((int64_t)p[1] << 22) |
+                        ((int64_t)(p[2] >> 1) << 15) | ((int64_t)p[3] << 7) | (p[4] >> 1);
+        value = (value + add_90k) % kPtsWrap;
+        p[0] = (uint8_t)((p[0] & 0xF1) | ((value >> 29) & 0x0E));
+        p[1] = (uint8_t)(value >> 22);
+        p[2] = (uint8_t)((p[2] & 0x01) | ((value >> 14) & 0xFE));
+        p[3] = (uint8_t)(value >> 7);
+        p[4] = (uint8_t)((p[4] & 0x01) | ((value << 1) & 0xFE));
+    }
+
+    // 반복 횟수만큼 PCR/PTS/DTS를 밀고 CC를 이어 씀 (첫 바퀴는 CC만 - 원본과 같음)
+    void PatchMessage(Stream& stream, uint8_t* data, size_t size, int64_t add_27mhz)
+    {
+        const int64_t add_90k = add_27mhz / 300;
+        for (size_t offset = 0; offset + kPacketSize <= size; offset += kPacketSize)
+        {
+            uint8_t* p = data + offset;
+            const int pid = ((p[1] & 0x1F) << 8) | p[2];
+            if (pid == 0x1FFF)
+                continue;
+            const int afc = (p[3] >> 4) & 0x03;
+            if (afc & 0x01)
+            {
+                if (stream.cc_valid[pid])
+                    stream.cc[pid] = (uint8_t)((stream.cc[pid] + 1) & 0x0F);
+                else
+                    stream.cc[pid] = p[3] & 0x0F;
+                stream.cc_valid[pid] = 1;
+                p[3] = (uint8_t)((p[3] & 0xF0) | stream.cc[pid]);
+            }
+            if (add_27mhz == 0)
+                continue;
+
+            int payload = 4;
+            if (afc & 0x02)
+            {
+                if (HasPcr(p))
+                {
+                    const int64_t pcr = (ReadPcr(p) + add_27mhz) % kPcrWrap;
+                    const int64_t base = pcr / 300;
+                    const int64_t ext = pcr % 300;
+                    p[6] = (uint8_t)(base >> 25);
+                    p[7] = (uint8_t)(base >> 17);
+                    p[8] = (uint8_t)(base >> 9);
+                    p[9] = (uint8_t)(base >> 1);
+                    p[10] = (uint8_t)(((base & 1) << 7) | 0x7E | (ext >> 8));
+                    p[11] = (uint8_t)(ext & 0xFF);
+                }
+                payload += 1 + p[4];
+            }
+
+            // PES 헤더 (PUSI, 헤더 확장이 있는 스트림만)
+            if (!(p[1] & 0x40) || !(afc & 0x01) || payload + 14 > kPacketSize)
+                continue;
+            uint8_t* pes = p + payload;
+            const uint8_t stream_id = pes[3];
+            if (pes[0] != 0 || pes[1] != 0 || pes[2] != 1 || stream_id == 0xBC || stream_id == 0xBE || stream_id == 0xBF ||
+                (pes[6] & 0xC0) != 0x80)
+                continue;
+            const int flags = pes[7] >> 6;
+            if (flags & 0x02)
+                AddToTimestamp(pes + 9, add_90k);
+            if (flags == 0x03 && payload + 19 <= kPacketSize)
+                AddToTimestamp(pes + 14, add_90k);
+        }
+    }
+
+    bool ApplyOptions(SRTSOCKET sock, const Options& opt, int index)
+    {
+        int live = SRTT_LIVE;
+        int latency = opt.latency_ms;
+        int sync = 0;
+        bool ok = srt_setsockopt(sock, 0, SRTO_TRANSTYPE, &live, sizeof(live)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_LATENCY, &latency, sizeof(latency)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_RCVSYN, &sync, sizeof(sync)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_SNDSYN, &sync, sizeof(sync)) == 0;
+        if (ok && !opt.passphrase.empty())
+            ok = srt_setsockopt(sock, 0, SRTO_PASSPHRASE, opt.passphrase.c_str(), (int)opt.passphrase.size()) == 0;
+        if (ok && !opt.streamid.empty())
+        {
+            std::string id = opt.streamid;
+            const size_t at = id.find("{n}");
+            if (at != std::string::npos)
+                id.replace(at, 3, std::to_string(index));
+            ok = srt_setsockopt(sock, 0, SRTO_STREAMID, id.c_str(), (int)id.size()) == 0;
+        }
+        return ok;
+    }
+
+    // 송신 스레드 하나 - 맡은 연결의 접속, 일정에 따른 송신, 종료 시 통계
+    class Worker
+    {
+    public:
+        Worker(const Options& options, const Source& input, const sockaddr_in& address)
+            : opt(options), source(input), target(address)
+        {
+            eid = srt_epoll_create();
+            srt_epoll_set(eid, SRT_EPOLL_ENABLE_EMPTY);
+        }
+
+        ~Worker()
+        {
+            srt_epoll_release(eid);
+        }
+
+        void Add(Stream* stream) { streams.push_back(stream); }
+
+        void Start() { thread = std::thread([this]() { Run(); }); }
+        void Join()
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+
+        double GetCPUSeconds() const { return cpu_seconds; }
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<int> sending{0};
+
+    private:
+        const Options& opt;
+        const Source& source;
+        sockaddr_in target;
+        int eid = -1;
+        std::vector<Stream*> streams;
+        std::thread thread;
+        double cpu_seconds = 0.0;
+
+        void Connect(Stream& stream)
+        {
+            stream.sock = srt_create_socket();
+            if (!ApplyOptions(stream.sock, opt, stream.index))
+            {
+                Fail(stream, srt_getlasterror_str());
+                return;
+            }
+            int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+            srt_epoll_add_usock(eid, stream.sock, &events);
+            // 논블로킹 접속 - 완료는 epoll OUT, 실패는 ERR
+            if (srt_connect(stream.sock, (const sockaddr*)&target, sizeof(target)) == SRT_ERROR)
+            {
+                Fail(stream, srt_getlasterror_str());
+                return;
+            }
+            stream.state = State::Connecting;
+        }
+
+        void Fail(Stream& stream, const std::string& reason)
+        {
+            if (stream.state == State::Sending)
+                sending--;
+            stream.error = reason;
+            stream.state = State::Failed;
+            if (stream.sock != SRT_INVALID_SOCK)
+            {
+                CollectStats(stream);
+                srt_close(stream.sock);   // 닫으면 epoll에서도 빠짐
+                stream.sock = SRT_INVALID_SOCK;
+            }
+        }
+
+        void CollectStats(Stream& stream)
+        {
+            SRT_TRACEBSTATS stats;
+            if (srt_bstats(stream.sock, &stats, 0) != 0)
+                return;
+            stream.bytes_sent = stats.byteSentTotal;
+            stream.packets_sent = stats.pktSentTotal;
+            stream.packets_retrans = stats.pktRetransTotal;
+            stream.packets_loss = stats.pktSndLossTotal;
+            stream.packets_drop = stats.pktSndDropTotal;
+            stream.rtt_ms = stats.msRTT;
+            stream.seconds = stats.msTimeStamp / 1000.0;
+        }
+
+        void OnEvent(Stream& stream, int events)
+        {
+            if (stream.state != State::Connecting && stream.state != State::Sending)
+                return;
+            if (events & SRT_EPOLL_ERR)
+            {
+                const SRT_SOCKSTATUS status = srt_getsockstate(stream.sock);
+                const int reject = srt_getrejectreason(stream.sock);
+                Fail(stream, stream.state == State::Connecting
+                    ? std::string("connect failed: ") + srt_rejectreason_str(reject)
+                    : std::string("connection closed (state ") + std::to_string((int)status) + ")");
+                return;
+            }
+            if (stream.state == State::Connecting && (events & SRT_EPOLL_OUT))
+            {
+                // 접속 완료 - 이후에는 에러만 감시 (쓰기 가능 이벤트가 계속 깨우지 않도록)
+                int error_only = SRT_EPOLL_ERR;
+                srt_epoll_update_usock(eid, stream.sock, &error_only);
+                stream.state = State::Sending;
+                stream.origin_ns = NowNs();
+                sending++;
+            }
+        }
+
+        // 마감이 지난 메시지 송신, 다음 마감 반환
+        int64_t Pump(Stream& stream, int64_t now, std::vector<uint8_t>& buffer)
+        {
+            const size_t count = source.MessageCount();
+            while (true)
+            {
+                const int64_t due = stream.origin_ns + stream.loop * source.loop_ns + source.message_ns[stream.next_message];
+                if (due > now)
+                    return due;
+
+                const size_t offset = stream.next_message * kMessageSize;
+                const size_t size = std::min((size_t)kMessageSize, source.ts.size() - offset);
+                memcpy(buffer.data(), source.ts.data() + offset, size);
+                PatchMessage(stream, buffer.data(), size, stream.loop * source.loop_27mhz);
+
+                if (srt_sendmsg(stream.sock, (const char*)buffer.data(), (int)size, -1, 1) == SRT_ERROR)
+                {
+                    if (srt_getlasterror(nullptr) == SRT_EASYNCSND)
+                    {
+                        // 송신 버퍼가 참 - 다음 차례에 다시 (같은 메시지, CC는 되돌림)
+                        stream.stalls++;
+                        RewindCC(stream, buffer.data(), size);
+                        return now + 1000000;
+                    }
+                    Fail(stream, srt_getlasterror_str());
+                    return INT64_MAX;
+                }
+                bytes += size;
+
+                if (++stream.next_message == count)
+                {
+                    stream.next_message = 0;
+                    stream.loop++;
+                }
+            }
+        }
+
+        static void RewindCC(Stream& stream, const uint8_t* data, size_t size)
+        {
+            for (size_t offset = 0; offset + kPacketSize <= size; offset += kPacketSize)
+            {
+                const uint8_t* p = data + offset;
+                const int pid = ((p[1] & 0x1F) << 8) | p[2];
+                if (pid != 0x1FFF && (p[3] & 0x10))
+                    stream.cc[pid] = (uint8_t)((stream.cc[pid] + 15) & 0x0F);
+            }
+        }
+
+        void Run()
+        {
+            const double cpu_start = ThreadCPUSeconds();
+            std::vector<uint8_t> buffer(kMessageSize);
+            std::vector<SRT_EPOLL_EVENT> events(256);
+            const int64_t end_ns = NowNs() + (int64_t)(opt.duration_sec * 1e9);
+
+            while (!g_stop)
+            {
+                const int64_t now = NowNs();
+                if (now >= end_ns)
+                    break;
+
+                int64_t next = end_ns;
+                for (Stream* stream : streams)
+                {
+                    if (stream->state == State::Waiting)
+                    {
+                        if (now >= stream->start_at_ns)
+                            Connect(*stream);
+                        else
+                            next = std::min(next, stream->start_at_ns);
+                    }
+                    else if (stream->state == State::Sending)
+                    {
+                        next = std::min(next, Pump(*stream, now, buffer));
+                    }
+                }
+
+                // 다음 마감까지 epoll 대기 (접속 완료/에러), 1ms 미만은 잠깐 잠
+                const int64_t wait_ns = next - NowNs();
+                const int timeout_ms = wait_ns > 0 ? (int)std::min<int64_t>(wait_ns / 1000000, 100) : 0;
+                const int ready = srt_epoll_uwait(eid, events.data(), (int)events.size(), timeout_ms);
+                for (int i = 0; i < ready; i++)
+                {
+                    for (Stream* stream : streams)
+                    {
+                        if (stream->sock == events[i].fd)
+                        {
+                            OnEvent(*stream, events[i].events);
+                            break;
+                        }
+                    }
+                }
+                if (ready <= 0 && timeout_ms == 0 && wait_ns > 0)
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+            }
+
+            for (Stream* stream : streams)
+            {
+                if (stream->sock == SRT_INVALID_SOCK)
+                    continue;
+                CollectStats(*stream);
+                srt_close(stream->sock);
+                stream->sock = SRT_INVALID_SOCK;
+                if (stream->state == State::Sending)
+                    sending--;
+                if (stream->state == State::Connecting)
+                {
+                    stream->state = State::Failed;
+                    stream->error = "not connected before end";
+                }
+                else
+                {
+                    stream->state = State::Closed;
+                }
+            }
+            cpu_seconds = ThreadCPUSeconds() - cpu_start;
+        }
+    };
+
+    // --sink: 받아서 버리기만 하는 루프백 리스너 (스레드 하나)
+    class Sink
+    {
+    public:
+        bool Start(const Options& opt, std::string& error)
+        {
+            listener = srt_create_socket();
+            int live = SRTT_LIVE;
+            int latency = opt.latency_ms;
+            int sync = 0;
+            sockaddr_in sa;
+            memset(&sa, 0, sizeof(sa));
+            sa.sin_family = AF_INET;
+            sa.sin_port = htons((uint16_t)opt.port);
+            sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (srt_setsockopt(listener, 0, SRTO_TRANSTYPE, &live, sizeof(live)) != 0 ||
+                srt_setsockopt(listener, 0, SRTO_LATENCY, &latency, sizeof(latency)) != 0 ||
+                srt_setsockopt(listener, 0, SRTO_RCVSYN, &sync, sizeof(sync)) != 0 ||
+                (!opt.passphrase.empty() &&
+                 srt_setsockopt(listener, 0, SRTO_PASSPHRASE, opt.passphrase.c_str(), (int)opt.passphrase.size()) != 0) ||
+                srt_bind(listener, (sockaddr*)&sa, sizeof(sa)) != 0 ||
+                srt_listen(listener, 1024) != 0)
+            {
+                error = srt_getlasterror_str();
+                srt_close(listener);
+                return false;
+            }
+            eid = srt_epoll_create();
+            srt_epoll_set(eid, SRT_EPOLL_ENABLE_EMPTY);
+            int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+            srt_epoll_add_usock(eid, listener, &events);
+            thread = std::thread([this]() { Run(); });
+            return true;
+        }
+
+        void Stop()
+        {
+            stop = true;
+            if (thread.joinable())
+                thread.join();
+            srt_epoll_release(eid);
+            srt_close(listener);
+        }
+
+        std::atomic<uint64_t> bytes{0};
+
+    private:
+        SRTSOCKET listener = SRT_INVALID_SOCK;
+        int eid = -1;
+        std::atomic<bool> stop{false};
+        std::thread thread;
+
+        void Run()
+        {
+            std::vector<SRT_EPOLL_EVENT> events(1024);
+            std::vector<SRTSOCKET> peers;
+            char buffer[1500];
+            while (!stop)
+            {
+                const int ready = srt_epoll_uwait(eid, events.data(), (int)events.size(), 100);
+                for (int i = 0; i < ready; i++)
+                {
+                    const SRTSOCKET sock = events[i].fd;
+                    if (sock == listener)
+                    {
+                        const SRTSOCKET peer = srt_accept(listener, nullptr, nullptr);
+                        if (peer == SRT_INVALID_SOCK)
+                            continue;
+                        int peer_events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+                        srt_epoll_add_usock(eid, peer, &peer_events);
+                        peers.push_back(peer);
+                        continue;
+                    }
+                    if (events[i].events & SRT_EPOLL_ERR)
+                    {
+                        srt_close(sock);
+                        continue;
+                    }
+                    while (true)
+                    {
+                        const int received = srt_recvmsg(sock, buffer, sizeof(buffer));
+                        if (received <= 0)
+                            break;
+                        bytes += (uint64_t)received;
+                    }
+                }
+            }
+            for (SRTSOCKET peer : peers)
+                srt_close(peer);
+        }
+    };
+
+    template <typename T>
+    T Percentile(std::vector<T> values, double p)
+    {
+        if (values.empty())
+            return T();
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5))];
+    }
+
+    double RetransPercent(const Stream& s)
+    {
+        return s.packets_sent > 0 ? 100.0 * s.packets_retrans / s.packets_sent : 0.0;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: srt_loadgen [--streams=N] [--threads=N] [--duration=S] [--ramp=S] [--latency=MS]" << std::endl
+                  << "                   [--passphrase=P] [--streamid=S] [--file=<ts> | --bitrate-kbps=K --fps=F --gop=N" << std::endl
+                  << "                   --iframe-factor=X] [--burst] [--sink] [--interval=S] [--per-stream] [--json]" << std::endl
+                  << "                   <host> <port>" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--file=", 0) == 0)
+            opt.file = arg.substr(7);
+        else if (arg.rfind("--streams=", 0) == 0)
+            opt.streams = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--threads=", 0) == 0)
+            opt.threads = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--duration=", 0) == 0)
+            opt.duration_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--ramp=", 0) == 0)
+            opt.ramp_sec = atof(arg.c_str() + 7);
+        else if (arg.rfind("--latency=", 0) == 0)
+            opt.latency_ms = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--passphrase=", 0) == 0)
+            opt.passphrase = arg.substr(13);
+        else if (arg.rfind("--streamid=", 0) == 0)
+            opt.streamid = arg.substr(11);
+        else if (arg == "--burst")
+            opt.burst = true;
+        else if (arg.rfind("--bitrate-kbps=", 0) == 0)
+            opt.bitrate_kbps = atoi(arg.c_str() + 15);
+        else if (arg.rfind("--fps=", 0) == 0)
+            opt.fps = atof(arg.c_str() + 6);
+        else if (arg.rfind("--gop=", 0) == 0)
+            opt.gop = atoi(arg.c_str() + 6);
+        else if (arg.rfind("--iframe-factor=", 0) == 0)
+            opt.iframe_factor = atof(arg.c_str() + 16);
+        else if (arg == "--sink")
+            opt.sink = true;
+        else if (arg.rfind("--interval=", 0) == 0)
+            opt.interval_sec = atof(arg.c_str() + 11);
+        else if (arg == "--per-stream")
+            opt.per_stream = true;
+        else if (arg == "--json")
+            opt.json = true;
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            PrintUsage();
+            return 2;
+        }
+        else
+            positional.push_back(arg);
+    }
+
+    if (positional.size() != 2 || opt.streams <= 0 || opt.threads <= 0 || opt.duration_sec <= 0.0 || opt.ramp_sec < 0.0 ||
+        opt.bitrate_kbps <= 0 || opt.fps <= 0.0 || opt.gop < 1 || opt.iframe_factor < 1.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+    opt.host = positional[0];
+    opt.port = atoi(positional[1].c_str());
+    opt.threads = std::min(opt.threads, opt.streams);
+
+    sockaddr_in target;
+    memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons((uint16_t)opt.port);
+    if (inet_pton(AF_INET, opt.host.c_str(), &target.sin_addr) != 1)
+    {
+        std::cerr << "Invalid host " << opt.host << " (IPv4 address)" << std::endl;
+        return 2;
+    }
+
+    Source source;
+    std::string error;
+    if (!opt.file.empty())
+    {
+        if (!LoadFile(opt.file, source, error))
+        {
+            std::cerr << error << std::endl;
+            return 2;
+        }
+    }
+    else
+    {
+        BuildSynthetic(opt, source);
+    }
+    if (!BuildSchedule(source, opt.burst, error))
+    {
+        std::cerr << source.description << ": " << error << std::endl;
+        return 2;
+    }
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    srt_startup();
+    srt_setloglevel(LOG_ERR);   // 과부하 시 수신 드롭 경고가 수천 줄 쏟아지므로 - 결과는 통계로 봄
+    std::signal(SIGINT, OnSignal);
+
+    Sink sink;
+    if (opt.sink && !sink.Start(opt, error))
+    {
+        std::cerr << "Sink bind/listen on " << opt.port << " failed: " << error << std::endl;
+        srt_cleanup();
+        return 2;
+    }
+
+    std::cerr << "Source: " << source.description << ", " << source.MessageCount() << " messages, loop "
+              << source.loop_ns / 1e9 << " s, " << source.bitrate_kbps << " kbps" << std::endl;
+    std::cerr << "Target: " << opt.host << ":" << opt.port << ", " << opt.streams << " streams on " << opt.threads
+              << " threads" << (opt.sink ? " (local sink)" : "") << std::endl;
+
+    // 연결 → 스레드 라운드 로빈, 램프는 연결 번호 순으로 고르게
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < opt.threads; i++)
+        workers.emplace_back(new Worker(opt, source, target));
+    const int64_t start_ns = NowNs();
+    for (int i = 0; i < opt.streams; i++)
+    {
+        std::unique_ptr<Stream> stream(new Stream());
+        stream->index = i;
+        stream->start_at_ns = start_ns + (int64_t)(opt.ramp_sec * 1e9 * i / opt.streams);
+        memset(stream->cc_valid, 0, sizeof(stream->cc_valid));
+        workers[i % opt.threads]->Add(stream.get());
+        streams.push_back(std::move(stream));
+    }
+
+    const double cpu_start = ProcessCPUSeconds();
+    const auto wall_start = Clock::now();
+    for (auto& worker : workers)
+        worker->Start();
+
+    // 진행 상황 (작업 스레드가 duration이 지나면 스스로 끝냄)
+    auto last_print = wall_start;
+    uint64_t last_bytes = 0;
+    while (!g_stop && std::chrono::duration<double>(Clock::now() - wall_start).count() < opt.duration_sec)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto now = Clock::now();
+        if (opt.interval_sec <= 0.0 || std::chrono::duration<double>(now - last_print).count() < opt.interval_sec)
+            continue;
+        uint64_t bytes = 0;
+        int sending = 0;
+        for (auto& worker : workers)
+        {
+            bytes += worker->bytes;
+            sending += worker->sending;
+        }
+        const double seconds = std::chrono::duration<double>(now - last_print).count();
+        fprintf(stderr, "[%6.1fs] sending %d/%d  %9.1f Mbps  (target %.1f)\n",
+            std::chrono::duration<double>(now - wall_start).count(), sending, opt.streams,
+            (bytes - last_bytes) * 8.0 / 1e6 / seconds, source.bitrate_kbps * sending / 1000.0);
+        last_bytes = bytes;
+        last_print = now;
+    }
+
+    for (auto& worker : workers)
+        worker->Join();
+    const double wall_seconds = std::chrono::duration<double>(Clock::now() - wall_start).count();
+    const double process_cpu = ProcessCPUSeconds() - cpu_start;
+    double sender_cpu = 0.0;
+    uint64_t payload_bytes = 0;
+    for (auto& worker : workers)
+    {
+        sender_cpu += worker->GetCPUSeconds();
+        payload_bytes += worker->bytes;
+    }
+    if (opt.sink)
+        sink.Stop();
+    srt_cleanup();
+
+    // ===== 결과 =====
+    int connected = 0, failed = 0;
+    int64_t retrans = 0, sent = 0, loss = 0, drop = 0;
+    uint64_t stalls = 0;
+    std::vector<double> retrans_pct, rtt, stream_mbps;
+    for (const auto& s : streams)
+    {
+        if (s->state == State::Closed)
+        {
+            connected++;
+            retrans_pct.push_back(RetransPercent(*s));
+            rtt.push_back(s->rtt_ms);
+            stream_mbps.push_back(s->seconds > 0.0 ? s->bytes_sent * 8.0 / 1e6 / s->seconds : 0.0);
+        }
+        else
+        {
+            failed++;
+        }
+        sent += s->packets_sent;
+        retrans += s->packets_retrans;
+        loss += s->packets_loss;
+        drop += s->packets_drop;
+        stalls += s->stalls;
+    }
+
+    const double throughput_mbps = payload_bytes * 8.0 / 1e6 / wall_seconds;
+    // 목표: 램프 이후 전 구간 송신 기준 (램프 동안은 절반으로 계산)
+    const double active_fraction = std::max(0.0, (opt.duration_sec - opt.ramp_sec * 0.5) / opt.duration_sec);
+    const double target_mbps = source.bitrate_kbps / 1000.0 * opt.streams * active_fraction;
+    const double cores = process_cpu / wall_seconds;
+    const double sender_cores = sender_cpu / wall_seconds;
+    const bool ok = failed == 0 && drop == 0 && throughput_mbps >= target_mbps * 0.95;
+
+    std::vector<const Stream*> order;
+    for (const auto& s : streams)
+        order.push_back(s.get());
+    std::sort(order.begin(), order.end(), [](const Stream* a, const Stream* b) { return RetransPercent(*a) > RetransPercent(*b); });
+    const size_t shown = opt.per_stream ? order.size() : std::min<size_t>(order.size(), 10);
+
+    if (opt.json)
+    {
+        printf("{\"source\":\"%s\",\"source_kbps\":%.1f,\"streams\":%d,\"threads\":%d,\"connected\":%d,\"failed\":%d,"
+               "\"seconds\":%.3f,\"throughput_mbps\":%.3f,\"target_mbps\":%.3f,"
+               "\"retrans_percent\":%.4f,\"retrans_percent_p50\":%.4f,\"retrans_percent_max\":%.4f,"
+               "\"snd_loss\":%lld,\"snd_drop\":%lld,\"stalls\":%llu,\"rtt_ms_p50\":%.3f,\"rtt_ms_max\":%.3f,"
+               "\"cpu_cores\":%.3f,\"sender_thread_cores\":%.3f,\"cpu_ms_per_stream_per_sec\":%.3f,\"per_stream\":[\n",
+            source.description.c_str(), source.bitrate_kbps, opt.streams, opt.threads, connected, failed,
+            wall_seconds, throughput_mbps, target_mbps,
+            sent > 0 ? 100.0 * retrans / sent : 0.0, Percentile(retrans_pct, 0.5), Percentile(retrans_pct, 1.0),
+            (long long)loss, (long long)drop, (unsigned long long)stalls, Percentile(rtt, 0.5), Percentile(rtt, 1.0),
+            cores, sender_cores, cores * 1000.0 / opt.streams);
+        for (size_t i = 0; i < shown; i++)
+        {
+            const Stream& s = *order[i];
+            printf("{\"index\":%d,\"mbps\":%.3f,\"packets\":%lld,\"retrans\":%lld,\"snd_loss\":%lld,\"snd_drop\":%lld,"
+                   "\"rtt_ms\":%.3f,\"stalls\":%llu,\"error\":\"%s\"}%s\n",
+                s.index, s.seconds > 0.0 ? s.bytes_sent * 8.0 / 1e6 / s.seconds : 0.0, (long long)s.packets_sent,
+                (long long)s.packets_retrans, (long long)s.packets_loss, (long long)s.packets_drop, s.rtt_ms,
+                (unsigned long long)s.stalls, s.error.c_str(), i + 1 < shown ? "," : "");
+        }
+        printf("],\"pass\":%s}\n", ok ? "true" : "false");
+        return ok ? 0 : 1;
+    }
+
+    printf("\nsource      %s (%.0f kbps)\n", source.description.c_str(), source.bitrate_kbps);
+    printf("streams     %d connected, %d failed, %d threads\n", connected, failed, opt.threads);
+    printf("throughput  %.1f Mbps (target %.1f), per stream p50 %.2f / min %.2f Mbps\n",
+        throughput_mbps, target_mbps, Percentile(stream_mbps, 0.5), Percentile(stream_mbps, 0.0));
+    printf("retrans     %.3f%% total, per stream p50 %.3f%% / max %.3f%%\n",
+        sent > 0 ? 100.0 * retrans / sent : 0.0, Percentile(retrans_pct, 0.5), Percentile(retrans_pct, 1.0));
+    printf("loss/drop   %lld NAK-reported, %lld dropped by sender, %llu send-buffer stalls\n",
+        (long long)loss, (long long)drop, (unsigned long long)stalls);
+    printf("rtt         p50 %.2f / max %.2f ms\n", Percentile(rtt, 0.5), Percentile(rtt, 1.0));
+    printf("cpu         %.2f cores process, %.2f cores sender threads, %.2f ms/s per stream%s\n",
+        cores, sender_cores, cores * 1000.0 / opt.streams, opt.sink ? " (includes local sink)" : "");
+    if (opt.sink)
+        printf("sink        %.1f Mbps received\n", sink.bytes * 8.0 / 1e6 / wall_seconds);
+
+    printf("\n%6s %8s %9s %8s %7s %7s %8s %7s  %s\n", "stream", "Mbps", "packets", "retrans", "loss", "drop", "rtt ms", "stalls",
+        opt.per_stream ? "" : "(top 10 by retransmission)");
+    for (size_t i = 0; i < shown; i++)
+    {
+        const Stream& s = *order[i];
+        printf("%6d %8.2f %9lld %7.2f%% %7lld %7lld %8.2f %7llu  %s\n",
+            s.index, s.seconds > 0.0 ? s.bytes_sent * 8.0 / 1e6 / s.seconds : 0.0, (long long)s.packets_sent,
+            RetransPercent(s), (long long)s.packets_loss, (long long)s.packets_drop, s.rtt_ms,
+            (unsigned long long)s.stalls, s.error.c_str());
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// capture_sei.h - 캡처 타임스탬프 SEI (user_data_unregistered) 형식과 파서
+//
+// 송신 측이 액세스 유닛마다 넣는 SEI:
+//   payloadType 5 (user_data_unregistered), payloadSize 30
+//   uuid[16]         "CineSRT-Capture" + 0x01
+//   version (1)      1
+//   clock (1)        0 = UTC (시스템 시계, 같은 호스트 또는 NTP/PTP 동기화된 호스트끼리 비교)
+//   capture_us (8)   캡처 시각, 1970-01-01 UTC 기준 마이크로초 (big-endian)
+//   frame_number (4) 캡처 프레임 번호 (big-endian)
+//
+// 액세스 유닛(Annex B) 하나를 훑어 이 SEI와 키프레임 여부를 찾는다. H.264와 HEVC 모두 지원.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace capture_sei
+{
+    constexpr uint8_t Uuid[16] = { 'C', 'i', 'n', 'e', 'S', 'R', 'T', '-', 'C', 'a', 'p', 't', 'u', 'r', 'e', 0x01 };
+    constexpr int PayloadSize = 16 + 14;
+    constexpr uint8_t Version = 1;
+    constexpr uint8_t ClockUTC = 0;
+
+    struct CaptureTimestamp
+    {
+        uint8_t clock = ClockUTC;
+        int64_t capture_us = 0;
+        uint32_t frame_number = 0;
+    };
+
+    struct AccessUnitInfo
+    {
+        bool keyframe = false;             // H.264 IDR / HEVC IRAP
+        bool has_capture = false;
+        CaptureTimestamp capture;
+    };
+
+    namespace detail
+    {
+        // 에뮬레이션 방지 바이트(00 00 03) 제거
+        inline void Unescape(const uint8_t* data, size_t size, std::vector<uint8_t>& out)
+        {
+            out.clear();
+            out.reserve(size);
+            int zeros = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                if (zeros >= 2 && data[i] == 0x03)
+                {
+                    zeros = 0;
+                    continue;
+                }
+                zeros = (data[i] == 0) ? zeros + 1 : 0;
+                out.push_back(data[i]);
+            }
+        }
+
+        inline bool ParseSEI(const uint8_t* rbsp, size_t size, CaptureTimestamp& out)
+        {
+            size_t pos = 0;
+            while (pos + 2 <= size && rbsp[pos] != 0x80)
+            {
+                int type = 0;
+                while (pos < size && rbsp[pos] == 0xFF) { type += 255; pos++; }
+                if (pos >= size) return false;
+                type += rbsp[pos++];
+
+                int length = 0;
+                while (pos < size && rbsp[pos] == 0xFF) { length += 255; pos++; }
+                if (pos >= size) return false;
+                length += rbsp[pos++];
+                if (pos + (size_t)length > size) return false;
+
+                const uint8_t* payload = rbsp + pos;
+                if (type == 5 && length >= PayloadSize && memcmp(payload, Uuid, 16) == 0 && payload[16] == Version)
+                {
+                    out.clock = payload[17];
+                    uint64_t us = 0;
+                    for (int i = 0; i < 8; i++) us = (us << 8) | payload[18 + i];
+                    out.capture_us = (int64_t)us;
+                    out.frame_number = ((uint32_t)payload[26] << 24) | ((uint32_t)payload[27] << 16) |
+                                       ((uint32_t)payload[28] << 8) | payload[29];
+                    return true;
+                }
+                pos += length;
+            }
+            return false;
+        }
+    }
+
+    // 액세스 유닛 하나 (start code로 구분된 NAL들)
+    inline AccessUnitInfo Scan(const uint8_t* data, size_t size, bool hevc)
+    {
+        AccessUnitInfo info;
+        std::vector<uint8_t> rbsp;
+
+        size_t i = 0;
+        while (i + 3 <= size)
+        {
+            // 다음 start code
+            if (!(data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1))
+            {
+                i++;
+                continue;
+            }
+            const size_t nal_start = i + 3;
+            size_t next = nal_start;
+            while (next + 3 <= size && !(data[next] == 0 && data[next + 1] == 0 && data[next + 2] == 1))
+                next++;
+            if (next + 3 > size) next = size;
+            i = next;
+
+            // 4바이트 start code / trailing_zero_8bits
+            size_t nal_end = next;
+            while (nal_end > nal_start && data[nal_end - 1] == 0)
+                nal_end--;
+
+            const size_t header = hevc ? 2 : 1;
+            if (nal_end <= nal_start + header)
+                continue;
+
+            const int type = hevc ? (data[nal_start] >> 1) & 0x3F : data[nal_start] & 0x1F;
+            const bool sei = hevc ? (type == 39) : (type == 6);
+            if (hevc ? (type >= 16 && type <= 21) : (type == 5))
+                info.keyframe = true;
+
+            if (sei && !info.has_capture)
+            {
+                detail::Unescape(data + nal_start + header, nal_end - nal_start - header, rbsp);
+                info.has_capture = detail::ParseSEI(rbsp.data(), rbsp.size(), info.capture);
+            }
+        }
+        return info;
+    }
+}
@@ -0,0 +1,945 @@
+// srt_monitor.cpp - 저지연 수신 모니터 (여러 스트림 동시, Linux/Windows/macOS)
+//
+// SRT epoll로 스트림 여러 개를 스레드 몇 개에서 받으면서 TS를 역다중화해 액세스 유닛마다
+// 도착 지터, 손실/지각 프레임, (선택) 디코딩 시간, 캡처 타임스탬프 SEI가 있으면 종단 간 지연을 잰다.
+// TS 자체의 오류(동기, CC, PAT/PMT)는 ts_analyzer로 같이 검사한다.
+//
+// 사용법:
+//   srt_monitor [옵션] --listen <port>              (Caller 모드 송신기 여러 개가 접속)
+//   srt_monitor [옵션] --connect <host:port> ...    (Listener 모드 송신기에 접속, 여러 번 지정 가능)
+//
+// 옵션:
+//   --count=N        --connect 대상마다 연결 수 (기본 1, 리스너 팬아웃 부하용)
+//   --threads=N      수신 스레드 수 (기본 1, 스트림을 나눠 맡음)
+//   --duration=S     S초 후 종료 (기본: Ctrl+C까지)
+//   --latency=MS     SRT 레이턴시 (기본 120)
+//   --no-tsbpd       TSBPD 끔 - 도착 즉시 전달 (재생 지연 없이 네트워크 + 파이프라인만 측정)
+//   --passphrase=P   SRT 암호
+//   --decode         libavcodec으로 디코딩하고 시간 측정 (WITH_FFMPEG 빌드)
+//   --late-ms=M      PTS 일정보다 M ms 넘게 늦은 프레임을 지각으로 셈 (기본 50)
+//   --interval=S     진행 상황 출력 간격 (기본 1초, 0이면 끔)
+//   --json           최종 결과를 JSON으로 출력
+//   --clock=MODE     캡처 SEI 시각과 수신 시계의 관계 (기본 same-host)
+//                      same-host  송신기와 같은 호스트 - 같은 시스템 시계라 그대로 비교
+//                      synced     NTP/PTP로 동기화된 호스트 - 그대로 비교, 음수 지연은 동기화 오차로 따로 셈
+//                      unsynced   동기화 안 됨 - 최소 지연을 0으로 둔 상대값(지연 변동)만 보고
+//   --clock-offset-ms=X  송신 호스트 시계가 수신 호스트보다 X ms 앞섬 (측정값에 더해 보정, 예: chronyc/ptp4l 오프셋)
+//   --bucket-ms=W    지연 히스토그램 구간 폭 (기본 2ms, 텍스트 출력은 30줄 안으로 합침)
+//
+// 측정 기준:
+//   도착 시각  액세스 유닛의 마지막 TS 패킷이 수신된 시각
+//   지터       |도착 간격 - DTS 간격|
+//   손실       DTS 간격이 공칭 프레임 간격(DTS 간격 중앙값)의 1.5배를 넘으면 빠진 프레임 수만큼
+//   지각       (도착 - DTS)가 가장 빨랐던 프레임보다 --late-ms 넘게 늦음 (시계 동기화 필요 없음)
+//   지연       캡처 SEI의 캡처 시각(UTC) → 도착 시각(시스템 시계) + 시계 오프셋, SEI가 없으면 n/a
+//              최솟값은 네트워크 + 파이프라인의 하한 (synced 모드에서 음수면 시계 동기화 오차가 그보다 큼)
+//
+// 종료 코드: 0 = 모든 스트림이 프레임을 받았고 손실/1순위 TS 에러 없음, 1 = 아님, 2 = 설정 오류
+
+#include "capture_sei.h"
+#include "ts_analyzer.h"
+#include "video_demux.h"
+#include "srt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#endif
+
+#ifdef WITH_FFMPEG
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+}
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        int listen_port = 0;
+        std::vector<std::pair<std::string, int>> connect;
+        int count = 1;
+        int threads = 1;
+        double duration_sec = 0.0;
+        int latency_ms = 120;
+        bool tsbpd = true;
+        std::string passphrase;
+        bool decode = false;
+        double late_ms = 50.0;
+        double interval_sec = 1.0;
+        bool json = false;
+        std::string clock = "same-host";
+        double clock_offset_ms = 0.0;
+        double bucket_ms = 2.0;
+    };
+
+    std::atomic<bool> g_stop{false};
+
+    void OnSignal(int)
+    {
+        g_stop = true;
+    }
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    int64_t NowUtcUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename T>
+    T Percentile(std::vector<T> values, double p)
+    {
+        if (values.empty())
+            return T();
+        std::sort(values.begin(), values.end());
+        const size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+        return values[index];
+    }
+
+    // 고정 폭 구간 (시작은 최솟값이 든 구간, 구간이 너무 많으면 폭을 두 배씩)
+    struct Histogram
+    {
+        double start_ms = 0.0;
+        double bucket_ms = 0.0;
+        std::vector<uint64_t> counts;
+    };
+
+    Histogram BuildHistogram(const std::vector<double>& values, double bucket_ms)
+    {
+        Histogram h;
+        if (values.empty())
+            return h;
+        const auto range = std::minmax_element(values.begin(), values.end());
+        h.bucket_ms = bucket_ms;
+        while ((*range.second - *range.first) / h.bucket_ms > 1000.0)
+            h.bucket_ms *= 2.0;
+        h.start_ms = std::floor(*range.first / h.bucket_ms) * h.bucket_ms;
+        h.counts.assign((size_t)((*range.second - h.start_ms) / h.bucket_ms) + 1, 0);
+        for (double v : values)
+            h.counts[std::min(h.counts.size() - 1, (size_t)((v - h.start_ms) / h.bucket_ms))]++;
+        return h;
+    }
+
+    void PrintHistogram(const Histogram& h, const char* label)
+    {
+        constexpr size_t MaxRows = 30;
+        constexpr int BarWidth = 40;
+        const size_t merge = (h.counts.size() + MaxRows - 1) / MaxRows;
+        std::vector<uint64_t> rows;
+        for (size_t i = 0; i < h.counts.size(); i += merge)
+        {
+            uint64_t sum = 0;
+            for (size_t j = i; j < std::min(i + merge, h.counts.size()); j++)
+                sum += h.counts[j];
+            rows.push_back(sum);
+        }
+        const uint64_t peak = *std::max_element(rows.begin(), rows.end());
+        const double width = h.bucket_ms * merge;
+
+        printf("  %s (ms)\n", label);
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            const int bar = peak ? (int)((rows[i] * BarWidth + peak - 1) / peak) : 0;
+            printf("  %8.1f - %-8.1f %-*s %llu\n", h.start_ms + i * width, h.start_ms + (i + 1) * width,
+                BarWidth, std::string(bar, '#').c_str(), (unsigned long long)rows[i]);
+        }
+    }
+
+    double Mean(const std::vector<double>& values)
+    {
+        if (values.empty())
+            return 0.0;
+        double sum = 0.0;
+        for (double v : values)
+            sum += v;
+        return sum / values.size();
+    }
+
+#ifdef WITH_FFMPEG
+    // 저지연 설정 디코더 (스레드 1개 - 프레임 지연 없이 액세스 유닛 하나당 디코딩 시간)
+    class Decoder
+    {
+    public:
+        ~Decoder()
+        {
+            av_frame_free(&frame);
+            av_packet_free(&packet);
+            avcodec_free_context(&context);
+        }
+
+        bool Open(bool hevc)
+        {
+            const AVCodec* codec = avcodec_find_decoder(hevc ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264);
+            if (!codec)
+                return false;
+            context = avcodec_alloc_context3(codec);
+            context->flags |= AV_CODEC_FLAG_LOW_DELAY;
+            context->thread_count = 1;
+            packet = av_packet_alloc();
+            frame = av_frame_alloc();
+            return avcodec_open2(context, codec, nullptr) == 0 && packet && frame;
+        }
+
+        // 디코딩 시간(ms), 실패하면 음수
+        double Decode(const uint8_t* data, size_t size)
+        {
+            buffer.assign(data, data + size);
+            buffer.resize(size + AV_INPUT_BUFFER_PADDING_SIZE, 0);
+            packet->data = buffer.data();
+            packet->size = (int)size;
+
+            const auto start = Clock::now();
+            int result = avcodec_send_packet(context, packet);
+            while (result >= 0)
+            {
+                result = avcodec_receive_frame(context, frame);
+                if (result == 0)
+                    av_frame_unref(frame);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            return (result == AVERROR(EAGAIN) || result == AVERROR_EOF) ? ms : -1.0;
+        }
+
+    private:
+        AVCodecContext* context = nullptr;
+        AVPacket* packet = nullptr;
+        AVFrame* frame = nullptr;
+        std::vector<uint8_t> buffer;
+    };
+#endif
+
+    struct FrameRecord
+    {
+        int64_t dts = 0;                  // 33비트 wrap 풀린 값 (90kHz)
+        int64_t arrival_ns = 0;
+        int64_t latency_us = INT64_MIN;   // 캡처 SEI 없으면 INT64_MIN
+        float decode_ms = -1.0f;
+        uint32_t bytes = 0;
+        bool keyframe = false;
+        bool corrupt = false;
+    };
+
+    struct Track
+    {
+        int pid = 0;
+        int program = 0;
+        bool hevc = false;
+        int64_t last_dts = demux::NoTime;
+        int64_t dts_base = 0;             // wrap 보정
+        uint64_t decode_errors = 0;
+        std::vector<FrameRecord> frames;
+#ifdef WITH_FFMPEG
+        std::unique_ptr<Decoder> decoder;
+#endif
+    };
+
+    struct Stream
+    {
+        SRTSOCKET sock = SRT_INVALID_SOCK;
+        std::string name;
+        ts::Analyzer analyzer;
+        std::unique_ptr<demux::VideoDemux> demux;
+        std::map<int, Track> tracks;
+        int64_t start_ns = 0;
+        std::string error;
+
+        // 진행 상황 출력용 (다른 스레드에서 읽음)
+        std::atomic<bool> open{true};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> frames{0};
+        std::atomic<int64_t> last_latency_us{INT64_MIN};
+
+        // 종료 시 SRT 통계
+        int64_t srt_loss = 0;
+        int64_t srt_drop = 0;
+        double srt_rtt_ms = 0.0;
+    };
+
+    void OnAccessUnit(const Options& opt, Stream& stream, const demux::AccessUnit& au)
+    {
+        Track& track = stream.tracks[au.pid];
+        if (track.frames.empty() && track.last_dts == demux::NoTime)
+        {
+            track.pid = au.pid;
+            track.program = au.program;
+            track.hevc = au.hevc;
+#ifdef WITH_FFMPEG
+            if (opt.decode)
+            {
+                track.decoder.reset(new Decoder());
+                if (!track.decoder->Open(au.hevc))
+                    track.decoder.reset();
+            }
+#endif
+        }
+
+        FrameRecord record;
+        if (au.dts != demux::NoTime)
+        {
+            // 33비트 wrap (약 26.5시간)
+            if (track.last_dts != demux::NoTime && au.dts + (1LL << 32) < track.last_dts)
+                track.dts_base += 1LL << 33;
+            track.last_dts = au.dts;
+            record.dts = au.dts + track.dts_base;
+        }
+        record.arrival_ns = au.arrival_ns;
+        record.bytes = (uint32_t)au.size;
+        record.keyframe = au.info.keyframe;
+        record.corrupt = au.corrupt;
+        if (au.info.has_capture)
+        {
+            record.latency_us = au.arrival_utc_us - au.info.capture.capture_us + (int64_t)(opt.clock_offset_ms * 1000.0);
+            stream.last_latency_us = record.latency_us;
+        }
+
+#ifdef WITH_FFMPEG
+        if (track.decoder)
+        {
+            const double ms = track.decoder->Decode(au.data, au.size);
+            if (ms < 0.0)
+                track.decode_errors++;
+            else
+                record.decode_ms = (float)ms;
+        }
+#else
+        (void)opt;
+#endif
+
+        track.frames.push_back(record);
+        stream.frames++;
+    }
+
+    // 수신 스레드 하나 - 자기 epoll에 등록된 스트림만 처리
+    class Shard
+    {
+    public:
+        Shard(const Options& options, SRTSOCKET listener_socket) : opt(options), listener(listener_socket)
+        {
+            eid = srt_epoll_create();
+            srt_epoll_set(eid, SRT_EPOLL_ENABLE_EMPTY);
+            if (listener != SRT_INVALID_SOCK)
+            {
+                int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+                srt_epoll_add_usock(eid, listener, &events);
+            }
+        }
+
+        ~Shard()
+        {
+            srt_epoll_release(eid);
+        }
+
+        // 어느 스레드든 - 접속된 소켓을 이 스레드에 맡김
+        void Add(Stream* stream)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                pending.push_back(stream);
+            }
+            int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+            srt_epoll_add_usock(eid, stream->sock, &events);
+        }
+
+        void Start(std::vector<Shard*>* all, std::function<Stream*(SRTSOCKET, const std::string&)> create)
+        {
+            shards = all;
+            create_stream = std::move(create);
+            thread = std::thread([this]() { Run(); });
+        }
+
+        void Join()
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+
+    private:
+        const Options& opt;
+        SRTSOCKET listener;
+        int eid = -1;
+        std::mutex lock;
+        std::vector<Stream*> pending;
+        std::unordered_map<SRTSOCKET, Stream*> streams;
+        std::vector<Shard*>* shards = nullptr;
+        std::function<Stream*(SRTSOCKET, const std::string&)> create_stream;
+        size_t next_shard = 0;
+        std::thread thread;
+
+        void TakePending()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (Stream* stream : pending)
+                streams[stream->sock] = stream;
+            pending.clear();
+        }
+
+        // 대기 중인 연결이 더 있으면 epoll이 다시 알려줌 (레벨 트리거)
+        void Accept()
+        {
+            sockaddr_storage addr;
+            int addr_len = sizeof(addr);
+            const SRTSOCKET sock = srt_accept(listener, (sockaddr*)&addr, &addr_len);
+            if (sock == SRT_INVALID_SOCK)
+                return;
+
+            char host[64] = "?";
+            int port = 0;
+            if (addr.ss_family == AF_INET)
+            {
+                const sockaddr_in* sin = (const sockaddr_in*)&addr;
+                inet_ntop(AF_INET, &sin->sin_addr, host, sizeof(host));
+                port = ntohs(sin->sin_port);
+            }
+            Stream* stream = create_stream(sock, std::string(host) + ":" + std::to_string(port));
+            (*shards)[next_shard++ % shards->size()]->Add(stream);
+        }
+
+        void Close(Stream& stream, const char* reason)
+        {
+            SRT_TRACEBSTATS stats;
+            if (srt_bstats(stream.sock, &stats, 0) == 0)
+            {
+                stream.srt_loss = stats.pktRcvLossTotal;
+                stream.srt_drop = stats.pktRcvDropTotal;
+                stream.srt_rtt_ms = stats.msRTT;
+            }
+            srt_close(stream.sock);  // 닫으면 epoll에서도 빠짐
+            stream.demux->Flush();
+            stream.open = false;
+            if (reason)
+                stream.error = reason;
+        }
+
+        void Receive(Stream& stream)
+        {
+            char buffer[1500];
+            while (stream.open)
+            {
+                SRT_MSGCTRL control = srt_msgctrl_default;
+                const int received = srt_recvmsg2(stream.sock, buffer, sizeof(buffer), &control);
+                if (received == SRT_ERROR)
+                {
+                    if (srt_getlasterror(nullptr) != SRT_EASYNCRCV)
+                        Close(stream, srt_getlasterror_str());
+                    return;
+                }
+                if (received == 0)
+                    return;
+
+                const int64_t now_ns = NowNs();
+                if (stream.start_ns == 0)
+                    stream.start_ns = now_ns;
+                stream.analyzer.Feed((const uint8_t*)buffer, (size_t)received, (now_ns - stream.start_ns) * 27 / 1000);
+                stream.demux->Feed((const uint8_t*)buffer, (size_t)received, now_ns, NowUtcUs());
+                stream.bytes += (uint64_t)received;
+            }
+        }
+
+        void Run()
+        {
+            std::vector<SRT_EPOLL_EVENT> events(256);
+            while (!g_stop)
+            {
+                TakePending();
+                const int count = srt_epoll_uwait(eid, events.data(), (int)events.size(), 100);
+                for (int i = 0; i < count; i++)
+                {
+                    const SRTSOCKET sock = events[i].fd;
+                    if (sock == listener)
+                    {
+                        Accept();
+                        continue;
+                    }
+
+                    auto it = streams.find(sock);
+                    if (it == streams.end())
+                    {
+                        TakePending();
+                        it = streams.find(sock);
+                        if (it == streams.end())
+                            continue;
+                    }
+
+                    Stream& stream = *it->second;
+                    if (events[i].events & SRT_EPOLL_IN)
+                        Receive(stream);
+                    if (stream.open && (events[i].events & SRT_EPOLL_ERR))
+                        Close(stream, "connection closed");
+                    if (!stream.open)
+                        streams.erase(it);
+                }
+            }
+
+            TakePending();
+            for (auto& entry : streams)
+                Close(*entry.second, nullptr);
+            streams.clear();
+        }
+    };
+
+    bool ApplyOptions(SRTSOCKET sock, const Options& opt)
+    {
+        int live = SRTT_LIVE;
+        int messageapi = 1;  // 송신 측과 동일 - 수신 한 번에 1316바이트 메시지 하나
+        int latency = opt.latency_ms;
+        int tsbpd = opt.tsbpd ? 1 : 0;
+        bool ok = srt_setsockopt(sock, 0, SRTO_TRANSTYPE, &live, sizeof(live)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_MESSAGEAPI, &messageapi, sizeof(messageapi)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_TSBPDMODE, &tsbpd, sizeof(tsbpd)) == 0 &&
+                  srt_setsockopt(sock, 0, SRTO_LATENCY, &latency, sizeof(latency)) == 0;
+        if (ok && !opt.passphrase.empty())
+            ok = srt_setsockopt(sock, 0, SRTO_PASSPHRASE, opt.passphrase.c_str(), (int)opt.passphrase.size()) == 0;
+        return ok;
+    }
+
+    SRTSOCKET Connect(const Options& opt, const std::string& host, int port, std::string& error)
+    {
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET, host.c_str(), &sa.sin_addr) != 1)
+        {
+            error = "invalid host " + host;
+            return SRT_INVALID_SOCK;
+        }
+
+        SRTSOCKET sock = srt_create_socket();
+        if (!ApplyOptions(sock, opt) || srt_connect(sock, (sockaddr*)&sa, sizeof(sa)) == SRT_ERROR)
+        {
+            error = srt_getlasterror_str();
+            srt_close(sock);
+            return SRT_INVALID_SOCK;
+        }
+
+        // 접속 후 수신은 논블로킹 (epoll)
+        int sync = 0;
+        srt_setsockopt(sock, 0, SRTO_RCVSYN, &sync, sizeof(sync));
+        return sock;
+    }
+
+    struct TrackReport
+    {
+        std::string name;
+        uint64_t frames = 0;
+        uint64_t keyframes = 0;
+        uint64_t corrupt = 0;
+        uint64_t lost = 0;
+        uint64_t late = 0;
+        double fps = 0.0;
+        double kbps = 0.0;
+        double interval_ms = 0.0;
+        double jitter_mean_ms = 0.0, jitter_p95_ms = 0.0, jitter_max_ms = 0.0;
+        double lateness_max_ms = 0.0;
+        uint64_t latency_samples = 0;
+        double latency_min_ms = 0.0, latency_p50_ms = 0.0, latency_p95_ms = 0.0, latency_p99_ms = 0.0, latency_max_ms = 0.0;
+        uint64_t latency_negative = 0;    // 캡처보다 먼저 도착 = 시계 오차 (synced)
+        Histogram latency_histogram;
+        uint64_t decoded = 0;
+        uint64_t decode_errors = 0;
+        double decode_mean_ms = 0.0, decode_p95_ms = 0.0, decode_max_ms = 0.0;
+    };
+
+    TrackReport AnalyzeTrack(const Options& opt, const std::string& name, const Track& track)
+    {
+        TrackReport r;
+        r.name = name;
+        r.frames = track.frames.size();
+        r.decode_errors = track.decode_errors;
+        if (track.frames.empty())
+            return r;
+
+        std::vector<double> deltas;
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < track.frames.size(); i++)
+        {
+            const FrameRecord& f = track.frames[i];
+            bytes += f.bytes;
+            r.keyframes += f.keyframe ? 1 : 0;
+            r.corrupt += f.corrupt ? 1 : 0;
+            if (i > 0 && f.dts > track.frames[i - 1].dts)
+                deltas.push_back((f.dts - track.frames[i - 1].dts) / 90.0);
+        }
+        r.interval_ms = Percentile(deltas, 0.5);
+
+        const double span_sec = (track.frames.back().arrival_ns - track.frames.front().arrival_ns) / 1e9;
+        if (span_sec > 0.0)
+        {
+            r.fps = (track.frames.size() - 1) / span_sec;
+            r.kbps = bytes * 8.0 / 1000.0 / span_sec;
+        }
+
+        // 도착 - DTS 오프셋의 최솟값이 기준 (가장 빨리 온 프레임)
+        double best_offset = 1e300;
+        for (const FrameRecord& f : track.frames)
+            best_offset = std::min(best_offset, f.arrival_ns / 1e6 - f.dts / 90.0);
+
+        std::vector<double> jitter, latency, decode;
+        for (size_t i = 0; i < track.frames.size(); i++)
+        {
+            const FrameRecord& f = track.frames[i];
+            const double lateness = f.arrival_ns / 1e6 - f.dts / 90.0 - best_offset;
+            r.lateness_max_ms = std::max(r.lateness_max_ms, lateness);
+            if (lateness > opt.late_ms)
+                r.late++;
+
+            if (i > 0)
+            {
+                const FrameRecord& prev = track.frames[i - 1];
+                const double dts_delta = (f.dts - prev.dts) / 90.0;
+                jitter.push_back(std::fabs((f.arrival_ns - prev.arrival_ns) / 1e6 - dts_delta));
+                if (r.interval_ms > 0.0 && dts_delta > r.interval_ms * 1.5)
+                    r.lost += (uint64_t)std::llround(dts_delta / r.interval_ms) - 1;
+            }
+            if (f.latency_us != INT64_MIN)
+                latency.push_back(f.latency_us / 1000.0);
+            if (f.decode_ms >= 0.0f)
+                decode.push_back(f.decode_ms);
+        }
+
+        r.jitter_mean_ms = Mean(jitter);
+        r.jitter_p95_ms = Percentile(jitter, 0.95);
+        r.jitter_max_ms = Percentile(jitter, 1.0);
+        r.latency_samples = latency.size();
+        r.latency_negative = (uint64_t)std::count_if(latency.begin(), latency.end(), [](double v) { return v < 0.0; });
+        if (opt.clock == "unsynced" && !latency.empty())
+        {
+            const double floor_ms = *std::min_element(latency.begin(), latency.end());
+            for (double& v : latency)
+                v -= floor_ms;
+            r.latency_negative = 0;
+        }
+        r.latency_histogram = BuildHistogram(latency, opt.bucket_ms);
+        r.latency_min_ms = Percentile(latency, 0.0);
+        r.latency_p50_ms = Percentile(latency, 0.5);
+        r.latency_p95_ms = Percentile(latency, 0.95);
+        r.latency_p99_ms = Percentile(latency, 0.99);
+        r.latency_max_ms = Percentile(latency, 1.0);
+        r.decoded = decode.size();
+        r.decode_mean_ms = Mean(decode);
+        r.decode_p95_ms = Percentile(decode, 0.95);
+        r.decode_max_ms = Percentile(decode, 1.0);
+        return r;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: srt_monitor [--count=N] [--threads=N] [--duration=S] [--latency=MS] [--no-tsbpd]" << std::endl
+                  << "                   [--passphrase=P] [--decode] [--late-ms=M] [--interval=S] [--json]" << std::endl
+                  << "                   [--clock=same-host|synced|unsynced] [--clock-offset-ms=X] [--bucket-ms=W]" << std::endl
+                  << "                   (--listen <port> | --connect <host:port> ...)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--listen" && i + 1 < argc)
+            opt.listen_port = atoi(argv[++i]);
+        else if (arg == "--connect" && i + 1 < argc)
+        {
+            const std::string target = argv[++i];
+            const size_t colon = target.rfind(':');
+            if (colon == std::string::npos)
+            {
+                PrintUsage();
+                return 2;
+            }
+            opt.connect.emplace_back(target.substr(0, colon), atoi(target.c_str() + colon + 1));
+        }
+        else if (arg.rfind("--count=", 0) == 0)
+            opt.count = atoi(arg.c_str() + 8);
+        else if (arg.rfind("--threads=", 0) == 0)
+            opt.threads = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--duration=", 0) == 0)
+            opt.duration_sec = atof(arg.c_str() + 11);
+        else if (arg.rfind("--latency=", 0) == 0)
+            opt.latency_ms = atoi(arg.c_str() + 10);
+        else if (arg == "--no-tsbpd")
+            opt.tsbpd = false;
+        else if (arg.rfind("--passphrase=", 0) == 0)
+            opt.passphrase = arg.substr(13);
+        else if (arg == "--decode")
+            opt.decode = true;
+        else if (arg.rfind("--late-ms=", 0) == 0)
+            opt.late_ms = atof(arg.c_str() + 10);
+        else if (arg.rfind("--interval=", 0) == 0)
+            opt.interval_sec = atof(arg.c_str() + 11);
+        else if (arg == "--json")
+            opt.json = true;
+        else if (arg.rfind("--clock=", 0) == 0)
+            opt.clock = arg.substr(8);
+        else if (arg.rfind("--clock-offset-ms=", 0) == 0)
+            opt.clock_offset_ms = atof(arg.c_str() + 18);
+        else if (arg.rfind("--bucket-ms=", 0) == 0)
+            opt.bucket_ms = atof(arg.c_str() + 12);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if ((opt.listen_port == 0) == opt.connect.empty() || opt.count <= 0 || opt.threads <= 0 || opt.bucket_ms <= 0.0 ||
+        (opt.clock != "same-host" && opt.clock != "synced" && opt.clock != "unsynced"))
+    {
+        PrintUsage();
+        return 2;
+    }
+#ifndef WITH_FFMPEG
+    if (opt.decode)
+    {
+        std::cerr << "Decoding not available (build with -DWITH_FFMPEG=ON)" << std::endl;
+        return 2;
+    }
+#endif
+
+    srt_startup();
+    std::signal(SIGINT, OnSignal);
+
+    std::mutex streams_lock;
+    std::vector<std::unique_ptr<Stream>> streams;
+    auto create_stream = [&opt, &streams, &streams_lock](SRTSOCKET sock, const std::string& name)
+    {
+        std::unique_ptr<Stream> stream(new Stream());
+        Stream* raw = stream.get();
+        raw->sock = sock;
+        raw->name = name;
+        raw->demux.reset(new demux::VideoDemux([&opt, raw](const demux::AccessUnit& au) { OnAccessUnit(opt, *raw, au); }));
+        std::lock_guard<std::mutex> guard(streams_lock);
+        streams.push_back(std::move(stream));
+        return raw;
+    };
+
+    SRTSOCKET listener = SRT_INVALID_SOCK;
+    if (opt.listen_port != 0)
+    {
+        listener = srt_create_socket();
+        int sync = 0;
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)opt.listen_port);
+        sa.sin_addr.s_addr = INADDR_ANY;
+        if (!ApplyOptions(listener, opt) ||
+            srt_setsockopt(listener, 0, SRTO_RCVSYN, &sync, sizeof(sync)) != 0 ||
+            srt_bind(listener, (sockaddr*)&sa, sizeof(sa)) != 0 ||
+            srt_listen(listener, 64) != 0)
+        {
+            std::cerr << "Bind/listen failed: " << srt_getlasterror_str() << std::endl;
+            srt_close(listener);
+            srt_cleanup();
+            return 2;
+        }
+        std::cerr << "Listening on port " << opt.listen_port << "..." << std::endl;
+    }
+
+    std::vector<std::unique_ptr<Shard>> shard_storage;
+    std::vector<Shard*> shards;
+    for (int i = 0; i < opt.threads; i++)
+    {
+        shard_storage.emplace_back(new Shard(opt, i == 0 ? listener : SRT_INVALID_SOCK));
+        shards.push_back(shard_storage.back().get());
+    }
+
+    // 접속 (Listener 모드 송신기) - 스레드에 고르게 분배
+    size_t next_shard = 0;
+    for (const auto& target : opt.connect)
+    {
+        for (int n = 0; n < opt.count; n++)
+        {
+            std::string error;
+            const SRTSOCKET sock = Connect(opt, target.first, target.second, error);
+            if (sock == SRT_INVALID_SOCK)
+            {
+                std::cerr << "Connect " << target.first << ":" << target.second << " failed: " << error << std::endl;
+                continue;
+            }
+            const std::string name = target.first + ":" + std::to_string(target.second) +
+                                     (opt.count > 1 ? "#" + std::to_string(n) : "");
+            shards[next_shard++ % shards.size()]->Add(create_stream(sock, name));
+        }
+    }
+    if (!opt.connect.empty() && next_shard == 0)
+    {
+        srt_cleanup();
+        return 2;
+    }
+
+    for (Shard* shard : shards)
+        shard->Start(&shards, create_stream);
+
+    // 진행 상황
+    const auto start = Clock::now();
+    auto last_print = start;
+    uint64_t last_frames = 0, last_bytes = 0;
+    while (!g_stop)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto now = Clock::now();
+        if (opt.duration_sec > 0.0 && std::chrono::duration<double>(now - start).count() >= opt.duration_sec)
+            break;
+        if (opt.interval_sec <= 0.0 || std::chrono::duration<double>(now - last_print).count() < opt.interval_sec)
+            continue;
+
+        uint64_t frames = 0, bytes = 0;
+        int open = 0, total = 0;
+        int64_t worst_latency_us = INT64_MIN;
+        {
+            std::lock_guard<std::mutex> guard(streams_lock);
+            for (const auto& stream : streams)
+            {
+                total++;
+                open += stream->open ? 1 : 0;
+                frames += stream->frames;
+                bytes += stream->bytes;
+                worst_latency_us = std::max(worst_latency_us, stream->last_latency_us.load());
+            }
+        }
+        const double seconds = std::chrono::duration<double>(now - last_print).count();
+        char latency[32] = "n/a";
+        if (worst_latency_us != INT64_MIN && opt.clock != "unsynced")
+            snprintf(latency, sizeof(latency), "%.1f ms", worst_latency_us / 1000.0);
+        fprintf(stderr, "[%6.1fs] streams %d/%d  %7.1f fps  %9.0f kbps  worst latency %s\n",
+            std::chrono::duration<double>(now - start).count(), open, total,
+            (frames - last_frames) / seconds, (bytes - last_bytes) * 8.0 / 1000.0 / seconds, latency);
+        last_frames = frames;
+        last_bytes = bytes;
+        last_print = now;
+    }
+
+    g_stop = true;
+    for (Shard* shard : shards)
+        shard->Join();
+    shard_storage.clear();
+    if (listener != SRT_INVALID_SOCK)
+        srt_close(listener);
+    srt_cleanup();
+
+    // 결과 (트랙 = 스트림 안의 비디오 PID 하나, MPTS면 프로그램마다)
+    bool ok = !streams.empty();
+    std::vector<std::string> stream_json;
+    if (!opt.json)
+    {
+        printf("\n%-24s %7s %6s %6s %5s %5s %14s %22s %16s %4s %5s %6s\n", "track", "frames", "fps", "kbps", "lost", "late",
+            "jitter p95/max", opt.clock == "unsynced" ? "+latency p50/p95/p99" : "latency p50/p95/p99",
+            "decode mean/p95", "P1", "loss", "drop");
+    }
+    std::vector<std::pair<std::string, Histogram>> histograms;
+    for (const auto& stream : streams)
+    {
+        const ts::Report ts_report = stream->analyzer.Finish();
+        if (stream->tracks.empty() || ts_report.errors.Priority1() > 0)
+            ok = false;
+
+        for (const auto& entry : stream->tracks)
+        {
+            const std::string name = stream->name + (stream->tracks.size() > 1 ? "/p" + std::to_string(entry.second.program) : "");
+            const TrackReport r = AnalyzeTrack(opt, name, entry.second);
+            if (r.frames == 0 || r.lost > 0)
+                ok = false;
+
+            if (opt.json)
+            {
+                std::string counts;
+                for (size_t i = 0; i < r.latency_histogram.counts.size(); i++)
+                    counts += (i ? "," : "") + std::to_string(r.latency_histogram.counts[i]);
+                char histogram[128];
+                snprintf(histogram, sizeof(histogram), "\"histogram\":{\"start_ms\":%.3f,\"bucket_ms\":%.3f,\"counts\":[",
+                    r.latency_histogram.start_ms, r.latency_histogram.bucket_ms);
+
+                std::vector<char> json(2048 + counts.size());
+                snprintf(json.data(), json.size(),
+                    "{\"track\":\"%s\",\"pid\":%d,\"program\":%d,\"codec\":\"%s\",\"frames\":%llu,\"keyframes\":%llu,\"fps\":%.3f,\"kbps\":%.1f,"
+                    "\"frame_interval_ms\":%.3f,\"lost\":%llu,\"corrupt\":%llu,\"late\":%llu,\"lateness_max_ms\":%.3f,"
+                    "\"jitter_ms\":{\"mean\":%.3f,\"p95\":%.3f,\"max\":%.3f},"
+                    "\"latency_ms\":{\"clock\":\"%s\",\"offset_ms\":%.3f,\"samples\":%llu,\"negative\":%llu,"
+                    "\"min\":%.3f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f,%s%s]}},"
+                    "\"decode_ms\":{\"frames\":%llu,\"errors\":%llu,\"mean\":%.3f,\"p95\":%.3f,\"max\":%.3f},"
+                    "\"ts_priority1\":%llu,\"ts_cc_errors\":%llu,\"srt_loss\":%lld,\"srt_drop\":%lld,\"rtt_ms\":%.3f,\"error\":\"%s\"}",
+                    name.c_str(), entry.second.pid, entry.second.program, entry.second.hevc ? "hevc" : "h264",
+                    (unsigned long long)r.frames, (unsigned long long)r.keyframes, r.fps, r.kbps,
+                    r.interval_ms, (unsigned long long)r.lost, (unsigned long long)r.corrupt, (unsigned long long)r.late, r.lateness_max_ms,
+                    r.jitter_mean_ms, r.jitter_p95_ms, r.jitter_max_ms,
+                    opt.clock.c_str(), opt.clock_offset_ms, (unsigned long long)r.latency_samples, (unsigned long long)r.latency_negative,
+                    r.latency_min_ms, r.latency_p50_ms, r.latency_p95_ms, r.latency_p99_ms, r.latency_max_ms, histogram, counts.c_str(),
+                    (unsigned long long)r.decoded, (unsigned long long)r.decode_errors, r.decode_mean_ms, r.decode_p95_ms, r.decode_max_ms,
+                    (unsigned long long)ts_report.errors.Priority1(), (unsigned long long)ts_report.errors.continuity_count_error,
+                    (long long)stream->srt_loss, (long long)stream->srt_drop, stream->srt_rtt_ms, stream->error.c_str());
+                stream_json.push_back(json.data());
+                continue;
+            }
+
+            char latency[48] = "n/a";
+            if (r.latency_samples > 0)
+                snprintf(latency, sizeof(latency), "%.1f/%.1f/%.1f", r.latency_p50_ms, r.latency_p95_ms, r.latency_p99_ms);
+            char decode[32] = "n/a";
+            if (r.decoded > 0)
+                snprintf(decode, sizeof(decode), "%.2f/%.2f", r.decode_mean_ms, r.decode_p95_ms);
+            printf("%-24s %7llu %6.2f %6.0f %5llu %5llu %6.2f/%-7.2f %22s %16s %4llu %5lld %6lld\n",
+                name.c_str(), (unsigned long long)r.frames, r.fps, r.kbps, (unsigned long long)r.lost, (unsigned long long)r.late,
+                r.jitter_p95_ms, r.jitter_max_ms, latency, decode, (unsigned long long)ts_report.errors.Priority1(),
+                (long long)stream->srt_loss, (long long)stream->srt_drop);
+            if (r.latency_negative > 0)
+                printf("  %s: %llu frames arrived before capture - clock sync error exceeds the transport floor\n",
+                    name.c_str(), (unsigned long long)r.latency_negative);
+            if (r.latency_samples > 0)
+                histograms.emplace_back(name, r.latency_histogram);
+        }
+        if (!opt.json && !stream->error.empty())
+            printf("  %s: %s\n", stream->name.c_str(), stream->error.c_str());
+    }
+
+    for (const auto& entry : histograms)
+    {
+        printf("\n%s\n", entry.first.c_str());
+        PrintHistogram(entry.second, opt.clock == "unsynced" ? "latency above minimum" : "capture-to-arrival latency");
+    }
+
+    if (opt.json)
+    {
+        printf("{\"tracks\":[\n");
+        for (size_t i = 0; i < stream_json.size(); i++)
+            printf("%s%s\n", stream_json[i].c_str(), i + 1 < stream_json.size() ? "," : "");
+        printf("],\"pass\":%s}\n", ok ? "true" : "false");
+    }
+    else
+    {
+        printf("\n%s\n", ok ? "PASS" : "FAIL");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// video_demux.cpp - TS 비디오 액세스 유닛 추출
+
+#include "video_demux.h"
+
+#include <cstring>
+
+namespace demux
+{
+    namespace
+    {
+        int64_t ReadTimestamp(const uint8_t* p)
+        {
+            return ((int64_t)((p[0] >> 1) & 0x07) << 30) | ((int64_t)p[1] << 22) |
+                   ((int64_t)(p[2] >> 1) << 15) | ((int64_t)p[3] << 7) | (p[4] >> 1);
+        }
+    }
+
+    void VideoDemux::Feed(const uint8_t* data, size_t size, int64_t arrival_ns, int64_t arrival_utc_us)
+    {
+        // 이전 호출에서 남은 조각 채우기
+        if (carry_len > 0)
+        {
+            const size_t need = PacketSize - carry_len;
+            const size_t take = size < need ? size : need;
+            memcpy(carry + carry_len, data, take);
+            carry_len += take;
+            data += take;
+            size -= take;
+            if (carry_len < (size_t)PacketSize)
+                return;
+            if (carry[0] == 0x47)
+                ProcessPacket(carry, arrival_ns, arrival_utc_us);
+            carry_len = 0;
+        }
+
+        size_t pos = 0;
+        while (pos < size)
+        {
+            if (data[pos] != 0x47)
+            {
+                pos++;  // 재동기화
+                continue;
+            }
+            if (size - pos < (size_t)PacketSize)
+            {
+                memcpy(carry, data + pos, size - pos);
+                carry_len = size - pos;
+                return;
+            }
+            ProcessPacket(data + pos, arrival_ns, arrival_utc_us);
+            pos += PacketSize;
+        }
+    }
+
+    void VideoDemux::ProcessPacket(const uint8_t* p, int64_t arrival_ns, int64_t arrival_utc_us)
+    {
+        if (p[1] & 0x80)
+            return;  // transport_error_indicator
+
+        const bool pusi = (p[1] & 0x40) != 0;
+        const int pid = ((p[1] & 0x1F) << 8) | p[2];
+        const int afc = (p[3] >> 4) & 0x03;
+        const int cc = p[3] & 0x0F;
+
+        int offset = 4;
+        if (afc & 0x02)
+            offset += 1 + p[4];
+        if (!(afc & 0x01) || offset >= PacketSize)
+            return;
+
+        const uint8_t* payload = p + offset;
+        const int len = PacketSize - offset;
+
+        if (pid == 0 || pmt_pids.count(pid))
+        {
+            if (pusi)
+                ProcessSection(pid, payload, len);
+            return;
+        }
+
+        auto it = tracks.find(pid);
+        if (it == tracks.end())
+            return;
+        Track& track = it->second;
+
+        if (track.last_cc >= 0 && cc != ((track.last_cc + 1) & 0x0F))
+        {
+            if (cc == track.last_cc)
+                return;  // 중복 패킷
+            cc_errors++;
+            track.corrupt = true;
+        }
+        track.last_cc = (int8_t)cc;
+
+        if (pusi)
+        {
+            if (!track.pes.empty())
+                Complete(pid, track);
+            if (len >= 6 && payload[0] == 0 && payload[1] == 0 && payload[2] == 1)
+            {
+                const size_t pes_length = ((size_t)payload[4] << 8) | payload[5];
+                track.expected = pes_length ? pes_length + 6 : 0;
+            }
+        }
+        else if (track.pes.empty())
+        {
+            return;  // PES 시작 전 (접속 직후)
+        }
+
+        track.pes.insert(track.pes.end(), payload, payload + len);
+        track.arrival_ns = arrival_ns;
+        track.arrival_utc_us = arrival_utc_us;
+
+        if (track.expected != 0 && track.pes.size() >= track.expected)
+        {
+            track.pes.resize(track.expected);
+            Complete(pid, track);
+        }
+    }
+
+    void VideoDemux::ProcessSection(int pid, const uint8_t* payload, int len)
+    {
+        // 섹션은 패킷 하나에 들어간다고 가정 (PAT/PMT는 프로그램 수십 개까지 184바이트 안)
+        const int pointer = payload[0];
+        if (1 + pointer + 3 > len)
+            return;
+        const uint8_t* s = payload + 1 + pointer;
+        const int avail = len - 1 - pointer;
+        const int section_length = ((s[1] & 0x0F) << 8) | s[2];
+        if (3 + section_length > avail || section_length < 9)
+            return;
+        const int end = 3 + section_length - 4;  // CRC 제외
+
+        if (pid == 0 && s[0] == 0x00)
+        {
+            for (int i = 8; i + 4 <= end; i += 4)
+            {
+                const int program = (s[i] << 8) | s[i + 1];
+                const int pmt_pid = ((s[i + 2] & 0x1F) << 8) | s[i + 3];
+                if (program != 0)
+                    pmt_pids[pmt_pid] = program;
+            }
+        }
+        else if (s[0] == 0x02 && section_length >= 13)
+        {
+            const int program = pmt_pids[pid];
+            const int program_info_length = ((s[10] & 0x0F) << 8) | s[11];
+            for (int i = 12 + program_info_length; i + 5 <= end;)
+            {
+                const uint8_t stream_type = s[i];
+                const int es_pid = ((s[i + 1] & 0x1F) << 8) | s[i + 2];
+                const int es_info_length = ((s[i + 3] & 0x0F) << 8) | s[i + 4];
+                if ((stream_type == 0x1B || stream_type == 0x24) && !tracks.count(es_pid))
+                {
+                    Track& track = tracks[es_pid];
+                    track.program = program;
+                    track.hevc = stream_type == 0x24;
+                }
+                i += 5 + es_info_length;
+            }
+        }
+    }
+
+    void VideoDemux::Complete(int pid, Track& track)
+    {
+        const uint8_t* pes = track.pes.data();
+        const size_t size = track.pes.size();
+
+        if (size >= 9 && pes[0] == 0 && pes[1] == 0 && pes[2] == 1)
+        {
+            const int flags = pes[7] >> 6;
+            const size_t header_end = 9 + (size_t)pes[8];
+            if (header_end <= size)
+            {
+                AccessUnit au;
+                au.pid = pid;
+                au.program = track.program;
+                au.hevc = track.hevc;
+                if ((flags & 0x02) && size >= 14)
+                    au.pts = ReadTimestamp(pes + 9);
+                au.dts = ((flags & 0x03) == 0x03 && size >= 19) ? ReadTimestamp(pes + 14) : au.pts;
+                au.arrival_ns = track.arrival_ns;
+                au.arrival_utc_us = track.arrival_utc_us;
+                au.corrupt = track.corrupt;
+                au.data = pes + header_end;
+                au.size = size - header_end;
+                au.info = capture_sei::Scan(au.data, au.size, au.hevc);
+                on_access_unit(au);
+            }
+        }
+
+        track.pes.clear();
+        track.expected = 0;
+        track.corrupt = false;
+    }
+
+    void VideoDemux::Flush()
+    {
+        for (auto& entry : tracks)
+        {
+            if (!entry.second.pes.empty())
+                Complete(entry.first, entry.second);
+        }
+    }
+}
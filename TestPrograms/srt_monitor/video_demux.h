@@ -0,0 +1,76 @@
+// video_demux.h - TS에서 비디오 액세스 유닛 추출 (수신 모니터용 경량 역다중화기)
+//
+// PAT → PMT로 H.264/HEVC PID를 찾고 PES를 모아 액세스 유닛(Annex B) 단위로 넘긴다.
+// MPTS(공유 연결)면 프로그램마다 비디오 PID가 따로 나온다.
+// PES_packet_length가 있으면 길이가 찬 즉시, 0이면(비디오 보통) 다음 PES 시작에서 완성된다.
+// 도착 시각은 그 액세스 유닛의 마지막 TS 패킷이 들어온 시각 (다음 PES 시작까지 기다린 시간은 포함 안 함).
+
+#pragma once
+
+#include "capture_sei.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace demux
+{
+    constexpr int PacketSize = 188;
+    constexpr int64_t NoTime = -1;
+
+    struct AccessUnit
+    {
+        int pid = 0;
+        int program = 0;
+        bool hevc = false;
+        int64_t pts = NoTime;          // 90kHz
+        int64_t dts = NoTime;          // 없으면 PTS와 같음
+        int64_t arrival_ns = 0;        // 마지막 패킷 도착 (steady clock)
+        int64_t arrival_utc_us = 0;    // 같은 시점의 시스템 시계 (캡처 SEI와 비교)
+        bool corrupt = false;          // 이 액세스 유닛 안에서 CC 불연속
+        const uint8_t* data = nullptr; // ES (Annex B)
+        size_t size = 0;
+        capture_sei::AccessUnitInfo info;
+    };
+
+    class VideoDemux
+    {
+    public:
+        using Callback = std::function<void(const AccessUnit&)>;
+
+        explicit VideoDemux(Callback callback) : on_access_unit(std::move(callback)) {}
+
+        // 연속된 TS 바이트 (패킷 경계가 아니어도 됨)
+        void Feed(const uint8_t* data, size_t size, int64_t arrival_ns, int64_t arrival_utc_us);
+        // 남은 PES를 액세스 유닛으로 내보냄 (연결 종료 시)
+        void Flush();
+
+        uint64_t GetCCErrors() const { return cc_errors; }
+
+    private:
+        struct Track
+        {
+            int program = 0;
+            bool hevc = false;
+            int8_t last_cc = -1;
+            std::vector<uint8_t> pes;  // 헤더 포함 PES
+            size_t expected = 0;       // PES_packet_length + 6 (0 = 길이 미정)
+            bool corrupt = false;
+            int64_t arrival_ns = 0;
+            int64_t arrival_utc_us = 0;
+        };
+
+        Callback on_access_unit;
+        std::map<int, int> pmt_pids;       // PMT PID → program_number
+        std::map<int, Track> tracks;       // 비디오 PID → 상태
+        uint8_t carry[PacketSize];
+        size_t carry_len = 0;
+        uint64_t cc_errors = 0;
+
+        void ProcessPacket(const uint8_t* p, int64_t arrival_ns, int64_t arrival_utc_us);
+        void ProcessSection(int pid, const uint8_t* payload, int len);
+        void Complete(int pid, Track& track);
+    };
+}
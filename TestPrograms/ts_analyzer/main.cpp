@@ -0,0 +1,251 @@
+// main.cpp - ts_analyzer 명령줄 도구
+//
+// 사용법:
+//   ts_analyzer [옵션] <capture.ts>
+//   ts_analyzer [옵션] --srt <port>        (WITH_SRT 빌드에서만)
+//
+// 옵션:
+//   --json          결과를 JSON으로 출력
+//   --fail-on=N     N순위(1 또는 2) 이하 에러가 있으면 종료 코드 1 (기본 1, 0이면 항상 0)
+//   --duration=S    SRT 입력 시 S초 후 종료 (기본: 연결 종료까지)
+//
+// CI에서 먹서 변경을 검증할 때 종료 코드로 판정한다.
+
+#include "ts_analyzer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef WITH_SRT
+#include "srt.h"
+#endif
+
+namespace
+{
+    // 한 번에 넘기는 크기 (배치 파싱, 188의 배수)
+    constexpr size_t BatchSize = 188 * 7 * 1024;
+
+    bool AnalyzeFile(const char* path, ts::Analyzer& analyzer)
+    {
+#if !defined(_WIN32)
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "Cannot open " << path << std::endl;
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        const size_t size = (size_t)st.st_size;
+        if (size == 0)
+        {
+            close(fd);
+            return true;
+        }
+
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            const uint8_t* data = (const uint8_t*)mapped;
+            for (size_t pos = 0; pos < size; pos += BatchSize)
+            {
+                const size_t len = (size - pos < BatchSize) ? size - pos : BatchSize;
+                analyzer.Feed(data + pos, len);
+            }
+            munmap(mapped, size);
+            close(fd);
+            return true;
+        }
+        close(fd);
+        // mmap 실패 시 일반 읽기로 진행
+#endif
+
+        FILE* file = fopen(path, "rb");
+        if (!file)
+        {
+            std::cerr << "Cannot open " << path << std::endl;
+            return false;
+        }
+
+        std::vector<uint8_t> buffer(BatchSize);
+        size_t read_bytes;
+        while ((read_bytes = fread(buffer.data(), 1, buffer.size(), file)) > 0)
+        {
+            analyzer.Feed(buffer.data(), read_bytes);
+        }
+        fclose(file);
+        return true;
+    }
+
+#ifdef WITH_SRT
+    bool AnalyzeSRT(int port, double duration_sec, ts::Analyzer& analyzer)
+    {
+        srt_startup();
+
+        SRTSOCKET listener = srt_create_socket();
+        int messageapi = 1;  // 메시지 모드 (송신 측과 동일, 수신 한 번에 1316바이트 메시지 하나)
+        srt_setsockopt(listener, 0, SRTO_MESSAGEAPI, &messageapi, sizeof(messageapi));
+
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons((uint16_t)port);
+        sa.sin_addr.s_addr = INADDR_ANY;
+
+        if (srt_bind(listener, (sockaddr*)&sa, sizeof(sa)) != 0 || srt_listen(listener, 1) != 0)
+        {
+            std::cerr << "Bind/listen failed: " << srt_getlasterror_str() << std::endl;
+            srt_close(listener);
+            srt_cleanup();
+            return false;
+        }
+
+        std::cerr << "Listening on port " << port << "..." << std::endl;
+
+        sockaddr_storage client_addr;
+        int addr_len = sizeof(client_addr);
+        SRTSOCKET client = srt_accept(listener, (sockaddr*)&client_addr, &addr_len);
+        if (client == SRT_INVALID_SOCK)
+        {
+            std::cerr << "Accept failed: " << srt_getlasterror_str() << std::endl;
+            srt_close(listener);
+            srt_cleanup();
+            return false;
+        }
+
+        std::cerr << "Client connected" << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<char> buffer(1316 * 8);
+        while (true)
+        {
+            int received = srt_recv(client, buffer.data(), (int)buffer.size());
+            if (received <= 0)
+                break;
+
+            const auto now = std::chrono::steady_clock::now();
+            const int64_t arrival = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count() * 27 / 1000;
+            analyzer.Feed((const uint8_t*)buffer.data(), (size_t)received, arrival);
+
+            if (duration_sec > 0 && std::chrono::duration<double>(now - start).count() >= duration_sec)
+                break;
+        }
+
+        srt_close(client);
+        srt_close(listener);
+        srt_cleanup();
+        return true;
+    }
+#endif
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: ts_analyzer [--json] [--fail-on=N] <capture.ts>" << std::endl;
+#ifdef WITH_SRT
+        std::cerr << "       ts_analyzer [--json] [--fail-on=N] [--duration=S] --srt <port>" << std::endl;
+#endif
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    int fail_on = 1;
+    double duration_sec = 0.0;
+    int srt_port = 0;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--json")
+            json = true;
+        else if (arg.rfind("--fail-on=", 0) == 0)
+            fail_on = atoi(arg.c_str() + 10);
+        else if (arg.rfind("--duration=", 0) == 0)
+            duration_sec = atof(arg.c_str() + 11);
+        else if (arg == "--srt" && i + 1 < argc)
+            srt_port = atoi(argv[++i]);
+        else if (arg == "-h" || arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+            path = argv[i];
+    }
+
+    if (!path && srt_port == 0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    ts::Analyzer analyzer;
+    const auto start = std::chrono::steady_clock::now();
+
+    bool ok = false;
+    if (srt_port != 0)
+    {
+#ifdef WITH_SRT
+        ok = AnalyzeSRT(srt_port, duration_sec, analyzer);
+#else
+        (void)duration_sec;
+        std::cerr << "SRT input not available (build with -DWITH_SRT=ON)" << std::endl;
+        return 2;
+#endif
+    }
+    else
+    {
+        ok = AnalyzeFile(path, analyzer);
+    }
+
+    if (!ok)
+        return 2;
+
+    ts::Report report = analyzer.Finish();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (json)
+    {
+        std::cout << report.ToJson();
+    }
+    else
+    {
+        std::cout << report.ToText();
+        if (elapsed > 0.0)
+        {
+            char line[128];
+            snprintf(line, sizeof(line), "\nAnalyzed in %.3f s (%.1f MB/s, %.1fx real time)\n",
+                elapsed, report.total_bytes / elapsed / 1e6,
+                report.duration_sec > 0.0 ? report.duration_sec / elapsed : 0.0);
+            std::cout << line;
+        }
+    }
+
+    uint64_t failing = 0;
+    if (fail_on >= 1)
+        failing += report.errors.Priority1();
+    if (fail_on >= 2)
+        failing += report.errors.Priority2();
+    return failing > 0 ? 1 : 0;
+}
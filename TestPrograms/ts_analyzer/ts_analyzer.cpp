@@ -0,0 +1,694 @@
+// ts_analyzer.cpp - MPEG-TS 분석/검증 라이브러리 구현
+
+#include "ts_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace ts
+{
+    namespace
+    {
+        constexpr int64_t ClockHz = 27000000;          // PCR 27MHz
+        constexpr int64_t PCRWrap = (1LL << 33) * 300;  // 33비트 base * 300
+        constexpr int64_t PTSWrap = 1LL << 33;          // 90kHz 33비트
+
+        double TicksToMs(int64_t ticks) { return ticks * 1000.0 / ClockHz; }
+
+        int64_t ReadTimestamp(const uint8_t* p)
+        {
+            return ((int64_t)(p[0] & 0x0E) << 29) |
+                   ((int64_t)p[1] << 22) |
+                   ((int64_t)(p[2] & 0xFE) << 14) |
+                   ((int64_t)p[3] << 7) |
+                   ((int64_t)p[4] >> 1);
+        }
+
+        // 33비트 wrap을 풀어서 단조 증가하는 값으로 만든다
+        int64_t Unwrap(int64_t value, int64_t last, int64_t wrap)
+        {
+            if (last == NoTime)
+                return value;
+            int64_t base = last - (last % wrap);
+            int64_t candidate = base + value;
+            if (candidate < last - wrap / 2)
+                candidate += wrap;
+            else if (candidate > last + wrap / 2)
+                candidate -= wrap;
+            return candidate;
+        }
+
+        // 이벤트가 있을 때만 보내는 PID (SCTE-35, 타임드 메타데이터)는 PID 타임아웃 검사 제외
+        bool IsSparseStream(uint8_t stream_type)
+        {
+            return stream_type == 0x86 || stream_type == 0x15;
+        }
+
+        const char* KindName(bool is_pat, bool is_pmt, bool is_null, bool referenced)
+        {
+            if (is_pat) return "PAT";
+            if (is_pmt) return "PMT";
+            if (is_null) return "NULL";
+            if (referenced) return "ES";
+            return "UNREFERENCED";
+        }
+    }
+
+    uint32_t Crc32(const uint8_t* data, size_t len)
+    {
+        static uint32_t table[256];
+        static bool initialized = false;
+        if (!initialized)
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i << 24;
+                for (int j = 0; j < 8; j++)
+                    crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+                table[i] = crc;
+            }
+            initialized = true;
+        }
+
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < len; i++)
+            crc = (crc << 8) ^ table[((crc >> 24) ^ data[i]) & 0xFF];
+        return crc;
+    }
+
+    Analyzer::Analyzer(const Options& options)
+        : opts(options)
+    {
+        Reset();
+    }
+
+    void Analyzer::Reset()
+    {
+        pids.assign(MaxPID, PIDState());
+        errors = ErrorCounters();
+        carry_len = 0;
+        synced = false;
+        total_packets = 0;
+        total_bytes = 0;
+        timing_pid = -1;
+        time_ref_pcr = NoTime;
+        time_ref_byte = 0;
+        bytes_per_tick = 0.0;
+        first_pcr = NoTime;
+        first_pcr_byte = 0;
+        current_time = NoTime;
+        first_time = NoTime;
+        last_pat_time = NoTime;
+        max_pat_interval_ms = 0.0;
+        max_pmt_interval_ms = 0.0;
+        program_count = 0;
+    }
+
+    void Analyzer::Feed(const uint8_t* data, size_t size, int64_t arrival_27mhz)
+    {
+        size_t pos = 0;
+
+        // 이전 Feed에서 남은 조각 먼저 완성
+        if (carry_len > 0)
+        {
+            size_t need = PacketSize - carry_len;
+            size_t take = std::min(need, size);
+            memcpy(carry + carry_len, data, take);
+            carry_len += take;
+            pos = take;
+            if (carry_len < (size_t)PacketSize)
+                return;
+            carry_len = 0;
+            ProcessPacket(carry, arrival_27mhz);
+        }
+
+        int bad_sync_run = 0;
+        while (pos < size)
+        {
+            if (!synced)
+            {
+                // 다음 패킷 위치에도 sync가 있는 0x47을 찾는다
+                const uint8_t* found = nullptr;
+                for (size_t i = pos; i < size; i++)
+                {
+                    if (data[i] != SyncByte)
+                        continue;
+                    if (i + PacketSize < size && data[i + PacketSize] != SyncByte)
+                        continue;
+                    found = data + i;
+                    break;
+                }
+                if (!found)
+                    return;
+                pos = (size_t)(found - data);
+                synced = true;
+                bad_sync_run = 0;
+            }
+
+            if (size - pos < (size_t)PacketSize)
+            {
+                carry_len = size - pos;
+                memcpy(carry, data + pos, carry_len);
+                return;
+            }
+
+            if (data[pos] != SyncByte)
+            {
+                errors.sync_byte_error++;
+                if (++bad_sync_run >= 2)
+                {
+                    // 연속 2회 이상 sync 오류 → 동기 상실, 재탐색
+                    errors.ts_sync_loss++;
+                    synced = false;
+                    pos++;
+                    continue;
+                }
+                pos += PacketSize;
+                continue;
+            }
+
+            bad_sync_run = 0;
+            ProcessPacket(data + pos, arrival_27mhz);
+            pos += PacketSize;
+        }
+    }
+
+    int64_t Analyzer::EstimateTime() const
+    {
+        if (time_ref_pcr == NoTime)
+            return NoTime;
+        if (bytes_per_tick <= 0.0)
+            return time_ref_pcr;
+        return time_ref_pcr + (int64_t)((total_bytes - time_ref_byte) / bytes_per_tick);
+    }
+
+    void Analyzer::CheckTableInterval(int64_t& last, double limit_ms, double& max_ms, uint64_t& counter)
+    {
+        if (current_time == NoTime)
+            return;
+        if (last != NoTime)
+        {
+            double interval = TicksToMs(current_time - last);
+            max_ms = std::max(max_ms, interval);
+            if (interval > limit_ms)
+                counter++;
+        }
+        last = current_time;
+    }
+
+    void Analyzer::ProcessPacket(const uint8_t* p, int64_t arrival)
+    {
+        total_packets++;
+        total_bytes += PacketSize;
+
+        const bool tei = (p[1] & 0x80) != 0;
+        const bool pusi = (p[1] & 0x40) != 0;
+        const int pid = ((p[1] & 0x1F) << 8) | p[2];
+        const int afc = (p[3] >> 4) & 0x03;
+        const int cc = p[3] & 0x0F;
+
+        current_time = (arrival != NoTime) ? arrival : EstimateTime();
+        if (current_time != NoTime && first_time == NoTime)
+            first_time = current_time;
+
+        PIDState& st = pids[pid];
+        st.seen = true;
+        st.packets++;
+        if (current_time != NoTime)
+        {
+            if (st.first_time == NoTime)
+                st.first_time = current_time;
+            st.last_time = current_time;
+        }
+
+        if (tei)
+        {
+            errors.transport_error++;
+            return;
+        }
+
+        // Adaptation field
+        int payload_offset = 4;
+        bool discontinuity = false;
+        if (afc & 0x02)
+        {
+            const int af_len = p[4];
+            payload_offset = 5 + af_len;
+            if (af_len > 0)
+            {
+                const uint8_t flags = p[5];
+                discontinuity = (flags & 0x80) != 0;
+                if ((flags & 0x10) && af_len >= 7)
+                {
+                    int64_t base = ((int64_t)p[6] << 25) | ((int64_t)p[7] << 17) |
+                                   ((int64_t)p[8] << 9) | ((int64_t)p[9] << 1) | (p[10] >> 7);
+                    int64_t ext = ((p[10] & 0x01) << 8) | p[11];
+                    ProcessPCR(pid, st, base * 300 + ext, discontinuity);
+                }
+            }
+        }
+
+        // Continuity counter (NULL PID 제외, 페이로드 있는 패킷만 증가)
+        if (pid != 0x1FFF)
+        {
+            if (afc & 0x01)
+            {
+                if (st.last_cc >= 0 && !discontinuity)
+                {
+                    const int expected = (st.last_cc + 1) & 0x0F;
+                    if (cc == st.last_cc)
+                    {
+                        // ISO 13818-1: 중복 패킷은 연속 1개까지만 허용
+                        if (++st.cc_duplicates > 1)
+                        {
+                            errors.continuity_count_error++;
+                            st.cc_errors++;
+                        }
+                    }
+                    else
+                    {
+                        if (cc != expected)
+                        {
+                            errors.continuity_count_error++;
+                            st.cc_errors++;
+                        }
+                        st.cc_duplicates = 0;
+                    }
+                }
+                else
+                {
+                    st.cc_duplicates = 0;
+                }
+                st.last_cc = (int8_t)cc;
+            }
+            else if (st.last_cc >= 0 && cc != st.last_cc && !discontinuity)
+            {
+                errors.continuity_count_error++;
+                st.cc_errors++;
+            }
+        }
+
+        if (!(afc & 0x01) || payload_offset >= PacketSize)
+            return;
+
+        const uint8_t* payload = p + payload_offset;
+        const int payload_len = PacketSize - payload_offset;
+
+        if (pid == 0 || st.is_pmt)
+        {
+            ProcessSectionPayload(pid, st, payload, payload_len, pusi);
+        }
+        else if (pusi && pid != 0x1FFF)
+        {
+            ProcessPES(st, payload, payload_len);
+        }
+
+        // PID 타임아웃 검사 (1024 패킷마다)
+        if (current_time != NoTime && (total_packets & 0x3FF) == 0)
+        {
+            const int64_t timeout = (int64_t)(opts.pid_timeout_sec * ClockHz);
+            for (PIDState& s : pids)
+            {
+                if (s.referenced && !IsSparseStream(s.stream_type) &&
+                    s.last_time != NoTime && current_time - s.last_time > timeout)
+                {
+                    errors.pid_error++;
+                    s.last_time = current_time;  // 같은 공백을 반복 카운트하지 않음
+                }
+            }
+        }
+    }
+
+    void Analyzer::ProcessPCR(int pid, PIDState& st, int64_t pcr, bool discontinuity)
+    {
+        st.pcr_count++;
+
+        // 파일 입력용 시간 기준: 처음 PCR을 가진 PID
+        if (timing_pid < 0)
+            timing_pid = pid;
+
+        const uint64_t byte_pos = total_bytes - PacketSize;
+
+        if (st.last_pcr != NoTime && !discontinuity)
+        {
+            int64_t delta = pcr - st.last_pcr;
+            if (delta < -PCRWrap / 2)
+                delta += PCRWrap;
+
+            const double interval_ms = TicksToMs(delta);
+            if (delta < 0 || interval_ms > opts.pcr_max_jump_ms)
+            {
+                errors.pcr_discontinuity_error++;
+            }
+            else
+            {
+                st.max_pcr_interval_ms = std::max(st.max_pcr_interval_ms, interval_ms);
+                if (interval_ms > opts.pcr_max_interval_ms)
+                    errors.pcr_repetition_error++;
+
+                // PCR 정확도: 평균 TS 전송률로 예측한 값과의 차이
+                if (bytes_per_tick > 0.0)
+                {
+                    const double expected = (double)(byte_pos - st.last_pcr_byte) / bytes_per_tick;
+                    const double jitter_ns = std::fabs((double)delta - expected) * 1e9 / ClockHz;
+                    st.max_pcr_jitter_ns = std::max(st.max_pcr_jitter_ns, jitter_ns);
+                    if (jitter_ns > opts.pcr_accuracy_ns)
+                        errors.pcr_accuracy_error++;
+                }
+            }
+        }
+
+        st.last_pcr = pcr;
+        st.last_pcr_byte = byte_pos;
+
+        if (pid == timing_pid)
+        {
+            if (discontinuity || first_pcr == NoTime)
+            {
+                first_pcr = pcr;
+                first_pcr_byte = byte_pos;
+            }
+            else
+            {
+                int64_t span = pcr - first_pcr;
+                if (span < 0)
+                    span += PCRWrap;
+                if (span > 0)
+                    bytes_per_tick = (double)(byte_pos - first_pcr_byte) / (double)span;
+            }
+
+            time_ref_pcr = pcr;
+            time_ref_byte = byte_pos;
+        }
+    }
+
+    void Analyzer::ProcessPES(PIDState& st, const uint8_t* payload, int len)
+    {
+        if (len < 9 || payload[0] != 0x00 || payload[1] != 0x00 || payload[2] != 0x01)
+            return;
+
+        st.pes_count++;
+
+        const uint8_t stream_id = payload[3];
+        // padding/private_stream_2 등은 PES 헤더 확장 없음
+        if (stream_id == 0xBC || stream_id == 0xBE || stream_id == 0xBF ||
+            stream_id == 0xF0 || stream_id == 0xF1 || stream_id == 0xFF)
+            return;
+
+        const int flags = payload[7] >> 6;
+        if ((flags & 0x02) && len >= 14)
+        {
+            const int64_t pts = Unwrap(ReadTimestamp(payload + 9), st.last_pts, PTSWrap);
+            int64_t dts = pts;
+            const bool has_dts = (flags == 0x03) && len >= 19;
+            if (has_dts)
+                dts = Unwrap(ReadTimestamp(payload + 14), st.last_dts, PTSWrap);
+
+            // B프레임이 있으면 PTS는 역행할 수 있으므로 DTS가 있으면 DTS로 판단
+            if (has_dts)
+            {
+                if (st.last_dts != NoTime && dts <= st.last_dts)
+                    errors.dts_non_monotonic++;
+            }
+            else if (st.last_pts != NoTime && pts <= st.last_pts)
+            {
+                errors.pts_non_monotonic++;
+            }
+
+            if (current_time != NoTime)
+            {
+                if (st.last_pts_time != NoTime &&
+                    TicksToMs(current_time - st.last_pts_time) > opts.pts_max_interval_ms)
+                    errors.pts_error++;
+                st.last_pts_time = current_time;
+            }
+
+            st.last_pts = pts;
+            st.last_dts = dts;
+        }
+    }
+
+    void Analyzer::ProcessSectionPayload(int pid, PIDState& st, const uint8_t* payload, int len, bool pusi)
+    {
+        Section& sec = st.section;
+
+        if (pusi)
+        {
+            const int pointer = payload[0];
+            if (1 + pointer > len)
+                return;
+
+            // 이전 섹션의 꼬리
+            if (sec.active && pointer > 0)
+                sec.data.insert(sec.data.end(), payload + 1, payload + 1 + pointer);
+
+            // 이전 섹션 처리 후 새 섹션 시작
+            if (sec.active && sec.data.size() >= 3)
+            {
+                const size_t sec_len = 3 + (((sec.data[1] & 0x0F) << 8) | sec.data[2]);
+                if (sec.data.size() >= sec_len)
+                    ProcessSection(pid, sec.data.data(), (int)sec_len);
+            }
+
+            sec.data.assign(payload + 1 + pointer, payload + len);
+            sec.active = true;
+        }
+        else if (sec.active)
+        {
+            sec.data.insert(sec.data.end(), payload, payload + len);
+        }
+
+        // 완성된 섹션 처리 (한 패킷에 여러 섹션 가능)
+        while (sec.active && sec.data.size() >= 3)
+        {
+            if (sec.data[0] == 0xFF)
+            {
+                sec.active = false;  // 스터핑
+                sec.data.clear();
+                break;
+            }
+            const size_t sec_len = 3 + (((sec.data[1] & 0x0F) << 8) | sec.data[2]);
+            if (sec.data.size() < sec_len)
+                break;
+            ProcessSection(pid, sec.data.data(), (int)sec_len);
+            sec.data.erase(sec.data.begin(), sec.data.begin() + sec_len);
+        }
+    }
+
+    void Analyzer::ProcessSection(int pid, const uint8_t* sec, int len)
+    {
+        if (len < 12)
+            return;
+
+        const uint8_t table_id = sec[0];
+
+        if (Crc32(sec, len) != 0)
+        {
+            errors.crc_error++;
+            return;
+        }
+
+        if (pid == 0)
+        {
+            if (table_id != 0x00)
+            {
+                errors.pat_error++;
+                return;
+            }
+
+            CheckTableInterval(last_pat_time, opts.pat_max_interval_ms, max_pat_interval_ms, errors.pat_error);
+
+            int programs = 0;
+            for (int i = 8; i + 4 <= len - 4; i += 4)
+            {
+                const int program_number = (sec[i] << 8) | sec[i + 1];
+                const int map_pid = ((sec[i + 2] & 0x1F) << 8) | sec[i + 3];
+                if (program_number == 0)
+                    continue;  // NIT
+                pids[map_pid].is_pmt = true;
+                programs++;
+            }
+            program_count = programs;
+            return;
+        }
+
+        // PMT
+        if (table_id != 0x02)
+        {
+            errors.pmt_error++;
+            return;
+        }
+
+        PIDState& pmt = pids[pid];
+        CheckTableInterval(pmt.last_table_time, opts.pmt_max_interval_ms, max_pmt_interval_ms, errors.pmt_error);
+
+        const int program_info_length = ((sec[10] & 0x0F) << 8) | sec[11];
+        int i = 12 + program_info_length;
+        while (i + 5 <= len - 4)
+        {
+            const uint8_t stream_type = sec[i];
+            const int es_pid = ((sec[i + 1] & 0x1F) << 8) | sec[i + 2];
+            const int es_info_length = ((sec[i + 3] & 0x0F) << 8) | sec[i + 4];
+            PIDState& es = pids[es_pid];
+            es.referenced = true;
+            es.stream_type = stream_type;
+            if (es.last_time == NoTime)
+                es.last_time = current_time;
+            i += 5 + es_info_length;
+        }
+    }
+
+    Report Analyzer::Finish()
+    {
+        Report r;
+        r.total_packets = total_packets;
+        r.total_bytes = total_bytes;
+        r.errors = errors;
+        r.max_pat_interval_ms = max_pat_interval_ms;
+        r.max_pmt_interval_ms = max_pmt_interval_ms;
+        r.program_count = program_count;
+
+        // 마지막 구간의 PID 누락 검사
+        if (current_time != NoTime)
+        {
+            const int64_t timeout = (int64_t)(opts.pid_timeout_sec * ClockHz);
+            for (const PIDState& s : pids)
+            {
+                if (s.referenced && !IsSparseStream(s.stream_type) &&
+                    s.last_time != NoTime && current_time - s.last_time > timeout)
+                    r.errors.pid_error++;
+            }
+        }
+
+        if (first_time != NoTime && current_time != NoTime && current_time > first_time)
+            r.duration_sec = (double)(current_time - first_time) / ClockHz;
+        if (r.duration_sec > 0.0)
+            r.total_bitrate_kbps = total_bytes * 8.0 / r.duration_sec / 1000.0;
+
+        for (int pid = 0; pid < MaxPID; pid++)
+        {
+            const PIDState& s = pids[pid];
+            if (!s.seen && !s.referenced)
+                continue;
+
+            PIDStats ps;
+            ps.pid = (uint16_t)pid;
+            ps.packets = s.packets;
+            ps.cc_errors = s.cc_errors;
+            ps.pes_count = s.pes_count;
+            ps.pcr_count = s.pcr_count;
+            ps.stream_type = s.stream_type;
+            ps.max_pcr_interval_ms = s.max_pcr_interval_ms;
+            ps.max_pcr_jitter_ns = s.max_pcr_jitter_ns;
+            ps.kind = KindName(pid == 0, s.is_pmt, pid == 0x1FFF, s.referenced);
+            if (r.duration_sec > 0.0)
+                ps.bitrate_kbps = s.packets * PacketSize * 8.0 / r.duration_sec / 1000.0;
+            r.pids.push_back(ps);
+        }
+
+        return r;
+    }
+
+    std::string Report::ToText() const
+    {
+        std::string out;
+        char line[256];
+
+        snprintf(line, sizeof(line), "Packets: %llu (%llu bytes), duration %.3f s, %.1f kbps, programs %d\n",
+            (unsigned long long)total_packets, (unsigned long long)total_bytes,
+            duration_sec, total_bitrate_kbps, program_count);
+        out += line;
+        snprintf(line, sizeof(line), "Max PAT interval %.1f ms, max PMT interval %.1f ms\n",
+            max_pat_interval_ms, max_pmt_interval_ms);
+        out += line;
+
+        out += "\nPID     Kind          Type  Packets     kbps  CC-err   PES    PCR  MaxPCRint(ms)  MaxPCRjit(ns)\n";
+        for (const PIDStats& p : pids)
+        {
+            snprintf(line, sizeof(line), "0x%04X  %-12s  0x%02X  %8llu %8.1f  %6llu %5llu %6llu  %13.2f  %13.0f\n",
+                p.pid, p.kind.c_str(), p.stream_type, (unsigned long long)p.packets, p.bitrate_kbps,
+                (unsigned long long)p.cc_errors, (unsigned long long)p.pes_count,
+                (unsigned long long)p.pcr_count, p.max_pcr_interval_ms, p.max_pcr_jitter_ns);
+            out += line;
+        }
+
+        const ErrorCounters& e = errors;
+        snprintf(line, sizeof(line), "\nPriority 1 (%llu)\n", (unsigned long long)e.Priority1());
+        out += line;
+        snprintf(line, sizeof(line),
+            "  TS_sync_loss %llu, Sync_byte_error %llu, PAT_error %llu, CC_error %llu, PMT_error %llu, PID_error %llu\n",
+            (unsigned long long)e.ts_sync_loss, (unsigned long long)e.sync_byte_error,
+            (unsigned long long)e.pat_error, (unsigned long long)e.continuity_count_error,
+            (unsigned long long)e.pmt_error, (unsigned long long)e.pid_error);
+        out += line;
+        snprintf(line, sizeof(line), "Priority 2 (%llu)\n", (unsigned long long)e.Priority2());
+        out += line;
+        snprintf(line, sizeof(line),
+            "  Transport_error %llu, CRC_error %llu, PCR_repetition %llu, PCR_discontinuity %llu, PCR_accuracy %llu, PTS_error %llu\n",
+            (unsigned long long)e.transport_error, (unsigned long long)e.crc_error,
+            (unsigned long long)e.pcr_repetition_error, (unsigned long long)e.pcr_discontinuity_error,
+            (unsigned long long)e.pcr_accuracy_error, (unsigned long long)e.pts_error);
+        out += line;
+        snprintf(line, sizeof(line), "Timestamps: PTS non-monotonic %llu, DTS non-monotonic %llu\n",
+            (unsigned long long)e.pts_non_monotonic, (unsigned long long)e.dts_non_monotonic);
+        out += line;
+        return out;
+    }
+
+    std::string Report::ToJson() const
+    {
+        std::string out;
+        char buf[512];
+        const ErrorCounters& e = errors;
+
+        snprintf(buf, sizeof(buf),
+            "{\n  \"total_packets\": %llu,\n  \"total_bytes\": %llu,\n  \"duration_sec\": %.6f,\n"
+            "  \"total_bitrate_kbps\": %.3f,\n  \"program_count\": %d,\n"
+            "  \"max_pat_interval_ms\": %.3f,\n  \"max_pmt_interval_ms\": %.3f,\n",
+            (unsigned long long)total_packets, (unsigned long long)total_bytes, duration_sec,
+            total_bitrate_kbps, program_count, max_pat_interval_ms, max_pmt_interval_ms);
+        out += buf;
+
+        snprintf(buf, sizeof(buf),
+            "  \"priority1\": {\"total\": %llu, \"ts_sync_loss\": %llu, \"sync_byte_error\": %llu, \"pat_error\": %llu, "
+            "\"continuity_count_error\": %llu, \"pmt_error\": %llu, \"pid_error\": %llu},\n",
+            (unsigned long long)e.Priority1(), (unsigned long long)e.ts_sync_loss,
+            (unsigned long long)e.sync_byte_error, (unsigned long long)e.pat_error,
+            (unsigned long long)e.continuity_count_error, (unsigned long long)e.pmt_error,
+            (unsigned long long)e.pid_error);
+        out += buf;
+
+        snprintf(buf, sizeof(buf),
+            "  \"priority2\": {\"total\": %llu, \"transport_error\": %llu, \"crc_error\": %llu, "
+            "\"pcr_repetition_error\": %llu, \"pcr_discontinuity_error\": %llu, \"pcr_accuracy_error\": %llu, "
+            "\"pts_error\": %llu},\n",
+            (unsigned long long)e.Priority2(), (unsigned long long)e.transport_error,
+            (unsigned long long)e.crc_error, (unsigned long long)e.pcr_repetition_error,
+            (unsigned long long)e.pcr_discontinuity_error, (unsigned long long)e.pcr_accuracy_error,
+            (unsigned long long)e.pts_error);
+        out += buf;
+
+        snprintf(buf, sizeof(buf),
+            "  \"timestamps\": {\"pts_non_monotonic\": %llu, \"dts_non_monotonic\": %llu},\n  \"pids\": [\n",
+            (unsigned long long)e.pts_non_monotonic, (unsigned long long)e.dts_non_monotonic);
+        out += buf;
+
+        for (size_t i = 0; i < pids.size(); i++)
+        {
+            const PIDStats& p = pids[i];
+            snprintf(buf, sizeof(buf),
+                "    {\"pid\": %u, \"kind\": \"%s\", \"stream_type\": %u, \"packets\": %llu, \"bitrate_kbps\": %.3f, "
+                "\"cc_errors\": %llu, \"pes_count\": %llu, \"pcr_count\": %llu, \"max_pcr_interval_ms\": %.3f, "
+                "\"max_pcr_jitter_ns\": %.1f}%s\n",
+                p.pid, p.kind.c_str(), p.stream_type, (unsigned long long)p.packets, p.bitrate_kbps,
+                (unsigned long long)p.cc_errors, (unsigned long long)p.pes_count,
+                (unsigned long long)p.pcr_count, p.max_pcr_interval_ms, p.max_pcr_jitter_ns,
+                (i + 1 < pids.size()) ? "," : "");
+            out += buf;
+        }
+        out += "  ]\n}\n";
+        return out;
+    }
+}
@@ -0,0 +1,185 @@
+// ts_analyzer.h - MPEG-TS 분석/검증 라이브러리 (먹서 출력 검증용)
+//
+// ETR 290 1/2순위 항목을 기준으로 TS를 검사한다.
+// 파일(mmap)과 SRT 소켓 입력 모두 Feed()로 188바이트 패킷 묶음을 넘기면 된다.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ts
+{
+    constexpr int PacketSize = 188;
+    constexpr uint8_t SyncByte = 0x47;
+    constexpr int MaxPID = 8192;
+    constexpr int64_t NoTime = -1;
+
+    // ETR 290 스타일 에러 카운터
+    struct ErrorCounters
+    {
+        // Priority 1
+        uint64_t ts_sync_loss = 0;
+        uint64_t sync_byte_error = 0;
+        uint64_t pat_error = 0;            // PAT 간격 > 500ms, table_id 오류
+        uint64_t continuity_count_error = 0;
+        uint64_t pmt_error = 0;            // PMT 간격 > 500ms
+        uint64_t pid_error = 0;            // PMT에 있는 PID가 5초 이상 없음
+
+        // Priority 2
+        uint64_t transport_error = 0;      // transport_error_indicator
+        uint64_t crc_error = 0;            // PAT/PMT CRC32
+        uint64_t pcr_repetition_error = 0; // PCR 간격 > 40ms
+        uint64_t pcr_discontinuity_error = 0; // PCR 점프 > 100ms 또는 역행
+        uint64_t pcr_accuracy_error = 0;   // PCR 지터 > ±500ns (CBR 기준, VBR이면 참고용)
+        uint64_t pts_error = 0;            // PTS 간격 > 700ms
+
+        // 추가 검사
+        uint64_t pts_non_monotonic = 0;    // PES PTS 역행
+        uint64_t dts_non_monotonic = 0;
+
+        uint64_t Priority1() const
+        {
+            return ts_sync_loss + sync_byte_error + pat_error +
+                   continuity_count_error + pmt_error + pid_error;
+        }
+        uint64_t Priority2() const
+        {
+            return transport_error + crc_error + pcr_repetition_error +
+                   pcr_discontinuity_error + pcr_accuracy_error + pts_error;
+        }
+    };
+
+    struct PIDStats
+    {
+        uint16_t pid = 0;
+        uint64_t packets = 0;
+        uint64_t cc_errors = 0;
+        uint64_t pes_count = 0;
+        uint64_t pcr_count = 0;
+        double bitrate_kbps = 0.0;
+        double max_pcr_interval_ms = 0.0;
+        double max_pcr_jitter_ns = 0.0;
+        uint8_t stream_type = 0;   // PMT에서 알게 된 경우
+        std::string kind;          // "PAT", "PMT", "ES", "NULL", ...
+    };
+
+    struct Report
+    {
+        uint64_t total_packets = 0;
+        uint64_t total_bytes = 0;
+        double duration_sec = 0.0;
+        double total_bitrate_kbps = 0.0;
+        double max_pat_interval_ms = 0.0;
+        double max_pmt_interval_ms = 0.0;
+        int program_count = 0;
+        ErrorCounters errors;
+        std::vector<PIDStats> pids;
+
+        std::string ToText() const;
+        std::string ToJson() const;
+    };
+
+    struct Options
+    {
+        double pat_max_interval_ms = 500.0;
+        double pmt_max_interval_ms = 500.0;
+        double pcr_max_interval_ms = 40.0;
+        double pcr_max_jump_ms = 100.0;
+        double pcr_accuracy_ns = 500.0;
+        double pts_max_interval_ms = 700.0;
+        double pid_timeout_sec = 5.0;
+    };
+
+    class Analyzer
+    {
+    public:
+        explicit Analyzer(const Options& options = Options());
+
+        // 연속된 TS 바이트를 넘긴다. 패킷 경계가 아니어도 됨 (내부에서 재동기화).
+        // arrival_27mhz: 라이브 입력일 때 수신 시각 (27MHz), 파일이면 NoTime → PCR 기준 시간 사용
+        void Feed(const uint8_t* data, size_t size, int64_t arrival_27mhz = NoTime);
+
+        // 주기적 검사 마무리 (PID 타임아웃 등) 후 결과 생성
+        Report Finish();
+
+        void Reset();
+
+    private:
+        struct Section
+        {
+            std::vector<uint8_t> data;
+            bool active = false;
+        };
+
+        struct PIDState
+        {
+            bool seen = false;
+            bool referenced = false;   // PMT에 ES로 등록됨
+            bool is_pmt = false;
+            int8_t last_cc = -1;
+            uint8_t cc_duplicates = 0;   // 같은 CC가 연속으로 반복된 횟수 (1회까지 허용)
+            uint64_t packets = 0;
+            uint64_t cc_errors = 0;
+            uint64_t pes_count = 0;
+            uint64_t pcr_count = 0;
+            uint8_t stream_type = 0;
+            int64_t first_time = NoTime;
+            int64_t last_time = NoTime;
+            int64_t last_table_time = NoTime;
+
+            // PCR
+            int64_t last_pcr = NoTime;
+            uint64_t last_pcr_byte = 0;
+            double max_pcr_interval_ms = 0.0;
+            double max_pcr_jitter_ns = 0.0;
+
+            // PTS/DTS (33비트 wrap 처리된 값)
+            int64_t last_pts = NoTime;
+            int64_t last_dts = NoTime;
+            int64_t last_pts_time = NoTime;
+
+            Section section;
+        };
+
+        Options opts;
+        std::vector<PIDState> pids;
+        ErrorCounters errors;
+
+        // 미완성 패킷 (Feed 경계에 걸친 경우)
+        uint8_t carry[PacketSize];
+        size_t carry_len = 0;
+        bool synced = false;
+
+        uint64_t total_packets = 0;
+        uint64_t total_bytes = 0;
+
+        // 시간 기준: 라이브는 수신 시각, 파일은 첫 PCR PID의 PCR을 바이트 위치로 보간
+        int timing_pid = -1;
+        int64_t time_ref_pcr = NoTime;
+        uint64_t time_ref_byte = 0;
+        double bytes_per_tick = 0.0;    // 27MHz 틱당 바이트 (PCR 구간 평균)
+        int64_t first_pcr = NoTime;
+        uint64_t first_pcr_byte = 0;
+        int64_t current_time = NoTime;
+        int64_t first_time = NoTime;
+
+        int64_t last_pat_time = NoTime;
+        double max_pat_interval_ms = 0.0;
+        double max_pmt_interval_ms = 0.0;
+        int program_count = 0;
+
+        void ProcessPacket(const uint8_t* p, int64_t arrival);
+        void ProcessPCR(int pid, PIDState& st, int64_t pcr, bool discontinuity);
+        void ProcessPES(PIDState& st, const uint8_t* payload, int len);
+        void ProcessSectionPayload(int pid, PIDState& st, const uint8_t* payload, int len, bool pusi);
+        void ProcessSection(int pid, const uint8_t* sec, int len);
+        void CheckTableInterval(int64_t& last, double limit_ms, double& max_ms, uint64_t& counter);
+        int64_t EstimateTime() const;
+    };
+
+    // MPEG-2 CRC32 (PSI 섹션)
+    uint32_t Crc32(const uint8_t* data, size_t len);
+}
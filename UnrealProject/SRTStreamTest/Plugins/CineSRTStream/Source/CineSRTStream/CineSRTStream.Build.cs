@@ -4,6 +4,7 @@ using UnrealBuildTool;
 using System.IO;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 
 public class CineSRTStream : ModuleRules
 {
@@ -45,8 +46,7 @@ public class CineSRTStream : ModuleRules
                 "RenderCore",
                 "RHI",
                 "Renderer",
-                "Projects",
-                "D3D11RHI"  // D3D11 인터롭용
+                "Projects"
             }
         );
         
@@ -56,7 +56,8 @@ public class CineSRTStream : ModuleRules
                 "Sockets",
                 "Networking",
                 "Media",
-                "MediaAssets"
+                "MediaAssets",
+                "CineSRTStreamShaders"  // GPU YUV 변환 셰이더 (PostConfigInit)
             }
         );
         
@@ -76,6 +77,8 @@ public class CineSRTStream : ModuleRules
         // Windows 플랫폼 전용 설정
         if (Target.Platform == UnrealTargetPlatform.Win64)
         {
+            PublicDependencyModuleNames.Add("D3D11RHI");  // D3D11 인터롭용
+            
             // ThirdParty 경로 설정
             string ThirdPartyPath = Path.GetFullPath(Path.Combine(ModuleDirectory, "../../ThirdParty"));
             string SRTPath = Path.Combine(ThirdPartyPath, "SRT");
@@ -263,8 +266,133 @@ public class CineSRTStream : ModuleRules
                 "USE_SYSTEM_FFMPEG=" + (bUseSystemFFmpeg ? "1" : "0")
             });
             
+            // AES-GCM(SRTO_CRYPTOMODE)은 ENABLE_AEAD_API_PREVIEW=ON으로 다시 빌드한 SRT에만 있음
+            // 라이브러리만 보고는 알 수 없어 다시 빌드해 넣을 때 lib 폴더에 빈 표시 파일 SRT_AEAD를 함께 둠
+            if (IsSRTBuiltWithAEAD(Path.Combine(SRTPath, "lib", "Win64")))
+            {
+                PublicDefinitions.Add("ENABLE_AEAD_API_PREVIEW=1");
+                System.Console.WriteLine("CineSRTStream: SRT built with AEAD API (AES-GCM available)");
+            }
+            
             // C 파일 컴파일 설정 (Private 소스 파일로 추가)
             PrivateIncludePathModuleNames.Add("CineSRTStream");
         }
+        // Linux - 헤드리스 벤치마크(-run=SRTBenchmark -nullrhi)와 서버 빌드용
+        else if (Target.Platform == UnrealTargetPlatform.Linux)
+        {
+            string ThirdPartyPath = Path.GetFullPath(Path.Combine(ModuleDirectory, "../../ThirdParty"));
+            string SRTPath = Path.Combine(ThirdPartyPath, "SRT");
+            string BundledSRTLib = Path.Combine(SRTPath, "lib", "Linux", "libsrt.a");
+            string BundledFFmpegPath = Path.Combine(ThirdPartyPath, "FFmpeg");
+            string BundledFFmpegLibPath = Path.Combine(BundledFFmpegPath, "lib", "Linux");
+            
+            // SRT - 번들 정적 라이브러리 우선, 없으면 시스템 libsrt (pkg-config srt와 같은 위치)
+            if (File.Exists(BundledSRTLib))
+            {
+                PublicIncludePaths.Insert(0, Path.Combine(SRTPath, "include"));
+                PublicIncludePaths.AddRange(new string[] {
+                    Path.Combine(SRTPath, "include", "srtcore"),
+                    Path.Combine(SRTPath, "include", "common")
+                });
+                PublicAdditionalLibraries.Add(BundledSRTLib);
+                PublicDefinitions.Add("SRT_STATIC=1");
+                if (IsSRTBuiltWithAEAD(Path.GetDirectoryName(BundledSRTLib)))
+                {
+                    PublicDefinitions.Add("ENABLE_AEAD_API_PREVIEW=1");
+                }
+                System.Console.WriteLine("CineSRTStream: Using bundled libsrt.a");
+            }
+            else
+            {
+                // 헤더는 <prefix>/include/srt/srt.h - 소스가 "srt.h"로 포함하므로 그 폴더를 추가
+                // 배포판 libsrt는 AEAD API 없이 빌드되므로 ENABLE_AEAD_API_PREVIEW는 정의하지 않음 (AES-CTR만)
+                PublicSystemIncludePaths.AddRange(GetSystemSRTIncludePaths());
+                PublicSystemLibraries.Add("srt");
+                System.Console.WriteLine("CineSRTStream: Using system libsrt");
+            }
+            
+            // FFmpeg - 번들 우선, 없으면 시스템 (libavcodec-dev 등)
+            bool bUseSystemFFmpeg = !Directory.Exists(BundledFFmpegLibPath);
+            string[] FFmpegLibs = { "avcodec", "avformat", "avutil", "swscale", "swresample" };
+            if (!bUseSystemFFmpeg)
+            {
+                PublicIncludePaths.Add(Path.Combine(BundledFFmpegPath, "include"));
+                foreach (string lib in FFmpegLibs)
+                {
+                    string libFile = Path.Combine(BundledFFmpegLibPath, "lib" + lib + ".so");
+                    if (File.Exists(libFile))
+                    {
+                        PublicAdditionalLibraries.Add(libFile);
+                        RuntimeDependencies.Add(libFile);
+                    }
+                }
+                System.Console.WriteLine("CineSRTStream: Using bundled FFmpeg");
+            }
+            else
+            {
+                PublicSystemLibraries.AddRange(FFmpegLibs);
+                System.Console.WriteLine("CineSRTStream: Using system FFmpeg");
+            }
+            
+            // SRT 암호화 (OpenSSL) + 스레드
+            PublicSystemLibraries.AddRange(new string[] { "ssl", "crypto", "pthread" });
+            
+            PublicDefinitions.AddRange(new string[] {
+                "SRT_ENABLE_ENCRYPTION=1",
+                "__STDC_CONSTANT_MACROS",
+                "__STDC_FORMAT_MACROS",
+                "__STDC_LIMIT_MACROS",
+                "USE_SYSTEM_FFMPEG=" + (bUseSystemFFmpeg ? "1" : "0")
+            });
+        }
+    }
+    
+    // pkg-config srt의 -I 경로와 그 아래 srt 폴더, pkg-config가 없으면 표준 위치
+    private static List<string> GetSystemSRTIncludePaths()
+    {
+        List<string> IncludePaths = new List<string>();
+        List<string> Candidates = new List<string>();
+        try
+        {
+            ProcessStartInfo StartInfo = new ProcessStartInfo("pkg-config", "--cflags-only-I srt");
+            StartInfo.RedirectStandardOutput = true;
+            StartInfo.UseShellExecute = false;
+            using (Process PkgConfig = Process.Start(StartInfo))
+            {
+                string Output = PkgConfig.StandardOutput.ReadToEnd();
+                PkgConfig.WaitForExit();
+                if (PkgConfig.ExitCode == 0)
+                {
+                    foreach (string Flag in Output.Split(new char[] { ' ', '\t', '\n' }, StringSplitOptions.RemoveEmptyEntries))
+                    {
+                        if (Flag.StartsWith("-I"))
+                        {
+                            Candidates.Add(Flag.Substring(2));
+                            Candidates.Add(Path.Combine(Flag.Substring(2), "srt"));
+                        }
+                    }
+                }
+            }
+        }
+        catch (Exception)
+        {
+            // pkg-config 없음 - 아래 표준 위치로
+        }
+        Candidates.AddRange(new string[] { "/usr/include/srt", "/usr/local/include/srt" });
+        
+        foreach (string Candidate in Candidates)
+        {
+            if (File.Exists(Path.Combine(Candidate, "srt.h")) && !IncludePaths.Contains(Candidate))
+            {
+                IncludePaths.Add(Candidate);
+            }
+        }
+        return IncludePaths;
+    }
+    
+    // 번들 SRT 옆의 표시 파일 - 일반 빌드에 ENABLE_AEAD_API_PREVIEW를 정의하면 헤더만 GCM을 알아 암호화 연결이 실패
+    private static bool IsSRTBuiltWithAEAD(string LibDirectory)
+    {
+        return File.Exists(Path.Combine(LibDirectory, "SRT_AEAD"));
     }
 }
@@ -7,8 +7,8 @@
 #include <vector>
 #include <memory>
 
-// SRT 헤더 래퍼 사용
-#include "SRTWrapper.h"
+// SRT 초기화/정리 (SRTNetwork)
+#include "SRTNetworkWorker.h"
 
 #define LOCTEXT_NAMESPACE "FCineSRTStreamModule"
 
@@ -19,7 +19,7 @@ void FCineSRTStreamModule::StartupModule()
     UE_LOG(LogCineSRTStream, Log, TEXT("=== CineSRTStream Module Starting ==="));
     try {
         UE_LOG(LogCineSRTStream, Log, TEXT("SRT \ub77c\uc774\ube0c\ub7ec\ub9ac \ucd08\uae30\ud654 \uc2dc\ub3c4 \uc911..."));
-        if (!SRTWrapper::Initialize()) {
+        if (!SRTNetwork::Initialize()) {
             UE_LOG(LogCineSRTStream, Error, TEXT("SRT \ub77c\uc774\ube0c\ub7ec\ub9ac \ucd08\uae30\ud654 \uc2e4\ud328"));
             bSRTInitialized = false;
             return;
@@ -43,7 +43,7 @@ void FCineSRTStreamModule::ShutdownModule()
     
     if (bSRTInitialized) {
         // SRT 라이브러리 정리
-        SRTWrapper::Cleanup();
+        SRTNetwork::Shutdown();
         bSRTInitialized = false;
     }
     
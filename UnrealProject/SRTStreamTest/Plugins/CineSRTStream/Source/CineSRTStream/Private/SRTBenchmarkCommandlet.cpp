@@ -0,0 +1,1640 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTBenchmarkCommandlet.h"
+#include "SRTStreamComponent.h"
+#include "SRTStreamSubsystem.h"
+#include "SRTFrameTrace.h"
+#include "SRTYUVConversion.h"
+#include "SRTNetworkWorker.h"
+#include "SRTSocket.h"
+#include "SRTTransportStream.h"
+#include "CineSRTStream.h"
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    struct FBenchmarkOptions
+    {
+        TArray<FString> Resolutions = { TEXT("720p"), TEXT("1080p"), TEXT("4K") };
+        FString Source = TEXT("Bars");
+        float FPS = 30.0f;
+        int32 Frames = 600;
+        int32 WarmupFrames = 60;
+        int32 Repeat = 3;
+        int32 BitrateKbps = 8000;
+        FString Preset = TEXT("Medium");
+        FString Codec = TEXT("H264");
+        int32 Port = 9200;
+        int32 LatencyMs = 40;
+        FString Output;
+        FString CaptureFormat = TEXT("BGRA");   // NV12/I420 - 공급원이 YUV로 넘김 (패턴/파일은 CPU 참조 변환)
+
+        // -OverloadTest: 인코더 과부하 조정 시나리오 (첫 해상도 하나로)
+        bool bOverloadTest = false;
+        float Slowdown = 0.0f;          // CineSRT.SimulateEncoderSlowdown (0 = 기준 인코딩 시간으로 프레임 간격의 2배가 되게)
+        float OverloadSeconds = 30.0f;  // 내려가서 자리 잡기까지 기다리는 최대 시간
+        float RecoverSeconds = 60.0f;   // 부하를 없앤 뒤 올라오기까지 기다리는 최대 시간
+
+        // -MetadataTest: 매 프레임 타임드 메타데이터를 실었을 때 비디오 지연/간격 비교 (첫 해상도 하나로)
+        bool bMetadataTest = false;
+        FString MetadataFormat = TEXT("ID3");   // ID3 또는 KLV
+        float MaxDeltaMs = 2.0f;                // 메타데이터 없는 기준보다 p95가 이만큼 넘게 늘면 실패
+
+        // -ReconnectTest: 수신기를 멈췄다 다시 열어 자동 재연결과 복구 스트림 확인 (첫 해상도 하나로)
+        bool bReconnectTest = false;
+        float OutageSeconds = 2.0f;     // 수신기가 닫혀 있는 시간
+    };
+
+    // 프레임 추적으로 보는 단계 (FSRTFrameTraceRecorder의 Chrome trace 구간과 같은 경계)
+    struct FStage
+    {
+        const TCHAR* Name;
+        ESRTTraceStage Begin;
+        ESRTTraceStage End;
+    };
+
+    const FStage Stages[] =
+    {
+        { TEXT("Source"),  ESRTTraceStage::CopyBegin,    ESRTTraceStage::CopyEnd },   // 패턴 생성/파일 읽기 (씬 캡처면 복사)
+        { TEXT("Queue"),   ESRTTraceStage::CopyEnd,      ESRTTraceStage::Dequeue },   // FrameBuffer에서 인코더가 꺼낼 때까지
+        { TEXT("Convert"), ESRTTraceStage::ConvertBegin, ESRTTraceStage::ConvertEnd },
+        { TEXT("Encode"),  ESRTTraceStage::ConvertEnd,   ESRTTraceStage::EncodeEnd },
+        { TEXT("Mux"),     ESRTTraceStage::MuxBegin,     ESRTTraceStage::MuxEnd },
+        { TEXT("Send"),    ESRTTraceStage::SendBegin,    ESRTTraceStage::SendEnd },
+    };
+    constexpr int32 StageCount = UE_ARRAY_COUNT(Stages);
+
+    struct FPercentiles
+    {
+        double Mean = 0.0;
+        double P50 = 0.0;
+        double P95 = 0.0;
+        double P99 = 0.0;
+    };
+
+    struct FRunResult
+    {
+        FString Resolution;
+        int32 Width = 0;
+        int32 Height = 0;
+        double SustainedFPS = 0.0;
+        int32 FramesSent = 0;
+        int32 FramesSkipped = 0;         // 공급원이 이전 프레임을 아직 만드는 중이라 건너뜀
+        FPercentiles PipelineMs;         // 캡처 → 마지막 srt_send
+        FPercentiles DeliveryMs;         // 캡처 → 프레임 마지막 메시지 수신 (캡처 SEI, 수신 측 TSBPD 끔)
+        FPercentiles StageMs[StageCount];
+        double CPUCores = 0.0;           // 프로세스 CPU 시간 / 경과 시간
+        int64 ReceivedBytes = 0;
+        int32 FrameBytes = 0;            // 공급원 → 인코더 한 프레임 (씬 캡처면 GPU 리드백 크기)
+    };
+
+    double GetProcessCPUSeconds()
+    {
+#if PLATFORM_WINDOWS
+        FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+            return 0.0;
+        const uint64 Kernel = ((uint64)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime;
+        const uint64 User = ((uint64)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime;
+        return (double)(Kernel + User) / 10000000.0;
+#else
+        struct rusage Usage;
+        if (getrusage(RUSAGE_SELF, &Usage) != 0)
+            return 0.0;
+        return Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec
+            + (Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) / 1000000.0;
+#endif
+    }
+
+    FPercentiles ComputePercentiles(TArray<double>& Values)
+    {
+        FPercentiles Result;
+        if (Values.Num() == 0)
+            return Result;
+
+        Values.Sort();
+        double Sum = 0.0;
+        for (double Value : Values)
+        {
+            Sum += Value;
+        }
+        auto At = [&Values](double Percent)
+        {
+            const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent / 100.0 * Values.Num()) - 1, 0, Values.Num() - 1);
+            return Values[Index];
+        };
+        Result.Mean = Sum / Values.Num();
+        Result.P50 = At(50.0);
+        Result.P95 = At(95.0);
+        Result.P99 = At(99.0);
+        return Result;
+    }
+
+    double Median(TArray<double> Values)
+    {
+        if (Values.Num() == 0)
+            return 0.0;
+        Values.Sort();
+        const int32 Mid = Values.Num() / 2;
+        return (Values.Num() % 2) ? Values[Mid] : (Values[Mid - 1] + Values[Mid]) * 0.5;
+    }
+
+    // PES 시작 TS 패킷에서 캡처 SEI의 UTC 시각 찾기 (SEI는 AUD/파라미터 셋 바로 뒤라 첫 패킷 안에 들어감)
+    bool FindCaptureTimestamp(const uint8* Data, int32 Size, int64& OutCaptureUtcUs)
+    {
+        const uint8* Uuid = FSRTTransportStream::CaptureSEIUuid;
+        for (int32 Offset = 0; Offset + TS_PACKET_SIZE <= Size; Offset += TS_PACKET_SIZE)
+        {
+            const uint8* Packet = Data + Offset;
+            if (Packet[0] != TS_SYNC_BYTE || !(Packet[1] & 0x40))
+                continue;
+
+            for (int32 i = 4; i + 16 <= TS_PACKET_SIZE; i++)
+            {
+                if (Packet[i] != Uuid[0] || FMemory::Memcmp(Packet + i, Uuid, 16) != 0)
+                    continue;
+
+                // 버전, 시계, 시각 8바이트 - 에뮬레이션 방지 바이트(00 00 03의 03)는 건너뜀
+                uint8 Fields[10];
+                int32 Count = 0;
+                int32 Zeros = 0;
+                for (int32 j = i + 16; j < TS_PACKET_SIZE && Count < 10; j++)
+                {
+                    if (Zeros >= 2 && Packet[j] == 0x03)
+                    {
+                        Zeros = 0;
+                        continue;
+                    }
+                    Zeros = (Packet[j] == 0) ? Zeros + 1 : 0;
+                    Fields[Count++] = Packet[j];
+                }
+                if (Count < 10 || Fields[0] != 1)
+                    return false;
+
+                uint64 CaptureUs = 0;
+                for (int32 k = 2; k < 10; k++)
+                {
+                    CaptureUs = (CaptureUs << 8) | Fields[k];
+                }
+                OutCaptureUtcUs = (int64)CaptureUs;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 송신 측 FSRTTransportStream::FConfig 기본 PID - 타임드 메타데이터는 비디오 PID + 3
+    constexpr int32 BenchmarkPMTPID = 0x1000;
+    constexpr int32 BenchmarkVideoPID = 0x0100;
+    constexpr int32 BenchmarkMetadataPID = BenchmarkVideoPID + 3;
+
+    // PES 시작 TS 패킷의 PTS (90kHz) - PES 시작이 아니거나 PTS가 없으면 -1
+    int64 ReadPESTimestamp(const uint8* Packet)
+    {
+        int32 Offset = 4;
+        if (Packet[3] & 0x20)
+        {
+            Offset += 1 + Packet[4];
+        }
+        if (!(Packet[1] & 0x40) || Offset + 14 > TS_PACKET_SIZE)
+            return -1;
+
+        const uint8* PES = Packet + Offset;
+        if (PES[0] != 0 || PES[1] != 0 || PES[2] != 1 || !(PES[7] & 0x80))
+            return -1;
+        return ((int64)(PES[9] & 0x0E) << 29) | ((int64)PES[10] << 22) | ((int64)(PES[11] & 0xFE) << 14)
+            | ((int64)PES[12] << 7) | (PES[13] >> 1);
+    }
+
+    // 수신한 PES 하나 - 도착 시각(UTC us)과 PTS
+    struct FReceivedPES
+    {
+        int64 ArrivalUs = 0;
+        int64 PTS = -1;
+    };
+
+    // 연결마다 첫 비디오 PES까지 - 수신기가 바로 디코딩을 시작할 수 있는 순서로 왔는지
+    struct FConnectionStart
+    {
+        int32 Connections = 0;      // 이 수신기가 지금까지 받은 연결 수
+        bool bChecked = false;      // 첫 비디오 PES를 충분히 받아 판정함
+        bool bTablesFirst = false;  // PAT와 PMT가 첫 비디오 PES보다 먼저
+        bool bIDRFirst = false;     // 첫 비디오 PES가 IDR 접근 단위
+    };
+
+    // 첫 비디오 PES의 바이트에서 IDR 슬라이스 NAL 찾기 (H.264 5, HEVC IDR_W_RADL/IDR_N_LP/CRA 19-21)
+    bool ContainsIDR(const TArray<uint8>& Data, bool bHEVC)
+    {
+        for (int32 i = 0; i + 3 < Data.Num(); i++)
+        {
+            if (Data[i] != 0 || Data[i + 1] != 0 || Data[i + 2] != 1)
+                continue;
+
+            const uint8 Header = Data[i + 3];
+            const int32 Type = bHEVC ? (Header >> 1) & 0x3F : Header & 0x1F;
+            if (bHEVC ? (Type >= 19 && Type <= 21) : Type == 5)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * 내장 SRT 리스너 - 연결 하나를 받아 메시지를 읽고 프레임마다 캡처 → 마지막 메시지 수신 지연을 기록
+     * 캡처 시각은 송신 측이 넣은 캡처 타임스탬프 SEI (같은 프로세스라 시계 오프셋 없음).
+     * 수신 srctime은 TSBPD를 켜면 재생 시각, 끄면 연결 기준 시각이라 캡처 시각으로 쓸 수 없다.
+     * TSBPD를 끄므로 SRT 레이턴시만큼 붙잡아 두지 않고 도착하는 대로 받는다.
+     */
+    class FBenchmarkReceiver
+    {
+    public:
+        ~FBenchmarkReceiver() { Stop(); }
+
+        // Stop 뒤 같은 포트로 다시 Start하면 새 연결을 받음 (재연결 시험)
+        bool Start(int32 Port, int32 LatencyMs, FString& OutError)
+        {
+            bStop = false;
+            ListenSocket = FSRTSocket::Create();
+            if (!ListenSocket
+                || !SRTNetwork::ApplyLiveStreamOptions(ListenSocket, LatencyMs)
+                || !ListenSocket.SetOption(SRTO_TSBPDMODE, false)
+                || !ListenSocket.SetNonBlocking(true))
+            {
+                OutError = FString::Printf(TEXT("Receiver socket: %s"), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+                return false;
+            }
+            if (!SRTNetwork::Bind(ListenSocket.Get(), Port) || !SRTNetwork::Listen(ListenSocket.Get(), 1))
+            {
+                OutError = FString::Printf(TEXT("Receiver bind/listen on %d: %s"), Port, UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+                return false;
+            }
+
+            Done = Async(EAsyncExecution::Thread, [this]() { Run(); });
+            return true;
+        }
+
+        void Stop()
+        {
+            if (!Done.IsValid())
+                return;
+            bStop = true;
+            Done.Wait();
+            Done = TFuture<void>();
+            ListenSocket.Close();
+        }
+
+        void SetMeasuring(bool bEnable)
+        {
+            FScopeLock ScopeLock(&Lock);
+            bMeasuring = bEnable;
+            if (bEnable)
+            {
+                DeliveryMs.Reset();
+                VideoPES.Reset();
+                MetadataPES.Reset();
+                ReceivedBytes = 0;
+            }
+        }
+
+        void GetResults(TArray<double>& OutDeliveryMs, int64& OutBytes)
+        {
+            FScopeLock ScopeLock(&Lock);
+            OutDeliveryMs = DeliveryMs;
+            OutBytes = ReceivedBytes;
+        }
+
+        // 첫 비디오 PES 판정에 쓸 코덱 (Start 전에)
+        void SetHEVC(bool bInHEVC) { bHEVC = bInHEVC; }
+
+        FConnectionStart GetConnectionStart()
+        {
+            FScopeLock ScopeLock(&Lock);
+            return ConnectionStart;
+        }
+
+        // 측정 구간에 받은 비디오 PES와 타임드 메타데이터 PES
+        void GetPES(TArray<FReceivedPES>& OutVideo, TArray<FReceivedPES>& OutMetadata)
+        {
+            FScopeLock ScopeLock(&Lock);
+            OutVideo = VideoPES;
+            OutMetadata = MetadataPES;
+        }
+
+    private:
+        FSRTSocket ListenSocket;
+        TFuture<void> Done;
+        TAtomic<bool> bStop{false};
+
+        FCriticalSection Lock;
+        bool bMeasuring = false;
+        TArray<double> DeliveryMs;
+        TArray<FReceivedPES> VideoPES;
+        TArray<FReceivedPES> MetadataPES;
+        int64 ReceivedBytes = 0;
+        bool bHEVC = false;
+        FConnectionStart ConnectionStart;
+
+        // 연결 직후 첫 비디오 PES까지 TS 패킷 확인 (측정 여부와 무관)
+        bool bSawPAT = false;
+        bool bSawPMT = false;
+        TArray<uint8> FirstVideoPES;
+
+        void InspectConnectionStart(const uint8* Data, int32 Size)
+        {
+            constexpr int32 IDRSearchBytes = 2048;  // 파라미터 셋 + SEI 뒤 첫 슬라이스까지 충분
+            for (int32 Offset = 0; Offset + TS_PACKET_SIZE <= Size && !ConnectionStart.bChecked; Offset += TS_PACKET_SIZE)
+            {
+                const uint8* Packet = Data + Offset;
+                const int32 PID = ((Packet[1] & 0x1F) << 8) | Packet[2];
+                const bool bStart = (Packet[1] & 0x40) != 0;
+                if (Packet[0] != TS_SYNC_BYTE)
+                    continue;
+
+                if (PID == TS_PAT_PID)
+                {
+                    bSawPAT = true;
+                }
+                else if (PID == BenchmarkPMTPID)
+                {
+                    bSawPMT = true;
+                }
+                else if (PID == BenchmarkVideoPID && (bStart || FirstVideoPES.Num() > 0))
+                {
+                    if (bStart && FirstVideoPES.Num() > 0)
+                    {
+                        // 다음 PES 시작 - 첫 PES가 검색 범위보다 짧았음
+                        ConnectionStart.bIDRFirst = ContainsIDR(FirstVideoPES, bHEVC);
+                        ConnectionStart.bChecked = true;
+                        break;
+                    }
+                    if (bStart)
+                    {
+                        ConnectionStart.bTablesFirst = bSawPAT && bSawPMT;
+                    }
+
+                    int32 Payload = 4;
+                    if (Packet[3] & 0x20)
+                    {
+                        Payload += 1 + Packet[4];
+                    }
+                    if (Payload < TS_PACKET_SIZE)
+                    {
+                        FirstVideoPES.Append(Packet + Payload, TS_PACKET_SIZE - Payload);
+                    }
+                    if (FirstVideoPES.Num() >= IDRSearchBytes)
+                    {
+                        ConnectionStart.bIDRFirst = ContainsIDR(FirstVideoPES, bHEVC);
+                        ConnectionStart.bChecked = true;
+                    }
+                }
+            }
+        }
+
+        void Run()
+        {
+            FSRTSocket Peer;
+            while (!bStop)
+            {
+                const SRTSOCKET Accepted = srt_accept(ListenSocket.Get(), nullptr, nullptr);
+                if (Accepted != SRT_INVALID_SOCK)
+                {
+                    Peer = FSRTSocket(Accepted);
+                    FScopeLock ScopeLock(&Lock);
+                    ConnectionStart.Connections++;
+                    ConnectionStart.bChecked = false;
+                    ConnectionStart.bTablesFirst = false;
+                    ConnectionStart.bIDRFirst = false;
+                    bSawPAT = false;
+                    bSawPMT = false;
+                    FirstVideoPES.Reset();
+                    break;
+                }
+                FPlatformProcess::Sleep(0.005f);
+            }
+
+            // 수락된 소켓은 논블로킹을 물려받음 - 수신은 100ms 타임아웃 블로킹으로
+            Peer.SetOption(SRTO_RCVSYN, true);
+            Peer.SetOption(SRTO_RCVTIMEO, (int32)100);
+
+            char Buffer[FSRTSocket::LIVE_PAYLOAD_SIZE + 64];
+            int64 FrameCaptureUs = 0;   // 수신 중인 프레임의 캡처 시각 (0 = 아직 SEI 못 봄)
+            int64 LastArrivalUs = 0;
+            while (!bStop && Peer)
+            {
+                SRT_MSGCTRL Control = srt_msgctrl_default;
+                const int Received = srt_recvmsg2(Peer.Get(), Buffer, sizeof(Buffer), &Control);
+                if (Received <= 0)
+                {
+                    if (!Peer.IsConnected())
+                        break;
+                    continue;
+                }
+
+                const int64 NowUs = SRTNetwork::ToUtcMicroseconds(FPlatformTime::Seconds());
+                FScopeLock ScopeLock(&Lock);
+                if (!ConnectionStart.bChecked)
+                {
+                    InspectConnectionStart((const uint8*)Buffer, Received);
+                }
+                if (!bMeasuring)
+                {
+                    FrameCaptureUs = 0;
+                    continue;
+                }
+                ReceivedBytes += Received;
+
+                for (int32 Offset = 0; Offset + TS_PACKET_SIZE <= Received; Offset += TS_PACKET_SIZE)
+                {
+                    const uint8* Packet = (const uint8*)Buffer + Offset;
+                    const int32 PID = ((Packet[1] & 0x1F) << 8) | Packet[2];
+                    if (Packet[0] != TS_SYNC_BYTE || (PID != BenchmarkVideoPID && PID != BenchmarkMetadataPID))
+                        continue;
+
+                    const int64 PTS = ReadPESTimestamp(Packet);
+                    if (PTS >= 0)
+                    {
+                        (PID == BenchmarkVideoPID ? VideoPES : MetadataPES).Add({ NowUs, PTS });
+                    }
+                }
+
+                // 다음 프레임의 SEI가 오면 이전 프레임은 직전 메시지에서 끝난 것
+                int64 CaptureUs = 0;
+                if (FindCaptureTimestamp((const uint8*)Buffer, Received, CaptureUs))
+                {
+                    if (FrameCaptureUs != 0)
+                    {
+                        DeliveryMs.Add((LastArrivalUs - FrameCaptureUs) / 1000.0);
+                    }
+                    FrameCaptureUs = CaptureUs;
+                }
+                LastArrivalUs = NowUs;
+            }
+        }
+    };
+
+    void ResolveStreamMode(const FString& Label, ESRTStreamMode& OutMode, int32& OutWidth, int32& OutHeight)
+    {
+        if (Label.Equals(TEXT("4K"), ESearchCase::IgnoreCase) || Label.Equals(TEXT("2160p"), ESearchCase::IgnoreCase))
+        {
+            OutMode = ESRTStreamMode::UHD_3840x2160; OutWidth = 3840; OutHeight = 2160;
+        }
+        else if (Label.Equals(TEXT("720p"), ESearchCase::IgnoreCase))
+        {
+            OutMode = ESRTStreamMode::HD_1280x720; OutWidth = 1280; OutHeight = 720;
+        }
+        else
+        {
+            OutMode = ESRTStreamMode::HD_1920x1080; OutWidth = 1920; OutHeight = 1080;
+        }
+    }
+
+    void ConfigureSource(USRTStreamComponent* Stream, const FString& Source)
+    {
+        if (Source.Equals(TEXT("Noise"), ESearchCase::IgnoreCase))
+        {
+            Stream->FrameSource = ESRTFrameSourceType::TestPattern;
+            Stream->TestPattern = ESRTTestPattern::Noise;
+        }
+        else if (Source.Equals(TEXT("Text"), ESearchCase::IgnoreCase))
+        {
+            Stream->FrameSource = ESRTFrameSourceType::TestPattern;
+            Stream->TestPattern = ESRTTestPattern::Text;
+        }
+        else if (Source.Equals(TEXT("Bars"), ESearchCase::IgnoreCase))
+        {
+            Stream->FrameSource = ESRTFrameSourceType::TestPattern;
+            Stream->TestPattern = ESRTTestPattern::MovingBars;
+        }
+        else
+        {
+            Stream->FrameSource = ESRTFrameSourceType::File;
+            Stream->SourceFilePath = Source;
+        }
+    }
+
+    ESRTCaptureFormat ParseCaptureFormat(const FString& Format)
+    {
+        if (Format.Equals(TEXT("NV12"), ESearchCase::IgnoreCase)) return ESRTCaptureFormat::NV12;
+        if (Format.Equals(TEXT("I420"), ESearchCase::IgnoreCase)) return ESRTCaptureFormat::I420;
+        return ESRTCaptureFormat::BGRA;
+    }
+
+    ESRTQualityPreset ParsePreset(const FString& Preset)
+    {
+        if (Preset.Equals(TEXT("Low"), ESearchCase::IgnoreCase)) return ESRTQualityPreset::Low;
+        if (Preset.Equals(TEXT("High"), ESearchCase::IgnoreCase)) return ESRTQualityPreset::High;
+        if (Preset.Equals(TEXT("Ultra"), ESearchCase::IgnoreCase)) return ESRTQualityPreset::Ultra;
+        return ESRTQualityPreset::Medium;
+    }
+
+    USRTStreamComponent* SpawnStream(UWorld* World, const FBenchmarkOptions& Options, ESRTStreamMode StreamMode, bool bOverloadGovernor,
+                                     ESRTTimedMetadataFormat MetadataFormat = ESRTTimedMetadataFormat::None)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        USRTStreamComponent* Stream = NewObject<USRTStreamComponent>(Actor);
+        Stream->StreamMode = StreamMode;
+        Stream->StreamFPS = Options.FPS;
+        Stream->BitrateKbps = Options.BitrateKbps;
+        Stream->QualityPreset = ParsePreset(Options.Preset);
+        Stream->VideoCodec = Options.Codec.Equals(TEXT("HEVC"), ESearchCase::IgnoreCase) ? ESRTVideoCodec::HEVC : ESRTVideoCodec::H264;
+        Stream->bUseHardwareAcceleration = false;   // 하드웨어 인코더 유무에 따라 결과가 달라지지 않게
+        Stream->ConnectionMode = ESRTConnectionMode::Caller;
+        Stream->StreamIP = TEXT("127.0.0.1");
+        Stream->StreamPort = Options.Port;
+        Stream->LatencyMs = Options.LatencyMs;
+        Stream->bEmbedCaptureTimestamp = true;      // 수신 측 지연 측정에 필요
+        Stream->CaptureFormat = ParseCaptureFormat(Options.CaptureFormat);
+        Stream->bEnableOverloadGovernor = bOverloadGovernor;
+        Stream->OverloadRecoverSeconds = 3.0f;      // 시험 시간을 줄임 (단계마다 쿨다운 + 3초)
+        Stream->TimedMetadataFormat = MetadataFormat;
+        ConfigureSource(Stream, Options.Source);
+        Stream->RegisterComponent();
+        Stream->StartStreaming();
+        return Stream;
+    }
+
+    void DestroyStream(USRTStreamComponent* Stream)
+    {
+        AActor* Actor = Stream->GetOwner();
+        Stream->StopStreaming();
+        Stream->DestroyComponent();
+        Actor->Destroy();
+    }
+
+    // 게임 스레드 루프 - 서브시스템 틱(캡처 요청)과 게임 스레드 태스크 처리만 (OnPump는 매 바퀴 끝에)
+    void PumpFor(USRTStreamSubsystem* Subsystem, double Seconds, const TFunction<void()>& OnPump = TFunction<void()>())
+    {
+        const double EndTime = FPlatformTime::Seconds() + Seconds;
+        double LastTick = FPlatformTime::Seconds();
+        while (FPlatformTime::Seconds() < EndTime)
+        {
+            const double Now = FPlatformTime::Seconds();
+            Subsystem->Tick((float)(Now - LastTick));
+            LastTick = Now;
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+            if (OnPump)
+            {
+                OnPump();
+            }
+            FPlatformProcess::Sleep(0.001f);
+        }
+    }
+
+    bool RunOnce(UWorld* World, USRTStreamSubsystem* Subsystem, const FBenchmarkOptions& Options,
+                 const FString& Resolution, FRunResult& OutResult, FString& OutError)
+    {
+        ESRTStreamMode StreamMode;
+        ResolveStreamMode(Resolution, StreamMode, OutResult.Width, OutResult.Height);
+        OutResult.Resolution = Resolution;
+
+        FBenchmarkReceiver Receiver;
+        if (!Receiver.Start(Options.Port, Options.LatencyMs, OutError))
+            return false;
+
+        USRTStreamComponent* Stream = SpawnStream(World, Options, StreamMode, false);
+
+        bool bSucceeded = Stream->IsStreaming();
+        if (!bSucceeded)
+        {
+            OutError = FString::Printf(TEXT("StartStreaming failed: %s"), *Stream->LastErrorMessage);
+        }
+        else
+        {
+            // 워밍업: 연결, 인코더 룩어헤드, 스레드 풀이 자리 잡을 때까지
+            PumpFor(Subsystem, Options.WarmupFrames / Options.FPS);
+            if (Stream->ConnectionState == ESRTConnectionState::Error)
+            {
+                OutError = FString::Printf(TEXT("Connection failed: %s"), *Stream->LastErrorMessage);
+                bSucceeded = false;
+            }
+        }
+
+        if (bSucceeded)
+        {
+
+            const double MeasureSeconds = Options.Frames / Options.FPS;
+            FSRTFrameTraceRecorder::Get().Reset();
+            Receiver.SetMeasuring(true);
+            const double CPUStart = GetProcessCPUSeconds();
+            const double WallStart = FPlatformTime::Seconds();
+            const uint64 WindowStart = FPlatformTime::Cycles64();
+
+            PumpFor(Subsystem, MeasureSeconds);
+
+            const double WallSeconds = FPlatformTime::Seconds() - WallStart;
+            OutResult.CPUCores = (GetProcessCPUSeconds() - CPUStart) / FMath::Max(WallSeconds, 0.001);
+            Receiver.SetMeasuring(false);
+
+            // 측정 구간에 캡처된 프레임만 (워밍업 프레임의 늦은 기록 제외)
+            const TArray<FSRTFrameTrace> Traces = FSRTFrameTraceRecorder::Get().GetRecorded();
+            const double MsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+            TArray<double> PipelineMs;
+            TArray<double> StageValues[StageCount];
+            for (const FSRTFrameTrace& Trace : Traces)
+            {
+                const uint64 Capture = Trace.StageCycles[(int32)ESRTTraceStage::Capture];
+                const uint64 SendEnd = Trace.StageCycles[(int32)ESRTTraceStage::SendEnd];
+                if (Capture < WindowStart || SendEnd < Capture)
+                    continue;
+
+                PipelineMs.Add((SendEnd - Capture) * MsPerCycle);
+                for (int32 i = 0; i < StageCount; i++)
+                {
+                    const uint64 Begin = Trace.StageCycles[(int32)Stages[i].Begin];
+                    const uint64 End = Trace.StageCycles[(int32)Stages[i].End];
+                    if (Begin != 0 && End >= Begin)
+                    {
+                        StageValues[i].Add((End - Begin) * MsPerCycle);
+                    }
+                }
+            }
+
+            OutResult.FramesSent = PipelineMs.Num();
+            OutResult.SustainedFPS = PipelineMs.Num() / FMath::Max(WallSeconds, 0.001);
+            OutResult.PipelineMs = ComputePercentiles(PipelineMs);
+            for (int32 i = 0; i < StageCount; i++)
+            {
+                OutResult.StageMs[i] = ComputePercentiles(StageValues[i]);
+            }
+
+            TArray<double> DeliveryMs;
+            Receiver.GetResults(DeliveryMs, OutResult.ReceivedBytes);
+            OutResult.DeliveryMs = ComputePercentiles(DeliveryMs);
+
+            // 씬 캡처가 아니면 항상 패턴/파일 (FSRTGeneratedFrameSource)
+            const TSharedPtr<FSRTFrameSource> Source = Stream->GetFrameSource();
+            if (Source.IsValid())
+            {
+                OutResult.FrameBytes = SRTYUV::GetFrameBytes(Source->GetOutputFormat(), OutResult.Width, OutResult.Height);
+            }
+            if (Source.IsValid() && Stream->FrameSource != ESRTFrameSourceType::SceneCapture)
+            {
+                OutResult.FramesSkipped = static_cast<const FSRTGeneratedFrameSource*>(Source.Get())->GetSkippedFrames();
+            }
+
+            if (OutResult.FramesSent == 0)
+            {
+                bSucceeded = false;
+                OutError = TEXT("No frame reached the SRT socket (is CineSRT.FrameTrace compiled in?)");
+            }
+        }
+
+        DestroyStream(Stream);
+        Receiver.Stop();
+        return bSucceeded;
+    }
+
+    // 인코더가 CPU를 못 받을 때 - 단계를 내려 프레임 간격을 지키는지, 부하가 사라지면 다시 올라오는지
+    // 0 = 통과, 1 = 조정이 기대대로 움직이지 않음, 2 = 설정/연결 오류
+    int32 RunOverloadTest(UWorld* World, USRTStreamSubsystem* Subsystem, const FBenchmarkOptions& Options, const FString& Resolution)
+    {
+        ESRTStreamMode StreamMode;
+        int32 Width, Height;
+        ResolveStreamMode(Resolution, StreamMode, Width, Height);
+
+        IConsoleVariable* SlowdownVar = IConsoleManager::Get().FindConsoleVariable(TEXT("CineSRT.SimulateEncoderSlowdown"));
+        FBenchmarkReceiver Receiver;
+        FString Error;
+        if (!SlowdownVar || !Receiver.Start(Options.Port, Options.LatencyMs, Error))
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Overload test: %s"), SlowdownVar ? *Error : TEXT("CineSRT.SimulateEncoderSlowdown not available"));
+            return 2;
+        }
+
+        USRTStreamComponent* Stream = SpawnStream(World, Options, StreamMode, true);
+        if (!Stream->IsStreaming())
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Overload test: StartStreaming failed: %s"), *Stream->LastErrorMessage);
+            DestroyStream(Stream);
+            return 2;
+        }
+
+        // 기준: 부하 없이 한 프레임 변환 + 인코딩 시간
+        PumpFor(Subsystem, Options.WarmupFrames / Options.FPS);
+        FSRTFrameTraceRecorder::Get().Reset();
+        PumpFor(Subsystem, 2.0);
+        TArray<double> EncodeMs;
+        for (const FSRTFrameTrace& Trace : FSRTFrameTraceRecorder::Get().GetRecorded())
+        {
+            const uint64 Begin = Trace.StageCycles[(int32)ESRTTraceStage::ConvertBegin];
+            const uint64 End = Trace.StageCycles[(int32)ESRTTraceStage::EncodeEnd];
+            if (Begin != 0 && End >= Begin)
+            {
+                EncodeMs.Add((End - Begin) * FPlatformTime::GetSecondsPerCycle64() * 1000.0);
+            }
+        }
+        const double BaselineMs = ComputePercentiles(EncodeMs).Mean;
+        if (Stream->ConnectionState == ESRTConnectionState::Error || BaselineMs <= 0.0 || Stream->OverloadLevel != 0)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Overload test: no baseline (%s, level %d)"), *Stream->LastErrorMessage, Stream->OverloadLevel);
+            DestroyStream(Stream);
+            return 2;
+        }
+
+        // 내림: 인코딩이 프레임 간격의 두 배 걸리게 굶김 → 단계가 멈춘 뒤 3초 동안 받은 프레임으로 간격 확인
+        const double IntervalMs = 1000.0 / Options.FPS;
+        const float Slowdown = Options.Slowdown > 1.0f ? Options.Slowdown : (float)FMath::Max(2.0, 2.0 * IntervalMs / BaselineMs);
+        UE_LOG(LogCineSRTStream, Display, TEXT("Overload test: %s baseline %.2f ms / %.2f ms interval, starving encoder x%.2f"),
+            *Stream->OverloadState, BaselineMs, IntervalMs, Slowdown);
+        SlowdownVar->Set(Slowdown);
+
+        // 조정기 창(1초) + 쿨다운(2초) 넘게 그대로면 자리 잡은 것
+        const double SettleSeconds = 5.0;
+        auto WaitForLevel = [Subsystem, Stream](double MaxSeconds, double StableSeconds, TFunctionRef<bool(int32)> Done)
+        {
+            const double EndTime = FPlatformTime::Seconds() + MaxSeconds;
+            int32 Level = Stream->OverloadLevel;
+            double ChangedAt = FPlatformTime::Seconds();
+            while (FPlatformTime::Seconds() < EndTime)
+            {
+                PumpFor(Subsystem, 0.25);
+                if (Stream->OverloadLevel != Level)
+                {
+                    Level = Stream->OverloadLevel;
+                    ChangedAt = FPlatformTime::Seconds();
+                }
+                if (Done(Level) && FPlatformTime::Seconds() - ChangedAt >= StableSeconds)
+                    return true;
+            }
+            return false;
+        };
+
+        int32 ExitCode = 0;
+        const bool bSettled = WaitForLevel(Options.OverloadSeconds, SettleSeconds, [](int32 Level) { return Level > 0; });
+        const int32 StarvedLevel = Stream->OverloadLevel;
+        const float GovernedFPS = Stream->GetCaptureFPS();
+
+        Receiver.SetMeasuring(true);
+        const double MeasureStart = FPlatformTime::Seconds();
+        PumpFor(Subsystem, 3.0);
+        Receiver.SetMeasuring(false);
+        TArray<double> DeliveryMs;
+        int64 ReceivedBytes = 0;
+        Receiver.GetResults(DeliveryMs, ReceivedBytes);
+        const double ReceivedFPS = DeliveryMs.Num() / (FPlatformTime::Seconds() - MeasureStart);
+        const bool bCadence = ReceivedFPS >= GovernedFPS * 0.95;
+
+        UE_LOG(LogCineSRTStream, Display, TEXT("Overload test: starved -> level %d (%s)%s, received %.2f / %.0f fps %s, delivery p95 %.1f ms"),
+            StarvedLevel, *Stream->OverloadState, bSettled ? TEXT("") : TEXT(" NOT SETTLED"),
+            ReceivedFPS, GovernedFPS, bCadence ? TEXT("OK") : TEXT("IRREGULAR"), ComputePercentiles(DeliveryMs).P95);
+        if (!bSettled || !bCadence)
+        {
+            ExitCode = 1;
+        }
+
+        // 올림: 부하를 없애면 단계가 돌아옴 (0단계까지 못 가도 한 단계 이상 오르면 통과 - 기준 부하가 높은 기계)
+        SlowdownVar->Set(1.0f);
+        const bool bFullyRecovered = WaitForLevel(Options.RecoverSeconds, 0.0, [](int32 Level) { return Level == 0; });
+        const int32 RecoveredLevel = Stream->OverloadLevel;
+        const bool bRecovered = StarvedLevel > 0 && RecoveredLevel < StarvedLevel;
+        UE_LOG(LogCineSRTStream, Display, TEXT("Overload test: load removed -> level %d (%s)%s"),
+            RecoveredLevel, *Stream->OverloadState, bFullyRecovered ? TEXT("") : TEXT(" (not back to level 0)"));
+        if (!bRecovered)
+        {
+            ExitCode = 1;
+        }
+
+        UE_LOG(LogCineSRTStream, Display, TEXT("Overload test: %s"), ExitCode == 0 ? TEXT("PASSED") : TEXT("FAILED"));
+        DestroyStream(Stream);
+        Receiver.Stop();
+        return ExitCode;
+    }
+
+    // 메타데이터 시험 한 회 - 측정 구간 동안 매 프레임 다음 프레임 PTS로 메타데이터 예약
+    struct FMetadataPass
+    {
+        FPercentiles DeliveryMs;        // 캡처 → 프레임 마지막 메시지 수신
+        FPercentiles IntervalErrorMs;   // |비디오 PES 도착 간격 - PTS 간격|
+        double ReceivedFPS = 0.0;
+        int32 Scheduled = 0;
+        int32 MetadataReceived = 0;
+        int32 MetadataOnFrame = 0;      // PTS가 받은 비디오 PES 중 하나와 같음 (프레임 정확)
+    };
+
+    void BuildMetadataPayload(ESRTTimedMetadataFormat Format, int32 Sequence, TArray<uint8>& OutPayload)
+    {
+        const int64 NowUs = SRTNetwork::ToUtcMicroseconds(FPlatformTime::Seconds());
+        if (Format == ESRTTimedMetadataFormat::ID3)
+        {
+            FSRTTransportStream::BuildID3TextTag(TEXT("CineSRTBenchmark"),
+                FString::Printf(TEXT("frame=%d utc=%lld"), Sequence, NowUs), OutPayload);
+            return;
+        }
+
+        // KLV: MISB ST 0601 로컬 셋 키 + Precision Time Stamp(태그 2, 8바이트 us)
+        static const uint8 Key[16] = { 0x06, 0x0E, 0x2B, 0x34, 0x02, 0x0B, 0x01, 0x01, 0x0E, 0x01, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00 };
+        OutPayload.Reset();
+        OutPayload.Append(Key, 16);
+        OutPayload.Add(10);
+        OutPayload.Add(2);
+        OutPayload.Add(8);
+        for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+        {
+            OutPayload.Add((uint8)(NowUs >> Shift));
+        }
+    }
+
+    bool RunMetadataPass(UWorld* World, USRTStreamSubsystem* Subsystem, const FBenchmarkOptions& Options, ESRTStreamMode StreamMode,
+                         ESRTTimedMetadataFormat Format, FMetadataPass& OutPass, FString& OutError)
+    {
+        FBenchmarkReceiver Receiver;
+        if (!Receiver.Start(Options.Port, Options.LatencyMs, OutError))
+            return false;
+
+        USRTStreamComponent* Stream = SpawnStream(World, Options, StreamMode, false, Format);
+        bool bSucceeded = Stream->IsStreaming();
+        if (!bSucceeded)
+        {
+            OutError = FString::Printf(TEXT("StartStreaming failed: %s"), *Stream->LastErrorMessage);
+        }
+        else
+        {
+            PumpFor(Subsystem, Options.WarmupFrames / Options.FPS);
+            if (Stream->ConnectionState == ESRTConnectionState::Error)
+            {
+                OutError = FString::Printf(TEXT("Connection failed: %s"), *Stream->LastErrorMessage);
+                bSucceeded = false;
+            }
+        }
+
+        if (bSucceeded)
+        {
+            Receiver.SetMeasuring(true);
+            const double MeasureStart = FPlatformTime::Seconds();
+            int64 LastPTS = -1;
+            TArray<uint8> Payload;
+            PumpFor(Subsystem, Options.Frames / Options.FPS, [&]()
+            {
+                // 인코더가 다음 프레임을 넘길 때마다 한 번 - 그 다음 프레임 PTS에 실음
+                const int64 PTS = Stream->GetFramePTS(1);
+                if (Format == ESRTTimedMetadataFormat::None || PTS <= LastPTS)
+                    return;
+                LastPTS = PTS;
+                BuildMetadataPayload(Format, OutPass.Scheduled, Payload);
+                if (Stream->ScheduleTimedMetadata(PTS, Payload))
+                {
+                    OutPass.Scheduled++;
+                }
+            });
+            // 마지막에 예약한 프레임까지 받도록 몇 프레임 더
+            PumpFor(Subsystem, 4.0 / Options.FPS);
+            const double MeasureSeconds = FPlatformTime::Seconds() - MeasureStart;
+            Receiver.SetMeasuring(false);
+
+            TArray<double> DeliveryMs;
+            int64 ReceivedBytes = 0;
+            Receiver.GetResults(DeliveryMs, ReceivedBytes);
+            TArray<FReceivedPES> Video;
+            TArray<FReceivedPES> Metadata;
+            Receiver.GetPES(Video, Metadata);
+
+            TArray<double> IntervalErrorMs;
+            TSet<int64> VideoPTS;
+            for (int32 i = 0; i < Video.Num(); i++)
+            {
+                VideoPTS.Add(Video[i].PTS);
+                if (i > 0)
+                {
+                    const double ArrivalMs = (Video[i].ArrivalUs - Video[i - 1].ArrivalUs) / 1000.0;
+                    const double PTSMs = (Video[i].PTS - Video[i - 1].PTS) / 90.0;
+                    IntervalErrorMs.Add(FMath::Abs(ArrivalMs - PTSMs));
+                }
+            }
+            for (const FReceivedPES& Item : Metadata)
+            {
+                OutPass.MetadataOnFrame += VideoPTS.Contains(Item.PTS) ? 1 : 0;
+            }
+
+            OutPass.DeliveryMs = ComputePercentiles(DeliveryMs);
+            OutPass.IntervalErrorMs = ComputePercentiles(IntervalErrorMs);
+            OutPass.ReceivedFPS = Video.Num() / FMath::Max(MeasureSeconds, 0.001);
+            OutPass.MetadataReceived = Metadata.Num();
+            if (Video.Num() < 2)
+            {
+                OutError = TEXT("No video PES received");
+                bSucceeded = false;
+            }
+        }
+
+        DestroyStream(Stream);
+        Receiver.Stop();
+        return bSucceeded;
+    }
+
+    // 매 프레임(기본 60 Hz) ID3/KLV 메타데이터가 비디오 전달을 늦추지 않는지 - 메타데이터 없는 기준과 번갈아 Repeat 회
+    // 0 = 통과, 1 = 지연/간격이 MaxDeltaMs 넘게 늘거나 메타데이터 유실/프레임 어긋남, 2 = 설정/연결 오류
+    int32 RunMetadataTest(UWorld* World, USRTStreamSubsystem* Subsystem, const FBenchmarkOptions& Options, const FString& Resolution)
+    {
+        ESRTStreamMode StreamMode;
+        int32 Width, Height;
+        ResolveStreamMode(Resolution, StreamMode, Width, Height);
+        const ESRTTimedMetadataFormat Format = Options.MetadataFormat.Equals(TEXT("KLV"), ESearchCase::IgnoreCase)
+            ? ESRTTimedMetadataFormat::KLV : ESRTTimedMetadataFormat::ID3;
+        const TCHAR* FormatName = Format == ESRTTimedMetadataFormat::KLV ? TEXT("KLV") : TEXT("ID3");
+
+        TArray<FMetadataPass> Baseline;
+        TArray<FMetadataPass> WithMetadata;
+        for (int32 RepeatIndex = 0; RepeatIndex < Options.Repeat; RepeatIndex++)
+        {
+            for (const ESRTTimedMetadataFormat PassFormat : { ESRTTimedMetadataFormat::None, Format })
+            {
+                FMetadataPass Pass;
+                FString Error;
+                if (!RunMetadataPass(World, Subsystem, Options, StreamMode, PassFormat, Pass, Error))
+                {
+                    UE_LOG(LogCineSRTStream, Error, TEXT("Metadata test: %s run %d failed: %s"), *Resolution, RepeatIndex + 1, *Error);
+                    return 2;
+                }
+
+                UE_LOG(LogCineSRTStream, Display, TEXT("Metadata test: %s run %d %s: %.2f fps, delivery p50 %.2f / p95 %.2f ms, PES interval error p95 %.2f ms, metadata %d / %d (%d on frame)"),
+                    *Resolution, RepeatIndex + 1, PassFormat == ESRTTimedMetadataFormat::None ? TEXT("baseline") : FormatName,
+                    Pass.ReceivedFPS, Pass.DeliveryMs.P50, Pass.DeliveryMs.P95, Pass.IntervalErrorMs.P95,
+                    Pass.MetadataReceived, Pass.Scheduled, Pass.MetadataOnFrame);
+                (PassFormat == ESRTTimedMetadataFormat::None ? Baseline : WithMetadata).Add(Pass);
+            }
+        }
+
+        auto MedianOf = [](const TArray<FMetadataPass>& Passes, TFunctionRef<double(const FMetadataPass&)> Get)
+        {
+            TArray<double> Values;
+            for (const FMetadataPass& Pass : Passes)
+            {
+                Values.Add(Get(Pass));
+            }
+            return Median(Values);
+        };
+
+        const double DeliveryDelta = MedianOf(WithMetadata, [](const FMetadataPass& Pass) { return Pass.DeliveryMs.P95; })
+            - MedianOf(Baseline, [](const FMetadataPass& Pass) { return Pass.DeliveryMs.P95; });
+        const double IntervalDelta = MedianOf(WithMetadata, [](const FMetadataPass& Pass) { return Pass.IntervalErrorMs.P95; })
+            - MedianOf(Baseline, [](const FMetadataPass& Pass) { return Pass.IntervalErrorMs.P95; });
+        const double FPSRatio = MedianOf(WithMetadata, [](const FMetadataPass& Pass) { return Pass.ReceivedFPS; })
+            / FMath::Max(MedianOf(Baseline, [](const FMetadataPass& Pass) { return Pass.ReceivedFPS; }), 0.001);
+
+        int32 Scheduled = 0;
+        int32 Received = 0;
+        int32 OnFrame = 0;
+        for (const FMetadataPass& Pass : WithMetadata)
+        {
+            Scheduled += Pass.Scheduled;
+            Received += Pass.MetadataReceived;
+            OnFrame += Pass.MetadataOnFrame;
+        }
+
+        // 측정 구간 경계에서 잘리는 몇 개 외에는 모두 제 프레임과 함께 도착해야 함
+        const bool bDelivery = DeliveryDelta <= Options.MaxDeltaMs;
+        const bool bInterval = IntervalDelta <= Options.MaxDeltaMs;
+        const bool bThroughput = FPSRatio >= 0.98;
+        const bool bMetadata = Scheduled > 0 && Received >= Scheduled * 0.95 && OnFrame >= Received * 0.95;
+
+        UE_LOG(LogCineSRTStream, Display, TEXT("Metadata test: %s %.0f Hz %s vs baseline: delivery p95 %+.2f ms %s, PES interval error p95 %+.2f ms %s, fps x%.3f %s, metadata %d / %d (%d on frame) %s"),
+            *Resolution, Options.FPS, FormatName,
+            DeliveryDelta, bDelivery ? TEXT("OK") : TEXT("SLOWER"),
+            IntervalDelta, bInterval ? TEXT("OK") : TEXT("IRREGULAR"),
+            FPSRatio, bThroughput ? TEXT("OK") : TEXT("DROPPED"),
+            Received, Scheduled, OnFrame, bMetadata ? TEXT("OK") : TEXT("LOST"));
+
+        const int32 ExitCode = (bDelivery && bInterval && bThroughput && bMetadata) ? 0 : 1;
+        UE_LOG(LogCineSRTStream, Display, TEXT("Metadata test: %s"), ExitCode == 0 ? TEXT("PASSED") : TEXT("FAILED"));
+        return ExitCode;
+    }
+
+    // 수신기가 사라졌다 돌아올 때 - Reconnecting → Streaming 전이, 재연결 직후 PAT/PMT와 IDR부터, 복구 시간 기록
+    // 0 = 통과, 1 = 재연결/복구 스트림이 기대와 다름, 2 = 설정/연결 오류
+    int32 RunReconnectTest(UWorld* World, USRTStreamSubsystem* Subsystem, const FBenchmarkOptions& Options, const FString& Resolution)
+    {
+        ESRTStreamMode StreamMode;
+        int32 Width, Height;
+        ResolveStreamMode(Resolution, StreamMode, Width, Height);
+
+        FBenchmarkReceiver Receiver;
+        Receiver.SetHEVC(Options.Codec.Equals(TEXT("HEVC"), ESearchCase::IgnoreCase));
+        FString Error;
+        if (!Receiver.Start(Options.Port, Options.LatencyMs, Error))
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Reconnect test: %s"), *Error);
+            return 2;
+        }
+
+        USRTStreamComponent* Stream = SpawnStream(World, Options, StreamMode, false);
+        if (!Stream->IsStreaming())
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Reconnect test: StartStreaming failed: %s"), *Stream->LastErrorMessage);
+            DestroyStream(Stream);
+            return 2;
+        }
+
+        // 통계(ReconnectCount, LastRecoveryTimeMs)는 컴포넌트 틱에서 갱신 - 게임 월드처럼 매 바퀴 틱
+        double LastTick = FPlatformTime::Seconds();
+        auto TickStream = [Stream, &LastTick]()
+        {
+            const double Now = FPlatformTime::Seconds();
+            Stream->TickComponent((float)(Now - LastTick), LEVELTICK_All, nullptr);
+            LastTick = Now;
+        };
+        auto WaitFor = [Subsystem, &TickStream](double MaxSeconds, TFunctionRef<bool()> Done)
+        {
+            const double EndTime = FPlatformTime::Seconds() + MaxSeconds;
+            while (FPlatformTime::Seconds() < EndTime)
+            {
+                PumpFor(Subsystem, 0.05, TickStream);
+                if (Done())
+                    return true;
+            }
+            return false;
+        };
+
+        const bool bConnected = WaitFor(10.0, [Stream]() { return Stream->ConnectionState == ESRTConnectionState::Streaming; });
+        PumpFor(Subsystem, Options.WarmupFrames / Options.FPS, TickStream);
+        const FConnectionStart First = Receiver.GetConnectionStart();
+        if (!bConnected || Stream->ConnectionState != ESRTConnectionState::Streaming || !First.bChecked)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Reconnect test: no initial stream (%s)"), *Stream->LastErrorMessage);
+            DestroyStream(Stream);
+            Receiver.Stop();
+            return 2;
+        }
+
+        // 끊김: 수신기를 닫음 → 송신 측이 연결 끊김을 보고 재연결을 시작해야 함
+        Receiver.Stop();
+        const double OutageStart = FPlatformTime::Seconds();
+        const bool bReconnecting = WaitFor(15.0, [Stream]() { return Stream->ConnectionState == ESRTConnectionState::Reconnecting; });
+        const double DetectSeconds = FPlatformTime::Seconds() - OutageStart;
+        PumpFor(Subsystem, Options.OutageSeconds, TickStream);
+
+        // 복구: 같은 포트로 다시 열면 백오프 간격 안에 다시 붙어야 함
+        const bool bRestarted = Receiver.Start(Options.Port, Options.LatencyMs, Error);
+        const double RestartTime = FPlatformTime::Seconds();
+        const bool bStreaming = bRestarted && WaitFor(Stream->ReconnectMaxDelayMs / 1000.0 + 10.0, [Stream]()
+        {
+            return Stream->ConnectionState == ESRTConnectionState::Streaming && Stream->ReconnectCount >= 1;
+        });
+        const double ResumeSeconds = FPlatformTime::Seconds() - RestartTime;
+
+        // 첫 IDR 전송 뒤 통계 주기(1초) 한 번은 지나야 LastRecoveryTimeMs가 보임
+        WaitFor(3.0, [Stream, &Receiver]() { return Stream->LastRecoveryTimeMs > 0.0f && Receiver.GetConnectionStart().bChecked; });
+        const FConnectionStart Second = Receiver.GetConnectionStart();
+        const bool bNewConnection = Second.Connections == First.Connections + 1 && Second.bChecked;
+        const bool bRecoveryTime = Stream->LastRecoveryTimeMs > 0.0f;
+
+        UE_LOG(LogCineSRTStream, Display, TEXT("Reconnect test: %s, receiver closed -> Reconnecting %s (%.2f s), reopened -> Streaming %s (%.2f s, %d reconnect(s))"),
+            *Resolution, bReconnecting ? TEXT("OK") : TEXT("MISSING"), DetectSeconds,
+            bStreaming ? TEXT("OK") : TEXT("MISSING"), ResumeSeconds, Stream->ReconnectCount);
+        UE_LOG(LogCineSRTStream, Display, TEXT("Reconnect test: first connection PAT/PMT %s, IDR %s; after reconnect PAT/PMT %s, IDR %s; recovery %.0f ms %s"),
+            First.bTablesFirst ? TEXT("first") : TEXT("LATE"), First.bIDRFirst ? TEXT("first") : TEXT("LATE"),
+            !bNewConnection ? TEXT("NOT SEEN") : Second.bTablesFirst ? TEXT("first") : TEXT("LATE"),
+            !bNewConnection ? TEXT("NOT SEEN") : Second.bIDRFirst ? TEXT("first") : TEXT("LATE"),
+            Stream->LastRecoveryTimeMs, bRecoveryTime ? TEXT("OK") : TEXT("NOT RECORDED"));
+
+        const bool bPassed = bReconnecting && bStreaming && bNewConnection && bRecoveryTime
+            && Second.bTablesFirst && Second.bIDRFirst;
+        const int32 ExitCode = !bRestarted ? 2 : bPassed ? 0 : 1;
+        if (!bRestarted)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Reconnect test: %s"), *Error);
+        }
+        UE_LOG(LogCineSRTStream, Display, TEXT("Reconnect test: %s"), ExitCode == 0 ? TEXT("PASSED") : TEXT("FAILED"));
+        DestroyStream(Stream);
+        Receiver.Stop();
+        return ExitCode;
+    }
+
+    // CPU 참조 YUV 변환(GPU 셰이더와 같은 식) 검증 + 해상도별 프레임 크기와 변환 시간 - GPU 없이 실행
+    // 0 = 통과, 1 = 표준값과 다름
+    int32 RunYUVTest(const FBenchmarkOptions& Options)
+    {
+        int32 Failures = 0;
+        auto Check = [&Failures](const TCHAR* What, int32 Got, int32 Expected)
+        {
+            if (Got != Expected)
+            {
+                UE_LOG(LogCineSRTStream, Error, TEXT("YUV test: %s = %d, expected %d"), What, Got, Expected);
+                Failures++;
+            }
+        };
+
+        // 100% 컬러 바 (흰, 노랑, 청록, 초록, 자홍, 빨강, 파랑, 검정) - 제한 범위 표준값 (Y, Cb, Cr)
+        const uint8 BarRGB[8][3] = { {255,255,255}, {255,255,0}, {0,255,255}, {0,255,0}, {255,0,255}, {255,0,0}, {0,0,255}, {0,0,0} };
+        const uint8 Expected709[8][3] = { {235,128,128}, {219,16,138}, {188,154,16}, {173,42,26}, {78,214,230}, {63,102,240}, {32,240,118}, {16,128,128} };
+        const uint8 Expected601[8][3] = { {235,128,128}, {210,16,146}, {170,166,16}, {145,54,34}, {106,202,222}, {81,90,240}, {41,240,110}, {16,128,128} };
+        const EVideoPixelFormat YUVFormats[] = { EVideoPixelFormat::NV12, EVideoPixelFormat::I420 };
+
+        // 단색 2x2 블록 → Y 4개 뒤에 (2x2면 NV12/I420 모두) U, V
+        auto ConvertSolid = [](const uint8 RGB[3], EVideoPixelFormat Format, const FSRTYUVColorParams& Color, uint8 Out[6])
+        {
+            uint8 Block[16];
+            for (int32 i = 0; i < 4; i++)
+            {
+                Block[i * 4] = RGB[2];
+                Block[i * 4 + 1] = RGB[1];
+                Block[i * 4 + 2] = RGB[0];
+                Block[i * 4 + 3] = 255;
+            }
+            SRTYUV::ConvertBGRA(Block, 2, 2, 2, Format, Color, Out);
+        };
+
+        for (const EVideoPixelFormat Format : YUVFormats)
+        {
+            for (int32 MatrixIndex = 0; MatrixIndex < 2; MatrixIndex++)
+            {
+                FSRTYUVColorParams Color;
+                Color.Matrix = MatrixIndex == 0 ? EVideoColorMatrix::BT709 : EVideoColorMatrix::BT601;
+                const uint8 (*Expected)[3] = MatrixIndex == 0 ? Expected709 : Expected601;
+                for (int32 Bar = 0; Bar < 8; Bar++)
+                {
+                    uint8 Out[6];
+                    ConvertSolid(BarRGB[Bar], Format, Color, Out);
+                    const FString What = FString::Printf(TEXT("%s %s bar %d"), SRTYUV::GetFormatName(Format), Color.ToString(), Bar);
+                    for (int32 i = 0; i < 4; i++)
+                    {
+                        Check(*(What + TEXT(" Y")), Out[i], Expected[Bar][0]);
+                    }
+                    Check(*(What + TEXT(" U")), Out[4], Expected[Bar][1]);
+                    Check(*(What + TEXT(" V")), Out[5], Expected[Bar][2]);
+                }
+            }
+
+            // 전체 범위 끝값
+            FSRTYUVColorParams FullRange;
+            FullRange.bFullRange = true;
+            uint8 Out[6];
+            ConvertSolid(BarRGB[0], Format, FullRange, Out);
+            Check(TEXT("full range white Y"), Out[0], 255);
+            ConvertSolid(BarRGB[7], Format, FullRange, Out);
+            Check(TEXT("full range black Y"), Out[0], 0);
+            Check(TEXT("full range black U"), Out[4], 128);
+        }
+
+        // 해상도별: NV12와 I420은 배치만 다른 같은 값인지 + 프레임 크기(리드백)와 CPU 변환 시간
+        const FSRTYUVColorParams Color;
+        for (const FString& Resolution : Options.Resolutions)
+        {
+            ESRTStreamMode StreamMode;
+            int32 Width, Height;
+            ResolveStreamMode(Resolution, StreamMode, Width, Height);
+
+            TArray<uint8> BGRA;
+            BGRA.SetNumUninitialized(Width * Height * 4);
+            FRandomStream Random(Width);
+            for (uint8& Byte : BGRA)
+            {
+                Byte = (uint8)Random.RandRange(0, 255);
+            }
+
+            TArray<uint8> NV12, I420;
+            NV12.SetNumUninitialized(SRTYUV::GetFrameBytes(EVideoPixelFormat::NV12, Width, Height));
+            I420.SetNumUninitialized(NV12.Num());
+            const int32 Iterations = 10;
+            const double Start = FPlatformTime::Seconds();
+            for (int32 i = 0; i < Iterations; i++)
+            {
+                SRTYUV::ConvertBGRA(BGRA.GetData(), Width, Width, Height, EVideoPixelFormat::NV12, Color, NV12.GetData());
+            }
+            const double ConvertMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+            SRTYUV::ConvertBGRA(BGRA.GetData(), Width, Width, Height, EVideoPixelFormat::I420, Color, I420.GetData());
+
+            const int32 LumaBytes = Width * Height;
+            const int32 ChromaBytes = LumaBytes / 4;
+            int32 Mismatched = FMemory::Memcmp(NV12.GetData(), I420.GetData(), LumaBytes) != 0 ? 1 : 0;
+            for (int32 i = 0; i < ChromaBytes; i++)
+            {
+                Mismatched += (NV12[LumaBytes + i * 2] != I420[LumaBytes + i]) ? 1 : 0;
+                Mismatched += (NV12[LumaBytes + i * 2 + 1] != I420[LumaBytes + ChromaBytes + i]) ? 1 : 0;
+            }
+            Check(*FString::Printf(TEXT("%s NV12/I420 mismatched bytes"), *Resolution), Mismatched, 0);
+
+            const double MB = 1024.0 * 1024.0;
+            const int32 BGRABytes = SRTYUV::GetFrameBytes(EVideoPixelFormat::BGRA, Width, Height);
+            UE_LOG(LogCineSRTStream, Display, TEXT("YUV test: %s %dx%d readback per frame BGRA %.2f MB -> NV12/I420 %.2f MB (%.1f%% less, %.0f -> %.0f MB/s at %.0f fps), CPU reference %.2f ms/frame"),
+                *Resolution, Width, Height, BGRABytes / MB, NV12.Num() / MB, (1.0 - (double)NV12.Num() / BGRABytes) * 100.0,
+                BGRABytes * Options.FPS / MB, NV12.Num() * Options.FPS / MB, Options.FPS, ConvertMs);
+        }
+
+        UE_LOG(LogCineSRTStream, Display, TEXT("YUV test: %s"), Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"));
+        return Failures == 0 ? 0 : 1;
+    }
+
+    // GMalloc 앞에 끼워 지정한 스레드의 할당만 세는 프록시 (-EventTest) - 나머지는 그대로 넘김
+    class FCountingMalloc : public FMalloc
+    {
+    public:
+        explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+        // 세기 전에 (Begin 전) 스레드 등록
+        void Track(uint32 ThreadId) { TrackedThreads.Add(ThreadId); }
+        void Begin() { Count = 0; bCounting = true; }
+        int32 End() { bCounting = false; return Count.Load(); }
+
+        virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Note(); return Inner->Malloc(Size, Alignment); }
+        virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Note(); return Inner->TryMalloc(Size, Alignment); }
+        virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override { Note(); return Inner->Realloc(Original, Size, Alignment); }
+        virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override { Note(); return Inner->TryRealloc(Original, Size, Alignment); }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& OutSize) override { return Inner->GetAllocationSize(Original, OutSize); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        FMalloc* Inner;
+        TArray<uint32, TInlineAllocator<4>> TrackedThreads;
+        TAtomic<bool> bCounting{false};
+        TAtomic<int32> Count{0};
+
+        void Note()
+        {
+            if (bCounting && TrackedThreads.Contains(FPlatformTLS::GetCurrentThreadId()))
+            {
+                Count++;
+            }
+        }
+    };
+
+    // 워커 스레드 흉내 - 프레임마다 워커와 같은 빈도로 이벤트를 보냄 (30프레임마다 상태, 300프레임마다 연결 상태 문자열)
+    class FEventTestProducer : public FRunnable
+    {
+    public:
+        FSRTWorkerEventChannel& Channel;
+        int32 Frames;
+        TAtomic<bool> bReady{false};    // 스레드 시작 중 할당이 끝남
+        TAtomic<bool> bStart{false};
+        TAtomic<bool> bDone{false};
+        TAtomic<bool> bRelease{false};  // 세기를 끝낸 뒤 스레드 종료 (종료 중 할당은 세지 않음)
+        int32 Posted = 0;
+
+        FEventTestProducer(FSRTWorkerEventChannel& InChannel, int32 InFrames) : Channel(InChannel), Frames(InFrames) {}
+
+        virtual uint32 Run() override
+        {
+            bReady = true;
+            while (!bStart)
+            {
+                FPlatformProcess::YieldThread();
+            }
+            for (int32 Frame = 1; Frame <= Frames; Frame++)
+            {
+                if (Frame % 30 == 0)
+                {
+                    PostWorkerEvent(Channel, FSRTWorkerEvent::EType::StreamingStatus, Frame, Frame * 7);
+                    Posted++;
+                }
+                if (Frame % 300 == 0)
+                {
+                    PostWorkerEvent(Channel, FSRTWorkerEvent::EType::ConnectionState, Frame, 0,
+                        TEXT("Reconnected after 1 attempt(s)"), ESRTConnectionState::Streaming);
+                    Posted++;
+                }
+                FPlatformProcess::SleepNoStats(0.001f);
+            }
+            bDone = true;
+            while (!bRelease)
+            {
+                FPlatformProcess::SleepNoStats(0.001f);
+            }
+            return 0;
+        }
+    };
+
+    // 워커 → 게임 스레드 이벤트 채널 검사 - 정상 상태에서 보내는 쪽/비우는 쪽 모두 프레임당 할당 0, 순서 유지, 넘치면 버림
+    // 0 = 통과, 1 = 할당 있음/순서 틀림/버린 수 다름
+    int32 RunEventTest(const FBenchmarkOptions& Options)
+    {
+        int32 Failures = 0;
+        TUniquePtr<FSRTWorkerEventChannel> Channel = MakeUnique<FSRTWorkerEventChannel>();
+        const int32 Capacity = (int32)FSRTWorkerEventChannel::GetCapacity();
+
+        // 넘침: 비우지 않고 Capacity + 5개 → 앞의 Capacity개만 순서대로, 5개 버림
+        for (int32 i = 0; i < Capacity + 5; i++)
+        {
+            PostWorkerEvent(*Channel, FSRTWorkerEvent::EType::NoFrame, i);
+        }
+        int32 Expected = 0;
+        int32 OutOfOrder = 0;
+        const int32 Drained = Channel->Drain([&](const FSRTWorkerEvent& Event) { OutOfOrder += (Event.A != Expected++) ? 1 : 0; });
+        const int32 Dropped = Channel->ConsumeDroppedCount();
+        if (Drained != Capacity || Dropped != 5 || OutOfOrder != 0)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("Event test: overflow drained %d (expected %d), dropped %d (expected 5), %d out of order"),
+                Drained, Capacity, Dropped, OutOfOrder);
+            Failures++;
+        }
+
+        // 정상 상태: 생산자 스레드가 1ms마다 한 프레임, 이 스레드는 게임 틱처럼 4ms마다 비움
+        static FCountingMalloc* Counting = nullptr;    // 복원 뒤에도 들어와 있는 호출이 있을 수 있어 해제하지 않음
+        if (!Counting)
+        {
+            Counting = new FCountingMalloc(GMalloc);
+        }
+        FEventTestProducer Producer(*Channel, Options.Frames);
+        FRunnableThread* Thread = FRunnableThread::Create(&Producer, TEXT("SRTEventTestProducer"));
+        Counting->Track(Thread->GetThreadID());
+        Counting->Track(FPlatformTLS::GetCurrentThreadId());
+
+        int32 Received = 0;
+        int32 LastFrame = 0;
+        int32 TextLength = 0;
+        auto Consume = [&](const FSRTWorkerEvent& Event)
+        {
+            Received++;
+            OutOfOrder += (Event.A < LastFrame) ? 1 : 0;
+            LastFrame = Event.A;
+            if (Event.Type == FSRTWorkerEvent::EType::ConnectionState)
+            {
+                TextLength += FCString::Strlen(Event.Text);
+            }
+        };
+
+        while (!Producer.bReady)
+        {
+            FPlatformProcess::YieldThread();
+        }
+
+        OutOfOrder = 0;
+        FMalloc* const Original = GMalloc;
+        GMalloc = Counting;
+        Counting->Begin();
+        const double Start = FPlatformTime::Seconds();
+        Producer.bStart = true;
+        int32 Ticks = 0;
+        while (!Producer.bDone && FPlatformTime::Seconds() - Start < Options.Frames * 0.01 + 5.0)
+        {
+            Channel->Drain(Consume);
+            Ticks++;
+            FPlatformProcess::SleepNoStats(0.004f);
+        }
+        Channel->Drain(Consume);
+        const int32 Allocations = Counting->End();
+        GMalloc = Original;
+        Producer.bRelease = true;
+        Thread->WaitForCompletion();
+        delete Thread;
+
+        const int32 SteadyDropped = Channel->ConsumeDroppedCount();
+        const bool bPassed = Allocations == 0 && Received == Producer.Posted && SteadyDropped == 0 && OutOfOrder == 0 && Failures == 0;
+        UE_LOG(LogCineSRTStream, Display, TEXT("Event test: %d frames, %d events over %d drains, %d dropped, %d out of order, %d state text chars, %d allocations (%.3f per frame)"),
+            Options.Frames, Received, Ticks, SteadyDropped, OutOfOrder, TextLength, Allocations, (double)Allocations / FMath::Max(Options.Frames, 1));
+        UE_LOG(LogCineSRTStream, Display, TEXT("Event test: %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+        return bPassed ? 0 : 1;
+    }
+
+    FString PercentilesToJson(const FPercentiles& Value)
+    {
+        return FString::Printf(TEXT("{\"mean\":%.3f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f}"),
+            Value.Mean, Value.P50, Value.P95, Value.P99);
+    }
+
+    FString RunToJson(const FRunResult& Run, int32 RepeatIndex)
+    {
+        TArray<FString> StageJson;
+        for (int32 i = 0; i < StageCount; i++)
+        {
+            StageJson.Add(FString::Printf(TEXT("\"%s\":%s"), Stages[i].Name, *PercentilesToJson(Run.StageMs[i])));
+        }
+        return FString::Printf(
+            TEXT("{\"resolution\":\"%s\",\"width\":%d,\"height\":%d,\"repeat\":%d,\"sustained_fps\":%.3f,")
+            TEXT("\"frames_sent\":%d,\"frames_skipped\":%d,\"cpu_cores\":%.3f,\"received_bytes\":%lld,\"frame_bytes\":%d,")
+            TEXT("\"pipeline_ms\":%s,\"delivery_ms\":%s,\"stage_ms\":{%s}}"),
+            *Run.Resolution, Run.Width, Run.Height, RepeatIndex, Run.SustainedFPS,
+            Run.FramesSent, Run.FramesSkipped, Run.CPUCores, Run.ReceivedBytes, Run.FrameBytes,
+            *PercentilesToJson(Run.PipelineMs), *PercentilesToJson(Run.DeliveryMs), *FString::Join(StageJson, TEXT(",")));
+    }
+}
+
+USRTBenchmarkCommandlet::USRTBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USRTBenchmarkCommandlet::Main(const FString& Params)
+{
+    FBenchmarkOptions Options;
+    FString ResolutionList;
+    if (FParse::Value(*Params, TEXT("Resolutions="), ResolutionList))
+    {
+        ResolutionList.ParseIntoArray(Options.Resolutions, TEXT(","));
+    }
+    FParse::Value(*Params, TEXT("Source="), Options.Source);
+    FParse::Value(*Params, TEXT("FPS="), Options.FPS);
+    FParse::Value(*Params, TEXT("Frames="), Options.Frames);
+    FParse::Value(*Params, TEXT("Warmup="), Options.WarmupFrames);
+    FParse::Value(*Params, TEXT("Repeat="), Options.Repeat);
+    FParse::Value(*Params, TEXT("Bitrate="), Options.BitrateKbps);
+    FParse::Value(*Params, TEXT("Preset="), Options.Preset);
+    FParse::Value(*Params, TEXT("Codec="), Options.Codec);
+    FParse::Value(*Params, TEXT("Port="), Options.Port);
+    FParse::Value(*Params, TEXT("Latency="), Options.LatencyMs);
+    FParse::Value(*Params, TEXT("Output="), Options.Output);
+    FParse::Value(*Params, TEXT("CaptureFormat="), Options.CaptureFormat);
+    Options.bOverloadTest = FParse::Param(*Params, TEXT("OverloadTest"));
+    FParse::Value(*Params, TEXT("Slowdown="), Options.Slowdown);
+    Options.bReconnectTest = FParse::Param(*Params, TEXT("ReconnectTest"));
+    FParse::Value(*Params, TEXT("Outage="), Options.OutageSeconds);
+    Options.bMetadataTest = FParse::Param(*Params, TEXT("MetadataTest"));
+    FParse::Value(*Params, TEXT("MetadataFormat="), Options.MetadataFormat);
+    FParse::Value(*Params, TEXT("MaxDeltaMs="), Options.MaxDeltaMs);
+    if (Options.bMetadataTest && !FParse::Value(*Params, TEXT("FPS="), Options.FPS))
+    {
+        Options.FPS = 60.0f;
+    }
+
+    if (FParse::Param(*Params, TEXT("YUVTest")))
+    {
+        return RunYUVTest(Options);
+    }
+    if (FParse::Param(*Params, TEXT("EventTest")))
+    {
+        return RunEventTest(Options);
+    }
+
+    Options.FPS = FMath::Clamp(Options.FPS, 1.0f, 120.0f);
+    Options.Repeat = FMath::Max(Options.Repeat, 1);
+    // 측정 구간의 프레임 추적이 링 버퍼에서 밀려나지 않게
+    Options.Frames = FMath::Clamp(Options.Frames, 30, FSRTFrameTraceRecorder::Capacity);
+
+    IConsoleVariable* FrameTraceVar = IConsoleManager::Get().FindConsoleVariable(TEXT("CineSRT.FrameTrace"));
+    if (!FrameTraceVar || !GEngine)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Benchmark: engine or CineSRT.FrameTrace not available"));
+        return 2;
+    }
+    FrameTraceVar->Set(1);
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SRTBenchmark"));
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+    USRTStreamSubsystem* Subsystem = World->GetSubsystem<USRTStreamSubsystem>();
+    if (!Subsystem)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Benchmark: SRT stream subsystem missing"));
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        return 2;
+    }
+
+    if (Options.bOverloadTest)
+    {
+        const int32 Result = RunOverloadTest(World, Subsystem, Options, Options.Resolutions.Num() > 0 ? Options.Resolutions[0] : TEXT("1080p"));
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        FrameTraceVar->Set(0);
+        return Result;
+    }
+
+    if (Options.bReconnectTest)
+    {
+        const int32 Result = RunReconnectTest(World, Subsystem, Options, Options.Resolutions.Num() > 0 ? Options.Resolutions[0] : TEXT("1080p"));
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        FrameTraceVar->Set(0);
+        return Result;
+    }
+
+    if (Options.bMetadataTest)
+    {
+        const int32 Result = RunMetadataTest(World, Subsystem, Options, Options.Resolutions.Num() > 0 ? Options.Resolutions[0] : TEXT("1080p"));
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        FrameTraceVar->Set(0);
+        return Result;
+    }
+
+    UE_LOG(LogCineSRTStream, Display, TEXT("Benchmark: source %s (%s), %.0f fps, %d frames (+%d warmup), %d kbps, %s %s, %d repeats"),
+        *Options.Source, *Options.CaptureFormat, Options.FPS, Options.Frames, Options.WarmupFrames, Options.BitrateKbps,
+        *Options.Codec, *Options.Preset, Options.Repeat);
+
+    int32 ExitCode = 0;
+    TArray<FString> RunJson;
+    TArray<FString> SummaryJson;
+    for (const FString& Resolution : Options.Resolutions)
+    {
+        TArray<FRunResult> Runs;
+        for (int32 RepeatIndex = 0; RepeatIndex < Options.Repeat; RepeatIndex++)
+        {
+            FRunResult Run;
+            FString Error;
+            if (!RunOnce(World, Subsystem, Options, Resolution, Run, Error))
+            {
+                UE_LOG(LogCineSRTStream, Error, TEXT("Benchmark: %s run %d failed: %s"), *Resolution, RepeatIndex + 1, *Error);
+                ExitCode = 2;
+                break;
+            }
+
+            UE_LOG(LogCineSRTStream, Display, TEXT("Benchmark: %s run %d: %.2f fps, pipeline p50 %.2f / p99 %.2f ms, delivery p50 %.2f ms, %.2f cores"),
+                *Resolution, RepeatIndex + 1, Run.SustainedFPS, Run.PipelineMs.P50, Run.PipelineMs.P99,
+                Run.DeliveryMs.P50, Run.CPUCores);
+            RunJson.Add(RunToJson(Run, RepeatIndex + 1));
+            Runs.Add(Run);
+        }
+        if (Runs.Num() == 0)
+            continue;
+
+        // 반복 실행 중앙값 + 변동 폭 (최대-최소)/중앙값
+        auto Collect = [&Runs](TFunctionRef<double(const FRunResult&)> Get, double& OutMin, double& OutMax)
+        {
+            TArray<double> Values;
+            OutMin = MAX_dbl;
+            OutMax = -MAX_dbl;
+            for (const FRunResult& Run : Runs)
+            {
+                const double Value = Get(Run);
+                Values.Add(Value);
+                OutMin = FMath::Min(OutMin, Value);
+                OutMax = FMath::Max(OutMax, Value);
+            }
+            return Median(Values);
+        };
+        double MinFPS, MaxFPS, MinP50, MaxP50, MinP99, MaxP99, MinCores, MaxCores;
+        const double FPS = Collect([](const FRunResult& Run) { return Run.SustainedFPS; }, MinFPS, MaxFPS);
+        const double P50 = Collect([](const FRunResult& Run) { return Run.PipelineMs.P50; }, MinP50, MaxP50);
+        const double P99 = Collect([](const FRunResult& Run) { return Run.PipelineMs.P99; }, MinP99, MaxP99);
+        const double Cores = Collect([](const FRunResult& Run) { return Run.CPUCores; }, MinCores, MaxCores);
+        const double FPSSpread = FPS > 0.0 ? (MaxFPS - MinFPS) / FPS * 100.0 : 0.0;
+        const bool bSustained = FPS >= Options.FPS * 0.98;
+        if (!bSustained && ExitCode == 0)
+        {
+            ExitCode = 1;
+        }
+
+        // 공급원 → 인코더 대역폭 (씬 캡처면 GPU 리드백) - BGRA 4바이트/픽셀, NV12/I420 1.5바이트/픽셀
+        const double SourceMBps = Runs[0].FrameBytes * FPS / (1024.0 * 1024.0);
+        UE_LOG(LogCineSRTStream, Display, TEXT("Benchmark: === %s (%dx%d) median of %d: %.2f / %.0f fps (spread %.1f%%) %s, pipeline p50 %.2f (%.2f-%.2f) p99 %.2f (%.2f-%.2f) ms, %.2f cores, %s frames %.0f MB/s"),
+            *Resolution, Runs[0].Width, Runs[0].Height, Runs.Num(), FPS, Options.FPS, FPSSpread,
+            bSustained ? TEXT("SUSTAINED") : TEXT("NOT SUSTAINED"), P50, MinP50, MaxP50, P99, MinP99, MaxP99,
+            Cores, *Options.CaptureFormat, SourceMBps);
+        TArray<FString> StageJson;
+        for (int32 i = 0; i < StageCount; i++)
+        {
+            double MinStage, MaxStage;
+            const double StageMean = Collect([i](const FRunResult& Run) { return Run.StageMs[i].Mean; }, MinStage, MaxStage);
+            const double StageP95 = Collect([i](const FRunResult& Run) { return Run.StageMs[i].P95; }, MinStage, MaxStage);
+            // 프레임당 ms x fps = 그 단계가 쓰는 코어 비율 (Queue는 대기라 CPU가 아님)
+            UE_LOG(LogCineSRTStream, Display, TEXT("Benchmark:     %-8s mean %7.2f ms  p95 %7.2f ms  (%5.1f%% of a core)"),
+                Stages[i].Name, StageMean, StageP95, StageMean * FPS / 10.0);
+            StageJson.Add(FString::Printf(TEXT("\"%s\":{\"mean\":%.3f,\"p95\":%.3f}"), Stages[i].Name, StageMean, StageP95));
+        }
+
+        SummaryJson.Add(FString::Printf(
+            TEXT("{\"resolution\":\"%s\",\"width\":%d,\"height\":%d,\"runs\":%d,\"target_fps\":%.3f,\"sustained_fps\":%.3f,")
+            TEXT("\"fps_spread_percent\":%.3f,\"sustained\":%s,\"pipeline_p50_ms\":%.3f,\"pipeline_p99_ms\":%.3f,")
+            TEXT("\"pipeline_p50_range_ms\":[%.3f,%.3f],\"pipeline_p99_range_ms\":[%.3f,%.3f],\"cpu_cores\":%.3f,")
+            TEXT("\"frame_bytes\":%d,\"source_mb_per_s\":%.3f,\"stage_ms\":{%s}}"),
+            *Resolution, Runs[0].Width, Runs[0].Height, Runs.Num(), Options.FPS, FPS, FPSSpread,
+            bSustained ? TEXT("true") : TEXT("false"), P50, P99, MinP50, MaxP50, MinP99, MaxP99, Cores, Runs[0].FrameBytes, SourceMBps, *FString::Join(StageJson, TEXT(","))));
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    FrameTraceVar->Set(0);
+
+    FString OutputPath = Options.Output;
+    if (OutputPath.IsEmpty())
+    {
+        const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SRTBenchmark"));
+        FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Directory);
+        OutputPath = FPaths::Combine(Directory, FString::Printf(TEXT("Benchmark_%s.json"),
+            *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+    }
+
+    const FString Json = FString::Printf(
+        TEXT("{\"source\":\"%s\",\"fps\":%.3f,\"frames\":%d,\"warmup\":%d,\"bitrate_kbps\":%d,\"codec\":\"%s\",\"preset\":\"%s\",\"capture_format\":\"%s\",\"platform\":\"%s\",\"cores\":%d,\n")
+        TEXT("\"summary\":[\n%s\n],\n\"runs\":[\n%s\n]}\n"),
+        *Options.Source.ReplaceCharWithEscapedChar(), Options.FPS, Options.Frames, Options.WarmupFrames, Options.BitrateKbps,
+        *Options.Codec, *Options.Preset, *Options.CaptureFormat, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), FPlatformMisc::NumberOfCoresIncludingHyperthreads(),
+        *FString::Join(SummaryJson, TEXT(",\n")), *FString::Join(RunJson, TEXT(",\n")));
+    if (FFileHelper::SaveStringToFile(Json, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogCineSRTStream, Display, TEXT("Benchmark: Wrote %s"), *OutputPath);
+    }
+    else
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("Benchmark: Cannot write %s"), *OutputPath);
+    }
+
+    return ExitCode;
+}
@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTEncodePool.h"
+#include "CineSRTStream.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+// 워커 스레드 하나 - 대기열이 비면 이벤트를 기다림 (10ms마다 종료 확인)
+class FSRTEncodePool::FWorker : public FRunnable
+{
+public:
+    explicit FWorker(FSRTEncodePool& InPool) : Pool(InPool) {}
+
+    virtual uint32 Run() override
+    {
+        while (!Pool.bShouldExit)
+        {
+            if (!Pool.RunNext())
+            {
+                Pool.WorkEvent->Wait(10);
+            }
+        }
+        return 0;
+    }
+
+private:
+    FSRTEncodePool& Pool;
+};
+
+FSRTEncodePool::FSRTEncodePool(int32 InWorkerCount)
+{
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+    const int32 WorkerCount = FMath::Max(InWorkerCount, 1);
+    for (int32 i = 0; i < WorkerCount; i++)
+    {
+        TUniquePtr<FWorker> Worker = MakeUnique<FWorker>(*this);
+        FRunnableThread* Thread = FRunnableThread::Create(Worker.Get(),
+            *FString::Printf(TEXT("SRTEncodeWorker%d"), i), 0, TPri_AboveNormal);
+        if (!Thread)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("EncodePool: Failed to create worker %d"), i);
+            break;
+        }
+        Workers.Add(MoveTemp(Worker));
+        Threads.Add(Thread);
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("EncodePool: %d workers"), Threads.Num());
+}
+
+FSRTEncodePool::~FSRTEncodePool()
+{
+    bShouldExit = true;
+    for (int32 i = 0; i < Threads.Num(); i++)
+    {
+        WorkEvent->Trigger();
+    }
+    for (FRunnableThread* Thread : Threads)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+    }
+    Threads.Reset();
+    Workers.Reset();
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    WorkEvent = nullptr;
+}
+
+int32 FSRTEncodePool::AddStream(TFunction<void()> Job)
+{
+    TSharedPtr<FStream> Stream = MakeShared<FStream>();
+    Stream->Job = MoveTemp(Job);
+
+    FScopeLock ScopeLock(&Lock);
+    const int32 Handle = NextHandle++;
+    Streams.Add(Handle, Stream);
+    return Handle;
+}
+
+void FSRTEncodePool::RemoveStream(int32 Handle)
+{
+    TSharedPtr<FStream> Stream;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Stream = Streams.FindRef(Handle);
+        if (!Stream.IsValid())
+            return;
+        Streams.Remove(Handle);
+        ReadyQueue.Remove(Handle);
+        Stream->bRemoved = true;
+    }
+
+    // 실행 중인 인코딩 하나가 끝날 때까지 (길어야 프레임 하나)
+    for (;;)
+    {
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (!Stream->bRunning)
+                break;
+        }
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+void FSRTEncodePool::Schedule(int32 Handle)
+{
+    FScopeLock ScopeLock(&Lock);
+    const TSharedPtr<FStream>* Found = Streams.Find(Handle);
+    if (!Found)
+        return;
+
+    FStream& Stream = **Found;
+    if (Stream.bQueued)
+        return;
+    if (Stream.bRunning)
+    {
+        Stream.bRerun = true;
+        return;
+    }
+
+    Stream.bQueued = true;
+    Stream.QueuedTime = FPlatformTime::Seconds();
+    ReadyQueue.Add(Handle);
+    WorkEvent->Trigger();
+}
+
+bool FSRTEncodePool::RunNext()
+{
+    TSharedPtr<FStream> Stream;
+    int32 Handle = INDEX_NONE;
+    const double StartTime = FPlatformTime::Seconds();
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (ReadyQueue.Num() == 0)
+            return false;
+
+        // 먼저 들어온 스트림부터 - 한 스트림이 워커를 독차지하지 않음
+        Handle = ReadyQueue[0];
+        ReadyQueue.RemoveAt(0);
+        Stream = Streams.FindRef(Handle);
+        if (!Stream.IsValid())
+            return true;
+
+        Stream->bQueued = false;
+        Stream->bRunning = true;
+        QueueWaitSeconds += StartTime - Stream->QueuedTime;
+
+        // 이벤트는 자동 리셋이라 한 워커만 깨움 - 남은 작업이 있으면 다음 워커를 이어서 깨움
+        if (ReadyQueue.Num() > 0)
+        {
+            WorkEvent->Trigger();
+        }
+    }
+
+    Stream->Job();
+
+    const double EndTime = FPlatformTime::Seconds();
+    FScopeLock ScopeLock(&Lock);
+    Stream->bRunning = false;
+    BusySeconds += EndTime - StartTime;
+    JobsCompleted++;
+
+    if (Stream->bRerun && !Stream->bRemoved)
+    {
+        Stream->bRerun = false;
+        Stream->bQueued = true;
+        Stream->QueuedTime = EndTime;
+        ReadyQueue.Add(Handle);
+        WorkEvent->Trigger();
+    }
+    return true;
+}
+
+FSRTEncodePool::FStats FSRTEncodePool::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    FStats Stats;
+    Stats.WorkerCount = Threads.Num();
+    Stats.StreamCount = Streams.Num();
+    Stats.QueuedStreams = ReadyQueue.Num();
+    Stats.BusySeconds = BusySeconds;
+    Stats.QueueWaitSeconds = QueueWaitSeconds;
+    Stats.JobsCompleted = JobsCompleted;
+    return Stats;
+}
@@ -0,0 +1,452 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTFrameSource.h"
+#include "CineSRTStream.h"
+#include "Async/Async.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+// ================================================================================
+// FrameBuffer Implementation
+// ================================================================================
+
+void FrameBuffer::SetFrame(Frame&& frame)
+{
+    SRT_TRACE_SCOPE(CineSRT_FrameHandoff);
+    FScopeLock Lock(&Mutex);
+    if (bNewFrameReady)
+    {
+        OverwrittenFrames++;
+    }
+    CurrentFrame = MoveTemp(frame);
+    bNewFrameReady = true;
+}
+
+bool FrameBuffer::GetFrame(Frame& OutFrame)
+{
+    FScopeLock Lock(&Mutex);
+    if (bNewFrameReady)
+    {
+        OutFrame = MoveTemp(CurrentFrame);
+        bNewFrameReady = false;
+        return true;
+    }
+    return false;
+}
+
+void FrameBuffer::Clear()
+{
+    FScopeLock Lock(&Mutex);
+    CurrentFrame.Data.Empty();
+    bNewFrameReady = false;
+}
+
+bool FrameBuffer::HasNewFrame() const
+{
+    return bNewFrameReady.Load();
+}
+
+// ================================================================================
+// FSRTFrameSource
+// ================================================================================
+
+FSRTFrameTrace FSRTFrameSource::BeginTrace()
+{
+    FSRTFrameTrace Trace;
+    Trace.FrameId = NextTraceFrameId++;
+    Trace.StreamId = TraceStreamId;
+    SRT_TRACE_STAGE(Trace, Capture);
+    SRT_TRACE_FRAME_ID(CaptureFrameId, Trace.FrameId);
+    return Trace;
+}
+
+void FSRTFrameSource::Deliver(FrameBuffer::Frame&& Frame)
+{
+    if (!MyFrameBuffer)
+        return;
+
+    MyFrameBuffer->SetFrame(MoveTemp(Frame));
+    if (OnFrameReady)
+    {
+        OnFrameReady();
+    }
+}
+
+// ================================================================================
+// FSRTGeneratedFrameSource
+// ================================================================================
+
+FSRTGeneratedFrameSource::FSRTGeneratedFrameSource(TSharedPtr<FrameBuffer> InFrameBuffer, int32 InWidth, int32 InHeight)
+    : FSRTFrameSource(InFrameBuffer)
+    , Width(InWidth)
+    , Height(InHeight)
+{
+}
+
+bool FSRTGeneratedFrameSource::CaptureFrame(uint32 FrameNumber)
+{
+    if (IsShuttingDown())
+        return false;
+
+    // 이전 프레임 생성이 안 끝났으면 건너뜀 - 순번은 그대로라 다음 프레임 내용이 이어짐
+    if (bGenerating.Exchange(true))
+    {
+        SkippedFrames++;
+        return false;
+    }
+
+    if (PendingWidth > 0)
+    {
+        Width = PendingWidth;
+        Height = PendingHeight;
+        PendingWidth = PendingHeight = 0;
+    }
+
+    FrameBuffer::Frame Frame;
+    Frame.FrameNumber = FrameNumber;
+    Frame.Timestamp = FPlatformTime::Seconds();
+    Frame.Width = Width;
+    Frame.Height = Height;
+    Frame.Format = OutputFormat;
+    Frame.Trace = BeginTrace();
+
+    const uint32 Sequence = NextSequence++;
+    TSharedRef<FSRTGeneratedFrameSource> Self = StaticCastSharedRef<FSRTGeneratedFrameSource>(AsShared());
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+        [Self, Sequence, Frame = MoveTemp(Frame)]() mutable
+    {
+        SRT_TRACE_SCOPE(CineSRT_GenerateFrame);
+        SRT_TRACE_STAGE(Frame.Trace, CopyBegin);
+        Frame.Data.SetNumUninitialized(SRTYUV::GetFrameBytes(Frame.Format, Frame.Width, Frame.Height));
+        bool bGenerated = false;
+        if (Frame.Format == EVideoPixelFormat::BGRA)
+        {
+            bGenerated = Self->Generate(Sequence, Frame.Data.GetData());
+        }
+        else
+        {
+            // GPU 변환과 같은 식의 CPU 참조 구현 - 씬 캡처 없이도 YUV 프레임 경로 전체를 돌림
+            Self->ScratchBGRA.SetNumUninitialized(Frame.Width * Frame.Height * 4, EAllowShrinking::No);
+            bGenerated = Self->Generate(Sequence, Self->ScratchBGRA.GetData())
+                && SRTYUV::ConvertBGRA(Self->ScratchBGRA.GetData(), Frame.Width, Frame.Width, Frame.Height,
+                                       Frame.Format, Self->OutputColor, Frame.Data.GetData());
+        }
+        SRT_TRACE_STAGE(Frame.Trace, CopyEnd);
+        Self->bGenerating.Store(false);
+
+        if (bGenerated && !Self->IsShuttingDown())
+        {
+            Self->Deliver(MoveTemp(Frame));
+        }
+    });
+    return true;
+}
+
+bool FSRTGeneratedFrameSource::SetOutputSize(int32 InWidth, int32 InHeight)
+{
+    if (InWidth <= 0 || InHeight <= 0)
+        return false;
+
+    PendingWidth = InWidth;
+    PendingHeight = InHeight;
+    return true;
+}
+
+// ================================================================================
+// FSRTTestPatternSource
+// ================================================================================
+
+namespace
+{
+    // 3x5 숫자 글꼴 (행마다 3비트, 위에서부터)
+    const uint8 DigitGlyphs[10][5] =
+    {
+        { 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 }, { 7, 1, 7, 1, 7 }, { 5, 5, 7, 1, 1 },
+        { 7, 4, 7, 1, 7 }, { 7, 4, 7, 5, 7 }, { 7, 1, 1, 1, 1 }, { 7, 5, 7, 5, 7 }, { 7, 5, 7, 1, 7 },
+    };
+
+    // 75% 컬러 바 (BGRA)
+    const uint32 BarColors[8] =
+    {
+        0xFFBFBFBF, 0xFF00BFBF, 0xFFBFBF00, 0xFF00BF00, 0xFFBF00BF, 0xFF0000BF, 0xFFBF0000, 0xFF101010,
+    };
+
+    FORCEINLINE uint32 MakeBGRA(uint8 R, uint8 G, uint8 B)
+    {
+        return 0xFF000000u | ((uint32)R << 16) | ((uint32)G << 8) | (uint32)B;
+    }
+
+    void FillRect(uint32* Pixels, int32 Width, int32 Height, int32 X, int32 Y, int32 W, int32 H, uint32 Color)
+    {
+        const int32 X0 = FMath::Clamp(X, 0, Width);
+        const int32 X1 = FMath::Clamp(X + W, 0, Width);
+        const int32 Y0 = FMath::Clamp(Y, 0, Height);
+        const int32 Y1 = FMath::Clamp(Y + H, 0, Height);
+        for (int32 Row = Y0; Row < Y1; Row++)
+        {
+            uint32* Line = Pixels + (int64)Row * Width;
+            for (int32 Col = X0; Col < X1; Col++)
+            {
+                Line[Col] = Color;
+            }
+        }
+    }
+}
+
+FSRTTestPatternSource::FSRTTestPatternSource(TSharedPtr<FrameBuffer> InFrameBuffer, ESRTTestPattern InPattern,
+                                             int32 InWidth, int32 InHeight, uint32 InSeed)
+    : FSRTGeneratedFrameSource(InFrameBuffer, InWidth, InHeight)
+    , Pattern(InPattern)
+    , Seed(InSeed)
+{
+}
+
+const TCHAR* FSRTTestPatternSource::GetName() const
+{
+    switch (Pattern)
+    {
+        case ESRTTestPattern::Noise: return TEXT("Noise");
+        case ESRTTestPattern::Text: return TEXT("Text");
+        default: return TEXT("MovingBars");
+    }
+}
+
+bool FSRTTestPatternSource::Generate(uint32 Sequence, uint8* OutBGRA)
+{
+    uint32* Pixels = reinterpret_cast<uint32*>(OutBGRA);
+
+    switch (Pattern)
+    {
+        case ESRTTestPattern::MovingBars:
+        {
+            // 프레임마다 8픽셀씩 흐르는 바 + 튀는 흰 사각형 (움직임 추정이 일할 거리)
+            const int32 Shift = (int32)((Sequence * 8) % (uint32)Width);
+            for (int32 Row = 0; Row < Height; Row++)
+            {
+                uint32* Line = Pixels + (int64)Row * Width;
+                for (int32 Col = 0; Col < Width; Col++)
+                {
+                    Line[Col] = BarColors[((int64)((Col + Shift) % Width) * 8 / Width) & 7];
+                }
+            }
+
+            const int32 Box = FMath::Max(Height / 8, 8);
+            const int32 RangeX = FMath::Max(Width - Box, 1);
+            const int32 RangeY = FMath::Max(Height - Box, 1);
+            const int32 PosX = (int32)((Sequence * 12) % (uint32)(RangeX * 2));
+            const int32 PosY = (int32)((Sequence * 7) % (uint32)(RangeY * 2));
+            FillRect(Pixels, Width, Height,
+                PosX < RangeX ? PosX : RangeX * 2 - PosX,
+                PosY < RangeY ? PosY : RangeY * 2 - PosY,
+                Box, Box, 0xFFFFFFFF);
+            break;
+        }
+
+        case ESRTTestPattern::Noise:
+        {
+            // 프레임마다 새 노이즈 - 예측이 안 되므로 인코더 비용과 비트레이트가 최대
+            uint32 State = (Seed * 0x9E3779B9u) ^ ((Sequence + 1) * 0x85EBCA6Bu);
+            State = State ? State : 1;
+            const int64 Count = (int64)Width * Height;
+            for (int64 i = 0; i < Count; i++)
+            {
+                State ^= State << 13;
+                State ^= State >> 17;
+                State ^= State << 5;
+                Pixels[i] = State | 0xFF000000u;
+            }
+            break;
+        }
+
+        case ESRTTestPattern::Text:
+        {
+            // 흐르는 그라데이션 위에 8자리 프레임 번호
+            for (int32 Row = 0; Row < Height; Row++)
+            {
+                uint32* Line = Pixels + (int64)Row * Width;
+                const uint8 Level = (uint8)(32 + ((Row + Sequence * 2) % 64));
+                const uint32 Color = MakeBGRA(Level / 2, Level / 2, Level);
+                for (int32 Col = 0; Col < Width; Col++)
+                {
+                    Line[Col] = Color;
+                }
+            }
+
+            const int32 Cell = FMath::Max(Height / 40, 2);
+            const int32 Digits = 8;
+            const int32 TextWidth = Digits * 4 * Cell;
+            const int32 OriginX = (Width - TextWidth) / 2;
+            const int32 OriginY = (Height - 5 * Cell) / 2;
+            uint32 Value = Sequence;
+            for (int32 Digit = Digits - 1; Digit >= 0; Digit--)
+            {
+                const uint8* Glyph = DigitGlyphs[Value % 10];
+                Value /= 10;
+                for (int32 GlyphRow = 0; GlyphRow < 5; GlyphRow++)
+                {
+                    for (int32 GlyphCol = 0; GlyphCol < 3; GlyphCol++)
+                    {
+                        if (Glyph[GlyphRow] & (4 >> GlyphCol))
+                        {
+                            FillRect(Pixels, Width, Height,
+                                OriginX + (Digit * 4 + GlyphCol) * Cell, OriginY + GlyphRow * Cell,
+                                Cell, Cell, 0xFFFFFFFF);
+                        }
+                    }
+                }
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+// ================================================================================
+// FSRTFileFrameSource
+// ================================================================================
+
+FSRTFileFrameSource::FSRTFileFrameSource(TSharedPtr<FrameBuffer> InFrameBuffer, int32 InWidth, int32 InHeight)
+    : FSRTGeneratedFrameSource(InFrameBuffer, InWidth, InHeight)
+{
+}
+
+FSRTFileFrameSource::~FSRTFileFrameSource()
+{
+    delete File;
+    File = nullptr;
+}
+
+bool FSRTFileFrameSource::Open(const FString& Path, FString& OutError)
+{
+    FScopeLock ScopeLock(&FileLock);
+    delete File;
+    File = FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path);
+    if (!File)
+    {
+        OutError = FString::Printf(TEXT("Cannot open %s"), *Path);
+        return false;
+    }
+
+    bY4M = FPaths::GetExtension(Path).Equals(TEXT("y4m"), ESearchCase::IgnoreCase);
+    const int64 FileSize = File->Size();
+
+    if (bY4M)
+    {
+        // 헤더 한 줄: YUV4MPEG2 W1920 H1080 F30:1 Ip A1:1 C420jpeg
+        TArray<uint8> Header;
+        Header.SetNumZeroed(FMath::Min<int64>(FileSize, 512));
+        if (!File->Read(Header.GetData(), Header.Num()))
+        {
+            OutError = TEXT("Cannot read Y4M header");
+            return false;
+        }
+        const int32 LineEnd = Header.Find((uint8)'\n');
+        if (LineEnd == INDEX_NONE)
+        {
+            OutError = TEXT("Y4M header line not found");
+            return false;
+        }
+
+        const FString Line(LineEnd, reinterpret_cast<const ANSICHAR*>(Header.GetData()));
+        TArray<FString> Tokens;
+        Line.ParseIntoArrayWS(Tokens);
+        if (Tokens.Num() == 0 || Tokens[0] != TEXT("YUV4MPEG2"))
+        {
+            OutError = TEXT("Not a YUV4MPEG2 file");
+            return false;
+        }
+
+        int32 FileWidth = 0;
+        int32 FileHeight = 0;
+        FString Chroma = TEXT("420jpeg");
+        for (const FString& Token : Tokens)
+        {
+            if (Token.StartsWith(TEXT("W"))) FileWidth = FCString::Atoi(*Token + 1);
+            else if (Token.StartsWith(TEXT("H"))) FileHeight = FCString::Atoi(*Token + 1);
+            else if (Token.StartsWith(TEXT("C"))) Chroma = Token.Mid(1);
+        }
+        if (FileWidth != Width || FileHeight != Height)
+        {
+            OutError = FString::Printf(TEXT("Y4M is %dx%d but the stream is %dx%d"), FileWidth, FileHeight, Width, Height);
+            return false;
+        }
+        if (!Chroma.StartsWith(TEXT("420")) || Chroma.Contains(TEXT("p1")))
+        {
+            OutError = FString::Printf(TEXT("Y4M chroma %s not supported (8-bit 4:2:0 only)"), *Chroma);
+            return false;
+        }
+
+        DataOffset = LineEnd + 1;
+        FramePayload = (int64)Width * Height + 2 * ((int64)(Width / 2) * (Height / 2));
+        FrameStride = 6 + FramePayload;
+
+        uint8 FrameHeader[6] = {};
+        File->Seek(DataOffset);
+        if (!File->Read(FrameHeader, 6) || FMemory::Memcmp(FrameHeader, "FRAME\n", 6) != 0)
+        {
+            OutError = TEXT("Y4M frame headers with parameters are not supported");
+            return false;
+        }
+        ReadBuffer.SetNumUninitialized(FramePayload);
+    }
+    else
+    {
+        DataOffset = 0;
+        FramePayload = (int64)Width * Height * 4;
+        FrameStride = FramePayload;
+    }
+
+    FrameCount = (int32)((FileSize - DataOffset) / FrameStride);
+    if (FrameCount <= 0)
+    {
+        OutError = FString::Printf(TEXT("%s holds no complete %dx%d frame"), *Path, Width, Height);
+        return false;
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("FileFrameSource: %s, %d frames (%s)"), *Path, FrameCount, GetName());
+    return true;
+}
+
+bool FSRTFileFrameSource::Generate(uint32 Sequence, uint8* OutBGRA)
+{
+    FScopeLock ScopeLock(&FileLock);
+    if (!File || FrameCount <= 0)
+        return false;
+
+    const int64 FrameOffset = DataOffset + (int64)(Sequence % (uint32)FrameCount) * FrameStride;
+    if (!bY4M)
+    {
+        return File->Seek(FrameOffset) && File->Read(OutBGRA, FramePayload);
+    }
+
+    if (!File->Seek(FrameOffset + 6) || !File->Read(ReadBuffer.GetData(), FramePayload))
+        return false;
+
+    // I420 → BGRA (BT.709 제한 범위, 정수 연산)
+    const uint8* PlaneY = ReadBuffer.GetData();
+    const uint8* PlaneU = PlaneY + (int64)Width * Height;
+    const uint8* PlaneV = PlaneU + (int64)(Width / 2) * (Height / 2);
+    const int32 ChromaWidth = Width / 2;
+    for (int32 Row = 0; Row < Height; Row++)
+    {
+        const uint8* LineY = PlaneY + (int64)Row * Width;
+        const uint8* LineU = PlaneU + (int64)(Row / 2) * ChromaWidth;
+        const uint8* LineV = PlaneV + (int64)(Row / 2) * ChromaWidth;
+        uint8* Out = OutBGRA + (int64)Row * Width * 4;
+        for (int32 Col = 0; Col < Width; Col++)
+        {
+            const int32 C = 298 * (LineY[Col] - 16);
+            const int32 D = LineU[Col / 2] - 128;
+            const int32 E = LineV[Col / 2] - 128;
+            Out[0] = (uint8)FMath::Clamp((C + 541 * D + 128) >> 8, 0, 255);
+            Out[1] = (uint8)FMath::Clamp((C - 55 * D - 136 * E + 128) >> 8, 0, 255);
+            Out[2] = (uint8)FMath::Clamp((C + 459 * E + 128) >> 8, 0, 255);
+            Out[3] = 255;
+            Out += 4;
+        }
+    }
+    return true;
+}
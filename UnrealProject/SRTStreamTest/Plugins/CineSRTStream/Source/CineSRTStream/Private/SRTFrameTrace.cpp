@@ -0,0 +1,199 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTFrameTrace.h"
+#include "CineSRTStream.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if CINESRT_FRAME_TRACE
+TRACE_DECLARE_INT_COUNTER(CineSRT_CaptureFrameId, TEXT("CineSRT/CaptureFrameId"));
+TRACE_DECLARE_INT_COUNTER(CineSRT_EncodeFrameId, TEXT("CineSRT/EncodeFrameId"));
+TRACE_DECLARE_INT_COUNTER(CineSRT_SendFrameId, TEXT("CineSRT/SendFrameId"));
+#endif
+
+static TAutoConsoleVariable<int32> CVarFrameTrace(
+    TEXT("CineSRT.FrameTrace"),
+    0,
+    TEXT("1 = record per-frame pipeline timestamps of SRT streams into a ring buffer (dump with CineSRT.DumpFrameTrace)"),
+    ECVF_Default);
+
+static FAutoConsoleCommand CmdDumpFrameTrace(
+    TEXT("CineSRT.DumpFrameTrace"),
+    TEXT("Write recorded SRT frame traces as Chrome trace JSON. Optional argument: output file path"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const FString Path = FSRTFrameTraceRecorder::Get().DumpChromeTrace(Args.Num() > 0 ? Args[0] : FString());
+        if (!Path.IsEmpty())
+        {
+            UE_LOG(LogCineSRTStream, Log, TEXT("FrameTrace: Wrote %s"), *Path);
+        }
+    }));
+
+namespace
+{
+    // Chrome trace 이벤트 = 단계 구간 (스레드 lane 하나씩, lane 0은 캡처→송신 전체)
+    struct FSpan
+    {
+        const TCHAR* Name;
+        ESRTTraceStage Begin;
+        ESRTTraceStage End;
+    };
+
+    const FSpan Spans[] =
+    {
+        { TEXT("Frame"),                  ESRTTraceStage::Capture,       ESRTTraceStage::SendEnd },
+        { TEXT("RenderQueue"),            ESRTTraceStage::Capture,       ESRTTraceStage::ReadbackBegin },
+        { TEXT("Readback"),               ESRTTraceStage::ReadbackBegin, ESRTTraceStage::ReadbackEnd },
+        { TEXT("CopyTask"),               ESRTTraceStage::CopyBegin,     ESRTTraceStage::CopyEnd },
+        { TEXT("FrameBuffer"),            ESRTTraceStage::CopyEnd,       ESRTTraceStage::Dequeue },
+        { TEXT("ConvertAndEncode"),       ESRTTraceStage::ConvertBegin,  ESRTTraceStage::ConvertEnd },
+        { TEXT("avcodec_send_frame"),     ESRTTraceStage::ConvertEnd,    ESRTTraceStage::EncodeSubmit },
+        { TEXT("avcodec_receive_packet"), ESRTTraceStage::EncodeSubmit,  ESRTTraceStage::EncodeEnd },
+        { TEXT("MuxH264Frame"),           ESRTTraceStage::MuxBegin,      ESRTTraceStage::MuxEnd },
+        { TEXT("srt_send"),               ESRTTraceStage::SendBegin,     ESRTTraceStage::SendEnd },
+    };
+}
+
+FSRTFrameTraceRecorder& FSRTFrameTraceRecorder::Get()
+{
+    static FSRTFrameTraceRecorder Instance;
+    return Instance;
+}
+
+bool FSRTFrameTraceRecorder::IsEnabled()
+{
+    return CVarFrameTrace.GetValueOnAnyThread() != 0;
+}
+
+uint16 FSRTFrameTraceRecorder::RegisterStream(const FString& Name)
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 Index = StreamNames.AddUnique(Name);
+    return (uint16)(Index + 1);
+}
+
+void FSRTFrameTraceRecorder::Record(const FSRTFrameTrace& Trace)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Ring.Num() < Capacity)
+    {
+        Ring.Add(Trace);
+        return;
+    }
+    Ring[Next] = Trace;
+    Next = (Next + 1) % Capacity;
+}
+
+void FSRTFrameTraceRecorder::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Ring.Reset();
+    Next = 0;
+}
+
+TArray<FSRTFrameTrace> FSRTFrameTraceRecorder::GetRecorded()
+{
+    FScopeLock ScopeLock(&Lock);
+    TArray<FSRTFrameTrace> Frames;
+    Frames.Reserve(Ring.Num());
+    for (int32 i = 0; i < Ring.Num(); i++)
+    {
+        Frames.Add(Ring[(Next + i) % Ring.Num()]);
+    }
+    return Frames;
+}
+
+FString FSRTFrameTraceRecorder::DumpChromeTrace(const FString& Path)
+{
+    // 락은 복사하는 동안만 - 파일 쓰기 중에도 송신 스레드가 기록할 수 있도록
+    const TArray<FSRTFrameTrace> Frames = GetRecorded();
+    TArray<FString> Names;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Names = StreamNames;
+    }
+
+    if (Frames.Num() == 0)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("FrameTrace: Nothing recorded (set CineSRT.FrameTrace 1 while streaming)"));
+        return FString();
+    }
+
+    // 시각 원점 = 가장 이른 타임스탬프
+    uint64 Origin = MAX_uint64;
+    for (const FSRTFrameTrace& Frame : Frames)
+    {
+        for (uint64 Cycles : Frame.StageCycles)
+        {
+            if (Cycles != 0)
+            {
+                Origin = FMath::Min(Origin, Cycles);
+            }
+        }
+    }
+    const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+
+    TArray<FString> Events;
+    for (int32 StreamIndex = 0; StreamIndex < Names.Num(); StreamIndex++)
+    {
+        Events.Add(FString::Printf(TEXT("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}"),
+            StreamIndex + 1, *Names[StreamIndex].ReplaceCharWithEscapedChar()));
+        for (int32 Lane = 0; Lane < UE_ARRAY_COUNT(Spans); Lane++)
+        {
+            Events.Add(FString::Printf(TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}"),
+                StreamIndex + 1, Lane, Spans[Lane].Name));
+            Events.Add(FString::Printf(TEXT("{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"sort_index\":%d}}"),
+                StreamIndex + 1, Lane, Lane));
+        }
+    }
+
+    for (const FSRTFrameTrace& Frame : Frames)
+    {
+        for (int32 Lane = 0; Lane < UE_ARRAY_COUNT(Spans); Lane++)
+        {
+            const uint64 Begin = Frame.StageCycles[(int32)Spans[Lane].Begin];
+            const uint64 End = Frame.StageCycles[(int32)Spans[Lane].End];
+            if (Begin == 0 || End < Begin)
+                continue;
+
+            const double BeginUs = (Begin - Origin) * MicrosecondsPerCycle;
+            const double EndUs = (End - Origin) * MicrosecondsPerCycle;
+            if (Lane == 0)
+            {
+                // 전체 구간은 프레임끼리 겹치므로 비동기 이벤트 (프레임 번호가 id)
+                Events.Add(FString::Printf(
+                    TEXT("{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"b\",\"id\":%u,\"pid\":%d,\"tid\":0,\"ts\":%.3f}"),
+                    Frame.FrameId, Frame.FrameId, (int32)Frame.StreamId, BeginUs));
+                Events.Add(FString::Printf(
+                    TEXT("{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"e\",\"id\":%u,\"pid\":%d,\"tid\":0,\"ts\":%.3f}"),
+                    Frame.FrameId, Frame.FrameId, (int32)Frame.StreamId, EndUs));
+                continue;
+            }
+            Events.Add(FString::Printf(
+                TEXT("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}"),
+                Spans[Lane].Name, (int32)Frame.StreamId, Lane, BeginUs, EndUs - BeginUs, Frame.FrameId));
+        }
+    }
+
+    FString OutputPath = Path;
+    if (OutputPath.IsEmpty())
+    {
+        const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SRTTrace"));
+        FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Directory);
+        OutputPath = FPaths::Combine(Directory, FString::Printf(TEXT("FrameTrace_%s.json"),
+            *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+    }
+
+    const FString Json = TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n") + FString::Join(Events, TEXT(",\n")) + TEXT("\n]}\n");
+    if (!FFileHelper::SaveStringToFile(Json, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("FrameTrace: Cannot write %s"), *OutputPath);
+        return FString();
+    }
+    return OutputPath;
+}
@@ -0,0 +1,345 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTListenerOutput.h"
+#include "CineSRTStream.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FSRTListenerOutput::FSRTListenerOutput(const FConfig& InConfig)
+    : Config(InConfig)
+{
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FSRTListenerOutput::~FSRTListenerOutput()
+{
+    Shutdown();
+
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+}
+
+bool FSRTListenerOutput::Start()
+{
+    FSRTSocket sock = FSRTSocket::Create();
+    if (!sock)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Listener: Failed to create SRT socket"));
+        return false;
+    }
+
+    // 수락된 소켓은 리스너 옵션을 물려받음 (라이브 모드, 레이턴시, 논블로킹)
+    if (!SRTNetwork::ApplyLiveStreamOptions(sock, Config.LatencyMs)
+        || !sock.SetNonBlocking(true)
+        || !SRTNetwork::ApplyEncryptionOptions(sock, Config.Encryption))
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Listener: Failed to apply socket options: %s"),
+            UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        return false;
+    }
+
+    if (!SRTNetwork::Bind(sock.Get(), Config.Port) || !SRTNetwork::Listen(sock.Get(), Config.MaxSubscribers))
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Listener: Bind/listen on port %d failed: %s"),
+            Config.Port, UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        return false;
+    }
+    ListenSocket = MoveTemp(sock);
+
+    bShouldExit = false;
+    Thread = FRunnableThread::Create(this, TEXT("SRTListenerOutput"));
+    if (!Thread)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Listener: Failed to create sender thread"));
+        ListenSocket.Close();
+        return false;
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("Listener: Listening on port %d (max %d subscribers)"),
+        Config.Port, Config.MaxSubscribers);
+    return true;
+}
+
+void FSRTListenerOutput::Shutdown()
+{
+    Stop();
+
+    if (Thread)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    Subscribers.Reset();  // 구독자 소켓은 FSubscriber와 함께 닫힘
+    SubscriberCount = 0;
+
+    ListenSocket.Close();
+
+    FChunkRef Dummy;
+    while (Incoming.Dequeue(Dummy)) {}
+    IncomingCount = 0;
+    IncomingDropped = 0;
+}
+
+void FSRTListenerOutput::SubmitFrame(const TArray<uint8>& TSPackets, double CaptureTime, bool bKeyFrame)
+{
+    if (bShouldExit || !HasSubscribers())
+        return;
+
+    // 송신 스레드가 밀리면 새 프레임을 버림 - 모든 구독자에게 빈 구간이므로 다음 청크에 표시하고 IDR 요청
+    if (IncomingCount.Load() >= MaxIncomingFrames)
+    {
+        IncomingDropped++;
+        bKeyFrameRequested = true;
+        return;
+    }
+
+    // 모든 구독자가 이 버퍼 하나를 참조
+    TSharedPtr<FChunk, ESPMode::ThreadSafe> Chunk = MakeShared<FChunk, ESPMode::ThreadSafe>();
+    Chunk->Data = TSPackets;
+    Chunk->CaptureTime = CaptureTime;
+    Chunk->bKeyFrame = bKeyFrame;
+    Chunk->DroppedBefore = IncomingDropped;
+    IncomingDropped = 0;
+
+    Incoming.Enqueue(Chunk);
+    IncomingCount++;
+    WorkEvent->Trigger();
+}
+
+void FSRTListenerOutput::GetSubscriberStats(TArray<FSubscriberStats>& OutStats) const
+{
+    FScopeLock Lock(&StatsLock);
+    OutStats = StatsSnapshot;
+}
+
+bool FSRTListenerOutput::Init()
+{
+    return true;
+}
+
+uint32 FSRTListenerOutput::Run()
+{
+    LastStatsTime = FPlatformTime::Seconds();
+
+    while (!bShouldExit)
+    {
+        // 막힌 구독자의 재시도 주기 겸 새 연결 확인 주기
+        WorkEvent->Wait(5);
+        if (bShouldExit)
+            break;
+
+        AcceptSubscribers();
+        DistributeIncoming();
+
+        const double Now = FPlatformTime::Seconds();
+        for (TUniquePtr<FSubscriber>& Subscriber : Subscribers)
+        {
+            FlushSubscriber(*Subscriber, Now);
+        }
+        RemoveClosedSubscribers();
+
+        if (Now - LastStatsTime >= 1.0)
+        {
+            UpdateStats(Now);
+        }
+    }
+
+    return 0;
+}
+
+void FSRTListenerOutput::Stop()
+{
+    bShouldExit = true;
+    if (WorkEvent)
+    {
+        WorkEvent->Trigger();
+    }
+}
+
+void FSRTListenerOutput::AcceptSubscribers()
+{
+    FString PeerAddress;
+    while (FSRTSocket sock = SRTNetwork::AcceptPending(ListenSocket.Get(), PeerAddress))
+    {
+        if (Subscribers.Num() >= Config.MaxSubscribers)
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Listener: Rejecting %s (max %d subscribers)"),
+                *PeerAddress, Config.MaxSubscribers);
+            continue;
+        }
+
+        sock.SetNonBlocking(true);
+
+        TUniquePtr<FSubscriber> Subscriber = MakeUnique<FSubscriber>();
+        Subscriber->SourceClock.Reset(sock.Get());
+        Subscriber->Socket = MoveTemp(sock);
+        Subscriber->ConnectTime = FPlatformTime::Seconds();
+        Subscriber->LastProgressTime = Subscriber->ConnectTime;
+        Subscriber->Stats.PeerAddress = PeerAddress;
+        Subscribers.Add(MoveTemp(Subscriber));
+
+        SubscriberCount = Subscribers.Num();
+        TotalAccepted++;
+        // 중간 합류 - 다음 GOP까지 기다리지 않도록 IDR 요청
+        bKeyFrameRequested = true;
+
+        UE_LOG(LogCineSRTStream, Log, TEXT("Listener: Subscriber %s connected (%d active)"),
+            *PeerAddress, Subscribers.Num());
+    }
+}
+
+void FSRTListenerOutput::DistributeIncoming()
+{
+    FChunkRef Chunk;
+    while (Incoming.Dequeue(Chunk))
+    {
+        IncomingCount--;
+
+        for (TUniquePtr<FSubscriber>& SubscriberPtr : Subscribers)
+        {
+            FSubscriber& Subscriber = *SubscriberPtr;
+
+            // 앞에서 버린 프레임 뒤 - 키프레임이 아니면 참조가 끊겼으므로 다음 키프레임까지 기다림 (IDR은 SubmitFrame이 요청)
+            if (Chunk->DroppedBefore > 0 && !Subscriber.bWaitingForKeyFrame)
+            {
+                Subscriber.Stats.FramesSkipped += Chunk->DroppedBefore;
+                if (!Chunk->bKeyFrame)
+                {
+                    Subscriber.Stats.KeyFrameResyncs++;
+                    Subscriber.bWaitingForKeyFrame = true;
+                }
+            }
+
+            // 큐 초과: 쌓인 프레임을 버리고 다음 키프레임부터 (다른 구독자를 위해 IDR은 요청하지 않음)
+            if (Subscriber.Queue.Num() >= Config.MaxQueuedFrames && !Subscriber.bWaitingForKeyFrame)
+            {
+                // 전송 중인 청크는 메시지 경계에서 끊김 - 수신 측은 잘린 PES를 버리고 IDR부터 디코딩
+                Subscriber.Stats.FramesSkipped += Subscriber.Queue.Num();
+                Subscriber.Stats.KeyFrameResyncs++;
+                Subscriber.Queue.Reset();
+                Subscriber.Offset = 0;
+                Subscriber.bWaitingForKeyFrame = true;
+                UE_LOG(LogCineSRTStream, Verbose, TEXT("Listener: %s fell behind, skipping to next keyframe"),
+                    *Subscriber.Stats.PeerAddress);
+            }
+
+            if (Subscriber.bWaitingForKeyFrame)
+            {
+                if (!Chunk->bKeyFrame)
+                {
+                    Subscriber.Stats.FramesSkipped++;
+                    continue;
+                }
+                Subscriber.bWaitingForKeyFrame = false;
+            }
+
+            Subscriber.Queue.Add(Chunk);
+        }
+    }
+}
+
+void FSRTListenerOutput::FlushSubscriber(FSubscriber& Subscriber, double Now)
+{
+    if (Subscriber.bClosed)
+        return;
+
+    const int32 TTL = Config.MessageTTLMs > 0 ? Config.MessageTTLMs : -1;
+
+    while (Subscriber.Queue.Num() > 0)
+    {
+        const FChunk& Chunk = *Subscriber.Queue[0];
+
+        FSRTSocket::FSendResult Result;
+        if (!Subscriber.Socket.SendMessages(Chunk.Data.GetData() + Subscriber.Offset,
+                                            Chunk.Data.Num() - Subscriber.Offset,
+                                            Subscriber.SourceClock.ToSourceTime(Chunk.CaptureTime),
+                                            TTL, Result))
+        {
+            UE_LOG(LogCineSRTStream, Log, TEXT("Listener: Subscriber %s disconnected: %s"),
+                *Subscriber.Stats.PeerAddress, UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+            Subscriber.bClosed = true;
+            return;
+        }
+
+        Subscriber.Offset += Result.BytesSent;
+        Subscriber.Stats.BytesSent += Result.BytesSent;
+        if (Result.BytesSent > 0)
+        {
+            Subscriber.LastProgressTime = Now;
+        }
+
+        if (Result.bWouldBlock)
+            break;
+
+        Subscriber.Queue.RemoveAt(0, 1, EAllowShrinking::No);
+        Subscriber.Offset = 0;
+        Subscriber.Stats.FramesSent++;
+    }
+
+    if (Subscriber.Queue.Num() == 0)
+    {
+        Subscriber.LastProgressTime = Now;
+    }
+    else if (Now - Subscriber.LastProgressTime > Config.StallTimeoutSeconds)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("Listener: Dropping stalled subscriber %s (no progress for %.1f s)"),
+            *Subscriber.Stats.PeerAddress, Now - Subscriber.LastProgressTime);
+        Subscriber.bClosed = true;
+    }
+}
+
+void FSRTListenerOutput::RemoveClosedSubscribers()
+{
+    const int32 Removed = Subscribers.RemoveAll([](const TUniquePtr<FSubscriber>& Subscriber)
+    {
+        return Subscriber->bClosed;
+    });
+
+    if (Removed > 0)
+    {
+        SubscriberCount = Subscribers.Num();
+        TotalDisconnected += Removed;
+    }
+}
+
+void FSRTListenerOutput::UpdateStats(double Now)
+{
+    LastStatsTime = Now;
+
+    TArray<FSubscriberStats> Snapshot;
+    Snapshot.Reserve(Subscribers.Num());
+    for (TUniquePtr<FSubscriber>& SubscriberPtr : Subscribers)
+    {
+        FSubscriber& Subscriber = *SubscriberPtr;
+
+        // 피어가 끊었는데 보낼 게 없어서 아직 모르는 경우
+        if (!Subscriber.Socket.IsConnected())
+        {
+            UE_LOG(LogCineSRTStream, Log, TEXT("Listener: Subscriber %s disconnected"), *Subscriber.Stats.PeerAddress);
+            Subscriber.bClosed = true;
+            continue;
+        }
+
+        SRTNetwork::Stats Totals;
+        SRTNetwork::StatsInterval Interval;
+        if (Subscriber.StatsTracker.Sample(Subscriber.Socket.Get(), Totals, Interval))
+        {
+            Subscriber.Stats.RTTMs = (float)Totals.msRTT;
+            Subscriber.Stats.SendRateMbps = (float)Interval.SendMbps;
+        }
+        Subscriber.Stats.KeyMaterialState = SRTNetwork::GetKeyMaterialState(Subscriber.Socket.Get());
+        Subscriber.Stats.ConnectedSeconds = Now - Subscriber.ConnectTime;
+        Subscriber.Stats.QueuedFrames = Subscriber.Queue.Num();
+        Snapshot.Add(Subscriber.Stats);
+    }
+    RemoveClosedSubscribers();
+
+    FScopeLock Lock(&StatsLock);
+    StatsSnapshot = MoveTemp(Snapshot);
+}
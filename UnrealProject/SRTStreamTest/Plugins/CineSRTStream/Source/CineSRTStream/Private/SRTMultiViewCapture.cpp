@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTMultiViewCapture.h"
+#include "CineSRTStream.h"
+#include "CanvasTypes.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "EngineModule.h"
+#include "LegacyScreenPercentageDriver.h"
+#include "RendererInterface.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "SceneInterface.h"
+#include "SceneView.h"
+#include "TextureResource.h"
+#include "Misc/ScopeLock.h"
+
+// ================================================================================
+// FSRTMultiViewCapture
+// ================================================================================
+
+bool FSRTMultiViewCapture::RenderViews(UWorld* World, UTextureRenderTarget2D* Atlas, const TArray<FView>& Views)
+{
+    if (!World || !World->Scene || !Atlas || Views.Num() == 0 || !Views[0].SceneCapture)
+        return false;
+
+    FTextureRenderTargetResource* AtlasResource = Atlas->GameThread_GetRenderTargetResource();
+    if (!AtlasResource)
+        return false;
+
+    USceneCaptureComponent2D* FirstCapture = Views[0].SceneCapture;
+
+    // SceneCaptureRendering의 CreateSceneRendererForSceneCapture와 같은 설정 - 뷰만 여러 개
+    FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(
+        AtlasResource,
+        World->Scene,
+        FirstCapture->ShowFlags)
+        .SetResolveScene(true)
+        .SetRealtimeUpdate(true)
+        .SetTime(World->GetTime()));
+    ViewFamily.SceneCaptureSource = FirstCapture->CaptureSource;
+    ViewFamily.SetScreenPercentageInterface(new FLegacyScreenPercentageDriver(ViewFamily, 1.0f));
+
+    for (const FView& Capture : Views)
+    {
+        USceneCaptureComponent2D* SceneCapture = Capture.SceneCapture;
+        if (!SceneCapture)
+            return false;
+
+        const FTransform Transform = SceneCapture->GetComponentToWorld();
+        const FVector ViewLocation = Transform.GetTranslation();
+        const FIntPoint ViewSize = Capture.Rect.Size();
+
+        FSceneViewInitOptions ViewInitOptions;
+        ViewInitOptions.SetViewRectangle(Capture.Rect);
+        ViewInitOptions.ViewFamily = &ViewFamily;
+        ViewInitOptions.ViewActor = SceneCapture->GetOwner();
+        ViewInitOptions.ViewOrigin = ViewLocation;
+        ViewInitOptions.ViewRotationMatrix = FInverseRotationMatrix(Transform.Rotator()) * FMatrix(
+            FPlane(0, 0, 1, 0),
+            FPlane(1, 0, 0, 0),
+            FPlane(0, 1, 0, 0),
+            FPlane(0, 0, 0, 1));
+        ViewInitOptions.SceneViewStateInterface = SceneCapture->GetViewState(0);
+        ViewInitOptions.BackgroundColor = FLinearColor::Black;
+        ViewInitOptions.LODDistanceFactor = FMath::Clamp(SceneCapture->LODDistanceFactor, 0.01f, 100.0f);
+        ViewInitOptions.FOV = SceneCapture->FOVAngle;
+        ViewInitOptions.DesiredFOV = SceneCapture->FOVAngle;
+
+        // 수평 FOV 고정 (CaptureScene과 같은 투영)
+        const float HalfFOV = FMath::DegreesToRadians(SceneCapture->FOVAngle) * 0.5f;
+        const float XAxisMultiplier = ViewSize.X > ViewSize.Y ? 1.0f : (float)ViewSize.Y / ViewSize.X;
+        const float YAxisMultiplier = ViewSize.X > ViewSize.Y ? (float)ViewSize.X / ViewSize.Y : 1.0f;
+        ViewInitOptions.ProjectionMatrix = FReversedZPerspectiveMatrix(
+            HalfFOV, HalfFOV, XAxisMultiplier, YAxisMultiplier, GNearClippingPlane, GNearClippingPlane);
+
+        FSceneView* View = new FSceneView(ViewInitOptions);
+        View->bIsSceneCapture = true;
+        View->StartFinalPostprocessSettings(ViewLocation);
+        View->OverridePostProcessSettings(SceneCapture->PostProcessSettings, SceneCapture->PostProcessBlendWeight);
+        View->EndFinalPostprocessSettings(ViewInitOptions);
+
+        // 뷰 패밀리가 소유 (FSceneViewFamilyContext 소멸 시 삭제)
+        ViewFamily.Views.Add(View);
+    }
+
+    FCanvas Canvas(AtlasResource, nullptr, World, World->GetFeatureLevel());
+    GetRendererModule().BeginRenderingViewFamily(&Canvas, &ViewFamily);
+    return true;
+}
+
+// ================================================================================
+// FSRTGPUTimer
+// ================================================================================
+
+void FSRTGPUTimer::Begin()
+{
+    if (!GSupportsTimestampRenderQueries)
+        return;
+
+    ENQUEUE_RENDER_COMMAND(SRTGPUTimerBegin)(
+        [Self = AsShared()](FRHICommandListImmediate& RHICmdList)
+        {
+            FInterval& Interval = Self->Pending.AddDefaulted_GetRef();
+            Interval.Start = RHICreateRenderQuery(RQT_AbsoluteTime);
+            RHICmdList.EndRenderQuery(Interval.Start);
+        });
+}
+
+void FSRTGPUTimer::End(int32 ViewCount)
+{
+    if (!GSupportsTimestampRenderQueries)
+        return;
+
+    ENQUEUE_RENDER_COMMAND(SRTGPUTimerEnd)(
+        [Self = AsShared(), ViewCount](FRHICommandListImmediate& RHICmdList)
+        {
+            if (Self->Pending.Num() == 0 || Self->Pending.Last().End.IsValid())
+                return;
+
+            FInterval& Interval = Self->Pending.Last();
+            Interval.End = RHICreateRenderQuery(RQT_AbsoluteTime);
+            RHICmdList.EndRenderQuery(Interval.End);
+            Interval.ViewCount = ViewCount;
+
+            Self->Poll();
+        });
+}
+
+void FSRTGPUTimer::Poll()
+{
+    // GPU가 멈춰 결과가 안 나오는 경우에도 쿼리가 쌓이지 않게
+    constexpr int32 MaxPending = 32;
+    while (Pending.Num() > MaxPending)
+    {
+        Pending.RemoveAt(0);
+    }
+
+    while (Pending.Num() > 0 && Pending[0].End.IsValid())
+    {
+        uint64 StartMicroseconds = 0;
+        uint64 EndMicroseconds = 0;
+        if (!RHIGetRenderQueryResult(Pending[0].Start, StartMicroseconds, false) ||
+            !RHIGetRenderQueryResult(Pending[0].End, EndMicroseconds, false))
+        {
+            break;
+        }
+
+        if (Pending[0].ViewCount > 0 && EndMicroseconds >= StartMicroseconds)
+        {
+            FScopeLock ScopeLock(&Lock);
+            AccumulatedMicroseconds += EndMicroseconds - StartMicroseconds;
+            AccumulatedViews += Pending[0].ViewCount;
+        }
+        Pending.RemoveAt(0);
+    }
+}
+
+bool FSRTGPUTimer::ConsumeAverageMsPerView(float& OutMs)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (AccumulatedViews == 0)
+        return false;
+
+    OutMs = (float)((double)AccumulatedMicroseconds / 1000.0 / AccumulatedViews);
+    AccumulatedMicroseconds = 0;
+    AccumulatedViews = 0;
+    return true;
+}
@@ -1,5 +1,8 @@
 #include "CoreMinimal.h"
-#include <cstdint>  // intptr_t 사용
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
 
 #ifdef _WIN32
     #ifndef WIN32_LEAN_AND_MEAN
@@ -8,11 +11,16 @@
     #include <Windows.h>
     #include <winsock2.h>
     #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
 #endif
 
 #include "SRTNetworkWorker.h"
-#include "srt.h"
 #include <string>
+#include <chrono>
 
 namespace SRTNetwork
 {
@@ -43,117 +51,720 @@ namespace SRTNetwork
             bInitialized = false;
         }
     }
-    void* CreateSocket()
+    bool ApplyLiveStreamOptions(FSRTSocket& socket, int latencyMs)
     {
-        SRTSOCKET sock = srt_create_socket();
-        if (sock == SRT_INVALID_SOCK) return nullptr;
-        // intptr_t를 통한 안전한 변환
-        return reinterpret_cast<void*>(static_cast<intptr_t>(sock));
+        if (!socket) return false;
+        
+        // 전송 모드를 먼저 설정 (TRANSTYPE은 관련 옵션을 기본값으로 되돌림)
+        // 메시지 모드: 메시지 하나가 SRT 패킷 하나, 수신 측 TSBPD가 srctime 기준으로 전달
+        // 버퍼 1MB (기본 8MB), 흐름 제어 윈도우 1000 패킷 (기본 25600)
+        // SNDDROPDELAY: 레이턴시 + 200ms 넘게 못 보낸 패킷은 송신 측에서 버림
+        return socket.SetOptions({
+            {SRTO_TRANSTYPE, (int32)SRTT_LIVE},
+            {SRTO_MESSAGEAPI, 1},
+            {SRTO_LATENCY, latencyMs},
+            {SRTO_SNDBUF, 1024 * 1024},
+            {SRTO_RCVBUF, 1024 * 1024},
+            {SRTO_FC, 1000},
+            {SRTO_MSS, 1500},
+            {SRTO_SNDDROPDELAY, 200}
+        });
     }
-    void CloseSocket(void* socket)
+    bool ApplyPacingOptions(FSRTSocket& socket, int64 maxRateBytesPerSec)
     {
-        if (socket) {
-            SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-            srt_close(sock);
+        if (!socket || maxRateBytesPerSec <= 0) return false;
+        
+        return socket.SetOption(SRTO_MAXBW, (int64)0)
+            && socket.SetOption(SRTO_INPUTBW, maxRateBytesPerSec)
+            && socket.SetOption(SRTO_OHEADBW, (int32)PACING_OVERHEAD_PERCENT);
+    }
+    bool MakeEncryptionOptions(const FString& passphrase, int keyLength, int cryptoMode, bool bEnforced,
+                               EncryptionOptions& outOptions, FString& OutError)
+    {
+        outOptions = EncryptionOptions();
+        
+        // SRT는 PBKDF2 입력을 바이트 길이로 검사 (UTF-8 기준 10~79)
+        const FTCHARToUTF8 utf8(*passphrase);
+        if (utf8.Length() < 10 || utf8.Length() > 79)
+        {
+            OutError = FString::Printf(TEXT("Passphrase must be 10-79 bytes (got %d)"), utf8.Length());
+            return false;
         }
+        if (keyLength != 16 && keyLength != 24 && keyLength != 32)
+        {
+            OutError = FString::Printf(TEXT("Invalid key length %d (16, 24 or 32)"), keyLength);
+            return false;
+        }
+        
+        outOptions.Passphrase.Append(utf8.Get(), utf8.Length());
+        outOptions.KeyLength = keyLength;
+        outOptions.CryptoMode = cryptoMode;
+        outOptions.bEnforced = bEnforced;
+        return true;
     }
-    bool SetSocketOption(void* socket, int opt, const void* value, int len)
+    bool ApplyEncryptionOptions(FSRTSocket& socket, const EncryptionOptions& options)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        return srt_setsockopt(sock, 0, static_cast<SRT_SOCKOPT>(opt), value, len) == 0;
+        if (!socket) return false;
+        
+        if (!socket.SetOption(SRTO_ENFORCEDENCRYPTION, options.bEnforced))
+            return false;
+        
+        if (!options.IsEnabled())
+            return true;
+        
+        // 모드를 먼저 - GCM을 지원하지 않는 빌드면 여기서 실패 (SRT_EINVOP)
+        // CTR은 AUTO로 넘어옴: 일반 libsrt에는 SRTO_CRYPTOMODE 자체가 없어 설정하면 항상 실패
+        if (options.CryptoMode != CRYPTOMODE_AUTO)
+        {
+#ifdef ENABLE_AEAD_API_PREVIEW
+            if (!socket.SetOption(SRTO_CRYPTOMODE, (int32)options.CryptoMode))
+                return false;
+#else
+            // SRTO_CRYPTOMODE가 없는 헤더 = CTR 전용 빌드
+            if (options.CryptoMode != CRYPTOMODE_AES_CTR)
+                return false;
+#endif
+        }
+        
+        return socket.SetOption(SRTO_PBKEYLEN, (int32)options.KeyLength)
+            && socket.SetOption(SRTO_PASSPHRASE, options.Passphrase);
     }
-    bool Connect(void* socket, const char* ip, int port)
+    int GetKeyMaterialState(SRTSOCKET socket)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        sockaddr_in sa;
-        memset(&sa, 0, sizeof(sa));
-        sa.sin_family = AF_INET;
-        sa.sin_port = htons(port);
-        inet_pton(AF_INET, ip, &sa.sin_addr);
-        return srt_connect(sock, (sockaddr*)&sa, sizeof(sa)) != SRT_ERROR;
+        int state = SRT_KM_S_UNSECURED;
+        int len = sizeof(state);
+        if (socket == SRT_INVALID_SOCK || srt_getsockflag(socket, SRTO_KMSTATE, &state, &len) != 0)
+            return SRT_KM_S_UNSECURED;
+        return state;
+    }
+    const TCHAR* KeyMaterialStateToString(int state)
+    {
+        switch (state)
+        {
+            case 0: return TEXT("Unsecured");
+            case 1: return TEXT("Securing");
+            case 2: return TEXT("Secured");
+            case 3: return TEXT("No secret");
+            case 4: return TEXT("Bad secret");
+            case 5: return TEXT("Bad crypto mode");
+            default: return TEXT("Unknown");
+        }
+    }
+    FString GetRejectReason(SRTSOCKET socket)
+    {
+        if (socket == SRT_INVALID_SOCK) return FString();
+        const int reason = srt_getrejectreason(socket);
+        return FString::Printf(TEXT("%s (%d)"), UTF8_TO_TCHAR(srt_rejectreason_str(reason)), reason);
+    }
+    
+    // 주소 해석
+    FString Endpoint::ToString() const
+    {
+        char ip[INET6_ADDRSTRLEN] = {0};
+        if (bIPv6)
+        {
+            const sockaddr_in6* sa = reinterpret_cast<const sockaddr_in6*>(Address);
+            inet_ntop(AF_INET6, &sa->sin6_addr, ip, sizeof(ip));
+            return FString::Printf(TEXT("[%s]:%d"), UTF8_TO_TCHAR(ip), ntohs(sa->sin6_port));
+        }
+        const sockaddr_in* sa = reinterpret_cast<const sockaddr_in*>(Address);
+        inet_ntop(AF_INET, &sa->sin_addr, ip, sizeof(ip));
+        return FString::Printf(TEXT("%s:%d"), UTF8_TO_TCHAR(ip), ntohs(sa->sin_port));
+    }
+    static bool MakeEndpoint(const sockaddr* address, int length, Endpoint& out)
+    {
+        if (length <= 0 || length > (int)sizeof(out.Address)) return false;
+        if (address->sa_family != AF_INET && address->sa_family != AF_INET6) return false;
+        memset(out.Address, 0, sizeof(out.Address));
+        memcpy(out.Address, address, length);
+        out.Length = length;
+        out.bIPv6 = address->sa_family == AF_INET6;
+        return true;
+    }
+    // "1.2.3.4", "::1", "[::1]" - 이름이면 false
+    static bool ParseAddressLiteral(const FString& host, int port, Endpoint& out)
+    {
+        FString literal = host;
+        if (literal.StartsWith(TEXT("[")) && literal.EndsWith(TEXT("]")))
+        {
+            literal = literal.Mid(1, literal.Len() - 2);
+        }
+        const FTCHARToUTF8 utf8(*literal);
+        
+        sockaddr_in sa4;
+        memset(&sa4, 0, sizeof(sa4));
+        sa4.sin_family = AF_INET;
+        sa4.sin_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET, utf8.Get(), &sa4.sin_addr) == 1)
+            return MakeEndpoint((const sockaddr*)&sa4, sizeof(sa4), out);
+        
+        sockaddr_in6 sa6;
+        memset(&sa6, 0, sizeof(sa6));
+        sa6.sin6_family = AF_INET6;
+        sa6.sin6_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET6, utf8.Get(), &sa6.sin6_addr) == 1)
+            return MakeEndpoint((const sockaddr*)&sa6, sizeof(sa6), out);
+        return false;
+    }
+    
+    struct FResolvedHost
+    {
+        TArray<Endpoint> Endpoints;
+        double ExpireTime = 0.0;
+    };
+    static FCriticalSection ResolveCacheLock;
+    static TMap<FString, FResolvedHost> ResolveCache;
+    
+    static FString MakeResolveKey(const FString& host, int port)
+    {
+        return FString::Printf(TEXT("%s:%d"), *host.ToLower(), port);
     }
-    bool Bind(void* socket, int port)
+    
+    // 스레드 풀 작업과 대기 측이 공유 - 대기 측이 먼저 포기해도 작업이 끝날 때까지 유지
+    struct FResolveRequest
+    {
+        FString Host;
+        int Port = 0;
+        TArray<Endpoint> Endpoints;
+        FString Error;
+        TAtomic<bool> bDone{false};
+    };
+    
+    static void RunGetAddrInfo(FResolveRequest& request)
+    {
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        hints.ai_protocol = IPPROTO_UDP;
+        
+        addrinfo* results = nullptr;
+        const FString service = FString::FromInt(request.Port);
+        const int status = getaddrinfo(TCHAR_TO_UTF8(*request.Host), TCHAR_TO_UTF8(*service), &hints, &results);
+        if (status != 0)
+        {
+            request.Error = FString::Printf(TEXT("Cannot resolve %s: %s"), *request.Host, UTF8_TO_TCHAR(gai_strerror(status)));
+            return;
+        }
+        
+        // RFC 8305: 첫 결과의 주소 체계부터 IPv6/IPv4를 번갈아 시도 (한쪽 경로가 죽어 있어도 다음 시도가 바로 다른 쪽)
+        TArray<Endpoint> families[2];
+        int firstFamily = -1;
+        for (addrinfo* it = results; it; it = it->ai_next)
+        {
+            Endpoint endpoint;
+            if (!MakeEndpoint(it->ai_addr, (int)it->ai_addrlen, endpoint))
+                continue;
+            const int family = endpoint.bIPv6 ? 1 : 0;
+            if (firstFamily < 0) firstFamily = family;
+            const bool bDuplicate = families[family].ContainsByPredicate([&endpoint](const Endpoint& other)
+            {
+                return other.Length == endpoint.Length && memcmp(other.Address, endpoint.Address, endpoint.Length) == 0;
+            });
+            if (!bDuplicate)
+            {
+                families[family].Add(endpoint);
+            }
+        }
+        freeaddrinfo(results);
+        
+        for (int32 i = 0; firstFamily >= 0 && i < FMath::Max(families[0].Num(), families[1].Num()); i++)
+        {
+            if (families[firstFamily].IsValidIndex(i)) request.Endpoints.Add(families[firstFamily][i]);
+            if (families[1 - firstFamily].IsValidIndex(i)) request.Endpoints.Add(families[1 - firstFamily][i]);
+        }
+        if (request.Endpoints.Num() == 0)
+        {
+            request.Error = FString::Printf(TEXT("Cannot resolve %s: no IPv4/IPv6 address"), *request.Host);
+        }
+    }
+    
+    bool ResolveHost(const FString& host, int port, TArray<Endpoint>& OutEndpoints, FString& OutError,
+                     TFunctionRef<bool()> shouldAbort)
+    {
+        OutEndpoints.Reset();
+        
+        Endpoint literal;
+        if (ParseAddressLiteral(host, port, literal))
+        {
+            OutEndpoints.Add(literal);
+            return true;
+        }
+        if (host.IsEmpty())
+        {
+            OutError = TEXT("Empty host");
+            return false;
+        }
+        
+        const FString key = MakeResolveKey(host, port);
+        const double now = FPlatformTime::Seconds();
+        {
+            FScopeLock Lock(&ResolveCacheLock);
+            const FResolvedHost* cached = ResolveCache.Find(key);
+            if (cached && now < cached->ExpireTime)
+            {
+                OutEndpoints = cached->Endpoints;
+                return true;
+            }
+        }
+        
+        // getaddrinfo는 취소할 수 없으므로 스레드 풀에서 실행하고 여기서는 중단 요청만 확인
+        TSharedRef<FResolveRequest, ESPMode::ThreadSafe> request = MakeShared<FResolveRequest, ESPMode::ThreadSafe>();
+        request->Host = host;
+        request->Port = port;
+        Async(EAsyncExecution::ThreadPool, [request]()
+        {
+            RunGetAddrInfo(*request);
+            request->bDone = true;
+        });
+        
+        const double deadline = now + RESOLVE_TIMEOUT_MS / 1000.0;
+        while (!request->bDone)
+        {
+            if (shouldAbort())
+            {
+                OutError = TEXT("Aborted");
+                return false;
+            }
+            if (FPlatformTime::Seconds() >= deadline)
+                break;
+            FPlatformProcess::Sleep(0.01f);
+        }
+        
+        // 시간 초과면 풀 태스크가 아직 request를 쓰는 중일 수 있음 - bDone을 본 뒤에만 결과를 읽음
+        const bool bDone = request->bDone;
+        FScopeLock Lock(&ResolveCacheLock);
+        if (bDone && request->Error.IsEmpty())
+        {
+            FResolvedHost& entry = ResolveCache.FindOrAdd(key);
+            entry.Endpoints = request->Endpoints;
+            entry.ExpireTime = FPlatformTime::Seconds() + RESOLVE_CACHE_SECONDS;
+            OutEndpoints = request->Endpoints;
+            return true;
+        }
+        
+        // DNS가 잠깐 안 될 때는 마지막으로 알던 주소로 재연결
+        if (const FResolvedHost* stale = ResolveCache.Find(key))
+        {
+            OutEndpoints = stale->Endpoints;
+            return true;
+        }
+        OutError = bDone ? request->Error : FString::Printf(TEXT("Cannot resolve %s: timeout"), *host);
+        return false;
+    }
+    void InvalidateResolvedHost(const FString& host, int port)
+    {
+        FScopeLock Lock(&ResolveCacheLock);
+        ResolveCache.Remove(MakeResolveKey(host, port));
+    }
+    
+    static FString DescribeFailedConnect(SRTSOCKET sock, const Endpoint& endpoint)
+    {
+        const int reason = srt_getrejectreason(sock);
+        return FString::Printf(TEXT("%s: %s (%d)"), *endpoint.ToString(), UTF8_TO_TCHAR(srt_rejectreason_str(reason)), reason);
+    }
+    FSRTSocket ConnectHost(const FString& host, int port, TFunctionRef<FSRTSocket()> createSocket, int timeoutMs,
+                           TFunctionRef<bool()> shouldAbort, FString& OutEndpoint, FString& OutError)
+    {
+        TArray<Endpoint> endpoints;
+        if (!ResolveHost(host, port, endpoints, OutError, shouldAbort))
+            return FSRTSocket();
+        
+        // 진 쪽 (아직 연결 중인 시도)은 배열과 함께 닫힘
+        struct FAttempt
+        {
+            FSRTSocket Socket;
+            int32 Index;
+        };
+        TArray<FAttempt> attempts;
+        TArray<FString> errors;
+        const int eid = srt_epoll_create();
+        if (eid < 0)
+        {
+            OutError = UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString());
+            return FSRTSocket();
+        }
+        
+        const double deadline = FPlatformTime::Seconds() + FMath::Max(timeoutMs, 1) / 1000.0;
+        double nextAttemptTime = 0.0;
+        int32 nextIndex = 0;
+        FSRTSocket winner;
+        int32 winnerIndex = INDEX_NONE;
+        bool bAborted = false;
+        bool bTimedOut = false;
+        
+        while (!winner)
+        {
+            const double now = FPlatformTime::Seconds();
+            if (shouldAbort())
+            {
+                bAborted = true;
+                break;
+            }
+            if (now >= deadline)
+            {
+                bTimedOut = true;
+                break;
+            }
+            
+            // 다음 주소 시작: 처음, 지연 시간이 지났을 때, 진행 중인 시도가 모두 실패했을 때
+            if (nextIndex < endpoints.Num() && (attempts.Num() == 0 || now >= nextAttemptTime))
+            {
+                const Endpoint& endpoint = endpoints[nextIndex];
+                FSRTSocket sock = createSocket();
+                if (!sock)
+                {
+                    errors.Add(FString::Printf(TEXT("%s: cannot create socket"), *endpoint.ToString()));
+                    break;
+                }
+                sock.SetOption(SRTO_RCVSYN, false);  // srt_connect가 바로 반환, 완료는 epoll OUT/ERR
+                const int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+                if (srt_connect(sock.Get(), (const sockaddr*)endpoint.Address, endpoint.Length) == SRT_ERROR
+                    || srt_epoll_add_usock(eid, sock.Get(), &events) == SRT_ERROR)
+                {
+                    errors.Add(FString::Printf(TEXT("%s: %s"), *endpoint.ToString(), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString())));
+                }
+                else
+                {
+                    attempts.Add({MoveTemp(sock), nextIndex});
+                }
+                nextIndex++;
+                nextAttemptTime = now + HAPPY_EYEBALLS_DELAY_MS / 1000.0;
+                continue;
+            }
+            if (attempts.Num() == 0)
+                break;  // 모든 주소 실패
+            
+            // 종료 요청을 50ms 안에 볼 수 있도록 짧게 대기
+            double waitUntil = deadline;
+            if (nextIndex < endpoints.Num())
+            {
+                waitUntil = FMath::Min(waitUntil, nextAttemptTime);
+            }
+            const int waitMs = FMath::Clamp((int)((waitUntil - now) * 1000.0), 1, 50);
+            SRT_EPOLL_EVENT ready[8];
+            const int count = srt_epoll_uwait(eid, ready, (int)UE_ARRAY_COUNT(ready), waitMs);
+            for (int i = 0; i < count; i++)
+            {
+                const int32 attemptIndex = attempts.IndexOfByPredicate([&](const FAttempt& attempt) { return attempt.Socket.Get() == ready[i].fd; });
+                if (attemptIndex == INDEX_NONE)
+                    continue;
+                
+                FAttempt& attempt = attempts[attemptIndex];
+                const SRT_SOCKSTATUS state = attempt.Socket.GetState();
+                if (state == SRTS_CONNECTED && !winner)
+                {
+                    srt_epoll_remove_usock(eid, attempt.Socket.Get());
+                    winner = MoveTemp(attempt.Socket);
+                    winnerIndex = attempt.Index;
+                    attempts.RemoveAtSwap(attemptIndex);
+                }
+                else if (state != SRTS_CONNECTING && state != SRTS_CONNECTED)
+                {
+                    errors.Add(DescribeFailedConnect(attempt.Socket.Get(), endpoints[attempt.Index]));
+                    srt_epoll_remove_usock(eid, attempt.Socket.Get());
+                    attempts.RemoveAtSwap(attemptIndex);
+                }
+            }
+        }
+        
+        attempts.Reset();
+        srt_epoll_release(eid);
+        
+        if (winner)
+        {
+            winner.SetOption(SRTO_RCVSYN, true);  // 호출자는 블로킹 소켓을 기대 (필요하면 SetNonBlocking)
+            OutEndpoint = endpoints[winnerIndex].ToString();
+            return winner;
+        }
+        
+        if (bAborted)
+        {
+            OutError = TEXT("Aborted");
+            return FSRTSocket();
+        }
+        if (bTimedOut)
+        {
+            errors.Add(TEXT("connection timeout"));
+        }
+        // 주소가 바뀌었을 수 있으므로 다음 시도는 다시 조회
+        InvalidateResolvedHost(host, port);
+        OutError = FString::Join(errors, TEXT(", "));
+        return FSRTSocket();
+    }
+    bool WaitConnected(SRTSOCKET sock, int timeoutMs, TFunctionRef<bool()> shouldAbort)
+    {
+        if (sock == SRT_INVALID_SOCK) return false;
+        const int eid = srt_epoll_create();
+        const int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+        if (eid < 0 || srt_epoll_add_usock(eid, sock, &events) == SRT_ERROR)
+        {
+            if (eid >= 0) srt_epoll_release(eid);
+            return false;
+        }
+        
+        const double deadline = FPlatformTime::Seconds() + FMath::Max(timeoutMs, 1) / 1000.0;
+        bool bConnected = false;
+        while (!shouldAbort() && FPlatformTime::Seconds() < deadline)
+        {
+            SRT_EPOLL_EVENT ready[1];
+            srt_epoll_uwait(eid, ready, 1, 50);
+            const SRT_SOCKSTATUS state = srt_getsockstate(sock);
+            if (state == SRTS_CONNECTED)
+            {
+                bConnected = true;
+                break;
+            }
+            if (state != SRTS_CONNECTING && state != SRTS_OPENED)
+                break;
+        }
+        srt_epoll_release(eid);
+        return bConnected;
+    }
+    bool Bind(SRTSOCKET socket, int port)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
         sockaddr_in sa;
         memset(&sa, 0, sizeof(sa));
         sa.sin_family = AF_INET;
         sa.sin_port = htons(port);
         sa.sin_addr.s_addr = INADDR_ANY;
-        return srt_bind(sock, (sockaddr*)&sa, sizeof(sa)) == 0;
+        return srt_bind(socket, (sockaddr*)&sa, sizeof(sa)) == 0;
     }
-    bool Listen(void* socket, int backlog)
+    bool Listen(SRTSOCKET socket, int backlog)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        return srt_listen(sock, backlog) == 0;
+        return srt_listen(socket, backlog) == 0;
     }
-    void* Accept(void* socket)
+    int CreateSendEpoll(SRTSOCKET sock)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        sockaddr_in client_addr;
-        int addr_len = sizeof(client_addr);
-        SRTSOCKET client = srt_accept(sock, (sockaddr*)&client_addr, &addr_len);
-        if (client == SRT_INVALID_SOCK) return nullptr;
-        return reinterpret_cast<void*>(static_cast<intptr_t>(client));
+        if (sock == SRT_INVALID_SOCK) return -1;
+        
+        int eid = srt_epoll_create();
+        if (eid < 0) return -1;
+        
+        const int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+        if (srt_epoll_add_usock(eid, sock, &events) != 0)
+        {
+            srt_epoll_release(eid);
+            return -1;
+        }
+        return eid;
     }
-    int Send(void* socket, const char* data, int len)
+    void InterruptEpoll(int eid)
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        return srt_send(sock, data, len);
+        // 해제된 eid로 대기 중인 srt_epoll_uwait는 다음 검사에서 에러로 반환됨 (eid는 재사용되지 않음)
+        if (eid >= 0)
+        {
+            srt_epoll_release(eid);
+        }
     }
-    const char* GetLastError()
+    int WaitWritable(int eid, int timeoutMs)
     {
-        return srt_getlasterror_str();
+        if (eid < 0) return -1;
+        
+        SRT_EPOLL_EVENT event;
+        const int ready = srt_epoll_uwait(eid, &event, 1, timeoutMs);
+        if (ready < 0) return -1;
+        if (ready == 0) return 0;
+        return (event.events & SRT_EPOLL_ERR) ? -1 : 1;
     }
-    bool GetStats(void* socket, Stats& stats)
+    int64 GetTimeNowUs()
     {
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        SRT_TRACEBSTATS srtStats;
-        if (srt_bstats(sock, &srtStats, 1) == 0) {
-            stats.mbpsSendRate = srtStats.mbpsSendRate;
-            stats.msRTT = srtStats.msRTT;
-            stats.pktSndLossTotal = srtStats.pktSndLossTotal;
-            return true;
+        return srt_time_now();
+    }
+    int64 ToUtcMicroseconds(double platformSeconds)
+    {
+        const int64 utcNow = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return utcNow - static_cast<int64>((FPlatformTime::Seconds() - platformSeconds) * 1000000.0);
+    }
+    void SourceClock::Reset(SRTSOCKET sock)
+    {
+        // 두 시계를 연달아 읽어 오프셋 계산 (둘 다 단조 증가 시계)
+        OffsetUs = srt_time_now() - static_cast<int64>(FPlatformTime::Seconds() * 1000000.0);
+        
+        bUseSendTime = sock != SRT_INVALID_SOCK && (sock & SRTGROUP_MASK) != 0;
+        ConnectionTimeUs = (sock != SRT_INVALID_SOCK && !bUseSendTime) ? srt_connection_time(sock) : 0;
+        if (ConnectionTimeUs < 0)
+        {
+            ConnectionTimeUs = 0;
         }
-        return false;
+        LastSourceTimeUs = ConnectionTimeUs;
     }
-
-    bool SetNonBlocking(void* socket, bool nonblocking)
+    int64 SourceClock::ToSourceTime(double captureSeconds)
     {
-        if (!socket) return false;
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        int sync_mode = nonblocking ? 0 : 1;
-        bool result = true;
-        result &= (srt_setsockopt(sock, 0, SRTO_SNDSYN, &sync_mode, sizeof(sync_mode)) == 0);
-        result &= (srt_setsockopt(sock, 0, SRTO_RCVSYN, &sync_mode, sizeof(sync_mode)) == 0);
-        if (nonblocking)
+        if (bUseSendTime)
+            return 0;
+        
+        const int64 now = srt_time_now();
+        int64 srctime = static_cast<int64>(captureSeconds * 1000000.0) + OffsetUs;
+        
+        // 연결 이전 캡처 / 역순 / 미래 시각은 SRT가 거부하거나 TSBPD가 꼬이므로 제한
+        srctime = FMath::Clamp(srctime, LastSourceTimeUs, now);
+        LastSourceTimeUs = srctime;
+        return srctime;
+    }
+    void TokenBucketPacer::Reset(int burstPackets, int64 maxRateBytesPerSec)
+    {
+        BurstBytes = (double)FMath::Max(burstPackets, 1) * FSRTSocket::LIVE_PAYLOAD_SIZE;
+        MaxRateBytesPerSec = (double)FMath::Max<int64>(maxRateBytesPerSec, FSRTSocket::LIVE_PAYLOAD_SIZE);
+        RateBytesPerSec = MaxRateBytesPerSec;
+        DepthBytes = BurstBytes;
+        Tokens = BurstBytes;
+        LastRefill = 0.0;
+    }
+    void TokenBucketPacer::BeginFrame(int bytes, double windowSeconds, int64 minRateBytesPerSec, double now)
+    {
+        // 이전 프레임 속도로 지금까지 찬 토큰을 먼저 반영
+        Refill(now);
+        
+        const double rate = bytes / FMath::Max(windowSeconds, 0.001);
+        RateBytesPerSec = FMath::Clamp(rate, FMath::Min((double)minRateBytesPerSec, MaxRateBytesPerSec), MaxRateBytesPerSec);
+        DepthBytes = FMath::Max(BurstBytes, RateBytesPerSec * 0.002);
+        Tokens = FMath::Min(Tokens, DepthBytes);
+    }
+    void TokenBucketPacer::Refill(double now)
+    {
+        if (LastRefill > 0.0 && now > LastRefill)
         {
-            int timeout_ms = 100;
-            srt_setsockopt(sock, 0, SRTO_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+            Tokens = FMath::Min(DepthBytes, Tokens + (now - LastRefill) * RateBytesPerSec);
         }
-        return result;
+        LastRefill = now;
     }
-
-    void* AcceptWithTimeout(void* socket, int timeout_ms)
+    int TokenBucketPacer::Acquire(int wantBytes, double now, double& OutWaitSeconds)
     {
-        if (!socket) return nullptr;
+        Refill(now);
         
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
+        const int packets = (int)(Tokens / FSRTSocket::LIVE_PAYLOAD_SIZE);
+        if (packets > 0)
+        {
+            OutWaitSeconds = 0.0;
+            return FMath::Min(wantBytes, packets * FSRTSocket::LIVE_PAYLOAD_SIZE);
+        }
+        OutWaitSeconds = (FSRTSocket::LIVE_PAYLOAD_SIZE - Tokens) / RateBytesPerSec;
+        return 0;
+    }
+    void TokenBucketPacer::Consume(int bytes)
+    {
+        // 마지막 청크가 패킷보다 작아도 한 패킷 분량 - 토큰은 음수가 되지 않음
+        const int packets = FMath::DivideAndRoundUp(bytes, FSRTSocket::LIVE_PAYLOAD_SIZE);
+        Tokens = FMath::Max(0.0, Tokens - (double)packets * FSRTSocket::LIVE_PAYLOAD_SIZE);
+    }
+    void ReconnectBackoff::Reset(int initialDelayMs, int maxDelayMs)
+    {
+        InitialDelay = FMath::Max(initialDelayMs, 10) / 1000.0;
+        MaxDelay = FMath::Max(maxDelayMs, initialDelayMs) / 1000.0;
+        CurrentDelay = InitialDelay;
+    }
+    double ReconnectBackoff::NextDelaySeconds()
+    {
+        const double delay = CurrentDelay * FMath::FRandRange(0.8, 1.2);
+        CurrentDelay = FMath::Min(CurrentDelay * 2.0, MaxDelay);
+        return delay;
+    }
+    bool GetStats(SRTSOCKET sock, Stats& stats)
+    {
+        if (sock == SRT_INVALID_SOCK) return false;
+        
+        SRT_TRACEBSTATS s;
+        // clear=0: 구간 카운터를 지우면 같은 소켓을 읽는 다른 곳의 값이 깨짐 - 구간은 StatsTracker가 계산
+        if (srt_bstats(sock, &s, 0) != 0)
+            return false;
         
-        // Accept 타임아웃 설정
-        int rcvtimeo = timeout_ms;
-        srt_setsockopt(sock, 0, SRTO_RCVTIMEO, &rcvtimeo, sizeof(rcvtimeo));
+        stats.msTimeStamp = s.msTimeStamp;
         
-        sockaddr_in client_addr;
-        int addr_len = sizeof(client_addr);
-        SRTSOCKET client = srt_accept(sock, (sockaddr*)&client_addr, &addr_len);
+        stats.pktSentTotal = s.pktSentTotal;
+        stats.pktSentUniqueTotal = s.pktSentUniqueTotal;
+        stats.pktRetransTotal = s.pktRetransTotal;
+        stats.pktSndLossTotal = s.pktSndLossTotal;
+        stats.pktSndDropTotal = s.pktSndDropTotal;
+        stats.pktRecvACKTotal = s.pktRecvACKTotal;
+        stats.pktRecvNAKTotal = s.pktRecvNAKTotal;
+        stats.usSndDurationTotal = s.usSndDurationTotal;
+        stats.byteSentTotal = s.byteSentTotal;
+        stats.byteSentUniqueTotal = s.byteSentUniqueTotal;
+        stats.byteRetransTotal = s.byteRetransTotal;
+        stats.byteSndDropTotal = s.byteSndDropTotal;
+        
+        stats.pktRecvTotal = s.pktRecvTotal;
+        stats.pktRecvUniqueTotal = s.pktRecvUniqueTotal;
+        stats.pktRcvLossTotal = s.pktRcvLossTotal;
+        stats.pktRcvDropTotal = s.pktRcvDropTotal;
+        stats.pktRcvUndecryptTotal = s.pktRcvUndecryptTotal;
+        stats.pktSentACKTotal = s.pktSentACKTotal;
+        stats.pktSentNAKTotal = s.pktSentNAKTotal;
+        stats.byteRecvTotal = s.byteRecvTotal;
+        stats.byteRcvLossTotal = s.byteRcvLossTotal;
+        stats.byteRcvDropTotal = s.byteRcvDropTotal;
         
-        if (client != SRT_INVALID_SOCK)
+        stats.mbpsSendRate = s.mbpsSendRate;
+        stats.mbpsRecvRate = s.mbpsRecvRate;
+        
+        stats.msRTT = s.msRTT;
+        stats.mbpsBandwidth = s.mbpsBandwidth;
+        stats.mbpsMaxBW = s.mbpsMaxBW;
+        stats.usPktSndPeriod = s.usPktSndPeriod;
+        stats.pktFlowWindow = s.pktFlowWindow;
+        stats.pktCongestionWindow = s.pktCongestionWindow;
+        stats.pktFlightSize = s.pktFlightSize;
+        stats.byteAvailSndBuf = s.byteAvailSndBuf;
+        stats.byteAvailRcvBuf = s.byteAvailRcvBuf;
+        stats.byteMSS = s.byteMSS;
+        stats.pktSndBuf = s.pktSndBuf;
+        stats.byteSndBuf = s.byteSndBuf;
+        stats.msSndBuf = s.msSndBuf;
+        stats.msSndTsbPdDelay = s.msSndTsbPdDelay;
+        stats.pktRcvBuf = s.pktRcvBuf;
+        stats.byteRcvBuf = s.byteRcvBuf;
+        stats.msRcvBuf = s.msRcvBuf;
+        stats.msRcvTsbPdDelay = s.msRcvTsbPdDelay;
+        stats.pktReorderTolerance = s.pktReorderTolerance;
+        return true;
+    }
+
+    void StatsTracker::Reset()
+    {
+        Last = Stats();
+        bHasLast = false;
+    }
+
+    bool StatsTracker::Sample(SRTSOCKET socket, Stats& outTotals, StatsInterval& outInterval)
+    {
+        if (!GetStats(socket, outTotals))
+            return false;
+        
+        // 첫 샘플은 연결 시작부터를 구간으로 (누적값이 곧 구간 값)
+        const Stats& Prev = bHasLast ? Last : Stats();
+        
+        outInterval = StatsInterval();
+        outInterval.Seconds = FMath::Max<int64>(outTotals.msTimeStamp - Prev.msTimeStamp, 0) / 1000.0;
+        outInterval.PacketsSent = outTotals.pktSentTotal - Prev.pktSentTotal;
+        outInterval.PacketsSentUnique = outTotals.pktSentUniqueTotal - Prev.pktSentUniqueTotal;
+        outInterval.PacketsRetransmitted = outTotals.pktRetransTotal - Prev.pktRetransTotal;
+        outInterval.PacketsLost = outTotals.pktSndLossTotal - Prev.pktSndLossTotal;
+        outInterval.PacketsDropped = outTotals.pktSndDropTotal - Prev.pktSndDropTotal;
+        outInterval.BytesSent = (int64)(outTotals.byteSentTotal - Prev.byteSentTotal);
+        outInterval.BytesSentUnique = (int64)(outTotals.byteSentUniqueTotal - Prev.byteSentUniqueTotal);
+        outInterval.BytesRetransmitted = (int64)(outTotals.byteRetransTotal - Prev.byteRetransTotal);
+        outInterval.BytesDropped = (int64)(outTotals.byteSndDropTotal - Prev.byteSndDropTotal);
+        
+        if (outInterval.Seconds > 0.0)
+        {
+            outInterval.SendMbps = outInterval.BytesSent * 8.0 / outInterval.Seconds / 1000000.0;
+            outInterval.PayloadMbps = outInterval.BytesSentUnique * 8.0 / outInterval.Seconds / 1000000.0;
+            outInterval.RetransmitMbps = outInterval.BytesRetransmitted * 8.0 / outInterval.Seconds / 1000000.0;
+        }
+        if (outInterval.PacketsSentUnique > 0)
+        {
+            outInterval.LossPercent = 100.0 * outInterval.PacketsLost / outInterval.PacketsSentUnique;
+        }
+        if (outInterval.PacketsSent > 0)
         {
-            return reinterpret_cast<void*>(static_cast<intptr_t>(client));
+            outInterval.RetransmitPercent = 100.0 * outInterval.PacketsRetransmitted / outInterval.PacketsSent;
         }
         
-        return nullptr;
+        Last = outTotals;
+        bHasLast = true;
+        return true;
     }
 
     static VersionInfo CachedVersionInfo = {0, 0, 0, "", "", false};
@@ -194,6 +805,8 @@ namespace SRTNetwork
 #endif
 #ifdef _WIN64
         OutInfo.Platform = TEXT("Windows 64-bit");
+#elif defined(__linux__) && defined(__x86_64__)
+        OutInfo.Platform = TEXT("Linux 64-bit");
 #else
         OutInfo.Platform = TEXT("Unknown Platform");
 #endif
@@ -218,39 +831,127 @@ namespace SRTNetwork
         return versionStr.c_str();
     }
     
-    // 정상적인 연결 종료를 위한 함수
-    bool GracefulShutdown(void* socket)
+    // 소켓 그룹
+    bool ConnectGroupLinks(SRTSOCKET grp, const TArray<GroupLink>& links, const TArray<int32>& indices, TArray<FString>& OutErrors,
+                           TFunctionRef<bool()> shouldAbort)
     {
-        if (!socket) return false;
-        
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
+        OutErrors.Reset();
+        if (grp == SRT_INVALID_SOCK || indices.Num() == 0) return false;
         
-        // 1. 송신 버퍼 비우기
-        int opt_val = 0;
-        srt_setsockopt(sock, 0, SRTO_SNDDROPDELAY, &opt_val, sizeof(opt_val));
+        TArray<SRT_SOCKGROUPCONFIG> targets;
+        for (int32 index : indices)
+        {
+            const GroupLink& link = links[index];
+            
+            // 로컬 주소를 지정하면 해당 NIC로 바인드 - 업링크마다 다른 경로를 타게 함
+            const bool bBindLocal = !link.LocalAddress.IsEmpty() || link.LocalPort != 0;
+            Endpoint local;
+            if (!link.LocalAddress.IsEmpty() && !ParseAddressLiteral(link.LocalAddress, link.LocalPort, local))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Link %d: invalid local address %s"), index, *link.LocalAddress));
+                continue;
+            }
+            
+            TArray<Endpoint> remotes;
+            FString resolveError;
+            if (!ResolveHost(link.RemoteAddress, link.RemotePort, remotes, resolveError, shouldAbort))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Link %d: %s"), index, *resolveError));
+                continue;
+            }
+            // 로컬 주소가 있으면 같은 주소 체계의 원격 주소, 없으면 해석 순서대로 첫 번째
+            const Endpoint* remote = &remotes[0];
+            if (!link.LocalAddress.IsEmpty())
+            {
+                remote = remotes.FindByPredicate([&local](const Endpoint& candidate) { return candidate.bIPv6 == local.bIPv6; });
+                if (!remote)
+                {
+                    OutErrors.Add(FString::Printf(TEXT("Link %d: %s has no %s address"), index, *link.RemoteAddress,
+                        local.bIPv6 ? TEXT("IPv6") : TEXT("IPv4")));
+                    continue;
+                }
+            }
+            else if (bBindLocal)
+            {
+                // 포트만 지정 - 원격 주소 체계의 와일드카드 주소에 바인드
+                ParseAddressLiteral(remote->bIPv6 ? TEXT("::") : TEXT("0.0.0.0"), link.LocalPort, local);
+            }
+            
+            SRT_SOCKGROUPCONFIG target = srt_prepare_endpoint(bBindLocal ? (const sockaddr*)local.Address : nullptr,
+                                                              (const sockaddr*)remote->Address, remote->Length);
+            target.weight = (uint16_t)FMath::Clamp(link.Weight, 0, 65535);
+            target.token = index;
+            targets.Add(target);
+        }
+        if (targets.Num() == 0) return false;
         
-        // 2. Linger 옵션 설정 (즉시 종료)
-        linger l;
-        l.l_onoff = 1;
-        l.l_linger = 0;
-        srt_setsockopt(sock, 0, SRTO_LINGER, &l, sizeof(l));
+        const int result = srt_connect_group(grp, targets.GetData(), targets.Num());
+        for (const SRT_SOCKGROUPCONFIG& target : targets)
+        {
+            if (target.errorcode != SRT_SUCCESS)
+            {
+                OutErrors.Add(FString::Printf(TEXT("Link %d: %s"), target.token, UTF8_TO_TCHAR(srt_strerror(target.errorcode, 0))));
+            }
+        }
+        return result != SRT_ERROR;
+    }
+    bool GetGroupMembers(SRTSOCKET grp, TArray<GroupMember>& OutMembers)
+    {
+        OutMembers.Reset();
+        if (grp == SRT_INVALID_SOCK) return false;
         
-        // 3. 연결 종료 신호 전송
-        // SRT는 내부적으로 UMSG_SHUTDOWN을 보냄
+        SRT_SOCKGROUPDATA data[16];
+        size_t count = UE_ARRAY_COUNT(data);
+        if (srt_group_data(grp, data, &count) == SRT_ERROR)
+            return false;
         
+        for (size_t i = 0; i < count; i++)
+        {
+            GroupMember& member = OutMembers.AddDefaulted_GetRef();
+            member.Socket = data[i].id;
+            member.Token = data[i].token;
+            member.SocketState = data[i].sockstate;
+            member.MemberState = data[i].memberstate;
+            member.Weight = data[i].weight;
+            
+            const sockaddr* peer = reinterpret_cast<const sockaddr*>(&data[i].peeraddr);
+            Endpoint endpoint;
+            if (MakeEndpoint(peer, peer->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in), endpoint))
+            {
+                member.PeerAddress = endpoint.ToString();
+            }
+        }
         return true;
     }
+    const TCHAR* MemberStateToString(int memberState)
+    {
+        switch (memberState)
+        {
+            case SRT_GST_PENDING: return TEXT("Pending");
+            case SRT_GST_IDLE: return TEXT("Idle");
+            case SRT_GST_RUNNING: return TEXT("Running");
+            case SRT_GST_BROKEN: return TEXT("Broken");
+            default: return TEXT("Unknown");
+        }
+    }
     
-    // 연결 상태 확인
-    bool IsConnected(void* socket)
+    FSRTSocket AcceptPending(SRTSOCKET listenSocket, FString& OutPeerAddress)
     {
-        if (!socket) return false;
+        if (listenSocket == SRT_INVALID_SOCK) return FSRTSocket();
         
-        SRTSOCKET sock = static_cast<SRTSOCKET>(reinterpret_cast<intptr_t>(socket));
-        
-        // 소켓 상태 확인
-        SRT_SOCKSTATUS status = srt_getsockstate(sock);
+        sockaddr_storage client_addr;
+        int addr_len = sizeof(client_addr);
+        FSRTSocket client(srt_accept(listenSocket, (sockaddr*)&client_addr, &addr_len));
+        if (!client)
+        {
+            return client;  // SRT_EASYNCRCV = 대기 중인 연결 없음
+        }
         
-        return (status == SRTS_CONNECTED);
+        Endpoint peer;
+        if (MakeEndpoint((const sockaddr*)&client_addr, addr_len, peer))
+        {
+            OutPeerAddress = peer.ToString();
+        }
+        return client;
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
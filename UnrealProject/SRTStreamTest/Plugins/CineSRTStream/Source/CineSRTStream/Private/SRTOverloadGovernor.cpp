@@ -0,0 +1,212 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTOverloadGovernor.h"
+
+namespace
+{
+    // x264/x265 프리셋 (빠른 순)과 ultrafast 대비 대략적인 프레임당 비용 - 올림 판단의 예상 부하용이라 정확할 필요는 없음
+    struct FPresetCost
+    {
+        const TCHAR* Name;
+        double Cost;
+    };
+
+    const FPresetCost PresetCosts[] =
+    {
+        { TEXT("ultrafast"), 1.0 },
+        { TEXT("superfast"), 1.4 },
+        { TEXT("veryfast"), 1.9 },
+        { TEXT("faster"), 2.6 },
+        { TEXT("fast"), 3.2 },
+        { TEXT("medium"), 3.8 },
+        { TEXT("slow"), 5.5 },
+        { TEXT("slower"), 9.0 },
+        { TEXT("veryslow"), 16.0 },
+        { TEXT("placebo"), 45.0 },
+    };
+
+    int32 FindPreset(const FString& Name)
+    {
+        for (int32 i = 0; i < UE_ARRAY_COUNT(PresetCosts); i++)
+        {
+            if (Name.Equals(PresetCosts[i].Name, ESearchCase::IgnoreCase))
+                return i;
+        }
+        return INDEX_NONE;
+    }
+
+    const float ResolutionScales[] = { 0.75f, 0.5f, 0.375f, 0.25f };
+    const float FrameRateScales[] = { 2.0f / 3.0f, 0.5f, 1.0f / 3.0f, 0.25f };
+
+    // 데드 타임 없이 한 창에서 이만큼 넘게 덮어써지면 과부하 (가끔 한 장은 캡처 지터)
+    const float OverwriteRatio = 0.1f;
+    const double MaxRecoverHoldSeconds = 60.0;
+}
+
+FString FSRTOverloadGovernor::FLevel::ToString() const
+{
+    return Preset.IsEmpty()
+        ? FString::Printf(TEXT("%dx%d@%d"), Width, Height, FPS)
+        : FString::Printf(TEXT("%dx%d@%d %s"), Width, Height, FPS, *Preset);
+}
+
+void FSRTOverloadGovernor::Reset(const FConfig& InConfig)
+{
+    Config = InConfig;
+    Levels.Reset();
+    Current = 0;
+    Load = 0.0f;
+    LastReason.Reset();
+    WindowStart = 0.0;
+    LastSampleTime = 0.0;
+    HoldUntil = 0.0;
+    RecoverStart = 0.0;
+    RecoverHoldSeconds = Config.RecoverSeconds;
+    LastUpgradeTime = -1.0e9;
+
+    FLevel Level;
+    Level.Width = Config.Width;
+    Level.Height = Config.Height;
+    Level.FPS = FMath::Max(Config.FPS, 1);
+    Level.Preset = Config.Preset;
+    Levels.Add(Level);
+
+    const double BasePixels = (double)Config.Width * Config.Height;
+    auto AddLevel = [this, BasePixels](FLevel NewLevel, double PresetRatio)
+    {
+        NewLevel.Cost = PresetRatio * ((double)NewLevel.Width * NewLevel.Height / BasePixels)
+                        * ((double)NewLevel.FPS / Levels[0].FPS);
+        Levels.Add(NewLevel);
+    };
+
+    // 1) 프리셋 - 모르는 이름이거나 하드웨어 인코더(빈 이름)면 건너뜀
+    const int32 StartPreset = FindPreset(Config.Preset);
+    double PresetRatio = 1.0;
+    if (StartPreset != INDEX_NONE)
+    {
+        const int32 FastestPreset = FMath::Min(FMath::Max(FindPreset(Config.FastestPreset), 0), StartPreset);
+        for (int32 i = StartPreset - 1; i >= FastestPreset; i--)
+        {
+            Level.Preset = PresetCosts[i].Name;
+            PresetRatio = PresetCosts[i].Cost / PresetCosts[StartPreset].Cost;
+            AddLevel(Level, PresetRatio);
+        }
+    }
+
+    // 2) 해상도 - 4:2:0이라 짝수로
+    for (const float Scale : ResolutionScales)
+    {
+        if (Scale < Config.MinResolutionScale - KINDA_SMALL_NUMBER)
+            break;
+        Level.Width = FMath::Max((int32)(Config.Width * Scale) & ~1, 2);
+        Level.Height = FMath::Max((int32)(Config.Height * Scale) & ~1, 2);
+        AddLevel(Level, PresetRatio);
+    }
+
+    // 3) 프레임 속도
+    for (const float Scale : FrameRateScales)
+    {
+        const int32 FPS = FMath::RoundToInt(Levels[0].FPS * Scale);
+        if (FPS < Config.MinFPS)
+            break;
+        if (FPS >= Level.FPS)
+            continue;
+        Level.FPS = FPS;
+        AddLevel(Level, PresetRatio);
+    }
+}
+
+void FSRTOverloadGovernor::ResetWindow(double Now, int32 OverwrittenFrames)
+{
+    WindowStart = Now;
+    WindowFrames = 0;
+    WindowEncodeMs = 0.0;
+    WindowOverwriteBase = OverwrittenFrames;
+}
+
+void FSRTOverloadGovernor::OnLevelApplied(double Now)
+{
+    HoldUntil = Now + Config.CooldownSeconds;
+    WindowStart = 0.0;
+}
+
+void FSRTOverloadGovernor::RevertLevel(int32 Index, double Now)
+{
+    ChangeLevel(FMath::Clamp(Index, 0, Levels.Num() - 1), Now);
+}
+
+void FSRTOverloadGovernor::ChangeLevel(int32 NewLevel, double Now)
+{
+    Current = NewLevel;
+    RecoverStart = 0.0;
+    // 인코더가 바뀔 때까지도 판단하지 않음 (OnLevelApplied에서 쿨다운 다시 시작)
+    HoldUntil = Now + Config.CooldownSeconds;
+    WindowStart = 0.0;
+}
+
+bool FSRTOverloadGovernor::AddSample(double EncodeMs, int32 OverwrittenFrames, double Now)
+{
+    if (!IsEnabled())
+        return false;
+
+    // 첫 샘플, 쿨다운, 또는 끊김/정지로 샘플이 비었던 뒤 - 그동안의 덮어쓰기는 인코더 탓이 아님
+    const bool bGap = LastSampleTime > 0.0 && Now - LastSampleTime > Config.WindowSeconds;
+    LastSampleTime = Now;
+    if (WindowStart == 0.0 || bGap || Now < HoldUntil)
+    {
+        ResetWindow(Now, OverwrittenFrames);
+        return false;
+    }
+
+    WindowFrames++;
+    WindowEncodeMs += EncodeMs;
+    if (Now - WindowStart < Config.WindowSeconds)
+        return false;
+
+    const double IntervalMs = 1000.0 / Levels[Current].FPS;
+    const int32 Overwrites = OverwrittenFrames - WindowOverwriteBase;
+    const int32 Frames = WindowFrames;
+    Load = (float)(WindowEncodeMs / FMath::Max(WindowFrames, 1) / IntervalMs);
+    const double WindowBegin = WindowStart;
+    ResetWindow(Now, OverwrittenFrames);
+
+    const bool bOverloaded = Load > Config.OverloadThreshold || Overwrites > FMath::Max(1, (int32)(Frames * OverwriteRatio));
+    if (bOverloaded)
+    {
+        RecoverStart = 0.0;
+        if (Current + 1 >= Levels.Num())
+            return false;
+
+        // 올린 지 얼마 안 돼 다시 내려옴 - 그 단계는 감당이 안 되니 다음 올림은 더 오래 지켜봄
+        if (Now - LastUpgradeTime < RecoverHoldSeconds + Config.CooldownSeconds)
+        {
+            RecoverHoldSeconds = FMath::Min(RecoverHoldSeconds * 2.0, MaxRecoverHoldSeconds);
+        }
+        LastReason = FString::Printf(TEXT("encode %.1f ms / %.1f ms frame interval (%.0f%%), %d of %d frames overwritten"),
+            Load * IntervalMs, IntervalMs, Load * 100.0f, Overwrites, Frames + Overwrites);
+        ChangeLevel(Current + 1, Now);
+        return true;
+    }
+
+    if (Current == 0)
+        return false;
+
+    const double ProjectedLoad = Load * Levels[Current - 1].Cost / Levels[Current].Cost;
+    if (ProjectedLoad >= Config.RecoverThreshold)
+    {
+        RecoverStart = 0.0;
+        return false;
+    }
+    if (RecoverStart == 0.0)
+    {
+        RecoverStart = WindowBegin;
+    }
+    if (Now - RecoverStart < RecoverHoldSeconds)
+        return false;
+
+    LastReason = FString::Printf(TEXT("encode load %.0f%%, projected %.0f%% one level up for %.0f s"),
+        Load * 100.0f, ProjectedLoad * 100.0, Now - RecoverStart);
+    LastUpgradeTime = Now;
+    ChangeLevel(Current - 1, Now);
+    return true;
+}
@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTRecordingTap.h"
+#include "CineSRTStream.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // 디스크 섹터/페이지 정렬
+    constexpr int32 WriteAlignment = 4096;
+}
+
+FSRTRecordingTap::FSRTRecordingTap()
+{
+}
+
+FSRTRecordingTap::~FSRTRecordingTap()
+{
+    Shutdown();
+}
+
+bool FSRTRecordingTap::Start(const FConfig& InConfig)
+{
+    if (Thread)
+        return true;
+
+    Config = InConfig;
+    OutputDirectory = Config.OutputDirectory.IsEmpty()
+        ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SRTRecordings"))
+        : Config.OutputDirectory;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.CreateDirectoryTree(*OutputDirectory))
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("RecordingTap: Cannot create directory %s"), *OutputDirectory);
+        return false;
+    }
+
+    MaxBufferedBytes = (int64)FMath::Max(Config.MaxBufferedMB, 1) * 1024 * 1024;
+    WriteBlockSize = Align(FMath::Max(Config.WriteBlockKB, 4) * 1024, WriteAlignment);
+    WriteBlock = (uint8*)FMemory::Malloc(WriteBlockSize, WriteAlignment);
+    WriteBlockUsed = 0;
+    SegmentIndex = 0;
+    bWaitForKeyFrame = true;
+    bShouldExit = false;
+
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("SRTRecordingTap"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("RecordingTap: Failed to create I/O thread"));
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+        FMemory::Free(WriteBlock);
+        WriteBlock = nullptr;
+        return false;
+    }
+
+    bRecording = true;
+    UE_LOG(LogCineSRTStream, Log, TEXT("RecordingTap: Recording to %s (%ds segments, %d MB buffer)"),
+        *OutputDirectory, Config.SegmentDurationSec, Config.MaxBufferedMB);
+    return true;
+}
+
+void FSRTRecordingTap::Shutdown()
+{
+    if (!Thread)
+        return;
+
+    bRecording = false;
+    Stop();
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+
+    // Run()이 남은 청크를 모두 기록하고 세그먼트를 닫은 뒤 종료함
+    FChunk Dummy;
+    while (Chunks.Dequeue(Dummy)) {}
+    BufferedBytes = 0;
+
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+
+    if (WriteBlock)
+    {
+        FMemory::Free(WriteBlock);
+        WriteBlock = nullptr;
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("RecordingTap: Stopped (%d segments, %lld bytes, %d chunks dropped)"),
+        SegmentsWritten.Load(), BytesWritten.Load(), DroppedChunks.Load());
+}
+
+bool FSRTRecordingTap::Submit(const TArray<uint8>& TSPackets, int64 PTS, bool bKeyFrame)
+{
+    if (!bRecording || bShouldExit || TSPackets.Num() == 0)
+        return false;
+
+    // 드롭 이후에는 키프레임부터 다시 시작 (중간 프레임만 있는 구간은 디코딩 불가)
+    const bool bResync = bWaitForKeyFrame;
+    if (bResync)
+    {
+        if (!bKeyFrame)
+        {
+            DroppedChunks++;
+            DroppedBytes += TSPackets.Num();
+            return false;
+        }
+        bWaitForKeyFrame = false;
+    }
+
+    // 메모리 상한 - 디스크가 밀려도 송신 경로는 기다리지 않음
+    if (BufferedBytes.Load() + TSPackets.Num() > MaxBufferedBytes)
+    {
+        DroppedChunks++;
+        DroppedBytes += TSPackets.Num();
+        bWaitForKeyFrame = true;
+        return false;
+    }
+
+    FChunk Chunk;
+    Chunk.Data = TSPackets;
+    Chunk.PTS = PTS;
+    Chunk.bKeyFrame = bKeyFrame;
+    Chunk.bDiscontinuity = bResync;
+
+    BufferedBytes += TSPackets.Num();
+    Chunks.Enqueue(MoveTemp(Chunk));
+    WorkEvent->Trigger();
+    return true;
+}
+
+FSRTRecordingTap::FStats FSRTRecordingTap::GetStats() const
+{
+    FStats Stats;
+    Stats.SegmentsWritten = SegmentsWritten.Load();
+    Stats.BytesWritten = BytesWritten.Load();
+    Stats.DroppedChunks = DroppedChunks.Load();
+    Stats.DroppedBytes = DroppedBytes.Load();
+    Stats.WriteErrors = WriteErrors.Load();
+    Stats.BufferedBytes = BufferedBytes.Load();
+    return Stats;
+}
+
+FString FSRTRecordingTap::GetCurrentSegmentPath() const
+{
+    FScopeLock Lock(&PathLock);
+    return CurrentSegmentPath;
+}
+
+bool FSRTRecordingTap::Init()
+{
+    return true;
+}
+
+uint32 FSRTRecordingTap::Run()
+{
+    FChunk Chunk;
+    while (true)
+    {
+        WorkEvent->Wait(100);
+
+        while (Chunks.Dequeue(Chunk))
+        {
+            BufferedBytes -= Chunk.Data.Num();
+            WriteChunk(Chunk);
+        }
+
+        if (bShouldExit)
+            break;
+    }
+
+    CloseSegment();
+    return 0;
+}
+
+void FSRTRecordingTap::Stop()
+{
+    bShouldExit = true;
+    if (WorkEvent)
+    {
+        WorkEvent->Trigger();
+    }
+}
+
+void FSRTRecordingTap::WriteChunk(const FChunk& Chunk)
+{
+    // 세그먼트 분할은 키프레임에서만 (각 세그먼트가 IDR + PAT/PMT로 시작)
+    const int64 SegmentTicks = (int64)FMath::Max(Config.SegmentDurationSec, 1) * 90000;
+    if (Chunk.bKeyFrame && (!SegmentFile || Chunk.bDiscontinuity || Chunk.PTS - SegmentStartPTS >= SegmentTicks))
+    {
+        CloseSegment();
+        OpenSegment(Chunk.PTS);
+    }
+
+    if (!SegmentFile)
+        return;
+
+    const uint8* Src = Chunk.Data.GetData();
+    int32 Remaining = Chunk.Data.Num();
+    while (Remaining > 0)
+    {
+        const int32 Copy = FMath::Min(Remaining, WriteBlockSize - WriteBlockUsed);
+        FMemory::Memcpy(WriteBlock + WriteBlockUsed, Src, Copy);
+        WriteBlockUsed += Copy;
+        Src += Copy;
+        Remaining -= Copy;
+
+        if (WriteBlockUsed == WriteBlockSize)
+        {
+            FlushBlock();
+        }
+    }
+}
+
+bool FSRTRecordingTap::OpenSegment(int64 StartPTS)
+{
+    const FString FileName = FString::Printf(TEXT("%s_%s_%04d.ts"),
+        *Config.FilePrefix, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), ++SegmentIndex);
+    const FString Path = FPaths::Combine(OutputDirectory, FileName);
+
+    SegmentFile = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path);
+    if (!SegmentFile)
+    {
+        WriteErrors++;
+        UE_LOG(LogCineSRTStream, Error, TEXT("RecordingTap: Cannot open %s"), *Path);
+        return false;
+    }
+
+    SegmentStartPTS = StartPTS;
+    WriteBlockUsed = 0;
+
+    FScopeLock Lock(&PathLock);
+    CurrentSegmentPath = Path;
+    return true;
+}
+
+void FSRTRecordingTap::CloseSegment()
+{
+    if (!SegmentFile)
+        return;
+
+    FlushBlock();
+    SegmentFile->Flush();
+    delete SegmentFile;
+    SegmentFile = nullptr;
+    SegmentsWritten++;
+}
+
+void FSRTRecordingTap::FlushBlock()
+{
+    if (!SegmentFile || WriteBlockUsed == 0)
+        return;
+
+    if (SegmentFile->Write(WriteBlock, WriteBlockUsed))
+    {
+        BytesWritten += WriteBlockUsed;
+    }
+    else
+    {
+        WriteErrors++;
+    }
+    WriteBlockUsed = 0;
+}
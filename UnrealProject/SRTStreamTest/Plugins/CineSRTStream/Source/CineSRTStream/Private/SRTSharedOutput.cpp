@@ -0,0 +1,442 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTSharedOutput.h"
+#include "CineSRTStream.h"
+#include "SRTNetworkWorker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+TMap<FString, TWeakPtr<FSRTSharedOutput>> FSRTSharedOutput::Registry;
+FCriticalSection FSRTSharedOutput::RegistryLock;
+
+FString FSRTSharedOutput::MakeKey(const FConfig& InConfig)
+{
+    return FString::Printf(TEXT("%s:%d"), *InConfig.StreamIP, InConfig.StreamPort);
+}
+
+TSharedPtr<FSRTSharedOutput> FSRTSharedOutput::Acquire(const FConfig& InConfig)
+{
+    FScopeLock Lock(&RegistryLock);
+
+    const FString Key = MakeKey(InConfig);
+    if (TWeakPtr<FSRTSharedOutput>* Existing = Registry.Find(Key))
+    {
+        TSharedPtr<FSRTSharedOutput> Output = Existing->Pin();
+        if (Output.IsValid())
+        {
+            const SRTNetwork::EncryptionOptions& Current = Output->Config.Encryption;
+            if (Current.Passphrase != InConfig.Encryption.Passphrase || Current.KeyLength != InConfig.Encryption.KeyLength
+                || Current.CryptoMode != InConfig.Encryption.CryptoMode)
+            {
+                UE_LOG(LogCineSRTStream, Warning, TEXT("SharedOutput: Encryption settings differ from the first component on %s - using the first"), *Key);
+            }
+            // 연결은 하나라 레이턴시/TTL도 첫 컴포넌트 값 - 조용히 바뀌지 않도록 알림
+            if (Output->Config.LatencyMs != InConfig.LatencyMs || Output->Config.MessageTTLMs != InConfig.MessageTTLMs)
+            {
+                UE_LOG(LogCineSRTStream, Warning, TEXT("SharedOutput: Latency %d ms / TTL %d ms differs from the first component on %s - using %d ms / %d ms"),
+                    InConfig.LatencyMs, InConfig.MessageTTLMs, *Key, Output->Config.LatencyMs, Output->Config.MessageTTLMs);
+            }
+            return Output;
+        }
+    }
+
+    TSharedPtr<FSRTSharedOutput> Output = MakeShareable(new FSRTSharedOutput(InConfig));
+    Output->Thread = FRunnableThread::Create(Output.Get(), TEXT("SRTSharedOutput"));
+    if (!Output->Thread)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("SharedOutput: Failed to create sender thread for %s"), *Key);
+        return nullptr;
+    }
+
+    Registry.Add(Key, Output);
+    UE_LOG(LogCineSRTStream, Log, TEXT("SharedOutput: Created shared MPTS output for %s"), *Key);
+    return Output;
+}
+
+FSRTSharedOutput::FSRTSharedOutput(const FConfig& InConfig)
+    : Config(InConfig)
+{
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+    FSRTTransportStream::FConfig TSConfig;
+    TSConfig.bMultiProgram = true;
+    TSConfig.ServiceName = TEXT("UnrealStream");
+    TSConfig.ProviderName = TEXT("CineSRT");
+    TransportStream.Initialize(TSConfig);
+}
+
+FSRTSharedOutput::~FSRTSharedOutput()
+{
+    Stop();
+
+    if (Thread)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    RecordingTap.Shutdown();
+
+    SRTSocket.Close();
+
+    FPendingFrame Dummy;
+    while (PendingFrames.Dequeue(Dummy)) {}
+
+    TransportStream.Shutdown();
+
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+
+    // 만료된 레지스트리 항목 정리
+    FScopeLock Lock(&RegistryLock);
+    const FString Key = MakeKey(Config);
+    if (TWeakPtr<FSRTSharedOutput>* Existing = Registry.Find(Key))
+    {
+        if (!Existing->IsValid())
+        {
+            Registry.Remove(Key);
+        }
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("SharedOutput: %s closed"), *Key);
+}
+
+int32 FSRTSharedOutput::RegisterProgram(const FString& ServiceName,
+                                        bool bEnableSCTE35,
+                                        FSRTTransportStream::EMetadataFormat MetadataFormat,
+                                        uint8 VideoStreamType)
+{
+    int32 ProgramIndex = INDEX_NONE;
+    {
+        FScopeLock Lock(&MuxLock);
+        ProgramIndex = TransportStream.AddProgram(ServiceName, bEnableSCTE35, MetadataFormat, VideoStreamType);
+    }
+
+    if (ProgramIndex != INDEX_NONE)
+    {
+        FScopeLock Lock(&StatsLock);
+        ProgramStats[ProgramIndex] = FProgramStats();
+        IntervalBytes[ProgramIndex] = 0;
+    }
+    return ProgramIndex;
+}
+
+void FSRTSharedOutput::UnregisterProgram(int32 ProgramIndex)
+{
+    FScopeLock Lock(&MuxLock);
+    TransportStream.RemoveProgram(ProgramIndex);
+}
+
+bool FSRTSharedOutput::ScheduleSpliceEvent(int32 ProgramIndex, const FSRTTransportStream::FSpliceEvent& Event)
+{
+    // 프로그램 배열은 등록/해제 시 바뀌므로 MuxLock 안에서 접근
+    FScopeLock Lock(&MuxLock);
+    return TransportStream.ScheduleSpliceEvent(ProgramIndex, Event);
+}
+
+bool FSRTSharedOutput::ScheduleMetadata(int32 ProgramIndex, int64 PTS, const TArray<uint8>& Payload)
+{
+    FScopeLock Lock(&MuxLock);
+    return TransportStream.ScheduleMetadata(ProgramIndex, PTS, Payload);
+}
+
+bool FSRTSharedOutput::StartRecording(const FSRTRecordingTap::FConfig& RecordingConfig)
+{
+    FScopeLock Lock(&RecordingLock);
+    if (RecordingTap.IsRecording())
+        return true;
+    return RecordingTap.Start(RecordingConfig);
+}
+
+void FSRTSharedOutput::StopRecording()
+{
+    FScopeLock Lock(&RecordingLock);
+    RecordingTap.Shutdown();
+}
+
+bool FSRTSharedOutput::SubmitFrame(int32 ProgramIndex, FEncodedFrame&& Frame)
+{
+    if (bShouldExit || ProgramIndex < 0 || ProgramIndex >= TS_MAX_PROGRAMS)
+        return false;
+
+    // 송신 스레드가 밀리면 새 프레임을 버림 (큐 무한 증가 방지)
+    if (PendingCount.Load() >= MaxPendingFrames)
+    {
+        FScopeLock Lock(&StatsLock);
+        ProgramStats[ProgramIndex].QueueDrops++;
+        return false;
+    }
+
+    FPendingFrame Pending;
+    Pending.ProgramIndex = ProgramIndex;
+    Pending.Frame = MoveTemp(Frame);
+    PendingFrames.Enqueue(MoveTemp(Pending));
+    PendingCount++;
+
+    WorkEvent->Trigger();
+    return true;
+}
+
+bool FSRTSharedOutput::GetProgramStats(int32 ProgramIndex, FProgramStats& OutStats) const
+{
+    if (ProgramIndex < 0 || ProgramIndex >= TS_MAX_PROGRAMS)
+        return false;
+
+    FScopeLock Lock(&StatsLock);
+    OutStats = ProgramStats[ProgramIndex];
+    return true;
+}
+
+bool FSRTSharedOutput::Init()
+{
+    return true;
+}
+
+uint32 FSRTSharedOutput::Run()
+{
+    const FString Key = MakeKey(Config);
+    SRTNetwork::ReconnectBackoff Backoff;
+    Backoff.Reset(Config.ReconnectInitialDelayMs, Config.ReconnectMaxDelayMs);
+    LastStatsTime = FPlatformTime::Seconds();
+
+    TArray<uint8> TSPackets;
+    while (!bShouldExit)
+    {
+        // 연결 (송신 스레드에서 수행하므로 게임 스레드를 막지 않음)
+        if (!bConnected)
+        {
+            if (!Connect(Key))
+            {
+                if (!Config.bAutoReconnect)
+                {
+                    return 1;
+                }
+
+                // 끊긴 동안 쌓인 프레임은 라이브 의미가 없으므로 버림
+                bReconnecting = true;
+                DiscardPendingFrames();
+                const double Delay = Backoff.NextDelaySeconds();
+                UE_LOG(LogCineSRTStream, Warning, TEXT("SharedOutput: Retrying %s in %.2f s"), *Key, Delay);
+                WorkEvent->Wait(FTimespan::FromSeconds(Delay));
+                continue;
+            }
+
+            Backoff.Reset(Config.ReconnectInitialDelayMs, Config.ReconnectMaxDelayMs);
+            bReconnecting = false;
+            // 이전 연결 시점의 프레임(키프레임 이전 P프레임)은 보내지 않음
+            DiscardPendingFrames();
+            ConnectionEpoch++;
+        }
+
+        WorkEvent->Wait(10);
+
+        FPendingFrame Pending;
+        while (!bShouldExit && bConnected && PendingFrames.Dequeue(Pending))
+        {
+            PendingCount--;
+
+            TSPackets.Reset();
+            bool bMuxed = false;
+            const FSRTTransportStream::FCaptureStamp CaptureStamp{Pending.Frame.CaptureUtcUs, Pending.Frame.CaptureFrameNumber};
+            SRT_TRACE_STAGE(Pending.Frame.Trace, MuxBegin);
+            {
+                FScopeLock Lock(&MuxLock);
+                bMuxed = TransportStream.MuxVideoFrame(
+                    Pending.ProgramIndex,
+                    Pending.Frame.Data,
+                    Pending.Frame.PTS,
+                    Pending.Frame.DTS,
+                    Pending.Frame.bKeyFrame,
+                    TSPackets,
+                    Pending.Frame.CaptureUtcUs != 0 ? &CaptureStamp : nullptr);
+            }
+
+            // 해제된 프로그램의 늦은 프레임은 조용히 버림
+            if (!bMuxed)
+                continue;
+            SRT_TRACE_STAGE(Pending.Frame.Trace, MuxEnd);
+            
+            {
+                // StopRecording이 탭의 I/O 스레드와 이벤트를 정리하는 중에는 제출하지 않음
+                FScopeLock RecordingScope(&RecordingLock);
+                RecordingTap.Submit(TSPackets, Pending.Frame.PTS, Pending.Frame.bKeyFrame);
+            }
+
+            SRT_TRACE_FRAME_ID(SendFrameId, Pending.Frame.Trace.FrameId);
+            SRT_TRACE_STAGE(Pending.Frame.Trace, SendBegin);
+            if (!SendPackets(TSPackets, Pending.Frame.CaptureTime))
+            {
+                UE_LOG(LogCineSRTStream, Error, TEXT("SharedOutput: Send failed: %s"),
+                    UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+                Disconnect();
+                if (!Config.bAutoReconnect)
+                {
+                    bShouldExit = true;
+                }
+                bReconnecting = Config.bAutoReconnect;
+                break;
+            }
+
+            SRT_TRACE_STAGE(Pending.Frame.Trace, SendEnd);
+            SRT_TRACE_COMMIT(Pending.Frame.Trace);
+
+            FScopeLock Lock(&StatsLock);
+            ProgramStats[Pending.ProgramIndex].FramesSent++;
+        }
+
+        if (bConnected && FPlatformTime::Seconds() - LastStatsTime >= 1.0)
+        {
+            UpdateStats();
+
+            // 송신이 없어도 피어 종료를 감지
+            if (!SRTSocket.IsConnected())
+            {
+                UE_LOG(LogCineSRTStream, Warning, TEXT("SharedOutput: Connection to %s lost"), *Key);
+                Disconnect();
+                bReconnecting = Config.bAutoReconnect;
+                if (!Config.bAutoReconnect)
+                {
+                    bShouldExit = true;
+                }
+            }
+        }
+    }
+
+    Disconnect();
+    bReconnecting = false;
+    return 0;
+}
+
+bool FSRTSharedOutput::Connect(const FString& Key)
+{
+    // 재연결 시도 중에는 백오프 간격이 길어지지 않도록 연결 타임아웃을 짧게
+    const int ConnectTimeoutMs = (ConnectionEpoch.Load() > 0 || bReconnecting) ? 1000 : 3000;
+    bool bSocketFailed = false;
+    auto CreateSocket = [this, ConnectTimeoutMs, &bSocketFailed]() -> FSRTSocket
+    {
+        FSRTSocket sock = FSRTSocket::Create();
+        if (!sock)
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("SharedOutput: Failed to create SRT socket"));
+            bSocketFailed = true;
+            return sock;
+        }
+
+        if (!SRTNetwork::ApplyLiveStreamOptions(sock, Config.LatencyMs)
+            || !SRTNetwork::ApplyEncryptionOptions(sock, Config.Encryption))
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("SharedOutput: Failed to apply socket options: %s"),
+                UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+            bSocketFailed = true;
+            return FSRTSocket();
+        }
+        sock.SetOption(SRTO_CONNTIMEO, (int32)ConnectTimeoutMs);
+        return sock;
+    };
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("SharedOutput: Connecting to %s..."), *Key);
+    FString Endpoint;
+    FString Error;
+    FSRTSocket sock = SRTNetwork::ConnectHost(Config.StreamIP, Config.StreamPort, CreateSocket, ConnectTimeoutMs,
+        [this]() { return bShouldExit.Load(); }, Endpoint, Error);
+    if (!sock)
+    {
+        if (!bSocketFailed && !bShouldExit)
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("SharedOutput: Connection failed: %s"), *Error);
+        }
+        return false;
+    }
+
+    SRTSocket = MoveTemp(sock);
+    SourceClock.Reset(SRTSocket.Get());
+    bConnected = true;
+    UE_LOG(LogCineSRTStream, Log, TEXT("SharedOutput: Connected to %s (%s)"), *Key, *Endpoint);
+    return true;
+}
+
+void FSRTSharedOutput::Disconnect()
+{
+    bConnected = false;
+    SRTSocket.Close();
+}
+
+void FSRTSharedOutput::DiscardPendingFrames()
+{
+    FPendingFrame Dummy;
+    while (PendingFrames.Dequeue(Dummy))
+    {
+        PendingCount--;
+    }
+}
+
+void FSRTSharedOutput::Stop()
+{
+    bShouldExit = true;
+    if (WorkEvent)
+    {
+        WorkEvent->Trigger();
+    }
+}
+
+bool FSRTSharedOutput::SendPackets(const TArray<uint8>& TSPackets, double CaptureTime)
+{
+    // 프로그램 간 캡처 시각이 섞여도 srctime은 단조 증가로 제한됨 (SourceClock)
+    FSRTSocket::FSendResult Result;
+    const bool bSent = SRTSocket.SendMessages(TSPackets.GetData(), TSPackets.Num(),
+        SourceClock.ToSourceTime(CaptureTime),
+        Config.MessageTTLMs > 0 ? Config.MessageTTLMs : -1,
+        Result);
+
+    MessagesSent += Result.MessagesSent;
+    if (Result.LastMessageNumber >= 0)
+    {
+        LastMessageNumber = Result.LastMessageNumber;
+    }
+    return bSent;
+}
+
+void FSRTSharedOutput::UpdateStats()
+{
+    const double Now = FPlatformTime::Seconds();
+    const double Elapsed = FMath::Max(Now - LastStatsTime, 0.001);
+    LastStatsTime = Now;
+
+    // 프로그램별 누적 바이트 (PES + PMT) 에서 구간 비트레이트 계산
+    FSRTTransportStream::FProgramStats MuxStats[TS_MAX_PROGRAMS];
+    int32 ProgramCount = 0;
+    {
+        FScopeLock Lock(&MuxLock);
+        ProgramCount = FMath::Min(TransportStream.GetProgramCount(), TS_MAX_PROGRAMS);
+        for (int32 i = 0; i < ProgramCount; i++)
+        {
+            TransportStream.GetProgramStats(i, MuxStats[i]);
+        }
+    }
+
+    {
+        FScopeLock Lock(&StatsLock);
+        for (int32 i = 0; i < ProgramCount; i++)
+        {
+            const int64 Delta = MuxStats[i].ByteCount - IntervalBytes[i];
+            IntervalBytes[i] = MuxStats[i].ByteCount;
+            ProgramStats[i].BytesSent = MuxStats[i].ByteCount;
+            ProgramStats[i].BitrateKbps = (float)(FMath::Max<int64>(Delta, 0) * 8.0 / Elapsed / 1000.0);
+            ProgramStats[i].CaptureSEIMicroseconds = MuxStats[i].CaptureSEICount > 0
+                ? (float)(MuxStats[i].CaptureSEICycles * FPlatformTime::GetSecondsPerCycle64() * 1000000.0 / MuxStats[i].CaptureSEICount)
+                : 0.0f;
+        }
+    }
+
+    SRTNetwork::Stats stats;
+    if (SRTNetwork::GetStats(SRTSocket.Get(), stats))
+    {
+        RTTMs = (float)stats.msRTT;
+        KeyMaterialState = SRTNetwork::GetKeyMaterialState(SRTSocket.Get());
+    }
+}
@@ -1,120 +1,362 @@
 // SRTStreamComponent.cpp - SRT 직접 사용 완전 제거
 #include "SRTStreamComponent.h"
+#include "SRTStreamSubsystem.h"
 #include "CineSRTStream.h"
 #include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
 #include "RenderingThread.h"
 #include "RenderTargetPool.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
 #include "RHICommandList.h"
+#include "RHIGPUReadback.h"
 #include "TextureResource.h"
 #include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformFilemanager.h"
 
-// SRT 네트워크 헤더만 포함 (srt.h 없음!)
+// SRT 소켓 (FSRTSocket) + 연결/통계 헬퍼
 #include "SRTNetworkWorker.h"
 
 // Phase 3: 새로운 인코더 및 멀티플렉서
 #include "SRTVideoEncoder.h"
 #include "SRTTransportStream.h"
+#include "SRTYUVConvertShader.h"
 
 #ifdef _WIN32
     #include <string>
     #include <memory>
 #endif
 
-// ================================================================================
-// FrameBuffer Implementation
-// ================================================================================
-
-void FrameBuffer::SetFrame(Frame&& frame)
-{
-    FScopeLock Lock(&Mutex);
-    CurrentFrame = MoveTemp(frame);
-    bNewFrameReady = true;
-}
-
-bool FrameBuffer::GetFrame(Frame& OutFrame)
-{
-    FScopeLock Lock(&Mutex);
-    if (bNewFrameReady)
-    {
-        OutFrame = MoveTemp(CurrentFrame);
-        bNewFrameReady = false;
-        return true;
-    }
-    return false;
-}
+static TAutoConsoleVariable<float> CVarSimulateEncoderSlowdown(
+    TEXT("CineSRT.SimulateEncoderSlowdown"),
+    1.0f,
+    TEXT("Multiplies every SRT stream's encode time by this factor by sleeping after each frame (1 = off). Simulates a CPU-starved encoder for overload governor tests"),
+    ECVF_Default);
 
-void FrameBuffer::Clear()
-{
-    FScopeLock Lock(&Mutex);
-    CurrentFrame.Data.Empty();
-    bNewFrameReady = false;
-}
-
-bool FrameBuffer::HasNewFrame() const
-{
-    return bNewFrameReady.Load();
-}
+static TAutoConsoleVariable<int32> CVarVerifyGPUYUV(
+    TEXT("CineSRT.VerifyGPUYUV"),
+    0,
+    TEXT("Every N-th GPU-converted NV12/I420 capture also reads back BGRA and compares it with the CPU reference conversion (0 = off)"),
+    ECVF_Default);
 
 // ================================================================================
 // FGPUReadbackManager Implementation
 // ================================================================================
 
 FGPUReadbackManager::FGPUReadbackManager(TSharedPtr<FrameBuffer> InFrameBuffer)
-    : MyFrameBuffer(InFrameBuffer)
+    : FSRTFrameSource(InFrameBuffer)
 {
 }
 
-void FGPUReadbackManager::RequestReadback(UTextureRenderTarget2D* RenderTarget, uint32 FrameNumber)
+FGPUReadbackManager::~FGPUReadbackManager() = default;
+
+bool FGPUReadbackManager::PrepareReadback(UTextureRenderTarget2D* RenderTarget, uint32 FrameNumber, FReadbackRequest& OutRequest)
 {
-    if (!RenderTarget || bShuttingDown.Load()) return;
+    if (!RenderTarget || IsShuttingDown()) return false;
 
     // 반드시 GameThread에서 호출!
     FTextureRenderTargetResource* Resource = RenderTarget->GameThread_GetRenderTargetResource();
-    if (!Resource) return;
-    int32 Width = RenderTarget->SizeX;
-    int32 Height = RenderTarget->SizeY;
+    if (!Resource) return false;
+    
+    OutRequest.Manager = StaticCastSharedRef<FGPUReadbackManager>(AsShared());
+    OutRequest.Resource = Resource;
+    OutRequest.FrameNumber = FrameNumber;
+    OutRequest.Width = RenderTarget->SizeX;
+    OutRequest.Height = RenderTarget->SizeY;
+    OutRequest.SourceRect = FIntRect(0, 0, RenderTarget->SizeX, RenderTarget->SizeY);
+    // 4:2:0은 짝수 크기만 - 홀수면 이번 프레임은 BGRA로 읽어 인코더가 변환
+    OutRequest.Format = ((RenderTarget->SizeX | RenderTarget->SizeY) & 1) ? EVideoPixelFormat::BGRA : OutputFormat;
+    OutRequest.Color = OutputColor;
+    
+    // 캡처 시각은 리드백 완료가 아니라 요청 시점 (수신 측 지연이 캡처 기준이 되도록)
+    OutRequest.CaptureTime = FPlatformTime::Seconds();
+    
+    OutRequest.Trace = BeginTrace();
+    return true;
+}
 
+void FGPUReadbackManager::SubmitReadbacks(TArray<FReadbackRequest>&& Requests)
+{
+    if (Requests.Num() == 0) return;
+
+    // 이번 틱의 CaptureScene이 모두 먼저 큐에 들어가 있으므로 GPU 동기화 대기는 첫 리드백에서 한 번
     ENQUEUE_RENDER_COMMAND(AsyncReadSurfaceCommand)(
-        [this, Resource, FrameNumber, Width, Height](FRHICommandListImmediate& RHICmdList)
+        [Requests = MoveTemp(Requests)](FRHICommandListImmediate& RHICmdList) mutable
         {
-            FRHITexture* Texture = Resource->GetRenderTargetTexture();
-            FReadSurfaceDataFlags Flags(RCM_UNorm, CubeFace_MAX);
-            Flags.SetLinearToGamma(false);
+            SRT_TRACE_SCOPE(CineSRT_Readback);
+            TArray<FReadbackRequest*> YUVRequests;
+            int32 First = 0;
+            while (First < Requests.Num())
+            {
+                // 같은 텍스처를 쓰는 연속 요청 (배치 캡처 아틀라스) - 타일을 모두 덮는 영역을 한 번만 읽음
+                // GPU에서 YUV로 변환하는 요청은 따로 모아 ReadbackYUV
+                FTextureRenderTargetResource* Resource = Requests[First].Resource;
+                FIntRect ReadRect;
+                bool bAnyActive = false;
+                int32 End = First;
+                for (; End < Requests.Num() && Requests[End].Resource == Resource; End++)
+                {
+                    FReadbackRequest& Request = Requests[End];
+                    if (Request.Manager->IsShuttingDown())
+                        continue;
+                    if (Request.Format != EVideoPixelFormat::BGRA)
+                    {
+                        YUVRequests.Add(&Request);
+                        continue;
+                    }
+                    ReadRect = bAnyActive ? ReadRect : Request.SourceRect;
+                    ReadRect.Union(Request.SourceRect);
+                    bAnyActive = true;
+                }
+                
+                if (bAnyActive)
+                {
+                    for (int32 i = First; i < End; i++)
+                    {
+                        if (Requests[i].Format == EVideoPixelFormat::BGRA)
+                        {
+                            SRT_TRACE_STAGE(Requests[i].Trace, ReadbackBegin);
+                        }
+                    }
+                    
+                    FRHITexture* Texture = Resource->GetRenderTargetTexture();
+                    FReadSurfaceDataFlags Flags(RCM_UNorm, CubeFace_MAX);
+                    Flags.SetLinearToGamma(false);
 
-            TArray<FColor>* PixelData = new TArray<FColor>();
+                    TSharedPtr<TArray<FColor>, ESPMode::ThreadSafe> PixelData = MakeShared<TArray<FColor>, ESPMode::ThreadSafe>();
+                    RHICmdList.ReadSurfaceData(
+                        Texture,
+                        ReadRect,
+                        *PixelData,
+                        Flags
+                    );
 
-            RHICmdList.ReadSurfaceData(
-                Texture,
-                FIntRect(0, 0, Width, Height),
-                *PixelData,
-                Flags
-            );
+                    for (int32 i = First; i < End; i++)
+                    {
+                        FReadbackRequest& Request = Requests[i];
+                        if (Request.Manager->IsShuttingDown() || Request.Format != EVideoPixelFormat::BGRA)
+                            continue;
+                        SRT_TRACE_STAGE(Request.Trace, ReadbackEnd);
 
-            AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, PixelData, FrameNumber, Width, Height]()
-            {
-                FrameBuffer::Frame Frame;
-                Frame.FrameNumber = FrameNumber;
-                Frame.Timestamp = FPlatformTime::Seconds();
-                Frame.Width = Width;
-                Frame.Height = Height;
-                Frame.Data.SetNum(PixelData->Num() * sizeof(FColor));
-                FMemory::Memcpy(Frame.Data.GetData(), PixelData->GetData(), Frame.Data.Num());
-
-                if (MyFrameBuffer) {
-                    MyFrameBuffer->SetFrame(MoveTemp(Frame));
-                }
+                        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+                            [Request = MoveTemp(Request), PixelData, ReadRect]() mutable
+                        {
+                            SRT_TRACE_SCOPE(CineSRT_CopyTask);
+                            SRT_TRACE_STAGE(Request.Trace, CopyBegin);
+                            const int32 Stride = ReadRect.Width();
+                            const FIntPoint Offset = Request.SourceRect.Min - ReadRect.Min;
+                            if (PixelData->Num() < Stride * ReadRect.Height())
+                                return;
+                            
+                            FrameBuffer::Frame Frame;
+                            Frame.FrameNumber = Request.FrameNumber;
+                            Frame.Timestamp = Request.CaptureTime;
+                            Frame.Width = Request.Width;
+                            Frame.Height = Request.Height;
+                            Frame.Data.SetNum(Request.Width * Request.Height * sizeof(FColor));
+                            if (Offset == FIntPoint::ZeroValue && Stride == Request.Width)
+                            {
+                                FMemory::Memcpy(Frame.Data.GetData(), PixelData->GetData(), Frame.Data.Num());
+                            }
+                            else
+                            {
+                                // 아틀라스 타일 - 행 단위 복사
+                                const int32 RowBytes = Request.Width * sizeof(FColor);
+                                for (int32 Y = 0; Y < Request.Height; Y++)
+                                {
+                                    FMemory::Memcpy(
+                                        Frame.Data.GetData() + Y * RowBytes,
+                                        PixelData->GetData() + (Offset.Y + Y) * Stride + Offset.X,
+                                        RowBytes);
+                                }
+                            }
+                            SRT_TRACE_STAGE(Request.Trace, CopyEnd);
+                            Frame.Trace = Request.Trace;
 
-                delete PixelData;
-            });
+                            Request.Manager->Deliver(MoveTemp(Frame));
+                        });
+                    }
+                }
+                First = End;
+            }
+            
+            if (YUVRequests.Num() > 0)
+            {
+                ReadbackYUV(RHICmdList, YUVRequests);
+            }
         }
     );
 }
 
-void FGPUReadbackManager::Shutdown()
+void FGPUReadbackManager::ReadbackYUV(FRHICommandListImmediate& RHICmdList, TArray<FReadbackRequest*>& Requests)
+{
+    SRT_TRACE_SCOPE(CineSRT_ReadbackYUV);
+    
+    // 이전 틱들에 넣은 복사 중 끝난 것부터 전달 - 이번 배치가 들어갈 자리가 없을 때만 오래된 복사를 기다림
+    {
+        TMap<FGPUReadbackManager*, int32> SlotsNeeded;
+        for (FReadbackRequest* Request : Requests)
+        {
+            SlotsNeeded.FindOrAdd(Request->Manager.Get())++;
+        }
+        for (const TPair<FGPUReadbackManager*, int32>& Pair : SlotsNeeded)
+        {
+            Pair.Key->DeliverYUVReadbacks(RHICmdList, Pair.Value);
+        }
+    }
+    
+    // 검증: 같은 영역을 BGRA로도 읽어 CPU 참조 변환과 비교 (셰이더와 같은 식이라 ±1 안이어야 함)
+    // 전달 시점에는 렌더 타깃이 다음 캡처로 바뀌어 있으므로 요청 시점에 읽음 (디버그 전용 - 이 프레임만 동기)
+    TArray<TSharedPtr<TArray<FColor>, ESPMode::ThreadSafe>> VerifyPixels;
+    VerifyPixels.SetNum(Requests.Num());
+    const int32 VerifyInterval = CVarVerifyGPUYUV.GetValueOnRenderThread();
+    if (VerifyInterval > 0)
+    {
+        for (int32 i = 0; i < Requests.Num(); i++)
+        {
+            const FReadbackRequest& Request = *Requests[i];
+            if (Request.FrameNumber % VerifyInterval != 0)
+                continue;
+            VerifyPixels[i] = MakeShared<TArray<FColor>, ESPMode::ThreadSafe>();
+            FReadSurfaceDataFlags Flags(RCM_UNorm, CubeFace_MAX);
+            Flags.SetLinearToGamma(false);
+            RHICmdList.ReadSurfaceData(Request.Resource->GetRenderTargetTexture(), Request.SourceRect, *VerifyPixels[i], Flags);
+        }
+    }
+    
+    // 변환 → 스테이징 복사를 그래프 하나로 (아틀라스는 한 번만 등록), 프레임마다 스테이징 버퍼 하나
+    FRDGBuilder GraphBuilder(RHICmdList);
+    TMap<FTextureRenderTargetResource*, FRDGTextureRef> Inputs;
+    for (int32 i = 0; i < Requests.Num(); i++)
+    {
+        FReadbackRequest& Request = *Requests[i];
+        SRT_TRACE_STAGE(Request.Trace, ReadbackBegin);
+        
+        FRDGTextureRef& Input = Inputs.FindOrAdd(Request.Resource);
+        if (!Input)
+        {
+            Input = GraphBuilder.RegisterExternalTexture(
+                CreateRenderTarget(Request.Resource->GetRenderTargetTexture(), TEXT("SRTCaptureTarget")));
+        }
+        
+        FVector4f YCoefficients, UCoefficients, VCoefficients;
+        Request.Color.GetCoefficients(YCoefficients, UCoefficients, VCoefficients);
+        FRDGTextureRef Planes = Request.Format == EVideoPixelFormat::BGRA ? nullptr
+            : SRTYUV::AddConvertPass(GraphBuilder, Input, Request.SourceRect, Request.Format == EVideoPixelFormat::I420,
+                                     YCoefficients, UCoefficients, VCoefficients);
+        if (!Planes)
+            continue;
+        
+        FGPUReadbackManager& Manager = *Request.Manager;
+        TUniquePtr<FRHIGPUTextureReadback> Readback = Manager.YUVReadbackPool.Num() > 0
+            ? Manager.YUVReadbackPool.Pop(EAllowShrinking::No)
+            : MakeUnique<FRHIGPUTextureReadback>(TEXT("SRTYUVReadback"));
+        AddEnqueueCopyPass(GraphBuilder, Readback.Get(), Planes);
+        
+        FPendingYUVReadback& Pending = Manager.YUVInFlight.AddDefaulted_GetRef();
+        Pending.Readback = MoveTemp(Readback);
+        Pending.Request = MoveTemp(Request);
+        Pending.Request.Manager.Reset();
+        Pending.VerifyPixels = MoveTemp(VerifyPixels[i]);
+    }
+    GraphBuilder.Execute();
+}
+
+void FGPUReadbackManager::DeliverYUVReadbacks(FRHICommandListImmediate& RHICmdList, int32 SlotsNeeded)
 {
-    bShuttingDown.Store(true);
+    if (IsShuttingDown())
+    {
+        for (FPendingYUVReadback& Pending : YUVInFlight)
+        {
+            YUVReadbackPool.Add(MoveTemp(Pending.Readback));
+        }
+        YUVInFlight.Reset();
+        return;
+    }
+    
+    const int32 MaxPending = MaxYUVInFlight - FMath::Min(SlotsNeeded, MaxYUVInFlight);
+    bool bFlushed = false;
+    while (YUVInFlight.Num() > 0)
+    {
+        FPendingYUVReadback& Pending = YUVInFlight[0];
+        if (!Pending.Readback->IsReady())
+        {
+            if (YUVInFlight.Num() <= MaxPending)
+                break;
+            
+            // 자리가 모자람 - GPU 전체가 아니라 가장 오래된 복사의 펜스만 기다림
+            if (!bFlushed)
+            {
+                RHICmdList.ImmediateFlush(EImmediateFlushType::FlushRHIThread);
+                bFlushed = true;
+            }
+            FPlatformProcess::SleepNoStats(0.0001f);
+            continue;
+        }
+        
+        FReadbackRequest& Request = Pending.Request;
+        SRT_TRACE_STAGE(Request.Trace, ReadbackEnd);
+        
+        // 스테이징 버퍼는 렌더 스레드에서만 매핑 가능 - 행 간격을 빼고 바로 프레임으로 (1.5바이트/픽셀)
+        SRT_TRACE_STAGE(Request.Trace, CopyBegin);
+        const FIntPoint PlaneSize = SRTYUV::GetPlaneTextureSize(Request.Width, Request.Height);
+        int32 RowPitch = 0;
+        const uint8* Mapped = static_cast<const uint8*>(Pending.Readback->Lock(RowPitch));
+        if (Mapped)
+        {
+            FrameBuffer::Frame Frame;
+            Frame.FrameNumber = Request.FrameNumber;
+            Frame.Timestamp = Request.CaptureTime;
+            Frame.Width = Request.Width;
+            Frame.Height = Request.Height;
+            Frame.Format = Request.Format;
+            Frame.Data.SetNumUninitialized(PlaneSize.X * PlaneSize.Y);
+            for (int32 Y = 0; Y < PlaneSize.Y; Y++)
+            {
+                FMemory::Memcpy(Frame.Data.GetData() + Y * PlaneSize.X, Mapped + Y * RowPitch, PlaneSize.X);
+            }
+            Pending.Readback->Unlock();
+            SRT_TRACE_STAGE(Request.Trace, CopyEnd);
+            Frame.Trace = Request.Trace;
+            
+            AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+                [Manager = StaticCastSharedRef<FGPUReadbackManager>(AsShared()), Color = Request.Color,
+                 Frame = MoveTemp(Frame), VerifyPixels = MoveTemp(Pending.VerifyPixels)]() mutable
+            {
+                if (VerifyPixels.IsValid() && VerifyPixels->Num() == Frame.Width * Frame.Height)
+                {
+                    TArray<uint8> Reference;
+                    Reference.SetNumUninitialized(Frame.Data.Num());
+                    SRTYUV::ConvertBGRA((const uint8*)VerifyPixels->GetData(), Frame.Width, Frame.Width, Frame.Height,
+                                        Frame.Format, Color, Reference.GetData());
+                    int32 MaxDiff = 0;
+                    int32 Mismatched = 0;
+                    for (int32 i = 0; i < Reference.Num(); i++)
+                    {
+                        const int32 Diff = FMath::Abs((int32)Reference[i] - (int32)Frame.Data[i]);
+                        MaxDiff = FMath::Max(MaxDiff, Diff);
+                        Mismatched += Diff > 1 ? 1 : 0;
+                    }
+                    if (Mismatched > 0)
+                    {
+                        UE_LOG(LogCineSRTStream, Warning, TEXT("GPU %s (%s) frame #%u differs from CPU reference: max diff %d, %d of %d bytes off by more than 1"),
+                            SRTYUV::GetFormatName(Frame.Format), Color.ToString(), Frame.FrameNumber, MaxDiff, Mismatched, Reference.Num());
+                    }
+                    else
+                    {
+                        UE_LOG(LogCineSRTStream, Log, TEXT("GPU %s (%s) frame #%u matches CPU reference (max diff %d)"),
+                            SRTYUV::GetFormatName(Frame.Format), Color.ToString(), Frame.FrameNumber, MaxDiff);
+                    }
+                }
+                
+                Manager->Deliver(MoveTemp(Frame));
+            });
+        }
+        
+        YUVReadbackPool.Add(MoveTemp(Pending.Readback));
+        YUVInFlight.RemoveAt(0, 1, EAllowShrinking::No);
+    }
 }
 
 // ================================================================================
@@ -150,6 +392,12 @@ USRTStreamComponent::~USRTStreamComponent()
             StreamWorker->Stop();
         }
         
+        // 풀 워커가 이 워커로 인코딩 중이면 끝날 때까지 대기
+        if (EncodePool.IsValid())
+        {
+            EncodePool->RemoveStream(EncodePoolHandle);
+        }
+        
         if (WorkerThread)
         {
             WorkerThread->Kill(true);  // 강제 종료
@@ -158,6 +406,7 @@ USRTStreamComponent::~USRTStreamComponent()
         }
         
         StreamWorker.Reset();
+        EncodePool.Reset();
     }
 }
 
@@ -194,6 +443,12 @@ void USRTStreamComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
+    if (!bIsStreaming)
+        return;
+    
+    // 워커가 보낸 상태 변경/로그 (서브시스템 틱에서도 처리 - 둘 다 게임 스레드)
+    // OnStateChanged 핸들러가 스트리밍을 멈췄을 수 있음
+    ProcessWorkerEvents();
     if (!bIsStreaming)
         return;
     
@@ -205,9 +460,13 @@ void USRTStreamComponent::TickComponent(float DeltaTime, ELevelTick TickType,
         LastStatsUpdateTime = CurrentTime;
     }
     
-    // Capture frame at target FPS
-    static double LastCaptureTime = 0.0;
-    double FrameInterval = 1.0 / StreamFPS;
+    // 서브시스템이 있으면 다른 스트림과 묶어서 캡처 (USRTStreamSubsystem::Tick)
+    if (StreamSubsystem.IsValid())
+        return;
+    
+    // Capture frame at target FPS (과부하 조정 단계의 프레임 속도)
+    ApplyOverloadLevel();
+    double FrameInterval = 1.0 / CaptureFPS;
     
     if (CurrentTime - LastCaptureTime >= FrameInterval)
     {
@@ -311,14 +570,9 @@ void USRTStreamComponent::SetBitrateRuntime(int32 NewBitrate)
     if (VideoEncoder)
     {
         VideoEncoder->SetBitrate(BitrateKbps);
-        UE_LOG(LogCineSRTStream, Log, TEXT("Runtime bitrate changed to %d kbps"), BitrateKbps);
         
-        // UI 알림
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, 
-                FString::Printf(TEXT("Bitrate: %d kbps"), BitrateKbps));
-        }
+        // 비트레이트 조정 로직이 매 프레임 부를 수 있으므로 알림은 틱에서 한 번 (ProcessWorkerEvents)
+        bBitrateChangePending = true;
     }
 }
 
@@ -347,7 +601,7 @@ void USRTStreamComponent::ForceKeyFrame()
     if (bIsStreaming && VideoEncoder)
     {
         VideoEncoder->ForceKeyFrame();
-        UE_LOG(LogCineSRTStream, Log, TEXT("Forced keyframe"));
+        PendingForcedKeyFrames++;
     }
 }
 
@@ -370,6 +624,92 @@ void USRTStreamComponent::ApplyRuntimeSettings()
     }
 }
 
+FSRTTransportStream::EMetadataFormat USRTStreamComponent::GetTSMetadataFormat() const
+{
+    switch (TimedMetadataFormat)
+    {
+        case ESRTTimedMetadataFormat::ID3:
+            return FSRTTransportStream::EMetadataFormat::ID3;
+        case ESRTTimedMetadataFormat::KLV:
+            return FSRTTransportStream::EMetadataFormat::KLV;
+        default:
+            return FSRTTransportStream::EMetadataFormat::None;
+    }
+}
+
+int64 USRTStreamComponent::GetFramePTS(int32 FramesAhead) const
+{
+    if (!VideoEncoder || !VideoEncoder->IsInitialized())
+        return 0;
+    
+    // 인코더 프레임 번호 = 다음에 인코딩될 프레임
+    return VideoEncoder->GetFramePTS(VideoEncoder->GetNextFrameIndex() + FMath::Max(FramesAhead, 0));
+}
+
+bool USRTStreamComponent::ScheduleSplice(const FSRTTransportStream::FSpliceEvent& Event)
+{
+    if (!bIsStreaming)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("Cannot schedule SCTE-35 event - not streaming"));
+        return false;
+    }
+    
+    if (SharedOutput.IsValid())
+    {
+        return SharedOutput->ScheduleSpliceEvent(SharedProgramIndex, Event);
+    }
+    return TransportStream && TransportStream->ScheduleSpliceEvent(0, Event);
+}
+
+bool USRTStreamComponent::ScheduleSpliceInsert(int64 FramePTS, int32 EventID, bool bOutOfNetwork, float BreakDurationSec)
+{
+    FSRTTransportStream::FSpliceEvent Event;
+    Event.PTS = FramePTS;
+    Event.EventID = (uint32)EventID;
+    Event.bOutOfNetwork = bOutOfNetwork;
+    Event.BreakDuration = (int64)(FMath::Max(BreakDurationSec, 0.0f) * 90000.0);
+    
+    if (!ScheduleSplice(Event))
+        return false;
+    
+    UE_LOG(LogCineSRTStream, Log, TEXT("SCTE-35 splice_insert %d scheduled at PTS %lld (%s, %.1fs)"),
+        EventID, FramePTS, bOutOfNetwork ? TEXT("out") : TEXT("in"), BreakDurationSec);
+    return true;
+}
+
+bool USRTStreamComponent::ScheduleTimeSignal(int64 FramePTS)
+{
+    FSRTTransportStream::FSpliceEvent Event;
+    Event.PTS = FramePTS;
+    Event.bTimeSignal = true;
+    return ScheduleSplice(Event);
+}
+
+bool USRTStreamComponent::ScheduleTimedMetadata(int64 FramePTS, const TArray<uint8>& Payload)
+{
+    if (!bIsStreaming)
+        return false;
+    
+    if (SharedOutput.IsValid())
+    {
+        return SharedOutput->ScheduleMetadata(SharedProgramIndex, FramePTS, Payload);
+    }
+    return TransportStream && TransportStream->ScheduleMetadata(0, FramePTS, Payload);
+}
+
+bool USRTStreamComponent::ScheduleID3Text(int64 FramePTS, const FString& Description, const FString& Value)
+{
+    if (TimedMetadataFormat != ESRTTimedMetadataFormat::ID3)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("ScheduleID3Text requires TimedMetadataFormat = ID3"));
+        return false;
+    }
+    
+    TArray<uint8> Tag;
+    FSRTTransportStream::BuildID3TextTag(Description, Value, Tag);
+    return ScheduleTimedMetadata(FramePTS, Tag);
+}
+
 void USRTStreamComponent::ApplyGamingPreset()
 {
     // 게임 스트리밍에 최적화
@@ -447,6 +787,12 @@ void USRTStreamComponent::StartStreaming()
     {
         UE_LOG(LogCineSRTStream, Warning, TEXT("Previous resources detected, cleaning..."));
         
+        if (EncodePool.IsValid())
+        {
+            EncodePool->RemoveStream(EncodePoolHandle);
+            EncodePoolHandle = INDEX_NONE;
+        }
+        
         if (WorkerThread)
         {
             WorkerThread->Kill(true);
@@ -469,10 +815,11 @@ void USRTStreamComponent::StartStreaming()
         FrameBuffer->Clear();
     }
     
-    if (!GPUReadbackManager)
-    {
-        GPUReadbackManager = MakeShared<FGPUReadbackManager>(FrameBuffer);
-    }
+    // 세션마다 새 공급원 - 이전 세션의 Shutdown 상태와 늦게 끝나는 복사 태스크에서 분리
+    if (!CreateFrameSource())
+        return;
+    ActiveFrameSource->SetTraceStreamId(FSRTFrameTraceRecorder::Get().RegisterStream(
+        GetOwner() ? GetOwner()->GetName() + TEXT(".") + GetName() : GetName()));
     
     UE_LOG(LogCineSRTStream, Log, TEXT("=== Starting SRT Stream ==="));
     // 시스템 정보 출력 및 호환성 체크
@@ -493,8 +840,80 @@ void USRTStreamComponent::StartStreaming()
     UE_LOG(LogCineSRTStream, Log, TEXT("Target: %s:%d"), *StreamIP, StreamPort);
     UE_LOG(LogCineSRTStream, Log, TEXT("Mode: Caller (Client)"));
     
+    // 암호화 옵션은 여기서 한 번만 검증/변환 - 연결, 재연결, 공유 출력, 리스너 소켓이 모두 이 값을 그대로 적용
+    Encryption = SRTNetwork::EncryptionOptions();
+    Encryption.bEnforced = bEnforceEncryption;
+    if (bUseEncryption)
+    {
+        FString EncryptionError;
+        const int CryptoMode = (EncryptionCipher == ESRTCipherMode::AES_GCM)
+            ? SRTNetwork::CRYPTOMODE_AES_GCM : SRTNetwork::CRYPTOMODE_AUTO;
+        if (!SRTNetwork::MakeEncryptionOptions(EncryptionPassphrase, (int)EncryptionKeyLength, CryptoMode,
+                                               bEnforceEncryption, Encryption, EncryptionError))
+        {
+            SetConnectionState(ESRTConnectionState::Error, FString::Printf(TEXT("Encryption: %s"), *EncryptionError));
+            return;
+        }
+        UE_LOG(LogCineSRTStream, Log, TEXT("Encryption: AES-%d %s%s"), (int)EncryptionKeyLength * 8,
+            CryptoMode == SRTNetwork::CRYPTOMODE_AES_GCM ? TEXT("GCM") : TEXT("CTR"),
+            bEnforceEncryption ? TEXT(" (enforced)") : TEXT(""));
+    }
+    
+    // 본딩은 이 컴포넌트가 직접 여는 Caller 연결에만 (공유 출력/리스너는 소켓 하나)
+    if (BondingMode != ESRTBondingMode::None)
+    {
+        if (ConnectionMode != ESRTConnectionMode::Caller || bUseSharedConnection)
+        {
+            SetConnectionState(ESRTConnectionState::Error, TEXT("Bonding requires Caller mode without shared connection"));
+            return;
+        }
+        if (BondingLinks.Num() == 0)
+        {
+            SetConnectionState(ESRTConnectionState::Error, TEXT("Bonding enabled but no links configured"));
+            return;
+        }
+        UE_LOG(LogCineSRTStream, Log, TEXT("Bonding: %s, %d links"),
+            BondingMode == ESRTBondingMode::MainBackup ? TEXT("Main/Backup") : TEXT("Broadcast"), BondingLinks.Num());
+        for (int32 i = 0; i < BondingLinks.Num(); i++)
+        {
+            const FSRTBondingLink& Link = BondingLinks[i];
+            UE_LOG(LogCineSRTStream, Log, TEXT("  Link %d: %s:%d -> %s:%d (weight %d)"), i,
+                Link.LocalAddress.IsEmpty() ? TEXT("*") : *Link.LocalAddress, Link.LocalPort,
+                *Link.RemoteAddress, Link.RemotePort, Link.Weight);
+        }
+    }
+    
     SetConnectionState(ESRTConnectionState::Connecting, TEXT("Initializing capture..."));
     
+    // 월드 서브시스템: 캡처를 다른 스트림과 묶고, 인코딩은 공유 풀에서 (CineSRT.EncodePool 0이면 워커가 직접)
+    UWorld* World = GetWorld();
+    USRTStreamSubsystem* Subsystem = World ? World->GetSubsystem<USRTStreamSubsystem>() : nullptr;
+    EncodePool = Subsystem ? Subsystem->AcquireEncodePool() : nullptr;
+    
+    // 공유 출력에 프로그램을 등록한 뒤의 실패 - bIsStreaming이 false라 StopStreaming이 정리하지 않으므로 여기서 되돌림
+    // 이미 시작한 로컬 기록도 함께 (공유 출력 기록은 이번 시작이 연 경우에만 닫음)
+    bool bStartedSharedRecording = false;
+    auto AbortStart = [this, &bStartedSharedRecording](const FString& Reason)
+    {
+        if (RecordingTap.IsValid())
+        {
+            RecordingTap->Shutdown();
+            RecordingTap.Reset();
+        }
+        
+        if (SharedOutput.IsValid())
+        {
+            if (bStartedSharedRecording)
+            {
+                SharedOutput->StopRecording();
+            }
+            SharedOutput->UnregisterProgram(SharedProgramIndex);
+            SharedOutput.Reset();
+            SharedProgramIndex = INDEX_NONE;
+        }
+        SetConnectionState(ESRTConnectionState::Error, Reason);
+    };
+    
     // Phase 3: 비디오 인코더 설정 부분 수정
     if (VideoEncoder && TransportStream)
     {
@@ -504,6 +923,8 @@ void USRTStreamComponent::StartStreaming()
         EncoderConfig.BitrateKbps = BitrateKbps;
         EncoderConfig.GOPSize = 60;
         EncoderConfig.bUseHardwareAcceleration = bUseHardwareAcceleration;
+        EncoderConfig.VideoCodec = (VideoCodec == ESRTVideoCodec::HEVC) ? EVideoCodec::HEVC : EVideoCodec::H264;
+        EncoderConfig.Color = GetYUVColorParams();
         
         // 품질 프리셋 적용
         switch (QualityPreset)
@@ -533,40 +954,136 @@ void USRTStreamComponent::StartStreaming()
         EncoderConfig.BufferSizeKb = BitrateKbps / 2;
         EncoderConfig.Tune = TEXT("zerolatency");
         
+        // 풀을 쓰면 동시에 도는 인코더 수가 워커 수로 제한되므로 스레드는 코어를 워커 수로 나눈 만큼
+        if (EncodePool.IsValid())
+        {
+            EncoderConfig.ThreadCount = Subsystem->GetEncoderThreadsPerStream();
+        }
+        
         if (!VideoEncoder->Initialize(EncoderConfig))
         {
             SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to initialize video encoder"));
             return;
         }
         
+        // PMT stream_type은 요청한 코덱이 아니라 실제로 열린 코덱 기준
+        const uint8 VideoStreamType = (VideoEncoder->GetVideoCodec() == EVideoCodec::HEVC)
+            ? TS_STREAM_TYPE_HEVC : TS_STREAM_TYPE_H264;
+        
+        // 공유 연결: 목적지별 MPTS 출력에 프로그램으로 등록 (PID 자동 할당) - 리스너 모드는 자체 팬아웃
+        if (bUseSharedConnection && ConnectionMode == ESRTConnectionMode::Caller)
+        {
+            FSRTSharedOutput::FConfig SharedConfig;
+            SharedConfig.StreamIP = StreamIP;
+            SharedConfig.StreamPort = StreamPort;
+            SharedConfig.LatencyMs = LatencyMs;
+            SharedConfig.MessageTTLMs = MessageTTLMs;
+            SharedConfig.Encryption = Encryption;
+            SharedConfig.bAutoReconnect = bAutoReconnect;
+            SharedConfig.ReconnectInitialDelayMs = ReconnectInitialDelayMs;
+            SharedConfig.ReconnectMaxDelayMs = ReconnectMaxDelayMs;
+            
+            SharedOutput = FSRTSharedOutput::Acquire(SharedConfig);
+            SharedProgramIndex = SharedOutput.IsValid()
+                ? SharedOutput->RegisterProgram(GetOwner() ? GetOwner()->GetName() : GetName(),
+                                                bEnableSCTE35, GetTSMetadataFormat(), VideoStreamType)
+                : INDEX_NONE;
+            
+            if (SharedProgramIndex == INDEX_NONE)
+            {
+                SharedOutput.Reset();
+                SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to register program on shared output"));
+                return;
+            }
+        }
+        
         // Transport Stream 설정
         FSRTTransportStream::FConfig TSConfig;
         TSConfig.ServiceID = 1;
         TSConfig.VideoPID = 0x0100;
         TSConfig.PCRPID = 0x0100;
+        TSConfig.VideoStreamType = VideoStreamType;
         TSConfig.ServiceName = TEXT("UnrealStream");
         TSConfig.ProviderName = TEXT("CineSRT");
+        TSConfig.bEnableSCTE35 = bEnableSCTE35;
+        TSConfig.MetadataFormat = GetTSMetadataFormat();
         
         if (!TransportStream->Initialize(TSConfig))
         {
-            SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to initialize transport stream"));
+            AbortStart(TEXT("Failed to initialize transport stream"));
             return;
         }
         
+        // 로컬 기록 - 실패해도 스트리밍은 계속
+        if (bRecordLocally)
+        {
+            FSRTRecordingTap::FConfig RecordingConfig;
+            RecordingConfig.OutputDirectory = RecordingDirectory;
+            RecordingConfig.SegmentDurationSec = RecordingSegmentSeconds;
+            
+            bool bRecording = false;
+            if (SharedOutput.IsValid())
+            {
+                RecordingConfig.FilePrefix = FString::Printf(TEXT("MPTS_%s_%d"), *StreamIP.Replace(TEXT("."), TEXT("-")), StreamPort);
+                const bool bWasRecording = SharedOutput->IsRecording();
+                bRecording = SharedOutput->StartRecording(RecordingConfig);
+                bStartedSharedRecording = bRecording && !bWasRecording;
+            }
+            else
+            {
+                RecordingConfig.FilePrefix = GetOwner() ? GetOwner()->GetName() : GetName();
+                RecordingTap = MakeUnique<FSRTRecordingTap>();
+                bRecording = RecordingTap->Start(RecordingConfig);
+                if (!bRecording)
+                {
+                    RecordingTap.Reset();
+                }
+            }
+            
+            if (!bRecording)
+            {
+                UE_LOG(LogCineSRTStream, Warning, TEXT("Local recording could not be started - streaming without it"));
+            }
+        }
+        
         UE_LOG(LogCineSRTStream, Log, TEXT("Phase 3 components initialized: %dx%d, %d fps, %d kbps"),
             EncoderConfig.Width, EncoderConfig.Height, EncoderConfig.FrameRate, EncoderConfig.BitrateKbps);
     }
     
-    // Scene capture 설정
-    if (!SetupSceneCapture())
+    // Scene capture 설정 (패턴/파일 공급원은 카메라가 필요 없음)
+    if (FrameSource == ESRTFrameSourceType::SceneCapture && !SetupSceneCapture())
     {
-        SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to setup scene capture"));
+        AbortStart(TEXT("Failed to setup scene capture"));
         return;
     }
     
+    // 리스너 모드: 수신기 접속을 받는 팬아웃 출력 (구독자가 없어도 스트림은 시작)
+    if (ConnectionMode == ESRTConnectionMode::Listener)
+    {
+        FSRTListenerOutput::FConfig ListenerConfig;
+        ListenerConfig.Port = StreamPort;
+        ListenerConfig.LatencyMs = LatencyMs;
+        ListenerConfig.MessageTTLMs = MessageTTLMs;
+        ListenerConfig.Encryption = Encryption;
+        ListenerConfig.MaxSubscribers = MaxSubscribers;
+        ListenerConfig.MaxQueuedFrames = SubscriberQueueFrames;
+        
+        ListenerOutput = MakeUnique<FSRTListenerOutput>(ListenerConfig);
+        if (!ListenerOutput->Start())
+        {
+            ListenerOutput.Reset();
+            CleanupSceneCapture();
+            AbortStart(FString::Printf(TEXT("Failed to listen on port %d"), StreamPort));
+            return;
+        }
+    }
+    
     // 플래그 초기화
     bStopRequested = false;
     bIsStreaming = true;
+    CaptureFPS = StreamFPS;
+    AppliedOverloadLevel = 0;
+    OverloadLevel = 0;
     
     // 워커 스레드 생성
     StreamWorker = MakeUnique<FSRTStreamWorker>(this);
@@ -577,12 +1094,46 @@ void USRTStreamComponent::StartStreaming()
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to create worker thread"));
         bIsStreaming = false;
         CleanupSceneCapture();
-        SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to create worker thread"));
         StreamWorker.Reset();
+        ListenerOutput.Reset();
+        EncodePool.Reset();
+        AbortStart(TEXT("Failed to create worker thread"));
         return;
     }
     
-    UE_LOG(LogCineSRTStream, Log, TEXT("SRT streaming started"));
+    if (StreamWorker->GetOverloadLevelCount() > 1)
+    {
+        OverloadState = StreamWorker->GetOverloadLevel(0).ToString();
+        UE_LOG(LogCineSRTStream, Log, TEXT("Overload governor: %d levels, %s .. %s"), StreamWorker->GetOverloadLevelCount(),
+            *OverloadState, *StreamWorker->GetOverloadLevel(StreamWorker->GetOverloadLevelCount() - 1).ToString());
+    }
+    
+    // 복사 태스크가 새 프레임을 넣으면 풀에 인코딩 예약 (풀이 먼저 사라지거나 스트림이 빠지면 무시됨)
+    if (EncodePool.IsValid())
+    {
+        FSRTStreamWorker* Worker = StreamWorker.Get();
+        EncodePoolHandle = EncodePool->AddStream([Worker]() { Worker->EncodeFromPool(); });
+        
+        TWeakPtr<FSRTEncodePool> WeakPool = EncodePool;
+        const int32 PoolHandle = EncodePoolHandle;
+        ActiveFrameSource->SetOnFrameReady([WeakPool, PoolHandle]()
+        {
+            if (TSharedPtr<FSRTEncodePool> Pool = WeakPool.Pin())
+            {
+                Pool->Schedule(PoolHandle);
+            }
+        });
+    }
+    
+    LastCaptureTime = 0.0;
+    if (Subsystem)
+    {
+        Subsystem->RegisterStream(this);
+        StreamSubsystem = Subsystem;
+    }
+    
+    UE_LOG(LogCineSRTStream, Log, TEXT("SRT streaming started (%s)"),
+        EncodePool.IsValid() ? TEXT("shared encode pool") : TEXT("per-stream encoding"));
 }
 
 void USRTStreamComponent::StopStreaming()
@@ -599,6 +1150,18 @@ void USRTStreamComponent::StopStreaming()
     
     SetConnectionState(ESRTConnectionState::Disconnected, TEXT("Stopping..."));
     
+    if (USRTStreamSubsystem* Subsystem = StreamSubsystem.Get())
+    {
+        Subsystem->UnregisterStream(this);
+    }
+    StreamSubsystem.Reset();
+    
+    // 풀에서 먼저 빼기 - 실행 중인 인코딩이 끝난 뒤에는 워커를 다시 호출하지 않음
+    if (EncodePool.IsValid())
+    {
+        EncodePool->RemoveStream(EncodePoolHandle);
+    }
+    
     // 워커에게 종료 신호
     if (StreamWorker.IsValid())
     {
@@ -614,12 +1177,17 @@ void USRTStreamComponent::StopStreaming()
         WorkerThread = nullptr;
     }
     
+    // 워커가 마지막에 보낸 로그 (상태 변경은 버림)
+    ProcessWorkerEvents();
+    
     // 리소스 정리
     StreamWorker.Reset();
+    EncodePool.Reset();
+    EncodePoolHandle = INDEX_NONE;
     
-    if (GPUReadbackManager)
+    if (ActiveFrameSource)
     {
-        GPUReadbackManager->Shutdown();
+        ActiveFrameSource->Shutdown();
     }
     
     if (FrameBuffer)
@@ -637,13 +1205,50 @@ void USRTStreamComponent::StopStreaming()
         TransportStream->Shutdown();
     }
     
-    CleanupSceneCapture();
-    
-    // 통계 초기화
-    CurrentBitrateKbps = 0.0f;
-    TotalFramesSent = 0;
-    DroppedFrames = 0;
-    RoundTripTimeMs = 0.0f;
+    if (RecordingTap.IsValid())
+    {
+        RecordingTap->Shutdown();
+        RecordingTap.Reset();
+    }
+    
+    if (SharedOutput.IsValid())
+    {
+        SharedOutput->UnregisterProgram(SharedProgramIndex);
+        SharedOutput.Reset();  // 마지막 참조면 연결과 송신 스레드 종료
+        SharedProgramIndex = INDEX_NONE;
+    }
+    
+    if (ListenerOutput.IsValid())
+    {
+        ListenerOutput->Shutdown();
+        ListenerOutput.Reset();
+    }
+    
+    CleanupSceneCapture();
+    
+    // 통계 초기화 (워커가 끝났으므로 남은 스냅샷을 비움)
+    StatsBuffer.Write(FSRTNetworkStats());
+    StatsBuffer.SwapAndRead();
+    NetworkStats = FSRTNetworkStats();
+    CurrentBitrateKbps = 0.0f;
+    TotalFramesSent = 0;
+    DroppedFrames = 0;
+    RoundTripTimeMs = 0.0f;
+    MessagesSent = 0;
+    LastMessageNumber = -1;
+    BackpressureDrops = 0;
+    ReconnectCount = 0;
+    LastRecoveryTimeMs = 0.0f;
+    SubscriberCount = 0;
+    SubscriberStats.Reset();
+    RecordingDroppedChunks = 0;
+    RecordingSegmentsWritten = 0;
+    EncryptionState.Reset();
+    Encryption = SRTNetwork::EncryptionOptions();
+    BondingMembers.Reset();
+    BondingActiveLinks = 0;
+    OverloadLevel = 0;
+    OverloadState.Reset();
     
     bCleanupInProgress = false;
     SetConnectionState(ESRTConnectionState::Disconnected, TEXT("Stopped"));
@@ -655,20 +1260,46 @@ void USRTStreamComponent::TestConnection()
 {
     UE_LOG(LogCineSRTStream, Log, TEXT("=== Testing SRT Connection ==="));
     
-    void* testSock = SRTNetwork::CreateSocket();
-    if (!testSock)
+    FSRTSocket TestSocket = FSRTSocket::Create();
+    if (!TestSocket)
     {
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to create test socket"));
         return;
     }
     
-    // 암호화 테스트 제거 (변수 없음)
+    // 암호화 설정 검증 - 연결하지 않고 소켓 옵션만 적용해 봄 (GCM 미지원 빌드, 비밀번호 길이 등)
+    if (bUseEncryption)
+    {
+        SRTNetwork::EncryptionOptions TestEncryption;
+        FString EncryptionError;
+        const int CryptoMode = (EncryptionCipher == ESRTCipherMode::AES_GCM)
+            ? SRTNetwork::CRYPTOMODE_AES_GCM : SRTNetwork::CRYPTOMODE_AUTO;
+        if (!SRTNetwork::MakeEncryptionOptions(EncryptionPassphrase, (int)EncryptionKeyLength, CryptoMode,
+                                               bEnforceEncryption, TestEncryption, EncryptionError))
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("❌ Encryption settings invalid: %s"), *EncryptionError);
+        }
+        else if (!SRTNetwork::ApplyEncryptionOptions(TestSocket, TestEncryption))
+        {
+            UE_LOG(LogCineSRTStream, Error, TEXT("❌ Encryption options rejected by SRT: %s"), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        }
+        else
+        {
+            UE_LOG(LogCineSRTStream, Log, TEXT("✅ Encryption options accepted (AES-%d %s)"), (int)EncryptionKeyLength * 8,
+                CryptoMode == SRTNetwork::CRYPTOMODE_AES_GCM ? TEXT("GCM") : TEXT("CTR"));
+        }
+    }
     UE_LOG(LogCineSRTStream, Log, TEXT("✅ Connection test completed"));
     
-    SRTNetwork::CloseSocket(testSock);
+    TestSocket.Close();
     UE_LOG(LogCineSRTStream, Log, TEXT("Test completed"));
 }
 
+FString USRTStreamComponent::DumpFrameTrace(const FString& FilePath)
+{
+    return FSRTFrameTraceRecorder::Get().DumpChromeTrace(FilePath);
+}
+
 void USRTStreamComponent::GetResolution(int32& OutWidth, int32& OutHeight) const
 {
     switch (StreamMode)
@@ -754,51 +1385,229 @@ void USRTStreamComponent::CleanupSceneCapture()
     RenderTarget = nullptr;
 }
 
+bool USRTStreamComponent::CreateFrameSource()
+{
+    GPUReadbackManager = MakeShared<FGPUReadbackManager>(FrameBuffer);
+    
+    int32 Width, Height;
+    GetResolution(Width, Height);
+    
+    switch (FrameSource)
+    {
+        case ESRTFrameSourceType::TestPattern:
+            ActiveFrameSource = MakeShared<FSRTTestPatternSource>(FrameBuffer, TestPattern, Width, Height);
+            break;
+            
+        case ESRTFrameSourceType::File:
+        {
+            TSharedPtr<FSRTFileFrameSource> FileSource = MakeShared<FSRTFileFrameSource>(FrameBuffer, Width, Height);
+            FString Error;
+            if (!FileSource->Open(SourceFilePath, Error))
+            {
+                SetConnectionState(ESRTConnectionState::Error, FString::Printf(TEXT("Frame source: %s"), *Error));
+                return false;
+            }
+            ActiveFrameSource = FileSource;
+            break;
+        }
+        
+        default:
+            ActiveFrameSource = GPUReadbackManager;
+            break;
+    }
+    
+    EVideoPixelFormat Format = EVideoPixelFormat::BGRA;
+    if (CaptureFormat != ESRTCaptureFormat::BGRA)
+    {
+        Format = (CaptureFormat == ESRTCaptureFormat::NV12) ? EVideoPixelFormat::NV12 : EVideoPixelFormat::I420;
+        if (ActiveFrameSource == GPUReadbackManager && !SRTYUV::IsGPUConversionSupported())
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Frame source: GPU YUV conversion not supported on this RHI, capturing BGRA"));
+            Format = EVideoPixelFormat::BGRA;
+        }
+    }
+    ActiveFrameSource->SetOutputFormat(Format, GetYUVColorParams());
+    
+    UE_LOG(LogCineSRTStream, Log, TEXT("Frame source: %s %dx%d %s (%s, %d bytes/frame)"), ActiveFrameSource->GetName(), Width, Height,
+        SRTYUV::GetFormatName(Format), GetYUVColorParams().ToString(), SRTYUV::GetFrameBytes(Format, Width, Height));
+    return true;
+}
+
+FSRTYUVColorParams USRTStreamComponent::GetYUVColorParams() const
+{
+    FSRTYUVColorParams Color;
+    Color.Matrix = (ColorMatrix == ESRTColorMatrix::BT601) ? EVideoColorMatrix::BT601 : EVideoColorMatrix::BT709;
+    Color.bFullRange = bFullRangeColor;
+    return Color;
+}
+
 void USRTStreamComponent::CaptureFrame()
 {
-    // 디버그 카운터 추가
-    static int CaptureCount = 0;
-    CaptureCount++;
+    // 패턴/파일 공급원은 리드백 없이 백그라운드에서 프레임 생성
+    if (ActiveFrameSource && ActiveFrameSource != GPUReadbackManager)
+    {
+        ActiveFrameSource->CaptureFrame(TotalFramesSent);
+        return;
+    }
     
-    if (CaptureCount % 30 == 0) // 1초마다 로그
+    // 서브시스템 없이 혼자 캡처 - 배치 하나짜리
+    FGPUReadbackManager::FReadbackRequest Request;
+    if (PrepareCapture(Request))
     {
-        UE_LOG(LogCineSRTStream, Log, TEXT("CaptureFrame called %d times"), CaptureCount);
+        TArray<FGPUReadbackManager::FReadbackRequest> Batch;
+        Batch.Add(MoveTemp(Request));
+        FGPUReadbackManager::SubmitReadbacks(MoveTemp(Batch));
     }
+}
+
+bool USRTStreamComponent::PrepareCapture(FGPUReadbackManager::FReadbackRequest& OutRequest, bool bCaptureScene)
+{
+    SRT_TRACE_SCOPE(CineSRT_CaptureFrame);
     
     // 컴포넌트 상태 확인
     if (!SceneCapture)
     {
         UE_LOG(LogCineSRTStream, Warning, TEXT("CaptureFrame: SceneCapture is null"));
-        return;
+        return false;
     }
     
     if (!RenderTarget)
     {
         UE_LOG(LogCineSRTStream, Warning, TEXT("CaptureFrame: RenderTarget is null"));
-        return;
+        return false;
     }
     
     // Capture the scene
-    SceneCapture->CaptureScene();
+    if (bCaptureScene)
+    {
+        SceneCapture->CaptureScene();
+    }
     
     // 폴백: 기존 GPU readback 방식
-    if (GPUReadbackManager)
+    if (!GPUReadbackManager)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("CaptureFrame: GPUReadbackManager is null"));
+        return false;
+    }
+    
+    return GPUReadbackManager->PrepareReadback(RenderTarget, TotalFramesSent, OutRequest);
+}
+
+void USRTStreamComponent::UpdateStats()
+{
+    // 워커가 발행한 최신 스냅샷 → Blueprint 노출 값 (게임 스레드에서만 씀)
+    if (StatsBuffer.IsDirty())
+    {
+        NetworkStats = StatsBuffer.SwapAndRead();
+        
+        CurrentBitrateKbps = NetworkStats.BitrateKbps;
+        TotalFramesSent = NetworkStats.FramesSent;
+        DroppedFrames = NetworkStats.DroppedFrames;
+        RoundTripTimeMs = NetworkStats.RTTMs;
+        MessagesSent = NetworkStats.MessagesSent;
+        LastMessageNumber = NetworkStats.LastMessageNumber;
+        BackpressureDrops = NetworkStats.BackpressureDrops;
+        ReconnectCount = NetworkStats.ReconnectCount;
+        LastRecoveryTimeMs = NetworkStats.LastRecoveryTimeMs;
+        RecordingDroppedChunks = NetworkStats.RecordingDroppedChunks;
+        RecordingSegmentsWritten = NetworkStats.RecordingSegmentsWritten;
+        
+        if (!Encryption.IsEnabled())
+        {
+            EncryptionState = TEXT("Off");
+        }
+        else if (ListenerOutput.IsValid())
+        {
+            EncryptionState = TEXT("Per subscriber");
+        }
+        else
+        {
+            EncryptionState = SRTNetwork::KeyMaterialStateToString(NetworkStats.KeyMaterialState);
+        }
+    }
+    
+    // 구독자 목록은 배열이라 워커가 아닌 게임 스레드에서 갱신
+    if (ListenerOutput.IsValid())
     {
-        GPUReadbackManager->RequestReadback(RenderTarget, TotalFramesSent);
+        TArray<FSRTListenerOutput::FSubscriberStats> Stats;
+        ListenerOutput->GetSubscriberStats(Stats);
         
-        if (CaptureCount % 30 == 0)
+        SubscriberCount = ListenerOutput->GetSubscriberCount();
+        SubscriberStats.Reset(Stats.Num());
+        for (const FSRTListenerOutput::FSubscriberStats& Source : Stats)
         {
-            UE_LOG(LogCineSRTStream, Log, TEXT("GPU readback requested for frame #%d"), TotalFramesSent);
+            FSRTSubscriberInfo& Info = SubscriberStats.AddDefaulted_GetRef();
+            Info.PeerAddress = Source.PeerAddress;
+            Info.ConnectedSeconds = (float)Source.ConnectedSeconds;
+            Info.BytesSent = Source.BytesSent;
+            Info.FramesSent = Source.FramesSent;
+            Info.FramesSkipped = Source.FramesSkipped;
+            Info.KeyFrameResyncs = Source.KeyFrameResyncs;
+            Info.QueuedFrames = Source.QueuedFrames;
+            Info.RTTMs = Source.RTTMs;
+            Info.SendRateMbps = Source.SendRateMbps;
+            Info.EncryptionState = SRTNetwork::KeyMaterialStateToString(Source.KeyMaterialState);
         }
     }
-    else
+    
+    // 본딩 링크별 상태도 배열이라 같은 방식
+    if (BondingMode != ESRTBondingMode::None && StreamWorker.IsValid())
     {
-        UE_LOG(LogCineSRTStream, Warning, TEXT("CaptureFrame: GPUReadbackManager is null"));
+        StreamWorker->GetBondingMembers(BondingMembers);
+        BondingActiveLinks = 0;
+        for (const FSRTBondingMemberInfo& Member : BondingMembers)
+        {
+            if (Member.State == TEXT("Running"))
+            {
+                BondingActiveLinks++;
+            }
+        }
+    }
+    
+    if (OnStatsUpdated.IsBound())
+    {
+        OnStatsUpdated.Broadcast(CurrentBitrateKbps, TotalFramesSent, RoundTripTimeMs);
     }
 }
 
-void USRTStreamComponent::UpdateStats()
+void USRTStreamComponent::ApplyOverloadLevel()
 {
+    if (!StreamWorker.IsValid())
+        return;
+    
+    const int32 Level = StreamWorker->GetRequestedOverloadLevel();
+    if (Level == AppliedOverloadLevel)
+        return;
+    
+    const FSRTOverloadGovernor::FLevel& Target = StreamWorker->GetOverloadLevel(Level);
+    const FSRTOverloadGovernor::FLevel& Previous = StreamWorker->GetOverloadLevel(AppliedOverloadLevel);
+    
+    // 다음 캡처부터 새 크기 - 이미 요청한 리드백/생성은 이전 크기로 도착하고 워커가 건너뜀
+    if (Target.Width != Previous.Width || Target.Height != Previous.Height)
+    {
+        if (ActiveFrameSource == GPUReadbackManager && RenderTarget)
+        {
+            RenderTarget->ResizeTarget(Target.Width, Target.Height);
+        }
+        else if (ActiveFrameSource)
+        {
+            ActiveFrameSource->SetOutputSize(Target.Width, Target.Height);
+        }
+    }
+    CaptureFPS = (float)Target.FPS;
+    AppliedOverloadLevel = Level;
+    StreamWorker->SetCaptureOverloadLevel(Level);
+    
+    OverloadLevel = Level;
+    OverloadState = Target.ToString();
+    NetworkStats.OverloadLevel = Level;
+    NetworkStats.EncodeWidth = Target.Width;
+    NetworkStats.EncodeHeight = Target.Height;
+    NetworkStats.EncodeFPS = (float)Target.FPS;
+    UE_LOG(LogCineSRTStream, Log, TEXT("Overload level %d/%d: %s -> %s"),
+        Level, StreamWorker->GetOverloadLevelCount() - 1, *Previous.ToString(), *OverloadState);
+    
+    // 다음 1초 스냅샷을 기다리지 않고 바로 알림 (OverloadLevel/OverloadState, NetworkStats)
     if (OnStatsUpdated.IsBound())
     {
         OnStatsUpdated.Broadcast(CurrentBitrateKbps, TotalFramesSent, RoundTripTimeMs);
@@ -827,6 +1636,9 @@ void USRTStreamComponent::SetConnectionState(ESRTConnectionState NewState, const
             case ESRTConnectionState::Streaming:
                 CurrentStatus = FString::Printf(TEXT("Streaming (%.1f Mbps)"), CurrentBitrateKbps / 1000.0f);
                 break;
+            case ESRTConnectionState::Reconnecting:
+                CurrentStatus = TEXT("Reconnecting...");
+                break;
             case ESRTConnectionState::Error:
                 CurrentStatus = FString::Printf(TEXT("Error: %s"), *Message);
                 break;
@@ -847,6 +1659,9 @@ void USRTStreamComponent::SetConnectionState(ESRTConnectionState NewState, const
             case ESRTConnectionState::Streaming:
                 StateStr = TEXT("Streaming");
                 break;
+            case ESRTConnectionState::Reconnecting:
+                StateStr = TEXT("Reconnecting");
+                break;
             case ESRTConnectionState::Error:
                 StateStr = TEXT("Error");
                 break;
@@ -854,14 +1669,94 @@ void USRTStreamComponent::SetConnectionState(ESRTConnectionState NewState, const
         
         UE_LOG(LogCineSRTStream, Log, TEXT("State: %s - %s"), *StateStr, *Message);
         
-        // Broadcast on game thread
-        AsyncTask(ENamedThreads::GameThread, [this, NewState, Message]()
+        if (OnStateChanged.IsBound())
+        {
+            OnStateChanged.Broadcast(NewState, Message);
+        }
+    }
+}
+
+void USRTStreamComponent::ProcessWorkerEvents()
+{
+    // 상태 변경은 다 꺼낸 뒤에 적용 - OnStateChanged 핸들러가 StopStreaming을 불러 워커를 없앨 수 있음
+    TArray<TPair<ESRTConnectionState, FString>, TInlineAllocator<4>> StateChanges;
+    if (StreamWorker.IsValid())
+    {
+        const int32 Dropped = StreamWorker->DrainEvents([this, &StateChanges](const FSRTWorkerEvent& Event)
         {
-            if (OnStateChanged.IsBound())
+            if (Event.Type == FSRTWorkerEvent::EType::ConnectionState)
+            {
+                StateChanges.Emplace(Event.State, Event.Text);
+            }
+            else
             {
-                OnStateChanged.Broadcast(NewState, Message);
+                HandleWorkerEvent(Event);
             }
         });
+        if (Dropped > 0)
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("%d worker events dropped (game thread not ticking?)"), Dropped);
+        }
+    }
+    
+    // 정지 중에 남은 상태는 버림 (StopStreaming이 마지막 상태를 정함)
+    for (const TPair<ESRTConnectionState, FString>& Change : StateChanges)
+    {
+        if (!bIsStreaming)
+            break;
+        SetConnectionState(Change.Key, Change.Value);
+    }
+    
+    if (bBitrateChangePending)
+    {
+        bBitrateChangePending = false;
+        UE_LOG(LogCineSRTStream, Log, TEXT("Runtime bitrate changed to %d kbps"), BitrateKbps);
+        
+        // UI 알림
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, 
+                FString::Printf(TEXT("Bitrate: %d kbps"), BitrateKbps));
+        }
+    }
+    
+    if (PendingForcedKeyFrames > 0)
+    {
+        UE_LOG(LogCineSRTStream, Log, TEXT("Forced keyframe (x%d)"), PendingForcedKeyFrames);
+        PendingForcedKeyFrames = 0;
+    }
+}
+
+void USRTStreamComponent::HandleWorkerEvent(const FSRTWorkerEvent& Event)
+{
+    switch (Event.Type)
+    {
+        case FSRTWorkerEvent::EType::ConnectionState:
+            // ProcessWorkerEvents가 모아서 적용
+            break;
+        case FSRTWorkerEvent::EType::StreamingStatus:
+            UE_LOG(LogCineSRTStream, Log, TEXT("Streaming status: %d frames sent, %d messages"), Event.A, Event.B);
+            break;
+        case FSRTWorkerEvent::EType::NoFrame:
+            UE_LOG(LogCineSRTStream, Warning, TEXT("No new frame available (count: %d)"), Event.A);
+            break;
+        case FSRTWorkerEvent::EType::EncoderMissing:
+            UE_LOG(LogCineSRTStream, Warning, TEXT("VideoEncoder or TransportStream is null"));
+            break;
+        case FSRTWorkerEvent::EType::EncodeFailed:
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Failed to encode frame #%d"), Event.A);
+            break;
+        case FSRTWorkerEvent::EType::MuxFailed:
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Failed to mux video frame #%d"), Event.A);
+            break;
+        case FSRTWorkerEvent::EType::EncoderLevelApplied:
+            UE_LOG(LogCineSRTStream, Log, TEXT("Encoder switched to overload level %d: %s"), Event.A,
+                StreamWorker.IsValid() ? *StreamWorker->GetOverloadLevel(Event.A).ToString() : TEXT("?"));
+            break;
+        case FSRTWorkerEvent::EType::OverloadDecision:
+            UE_LOG(LogCineSRTStream, Log, TEXT("Overload governor: %s level %d -> %d (%s)"),
+                Event.B > Event.A ? TEXT("down") : TEXT("up"), Event.A, Event.B, Event.Text);
+            break;
     }
 }
 
@@ -876,15 +1771,23 @@ FString USRTStreamComponent::GetConnectionInfo() const
 
 FString USRTStreamComponent::GetStreamURL() const
 {
-    FString URL = FString::Printf(TEXT("srt://%s:%d"), *StreamIP, StreamPort);
+    // IPv6 리터럴은 대괄호로 감쌈
+    const FString Host = (StreamIP.Contains(TEXT(":")) && !StreamIP.StartsWith(TEXT("[")))
+        ? FString::Printf(TEXT("[%s]"), *StreamIP) : StreamIP;
+    FString URL = FString::Printf(TEXT("srt://%s:%d"), *Host, StreamPort);
     
     TArray<FString> Options;
     
-    // 암호화 및 기타 옵션 제거 (변수 없음)
-    // if (!bUseEncryption && !EncryptionPassphrase.IsEmpty())
-    // {
-    //     Options.Add(FString::Printf(TEXT("passphrase=%s"), *EncryptionPassphrase));
-    // }
+    if (bUseEncryption && !EncryptionPassphrase.IsEmpty())
+    {
+        Options.Add(FString::Printf(TEXT("passphrase=%s"), *EncryptionPassphrase));
+        Options.Add(FString::Printf(TEXT("pbkeylen=%d"), (int32)EncryptionKeyLength));
+        // 수신 측이 caller면 모드를 맞춰야 함 (listener 쪽은 AUTO로 caller의 모드를 따름)
+        if (EncryptionCipher == ESRTCipherMode::AES_GCM)
+        {
+            Options.Add(TEXT("cryptomode=2"));
+        }
+    }
     
     // StreamID 제거 (변수 없음)
     // if (!StreamID.IsEmpty())
@@ -895,6 +1798,20 @@ FString USRTStreamComponent::GetStreamURL() const
     // 기본 레이턴시 설정
     Options.Add(FString::Printf(TEXT("latency=%d"), LatencyMs));  // UI에서 설정한 값 사용
     
+    // 리스너 모드면 수신기가 이 주소로 접속 (StreamIP 대신 이 머신의 주소를 넣어 사용)
+    if (ConnectionMode == ESRTConnectionMode::Listener)
+    {
+        Options.Add(TEXT("mode=caller"));
+    }
+    
+    // 본딩: 수신기가 그룹 연결을 받는 리스너가 되어야 함 (링크마다 다른 포트면 첫 링크 기준)
+    if (BondingMode != ESRTBondingMode::None && BondingLinks.Num() > 0)
+    {
+        URL = FString::Printf(TEXT("srt://:%d"), BondingLinks[0].RemotePort);
+        Options.Add(TEXT("mode=listener"));
+        Options.Add(TEXT("groupconnect=1"));
+    }
+    
     if (Options.Num() > 0)
     {
         URL += TEXT("?") + FString::Join(Options, TEXT("&"));
@@ -911,21 +1828,68 @@ FSRTStreamWorker::FSRTStreamWorker(USRTStreamComponent* InOwner)
     : Owner(InOwner)
     , bShouldExit(false)
 {
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    
+    // 과부하 조정 단계 - 0단계는 방금 연 인코더 설정 (꺼져 있으면 단계 하나뿐)
+    FSRTOverloadGovernor::FConfig GovernorConfig;
+    if (Owner->VideoEncoder)
+    {
+        const FSRTVideoEncoder::FConfig& EncoderConfig = Owner->VideoEncoder->GetConfig();
+        GovernorConfig.Width = EncoderConfig.Width;
+        GovernorConfig.Height = EncoderConfig.Height;
+        GovernorConfig.FPS = EncoderConfig.FrameRate;
+        if (Owner->VideoEncoder->UsesPreset())
+        {
+            GovernorConfig.Preset = EncoderConfig.Preset;
+        }
+    }
+    if (Owner->bEnableOverloadGovernor)
+    {
+        GovernorConfig.FastestPreset = StaticEnum<EEncoderPreset>()->GetNameStringByValue((int64)Owner->OverloadFastestPreset).ToLower();
+        // 파일은 원본 해상도로만 재생
+        GovernorConfig.MinResolutionScale = (Owner->FrameSource == ESRTFrameSourceType::File) ? 1.0f : Owner->OverloadMinResolutionScale;
+        GovernorConfig.MinFPS = Owner->OverloadMinFPS;
+        GovernorConfig.OverloadThreshold = Owner->OverloadThreshold;
+        GovernorConfig.RecoverThreshold = FMath::Min(Owner->OverloadRecoverThreshold, Owner->OverloadThreshold);
+        GovernorConfig.RecoverSeconds = Owner->OverloadRecoverSeconds;
+    }
+    else
+    {
+        GovernorConfig.Preset.Reset();
+        GovernorConfig.MinResolutionScale = 1.0f;
+        GovernorConfig.MinFPS = GovernorConfig.FPS;
+    }
+    Governor.Reset(GovernorConfig);
 }
 
 FSRTStreamWorker::~FSRTStreamWorker()
 {
     CleanupSRT();
+    
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
 }
 
 void FSRTStreamWorker::ForceCloseSocket()
 {
     FScopeLock Lock(&SocketLock);
-    if (SRTSocket)
-    {
-        SRTNetwork::CloseSocket(SRTSocket);
-        SRTSocket = nullptr;
-    }
+    SRTSocket.Close();
+}
+
+int32 FSRTStreamWorker::DrainEvents(TFunctionRef<void(const FSRTWorkerEvent&)> Handler)
+{
+    WorkerEvents.Drain(Handler);
+    EncodeEvents.Drain(Handler);
+    return WorkerEvents.ConsumeDroppedCount() + EncodeEvents.ConsumeDroppedCount();
+}
+
+void FSRTStreamWorker::PostConnectionState(ESRTConnectionState NewState, const FString& Message)
+{
+    // UPROPERTY 상태/문자열은 게임 스레드가 바꿈 (USRTStreamComponent::SetConnectionState)
+    PostWorkerEvent(WorkerEvents, FSRTWorkerEvent::EType::ConnectionState, 0, 0, *Message, NewState);
 }
 
 bool FSRTStreamWorker::Init()
@@ -941,6 +1905,20 @@ uint32 FSRTStreamWorker::Run()
     const double FrameInterval = 1.0 / Owner->StreamFPS;
     double LastFrameTime = FPlatformTime::Seconds();
     double LastStatsTime = LastFrameTime;
+    StreamStartTime = LastFrameTime;
+    LastPublishTime = LastFrameTime;
+    
+    if (!ConnectInitial())
+    {
+        return 0;
+    }
+    
+    if (Owner->bExportStats)
+    {
+        StatsExporter.Open(Owner->StatsExportDirectory,
+            Owner->GetOwner() ? Owner->GetOwner()->GetName() : Owner->GetName(),
+            Owner->StatsExportFormat);
+    }
     
     // 메인 루프 - bShouldExit 체크 추가
     while (!bShouldExit && Owner && !Owner->bStopRequested)
@@ -961,45 +1939,104 @@ uint32 FSRTStreamWorker::Run()
         
         double CurrentTime = FPlatformTime::Seconds();
         
+        // 공유 출력의 연결/재연결을 따라감
+        if (Owner->SharedOutput.IsValid())
+        {
+            SyncSharedConnection();
+        }
+        
+        // 재연결 시도 (직접 연결)
+        if (bReconnecting && !Owner->SharedOutput.IsValid() && CurrentTime >= NextReconnectTime)
+        {
+            TryReconnect();
+        }
+        
+        // 재연결을 포기했거나 비활성화된 상태에서 끊김 (공유 출력은 첫 연결 전까지 대기)
+        // 리스너 모드는 구독자가 없어도 계속 대기
+        bool bConnectionLost = false;
+        if (Owner->SharedOutput.IsValid())
+        {
+            bConnectionLost = SharedConnectionEpoch > 0 && !bReconnecting && !HasOutput();
+        }
+        else if (!Owner->ListenerOutput.IsValid())
+        {
+            bConnectionLost = !bReconnecting && !HasOutput();
+        }
+        if (bConnectionLost)
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Connection lost"));
+            break;
+        }
+        
         // 프레임 전송
-        if (CurrentTime - LastFrameTime >= FrameInterval)
+        if (Owner->EncodePool.IsValid())
+        {
+            // 인코딩은 풀 워커가 - 여기서는 출력 상태를 알려주고 인코딩된 프레임만 다중화/송신
+            FScopeLock Lock(&SocketLock);
+            if (bShouldExit)
+            {
+                break;
+            }
+            
+            UpdateEncodeGate();
+            FEncodedFrame EncodedFrame;
+            while (!bShouldExit && EncodedFrames.Dequeue(EncodedFrame))
+            {
+                if (!DeliverEncodedFrame(EncodedFrame))
+                {
+                    Counters.DroppedFrames++;
+                }
+            }
+        }
+        else if (CurrentTime - LastFrameTime >= FrameInterval)
         {
             if (Owner->FrameBuffer && Owner->FrameBuffer->HasNewFrame())
             {
                 FScopeLock Lock(&SocketLock);
-                if (SRTSocket && !bShouldExit)  // 다시 체크
+                if (bShouldExit)
                 {
-                    if (!SendFrameData())
-                    {
-                        Owner->DroppedFrames++;
-                        
-                        // 연결이 끊어졌는지 확인
-                        if (!SRTSocket)
-                        {
-                            UE_LOG(LogCineSRTStream, Warning, TEXT("Connection lost"));
-                            break;
-                        }
-                    }
+                    break;
+                }
+                
+                if (!SendFrameData())
+                {
+                    Counters.DroppedFrames++;
                 }
             }
             LastFrameTime = CurrentTime;
         }
         
-        // 통계 업데이트
+        // 통계 업데이트 (끊긴 동안에도 파이프라인 카운터는 발행)
         if (CurrentTime - LastStatsTime >= 1.0)
         {
             FScopeLock Lock(&SocketLock);
-            if (SRTSocket && !bShouldExit)
+            if (!bShouldExit)
             {
                 UpdateSRTStats();
+                
+                // 송신이 없어도 피어 종료를 감지
+                if (SRTSocket && !SRTSocket.IsConnected())
+                {
+                    BeginReconnect(TEXT("Connection lost"));
+                }
             }
             LastStatsTime = CurrentTime;
         }
         
-        // CPU 사용률 감소를 위한 짧은 대기
-        FPlatformProcess::Sleep(0.0001f);  // 0.001f → 0.0001f (10배 감소!)
+        if (Owner->EncodePool.IsValid())
+        {
+            // 인코딩된 프레임이나 Stop이 깨움 - 재연결/통계 타이머 때문에 최대 5ms
+            WorkEvent->Wait(5);
+        }
+        else
+        {
+            // CPU 사용률 감소를 위한 짧은 대기
+            FPlatformProcess::Sleep(0.0001f);  // 0.001f → 0.0001f (10배 감소!)
+        }
     }
     
+    StatsExporter.Close();
+    
     UE_LOG(LogCineSRTStream, Log, TEXT("SRT Worker thread ending (exit: %s, stop: %s)"),
         bShouldExit ? TEXT("true") : TEXT("false"),
         (Owner && Owner->bStopRequested) ? TEXT("true") : TEXT("false"));
@@ -1014,20 +2051,11 @@ void FSRTStreamWorker::Stop()
     // 종료 플래그 설정
     bShouldExit = true;
     
-    // 소켓을 즉시 닫아서 블로킹된 Send/Recv 해제
-    FScopeLock Lock(&SocketLock);
-    if (SRTSocket)
+    // 송신 대기 중이면 epoll 인터럽트로 즉시 깨움 - 소켓은 워커 스레드가 Exit()에서 닫음
+    SRTNetwork::InterruptEpoll(EpollID.Exchange(-1));
+    if (WorkEvent)
     {
-        UE_LOG(LogCineSRTStream, Log, TEXT("Closing SRT socket immediately"));
-        
-        // 소켓 핸들 백업 후 null로 설정
-        void* socketToClose = SRTSocket;
-        SRTSocket = nullptr;
-        
-        // 소켓 닫기 - 이렇게 하면 진행 중인 Send/Recv가 즉시 실패
-        SRTNetwork::CloseSocket(socketToClose);
-        
-        UE_LOG(LogCineSRTStream, Log, TEXT("SRT socket closed"));
+        WorkEvent->Trigger();
     }
 }
 
@@ -1036,237 +2064,1045 @@ void FSRTStreamWorker::Exit()
     UE_LOG(LogCineSRTStream, Log, TEXT("Worker Exit() called"));
     
     // 혹시 남아있는 소켓 정리
+    SRTNetwork::InterruptEpoll(EpollID.Exchange(-1));
     FScopeLock Lock(&SocketLock);
-    if (SRTSocket)
-    {
-        SRTNetwork::CloseSocket(SRTSocket);
-        SRTSocket = nullptr;
-    }
+    SRTSocket.Close();
     
     UE_LOG(LogCineSRTStream, Log, TEXT("Worker thread exiting"));
 }
 
 bool FSRTStreamWorker::InitializeSRT()
 {
-    UE_LOG(LogCineSRTStream, Log, TEXT("Creating SRT socket..."));
-    void* sock = SRTNetwork::CreateSocket();
-    if (!sock)
+    Backoff.Reset(Owner->ReconnectInitialDelayMs, Owner->ReconnectMaxDelayMs);
+    Pacer.Reset(Owner->PacingBurstPackets, GetPacingMaxRate());
+    
+    // 리스너 모드: 소켓은 팬아웃 출력이 소유, 워커는 인코딩/다중화만 담당
+    if (Owner->ListenerOutput.IsValid())
     {
-        Owner->SetConnectionState(ESRTConnectionState::Error, TEXT("Failed to create SRT socket"));
-        return false;
+        PostConnectionState(ESRTConnectionState::Streaming,
+            FString::Printf(TEXT("Listening on port %d"), Owner->StreamPort));
+        return true;
     }
-    UE_LOG(LogCineSRTStream, Log, TEXT("SRT socket created successfully"));
-    
-    // 최소한의 SRT 설정만 사용
-    UE_LOG(LogCineSRTStream, Log, TEXT("Using minimal SRT options..."));
-    
-    // ⭐ 스트림 모드 설정 (메시지 모드 OFF)
-    int messageapi = 0;  // 0 = stream mode
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_MESSAGEAPI, &messageapi, sizeof(messageapi));
-    
-    // 기본 전송 모드만 설정
-    int live_mode = SRTNetwork::TRANSTYPE_LIVE;
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_TRANSTYPE, &live_mode, sizeof(live_mode));
-    
-    // ⭐ 성능 최적화 옵션 (권장)
-    int latency = Owner->LatencyMs;  // UI에서 설정한 값 사용
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_LATENCY, &latency, sizeof(latency));
-    
-    // 송신 버퍼 크기 최소화 (64MB → 1MB)
-    int sndbuf = 1024 * 1024;  // 64배 감소!
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_SNDBUF, &sndbuf, sizeof(sndbuf));
     
-    // 수신 버퍼 크기 최소화
-    int rcvbuf = 1024 * 1024;
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_RCVBUF, &rcvbuf, sizeof(rcvbuf));
-    
-    // ⭐ Flow Control 윈도우 크기 최소화 (50000 → 1000)
-    int fc = 1000;  // 50배 감소!
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_FC, &fc, sizeof(fc));
+    // 공유 연결: 소켓은 공유 출력이 소유, 워커는 인코딩만 담당
+    if (Owner->SharedOutput.IsValid())
+    {
+        SharedConnectionEpoch = Owner->SharedOutput->GetConnectionEpoch();
+        PostConnectionState(ESRTConnectionState::Streaming,
+            FString::Printf(TEXT("Streaming as program %d on shared output"), Owner->SharedProgramIndex + 1));
+        return true;
+    }
     
-    // ⭐ 추가 최적화 옵션
-    int mss = 1500;  // Maximum Segment Size
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_MSS, &mss, sizeof(mss));
+    // 본딩: 링크 목록으로 소켓 그룹 연결 (StreamIP/StreamPort 대신)
+    GroupLinks.Reset();
+    if (Owner->BondingMode != ESRTBondingMode::None)
+    {
+        for (const FSRTBondingLink& Link : Owner->BondingLinks)
+        {
+            SRTNetwork::GroupLink& GroupLink = GroupLinks.AddDefaulted_GetRef();
+            GroupLink.LocalAddress = Link.LocalAddress;
+            GroupLink.LocalPort = Link.LocalPort;
+            GroupLink.RemoteAddress = Link.RemoteAddress;
+            GroupLink.RemotePort = Link.RemotePort;
+            GroupLink.Weight = Link.Weight;
+        }
+        LinkStates.SetNum(GroupLinks.Num());
+    }
     
-    int snddropdelay = 200;  // 송신 드롭 지연 (ms)
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_SNDDROPDELAY, &snddropdelay, sizeof(snddropdelay));
-    
-    int rcvdropdelay = 200;  // 수신 드롭 지연 (ms)
-    SRTNetwork::SetSocketOption(sock, SRTNetwork::OPT_RCVDROPDELAY, &rcvdropdelay, sizeof(rcvdropdelay));
+    // 기본적으로 Caller 모드로 설정 (bCallerMode 변수 없음)
+    // 연결 자체는 Run()에서 - Init()은 스레드 생성 중이라 게임 스레드가 끝날 때까지 기다림
+    PostConnectionState(ESRTConnectionState::Connecting, GroupLinks.Num() > 0
+        ? FString::Printf(TEXT("Connecting %d bonded links..."), GroupLinks.Num())
+        : FString::Printf(TEXT("Connecting to %s:%d..."), *Owner->StreamIP, Owner->StreamPort));
+    return true;
+}
+
+bool FSRTStreamWorker::ConnectInitial()
+{
+    // 리스너/공유 출력은 소켓을 직접 열지 않음
+    if (Owner->ListenerOutput.IsValid() || Owner->SharedOutput.IsValid())
+    {
+        return true;
+    }
     
-    // ⭐ 암호화 관련 코드 모두 삭제!
+    if (!ConnectSocket(0))
+    {
+        if (bShouldExit)
+        {
+            return false;
+        }
+        if (Owner->bAutoReconnect)
+        {
+            // 수신 측이 아직 안 떠 있어도 스트림은 시작 - 워커가 백오프로 계속 시도
+            BeginReconnect(FString::Printf(TEXT("Connection failed: %s"), *LastConnectError));
+            return true;
+        }
+        PostConnectionState(ESRTConnectionState::Error, FString::Printf(TEXT("Connection failed: %s"), *LastConnectError));
+        return false;
+    }
     
-    // Connect or bind
-    // 기본적으로 Caller 모드로 설정 (bCallerMode 변수 없음)
+    PostConnectionState(ESRTConnectionState::Connected, TEXT("Connected successfully"));
+    PostConnectionState(ESRTConnectionState::Streaming, TEXT("Streaming active"));
+    return true;
+}
+
+bool FSRTStreamWorker::ConnectSocket(int32 ConnectTimeoutMs)
+{
+    LastConnectError.Reset();
+    FSRTSocket sock;
+    if (GroupLinks.Num() > 0)
     {
-        Owner->SetConnectionState(ESRTConnectionState::Connecting, FString::Printf(TEXT("Connecting to %s:%d..."), *Owner->StreamIP, Owner->StreamPort));
-        if (!SRTNetwork::Connect(sock, TCHAR_TO_UTF8(*Owner->StreamIP), Owner->StreamPort))
+        UE_LOG(LogCineSRTStream, Log, TEXT("Creating SRT socket group (%d links)..."), GroupLinks.Num());
+        sock = CreateConfiguredSocket(true, ConnectTimeoutMs);
+        if (!sock || !ConnectGroup(sock, ConnectTimeoutMs > 0 ? ConnectTimeoutMs : 3000))
         {
-            FString Error = UTF8_TO_TCHAR(SRTNetwork::GetLastError());
-            Owner->SetConnectionState(ESRTConnectionState::Error, FString::Printf(TEXT("Connection failed: %s"), *Error));
-            SRTNetwork::CloseSocket(sock);
             return false;
         }
-        SRTSocket = sock;
-        Owner->SetConnectionState(ESRTConnectionState::Connected, TEXT("Connected successfully"));
     }
-    Owner->SetConnectionState(ESRTConnectionState::Streaming, TEXT("Streaming active"));
+    else
+    {
+        // 이름 해석(캐시) + IPv4/IPv6 동시 시도 - 종료 요청은 50ms 안에 반영
+        FString Endpoint;
+        sock = SRTNetwork::ConnectHost(Owner->StreamIP, Owner->StreamPort,
+            [this, ConnectTimeoutMs]() { return CreateConfiguredSocket(false, ConnectTimeoutMs); },
+            ConnectTimeoutMs > 0 ? ConnectTimeoutMs : 3000,
+            [this]() { return bShouldExit.Load(); },
+            Endpoint, LastConnectError);
+        if (!sock)
+        {
+            // 비밀번호 불일치/암호화 설정 불일치는 거부 사유로만 구분됨
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Connect to %s:%d failed: %s"),
+                *Owner->StreamIP, Owner->StreamPort, *LastConnectError);
+            return false;
+        }
+        UE_LOG(LogCineSRTStream, Log, TEXT("Connected to %s"), *Endpoint);
+    }
+    
+    // 연결 후 논블로킹 전환 - 송신 버퍼가 차면 기다리지 않고 epoll로 판단
+    sock.SetNonBlocking(true);
+    const int32 NewEpollID = SRTNetwork::CreateSendEpoll(sock.Get());
+    if (NewEpollID < 0)
+    {
+        UE_LOG(LogCineSRTStream, Error, TEXT("Failed to create SRT epoll"));
+        return false;
+    }
+    
+    // 레이턴시 동안 보낼 양 이상 쌓이면 수신 측에서 어차피 늦게 도착 (TLPKTDROP)
+    SendBufferBudgetBytes = FMath::Max<int64>((int64)Owner->BitrateKbps * 125 * Owner->LatencyMs / 1000,
+        (int64)FSRTSocket::LIVE_PAYLOAD_SIZE * 64);
+    
+    FScopeLock Lock(&SocketLock);
+    EpollID = NewEpollID;
+    SRTSocket = MoveTemp(sock);
+    SourceClock.Reset(SRTSocket.Get());
+    StatsTracker.Reset();
+    // 새 연결의 첫 프레임은 반드시 IDR (PAT/PMT도 키프레임마다 함께 나감)
+    bWaitForKeyFrame = true;
     return true;
 }
 
-void FSRTStreamWorker::CleanupSRT()
+FSRTSocket FSRTStreamWorker::CreateConfiguredSocket(bool bGroup, int32 ConnectTimeoutMs)
 {
-    if (SRTSocket)
+    FSRTSocket sock;
+    if (bGroup)
+    {
+        sock = FSRTSocket::CreateGroup(Owner->BondingMode == ESRTBondingMode::MainBackup
+            ? SRT_GTYPE_BACKUP : SRT_GTYPE_BROADCAST);
+        if (!sock)
+        {
+            LastConnectError = FString::Printf(TEXT("Failed to create SRT socket group (SRT built without ENABLE_BONDING?): %s"),
+                UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+            UE_LOG(LogCineSRTStream, Error, TEXT("%s"), *LastConnectError);
+            return sock;
+        }
+    }
+    else
     {
-        SRTNetwork::CloseSocket(SRTSocket);
-        SRTSocket = nullptr;
+        sock = FSRTSocket::Create();
+        if (!sock)
+        {
+            LastConnectError = TEXT("Failed to create SRT socket");
+            UE_LOG(LogCineSRTStream, Error, TEXT("%s"), *LastConnectError);
+            return sock;
+        }
+    }
+    
+    // 최소한의 SRT 설정만 사용 (레이턴시는 UI 설정)
+    if (!SRTNetwork::ApplyLiveStreamOptions(sock, Owner->LatencyMs))
+    {
+        LastConnectError = FString::Printf(TEXT("Failed to apply live stream options: %s"), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        UE_LOG(LogCineSRTStream, Error, TEXT("%s"), *LastConnectError);
+        return FSRTSocket();
     }
+    if (!SRTNetwork::ApplyEncryptionOptions(sock, Owner->Encryption))
+    {
+        LastConnectError = FString::Printf(TEXT("Failed to apply encryption options: %s"), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        UE_LOG(LogCineSRTStream, Error, TEXT("%s"), *LastConnectError);
+        return FSRTSocket();
+    }
+    if (Owner->bEnablePacing && !SRTNetwork::ApplyPacingOptions(sock, GetPacingMaxRate()))
+    {
+        LastConnectError = FString::Printf(TEXT("Failed to apply pacing options: %s"), UTF8_TO_TCHAR(FSRTSocket::GetLastErrorString()));
+        UE_LOG(LogCineSRTStream, Error, TEXT("%s"), *LastConnectError);
+        return FSRTSocket();
+    }
+    if (ConnectTimeoutMs > 0)
+    {
+        // 재연결 시도는 짧게 - 백오프 간격이 연결 타임아웃에 묻히지 않도록
+        sock.SetOption(SRTO_CONNTIMEO, ConnectTimeoutMs);
+    }
+    if (bGroup && Owner->BondingMode == ESRTBondingMode::MainBackup)
+    {
+        sock.SetOption(SRTO_GROUPMINSTABLETIMEO, Owner->BackupStabilityTimeoutMs);
+    }
+    return sock;
 }
 
-bool FSRTStreamWorker::SendFrameData()
+bool FSRTStreamWorker::ConnectGroup(FSRTSocket& Group, int32 TimeoutMs)
 {
-    if (!SRTSocket || !Owner || !Owner->FrameBuffer)
-        return false;
+    // 논블로킹으로 모든 링크를 시작하고 첫 멤버가 붙을 때까지 대기 - 나머지 링크는 백그라운드에서 계속 연결
+    TArray<int32> Indices;
+    for (int32 i = 0; i < GroupLinks.Num(); i++)
+    {
+        Indices.Add(i);
+    }
     
-    FrameBuffer::Frame Frame;
-    if (!Owner->FrameBuffer->GetFrame(Frame))
+    Group.SetNonBlocking(true);
+    auto ShouldAbort = [this]() { return bShouldExit.Load(); };
+    TArray<FString> Errors;
+    bool bConnected = SRTNetwork::ConnectGroupLinks(Group.Get(), GroupLinks, Indices, Errors, ShouldAbort);
+    for (const FString& Error : Errors)
     {
-        // 로그 추가
-        static int NoFrameCount = 0;
-        if (++NoFrameCount % 30 == 0) // 1초마다 한 번
+        UE_LOG(LogCineSRTStream, Warning, TEXT("Bonding: %s"), *Error);
+    }
+    bConnected = bConnected && SRTNetwork::WaitConnected(Group.Get(), TimeoutMs, ShouldAbort);
+    if (!bConnected)
+    {
+        LastConnectError = Errors.Num() > 0 ? FString::Join(Errors, TEXT(", ")) : TEXT("No bonded link connected");
+    }
+    
+    for (FGroupLinkState& Link : LinkStates)
+    {
+        Link = FGroupLinkState();
+    }
+    return bConnected;
+}
+
+void FSRTStreamWorker::MaintainGroupLinks(const TArray<SRTNetwork::GroupMember>& Members, double Now)
+{
+    TArray<bool> bPresent;
+    bPresent.SetNumZeroed(GroupLinks.Num());
+    for (const SRTNetwork::GroupMember& Member : Members)
+    {
+        if (GroupLinks.IsValidIndex(Member.Token) && Member.MemberState != SRT_GST_BROKEN)
         {
-            UE_LOG(LogCineSRTStream, Warning, TEXT("No new frame available (count: %d)"), NoFrameCount);
+            bPresent[Member.Token] = true;
         }
-        return false;
     }
     
-    // Phase 3: 새로운 인코더 및 멀티플렉서 사용
-    if (Owner->VideoEncoder && Owner->TransportStream)
+    // 끊긴 링크는 SRT가 그룹에서 빼므로 직접 다시 추가 (논블로킹 - 연결은 백그라운드)
+    TArray<int32> Retry;
+    for (int32 i = 0; i < GroupLinks.Num(); i++)
     {
-        UE_LOG(LogCineSRTStream, VeryVerbose, TEXT("Processing frame #%d: %dx%d"), 
-            Frame.FrameNumber, Frame.Width, Frame.Height);
-        
-        // BGRA 데이터를 FColor 배열로 변환
-        TArray<FColor> BGRAData;
-        BGRAData.SetNum(Frame.Width * Frame.Height);
-        FMemory::Memcpy(BGRAData.GetData(), Frame.Data.GetData(), Frame.Data.Num());
+        FGroupLinkState& Link = LinkStates[i];
+        if (bPresent[i])
+        {
+            Link.bUp = true;
+            continue;
+        }
         
-        // H.264 인코딩
-        FEncodedFrame EncodedFrame;
-        if (!Owner->VideoEncoder->EncodeFrame(BGRAData, EncodedFrame))
+        if (Link.bUp)
         {
-            UE_LOG(LogCineSRTStream, Warning, TEXT("Failed to encode frame #%d"), Frame.FrameNumber);
-            return false;
+            UE_LOG(LogCineSRTStream, Warning, TEXT("Bonding: Link %d (%s:%d) lost - streaming continues on remaining links"),
+                i, *GroupLinks[i].RemoteAddress, GroupLinks[i].RemotePort);
+            Link.bUp = false;
+        }
+        if (Now >= Link.RetryTime)
+        {
+            Link.RetryTime = Now + 2.0;
+            Retry.Add(i);
+        }
+    }
+    
+    if (Retry.Num() > 0)
+    {
+        TArray<FString> Errors;
+        SRTNetwork::ConnectGroupLinks(SRTSocket.Get(), GroupLinks, Retry, Errors, [this]() { return bShouldExit.Load(); });
+        for (const FString& Error : Errors)
+        {
+            UE_LOG(LogCineSRTStream, Verbose, TEXT("Bonding: %s"), *Error);
         }
+    }
+}
+
+void FSRTStreamWorker::UpdateBondingStats(const TArray<SRTNetwork::GroupMember>& Members, FSRTNetworkStats& Snapshot)
+{
+    TArray<FSRTBondingMemberInfo> Infos;
+    float MinRTT = 0.0f;
+    for (const SRTNetwork::GroupMember& Member : Members)
+    {
+        FSRTBondingMemberInfo& Info = Infos.AddDefaulted_GetRef();
+        Info.LinkIndex = Member.Token;
+        Info.PeerAddress = Member.PeerAddress;
+        Info.State = SRTNetwork::MemberStateToString(Member.MemberState);
+        Info.Weight = Member.Weight;
         
-        UE_LOG(LogCineSRTStream, VeryVerbose, TEXT("Encoded frame #%d: %d bytes, %s"), 
-            EncodedFrame.FrameNumber, 
-            EncodedFrame.Data.Num(),
-            EncodedFrame.bKeyFrame ? TEXT("KEY") : TEXT("DELTA"));
+        if (!LinkStates.IsValidIndex(Member.Token) || Member.MemberState == SRT_GST_BROKEN)
+            continue;
         
-        // MPEG-TS 멀티플렉싱
-        TArray<uint8> TSPackets;
-        if (!Owner->TransportStream->MuxH264Frame(
-            EncodedFrame.Data,
-            EncodedFrame.PTS,
-            EncodedFrame.DTS,
-            EncodedFrame.bKeyFrame,
-            TSPackets))
-        {
-            UE_LOG(LogCineSRTStream, Warning, TEXT("Failed to mux H.264 frame"));
-            return false;
+        FGroupLinkState& Link = LinkStates[Member.Token];
+        if (Link.MemberSocket != Member.Socket)
+        {
+            Link.MemberSocket = Member.Socket;
+            Link.StatsTracker.Reset();
         }
         
-        UE_LOG(LogCineSRTStream, VeryVerbose, TEXT("Generated %d TS packets (%d bytes)"), 
-            TSPackets.Num() / 188, TSPackets.Num());
-        
-        // TS 패킷 전송 - 더 작은 청크로 지연 최소화
-        const int ChunkSize = 1316; // SRT 최적 청크 크기 (7 TS packets)
-        const uint8* DataPtr = TSPackets.GetData();
-        int32 TotalSize = TSPackets.Num();
-        int32 BytesSent = 0;
+        SRTNetwork::Stats Totals;
+        SRTNetwork::StatsInterval Interval;
+        if (!Link.StatsTracker.Sample(Member.Socket, Totals, Interval))
+            continue;
         
-        // ⭐ 더 작은 청크로 전송하여 지연 최소화
-        const int OptimalChunkSize = 1316; // 7 TS packets
+        Info.RTTMs = (float)Totals.msRTT;
+        Info.SendRateMbps = (float)Interval.SendMbps;
+        Info.LossPercent = (float)Interval.LossPercent;
+        Info.PacketsSent = Totals.pktSentTotal;
+        Info.PacketsRetransmitted = Totals.pktRetransTotal;
         
-        while (BytesSent < TotalSize && !Owner->bStopRequested && !bShouldExit)
+        // 그룹 전체 = 멤버 합 (브로드캐스트면 같은 패킷이 링크 수만큼), RTT는 가장 좋은 활성 링크
+        Snapshot.PacketsSent += Totals.pktSentTotal;
+        Snapshot.PacketsRetransmitted += Totals.pktRetransTotal;
+        Snapshot.PacketsLost += Totals.pktSndLossTotal;
+        Snapshot.PacketsDropped += Totals.pktSndDropTotal;
+        Snapshot.BytesSent += (int64)Totals.byteSentTotal;
+        Snapshot.BytesRetransmitted += (int64)Totals.byteRetransTotal;
+        Snapshot.BytesDropped += (int64)Totals.byteSndDropTotal;
+        Snapshot.SendRateMbps += (float)Interval.SendMbps;
+        Snapshot.RetransmitRateMbps += (float)Interval.RetransmitMbps;
+        Snapshot.IntervalPacketsLost += (int32)Interval.PacketsLost;
+        Snapshot.IntervalPacketsDropped += (int32)Interval.PacketsDropped;
+        Snapshot.IntervalPacketsRetransmitted += (int32)Interval.PacketsRetransmitted;
+        if (Member.MemberState == SRT_GST_RUNNING)
         {
-            int32 ToSend = FMath::Min(OptimalChunkSize, TotalSize - BytesSent);
-            int sent = SRTNetwork::Send(SRTSocket, (char*)(DataPtr + BytesSent), ToSend);
-            
-            if (sent < 0)
+            MinRTT = (MinRTT > 0.0f) ? FMath::Min(MinRTT, Info.RTTMs) : Info.RTTMs;
+            if (Snapshot.KeyMaterialState == 0)
             {
-                const char* error = SRTNetwork::GetLastError();
-                UE_LOG(LogCineSRTStream, Error, TEXT("Send failed: %s"), UTF8_TO_TCHAR(error));
-                return false;
+                Snapshot.KeyMaterialState = SRTNetwork::GetKeyMaterialState(Member.Socket);
             }
-            BytesSent += sent;
-            
-            // ⭐ 즉시 전송을 위한 짧은 대기 제거
-            // FPlatformProcess::Sleep(0.001f); // 이 줄 제거
         }
-        
-        if (BytesSent == TotalSize)
+    }
+    Snapshot.RTTMs = MinRTT;
+    
+    FScopeLock Lock(&BondingLock);
+    BondingSnapshot = MoveTemp(Infos);
+}
+
+void FSRTStreamWorker::GetBondingMembers(TArray<FSRTBondingMemberInfo>& OutMembers) const
+{
+    FScopeLock Lock(&BondingLock);
+    OutMembers = BondingSnapshot;
+}
+
+void FSRTStreamWorker::CloseConnection()
+{
+    SRTNetwork::InterruptEpoll(EpollID.Exchange(-1));
+    FScopeLock Lock(&SocketLock);
+    SRTSocket.Close();
+}
+
+void FSRTStreamWorker::BeginReconnect(const FString& Reason)
+{
+    CloseConnection();
+    
+    if (!Owner->bAutoReconnect || bShouldExit)
+    {
+        HandleDisconnection();
+        return;
+    }
+    
+    UE_LOG(LogCineSRTStream, Warning, TEXT("%s - reconnecting"), *Reason);
+    
+    const double Now = FPlatformTime::Seconds();
+    if (!bReconnecting)
+    {
+        DisconnectTime = Now;
+        ReconnectAttempt = 0;
+        Backoff.Reset(Owner->ReconnectInitialDelayMs, Owner->ReconnectMaxDelayMs);
+    }
+    bReconnecting = true;
+    bMeasuringRecovery = false;
+    bWaitForKeyFrame = true;
+    NextReconnectTime = Now + Backoff.NextDelaySeconds();
+    
+    PostConnectionState(ESRTConnectionState::Reconnecting, Reason);
+}
+
+bool FSRTStreamWorker::TryReconnect()
+{
+    ReconnectAttempt++;
+    if (GroupLinks.Num() > 0)
+    {
+        UE_LOG(LogCineSRTStream, Log, TEXT("Reconnect attempt %d (%d bonded links)..."), ReconnectAttempt, GroupLinks.Num());
+    }
+    else
+    {
+        UE_LOG(LogCineSRTStream, Log, TEXT("Reconnect attempt %d to %s:%d..."),
+            ReconnectAttempt, *Owner->StreamIP, Owner->StreamPort);
+    }
+    
+    if (ConnectSocket(1000))
+    {
+        OnReconnected();
+        return true;
+    }
+    
+    if (Owner->MaxReconnectAttempts > 0 && ReconnectAttempt >= Owner->MaxReconnectAttempts)
+    {
+        bReconnecting = false;
+        PostConnectionState(ESRTConnectionState::Error,
+            FString::Printf(TEXT("Reconnect failed after %d attempts: %s"),
+                ReconnectAttempt, *LastConnectError));
+        return false;
+    }
+    
+    NextReconnectTime = FPlatformTime::Seconds() + Backoff.NextDelaySeconds();
+    return false;
+}
+
+void FSRTStreamWorker::OnReconnected()
+{
+    bReconnecting = false;
+    bMeasuringRecovery = true;
+    bWaitForKeyFrame = true;
+    Counters.ReconnectCount++;
+    Backoff.Reset(Owner->ReconnectInitialDelayMs, Owner->ReconnectMaxDelayMs);
+    
+    PostConnectionState(ESRTConnectionState::Streaming,
+        FString::Printf(TEXT("Reconnected after %d attempt(s)"), FMath::Max(ReconnectAttempt, 1)));
+}
+
+void FSRTStreamWorker::SyncSharedConnection()
+{
+    const TSharedPtr<FSRTSharedOutput>& Shared = Owner->SharedOutput;
+    const int32 Epoch = Shared->GetConnectionEpoch();
+    
+    if (Epoch != SharedConnectionEpoch && Shared->IsConnected())
+    {
+        // 끊김을 보기 전에 이미 다시 붙은 경우도 재연결로 집계
+        const bool bWasConnected = SharedConnectionEpoch > 0;
+        SharedConnectionEpoch = Epoch;
+        bWaitForKeyFrame = true;
+        if (bReconnecting || bWasConnected)
         {
-            Owner->TotalFramesSent++;
-            
-            // 매 30프레임마다 상태 출력
-            if (Owner->TotalFramesSent % 30 == 0)
+            if (!bReconnecting)
             {
-                UE_LOG(LogCineSRTStream, Log, TEXT("Streaming status: %d frames sent, %d bytes total"), 
-                    Owner->TotalFramesSent, BytesSent);
+                DisconnectTime = FPlatformTime::Seconds();
             }
-            
-            return true;
+            ReconnectAttempt = 1;
+            OnReconnected();
+        }
+        return;
+    }
+    
+    if (!bReconnecting && SharedConnectionEpoch > 0 && !Shared->IsConnected())
+    {
+        if (!Shared->IsReconnecting())
+        {
+            HandleDisconnection();
+            return;
+        }
+        bReconnecting = true;
+        bMeasuringRecovery = false;
+        DisconnectTime = FPlatformTime::Seconds();
+        PostConnectionState(ESRTConnectionState::Reconnecting, TEXT("Shared output connection lost"));
+    }
+}
+
+void FSRTStreamWorker::DiscardFrameWhileDisconnected(const FrameBuffer::Frame& Frame)
+{
+    if (!Owner->VideoEncoder)
+        return;
+    
+    EncodeDroppedFrames++;
+    bWaitForKeyFrame = true;
+    
+    if (Owner->ReconnectPolicy == ESRTReconnectPolicy::KeepEncoding)
+    {
+        // 레이트 컨트롤과 인코더 세션을 유지 - 결과는 보내지 않음
+        FEncodedFrame Discarded;
+        Owner->VideoEncoder->EncodeFrame(Frame.Data.GetData(), Frame.Data.Num(), Frame.Format, Discarded);
+        return;
+    }
+    
+    // 인코딩 생략 - 프레임 번호만 진행
+    Owner->VideoEncoder->SkipFrame();
+}
+
+void FSRTStreamWorker::OnKeyFrameSent()
+{
+    if (!bMeasuringRecovery)
+        return;
+    
+    bMeasuringRecovery = false;
+    Counters.LastRecoveryTimeMs = (float)((FPlatformTime::Seconds() - DisconnectTime) * 1000.0);
+    UE_LOG(LogCineSRTStream, Log, TEXT("Stream recovered in %.0f ms (reconnect #%d)"),
+        Counters.LastRecoveryTimeMs, Counters.ReconnectCount);
+}
+
+void FSRTStreamWorker::CleanupSRT()
+{
+    SRTNetwork::InterruptEpoll(EpollID.Exchange(-1));
+    SRTSocket.Close();
+}
+
+bool FSRTStreamWorker::HasOutput() const
+{
+    if (Owner && Owner->ListenerOutput.IsValid())
+    {
+        return Owner->ListenerOutput->HasSubscribers();
+    }
+    if (Owner && Owner->SharedOutput.IsValid())
+    {
+        return Owner->SharedOutput->IsConnected();
+    }
+    return SRTSocket.IsValid();
+}
+
+bool FSRTStreamWorker::SendFrameData()
+{
+    SRT_TRACE_SCOPE(CineSRT_SendFrameData);
+    
+    if (!Owner || !Owner->FrameBuffer)
+        return false;
+    
+    FrameBuffer::Frame Frame;
+    if (!Owner->FrameBuffer->GetFrame(Frame))
+    {
+        if (++NoFrameCount % 30 == 0) // 1초마다 한 번
+        {
+            PostWorkerEvent(WorkerEvents, FSRTWorkerEvent::EType::NoFrame, NoFrameCount);
         }
+        return false;
+    }
+    
+    UpdateEncodeGate();
+    
+    FEncodedFrame EncodedFrame;
+    switch (EncodeFrame(Frame, EncodedFrame))
+    {
+        case EEncodeResult::Skipped:
+            return true;
+        case EEncodeResult::Failed:
+            return false;
+        default:
+            break;
+    }
+    return DeliverEncodedFrame(EncodedFrame);
+}
+
+void FSRTStreamWorker::EncodeFromPool()
+{
+    SRT_TRACE_SCOPE(CineSRT_PoolEncode);
+    
+    // 첫 연결 전에는 꺼내지 않음 - 최신 프레임이 버퍼에 남아 있다가 다음 캡처로 교체됨
+    if (bShouldExit || EncodeGate.Load() == EEncodeGate::Starting || !Owner->FrameBuffer)
+        return;
+    
+    FrameBuffer::Frame Frame;
+    if (!Owner->FrameBuffer->GetFrame(Frame))
+        return;
+    
+    FEncodedFrame EncodedFrame;
+    const EEncodeResult Result = EncodeFrame(Frame, EncodedFrame);
+    if (Result == EEncodeResult::Encoded)
+    {
+        EncodedFrames.Enqueue(MoveTemp(EncodedFrame));
+        WorkEvent->Trigger();
+    }
+    else if (Result == EEncodeResult::Failed)
+    {
+        EncodeDroppedFrames++;
+    }
+}
+
+void FSRTStreamWorker::UpdateEncodeGate()
+{
+    // 새 구독자는 IDR부터 받아야 바로 디코딩 가능
+    if (Owner->ListenerOutput.IsValid() && Owner->ListenerOutput->ConsumeKeyFrameRequest())
+    {
+        bWaitForKeyFrame = true;
+    }
+    
+    if (Owner->ListenerOutput.IsValid() && !HasOutput())
+    {
+        EncodeGate = EEncodeGate::Idle;
+    }
+    else if (bReconnecting || !HasOutput())
+    {
+        EncodeGate = EEncodeGate::Disconnected;
     }
     else
     {
-        UE_LOG(LogCineSRTStream, Warning, TEXT("VideoEncoder or TransportStream is null"));
+        EncodeGate = EEncodeGate::Open;
     }
     
-    return false;
+    // 리스너 모드는 구독자별 큐에서 따로 처리
+    bSendCongested = SRTSocket && IsSendCongested();
 }
 
-void FSRTStreamWorker::UpdateSRTStats()
+FSRTStreamWorker::EEncodeResult FSRTStreamWorker::EncodeFrame(FrameBuffer::Frame& Frame, FEncodedFrame& EncodedFrame)
 {
-    if (!SRTSocket)
+    SRT_TRACE_STAGE(Frame.Trace, Dequeue);
+    
+    if (!Owner->VideoEncoder || !Owner->TransportStream)
+    {
+        PostWorkerEvent(EncodeEvents, FSRTWorkerEvent::EType::EncoderMissing);
+        return EEncodeResult::Failed;
+    }
+    
+    // 과부하 단계가 바뀌는 동안 이전 크기로 캡처된 프레임 - 시간만 진행
+    if (!ApplyOverloadLevel(Frame))
+    {
+        Owner->VideoEncoder->SkipFrame();
+        return EEncodeResult::Skipped;
+    }
+    
+    switch (EncodeGate.Load())
+    {
+        case EEncodeGate::Idle:
+            // 구독자 없음 - 인코딩하지 않고 프레임 번호만 진행 (드롭으로 세지 않음)
+            Owner->VideoEncoder->SkipFrame();
+            return EEncodeResult::Skipped;
+        case EEncodeGate::Starting:
+        case EEncodeGate::Disconnected:
+            // 끊긴 동안에도 프레임 간격은 유지 - PTS가 실제 시간과 어긋나지 않도록
+            DiscardFrameWhileDisconnected(Frame);
+            return EEncodeResult::Skipped;
+        default:
+            break;
+    }
+    
+    SRT_FRAME_LOG(VeryVerbose, TEXT("Processing frame #%d: %dx%d"), 
+        Frame.FrameNumber, Frame.Width, Frame.Height);
+    
+    // 송신 혼잡: 인코딩 전에 버림 (B프레임이 없어 모든 프레임이 참조 프레임 → IDR부터 재개)
+    if (bSendCongested)
+    {
+        Owner->VideoEncoder->SkipFrame();
+        EncodeBackpressureDrops++;
+        bWaitForKeyFrame = true;
+        return EEncodeResult::Skipped;
+    }
+    if (bWaitForKeyFrame)
+    {
+        Owner->VideoEncoder->ForceKeyFrame();
+    }
+    
+    const uint64 EncodeStart = FPlatformTime::Cycles64();
+    
+    // H.264 인코딩 (FrameBuffer 프레임 그대로 - BGRA면 인코더가 변환, YUV면 평면 복사)
+    EncodedFrame.Trace = Frame.Trace;
+    SRT_TRACE_FRAME_ID(EncodeFrameId, Frame.Trace.FrameId);
+    const bool bEncoded = Owner->VideoEncoder->EncodeFrame(Frame.Data.GetData(), Frame.Data.Num(), Frame.Format, EncodedFrame);
+    
+    // CPU가 모자란 인코더 흉내 - 인코딩 시간에 비례하므로 단계를 내리면 같이 줄어듦
+    const float Slowdown = CVarSimulateEncoderSlowdown.GetValueOnAnyThread();
+    if (Slowdown > 1.0f)
+    {
+        FPlatformProcess::Sleep((float)((FPlatformTime::Cycles64() - EncodeStart) * FPlatformTime::GetSecondsPerCycle64() * (Slowdown - 1.0f)));
+    }
+    
+    const uint64 FrameEncodeCycles = FPlatformTime::Cycles64() - EncodeStart;
+    EncodeCycles += (int64)FrameEncodeCycles;
+    if (!bEncoded)
+    {
+        PostWorkerEvent(EncodeEvents, FSRTWorkerEvent::EType::EncodeFailed, Frame.FrameNumber);
+        return EEncodeResult::Failed;
+    }
+    EncodedFrameCount++;
+    SampleOverload(FrameEncodeCycles * FPlatformTime::GetSecondsPerCycle64() * 1000.0);
+    EncodedFrame.CaptureTime = Frame.Timestamp;
+    EncodedFrame.CaptureUtcUs = Owner->bEmbedCaptureTimestamp ? SRTNetwork::ToUtcMicroseconds(Frame.Timestamp) : 0;
+    EncodedFrame.CaptureFrameNumber = Frame.FrameNumber;
+    
+    if (bWaitForKeyFrame)
+    {
+        if (!EncodedFrame.bKeyFrame)
+        {
+            EncodeBackpressureDrops++;
+            Owner->VideoEncoder->ForceKeyFrame();
+            return EEncodeResult::Skipped;
+        }
+        bWaitForKeyFrame = false;
+    }
+    
+    SRT_FRAME_LOG(VeryVerbose, TEXT("Encoded frame #%d: %d bytes, %s"), 
+        EncodedFrame.FrameNumber, 
+        EncodedFrame.Data.Num(),
+        EncodedFrame.bKeyFrame ? TEXT("KEY") : TEXT("DELTA"));
+    return EEncodeResult::Encoded;
+}
+
+bool FSRTStreamWorker::ApplyOverloadLevel(const FrameBuffer::Frame& Frame)
+{
+    if (!Governor.IsEnabled())
+        return true;
+    
+    const FSRTVideoEncoder::FConfig& Current = Owner->VideoEncoder->GetConfig();
+    const bool bCurrentSize = (Frame.Width == Current.Width && Frame.Height == Current.Height);
+    
+    const int32 Target = CaptureLevel.Load();
+    const int32 Previous = EncoderLevel.Load();
+    if (Target == Previous)
+        return bCurrentSize;
+    
+    // 캡처가 새 단계로 바뀐 뒤의 프레임이 올 때까지는 지금 인코더로
+    const FSRTOverloadGovernor::FLevel& Level = Governor.GetLevel(Target);
+    if (Frame.Width != Level.Width || Frame.Height != Level.Height)
+        return bCurrentSize;
+    
+    // 런타임에 바꾼 비트레이트 등은 유지하고 단계 설정만 - 키프레임 간격은 시간 기준으로 유지
+    FSRTVideoEncoder::FConfig NewConfig = Current;
+    NewConfig.Width = Level.Width;
+    NewConfig.Height = Level.Height;
+    NewConfig.FrameRate = Level.FPS;
+    NewConfig.GOPSize = FMath::Max(1, FMath::RoundToInt((float)Current.GOPSize * Level.FPS / FMath::Max(Current.FrameRate, 1)));
+    if (!Level.Preset.IsEmpty())
+    {
+        NewConfig.Preset = Level.Preset;
+    }
+    
+    const double Now = FPlatformTime::Seconds();
+    if (!Owner->VideoEncoder->Reconfigure(NewConfig))
+    {
+        // 이전 설정으로 다시 열렸음 - 캡처도 되돌림
+        Governor.RevertLevel(Previous, Now);
+        RequestedLevel = Previous;
+        return bCurrentSize;
+    }
+    
+    EncoderLevel = Target;
+    OverloadTransitions++;
+    Governor.OnLevelApplied(Now);
+    PostWorkerEvent(EncodeEvents, FSRTWorkerEvent::EType::EncoderLevelApplied, Target);
+    return true;
+}
+
+void FSRTStreamWorker::SampleOverload(double EncodeMs)
+{
+    // 인코더가 판단한 단계로 바뀐 뒤의 프레임만
+    if (!Governor.IsEnabled() || EncoderLevel.Load() != Governor.GetLevelIndex())
         return;
     
-    SRTNetwork::Stats stats;
-    if (SRTNetwork::GetStats(SRTSocket, stats))
+    const int32 Previous = Governor.GetLevelIndex();
+    if (Governor.AddSample(EncodeMs, Owner->FrameBuffer->GetOverwrittenFrames(), FPlatformTime::Seconds()))
+    {
+        const int32 Level = Governor.GetLevelIndex();
+        PostWorkerEvent(EncodeEvents, FSRTWorkerEvent::EType::OverloadDecision, Previous, Level, *Governor.GetLastReason());
+        RequestedLevel = Level;
+    }
+}
+
+bool FSRTStreamWorker::DeliverEncodedFrame(FEncodedFrame& EncodedFrame)
+{
+    // 풀에서 인코딩하는 사이에 끊겼으면 버리고 IDR부터 재개
+    if (bReconnecting || !HasOutput())
+    {
+        bWaitForKeyFrame = true;
+        return false;
+    }
+    
+    // 공유 출력: 다중화와 전송은 공유 송신 스레드가 수행
+    if (Owner->SharedOutput.IsValid())
     {
-        // Update owner stats
-        Owner->CurrentBitrateKbps = static_cast<float>(stats.mbpsSendRate * 1000.0);
-        Owner->RoundTripTimeMs = static_cast<float>(stats.msRTT);
+        const bool bKeyFrameSubmitted = EncodedFrame.bKeyFrame;
+        if (!Owner->SharedOutput->SubmitFrame(Owner->SharedProgramIndex, MoveTemp(EncodedFrame)))
+        {
+            return false;
+        }
+        Counters.FramesSent++;
+        if (bKeyFrameSubmitted)
+        {
+            OnKeyFrameSent();
+        }
+        return true;
+    }
+    
+    // MPEG-TS 멀티플렉싱
+    TArray<uint8> TSPackets;
+    const FSRTTransportStream::FCaptureStamp CaptureStamp{EncodedFrame.CaptureUtcUs, EncodedFrame.CaptureFrameNumber};
+    SRT_TRACE_STAGE(EncodedFrame.Trace, MuxBegin);
+    if (!Owner->TransportStream->MuxVideoFrame(
+        EncodedFrame.Data,
+        EncodedFrame.PTS,
+        EncodedFrame.DTS,
+        EncodedFrame.bKeyFrame,
+        TSPackets,
+        EncodedFrame.CaptureUtcUs != 0 ? &CaptureStamp : nullptr))
+    {
+        PostWorkerEvent(WorkerEvents, FSRTWorkerEvent::EType::MuxFailed, EncodedFrame.CaptureFrameNumber);
+        return false;
+    }
+    
+    SRT_TRACE_STAGE(EncodedFrame.Trace, MuxEnd);
+    SRT_FRAME_LOG(VeryVerbose, TEXT("Generated %d TS packets (%d bytes)"), 
+        TSPackets.Num() / 188, TSPackets.Num());
+    
+    // 로컬 기록은 복사 후 큐에 넣기만 함 (디스크가 느려도 송신을 막지 않음)
+    if (Owner->RecordingTap.IsValid())
+    {
+        Owner->RecordingTap->Submit(TSPackets, EncodedFrame.PTS, EncodedFrame.bKeyFrame);
+    }
+    
+    // 리스너 모드: 같은 TS 버퍼를 모든 구독자에게 팬아웃
+    if (Owner->ListenerOutput.IsValid())
+    {
+        SRT_TRACE_STAGE(EncodedFrame.Trace, SendBegin);
+        Owner->ListenerOutput->SubmitFrame(TSPackets, EncodedFrame.CaptureTime, EncodedFrame.bKeyFrame);
+        SRT_TRACE_STAGE(EncodedFrame.Trace, SendEnd);
+        SRT_TRACE_COMMIT(EncodedFrame.Trace);
+        IntervalTSBytes += TSPackets.Num();
+        Counters.FramesSent++;
+        return true;
+    }
+    
+    // TS 패킷 전송 - 1316바이트 메시지마다 캡처 시각을 srctime으로 (수신 측 TSBPD가 캡처 간격을 재현)
+    SRT_TRACE_FRAME_ID(SendFrameId, EncodedFrame.Trace.FrameId);
+    SRT_TRACE_STAGE(EncodedFrame.Trace, SendBegin);
+    const ESendResult SendResult = SendWithBackpressure(TSPackets, SourceClock.ToSourceTime(EncodedFrame.CaptureTime));
+    SRT_TRACE_STAGE(EncodedFrame.Trace, SendEnd);
+    if (SendResult == ESendResult::Failed)
+    {
+        // BeginReconnect가 로그를 남기고 상태 이벤트로 사유를 보냄
+        const char* error = FSRTSocket::GetLastErrorString();
+        BeginReconnect(FString::Printf(TEXT("Send failed: %s"), UTF8_TO_TCHAR(error)));
+        return false;
+    }
+    if (SendResult == ESendResult::Dropped)
+    {
+        return true;
+    }
+    
+    Counters.FramesSent++;
+    SRT_TRACE_COMMIT(EncodedFrame.Trace);
+    if (EncodedFrame.bKeyFrame)
+    {
+        OnKeyFrameSent();
+    }
+    
+    // 매 30프레임마다 상태 출력 (게임 스레드가 로그)
+    if (Counters.FramesSent % 30 == 0)
+    {
+        PostWorkerEvent(WorkerEvents, FSRTWorkerEvent::EType::StreamingStatus, Counters.FramesSent, Counters.MessagesSent);
+    }
+    
+    return true;
+}
+
+bool FSRTStreamWorker::IsSendCongested() const
+{
+    // 버퍼에 레이턴시 이상 쌓였거나 지금 당장 한 패킷도 못 넣으면 혼잡
+    if (SRTSocket.GetSendBufferBytes() > SendBufferBudgetBytes)
+        return true;
+    return SRTNetwork::WaitWritable(EpollID.Load(), 0) == 0;
+}
+
+int64 FSRTStreamWorker::GetPacingMaxRate() const
+{
+    // 바이트/초
+    return Owner->PacingMaxRateMbps > 0.0f
+        ? (int64)(Owner->PacingMaxRateMbps * 125000.0)
+        : (int64)Owner->BitrateKbps * 125 * 8;
+}
+
+FSRTStreamWorker::ESendResult FSRTStreamWorker::SendWithBackpressure(const TArray<uint8>& TSPackets, int64 SourceTime)
+{
+    const int32 TTL = Owner->MessageTTLMs > 0 ? Owner->MessageTTLMs : -1;
+    const double FrameInterval = 1.0 / FMath::Max(Owner->StreamFPS, 1.0f);
+    const double Start = FPlatformTime::Seconds();
+    
+    // 페이싱: 프레임을 창(프레임 간격 x 비율) 안에 고르게 - 작은 프레임은 공칭 비트레이트로, 큰 I-프레임도 최고 속도 이하로
+    const bool bPaced = Owner->bEnablePacing;
+    const double PacingWindow = bPaced ? FrameInterval * Owner->PacingWindowFraction : 0.0;
+    if (bPaced)
+    {
+        Pacer.BeginFrame(TSPackets.Num(), PacingWindow, (int64)Owner->BitrateKbps * 125, Start);
+    }
+    
+    // 프레임 중간에 버퍼가 차면 (페이싱 창 +) 반 프레임 시간까지만 기다리고, 그래도 안 되면 나머지를 버림
+    const double Deadline = Start + PacingWindow + 0.5 * FrameInterval;
+    int32 Offset = 0;
+    
+    while (Offset < TSPackets.Num())
+    {
+        int32 Length = TSPackets.Num() - Offset;
+        if (bPaced && !bShouldExit)
+        {
+            double WaitSeconds = 0.0;
+            const int32 Allowed = Pacer.Acquire(Length, FPlatformTime::Seconds(), WaitSeconds);
+            if (Allowed == 0)
+            {
+                FPlatformProcess::Sleep((float)WaitSeconds);
+                continue;
+            }
+            Length = Allowed;
+        }
+        
+        FSRTSocket::FSendResult Result;
+        if (!SRTSocket.SendMessages(TSPackets.GetData() + Offset, Length, SourceTime, TTL, Result))
+        {
+            return ESendResult::Failed;
+        }
+        if (bPaced)
+        {
+            Pacer.Consume(Result.BytesSent);
+        }
+        
+        Counters.MessagesSent += Result.MessagesSent;
+        if (Result.LastMessageNumber >= 0)
+        {
+            Counters.LastMessageNumber = Result.LastMessageNumber;
+        }
+        Offset += Result.BytesSent;
+        
+        if (!Result.bWouldBlock)
+            continue;
+        
+        const int32 WaitMs = (int32)((Deadline - FPlatformTime::Seconds()) * 1000.0);
+        const int32 Ready = (WaitMs > 0 && !bShouldExit) ? SRTNetwork::WaitWritable(EpollID.Load(), WaitMs) : 0;
+        if (Ready <= 0)
+        {
+            // 잘린 PES는 수신 측에서 버려짐 - 다음 IDR부터 다시 디코딩 가능
+            if (Ready < 0 && !bShouldExit && !SRTSocket.IsConnected())
+            {
+                return ESendResult::Failed;
+            }
+            Counters.BackpressureDrops++;
+            bWaitForKeyFrame = true;
+            return ESendResult::Dropped;
+        }
+    }
+    
+    return ESendResult::Sent;
+}
+
+void FSRTStreamWorker::UpdateSRTStats()
+{
+    const double Now = FPlatformTime::Seconds();
+    const double Elapsed = FMath::Max(Now - LastPublishTime, 0.001);
+    LastPublishTime = Now;
+    
+    FSRTNetworkStats Snapshot = Counters;
+    Snapshot.StreamSeconds = Now - StreamStartTime;
+    
+    // 인코딩 단계 (풀 워커에서 셌을 수 있음)
+    Snapshot.DroppedFrames += EncodeDroppedFrames.Load();
+    Snapshot.BackpressureDrops += EncodeBackpressureDrops.Load();
+    const double EncodeSeconds = EncodeCycles.Exchange(0) * FPlatformTime::GetSecondsPerCycle64();
+    const int32 FramesEncoded = EncodedFrameCount.Exchange(0);
+    Snapshot.EncodeMs = FramesEncoded > 0 ? (float)(EncodeSeconds * 1000.0 / FramesEncoded) : 0.0f;
+    Snapshot.EncodeUtilization = (float)(EncodeSeconds / Elapsed);
+    const FSRTOverloadGovernor::FLevel& Level = Governor.GetLevel(EncoderLevel.Load());
+    Snapshot.OverloadLevel = EncoderLevel.Load();
+    Snapshot.EncodeWidth = Level.Width;
+    Snapshot.EncodeHeight = Level.Height;
+    Snapshot.EncodeFPS = (float)Level.FPS;
+    Snapshot.OverloadTransitions = OverloadTransitions.Load();
+    
+    // 공유 출력: 자기 프로그램의 비트레이트와 공유 연결 RTT
+    if (Owner->SharedOutput.IsValid())
+    {
+        FSRTSharedOutput::FProgramStats ProgramStats;
+        if (Owner->SharedOutput->GetProgramStats(Owner->SharedProgramIndex, ProgramStats))
+        {
+            Snapshot.BitrateKbps = ProgramStats.BitrateKbps;
+            Snapshot.CaptureSEIMicroseconds = ProgramStats.CaptureSEIMicroseconds;
+        }
+        Snapshot.RTTMs = Owner->SharedOutput->GetRTTMs();
+        Snapshot.KeyMaterialState = Owner->SharedOutput->GetKeyMaterialState();
+        Snapshot.MessagesSent = Owner->SharedOutput->GetMessagesSent();
+        Snapshot.LastMessageNumber = Owner->SharedOutput->GetLastMessageNumber();
         
-        // Calculate dropped frames from packet loss
-        if (stats.pktSndLossTotal > 0)
+        if (Owner->bRecordLocally)
+        {
+            const FSRTRecordingTap::FStats RecordingStats = Owner->SharedOutput->GetRecordingStats();
+            Snapshot.RecordingDroppedChunks = RecordingStats.DroppedChunks;
+            Snapshot.RecordingSegmentsWritten = RecordingStats.SegmentsWritten;
+        }
+        PublishStats(Snapshot);
+        return;
+    }
+
+    // 다중화는 이 워커 스레드에서만 하므로 잠금 없이 읽음
+    FSRTTransportStream::FProgramStats MuxStats;
+    if (Owner->TransportStream.IsValid() && Owner->TransportStream->GetProgramStats(0, MuxStats) && MuxStats.CaptureSEICount > 0)
+    {
+        Snapshot.CaptureSEIMicroseconds = (float)(MuxStats.CaptureSEICycles * FPlatformTime::GetSecondsPerCycle64() * 1000000.0 / MuxStats.CaptureSEICount);
+    }
+
+    if (Owner->RecordingTap.IsValid())
+    {
+        const FSRTRecordingTap::FStats RecordingStats = Owner->RecordingTap->GetStats();
+        Snapshot.RecordingDroppedChunks = RecordingStats.DroppedChunks;
+        Snapshot.RecordingSegmentsWritten = RecordingStats.SegmentsWritten;
+    }
+    
+    // 리스너 모드: 구독자별 SRT 통계는 SubscriberStats, 여기서는 다중화 출력 비트레이트만
+    if (Owner->ListenerOutput.IsValid())
+    {
+        Snapshot.BitrateKbps = (float)(IntervalTSBytes * 8.0 / Elapsed / 1000.0);
+        IntervalTSBytes = 0;
+        PublishStats(Snapshot);
+        return;
+    }
+    
+    // 직접 연결: SRT 통계 블록 전체 (패킷 손실은 DroppedFrames와 섞지 않음)
+    SRTNetwork::Stats Totals;
+    SRTNetwork::StatsInterval Interval;
+    if (SRTSocket && GroupLinks.Num() > 0)
+    {
+        // 그룹 통계는 고유 송신량만 있으므로 링크별 값은 멤버 소켓에서 직접
+        TArray<SRTNetwork::GroupMember> Members;
+        SRTNetwork::GetGroupMembers(SRTSocket.Get(), Members);
+        MaintainGroupLinks(Members, Now);
+        UpdateBondingStats(Members, Snapshot);
+        if (StatsTracker.Sample(SRTSocket.Get(), Totals, Interval))
         {
-            Owner->DroppedFrames += stats.pktSndLossTotal;
+            Snapshot.PayloadRateMbps = (float)Interval.PayloadMbps;
+            Snapshot.BitrateKbps = (float)(Interval.PayloadMbps * 1000.0);
         }
     }
+    else if (SRTSocket && StatsTracker.Sample(SRTSocket.Get(), Totals, Interval))
+    {
+        Snapshot.SetFromSRT(Totals, Interval);
+        Snapshot.BitrateKbps = (float)(Interval.PayloadMbps * 1000.0);
+        Snapshot.KeyMaterialState = SRTNetwork::GetKeyMaterialState(SRTSocket.Get());
+    }
+    PublishStats(Snapshot);
+}
+
+void FSRTStreamWorker::PublishStats(FSRTNetworkStats& Snapshot)
+{
+    if (StatsExporter.IsOpen())
+    {
+        StatsExporter.Append(Snapshot);
+    }
+    
+    // 게임 스레드는 다음 Tick에서 최신 스냅샷만 가져감
+    Owner->StatsBuffer.Write(Snapshot);
 }
 
 void FSRTStreamWorker::HandleDisconnection()
 {
-    Owner->SetConnectionState(ESRTConnectionState::Error, TEXT("Connection lost"));
-    
-    // 재연결 시도 제거 (bAutoReconnect 변수 없음)
-    // if (Owner->bAutoReconnect && !bShouldExit) {
-    //     UE_LOG(LogCineSRTStream, Log, TEXT("Waiting 2 seconds before reconnect..."));
-    //     FPlatformProcess::Sleep(2.0f); // 2초 대기
-    //     
-    //     if (!bShouldExit) {
-    //         UE_LOG(LogCineSRTStream, Log, TEXT("Attempting to reconnect..."));
-    //         InitializeSRT();
-    //     }
-    // }
+    // 자동 재연결이 꺼져 있거나 종료 중 - 재연결은 BeginReconnect/TryReconnect가 워커 루프 안에서 수행
+    bReconnecting = false;
+    if (!bShouldExit)
+    {
+        PostConnectionState(ESRTConnectionState::Error, TEXT("Connection lost"));
+    }
 }
 
 void FSRTStreamWorker::CheckHealth()
 {
-    static double LastHealthCheck = 0.0;
     double CurrentTime = FPlatformTime::Seconds();
     
     if (CurrentTime - LastHealthCheck >= 5.0) // 5초마다 체크
@@ -1282,8 +3118,5 @@ void FSRTStreamWorker::CheckHealth()
 
 void FSRTStreamWorker::CleanupConnection()
 {
-    if (SRTSocket) {
-        SRTNetwork::CloseSocket(SRTSocket);
-        SRTSocket = nullptr;
-    }
+    SRTSocket.Close();
 } 
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTStreamStats.h"
+#include "CineSRTStream.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UObject/UnrealType.h"
+
+void FSRTNetworkStats::SetFromSRT(const SRTNetwork::Stats& Totals, const SRTNetwork::StatsInterval& Interval)
+{
+    PacketsSent = Totals.pktSentTotal;
+    PacketsRetransmitted = Totals.pktRetransTotal;
+    PacketsLost = Totals.pktSndLossTotal;
+    PacketsDropped = Totals.pktSndDropTotal;
+    BytesSent = (int64)Totals.byteSentTotal;
+    BytesRetransmitted = (int64)Totals.byteRetransTotal;
+    BytesDropped = (int64)Totals.byteSndDropTotal;
+
+    IntervalSeconds = (float)Interval.Seconds;
+    SendRateMbps = (float)Interval.SendMbps;
+    PayloadRateMbps = (float)Interval.PayloadMbps;
+    RetransmitRateMbps = (float)Interval.RetransmitMbps;
+    LossPercent = (float)Interval.LossPercent;
+    RetransmitPercent = (float)Interval.RetransmitPercent;
+    IntervalPacketsLost = (int32)Interval.PacketsLost;
+    IntervalPacketsDropped = (int32)Interval.PacketsDropped;
+    IntervalPacketsRetransmitted = (int32)Interval.PacketsRetransmitted;
+
+    RTTMs = (float)Totals.msRTT;
+    EstimatedBandwidthMbps = (float)Totals.mbpsBandwidth;
+    MaxBandwidthMbps = (float)Totals.mbpsMaxBW;
+    PacketSendPeriodUs = (float)Totals.usPktSndPeriod;
+    FlowWindowPackets = Totals.pktFlowWindow;
+    CongestionWindowPackets = Totals.pktCongestionWindow;
+    FlightSizePackets = Totals.pktFlightSize;
+    SendBufferPackets = Totals.pktSndBuf;
+    SendBufferBytes = Totals.byteSndBuf;
+    SendBufferMs = Totals.msSndBuf;
+    AvailableSendBufferBytes = Totals.byteAvailSndBuf;
+    PeerLatencyMs = Totals.msSndTsbPdDelay;
+}
+
+FSRTStatsExporter::~FSRTStatsExporter()
+{
+    Close();
+}
+
+bool FSRTStatsExporter::Open(const FString& Directory, const FString& FilePrefix, ESRTStatsExportFormat InFormat)
+{
+    Close();
+    Format = InFormat;
+
+    const FString OutputDirectory = Directory.IsEmpty()
+        ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SRTStats"))
+        : Directory;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.CreateDirectoryTree(*OutputDirectory))
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("StatsExporter: Cannot create %s"), *OutputDirectory);
+        return false;
+    }
+
+    const TCHAR* Extension = (Format == ESRTStatsExportFormat::CSV) ? TEXT("csv") : TEXT("jsonl");
+    Path = FPaths::Combine(OutputDirectory, FString::Printf(TEXT("%s_%s.%s"),
+        *FilePrefix, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), Extension));
+
+    File = PlatformFile.OpenWrite(*Path);
+    if (!File)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("StatsExporter: Cannot open %s"), *Path);
+        return false;
+    }
+
+    // CSV 헤더 = 구조체 필드 이름 (필드를 추가하면 자동으로 열이 늘어남)
+    if (Format == ESRTStatsExportFormat::CSV)
+    {
+        TArray<FString> Names;
+        for (TFieldIterator<FProperty> It(FSRTNetworkStats::StaticStruct()); It; ++It)
+        {
+            Names.Add(It->GetName());
+        }
+        WriteLine(FString::Join(Names, TEXT(",")));
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("StatsExporter: Writing %s"), *Path);
+    return true;
+}
+
+void FSRTStatsExporter::Append(const FSRTNetworkStats& Stats)
+{
+    if (!File)
+        return;
+
+    TArray<FString> Fields;
+    for (TFieldIterator<FProperty> It(FSRTNetworkStats::StaticStruct()); It; ++It)
+    {
+        FString Value;
+        It->ExportTextItem_Direct(Value, It->ContainerPtrToValuePtr<void>(&Stats), nullptr, nullptr, PPF_None);
+
+        if (Format == ESRTStatsExportFormat::CSV)
+        {
+            Fields.Add(MoveTemp(Value));
+        }
+        else
+        {
+            Fields.Add(FString::Printf(TEXT("\"%s\":%s"), *It->GetName(), *Value));
+        }
+    }
+
+    if (Format == ESRTStatsExportFormat::CSV)
+    {
+        WriteLine(FString::Join(Fields, TEXT(",")));
+    }
+    else
+    {
+        WriteLine(TEXT("{") + FString::Join(Fields, TEXT(",")) + TEXT("}"));
+    }
+}
+
+void FSRTStatsExporter::Close()
+{
+    if (File)
+    {
+        File->Flush();
+        delete File;
+        File = nullptr;
+    }
+}
+
+void FSRTStatsExporter::WriteLine(const FString& Line)
+{
+    const FTCHARToUTF8 Utf8(*(Line + TEXT("\n")));
+    File->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    // 1초에 한 줄 - 프로세스가 죽어도 남도록 매번 플러시
+    File->Flush();
+}
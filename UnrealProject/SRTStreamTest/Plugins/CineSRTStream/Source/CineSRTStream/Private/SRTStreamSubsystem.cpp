@@ -0,0 +1,313 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTStreamSubsystem.h"
+#include "SRTStreamComponent.h"
+#include "CineSRTStream.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "RHI.h"
+#include "Stats/Stats.h"
+
+static TAutoConsoleVariable<int32> CVarEncodePool(
+    TEXT("CineSRT.EncodePool"),
+    1,
+    TEXT("1 = SRT streams share a fixed encode worker pool, 0 = each stream encodes on its own worker thread (applies to streams started afterwards)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEncodeWorkers(
+    TEXT("CineSRT.EncodeWorkers"),
+    0,
+    TEXT("Encode pool worker count (0 = physical cores / 4, clamped to 1..8). Read when the pool is created"),
+    ECVF_Default);
+
+void USRTStreamSubsystem::Deinitialize()
+{
+    // 스트리밍 중인 컴포넌트가 풀 참조를 들고 있으면 그 컴포넌트가 멈출 때 풀이 해제됨
+    Streams.Reset();
+    EncodePool.Reset();
+    // 렌더 명령이 들고 있는 참조가 끝나면 해제됨
+    BatchedCaptureTimer.Reset();
+    IndividualCaptureTimer.Reset();
+    CaptureAtlases.Reset();
+    CaptureAtlasTileSizes.Reset();
+    Super::Deinitialize();
+}
+
+TStatId USRTStreamSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USRTStreamSubsystem, STATGROUP_Tickables);
+}
+
+void USRTStreamSubsystem::RegisterStream(USRTStreamComponent* Stream)
+{
+    if (Stream)
+    {
+        Streams.AddUnique(Stream);
+    }
+}
+
+void USRTStreamSubsystem::UnregisterStream(USRTStreamComponent* Stream)
+{
+    Streams.Remove(Stream);
+}
+
+TSharedPtr<FSRTEncodePool> USRTStreamSubsystem::AcquireEncodePool()
+{
+    if (CVarEncodePool.GetValueOnGameThread() == 0)
+        return nullptr;
+
+    if (!EncodePool.IsValid())
+    {
+        const int32 RequestedWorkers = CVarEncodeWorkers.GetValueOnGameThread();
+        const int32 WorkerCount = RequestedWorkers > 0
+            ? RequestedWorkers
+            : FMath::Clamp(FPlatformMisc::NumberOfCores() / 4, 1, 8);
+
+        EncodePool = MakeShared<FSRTEncodePool>(WorkerCount);
+        LastPoolSample = FSRTEncodePool::FStats();
+        LastSampleTime = FPlatformTime::Seconds();
+
+        UE_LOG(LogCineSRTStream, Log, TEXT("StreamSubsystem: Encode pool %d workers, %d encoder threads per stream"),
+            EncodePool->GetWorkerCount(), GetEncoderThreadsPerStream());
+    }
+    return EncodePool;
+}
+
+int32 USRTStreamSubsystem::GetEncoderThreadsPerStream() const
+{
+    const int32 WorkerCount = EncodePool.IsValid() ? FMath::Max(EncodePool->GetWorkerCount(), 1) : 1;
+    return FMath::Max(FPlatformMisc::NumberOfCores() / WorkerCount, 1);
+}
+
+void USRTStreamSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    const double Now = FPlatformTime::Seconds();
+    CaptureDueStreams(Now);
+
+    if (Now - LastSampleTime >= 1.0)
+    {
+        SampleStats(Now);
+    }
+}
+
+void USRTStreamSubsystem::CaptureDueStreams(double Now)
+{
+    SRT_TRACE_SCOPE(CineSRT_CaptureDueStreams);
+
+    // 워커 이벤트 - 컴포넌트 틱 없이 서브시스템만 도는 경우(커맨드렛)에도 상태가 갱신되도록
+    // 상태 변경 핸들러가 스트림을 멈추면(UnregisterStream) 목록이 바뀌므로 복사본으로
+    const TArray<TWeakObjectPtr<USRTStreamComponent>, TInlineAllocator<16>> EventStreams(Streams);
+    for (const TWeakObjectPtr<USRTStreamComponent>& WeakStream : EventStreams)
+    {
+        if (USRTStreamComponent* Stream = WeakStream.Get())
+        {
+            if (Stream->IsStreaming())
+            {
+                Stream->ProcessWorkerEvents();
+            }
+        }
+    }
+
+    Streams.RemoveAll([](const TWeakObjectPtr<USRTStreamComponent>& Stream) { return !Stream.IsValid(); });
+
+    if (!BatchedCaptureTimer.IsValid())
+    {
+        BatchedCaptureTimer = MakeShared<FSRTGPUTimer, ESPMode::ThreadSafe>();
+        IndividualCaptureTimer = MakeShared<FSRTGPUTimer, ESPMode::ThreadSafe>();
+    }
+
+    // 컴포넌트 틱(TG_PostUpdateWork)이 끝난 뒤라 카메라 위치는 이번 프레임 기준
+    TArray<FGPUReadbackManager::FReadbackRequest> Batch;
+    TMap<FIntPoint, TArray<USRTStreamComponent*>> BatchedGroups;
+    for (const TWeakObjectPtr<USRTStreamComponent>& WeakStream : Streams)
+    {
+        USRTStreamComponent* Stream = WeakStream.Get();
+        if (!Stream->IsStreaming())
+            continue;
+
+        // 과부하 조정 단계가 바뀌었으면 이번 캡처부터 새 크기/간격
+        Stream->ApplyOverloadLevel();
+        if (Now - Stream->LastCaptureTime < 1.0 / Stream->CaptureFPS)
+            continue;
+        Stream->LastCaptureTime = Now;
+
+        // 패턴/파일 공급원 - 렌더링이 없으므로 바로 생성 요청
+        if (Stream->FrameSource != ESRTFrameSourceType::SceneCapture)
+        {
+            Stream->CaptureFrame();
+            continue;
+        }
+
+        if (Stream->bBatchedCapture && Stream->SceneCapture && Stream->RenderTarget)
+        {
+            BatchedGroups.FindOrAdd(FIntPoint(Stream->RenderTarget->SizeX, Stream->RenderTarget->SizeY)).Add(Stream);
+            continue;
+        }
+        CaptureIndividually(Stream, Batch);
+    }
+
+    CaptureStats.BatchedCameras = 0;
+    CaptureStats.Atlases = 0;
+    for (const TPair<FIntPoint, TArray<USRTStreamComponent*>>& Group : BatchedGroups)
+    {
+        // 카메라 하나뿐이면 공유할 작업이 없으니 개별 캡처
+        if (Group.Value.Num() >= 2 && CaptureBatched(Group.Value, Batch))
+        {
+            CaptureStats.BatchedCameras += Group.Value.Num();
+            CaptureStats.Atlases++;
+            continue;
+        }
+        for (USRTStreamComponent* Stream : Group.Value)
+        {
+            CaptureIndividually(Stream, Batch);
+        }
+    }
+
+    PoolStats.LastReadbackBatchSize = Batch.Num();
+    FGPUReadbackManager::SubmitReadbacks(MoveTemp(Batch));
+}
+
+void USRTStreamSubsystem::CaptureIndividually(USRTStreamComponent* Stream, TArray<FGPUReadbackManager::FReadbackRequest>& OutBatch)
+{
+    FGPUReadbackManager::FReadbackRequest Request;
+    IndividualCaptureTimer->Begin();
+    const bool bPrepared = Stream->PrepareCapture(Request);
+    IndividualCaptureTimer->End(bPrepared ? 1 : 0);
+    if (bPrepared)
+    {
+        OutBatch.Add(MoveTemp(Request));
+    }
+}
+
+bool USRTStreamSubsystem::CaptureBatched(const TArray<USRTStreamComponent*>& Group, TArray<FGPUReadbackManager::FReadbackRequest>& OutBatch)
+{
+    SRT_TRACE_SCOPE(CineSRT_CaptureBatched);
+
+    const FIntPoint TileSize(Group[0]->RenderTarget->SizeX, Group[0]->RenderTarget->SizeY);
+    int32 Columns = 0;
+    UTextureRenderTarget2D* Atlas = GetCaptureAtlas(TileSize, Group.Num(), Columns);
+    if (!Atlas)
+        return false;
+
+    FTextureRenderTargetResource* AtlasResource = Atlas->GameThread_GetRenderTargetResource();
+    if (!AtlasResource)
+        return false;
+
+    TArray<FSRTMultiViewCapture::FView> Views;
+    for (int32 i = 0; i < Group.Num(); i++)
+    {
+        FSRTMultiViewCapture::FView& View = Views.AddDefaulted_GetRef();
+        View.SceneCapture = Group[i]->SceneCapture;
+        const FIntPoint Origin((i % Columns) * TileSize.X, (i / Columns) * TileSize.Y);
+        View.Rect = FIntRect(Origin, Origin + TileSize);
+    }
+
+    BatchedCaptureTimer->Begin();
+    const bool bRendered = FSRTMultiViewCapture::RenderViews(GetWorld(), Atlas, Views);
+    BatchedCaptureTimer->End(bRendered ? Group.Num() : 0);
+    if (!bRendered)
+        return false;
+
+    // 아틀라스 타일 요청은 연속으로 넣어야 리드백 한 번으로 읽힘
+    for (int32 i = 0; i < Group.Num(); i++)
+    {
+        FGPUReadbackManager::FReadbackRequest Request;
+        if (Group[i]->PrepareCapture(Request, false))
+        {
+            Request.Resource = AtlasResource;
+            Request.SourceRect = Views[i].Rect;
+            OutBatch.Add(MoveTemp(Request));
+        }
+    }
+    return true;
+}
+
+UTextureRenderTarget2D* USRTStreamSubsystem::GetCaptureAtlas(FIntPoint TileSize, int32 TileCount, int32& OutColumns)
+{
+    const int32 Index = CaptureAtlasTileSizes.IndexOfByKey(TileSize);
+    if (Index != INDEX_NONE)
+    {
+        UTextureRenderTarget2D* Existing = CaptureAtlases[Index];
+        const int32 Columns = Existing->SizeX / TileSize.X;
+        if (Columns * (Existing->SizeY / TileSize.Y) >= TileCount)
+        {
+            OutColumns = Columns;
+            return Existing;
+        }
+    }
+
+    // 정사각형에 가까운 격자 (4대 1080p → 3840x2160)
+    const int32 Columns = FMath::CeilToInt(FMath::Sqrt((float)TileCount));
+    const int32 Rows = FMath::DivideAndRoundUp(TileCount, Columns);
+    const int32 MaxDimension = (int32)GetMax2DTextureDimension();
+    if (Columns * TileSize.X > MaxDimension || Rows * TileSize.Y > MaxDimension)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("StreamSubsystem: %d cameras at %dx%d exceed the max texture size, capturing individually"),
+            TileCount, TileSize.X, TileSize.Y);
+        return nullptr;
+    }
+
+    // 스트림 렌더 타깃과 같은 포맷 (SetupSceneCapture)
+    UTextureRenderTarget2D* Atlas = NewObject<UTextureRenderTarget2D>(this);
+    Atlas->InitAutoFormat(Columns * TileSize.X, Rows * TileSize.Y);
+    Atlas->RenderTargetFormat = RTF_RGBA8;
+    Atlas->bForceLinearGamma = true;
+    Atlas->TargetGamma = 1.0f;
+    Atlas->UpdateResourceImmediate(true);
+
+    if (Index != INDEX_NONE)
+    {
+        CaptureAtlases[Index] = Atlas;
+    }
+    else
+    {
+        CaptureAtlases.Add(Atlas);
+        CaptureAtlasTileSizes.Add(TileSize);
+    }
+
+    UE_LOG(LogCineSRTStream, Log, TEXT("StreamSubsystem: Capture atlas %dx%d (%dx%d tiles of %dx%d)"),
+        Atlas->SizeX, Atlas->SizeY, Columns, Rows, TileSize.X, TileSize.Y);
+    OutColumns = Columns;
+    return Atlas;
+}
+
+void USRTStreamSubsystem::SampleStats(double Now)
+{
+    const double Elapsed = FMath::Max(Now - LastSampleTime, 0.001);
+    LastSampleTime = Now;
+    PoolStats.StreamCount = Streams.Num();
+
+    if (BatchedCaptureTimer.IsValid())
+    {
+        BatchedCaptureTimer->ConsumeAverageMsPerView(CaptureStats.BatchedGPUMsPerCamera);
+        IndividualCaptureTimer->ConsumeAverageMsPerView(CaptureStats.IndividualGPUMsPerCamera);
+    }
+
+    if (!EncodePool.IsValid())
+    {
+        PoolStats.WorkerCount = 0;
+        PoolStats.EncoderThreadsPerStream = 0;
+        PoolStats.Utilization = 0.0f;
+        PoolStats.JobsPerSecond = 0.0f;
+        PoolStats.AverageQueueWaitMs = 0.0f;
+        PoolStats.QueuedStreams = 0;
+        return;
+    }
+
+    const FSRTEncodePool::FStats Sample = EncodePool->GetStats();
+    const int64 Jobs = Sample.JobsCompleted - LastPoolSample.JobsCompleted;
+
+    PoolStats.WorkerCount = Sample.WorkerCount;
+    PoolStats.EncoderThreadsPerStream = GetEncoderThreadsPerStream();
+    PoolStats.Utilization = (float)((Sample.BusySeconds - LastPoolSample.BusySeconds) / (Elapsed * FMath::Max(Sample.WorkerCount, 1)));
+    PoolStats.JobsPerSecond = (float)(Jobs / Elapsed);
+    PoolStats.AverageQueueWaitMs = Jobs > 0
+        ? (float)((Sample.QueueWaitSeconds - LastPoolSample.QueueWaitSeconds) * 1000.0 / Jobs)
+        : 0.0f;
+    PoolStats.QueuedStreams = Sample.QueuedStreams;
+
+    LastPoolSample = Sample;
+}
@@ -3,17 +3,116 @@
 #include "SRTTransportStream.h"
 #include "CineSRTStream.h"  // 이것도 추가!
 #include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Algo/BinarySearch.h"
+#include "SRTFrameTrace.h"
 
 // AV_NOPTS_VALUE 정의
 #ifndef AV_NOPTS_VALUE
 #define AV_NOPTS_VALUE ((int64_t)UINT64_C(0x8000000000000000))
 #endif
 
+namespace
+{
+    // Annex B NAL 유닛 하나 (Start = 시작 코드 위치, Header = NAL 헤더 위치)
+    struct FNalUnit
+    {
+        int32 Start;
+        int32 Header;
+        int32 End;
+        int32 Type;
+    };
+    
+    // H.264: nal_unit_type = b & 0x1F, HEVC: (b >> 1) & 0x3F
+    void ScanNalUnits(const uint8* data, int32 size, bool bHEVC, TArray<FNalUnit, TInlineAllocator<16>>& OutUnits)
+    {
+        OutUnits.Reset();
+        int32 i = 0;
+        while (i + 3 <= size)
+        {
+            if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+            {
+                const int32 Start = (i > 0 && data[i - 1] == 0) ? i - 1 : i;
+                const int32 Header = i + 3;
+                if (OutUnits.Num() > 0)
+                {
+                    OutUnits.Last().End = Start;
+                }
+                if (Header < size)
+                {
+                    const int32 Type = bHEVC ? (data[Header] >> 1) & 0x3F : data[Header] & 0x1F;
+                    OutUnits.Add({Start, Header, size, Type});
+                }
+                i = Header;
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+    
+    // 접근 단위 구분자 (모든 슬라이스 타입 허용)
+    const uint8 H264AUD[] = {0x00, 0x00, 0x00, 0x01, 0x09, 0xF0};
+    const uint8 HEVCAUD[] = {0x00, 0x00, 0x00, 0x01, 0x46, 0x01, 0x50};
+    
+    // 캡처 타임스탬프 SEI: user_data_unregistered(5), 크기 30 = UUID 16 + 버전/시계/시각/프레임 번호 14
+    const uint8 CaptureSEIVersion = 1;
+    const uint8 CaptureSEIClockUTC = 0;
+    
+    // SEI NAL 하나 추가 (H.264 nal_unit_type 6 / HEVC prefix SEI 39), 에뮬레이션 방지 바이트 포함
+    void AppendCaptureSEI(TArray<uint8>& Out, bool bHEVC, const FSRTTransportStream::FCaptureStamp& Stamp)
+    {
+        uint8 Rbsp[2 + 30 + 1];
+        int32 Pos = 0;
+        Rbsp[Pos++] = 5;   // payloadType
+        Rbsp[Pos++] = 30;  // payloadSize
+        FMemory::Memcpy(Rbsp + Pos, FSRTTransportStream::CaptureSEIUuid, sizeof(FSRTTransportStream::CaptureSEIUuid));
+        Pos += sizeof(FSRTTransportStream::CaptureSEIUuid);
+        Rbsp[Pos++] = CaptureSEIVersion;
+        Rbsp[Pos++] = CaptureSEIClockUTC;
+        for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+        {
+            Rbsp[Pos++] = (uint8)((uint64)Stamp.CaptureUtcUs >> Shift);
+        }
+        for (int32 Shift = 24; Shift >= 0; Shift -= 8)
+        {
+            Rbsp[Pos++] = (uint8)(Stamp.FrameNumber >> Shift);
+        }
+        Rbsp[Pos++] = 0x80;  // rbsp_trailing_bits
+        
+        const uint8 H264Header[] = {0x00, 0x00, 0x00, 0x01, 0x06};
+        const uint8 HEVCHeader[] = {0x00, 0x00, 0x00, 0x01, 0x4E, 0x01};
+        if (bHEVC)
+        {
+            Out.Append(HEVCHeader, UE_ARRAY_COUNT(HEVCHeader));
+        }
+        else
+        {
+            Out.Append(H264Header, UE_ARRAY_COUNT(H264Header));
+        }
+        
+        // 00 00 뒤에 00~03이 오면 03 삽입 (시각 상위 바이트와 작은 프레임 번호에서 생김)
+        int32 Zeros = 0;
+        for (int32 i = 0; i < Pos; i++)
+        {
+            if (Zeros >= 2 && Rbsp[i] <= 0x03)
+            {
+                Out.Add(0x03);
+                Zeros = 0;
+            }
+            Out.Add(Rbsp[i]);
+            Zeros = (Rbsp[i] == 0) ? Zeros + 1 : 0;
+        }
+    }
+}
+
+const uint8 FSRTTransportStream::CaptureSEIUuid[16] = {'C', 'i', 'n', 'e', 'S', 'R', 'T', '-', 'C', 'a', 'p', 't', 'u', 'r', 'e', 0x01};
+
 FSRTTransportStream::FSRTTransportStream()
     : bIsInitialized(false)
     , TotalPackets(0)
     , TotalBytes(0)
-    , LastPCR(0)
     , LastPAT(0)
     , LastPMT(0)
     , StartTime(0.0)
@@ -30,64 +129,649 @@ bool FSRTTransportStream::Initialize(const FConfig& InConfig)
 {
     Config = InConfig;
     StartTime = FPlatformTime::Seconds();
+    Programs.Reset();
+    TableVersion = 0;
+    LastPAT = 0;
+    LastPMT = 0;
+    
+    // 단일 프로그램 모드: 기존 설정 그대로 프로그램 0 등록
+    if (!Config.bMultiProgram)
+    {
+        FProgram& Program = Programs.AddDefaulted_GetRef();
+        Program.Config.ServiceID = Config.ServiceID;
+        Program.Config.PMTPID = Config.PMTPID;
+        Program.Config.VideoPID = Config.VideoPID;
+        Program.Config.PCRPID = Config.PCRPID;
+        Program.Config.VideoStreamType = Config.VideoStreamType;
+        Program.Config.ServiceName = Config.ServiceName;
+        AssignDataPIDs(Program.Config, Config.bEnableSCTE35, Config.MetadataFormat);
+        Program.bActive = true;
+    }
+    
     bIsInitialized = true;
     
-    UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Initialized with service ID %d, video PID 0x%04X"),
-        Config.ServiceID, Config.VideoPID);
+    UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Initialized with service ID %d, video PID 0x%04X%s"),
+        Config.ServiceID, Config.VideoPID, Config.bMultiProgram ? TEXT(" (MPTS)") : TEXT(""));
     
     return true;
 }
 
 void FSRTTransportStream::Shutdown()
 {
+    // 캡처 SEI 삽입 비용 (프레임당, 접근 단위 재구성 전체) - 소멸자의 두 번째 호출에서는 생략
+    for (int32 i = 0; bIsInitialized && i < Programs.Num(); i++)
+    {
+        const FProgramStats& Stats = Programs[i].Stats;
+        if (Stats.CaptureSEICount > 0)
+        {
+            UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Program %d capture SEI on %lld frames, %.2f us/frame"),
+                i, Stats.CaptureSEICount,
+                Stats.CaptureSEICycles * FPlatformTime::GetSecondsPerCycle64() * 1000000.0 / Stats.CaptureSEICount);
+        }
+    }
+    
     bIsInitialized = false;
     UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Shutdown complete"));
 }
 
-bool FSRTTransportStream::MuxH264Frame(const TArray<uint8>& H264Data, 
-                                       int64 PTS, 
-                                       int64 DTS,
-                                       bool bKeyFrame,
-                                       TArray<uint8>& OutTSPackets)
+int32 FSRTTransportStream::AddProgram(const FString& ServiceName,
+                                      bool bEnableSCTE35,
+                                      EMetadataFormat MetadataFormat,
+                                      uint8 VideoStreamType)
+{
+    // 제거된 슬롯 재사용 - 같은 슬롯은 항상 같은 PID를 받는다
+    int32 Index = Programs.IndexOfByPredicate([](const FProgram& P) { return !P.bActive; });
+    if (Index == INDEX_NONE)
+    {
+        if (Programs.Num() >= TS_MAX_PROGRAMS)
+        {
+            UE_LOG(LogCineSRTStream, Warning, TEXT("SRTTransportStream: Program limit reached (%d)"), TS_MAX_PROGRAMS);
+            return INDEX_NONE;
+        }
+        Index = Programs.AddDefaulted();
+    }
+    
+    // PID 자동 할당: PMT는 1씩, 비디오는 0x10 간격 (오디오/데이터 PID 여유)
+    FProgram& Program = Programs[Index];
+    Program = FProgram();
+    Program.Config.ServiceID = Config.ServiceID + Index;
+    Program.Config.PMTPID = Config.PMTPID + Index;
+    Program.Config.VideoPID = Config.VideoPID + Index * 0x10;
+    Program.Config.PCRPID = Program.Config.VideoPID;
+    Program.Config.VideoStreamType = VideoStreamType;
+    Program.Config.ServiceName = ServiceName.IsEmpty()
+        ? FString::Printf(TEXT("%s-%d"), *Config.ServiceName, Index + 1)
+        : ServiceName;
+    AssignDataPIDs(Program.Config, bEnableSCTE35, MetadataFormat);
+    Program.bActive = true;
+    
+    // PAT가 바뀌었으므로 버전 증가 후 즉시 재전송
+    TableVersion = (TableVersion + 1) & 0x1F;
+    LastPAT = 0;
+    LastPMT = 0;
+    
+    UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Program %d added (service %d, PMT 0x%04X, video 0x%04X)"),
+        Index, Program.Config.ServiceID, Program.Config.PMTPID, Program.Config.VideoPID);
+    
+    return Index;
+}
+
+void FSRTTransportStream::RemoveProgram(int32 ProgramIndex)
+{
+    if (!Programs.IsValidIndex(ProgramIndex) || !Programs[ProgramIndex].bActive)
+        return;
+    
+    Programs[ProgramIndex].bActive = false;
+    {
+        FScopeLock Lock(&EventLock);
+        Programs[ProgramIndex].PendingSplices.Empty();
+        Programs[ProgramIndex].PendingMetadata.Empty();
+    }
+    TableVersion = (TableVersion + 1) & 0x1F;
+    LastPAT = 0;
+    
+    UE_LOG(LogCineSRTStream, Log, TEXT("SRTTransportStream: Program %d removed"), ProgramIndex);
+}
+
+bool FSRTTransportStream::GetProgramConfig(int32 ProgramIndex, FProgramConfig& OutConfig) const
+{
+    if (!Programs.IsValidIndex(ProgramIndex) || !Programs[ProgramIndex].bActive)
+        return false;
+    
+    OutConfig = Programs[ProgramIndex].Config;
+    return true;
+}
+
+bool FSRTTransportStream::GetProgramStats(int32 ProgramIndex, FProgramStats& OutStats) const
+{
+    if (!Programs.IsValidIndex(ProgramIndex))
+        return false;
+    
+    OutStats = Programs[ProgramIndex].Stats;
+    return true;
+}
+
+bool FSRTTransportStream::MuxVideoFrame(const TArray<uint8>& VideoData, 
+                                        int64 PTS, 
+                                        int64 DTS,
+                                        bool bKeyFrame,
+                                        TArray<uint8>& OutTSPackets,
+                                        const FCaptureStamp* CaptureStamp)
 {
+    return MuxVideoFrame(0, VideoData, PTS, DTS, bKeyFrame, OutTSPackets, CaptureStamp);
+}
+
+bool FSRTTransportStream::MuxVideoFrame(int32 ProgramIndex,
+                                        const TArray<uint8>& VideoData, 
+                                        int64 PTS, 
+                                        int64 DTS,
+                                        bool bKeyFrame,
+                                        TArray<uint8>& OutTSPackets,
+                                        const FCaptureStamp* CaptureStamp)
+{
+    SRT_TRACE_SCOPE(CineSRT_MuxH264Frame);
+    
     if (!bIsInitialized)
         return false;
     
+    if (!Programs.IsValidIndex(ProgramIndex) || !Programs[ProgramIndex].bActive)
+        return false;
+    
     // 현재 시간 (마이크로초)
     double CurrentTime = FPlatformTime::Seconds();
     int64 CurrentTimeUs = (CurrentTime - StartTime) * 1000000.0;
     
-    // PAT/PMT 주기적 전송
-    if (CurrentTimeUs - LastPAT > Config.PATIntervalMs * 1000)
+    // PAT/PMT 주기적 전송 + 키프레임마다 (키프레임에서 자른 세그먼트/중간 합류가 바로 디코딩 가능)
+    if (bKeyFrame || CurrentTimeUs - LastPAT > Config.PATIntervalMs * 1000)
     {
         GeneratePAT(OutTSPackets);
         LastPAT = CurrentTimeUs;
     }
     
-    if (CurrentTimeUs - LastPMT > Config.PATIntervalMs * 1000)
+    if (bKeyFrame || CurrentTimeUs - LastPMT > Config.PATIntervalMs * 1000)
     {
         GeneratePMT(OutTSPackets);
         LastPMT = CurrentTimeUs;
     }
     
-    // PES 패킷 생성
-    WritePES(H264Data.GetData(), H264Data.Num(), PTS, DTS, bKeyFrame, OutTSPackets);
+    // PES 패킷 생성 (PCR은 프로그램별로 WritePES에서 삽입)
+    FProgram& Program = Programs[ProgramIndex];
+    const uint64 PrepareStart = CaptureStamp ? FPlatformTime::Cycles64() : 0;
+    const TArray<uint8>& AccessUnit = PrepareAccessUnit(Program, VideoData, bKeyFrame, CaptureStamp);
+    if (CaptureStamp)
+    {
+        Program.Stats.CaptureSEICount++;
+        Program.Stats.CaptureSEICycles += (int64)(FPlatformTime::Cycles64() - PrepareStart);
+    }
+    WritePES(Program, AccessUnit.GetData(), AccessUnit.Num(), PTS, DTS, bKeyFrame, OutTSPackets);
+    Program.Stats.FrameCount++;
     
-    // PCR 삽입 여부 확인
-    if (CurrentTimeUs - LastPCR > Config.PCRIntervalMs * 1000)
+    // 이 프레임에 맞춰 예약된 SCTE-35/메타데이터 (비디오 패킷 뒤에 붙임)
+    if (Program.Config.SCTE35PID != 0 || Program.Config.MetadataPID != 0)
     {
-        // 다음 비디오 패킷에 PCR 포함하도록 플래그 설정
-        LastPCR = CurrentTimeUs;
+        EmitScheduledData(Program, PTS, OutTSPackets);
     }
     
     return true;
 }
 
-void FSRTTransportStream::WritePES(const uint8* data, int size, 
+const TArray<uint8>& FSRTTransportStream::PrepareAccessUnit(FProgram& program, const TArray<uint8>& data, bool key_frame,
+                                                            const FCaptureStamp* capture_stamp)
+{
+    const bool bHEVC = (program.Config.VideoStreamType == TS_STREAM_TYPE_HEVC);
+    const int32 AUDType = bHEVC ? 35 : 9;
+    
+    TArray<FNalUnit, TInlineAllocator<16>> Units;
+    ScanNalUnits(data.GetData(), data.Num(), bHEVC, Units);
+    
+    auto IsParameterSet = [bHEVC](int32 Type)
+    {
+        return bHEVC ? (Type >= 32 && Type <= 34) : (Type == 7 || Type == 8);  // VPS/SPS/PPS, SPS/PPS
+    };
+    
+    const bool bHasAUD = Units.Num() > 0 && Units[0].Type == AUDType;
+    bool bHasParameterSets = false;
+    for (const FNalUnit& Unit : Units)
+    {
+        if (IsParameterSet(Unit.Type))
+        {
+            bHasParameterSets = true;
+            break;
+        }
+    }
+    
+    // 키프레임의 파라미터 셋 보관 (인코더가 첫 IDR에만 넣는 경우 대비)
+    if (key_frame && bHasParameterSets)
+    {
+        program.ParameterSets.Reset();
+        for (const FNalUnit& Unit : Units)
+        {
+            if (IsParameterSet(Unit.Type))
+            {
+                program.ParameterSets.Append(bHEVC ? HEVCAUD : H264AUD, 4);  // 4바이트 시작 코드
+                program.ParameterSets.Append(data.GetData() + Unit.Header, Unit.End - Unit.Header);
+            }
+        }
+    }
+    
+    // 캡처 SEI는 첫 VCL NAL 바로 앞 (AUD/파라미터 셋/인코더 SEI 뒤)
+    int32 SEIOffset = INDEX_NONE;
+    if (capture_stamp)
+    {
+        for (const FNalUnit& Unit : Units)
+        {
+            if (bHEVC ? (Unit.Type <= 31) : (Unit.Type >= 1 && Unit.Type <= 5))
+            {
+                SEIOffset = Unit.Start;
+                break;
+            }
+        }
+    }
+    
+    const bool bInsertParameterSets = key_frame && !bHasParameterSets && program.ParameterSets.Num() > 0;
+    if (bHasAUD && !bInsertParameterSets && SEIOffset == INDEX_NONE)
+    {
+        return data;
+    }
+    
+    // AUD → (파라미터 셋) → 나머지(첫 슬라이스 앞에 캡처 SEI) 순서로 재구성
+    TArray<uint8>& Out = program.AccessUnit;
+    Out.Reset(data.Num() + program.ParameterSets.Num() + 64);
+    
+    int32 Rest = 0;
+    if (bHasAUD)
+    {
+        Out.Append(data.GetData(), Units[0].End);
+        Rest = Units[0].End;
+    }
+    else if (bHEVC)
+    {
+        Out.Append(HEVCAUD, UE_ARRAY_COUNT(HEVCAUD));
+    }
+    else
+    {
+        Out.Append(H264AUD, UE_ARRAY_COUNT(H264AUD));
+    }
+    
+    if (bInsertParameterSets)
+    {
+        Out.Append(program.ParameterSets);
+    }
+    
+    if (SEIOffset != INDEX_NONE)
+    {
+        Out.Append(data.GetData() + Rest, SEIOffset - Rest);
+        AppendCaptureSEI(Out, bHEVC, *capture_stamp);
+        Rest = SEIOffset;
+    }
+    
+    Out.Append(data.GetData() + Rest, data.Num() - Rest);
+    return Out;
+}
+
+void FSRTTransportStream::AssignDataPIDs(FProgramConfig& ProgramConfig, bool bEnableSCTE35, EMetadataFormat MetadataFormat) const
+{
+    // 비디오 PID + 1은 오디오용으로 비워둠 (프로그램 간 PID 간격 0x10 안에서 할당)
+    ProgramConfig.SCTE35PID = bEnableSCTE35 ? ProgramConfig.VideoPID + 2 : 0;
+    ProgramConfig.MetadataPID = (MetadataFormat != EMetadataFormat::None) ? ProgramConfig.VideoPID + 3 : 0;
+    ProgramConfig.MetadataFormat = MetadataFormat;
+}
+
+bool FSRTTransportStream::ScheduleSpliceEvent(int32 ProgramIndex, const FSpliceEvent& Event)
+{
+    FScopeLock Lock(&EventLock);
+    
+    if (!Programs.IsValidIndex(ProgramIndex) || !Programs[ProgramIndex].bActive)
+        return false;
+    
+    FProgram& Program = Programs[ProgramIndex];
+    if (Program.Config.SCTE35PID == 0)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("SRTTransportStream: SCTE-35 is not enabled for program %d"), ProgramIndex);
+        return false;
+    }
+    
+    if (Program.PendingSplices.Num() >= MaxPendingEvents)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("SRTTransportStream: Too many pending SCTE-35 events"));
+        return false;
+    }
+    
+    // PTS 순 정렬 유지
+    const int32 InsertAt = Algo::UpperBoundBy(Program.PendingSplices, Event.PTS, &FSpliceEvent::PTS);
+    Program.PendingSplices.Insert(Event, InsertAt);
+    return true;
+}
+
+bool FSRTTransportStream::ScheduleMetadata(int32 ProgramIndex, int64 PTS, const TArray<uint8>& Payload)
+{
+    // PES_packet_length(16비트)에 들어가야 함: 헤더 확장 3 + PTS 5
+    if (Payload.Num() == 0 || Payload.Num() > 0xFFFF - 8)
+        return false;
+    
+    FScopeLock Lock(&EventLock);
+    
+    if (!Programs.IsValidIndex(ProgramIndex) || !Programs[ProgramIndex].bActive)
+        return false;
+    
+    FProgram& Program = Programs[ProgramIndex];
+    if (Program.Config.MetadataPID == 0)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("SRTTransportStream: Timed metadata is not enabled for program %d"), ProgramIndex);
+        return false;
+    }
+    
+    if (Program.PendingMetadata.Num() >= MaxPendingEvents)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("SRTTransportStream: Too many pending metadata items"));
+        return false;
+    }
+    
+    FPendingMetadata Item;
+    Item.PTS = PTS;
+    Item.Payload = Payload;
+    
+    const int32 InsertAt = Algo::UpperBoundBy(Program.PendingMetadata, PTS, &FPendingMetadata::PTS);
+    Program.PendingMetadata.Insert(MoveTemp(Item), InsertAt);
+    return true;
+}
+
+void FSRTTransportStream::EmitScheduledData(FProgram& program, int64 frame_pts, TArray<uint8>& out_packets)
+{
+    // 락 안에서는 꺼내기만 하고 패킷화는 밖에서
+    TArray<FSpliceEvent, TInlineAllocator<4>> due_splices;
+    TArray<FPendingMetadata, TInlineAllocator<4>> due_metadata;
+    {
+        FScopeLock Lock(&EventLock);
+        
+        // SCTE-35는 프리롤만큼 미리 전송 (splice_time에 정확한 PTS가 들어감)
+        const int64 preroll = (int64)Config.SCTE35PrerollMs * 90;
+        int32 count = 0;
+        while (count < program.PendingSplices.Num() && program.PendingSplices[count].PTS - preroll <= frame_pts)
+        {
+            due_splices.Add(program.PendingSplices[count]);
+            count++;
+        }
+        if (count > 0)
+        {
+            program.PendingSplices.RemoveAt(0, count, false);
+        }
+        
+        // 메타데이터는 대상 프레임과 함께 전송
+        count = 0;
+        while (count < program.PendingMetadata.Num() && program.PendingMetadata[count].PTS <= frame_pts)
+        {
+            due_metadata.Add(MoveTemp(program.PendingMetadata[count]));
+            count++;
+        }
+        if (count > 0)
+        {
+            program.PendingMetadata.RemoveAt(0, count, false);
+        }
+    }
+    
+    TArray<uint8> section;
+    for (const FSpliceEvent& event : due_splices)
+    {
+        BuildSpliceInfoSection(event, section);
+        WriteSection(program, program.Config.SCTE35PID, section.GetData(), section.Num(), out_packets);
+        program.Stats.SCTE35Count++;
+        if (event.PTS < frame_pts)
+        {
+            program.Stats.LateEvents++;
+        }
+    }
+    
+    for (const FPendingMetadata& item : due_metadata)
+    {
+        WriteDataPES(program, program.Config.MetadataPID, item.PTS, item.Payload.GetData(), item.Payload.Num(), out_packets);
+        program.Stats.MetadataCount++;
+        if (item.PTS < frame_pts)
+        {
+            program.Stats.LateEvents++;
+        }
+    }
+}
+
+void FSRTTransportStream::BuildSpliceInfoSection(const FSpliceEvent& Event, TArray<uint8>& OutSection)
+{
+    // splice_command
+    uint8 cmd[32];
+    int cmd_len = 0;
+    
+    auto WriteSpliceTime = [&cmd, &cmd_len](int64 pts)
+    {
+        // time_specified_flag = 1, reserved 6비트, pts_time 33비트
+        cmd[cmd_len++] = 0xFE | ((pts >> 32) & 0x01);
+        cmd[cmd_len++] = (pts >> 24) & 0xFF;
+        cmd[cmd_len++] = (pts >> 16) & 0xFF;
+        cmd[cmd_len++] = (pts >> 8) & 0xFF;
+        cmd[cmd_len++] = pts & 0xFF;
+    };
+    
+    const int64 pts = Event.PTS & 0x1FFFFFFFFLL;
+    uint8 cmd_type;
+    
+    if (Event.bTimeSignal)
+    {
+        cmd_type = 0x06;  // time_signal
+        WriteSpliceTime(pts);
+    }
+    else
+    {
+        cmd_type = 0x05;  // splice_insert
+        cmd[cmd_len++] = (Event.EventID >> 24) & 0xFF;
+        cmd[cmd_len++] = (Event.EventID >> 16) & 0xFF;
+        cmd[cmd_len++] = (Event.EventID >> 8) & 0xFF;
+        cmd[cmd_len++] = Event.EventID & 0xFF;
+        cmd[cmd_len++] = (Event.bCancel ? 0x80 : 0x00) | 0x7F;
+        
+        if (!Event.bCancel)
+        {
+            const bool has_duration = Event.BreakDuration > 0;
+            // out_of_network, program_splice_flag = 1, duration_flag, splice_immediate_flag = 0
+            cmd[cmd_len++] = (Event.bOutOfNetwork ? 0x80 : 0x00) | 0x40 | (has_duration ? 0x20 : 0x00) | 0x0F;
+            WriteSpliceTime(pts);
+            
+            if (has_duration)
+            {
+                const int64 duration = Event.BreakDuration & 0x1FFFFFFFFLL;
+                cmd[cmd_len++] = (Event.bAutoReturn ? 0x80 : 0x00) | 0x7E | ((duration >> 32) & 0x01);
+                cmd[cmd_len++] = (duration >> 24) & 0xFF;
+                cmd[cmd_len++] = (duration >> 16) & 0xFF;
+                cmd[cmd_len++] = (duration >> 8) & 0xFF;
+                cmd[cmd_len++] = duration & 0xFF;
+            }
+            
+            cmd[cmd_len++] = (Event.UniqueProgramID >> 8) & 0xFF;
+            cmd[cmd_len++] = Event.UniqueProgramID & 0xFF;
+            cmd[cmd_len++] = 0x00;  // avail_num
+            cmd[cmd_len++] = 0x00;  // avails_expected
+        }
+    }
+    
+    // splice_info_section
+    const int section_length = 11 + cmd_len + 2 + 4;  // 헤더 + 명령 + descriptor_loop_length + CRC
+    OutSection.Reset(3 + section_length);
+    OutSection.Add(0xFC);                                    // table_id
+    OutSection.Add(0x30 | ((section_length >> 8) & 0x0F));  // syntax 0, private 0, sap_type 3
+    OutSection.Add(section_length & 0xFF);
+    OutSection.Add(0x00);                                    // protocol_version
+    OutSection.Add(0x00);                                    // encrypted 0, algorithm 0, pts_adjustment[32] 0
+    OutSection.Add(0x00);                                    // pts_adjustment
+    OutSection.Add(0x00);
+    OutSection.Add(0x00);
+    OutSection.Add(0x00);
+    OutSection.Add(0xFF);                                    // cw_index
+    OutSection.Add(0xFF);                                    // tier 0xFFF
+    OutSection.Add(0xF0 | ((cmd_len >> 8) & 0x0F));          // splice_command_length
+    OutSection.Add(cmd_len & 0xFF);
+    OutSection.Add(cmd_type);
+    OutSection.Append(cmd, cmd_len);
+    OutSection.Add(0x00);                                    // descriptor_loop_length
+    OutSection.Add(0x00);
+    
+    uint32 crc = CalculateCRC32(OutSection.GetData(), OutSection.Num());
+    OutSection.Add((crc >> 24) & 0xFF);
+    OutSection.Add((crc >> 16) & 0xFF);
+    OutSection.Add((crc >> 8) & 0xFF);
+    OutSection.Add(crc & 0xFF);
+}
+
+void FSRTTransportStream::WriteSection(FProgram& program, int pid, const uint8* section, int size, TArray<uint8>& out_packets)
+{
+    uint8 packet[TS_PACKET_SIZE];
+    int remaining = size;
+    bool first = true;
+    
+    while (remaining > 0)
+    {
+        FMemory::Memset(packet, 0xFF, TS_PACKET_SIZE);
+        packet[0] = TS_SYNC_BYTE;
+        packet[1] = (first ? 0x40 : 0x00) | ((pid >> 8) & 0x1F);
+        packet[2] = pid & 0xFF;
+        packet[3] = 0x10 | (ContinuityCounter[pid] & 0x0F);
+        ContinuityCounter[pid] = (ContinuityCounter[pid] + 1) & 0x0F;
+        
+        int offset = 4;
+        if (first)
+        {
+            packet[offset++] = 0x00;  // pointer_field
+        }
+        
+        const int chunk = FMath::Min(TS_PACKET_SIZE - offset, remaining);
+        FMemory::Memcpy(packet + offset, section + (size - remaining), chunk);
+        remaining -= chunk;
+        first = false;
+        
+        out_packets.Append(packet, TS_PACKET_SIZE);
+        TotalPackets++;
+        TotalBytes += TS_PACKET_SIZE;
+        program.Stats.PacketCount++;
+        program.Stats.ByteCount += TS_PACKET_SIZE;
+    }
+}
+
+void FSRTTransportStream::WriteDataPES(FProgram& program, int pid, int64 pts, const uint8* data, int size, TArray<uint8>& out_packets)
+{
+    // PES 헤더 (metadata_stream, PTS만, data_alignment_indicator = 1)
+    uint8 header[14];
+    const int pes_length = 3 + 5 + size;
+    header[0] = 0x00;
+    header[1] = 0x00;
+    header[2] = 0x01;
+    header[3] = 0xFC;  // metadata stream_id
+    header[4] = (pes_length >> 8) & 0xFF;
+    header[5] = pes_length & 0xFF;
+    header[6] = 0x84;  // marker bits + data_alignment_indicator
+    header[7] = 0x80;  // PTS only
+    header[8] = 0x05;
+    header[9] = 0x21 | ((pts >> 29) & 0x0E);
+    header[10] = (pts >> 22) & 0xFF;
+    header[11] = 0x01 | ((pts >> 14) & 0xFE);
+    header[12] = (pts >> 7) & 0xFF;
+    header[13] = 0x01 | ((pts << 1) & 0xFE);
+    
+    const int total = sizeof(header) + size;
+    int written = 0;
+    uint8 packet[TS_PACKET_SIZE];
+    
+    while (written < total)
+    {
+        const int remaining = total - written;
+        const int payload_size = FMath::Min(184, remaining);
+        
+        packet[0] = TS_SYNC_BYTE;
+        packet[1] = (written == 0 ? 0x40 : 0x00) | ((pid >> 8) & 0x1F);
+        packet[2] = pid & 0xFF;
+        
+        int offset = 4;
+        if (payload_size < 184)
+        {
+            // 마지막 패킷은 adaptation field 스터핑으로 채움
+            const int af_length = 183 - payload_size;
+            packet[3] = 0x30 | (ContinuityCounter[pid] & 0x0F);
+            packet[4] = af_length;
+            if (af_length > 0)
+            {
+                packet[5] = 0x00;
+                FMemory::Memset(packet + 6, 0xFF, af_length - 1);
+            }
+            offset = 5 + af_length;
+        }
+        else
+        {
+            packet[3] = 0x10 | (ContinuityCounter[pid] & 0x0F);
+        }
+        ContinuityCounter[pid] = (ContinuityCounter[pid] + 1) & 0x0F;
+        
+        // 헤더와 페이로드가 패킷 경계에 걸칠 수 있음
+        for (int i = 0; i < payload_size; i++)
+        {
+            const int pos = written + i;
+            packet[offset + i] = pos < (int)sizeof(header) ? header[pos] : data[pos - sizeof(header)];
+        }
+        written += payload_size;
+        
+        out_packets.Append(packet, TS_PACKET_SIZE);
+        TotalPackets++;
+        TotalBytes += TS_PACKET_SIZE;
+        program.Stats.PacketCount++;
+        program.Stats.ByteCount += TS_PACKET_SIZE;
+    }
+}
+
+void FSRTTransportStream::BuildID3TextTag(const FString& Description, const FString& Value, TArray<uint8>& OutTag)
+{
+    FTCHARToUTF8 DescUtf8(*Description);
+    FTCHARToUTF8 ValueUtf8(*Value);
+    
+    // TXXX: encoding(1) + description + NUL + value
+    const int32 frame_size = 1 + DescUtf8.Length() + 1 + ValueUtf8.Length();
+    const int32 tag_size = 10 + frame_size;
+    
+    // ID3v2.4 크기는 syncsafe 정수 (7비트씩)
+    auto WriteSyncsafe = [&OutTag](int32 value)
+    {
+        OutTag.Add((value >> 21) & 0x7F);
+        OutTag.Add((value >> 14) & 0x7F);
+        OutTag.Add((value >> 7) & 0x7F);
+        OutTag.Add(value & 0x7F);
+    };
+    
+    OutTag.Reset(10 + tag_size);
+    
+    // 태그 헤더
+    OutTag.Add('I');
+    OutTag.Add('D');
+    OutTag.Add('3');
+    OutTag.Add(0x04);  // v2.4
+    OutTag.Add(0x00);
+    OutTag.Add(0x00);  // flags
+    WriteSyncsafe(tag_size);
+    
+    // TXXX 프레임
+    OutTag.Add('T');
+    OutTag.Add('X');
+    OutTag.Add('X');
+    OutTag.Add('X');
+    WriteSyncsafe(frame_size);
+    OutTag.Add(0x00);  // flags
+    OutTag.Add(0x00);
+    OutTag.Add(0x03);  // UTF-8
+    OutTag.Append((const uint8*)DescUtf8.Get(), DescUtf8.Length());
+    OutTag.Add(0x00);
+    OutTag.Append((const uint8*)ValueUtf8.Get(), ValueUtf8.Length());
+}
+
+void FSRTTransportStream::WritePES(FProgram& program,
+                                   const uint8* data, int size, 
                                    int64 pts, int64 dts, 
                                    bool key_frame, 
                                    TArray<uint8>& out_packets)
 {
+    const int32 VideoPID = program.Config.VideoPID;
+    
     // PES 헤더 크기 계산
     int pes_header_size = 9;  // 기본 PES 헤더
     if (pts != AV_NOPTS_VALUE)
@@ -105,22 +789,22 @@ void FSRTTransportStream::WritePES(const uint8* data, int size,
     
     // TS 헤더
     packet[0] = TS_SYNC_BYTE;
-    packet[1] = 0x40 | ((Config.VideoPID >> 8) & 0x1F);  // payload_unit_start_indicator = 1
-    packet[2] = Config.VideoPID & 0xFF;
+    packet[1] = 0x40 | ((VideoPID >> 8) & 0x1F);  // payload_unit_start_indicator = 1
+    packet[2] = VideoPID & 0xFF;
     
-    // Adaptation field (PCR 포함 시)
-    bool need_pcr = (FPlatformTime::Seconds() - StartTime) * 1000 - LastPCR > Config.PCRIntervalMs;
+    // Adaptation field (PCR 포함 시) - 프로그램마다 자기 PCR PID에 PCR을 실어야 함
+    int64 pcr = GetCurrentPCR();
+    bool need_pcr = (pcr / 300 - program.LastPCR) >= (int64)Config.PCRIntervalMs * 90;
     int adaptation_size = 0;
     
     if (need_pcr || key_frame)
     {
         adaptation_size = 8;  // PCR용
-        packet[3] = 0x30 | (ContinuityCounter[Config.VideoPID] & 0x0F);  // adaptation + payload
+        packet[3] = 0x30 | (ContinuityCounter[VideoPID] & 0x0F);  // adaptation + payload
         packet[4] = adaptation_size - 1;
         packet[5] = 0x10;  // PCR flag
         
         // PCR 쓰기 (임시 구현)
-        int64 pcr = GetCurrentPCR();
         packet[6] = (pcr >> 25) & 0xFF;
         packet[7] = (pcr >> 17) & 0xFF;
         packet[8] = (pcr >> 9) & 0xFF;
@@ -128,14 +812,14 @@ void FSRTTransportStream::WritePES(const uint8* data, int size,
         packet[10] = ((pcr & 1) << 7) | 0x7E;
         packet[11] = 0;
         
-        LastPCR = pcr / 300;  // 90kHz to 27MHz
+        program.LastPCR = pcr / 300;  // 27MHz to 90kHz
     }
     else
     {
-        packet[3] = 0x10 | (ContinuityCounter[Config.VideoPID] & 0x0F);  // payload only
+        packet[3] = 0x10 | (ContinuityCounter[VideoPID] & 0x0F);  // payload only
     }
     
-    ContinuityCounter[Config.VideoPID] = (ContinuityCounter[Config.VideoPID] + 1) & 0x0F;
+    ContinuityCounter[VideoPID] = (ContinuityCounter[VideoPID] + 1) & 0x0F;
     
     // PES 헤더 시작 위치
     int offset = 4 + adaptation_size;
@@ -205,6 +889,8 @@ void FSRTTransportStream::WritePES(const uint8* data, int size,
     out_packets.Append(packet, TS_PACKET_SIZE);
     TotalPackets++;
     TotalBytes += TS_PACKET_SIZE;
+    program.Stats.PacketCount++;
+    program.Stats.ByteCount += TS_PACKET_SIZE;
     
     // 나머지 데이터를 추가 TS 패킷으로
     int remaining = size - bytes_written;
@@ -216,11 +902,11 @@ void FSRTTransportStream::WritePES(const uint8* data, int size,
         
         // TS 헤더 (payload_unit_start_indicator = 0)
         packet[0] = TS_SYNC_BYTE;
-        packet[1] = (Config.VideoPID >> 8) & 0x1F;
-        packet[2] = Config.VideoPID & 0xFF;
-        packet[3] = 0x10 | (ContinuityCounter[Config.VideoPID] & 0x0F);
+        packet[1] = (VideoPID >> 8) & 0x1F;
+        packet[2] = VideoPID & 0xFF;
+        packet[3] = 0x10 | (ContinuityCounter[VideoPID] & 0x0F);
         
-        ContinuityCounter[Config.VideoPID] = (ContinuityCounter[Config.VideoPID] + 1) & 0x0F;
+        ContinuityCounter[VideoPID] = (ContinuityCounter[VideoPID] + 1) & 0x0F;
         
         int payload_size = FMath::Min(184, remaining);
         FMemory::Memcpy(packet + 4, remaining_data, payload_size);
@@ -245,6 +931,8 @@ void FSRTTransportStream::WritePES(const uint8* data, int size,
         out_packets.Append(packet, TS_PACKET_SIZE);
         TotalPackets++;
         TotalBytes += TS_PACKET_SIZE;
+        program.Stats.PacketCount++;
+        program.Stats.ByteCount += TS_PACKET_SIZE;
         
         remaining -= payload_size;
         remaining_data += payload_size;
@@ -282,17 +970,23 @@ void FSRTTransportStream::GeneratePAT(TArray<uint8>& OutPacket)
     packet[offset++] = 0x01;
     
     // Version, current_next_indicator
-    packet[offset++] = 0xC1;
+    packet[offset++] = 0xC1 | ((TableVersion & 0x1F) << 1);
     
     // Section number, last section number
     packet[offset++] = 0x00;
     packet[offset++] = 0x00;
     
-    // Program map
-    packet[offset++] = (Config.ServiceID >> 8) & 0xFF;
-    packet[offset++] = Config.ServiceID & 0xFF;
-    packet[offset++] = 0xE0 | ((Config.PMTPID >> 8) & 0x1F);
-    packet[offset++] = Config.PMTPID & 0xFF;
+    // Program map (활성 프로그램 전부)
+    for (const FProgram& Program : Programs)
+    {
+        if (!Program.bActive)
+            continue;
+        
+        packet[offset++] = (Program.Config.ServiceID >> 8) & 0xFF;
+        packet[offset++] = Program.Config.ServiceID & 0xFF;
+        packet[offset++] = 0xE0 | ((Program.Config.PMTPID >> 8) & 0x1F);
+        packet[offset++] = Program.Config.PMTPID & 0xFF;
+    }
     
     // Section length
     int section_length = offset - length_offset - 2 + 4;  // +4 for CRC
@@ -311,16 +1005,33 @@ void FSRTTransportStream::GeneratePAT(TArray<uint8>& OutPacket)
 
 void FSRTTransportStream::GeneratePMT(TArray<uint8>& OutPacket)
 {
+    for (int32 Index = 0; Index < Programs.Num(); Index++)
+    {
+        if (Programs[Index].bActive)
+        {
+            GeneratePMT(Index, OutPacket);
+        }
+    }
+}
+
+void FSRTTransportStream::GeneratePMT(int32 ProgramIndex, TArray<uint8>& OutPacket)
+{
+    if (!Programs.IsValidIndex(ProgramIndex))
+        return;
+    
+    FProgram& Program = Programs[ProgramIndex];
+    const FProgramConfig& PC = Program.Config;
+    
     uint8 packet[TS_PACKET_SIZE];
     FMemory::Memset(packet, 0xFF, TS_PACKET_SIZE);
     
     // TS 헤더
     packet[0] = TS_SYNC_BYTE;
-    packet[1] = 0x40 | ((Config.PMTPID >> 8) & 0x1F);  // payload_unit_start_indicator = 1
-    packet[2] = Config.PMTPID & 0xFF;
-    packet[3] = 0x10 | (ContinuityCounter[Config.PMTPID] & 0x0F);
+    packet[1] = 0x40 | ((PC.PMTPID >> 8) & 0x1F);  // payload_unit_start_indicator = 1
+    packet[2] = PC.PMTPID & 0xFF;
+    packet[3] = 0x10 | (ContinuityCounter[PC.PMTPID] & 0x0F);
     
-    ContinuityCounter[Config.PMTPID] = (ContinuityCounter[Config.PMTPID] + 1) & 0x0F;
+    ContinuityCounter[PC.PMTPID] = (ContinuityCounter[PC.PMTPID] + 1) & 0x0F;
     
     int offset = 4;
     
@@ -336,31 +1047,78 @@ void FSRTTransportStream::GeneratePMT(TArray<uint8>& OutPacket)
     offset += 2;
     
     // Program number
-    packet[offset++] = (Config.ServiceID >> 8) & 0xFF;
-    packet[offset++] = Config.ServiceID & 0xFF;
+    packet[offset++] = (PC.ServiceID >> 8) & 0xFF;
+    packet[offset++] = PC.ServiceID & 0xFF;
     
     // Version, current_next_indicator
-    packet[offset++] = 0xC1;
+    packet[offset++] = 0xC1 | ((TableVersion & 0x1F) << 1);
     
     // Section number, last section number
     packet[offset++] = 0x00;
     packet[offset++] = 0x00;
     
     // PCR PID
-    packet[offset++] = 0xE0 | ((Config.PCRPID >> 8) & 0x1F);
-    packet[offset++] = Config.PCRPID & 0xFF;
+    packet[offset++] = 0xE0 | ((PC.PCRPID >> 8) & 0x1F);
+    packet[offset++] = PC.PCRPID & 0xFF;
     
-    // Program info length
-    packet[offset++] = 0x00;
-    packet[offset++] = 0x00;
+    // Program info (SCTE-35 사용 시 registration_descriptor "CUEI")
+    if (PC.SCTE35PID != 0)
+    {
+        packet[offset++] = 0xF0;
+        packet[offset++] = 6;
+        packet[offset++] = 0x05;  // registration_descriptor
+        packet[offset++] = 4;
+        packet[offset++] = 'C';
+        packet[offset++] = 'U';
+        packet[offset++] = 'E';
+        packet[offset++] = 'I';
+    }
+    else
+    {
+        packet[offset++] = 0xF0;
+        packet[offset++] = 0x00;
+    }
     
     // Video stream
-    packet[offset++] = 0x1B;  // stream_type (H.264)
-    packet[offset++] = 0xE0 | ((Config.VideoPID >> 8) & 0x1F);
-    packet[offset++] = Config.VideoPID & 0xFF;
+    packet[offset++] = PC.VideoStreamType;  // stream_type (H.264 0x1B / HEVC 0x24)
+    packet[offset++] = 0xE0 | ((PC.VideoPID >> 8) & 0x1F);
+    packet[offset++] = PC.VideoPID & 0xFF;
     packet[offset++] = 0xF0;  // ES info length
     packet[offset++] = 0x00;
     
+    // SCTE-35 스트림
+    if (PC.SCTE35PID != 0)
+    {
+        packet[offset++] = TS_STREAM_TYPE_SCTE35;
+        packet[offset++] = 0xE0 | ((PC.SCTE35PID >> 8) & 0x1F);
+        packet[offset++] = PC.SCTE35PID & 0xFF;
+        packet[offset++] = 0xF0;
+        packet[offset++] = 0x00;
+    }
+    
+    // 타임드 메타데이터 스트림 (metadata_descriptor로 ID3/KLV 구분)
+    if (PC.MetadataPID != 0)
+    {
+        const char* format_id = (PC.MetadataFormat == EMetadataFormat::KLV) ? "KLVA" : "ID3 ";
+        
+        packet[offset++] = TS_STREAM_TYPE_METADATA;
+        packet[offset++] = 0xE0 | ((PC.MetadataPID >> 8) & 0x1F);
+        packet[offset++] = PC.MetadataPID & 0xFF;
+        packet[offset++] = 0xF0;
+        packet[offset++] = 15;
+        packet[offset++] = 0x26;  // metadata_descriptor
+        packet[offset++] = 13;
+        packet[offset++] = 0xFF;  // metadata_application_format = 0xFFFF (identifier 사용)
+        packet[offset++] = 0xFF;
+        FMemory::Memcpy(packet + offset, format_id, 4);
+        offset += 4;
+        packet[offset++] = 0xFF;  // metadata_format = 0xFF (identifier 사용)
+        FMemory::Memcpy(packet + offset, format_id, 4);
+        offset += 4;
+        packet[offset++] = 0x00;  // metadata_service_id
+        packet[offset++] = 0x0F;  // locator 0, carriage 0 (같은 TS), reserved
+    }
+    
     // Section length
     int section_length = offset - length_offset - 2 + 4;  // +4 for CRC
     packet[length_offset] = 0x0D | ((section_length >> 8) & 0x0F);
@@ -374,6 +1132,8 @@ void FSRTTransportStream::GeneratePMT(TArray<uint8>& OutPacket)
     packet[offset++] = crc & 0xFF;
     
     OutPacket.Append(packet, TS_PACKET_SIZE);
+    Program.Stats.PacketCount++;
+    Program.Stats.ByteCount += TS_PACKET_SIZE;
 }
 
 void FSRTTransportStream::GenerateNullPacket(TArray<uint8>& OutPacket)
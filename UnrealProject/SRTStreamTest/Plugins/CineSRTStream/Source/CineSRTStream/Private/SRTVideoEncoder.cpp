@@ -86,42 +86,57 @@ bool FSRTVideoEncoder::Initialize(const FConfig& InConfig)
     
     UE_LOG(LogCineSRTStream, Log, TEXT("FFmpeg version: %d.%d.%d"), major, minor, micro);
     
-    // 코덱 찾기 - GPU 인코더 우선
-    if (Config.bUseHardwareAcceleration)
+    PublishTimeline(0, 0);
+    return OpenCodec();
+}
+
+bool FSRTVideoEncoder::Reconfigure(const FConfig& InConfig)
+{
+    FScopeLock Lock(&EncoderLock);
+    
+    if (!bIsInitialized)
+        return false;
+    
+    // 타임라인 이어붙이기 - 다음 프레임은 이전 설정에서 받았을 PTS에서 새 프레임 간격으로 이어짐
+    const int64 NextIndex = NextFrameIndex.Load();
+    const int64 NextPTS = GetFramePTS(NextIndex);
+    
+    // 코덱을 새로 열면 첫 프레임은 새 SPS/PPS가 붙은 IDR
+    const FConfig PreviousConfig = Config;
+    ReleaseCodec();
+    Config = InConfig;
+    bForceKeyFrame = false;
+    if (OpenCodec())
     {
-        // GPU 인코더 시도 순서
-        const char* gpu_encoders[] = {
-            "h264_nvenc",     // NVIDIA
-            "h264_amf",       // AMD  
-            "h264_qsv",       // Intel
-            nullptr
-        };
-        
-        for (int i = 0; gpu_encoders[i]; i++)
-        {
-            Codec = avcodec_find_encoder_by_name(gpu_encoders[i]);
-            if (Codec)
-            {
-                UE_LOG(LogCineSRTStream, Log, TEXT("✅ GPU encoder found: %s"), UTF8_TO_TCHAR(gpu_encoders[i]));
-                break;
-            }
-        }
+        PublishTimeline(NextIndex, NextPTS);
+        return true;
+    }
+    
+    UE_LOG(LogCineSRTStream, Error, TEXT("Encoder reconfigure to %dx%d@%d failed - restoring %dx%d@%d"),
+        InConfig.Width, InConfig.Height, InConfig.FrameRate,
+        PreviousConfig.Width, PreviousConfig.Height, PreviousConfig.FrameRate);
+    Config = PreviousConfig;
+    OpenCodec();
+    PublishTimeline(NextIndex, NextPTS);
+    return false;
+}
+
+bool FSRTVideoEncoder::OpenCodec()
+{
+    // 코덱 찾기 - 요청한 코덱 우선, HEVC 인코더가 없으면 H.264로 대체
+    Codec = FindEncoder(Config.VideoCodec);
+    ActiveCodec = Config.VideoCodec;
+    if (!Codec && Config.VideoCodec == EVideoCodec::HEVC)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("⚠️ No HEVC encoder found, falling back to H.264"));
+        Codec = FindEncoder(EVideoCodec::H264);
+        ActiveCodec = EVideoCodec::H264;
     }
     
-    // GPU 인코더가 없으면 CPU 인코더 사용
     if (!Codec)
     {
-        Codec = avcodec_find_encoder_by_name("libx264");
-        if (!Codec)
-        {
-            Codec = avcodec_find_encoder(AV_CODEC_ID_H264);
-            if (!Codec)
-            {
-                UE_LOG(LogCineSRTStream, Error, TEXT("No H.264 encoder found!"));
-                return false;
-            }
-        }
-        UE_LOG(LogCineSRTStream, Warning, TEXT("⚠️ Using CPU encoder (slower performance)"));
+        UE_LOG(LogCineSRTStream, Error, TEXT("No H.264 encoder found!"));
+        return false;
     }
     
     // 코덱 컨텍스트 할당
@@ -145,7 +160,7 @@ bool FSRTVideoEncoder::Initialize(const FConfig& InConfig)
     if (!Frame)
     {
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to allocate frame"));
-        Shutdown();
+        ReleaseCodec();
         return false;
     }
     
@@ -159,7 +174,7 @@ bool FSRTVideoEncoder::Initialize(const FConfig& InConfig)
         char errbuf[AV_ERROR_MAX_STRING_SIZE];
         av_strerror(ret, errbuf, sizeof(errbuf));
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to allocate frame buffer: %s"), UTF8_TO_TCHAR(errbuf));
-        Shutdown();
+        ReleaseCodec();
         return false;
     }
     
@@ -174,16 +189,20 @@ bool FSRTVideoEncoder::Initialize(const FConfig& InConfig)
     if (!SwsContext)
     {
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to create color converter"));
-        Shutdown();
+        ReleaseCodec();
         return false;
     }
     
+    // 행렬/범위를 GPU 변환(SRTYUV)과 맞춤 - 기본값(BT.601 제한)에 기대지 않음
+    const int* Coefficients = sws_getCoefficients(Config.Color.Matrix == EVideoColorMatrix::BT709 ? SWS_CS_ITU709 : SWS_CS_ITU601);
+    sws_setColorspaceDetails(SwsContext, Coefficients, 1, Coefficients, Config.Color.bFullRange ? 1 : 0, 0, 1 << 16, 1 << 16);
+    
     // 패킷 할당
     Packet = av_packet_alloc();
     if (!Packet)
     {
         UE_LOG(LogCineSRTStream, Error, TEXT("Failed to allocate packet"));
-        Shutdown();
+        ReleaseCodec();
         return false;
     }
     
@@ -193,6 +212,52 @@ bool FSRTVideoEncoder::Initialize(const FConfig& InConfig)
     return true;
 }
 
+const AVCodec* FSRTVideoEncoder::FindEncoder(EVideoCodec InCodec) const
+{
+    const bool bHEVC = (InCodec == EVideoCodec::HEVC);
+    
+    // GPU 인코더 우선
+    if (Config.bUseHardwareAcceleration)
+    {
+        // GPU 인코더 시도 순서
+        const char* h264_gpu_encoders[] = {
+            "h264_nvenc",     // NVIDIA
+            "h264_amf",       // AMD  
+            "h264_qsv",       // Intel
+            nullptr
+        };
+        const char* hevc_gpu_encoders[] = {
+            "hevc_nvenc",
+            "hevc_amf",
+            "hevc_qsv",
+            nullptr
+        };
+        const char** gpu_encoders = bHEVC ? hevc_gpu_encoders : h264_gpu_encoders;
+        
+        for (int i = 0; gpu_encoders[i]; i++)
+        {
+            const AVCodec* Found = avcodec_find_encoder_by_name(gpu_encoders[i]);
+            if (Found)
+            {
+                UE_LOG(LogCineSRTStream, Log, TEXT("✅ GPU encoder found: %s"), UTF8_TO_TCHAR(gpu_encoders[i]));
+                return Found;
+            }
+        }
+    }
+    
+    // GPU 인코더가 없으면 CPU 인코더 사용
+    const AVCodec* Found = avcodec_find_encoder_by_name(bHEVC ? "libx265" : "libx264");
+    if (!Found)
+    {
+        Found = avcodec_find_encoder(bHEVC ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264);
+    }
+    if (Found)
+    {
+        UE_LOG(LogCineSRTStream, Warning, TEXT("⚠️ Using CPU encoder %s (slower performance)"), UTF8_TO_TCHAR(Found->name));
+    }
+    return Found;
+}
+
 bool FSRTVideoEncoder::CheckFFmpegInstallation()
 {
     // 방법 1: ffmpeg.exe 실행 가능 여부 확인
@@ -252,6 +317,26 @@ void FSRTVideoEncoder::Shutdown()
 {
     FScopeLock Lock(&EncoderLock);
     
+    ReleaseCodec();
+    
+    // 큐 비우기
+    {
+        FScopeLock QueueLockScope(&QueueLock);
+        FEncodedFrame Dummy;
+        while (EncodedFrameQueue.Dequeue(Dummy)) {}
+    }
+    
+    // 통계 초기화
+    EncodedFrameCount = 0;
+    NextFrameIndex = 0;
+    PublishTimeline(0, 0);
+    DroppedFrameCount = 0;
+    TotalEncodedBytes = 0;
+    LastEncodingTimeMs = 0.0f;
+}
+
+void FSRTVideoEncoder::ReleaseCodec()
+{
     bIsInitialized = false;
     
     if (Packet)
@@ -277,19 +362,6 @@ void FSRTVideoEncoder::Shutdown()
         avcodec_free_context(&CodecContext);
         CodecContext = nullptr;
     }
-    
-    // 큐 비우기
-    {
-        FScopeLock QueueLockScope(&QueueLock);
-        FEncodedFrame Dummy;
-        while (EncodedFrameQueue.Dequeue(Dummy)) {}
-    }
-    
-    // 통계 초기화
-    EncodedFrameCount = 0;
-    DroppedFrameCount = 0;
-    TotalEncodedBytes = 0;
-    LastEncodingTimeMs = 0.0f;
 }
 
 bool FSRTVideoEncoder::SetupCodecContext()
@@ -303,6 +375,10 @@ bool FSRTVideoEncoder::SetupCodecContext()
     CodecContext->max_b_frames = 0;
     CodecContext->pix_fmt = AV_PIX_FMT_YUV420P;
     
+    // VUI 색 정보 - 수신 측이 같은 행렬/범위로 RGB 복원
+    CodecContext->colorspace = (Config.Color.Matrix == EVideoColorMatrix::BT709) ? AVCOL_SPC_BT709 : AVCOL_SPC_SMPTE170M;
+    CodecContext->color_range = Config.Color.bFullRange ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG;
+    
     // 비트레이트 설정
     CodecContext->bit_rate = Config.BitrateKbps * 1000;
     
@@ -318,6 +394,8 @@ bool FSRTVideoEncoder::SetupCodecContext()
         CodecContext->rc_buffer_size = Config.BufferSizeKb * 1000;
     }
     
+    const bool bHEVC = (ActiveCodec == EVideoCodec::HEVC);
+    
     // 스레드 설정
     CodecContext->thread_count = Config.ThreadCount;
     CodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
@@ -332,6 +410,7 @@ bool FSRTVideoEncoder::SetupCodecContext()
         // x264 옵션
         FString x264opts = FString::Printf(TEXT("keyint=%d:min-keyint=%d:scenecut=0:bframes=0"), 
             Config.GOPSize, Config.GOPSize);
+        av_opt_set(CodecContext->priv_data, "forced-idr", "1", 0);  // ForceKeyFrame → IDR
         
         if (Config.bUseCBR)
         {
@@ -345,6 +424,34 @@ bool FSRTVideoEncoder::SetupCodecContext()
         av_opt_set(CodecContext->priv_data, "x264opts", TCHAR_TO_UTF8(*x264opts), 0);
     }
     
+    // x265 특정 옵션
+    // repeat-headers: 키프레임마다 VPS/SPS/PPS, aud: 접근 단위 구분자 - 중간 참여 수신기가 바로 디코딩 가능
+    else if (Codec && strcmp(Codec->name, "libx265") == 0)
+    {
+        av_opt_set(CodecContext->priv_data, "preset", TCHAR_TO_UTF8(*Config.Preset), 0);
+        av_opt_set(CodecContext->priv_data, "tune", "zerolatency", 0);
+        av_opt_set(CodecContext->priv_data, "profile", "main", 0);
+        
+        FString x265params = FString::Printf(
+            TEXT("keyint=%d:min-keyint=%d:scenecut=0:bframes=0:rc-lookahead=0:repeat-headers=1:aud=1:log-level=warning"),
+            Config.GOPSize, Config.GOPSize);
+        
+        if (Config.bUseCBR)
+        {
+            x265params += FString::Printf(TEXT(":vbv-maxrate=%d:vbv-bufsize=%d:strict-cbr=1"),
+                Config.BitrateKbps, Config.BufferSizeKb);
+        }
+        else
+        {
+            av_opt_set_double(CodecContext->priv_data, "crf", Config.CRF, 0);
+            x265params += FString::Printf(TEXT(":vbv-maxrate=%d:vbv-bufsize=%d"),
+                Config.MaxBitrateKbps, Config.BufferSizeKb);
+        }
+        
+        av_opt_set(CodecContext->priv_data, "x265-params", TCHAR_TO_UTF8(*x265params), 0);
+        av_opt_set(CodecContext->priv_data, "forced-idr", "1", 0);
+    }
+    
     // NVIDIA NVENC 특정 옵션
     else if (Codec && strstr(Codec->name, "nvenc"))
     {
@@ -362,9 +469,13 @@ bool FSRTVideoEncoder::SetupCodecContext()
         av_opt_set(CodecContext->priv_data, "forced-idr", "1", 0);
         av_opt_set(CodecContext->priv_data, "no-scenecut", "1", 0);
         
-        // 프로파일 설정
-        av_opt_set(CodecContext->priv_data, "profile", "baseline", 0);
-        av_opt_set(CodecContext->priv_data, "level", "4.1", 0);
+        // 프로파일 설정 (HEVC에는 baseline이 없음)
+        av_opt_set(CodecContext->priv_data, "profile", bHEVC ? "main" : "baseline", 0);
+        av_opt_set(CodecContext->priv_data, "level", bHEVC ? "auto" : "4.1", 0);
+        if (bHEVC)
+        {
+            av_opt_set(CodecContext->priv_data, "aud", "1", 0);
+        }
     }
     
     // AMD AMF 특정 옵션
@@ -382,9 +493,12 @@ bool FSRTVideoEncoder::SetupCodecContext()
         av_opt_set(CodecContext->priv_data, "usage", "lowlatency", 0);
         av_opt_set(CodecContext->priv_data, "quality", "speed", 0);
         
-        // 프로파일 설정
-        av_opt_set(CodecContext->priv_data, "profile", "baseline", 0);
-        av_opt_set(CodecContext->priv_data, "level", "4.1", 0);
+        // 프로파일 설정 (HEVC에는 baseline이 없음)
+        av_opt_set(CodecContext->priv_data, "profile", bHEVC ? "main" : "baseline", 0);
+        if (!bHEVC)
+        {
+            av_opt_set(CodecContext->priv_data, "level", "4.1", 0);
+        }
     }
     
     // Intel QuickSync 특정 옵션
@@ -402,9 +516,12 @@ bool FSRTVideoEncoder::SetupCodecContext()
         av_opt_set(CodecContext->priv_data, "async_depth", "1", 0);
         av_opt_set(CodecContext->priv_data, "low_power", "1", 0);
         
-        // 프로파일 설정
-        av_opt_set(CodecContext->priv_data, "profile", "baseline", 0);
-        av_opt_set(CodecContext->priv_data, "level", "41", 0);
+        // 프로파일 설정 (HEVC에는 baseline이 없음)
+        av_opt_set(CodecContext->priv_data, "profile", bHEVC ? "main" : "baseline", 0);
+        if (!bHEVC)
+        {
+            av_opt_set(CodecContext->priv_data, "level", "41", 0);
+        }
     }
     
     // 코덱 열기
@@ -424,6 +541,11 @@ bool FSRTVideoEncoder::SetupCodecContext()
 }
 
 bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame& OutFrame)
+{
+    return EncodeFrame((const uint8*)BGRAData.GetData(), BGRAData.Num() * sizeof(FColor), EVideoPixelFormat::BGRA, OutFrame);
+}
+
+bool FSRTVideoEncoder::EncodeFrame(const uint8* Data, int32 NumBytes, EVideoPixelFormat Format, FEncodedFrame& OutFrame)
 {
     FScopeLock Lock(&EncoderLock);
     
@@ -433,25 +555,36 @@ bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame
     double StartTime = FPlatformTime::Seconds();
     
     // 입력 데이터 검증
-    int32 ExpectedSize = Config.Width * Config.Height;
-    if (BGRAData.Num() != ExpectedSize)
+    const int32 ExpectedSize = SRTYUV::GetFrameBytes(Format, Config.Width, Config.Height);
+    if (NumBytes != ExpectedSize)
     {
-        UE_LOG(LogCineSRTStream, Error, TEXT("Invalid input size: %d, expected %d"), 
-            BGRAData.Num(), ExpectedSize);
+        UE_LOG(LogCineSRTStream, Error, TEXT("Invalid %s input size: %d, expected %d"), 
+            SRTYUV::GetFormatName(Format), NumBytes, ExpectedSize);
         return false;
     }
     
-    // 색공간 변환
-    if (!ConvertAndEncode(BGRAData))
+    // 색공간 변환 (YUV 입력은 GPU/공급원에서 이미 변환됨 - 평면 복사만)
+    SRT_TRACE_STAGE(OutFrame.Trace, ConvertBegin);
+    const bool bConverted = (Format == EVideoPixelFormat::BGRA) ? ConvertAndEncode(Data) : CopyYUVPlanes(Data, Format);
+    if (!bConverted)
     {
         return false;
     }
+    SRT_TRACE_STAGE(OutFrame.Trace, ConvertEnd);
     
-    // 프레임 타임스탬프
-    Frame->pts = EncodedFrameCount;
+    // 프레임 타임스탬프 (건너뛴 프레임도 시간은 흐름)
+    Frame->pts = NextFrameIndex++;
+    
+    // 요청된 키프레임 (송신 혼잡으로 프레임을 버린 뒤 복구 지점)
+    Frame->pict_type = bForceKeyFrame.Exchange(false) ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
     
     // 인코딩
-    int ret = avcodec_send_frame(CodecContext, Frame);
+    int ret = 0;
+    {
+        SRT_TRACE_SCOPE(CineSRT_avcodec_send_frame);
+        ret = avcodec_send_frame(CodecContext, Frame);
+    }
+    SRT_TRACE_STAGE(OutFrame.Trace, EncodeSubmit);
     if (ret < 0)
     {
         char errbuf[AV_ERROR_MAX_STRING_SIZE];
@@ -464,7 +597,10 @@ bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame
     bool bGotPacket = false;
     while (ret >= 0)
     {
-        ret = avcodec_receive_packet(CodecContext, Packet);
+        {
+            SRT_TRACE_SCOPE(CineSRT_avcodec_receive_packet);
+            ret = avcodec_receive_packet(CodecContext, Packet);
+        }
         if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
         {
             break;
@@ -480,8 +616,13 @@ bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame
         // 패킷 데이터 복사
         OutFrame.Data.SetNum(Packet->size);
         FMemory::Memcpy(OutFrame.Data.GetData(), Packet->data, Packet->size);
-        OutFrame.PTS = Packet->pts;
-        OutFrame.DTS = Packet->dts;
+        // MPEG-TS는 90kHz 타임스탬프 사용 (코덱 time_base는 1/FrameRate)
+        const AVRational TSTimeBase = {1, 90000};
+        // Reconfigure 뒤에는 바뀐 시점(IndexBase)부터 새 프레임 간격으로 이어짐
+        OutFrame.PTS = Timeline.PTSBase + av_rescale_q(Packet->pts - Timeline.IndexBase, CodecContext->time_base, TSTimeBase);
+        OutFrame.DTS = (Packet->dts != AV_NOPTS_VALUE)
+            ? Timeline.PTSBase + av_rescale_q(Packet->dts - Timeline.IndexBase, CodecContext->time_base, TSTimeBase)
+            : OutFrame.PTS;
         OutFrame.bKeyFrame = (Packet->flags & AV_PKT_FLAG_KEY) != 0;
         OutFrame.FrameNumber = EncodedFrameCount;
         
@@ -497,8 +638,9 @@ bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame
     {
         EncodedFrameCount++;
         LastEncodingTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        SRT_TRACE_STAGE(OutFrame.Trace, EncodeEnd);
         
-        UE_LOG(LogCineSRTStream, VeryVerbose, 
+        SRT_FRAME_LOG(VeryVerbose, 
             TEXT("Encoded frame %d: %d bytes, %.2fms, %s"),
             OutFrame.FrameNumber, OutFrame.Data.Num(), LastEncodingTimeMs.Load(),
             OutFrame.bKeyFrame ? TEXT("KEY") : TEXT("DELTA"));
@@ -507,8 +649,10 @@ bool FSRTVideoEncoder::EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame
     return bGotPacket;
 }
 
-bool FSRTVideoEncoder::ConvertAndEncode(const TArray<FColor>& BGRAData)
+bool FSRTVideoEncoder::ConvertAndEncode(const uint8* BGRAData)
 {
+    SRT_TRACE_SCOPE(CineSRT_ConvertAndEncode);
+    
     // 16바이트 정렬된 버퍼 할당
     int stride = ((Config.Width * 4 + 15) / 16) * 16;
     TArray<uint8> AlignedBuffer;
@@ -519,7 +663,7 @@ bool FSRTVideoEncoder::ConvertAndEncode(const TArray<FColor>& BGRAData)
     {
         FMemory::Memcpy(
             AlignedBuffer.GetData() + y * stride,
-            BGRAData.GetData() + y * Config.Width,
+            BGRAData + y * Config.Width * 4,
             Config.Width * 4
         );
     }
@@ -540,6 +684,49 @@ bool FSRTVideoEncoder::ConvertAndEncode(const TArray<FColor>& BGRAData)
     return ret == Config.Height;
 }
 
+bool FSRTVideoEncoder::CopyYUVPlanes(const uint8* Data, EVideoPixelFormat Format)
+{
+    SRT_TRACE_SCOPE(CineSRT_CopyYUVPlanes);
+    
+    if (av_frame_make_writable(Frame) < 0)
+    {
+        return false;
+    }
+    
+    const int32 ChromaWidth = Config.Width / 2;
+    const int32 ChromaHeight = Config.Height / 2;
+    for (int32 y = 0; y < Config.Height; y++)
+    {
+        FMemory::Memcpy(Frame->data[0] + y * Frame->linesize[0], Data + y * Config.Width, Config.Width);
+    }
+    
+    const uint8* Chroma = Data + Config.Width * Config.Height;
+    if (Format == EVideoPixelFormat::I420)
+    {
+        const uint8* VPlane = Chroma + ChromaWidth * ChromaHeight;
+        for (int32 y = 0; y < ChromaHeight; y++)
+        {
+            FMemory::Memcpy(Frame->data[1] + y * Frame->linesize[1], Chroma + y * ChromaWidth, ChromaWidth);
+            FMemory::Memcpy(Frame->data[2] + y * Frame->linesize[2], VPlane + y * ChromaWidth, ChromaWidth);
+        }
+        return true;
+    }
+    
+    // NV12 → YUV420P: UV 교차 행을 두 평면으로
+    for (int32 y = 0; y < ChromaHeight; y++)
+    {
+        const uint8* Row = Chroma + y * Config.Width;
+        uint8* U = Frame->data[1] + y * Frame->linesize[1];
+        uint8* V = Frame->data[2] + y * Frame->linesize[2];
+        for (int32 x = 0; x < ChromaWidth; x++)
+        {
+            U[x] = Row[x * 2];
+            V[x] = Row[x * 2 + 1];
+        }
+    }
+    return true;
+}
+
 bool FSRTVideoEncoder::EncodeFrameAsync(const TArray<FColor>& BGRAData)
 {
     FEncodedFrame EncodedFrame;
@@ -558,6 +745,27 @@ bool FSRTVideoEncoder::GetEncodedFrame(FEncodedFrame& OutFrame)
     return EncodedFrameQueue.Dequeue(OutFrame);
 }
 
+int64 FSRTVideoEncoder::GetFramePTS(int64 FrameNumber) const
+{
+    // 게임 스레드에서도 불림 - 인코딩 중인 EncoderLock 대신 타임라인 스냅샷만 잠깐 잠가 복사
+    FPTSTimeline Snapshot;
+    {
+        FScopeLock Lock(&TimelineLock);
+        Snapshot = Timeline;
+    }
+    
+    // EncodeFrame이 프레임 번호를 pts로 쓰므로 같은 변환 (90kHz, Reconfigure 이후는 바뀐 시점부터 새 간격)
+    return Snapshot.FrameRate > 0 ? Snapshot.PTSBase + (FrameNumber - Snapshot.IndexBase) * 90000 / Snapshot.FrameRate : 0;
+}
+
+void FSRTVideoEncoder::PublishTimeline(int64 InIndexBase, int64 InPTSBase)
+{
+    FScopeLock Lock(&TimelineLock);
+    Timeline.IndexBase = InIndexBase;
+    Timeline.PTSBase = InPTSBase;
+    Timeline.FrameRate = Config.FrameRate;
+}
+
 float FSRTVideoEncoder::GetAverageBitrateKbps() const
 {
     if (EncodedFrameCount == 0)
@@ -587,24 +795,35 @@ bool FSRTVideoEncoder::SetBitrate(int32 NewBitrateKbps)
     return true;
 }
 
+void FSRTVideoEncoder::SkipFrame()
+{
+    // 인코딩하지 않은 프레임 - 다음 프레임의 PTS가 실제 캡처 간격을 유지하도록 시간만 진행
+    NextFrameIndex++;
+    DroppedFrameCount++;
+}
+
 bool FSRTVideoEncoder::ForceKeyFrame()
 {
-    FScopeLock Lock(&EncoderLock);
-    
-    if (!bIsInitialized || !CodecContext)
+    if (!bIsInitialized)
         return false;
     
-    // 강제 키프레임 설정
-    avcodec_flush_buffers(CodecContext);
+    // 다음 EncodeFrame이 IDR로 인코딩됨 (B프레임이 없으므로 바로 다음 출력)
+    bForceKeyFrame = true;
     return true;
 }
 
+bool FSRTVideoEncoder::UsesPreset() const
+{
+    return Codec && (strcmp(Codec->name, "libx264") == 0 || strcmp(Codec->name, "libx265") == 0);
+}
+
 void FSRTVideoEncoder::LogCodecInfo()
 {
     if (Codec && CodecContext)
     {
         UE_LOG(LogCineSRTStream, Log, TEXT("Video Encoder Initialized:"));
-        UE_LOG(LogCineSRTStream, Log, TEXT("  Codec: %s"), UTF8_TO_TCHAR(Codec->name));
+        UE_LOG(LogCineSRTStream, Log, TEXT("  Codec: %s (%s)"), UTF8_TO_TCHAR(Codec->name),
+            ActiveCodec == EVideoCodec::HEVC ? TEXT("HEVC") : TEXT("H.264"));
         UE_LOG(LogCineSRTStream, Log, TEXT("  Resolution: %dx%d"), Config.Width, Config.Height);
         UE_LOG(LogCineSRTStream, Log, TEXT("  Frame Rate: %d fps"), Config.FrameRate);
         UE_LOG(LogCineSRTStream, Log, TEXT("  Bitrate: %d kbps"), Config.BitrateKbps);
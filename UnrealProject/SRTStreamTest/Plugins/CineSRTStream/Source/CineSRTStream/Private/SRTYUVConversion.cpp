@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTYUVConversion.h"
+
+void FSRTYUVColorParams::GetCoefficients(FVector4f& OutY, FVector4f& OutU, FVector4f& OutV) const
+{
+    const float Kr = (Matrix == EVideoColorMatrix::BT709) ? 0.2126f : 0.299f;
+    const float Kb = (Matrix == EVideoColorMatrix::BT709) ? 0.0722f : 0.114f;
+    const float Kg = 1.0f - Kr - Kb;
+
+    // 제한 범위: Y = 16 + 219*Y', U/V = 128 + 224*(B-Y')/(2(1-Kb)) ... / 전체 범위: 255, 255
+    const float YScale = bFullRange ? 255.0f : 219.0f;
+    const float YOffset = bFullRange ? 0.0f : 16.0f;
+    const float CScale = (bFullRange ? 255.0f : 224.0f) * 0.5f;
+
+    OutY = FVector4f(Kr * YScale, Kg * YScale, Kb * YScale, YOffset);
+    OutU = FVector4f(-Kr / (1.0f - Kb) * CScale, -Kg / (1.0f - Kb) * CScale, CScale, 128.0f);
+    OutV = FVector4f(CScale, -Kg / (1.0f - Kr) * CScale, -Kb / (1.0f - Kr) * CScale, 128.0f);
+}
+
+const TCHAR* FSRTYUVColorParams::ToString() const
+{
+    if (Matrix == EVideoColorMatrix::BT709)
+        return bFullRange ? TEXT("BT.709 full") : TEXT("BT.709 limited");
+    return bFullRange ? TEXT("BT.601 full") : TEXT("BT.601 limited");
+}
+
+namespace SRTYUV
+{
+    int32 GetFrameBytes(EVideoPixelFormat Format, int32 Width, int32 Height)
+    {
+        return Format == EVideoPixelFormat::BGRA ? Width * Height * 4 : Width * Height * 3 / 2;
+    }
+
+    FIntPoint GetPlaneTextureSize(int32 Width, int32 Height)
+    {
+        return FIntPoint(Width, Height * 3 / 2);
+    }
+
+    namespace
+    {
+        // 셰이더와 같은 순서 (dot + offset, floor(x + 0.5))
+        FORCEINLINE uint8 Quantize(const FVector4f& C, float R, float G, float B)
+        {
+            const float Value = R * C.X + G * C.Y + B * C.Z + C.W;
+            return (uint8)FMath::Clamp(FMath::FloorToInt(Value + 0.5f), 0, 255);
+        }
+    }
+
+    bool ConvertBGRA(const uint8* BGRA, int32 SourceStride, int32 Width, int32 Height,
+                     EVideoPixelFormat Format, const FSRTYUVColorParams& Color, uint8* Out)
+    {
+        if (Format == EVideoPixelFormat::BGRA)
+        {
+            for (int32 Y = 0; Y < Height; Y++)
+            {
+                FMemory::Memcpy(Out + Y * Width * 4, BGRA + Y * SourceStride * 4, Width * 4);
+            }
+            return true;
+        }
+        if ((Width & 1) || (Height & 1))
+            return false;
+
+        FVector4f YC, UC, VC;
+        Color.GetCoefficients(YC, UC, VC);
+
+        const float ToUnit = 1.0f / 255.0f;
+        const int32 ChromaWidth = Width / 2;
+        uint8* const LumaPlane = Out;
+        uint8* const ChromaPlane = Out + Width * Height;
+        uint8* const VPlane = ChromaPlane + ChromaWidth * (Height / 2);
+
+        for (int32 BlockY = 0; BlockY < Height / 2; BlockY++)
+        {
+            const uint8* Row0 = BGRA + (BlockY * 2) * SourceStride * 4;
+            const uint8* Row1 = Row0 + SourceStride * 4;
+            uint8* Luma0 = LumaPlane + (BlockY * 2) * Width;
+            uint8* Luma1 = Luma0 + Width;
+
+            for (int32 BlockX = 0; BlockX < ChromaWidth; BlockX++)
+            {
+                const uint8* P[4] = { Row0 + BlockX * 8, Row0 + BlockX * 8 + 4, Row1 + BlockX * 8, Row1 + BlockX * 8 + 4 };
+                float SumR = 0.0f, SumG = 0.0f, SumB = 0.0f;
+                uint8 Luma[4];
+                for (int32 i = 0; i < 4; i++)
+                {
+                    const float R = P[i][2] * ToUnit;
+                    const float G = P[i][1] * ToUnit;
+                    const float B = P[i][0] * ToUnit;
+                    Luma[i] = Quantize(YC, R, G, B);
+                    SumR += R;
+                    SumG += G;
+                    SumB += B;
+                }
+                Luma0[BlockX * 2] = Luma[0];
+                Luma0[BlockX * 2 + 1] = Luma[1];
+                Luma1[BlockX * 2] = Luma[2];
+                Luma1[BlockX * 2 + 1] = Luma[3];
+
+                const float R = SumR * 0.25f, G = SumG * 0.25f, B = SumB * 0.25f;
+                const uint8 U = Quantize(UC, R, G, B);
+                const uint8 V = Quantize(VC, R, G, B);
+                if (Format == EVideoPixelFormat::NV12)
+                {
+                    ChromaPlane[BlockY * Width + BlockX * 2] = U;
+                    ChromaPlane[BlockY * Width + BlockX * 2 + 1] = V;
+                }
+                else
+                {
+                    ChromaPlane[BlockY * ChromaWidth + BlockX] = U;
+                    VPlane[BlockY * ChromaWidth + BlockX] = V;
+                }
+            }
+        }
+        return true;
+    }
+
+    const TCHAR* GetFormatName(EVideoPixelFormat Format)
+    {
+        switch (Format)
+        {
+            case EVideoPixelFormat::NV12: return TEXT("NV12");
+            case EVideoPixelFormat::I420: return TEXT("I420");
+            default: return TEXT("BGRA");
+        }
+    }
+}
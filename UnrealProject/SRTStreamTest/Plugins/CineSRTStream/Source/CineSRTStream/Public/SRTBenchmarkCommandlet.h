@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "SRTBenchmarkCommandlet.generated.h"
+
+/**
+ * 헤드리스 파이프라인 벤치마크 - GPU와 에디터 화면 없이 공급원 → 인코딩 → TS 다중화 → SRT 전체 경로
+ *
+ * 사용법 (Linux/Windows, -nullrhi로 GPU 없이):
+ *   UnrealEditor-Cmd SRTStreamTest.uproject -run=SRTBenchmark -nullrhi -unattended -nosplash
+ *       [-Resolutions=720p,1080p,4K] [-Source=Bars|Noise|Text|<파일.y4m|파일.raw>]
+ *       [-FPS=30] [-Frames=600] [-Warmup=60] [-Repeat=3] [-Bitrate=8000] [-Preset=Medium]
+ *       [-Codec=H264|HEVC] [-Port=9200] [-Latency=40] [-Output=<결과.json>]
+ *       [-CaptureFormat=BGRA|NV12|I420]
+ *
+ * 해상도마다 스트림 컴포넌트 하나를 임시 월드에 만들어 127.0.0.1의 내장 SRT 리스너로 보낸다.
+ * 워밍업 뒤 Frames 프레임 분량 동안 프레임 추적(CineSRT.FrameTrace)과 캡처 타임스탬프 SEI로
+ * 지속 fps, 캡처→송신 / 캡처→수신 지연 백분위, 단계별 CPU 시간(프레임당 ms), 프로세스 CPU 사용량을 잰다.
+ * 공급원은 캡처 순번만으로 내용이 정해지고 인코더는 소프트웨어 고정이라 반복 실행 간 차이는
+ * 측정 편차뿐이다 (Repeat 회 중앙값과 변동 폭을 함께 출력).
+ *
+ * 종료 코드: 0 = 모든 해상도가 목표 fps의 98% 이상 유지, 1 = 유지 못 한 해상도 있음, 2 = 설정/연결 오류
+ *
+ * -OverloadTest [-Slowdown=N]: 과부하 조정(bEnableOverloadGovernor) 시나리오 - 첫 해상도 하나로
+ *   기준 인코딩 시간을 잰 뒤 CineSRT.SimulateEncoderSlowdown으로 인코딩을 프레임 간격의 두 배로 늘림 (N을 주면 그 배수)
+ *   → 단계가 내려가 자리 잡고 수신 fps가 그 단계 fps의 95% 이상인지, 부하를 없애면 다시 올라오는지 확인.
+ *   종료 코드: 0 = 통과, 1 = 내려가지 않음/간격 불규칙/올라오지 않음, 2 = 설정/연결 오류
+ *
+ * -ReconnectTest [-Outage=2]: 자동 재연결 시나리오 - 첫 해상도 하나로 스트리밍 중 내장 수신기를 닫고 Outage 초 뒤
+ *   같은 포트로 다시 연다. Reconnecting → Streaming 전이, 재연결 직후 PAT/PMT가 첫 비디오 PES보다 먼저 오고
+ *   그 PES가 IDR인지, LastRecoveryTimeMs가 기록되는지 확인 (컴포넌트 틱을 직접 돌려 통계 갱신).
+ *   종료 코드: 0 = 통과, 1 = 전이/복구 스트림/복구 시간 중 하나라도 다름, 2 = 설정/연결 오류
+ *
+ * -MetadataTest [-MetadataFormat=ID3|KLV] [-MaxDeltaMs=2]: 타임드 메타데이터 부하 시험 - 첫 해상도 하나를 FPS(기본 60)로
+ *   메타데이터 없는 기준과 매 프레임 메타데이터를 싣는 회를 번갈아 Repeat 회. 수신 측이 비디오 PES의 도착 시각과 PTS,
+ *   메타데이터 PES를 직접 읽어 캡처→수신 p95와 PES 도착 간격 오차 p95(중앙값)를 기준과 비교한다.
+ *   종료 코드: 0 = 두 값 모두 MaxDeltaMs 이내로 늘고 fps 98% 이상 유지, 메타데이터 95% 이상이 제 프레임과 함께 도착,
+ *   1 = 그 밖, 2 = 설정/연결 오류
+ *
+ * -CaptureFormat: 공급원이 넘기는 픽셀 배열. 결과에 프레임 바이트 수와 공급원→인코더 MB/s가 함께 나온다.
+ *
+ * -YUVTest: GPU와 월드 없이 CPU 참조 YUV 변환(GPU 셰이더와 같은 식)만 검사 - 100% 컬러 바의
+ *   BT.709/BT.601 표준값, 전체 범위 끝값, NV12/I420 일치, 해상도별 프레임 크기와 변환 시간.
+ *   종료 코드: 0 = 통과, 1 = 표준값과 다름
+ *
+ * -EventTest: 워커 → 게임 스레드 이벤트 채널(FSRTWorkerEventChannel)만 검사 - 생산자 스레드가 Frames 프레임 동안
+ *   워커와 같은 빈도로 보내고 이 스레드가 틱처럼 비우는 동안 두 스레드의 할당 횟수를 GMalloc 프록시로 센다.
+ *   종료 코드: 0 = 할당 0, 순서 유지, 버림 없음 (넘침 시험은 정확히 넘친 만큼 버림), 1 = 그 밖
+ */
+UCLASS()
+class CINESRTSTREAM_API USRTBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USRTBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
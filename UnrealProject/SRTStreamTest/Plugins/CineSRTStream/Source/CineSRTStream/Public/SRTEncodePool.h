@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+
+/**
+ * 여러 스트림이 공유하는 고정 크기 인코딩 워커 풀
+ *
+ * 스트림마다 인코딩 스레드를 두지 않고, 새 프레임이 준비된 스트림을 FIFO 대기열에 넣어
+ * 워커 N개가 차례로 처리한다. 한 스트림의 작업은 동시에 하나만 실행되므로
+ * 인코더 상태(참조 프레임, PTS 순서)는 스트림 안에서 그대로 유지된다.
+ */
+class CINESRTSTREAM_API FSRTEncodePool
+{
+public:
+    // 풀 전체 누적 값 - 호출하는 쪽이 두 샘플의 차이로 구간 값을 계산
+    struct FStats
+    {
+        int32 WorkerCount = 0;
+        int32 StreamCount = 0;
+        int32 QueuedStreams = 0;        // 지금 대기열에 있는 스트림
+        double BusySeconds = 0.0;       // 모든 워커가 작업에 쓴 시간 합
+        double QueueWaitSeconds = 0.0;  // Schedule부터 작업 시작까지 대기 시간 합
+        int64 JobsCompleted = 0;
+    };
+
+    explicit FSRTEncodePool(int32 InWorkerCount);
+    ~FSRTEncodePool();
+
+    /** 스트림 등록 - Job은 풀 워커에서 호출됨 (같은 스트림끼리는 겹치지 않음). 반환값은 Schedule/RemoveStream 핸들 */
+    int32 AddStream(TFunction<void()> Job);
+
+    /** 대기열에서 빼고 실행 중인 작업이 끝날 때까지 대기 - 반환 뒤에는 Job이 다시 호출되지 않음 */
+    void RemoveStream(int32 Handle);
+
+    /** 새 프레임 준비됨 (어느 스레드에서든) - 이미 대기 중이면 무시, 실행 중이면 끝난 뒤 한 번 더 */
+    void Schedule(int32 Handle);
+
+    int32 GetWorkerCount() const { return Threads.Num(); }
+    FStats GetStats() const;
+
+private:
+    class FWorker;
+
+    struct FStream
+    {
+        TFunction<void()> Job;
+        double QueuedTime = 0.0;
+        bool bQueued = false;
+        bool bRunning = false;
+        bool bRerun = false;    // 실행 중에 새 프레임이 들어옴
+        bool bRemoved = false;
+    };
+
+    TArray<TUniquePtr<FWorker>> Workers;
+    TArray<FRunnableThread*> Threads;
+    FEvent* WorkEvent = nullptr;
+    TAtomic<bool> bShouldExit{false};
+
+    mutable FCriticalSection Lock;
+    TMap<int32, TSharedPtr<FStream>> Streams;
+    TArray<int32> ReadyQueue;
+    int32 NextHandle = 1;
+    double BusySeconds = 0.0;
+    double QueueWaitSeconds = 0.0;
+    int64 JobsCompleted = 0;
+
+    /** 워커 스레드: 대기열에서 하나 꺼내 실행 (없으면 false) */
+    bool RunNext();
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 고정 크기 락 없는 단일 생산자 / 단일 소비자 이벤트 채널
+ *
+ * 슬롯을 미리 잡아 두고 생산자가 제자리에서 채우므로 Push와 Drain 모두 할당이 없다.
+ * 소비자가 늦어 가득 차면 새 이벤트를 버리고 센다 (생산자는 절대 기다리지 않음).
+ * 생산자 스레드와 소비자 스레드는 각각 하나 - 생산자가 둘이면 채널도 둘.
+ */
+template <typename EventType, uint32 Capacity>
+class TSRTEventChannel
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /** 생산자 - 빈 슬롯을 Fill(EventType&)로 채워 넣음. 가득 차면 false (버린 수 증가) */
+    template <typename FillFunc>
+    bool Push(FillFunc&& Fill)
+    {
+        const uint32 Write = WriteIndex.Load(EMemoryOrder::Relaxed);
+        if (Write - ReadIndex.Load() >= Capacity)
+        {
+            DroppedCount++;
+            return false;
+        }
+        Fill(Slots[Write & (Capacity - 1)]);
+        WriteIndex = Write + 1;
+        return true;
+    }
+
+    /** 소비자 - 쌓인 이벤트를 넣은 순서대로 Consume(const EventType&)에 넘기고 비움. 처리한 수 */
+    template <typename ConsumeFunc>
+    int32 Drain(ConsumeFunc&& Consume)
+    {
+        const uint32 Read = ReadIndex.Load(EMemoryOrder::Relaxed);
+        const uint32 Write = WriteIndex.Load();
+        for (uint32 Index = Read; Index != Write; Index++)
+        {
+            Consume(Slots[Index & (Capacity - 1)]);
+        }
+        ReadIndex = Write;
+        return (int32)(Write - Read);
+    }
+
+    /** 소비자 - 가득 차서 버린 이벤트 수 (읽으면 0으로) */
+    int32 ConsumeDroppedCount() { return DroppedCount.Exchange(0); }
+
+    static constexpr uint32 GetCapacity() { return Capacity; }
+
+private:
+    EventType Slots[Capacity];
+    TAtomic<uint32> WriteIndex{0};      // 생산자만 씀
+    TAtomic<uint32> ReadIndex{0};       // 소비자만 씀
+    TAtomic<int32> DroppedCount{0};
+};
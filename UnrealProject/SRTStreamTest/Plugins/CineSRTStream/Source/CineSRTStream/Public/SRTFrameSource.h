@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SRTFrameTrace.h"
+#include "SRTYUVConversion.h"
+
+#include "SRTFrameSource.generated.h"
+
+class IFileHandle;
+
+UENUM(BlueprintType)
+enum class ESRTFrameSourceType : uint8
+{
+    SceneCapture UMETA(DisplayName = "Scene Capture"),
+    TestPattern UMETA(DisplayName = "Test Pattern"),
+    File UMETA(DisplayName = "Raw/Y4M File")
+};
+
+UENUM(BlueprintType)
+enum class ESRTTestPattern : uint8
+{
+    MovingBars UMETA(DisplayName = "Moving Bars"),
+    Noise UMETA(DisplayName = "Noise (worst case)"),
+    Text UMETA(DisplayName = "Frame Counter Text")
+};
+
+// 단순한 프레임 버퍼 시스템
+class FrameBuffer {
+public:
+    struct Frame {
+        TArray<uint8> Data;
+        uint32 FrameNumber;
+        double Timestamp;  // 캡처 요청 시각 (FPlatformTime::Seconds)
+        int32 Width;
+        int32 Height;
+        EVideoPixelFormat Format = EVideoPixelFormat::BGRA;  // Data 배열 (SRTYUV::GetFrameBytes 크기)
+        FSRTFrameTrace Trace;  // 단계별 타임스탬프 (FEncodedFrame으로 이어짐)
+    };
+
+    void SetFrame(Frame&& frame);
+    bool GetFrame(Frame& OutFrame);
+    void Clear();
+    bool HasNewFrame() const;
+    // 인코더가 가져가기 전에 다음 프레임으로 덮어쓴 누적 수 (인코딩이 캡처를 못 따라감)
+    int32 GetOverwrittenFrames() const { return OverwrittenFrames.Load(); }
+
+private:
+    Frame CurrentFrame;
+    mutable FCriticalSection Mutex;
+    TAtomic<bool> bNewFrameReady{false};
+    TAtomic<int32> OverwrittenFrames{0};
+};
+
+/**
+ * FrameBuffer 앞단 프레임 공급원 (BGRA 8비트, 또는 SetOutputFormat으로 4:2:0 YUV)
+ *
+ * 씬 캡처(FGPUReadbackManager), 테스트 패턴, 파일 중 무엇이든 같은 방식으로 프레임을 넘기므로
+ * 인코딩 → 다중화 → SRT 경로는 공급원을 모른다. 패턴/파일은 GPU 없이 동작해서
+ * 헤드리스 벤치마크(USRTBenchmarkCommandlet)가 같은 파이프라인 전체를 돌릴 수 있다.
+ * YUV 출력은 씬 캡처면 GPU 컴퓨트 셰이더, 패턴/파일이면 같은 식의 CPU 참조 구현(SRTYUV::ConvertBGRA).
+ */
+class CINESRTSTREAM_API FSRTFrameSource : public TSharedFromThis<FSRTFrameSource>
+{
+public:
+    explicit FSRTFrameSource(TSharedPtr<FrameBuffer> InFrameBuffer) : MyFrameBuffer(InFrameBuffer) {}
+    virtual ~FSRTFrameSource() = default;
+
+    /** 게임 스레드 - 캡처 시점마다 호출. 프레임은 나중에 다른 스레드에서 FrameBuffer로 들어감
+     *  씬 캡처는 서브시스템이 다른 스트림과 묶어서 요청하므로 여기서는 false */
+    virtual bool CaptureFrame(uint32 FrameNumber) { return false; }
+    virtual const TCHAR* GetName() const = 0;
+
+    /** 게임 스레드 - 이후 캡처부터 출력 크기 변경 (과부하 조정). 크기를 못 바꾸는 공급원은 false */
+    virtual bool SetOutputSize(int32 InWidth, int32 InHeight) { return false; }
+
+    /** 게임 스레드 - FrameBuffer에 넣을 픽셀 배열과 YUV 변환 행렬/범위. 캡처 시작 전에 설정 */
+    void SetOutputFormat(EVideoPixelFormat InFormat, const FSRTYUVColorParams& InColor) { OutputFormat = InFormat; OutputColor = InColor; }
+    EVideoPixelFormat GetOutputFormat() const { return OutputFormat; }
+
+    void Shutdown() { bShuttingDown.Store(true); }
+    bool IsShuttingDown() const { return bShuttingDown.Load(); }
+
+    // 프레임 추적 스트림 (FSRTFrameTraceRecorder::RegisterStream)
+    void SetTraceStreamId(uint16 InStreamId) { TraceStreamId = InStreamId; }
+    // FrameBuffer에 새 프레임을 넣은 직후 호출 (인코딩 풀 예약) - 캡처 시작 전에 설정
+    void SetOnFrameReady(TFunction<void()> InCallback) { OnFrameReady = MoveTemp(InCallback); }
+
+protected:
+    EVideoPixelFormat OutputFormat = EVideoPixelFormat::BGRA;
+    FSRTYUVColorParams OutputColor;
+
+    /** 게임 스레드 - 캡처 요청 시점의 추적 시작 (Capture 단계) */
+    FSRTFrameTrace BeginTrace();
+    /** 어느 스레드든 - FrameBuffer에 넣고 OnFrameReady */
+    void Deliver(FrameBuffer::Frame&& Frame);
+
+private:
+    TSharedPtr<FrameBuffer> MyFrameBuffer;  // 명확한 이름
+    TAtomic<bool> bShuttingDown{false};
+    TFunction<void()> OnFrameReady;
+    uint16 TraceStreamId = 0;
+    uint32 NextTraceFrameId = 0;            // 게임 스레드 전용
+};
+
+/**
+ * CPU에서 만드는 공급원 공통 - 생성은 백그라운드 태스크 (CopyBegin~CopyEnd 단계로 추적)
+ *
+ * 내용은 캡처 순번(0부터)만으로 정해지므로 같은 설정이면 실행할 때마다 같은 프레임 열이 나온다.
+ * 이전 프레임을 아직 만드는 중이면 이번 캡처는 건너뜀 (GetSkippedFrames).
+ */
+class CINESRTSTREAM_API FSRTGeneratedFrameSource : public FSRTFrameSource
+{
+public:
+    FSRTGeneratedFrameSource(TSharedPtr<FrameBuffer> InFrameBuffer, int32 InWidth, int32 InHeight);
+
+    virtual bool CaptureFrame(uint32 FrameNumber) override;
+    virtual bool SetOutputSize(int32 InWidth, int32 InHeight) override;
+    int32 GetSkippedFrames() const { return SkippedFrames.Load(); }
+
+protected:
+    // 생성 중(bGenerating)에는 바뀌지 않음 - 새 크기는 다음 CaptureFrame에서 반영
+    int32 Width;
+    int32 Height;
+
+    /** 백그라운드 스레드 - Sequence번째 프레임을 OutBGRA(Width*Height*4)에 채움 */
+    virtual bool Generate(uint32 Sequence, uint8* OutBGRA) = 0;
+
+private:
+    uint32 NextSequence = 0;                // 게임 스레드 전용
+    int32 PendingWidth = 0;                 // 게임 스레드 전용
+    int32 PendingHeight = 0;
+    TAtomic<bool> bGenerating{false};
+    TAtomic<int32> SkippedFrames{0};
+    TArray<uint8> ScratchBGRA;              // YUV 출력일 때 생성 결과 (생성 중에만 사용)
+};
+
+/** 움직이는 컬러 바 / 프레임마다 다른 노이즈(인코더 최악) / 프레임 번호 글자 */
+class CINESRTSTREAM_API FSRTTestPatternSource : public FSRTGeneratedFrameSource
+{
+public:
+    FSRTTestPatternSource(TSharedPtr<FrameBuffer> InFrameBuffer, ESRTTestPattern InPattern,
+                          int32 InWidth, int32 InHeight, uint32 InSeed = 1);
+
+    virtual const TCHAR* GetName() const override;
+
+protected:
+    virtual bool Generate(uint32 Sequence, uint8* OutBGRA) override;
+
+private:
+    const ESRTTestPattern Pattern;
+    const uint32 Seed;
+};
+
+/**
+ * 파일 재생 - .y4m (4:2:0 8비트, 프레임 헤더 매개변수 없음) 또는 원시 BGRA (.raw/.bgra)
+ * 해상도는 스트림과 같아야 함 (크기 변환 안 함). 끝에 닿으면 처음부터 반복.
+ */
+class CINESRTSTREAM_API FSRTFileFrameSource : public FSRTGeneratedFrameSource
+{
+public:
+    FSRTFileFrameSource(TSharedPtr<FrameBuffer> InFrameBuffer, int32 InWidth, int32 InHeight);
+    virtual ~FSRTFileFrameSource();
+
+    /** 실패하면 OutError에 사유 */
+    bool Open(const FString& Path, FString& OutError);
+    int32 GetFrameCount() const { return FrameCount; }
+
+    // 파일 해상도 그대로만 재생
+    virtual bool SetOutputSize(int32 InWidth, int32 InHeight) override { return false; }
+
+    virtual const TCHAR* GetName() const override { return bY4M ? TEXT("Y4M") : TEXT("RawBGRA"); }
+
+protected:
+    virtual bool Generate(uint32 Sequence, uint8* OutBGRA) override;
+
+private:
+    FCriticalSection FileLock;
+    IFileHandle* File = nullptr;
+    bool bY4M = false;
+    int64 DataOffset = 0;       // 첫 프레임 위치
+    int64 FrameStride = 0;      // 프레임 헤더("FRAME\n") 포함 한 프레임 크기
+    int64 FramePayload = 0;
+    int32 FrameCount = 0;
+    TArray<uint8> ReadBuffer;   // Y4M 평면 (FileLock 안에서만)
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// 프레임 추적 (Unreal Insights 스코프 + 단계별 타임스탬프) - Shipping에서는 기본으로 빠짐
+#ifndef CINESRT_FRAME_TRACE
+#define CINESRT_FRAME_TRACE (!UE_BUILD_SHIPPING)
+#endif
+
+// 프레임마다 남는 상세 로그 - 기본으로 컴파일에서 빠짐 (Build.cs에서 CINESRT_FRAME_LOG=1로 켬)
+#ifndef CINESRT_FRAME_LOG
+#define CINESRT_FRAME_LOG 0
+#endif
+
+// 파이프라인 단계 - 프레임 하나가 지나가는 순서
+enum class ESRTTraceStage : uint8
+{
+    Capture,        // CaptureFrame (게임 스레드, 리드백 요청)
+    ReadbackBegin,  // 렌더 명령 시작
+    ReadbackEnd,    // ReadSurfaceData 완료
+    CopyBegin,      // 백그라운드 복사 태스크 시작
+    CopyEnd,        // FrameBuffer에 넘김
+    Dequeue,        // 워커가 FrameBuffer에서 꺼냄
+    ConvertBegin,   // ConvertAndEncode (BGRA → YUV)
+    ConvertEnd,
+    EncodeSubmit,   // avcodec_send_frame 반환
+    EncodeEnd,      // avcodec_receive_packet으로 패킷 받음
+    MuxBegin,       // MuxH264Frame (TS 다중화)
+    MuxEnd,
+    SendBegin,      // 첫 srt_send
+    SendEnd,        // 마지막 srt_send (리스너 모드는 구독자 큐에 넘긴 시각)
+    Count
+};
+
+/**
+ * 프레임 하나에 붙는 단계별 타임스탬프 (FPlatformTime::Cycles64, 0 = 거치지 않음)
+ *
+ * 캡처 때 만들어 FrameBuffer::Frame → FEncodedFrame으로 복사되며 따라가고,
+ * 송신이 끝난 스레드가 FSRTFrameTraceRecorder에 기록한다.
+ */
+struct FSRTFrameTrace
+{
+    uint32 FrameId = 0;
+    uint16 StreamId = 0;
+    uint64 StageCycles[(int32)ESRTTraceStage::Count] = {};
+
+    FORCEINLINE void Mark(ESRTTraceStage Stage) { StageCycles[(int32)Stage] = FPlatformTime::Cycles64(); }
+};
+
+/**
+ * 최근 프레임 추적 링 버퍼 (프로세스 전체, 스트림 여러 개 공용)
+ *
+ * CineSRT.FrameTrace 1일 때만 기록. CineSRT.DumpFrameTrace [경로]로 Chrome trace JSON을 쓴다
+ * (chrome://tracing 또는 https://ui.perfetto.dev에서 열기). 패키지 빌드에서도 동작.
+ */
+class CINESRTSTREAM_API FSRTFrameTraceRecorder
+{
+public:
+    static constexpr int32 Capacity = 4096;
+
+    static FSRTFrameTraceRecorder& Get();
+    static bool IsEnabled();
+
+    // 스트림 이름 등록 - Chrome trace의 프로세스 하나 (StreamId는 1부터)
+    uint16 RegisterStream(const FString& Name);
+
+    void Record(const FSRTFrameTrace& Trace);
+    void Reset();
+
+    // 기록된 추적 복사본 (오래된 것부터)
+    TArray<FSRTFrameTrace> GetRecorded();
+
+    // 쓴 파일 경로 (비어 있으면 Saved/SRTTrace/FrameTrace_<시각>.json), 실패하면 빈 문자열
+    FString DumpChromeTrace(const FString& Path = FString());
+
+private:
+    FCriticalSection Lock;
+    TArray<FSRTFrameTrace> Ring;
+    int32 Next = 0;
+    TArray<FString> StreamNames;
+};
+
+#if CINESRT_FRAME_TRACE
+TRACE_DECLARE_INT_COUNTER_EXTERN(CineSRT_CaptureFrameId);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CineSRT_EncodeFrameId);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CineSRT_SendFrameId);
+
+// Insights CPU 스코프 (이름은 식별자 - 예: SRT_TRACE_SCOPE(CineSRT_MuxH264Frame))
+#define SRT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+// Insights 카운터 트랙에 지금 처리 중인 프레임 번호 (스코프와 프레임을 맞춰 보기 위함)
+#define SRT_TRACE_FRAME_ID(Counter, Id) TRACE_COUNTER_SET(CineSRT_##Counter, (int64)(Id))
+#define SRT_TRACE_STAGE(Trace, Stage) (Trace).Mark(ESRTTraceStage::Stage)
+#define SRT_TRACE_COMMIT(Trace) \
+    do { if (FSRTFrameTraceRecorder::IsEnabled()) FSRTFrameTraceRecorder::Get().Record(Trace); } while (0)
+#else
+#define SRT_TRACE_SCOPE(Name)
+#define SRT_TRACE_FRAME_ID(Counter, Id)
+#define SRT_TRACE_STAGE(Trace, Stage)
+#define SRT_TRACE_COMMIT(Trace)
+#endif
+
+#if CINESRT_FRAME_LOG
+#define SRT_FRAME_LOG(Verbosity, Format, ...) UE_LOG(LogCineSRTStream, Verbosity, Format, ##__VA_ARGS__)
+#else
+#define SRT_FRAME_LOG(Verbosity, Format, ...)
+#endif
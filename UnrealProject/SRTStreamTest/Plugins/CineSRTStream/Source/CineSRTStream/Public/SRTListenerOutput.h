@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "Containers/Queue.h"
+#include "Templates/SharedPointer.h"
+
+#include "SRTNetworkWorker.h"
+
+/**
+ * 리스너(서버) 모드 출력 - 한 번 인코딩/다중화한 TS를 접속한 모든 수신기에 팬아웃
+ *
+ * 워커가 제출한 프레임 단위 TS 청크는 참조 카운트 버퍼 하나로 모든 구독자 큐가 공유한다 (복사 없음).
+ * 송신은 논블로킹이라 느린 구독자가 다른 구독자를 막지 않는다.
+ * 큐가 넘치는 구독자는 쌓인 프레임을 버리고 다음 키프레임부터 다시 받고,
+ * 그래도 진행이 없으면 연결을 끊는다.
+ */
+class CINESRTSTREAM_API FSRTListenerOutput : public FRunnable
+{
+public:
+    struct FConfig
+    {
+        int32 Port = 9001;
+        int32 LatencyMs = 120;
+        int32 MessageTTLMs = 0;            // 0 = 무제한
+        int32 MaxSubscribers = 16;
+        int32 MaxQueuedFrames = 30;        // 구독자별 대기 프레임 한도 - 넘으면 키프레임까지 건너뜀
+        double StallTimeoutSeconds = 5.0;  // 이 시간 동안 한 프레임도 못 보내면 연결 종료
+        SRTNetwork::EncryptionOptions Encryption;  // 리스너 소켓에 적용 - 수락된 소켓이 물려받음
+    };
+
+    struct FSubscriberStats
+    {
+        FString PeerAddress;
+        double ConnectedSeconds = 0.0;
+        int64 BytesSent = 0;
+        int64 FramesSent = 0;
+        int32 FramesSkipped = 0;       // 키프레임 대기/큐 초과로 건너뛴 프레임
+        int32 KeyFrameResyncs = 0;     // 큐 초과로 키프레임부터 다시 시작한 횟수
+        int32 QueuedFrames = 0;
+        float RTTMs = 0.0f;
+        float SendRateMbps = 0.0f;
+        int32 KeyMaterialState = 0;
+    };
+
+    explicit FSRTListenerOutput(const FConfig& InConfig);
+    virtual ~FSRTListenerOutput();
+
+    /** 바인드/리슨 후 송신 스레드 시작 */
+    bool Start();
+    void Shutdown();
+
+    /** 다중화된 프레임 하나 제출 (워커 스레드) - 구독자가 없으면 버림 */
+    void SubmitFrame(const TArray<uint8>& TSPackets, double CaptureTime, bool bKeyFrame);
+
+    bool HasSubscribers() const { return SubscriberCount.Load() > 0; }
+    int32 GetSubscriberCount() const { return SubscriberCount.Load(); }
+    int32 GetTotalAccepted() const { return TotalAccepted.Load(); }
+    int32 GetTotalDisconnected() const { return TotalDisconnected.Load(); }
+
+    /** 새 구독자가 들어왔거나 송신 스레드가 밀려 프레임을 버렸으면 한 번만 true - 워커가 IDR을 요청해서 바로 (다시) 디코딩 */
+    bool ConsumeKeyFrameRequest() { return bKeyFrameRequested.Exchange(false); }
+
+    void GetSubscriberStats(TArray<FSubscriberStats>& OutStats) const;
+    const FConfig& GetConfig() const { return Config; }
+
+    // FRunnable interface
+    virtual bool Init() override;
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    struct FChunk
+    {
+        TArray<uint8> Data;
+        double CaptureTime = 0.0;
+        bool bKeyFrame = false;
+        int32 DroppedBefore = 0;    // 이 청크 직전에 SubmitFrame이 버린 프레임 수 (모든 구독자에게 빈 구간)
+    };
+    using FChunkRef = TSharedPtr<const FChunk, ESPMode::ThreadSafe>;
+
+    struct FSubscriber
+    {
+        FSRTSocket Socket;
+        SRTNetwork::SourceClock SourceClock;
+        SRTNetwork::StatsTracker StatsTracker;
+        TArray<FChunkRef> Queue;       // 맨 앞 청크는 Offset까지 전송됨
+        int32 Offset = 0;
+        bool bWaitingForKeyFrame = true;
+        bool bClosed = false;
+        double ConnectTime = 0.0;
+        double LastProgressTime = 0.0;
+        FSubscriberStats Stats;
+    };
+
+    FConfig Config;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WorkEvent = nullptr;
+    TAtomic<bool> bShouldExit{false};
+    FSRTSocket ListenSocket;
+
+    // 워커(하나) → 송신 스레드(하나)
+    TQueue<FChunkRef, EQueueMode::Spsc> Incoming;
+    TAtomic<int32> IncomingCount{0};
+    static constexpr int32 MaxIncomingFrames = 64;
+    int32 IncomingDropped = 0;      // 워커 전용 - 다음 청크에 DroppedBefore로 넘김
+
+    // 송신 스레드 전용
+    TArray<TUniquePtr<FSubscriber>> Subscribers;
+    double LastStatsTime = 0.0;
+
+    TAtomic<int32> SubscriberCount{0};
+    TAtomic<int32> TotalAccepted{0};
+    TAtomic<int32> TotalDisconnected{0};
+    TAtomic<bool> bKeyFrameRequested{false};
+
+    // 게임 스레드가 읽는 구독자별 통계 스냅샷
+    TArray<FSubscriberStats> StatsSnapshot;
+    mutable FCriticalSection StatsLock;
+
+    void AcceptSubscribers();
+    void DistributeIncoming();
+    void FlushSubscriber(FSubscriber& Subscriber, double Now);
+    void RemoveClosedSubscribers();
+    void UpdateStats(double Now);
+};
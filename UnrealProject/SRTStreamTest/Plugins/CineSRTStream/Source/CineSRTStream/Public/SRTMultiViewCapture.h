@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "HAL/CriticalSection.h"
+
+class UWorld;
+class UTextureRenderTarget2D;
+class USceneCaptureComponent2D;
+
+/**
+ * 여러 스트림 카메라를 뷰 패밀리 하나의 뷰들로 렌더
+ *
+ * CaptureScene은 카메라마다 디퍼드 렌더러 전체(그림자 깊이, 조명, 포스트 프로세스)를 새로 돌린다.
+ * 여기서는 분할 화면처럼 뷰 N개를 씬 렌더러 하나에 넣어 아틀라스 텍스처의 타일에 그리므로
+ * GPU Scene 갱신, 섀도 맵/가상 섀도 페이지, Lumen 씬 같은 장면 단위 작업을 카메라들이 공유한다.
+ * 뷰별 작업(가시성, 베이스 패스, 포스트 프로세스)은 그대로 카메라 수만큼 든다.
+ */
+class CINESRTSTREAM_API FSRTMultiViewCapture
+{
+public:
+    struct FView
+    {
+        USceneCaptureComponent2D* SceneCapture = nullptr;   // 위치, FOV, 포스트 프로세스, 뷰 상태(TAA 히스토리)
+        FIntRect Rect;                                      // 아틀라스 안의 타일
+    };
+
+    /** 게임 스레드 - 렌더 명령을 큐에 넣고 바로 반환. 쇼 플래그와 캡처 소스는 첫 뷰 기준 */
+    static bool RenderViews(UWorld* World, UTextureRenderTarget2D* Atlas, const TArray<FView>& Views);
+};
+
+/**
+ * 렌더 스레드 타임스탬프 쿼리로 GPU 구간 측정
+ *
+ * Begin/End 사이에 게임 스레드가 큐에 넣은 렌더 작업의 GPU 시간을 잰다.
+ * 결과는 몇 프레임 늦게 나오며 기다리지 않고 폴링한다.
+ */
+class CINESRTSTREAM_API FSRTGPUTimer : public TSharedFromThis<FSRTGPUTimer, ESPMode::ThreadSafe>
+{
+public:
+    void Begin();
+    /** ViewCount = 구간에서 렌더한 카메라 수 (카메라당 평균 계산용) */
+    void End(int32 ViewCount);
+
+    /** 게임 스레드 - 지난 호출 이후 완료된 구간의 카메라당 평균 GPU 시간 (완료된 구간이 없으면 false) */
+    bool ConsumeAverageMsPerView(float& OutMs);
+
+private:
+    struct FInterval
+    {
+        FRenderQueryRHIRef Start;
+        FRenderQueryRHIRef End;
+        int32 ViewCount = 0;
+    };
+
+    TArray<FInterval> Pending;      // 렌더 스레드 전용
+
+    FCriticalSection Lock;
+    uint64 AccumulatedMicroseconds = 0;
+    int32 AccumulatedViews = 0;
+
+    /** 렌더 스레드 - 결과가 나온 구간을 앞에서부터 누적 */
+    void Poll();
+};
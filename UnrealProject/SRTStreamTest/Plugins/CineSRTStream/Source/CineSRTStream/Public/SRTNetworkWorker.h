@@ -1,28 +1,14 @@
 #pragma once
 
+#include "Templates/Function.h"
+#include "SRTSocket.h"
+
 namespace SRTNetwork
 {
-    // 기존 상수들...
-    constexpr int OPT_MESSAGEAPI = 76;  // SRTO_MESSAGEAPI
-    constexpr int OPT_TRANSTYPE = 50;
-    constexpr int OPT_SENDER = 21;
-    constexpr int OPT_STREAMID = 47;
-    constexpr int OPT_PBKEYLEN = 27;
-    constexpr int OPT_PASSPHRASE = 26;
-    constexpr int OPT_LATENCY = 23;
-    constexpr int OPT_MSS = 0;
-    constexpr int OPT_FC = 4;
-    constexpr int OPT_SNDBUF = 5;
-    constexpr int OPT_SNDDROPDELAY = 30;
-    constexpr int OPT_RCVBUF = 6;           // SRTO_RCVBUF
-    constexpr int OPT_RCVDROPDELAY = 31;    // SRTO_RCVDROPDELAY
-    constexpr int OPT_SNDTIMEO = 34;
-    constexpr int OPT_PEERLATENCY = 18;
-    constexpr int OPT_PEERIDLETIMEO = 19;
-    constexpr int TRANSTYPE_LIVE = 0;
-    constexpr int OPT_VERSION = 31;         // SRTO_VERSION (0x1f)
-    constexpr int OPT_MINVERSION = 32;      // SRTO_MINVERSION (0x20)
-    constexpr int OPT_ENFORCEDENCRYPTION = 37; // SRTO_ENFORCEDENCRYPTION (0x25)
+    // SRTO_CRYPTOMODE 값 (ENABLE_AEAD_API_PREVIEW 빌드에만 존재) - AUTO는 옵션을 건드리지 않음 = AES-CTR
+    constexpr int CRYPTOMODE_AUTO = 0;
+    constexpr int CRYPTOMODE_AES_CTR = 1;
+    constexpr int CRYPTOMODE_AES_GCM = 2;
 
     // 버전 정보 구조체
     struct VersionInfo
@@ -49,29 +35,257 @@ namespace SRTNetwork
     bool CheckCompatibility();
     const char* GetVersionString();
 
-    // 기존 함수들...
+    // 모듈 시작/종료 시 한 번 (srt_startup/srt_cleanup, Windows는 WSAStartup 포함)
     bool Initialize();
     void Shutdown();
-    void* CreateSocket();
-    void CloseSocket(void* socket);
-    bool SetSocketOption(void* socket, int opt, const void* value, int len);
-    bool Connect(void* socket, const char* ip, int port);
-    bool Bind(void* socket, int port);
-    bool Listen(void* socket, int backlog);
-    void* Accept(void* socket);
-    int Send(void* socket, const char* data, int len);
-    const char* GetLastError();
+    // 스트리밍 송신 소켓 공통 옵션 (라이브 모드, 레이턴시, 버퍼 크기) - 하나라도 거부되면 false
+    bool ApplyLiveStreamOptions(FSRTSocket& socket, int latencyMs);
+    
+    // 앱 페이서(TokenBucketPacer)와 함께 쓰는 SRT 송신 속도 상한: MAXBW=0 → 상한 = INPUTBW x (1 + OHEADBW%)
+    // 페이서 최고 속도를 INPUTBW로 주고 재전송 여유 25% - SRT 상한이 페이서보다 낮으면 송신 버퍼에 다시 쌓였다가 몰려 나감
+    constexpr int PACING_OVERHEAD_PERCENT = 25;
+    bool ApplyPacingOptions(FSRTSocket& socket, int64 maxRateBytesPerSec);
+    
+    // 암호화 설정 - 스트리밍 시작 시 한 번 검증/변환해 두고 연결(재연결, 리스너)마다 그대로 적용
+    // 키 유도(PBKDF2)와 암호 컨텍스트 생성은 SRT가 핸드셰이크 때 연결당 한 번만 수행하고,
+    // 패킷마다는 IV만 바꿔서 같은 컨텍스트를 재사용한다 (TestPrograms/crypto_benchmark 참고)
+    struct EncryptionOptions
+    {
+        TArray<ANSICHAR> Passphrase;        // UTF-8 (널 종료 없음), 비어 있으면 암호화 안 함
+        int KeyLength = 16;                 // 16/24/32 = AES-128/192/256
+        int CryptoMode = CRYPTOMODE_AUTO;   // GCM일 때만 SRTO_CRYPTOMODE 설정 (AEAD 빌드 필요)
+        bool bEnforced = true;              // 비밀번호가 다르거나 한쪽만 암호화면 연결 거부
+        
+        bool IsEnabled() const { return Passphrase.Num() > 0; }
+    };
+    // 비밀번호 10~79자, 키 길이 16/24/32 - 실패 시 OutError에 사유
+    bool MakeEncryptionOptions(const FString& passphrase, int keyLength, int cryptoMode, bool bEnforced,
+                               EncryptionOptions& outOptions, FString& OutError);
+    // ApplyLiveStreamOptions 뒤에 호출 (TRANSTYPE이 암호화 옵션을 초기화하므로)
+    // 리스너 소켓에 적용하면 수락된 소켓이 물려받음
+    bool ApplyEncryptionOptions(FSRTSocket& socket, const EncryptionOptions& options);
+    // 연결 후 키 교환 상태 (SRT_KM_STATE: 0 암호화 안 함, 2 정상, 3/4/5 비밀번호 없음/틀림/모드 불일치)
+    int GetKeyMaterialState(SRTSOCKET socket);
+    const TCHAR* KeyMaterialStateToString(int state);
+    // 연결 실패 사유 (비밀번호 불일치 SRT_REJ_BADSECRET 등) - 소켓을 닫기 전에 호출
+    FString GetRejectReason(SRTSOCKET socket);
+    
+    // ===== 주소 해석 + 연결 =====
+    // IPv4/IPv6 주소 하나 (sockaddr_in 또는 sockaddr_in6 바이트 그대로)
+    struct Endpoint
+    {
+        uint8 Address[28] = {};
+        int Length = 0;
+        bool bIPv6 = false;
+        
+        FString ToString() const;           // "1.2.3.4:9000" / "[::1]:9000"
+    };
+    // 호스트 이름/IPv4/IPv6("::1" 또는 "[::1]") → 연결 시도 순서대로 정렬된 주소 목록 (IPv6/IPv4 번갈아)
+    // 주소 리터럴은 바로 반환, 이름은 스레드 풀에서 getaddrinfo - 호출 스레드는 shouldAbort를 보며 대기
+    // 결과는 RESOLVE_CACHE_SECONDS 동안 캐시해서 재연결 때 다시 조회하지 않음 (조회 실패 시 만료된 값이라도 사용)
+    constexpr double RESOLVE_CACHE_SECONDS = 60.0;
+    constexpr int RESOLVE_TIMEOUT_MS = 5000;
+    bool ResolveHost(const FString& host, int port, TArray<Endpoint>& OutEndpoints, FString& OutError,
+                     TFunctionRef<bool()> shouldAbort);
+    // 연결이 전부 실패하면 호출 - 다음 시도에서 다시 조회
+    void InvalidateResolvedHost(const FString& host, int port);
+    
+    // Happy Eyeballs (RFC 8305) 방식 연결: 주소마다 createSocket()으로 만든 소켓을 논블로킹으로 연결하고,
+    // 먼저 시도한 주소가 HAPPY_EYEBALLS_DELAY_MS 안에 안 붙으면 다음 주소도 동시에 시도해서 먼저 붙은 쪽을 사용
+    // 연결 대기는 epoll로 짧게 끊어서 shouldAbort를 확인 - 종료 요청이 연결 타임아웃을 기다리지 않음
+    // 성공하면 블로킹 상태의 연결된 소켓, 실패/중단이면 빈 소켓과 OutError (거부 사유 포함)
+    constexpr int HAPPY_EYEBALLS_DELAY_MS = 250;
+    FSRTSocket ConnectHost(const FString& host, int port, TFunctionRef<FSRTSocket()> createSocket, int timeoutMs,
+                           TFunctionRef<bool()> shouldAbort, FString& OutEndpoint, FString& OutError);
+    // 논블로킹으로 연결을 시작한 소켓/그룹이 연결될 때까지 대기 (shouldAbort 확인하며)
+    bool WaitConnected(SRTSOCKET socket, int timeoutMs, TFunctionRef<bool()> shouldAbort);
+    bool Bind(SRTSOCKET socket, int port);
+    bool Listen(SRTSOCKET socket, int backlog);
+    
+    // 송신 epoll - 소켓의 쓰기 가능/에러 이벤트 구독 (실패 시 -1)
+    int CreateSendEpoll(SRTSOCKET socket);
+    // 다른 스레드에서 호출하면 대기 중인 WaitWritable이 바로 -1로 끝남 (epoll 해제)
+    void InterruptEpoll(int eid);
+    // 1 = 쓰기 가능, 0 = 타임아웃, -1 = 소켓 에러 또는 인터럽트
+    int WaitWritable(int eid, int timeoutMs);
+    
+    // srt_time_now() - SRT 내부 시계 (마이크로초)
+    int64 GetTimeNowUs();
+    
+    // FPlatformTime::Seconds 시각 → UTC 마이크로초 (1970 기준 시스템 시계, 캡처 타임스탬프 SEI용)
+    // 호출할 때마다 두 시계를 새로 읽으므로 NTP/PTP 보정이 바로 반영된다
+    int64 ToUtcMicroseconds(double platformSeconds);
+    
+    // 캡처 시각(FPlatformTime::Seconds) → srctime 변환 (연결마다 Reset)
+    // SRT는 연결 시작 이전이거나 이전 메시지보다 이른 srctime을 받지 않으므로 그 범위로 제한한다
+    // 그룹은 멤버가 중간에 합류하면 그 멤버의 시작 이전 srctime을 거부하므로 0(전송 시각)을 쓴다
+    struct SourceClock
+    {
+        void Reset(SRTSOCKET socket);
+        int64 ToSourceTime(double captureSeconds);
+        
+    private:
+        int64 OffsetUs = 0;
+        int64 ConnectionTimeUs = 0;
+        int64 LastSourceTimeUs = 0;
+        bool bUseSendTime = false;
+    };
+    
+    // 토큰 버킷 송신 페이서 - 프레임 하나의 TS 청크를 프레임 간격의 일부에 걸쳐 나눠 보냄 (I-프레임 순간 폭주 방지)
+    // 버킷에 든 만큼은 바로 보내고, 그 이상은 토큰이 찰 때까지 대기. 토큰은 패킷(LIVE_PAYLOAD_SIZE) 단위로 꺼냄
+    // 슬립 정밀도가 약 1ms라 버킷 깊이는 최소 2ms 분량 - 깨어날 때마다 그동안 찬 만큼 보내므로 평균 속도는 유지됨
+    struct TokenBucketPacer
+    {
+        void Reset(int burstPackets, int64 maxRateBytesPerSec);
+        // 프레임 시작: bytes를 windowSeconds 안에 보내는 속도로 설정 (minRate ~ 최고 속도로 제한)
+        void BeginFrame(int bytes, double windowSeconds, int64 minRateBytesPerSec, double now);
+        // 지금 보낼 수 있는 바이트 (패킷 단위, 최대 wantBytes) - 0이면 OutWaitSeconds 뒤에 다시 시도
+        int Acquire(int wantBytes, double now, double& OutWaitSeconds);
+        void Consume(int bytes);
+        double GetRate() const { return RateBytesPerSec; }
+        
+    private:
+        void Refill(double now);
+        
+        double RateBytesPerSec = 0.0;
+        double MaxRateBytesPerSec = 0.0;
+        double BurstBytes = 0.0;
+        double DepthBytes = 0.0;
+        double Tokens = 0.0;
+        double LastRefill = 0.0;
+    };
+    
+    // 재연결 지수 백오프 (지연 = 초기값 x 2^n, 최대값 제한, +-20% 지터로 여러 송신기 동시 재시도 분산)
+    struct ReconnectBackoff
+    {
+        void Reset(int initialDelayMs, int maxDelayMs);
+        double NextDelaySeconds();
+        
+    private:
+        double InitialDelay = 0.5;
+        double MaxDelay = 8.0;
+        double CurrentDelay = 0.5;
+    };
+    
+    // SRT_TRACEBSTATS 전체 - 카운터를 지우지 않고(clear=0) 읽으므로 *Total은 연결 시작부터 누적
+    // 구간 값이 필요하면 StatsTracker로 두 스냅샷의 차이를 사용 (여러 곳에서 읽어도 서로 간섭하지 않음)
     struct Stats
     {
-        double mbpsSendRate;
-        double msRTT;
-        int pktSndLossTotal;
+        int64 msTimeStamp = 0;              // 연결 시작부터 경과 (SRT 시계)
+        
+        // 송신 누적
+        int64 pktSentTotal = 0;             // 재전송 포함
+        int64 pktSentUniqueTotal = 0;       // 애플리케이션이 보낸 고유 패킷
+        int pktRetransTotal = 0;
+        int pktSndLossTotal = 0;            // 수신 측 NAK로 보고된 손실
+        int pktSndDropTotal = 0;            // 늦어서 송신 측이 버림 (TLPKTDROP)
+        int pktRecvACKTotal = 0;
+        int pktRecvNAKTotal = 0;
+        int64 usSndDurationTotal = 0;
+        uint64 byteSentTotal = 0;
+        uint64 byteSentUniqueTotal = 0;
+        uint64 byteRetransTotal = 0;
+        uint64 byteSndDropTotal = 0;
+        
+        // 수신 누적
+        int64 pktRecvTotal = 0;
+        int64 pktRecvUniqueTotal = 0;
+        int pktRcvLossTotal = 0;
+        int pktRcvDropTotal = 0;            // 늦어서 재생 못 하고 건너뜀
+        int pktRcvUndecryptTotal = 0;
+        int pktSentACKTotal = 0;
+        int pktSentNAKTotal = 0;
+        uint64 byteRecvTotal = 0;
+        uint64 byteRcvLossTotal = 0;
+        uint64 byteRcvDropTotal = 0;
+        
+        // 연결 평균 속도 (clear=0이므로 연결 시작부터의 평균)
+        double mbpsSendRate = 0.0;
+        double mbpsRecvRate = 0.0;
+        
+        // 순간값
+        double msRTT = 0.0;
+        double mbpsBandwidth = 0.0;         // 추정 링크 대역폭
+        double mbpsMaxBW = 0.0;             // 송신 상한
+        double usPktSndPeriod = 0.0;
+        int pktFlowWindow = 0;
+        int pktCongestionWindow = 0;
+        int pktFlightSize = 0;
+        int byteAvailSndBuf = 0;
+        int byteAvailRcvBuf = 0;
+        int byteMSS = 0;
+        int pktSndBuf = 0;                  // ACK 안 된 송신 버퍼
+        int byteSndBuf = 0;
+        int msSndBuf = 0;
+        int msSndTsbPdDelay = 0;            // 협상된 피어 레이턴시
+        int pktRcvBuf = 0;
+        int byteRcvBuf = 0;
+        int msRcvBuf = 0;
+        int msRcvTsbPdDelay = 0;
+        int pktReorderTolerance = 0;
+    };
+    bool GetStats(SRTSOCKET socket, Stats& stats);
+    
+    // 두 누적 스냅샷 사이의 구간 값과 속도
+    struct StatsInterval
+    {
+        double Seconds = 0.0;
+        int64 PacketsSent = 0;              // 재전송 포함
+        int64 PacketsSentUnique = 0;
+        int64 PacketsRetransmitted = 0;
+        int64 PacketsLost = 0;              // 수신 측이 보고한 손실 (재전송으로 복구됐을 수 있음)
+        int64 PacketsDropped = 0;           // 송신 측에서 늦어서 버림 = 수신 측에서 실제로 빠진 데이터
+        int64 BytesSent = 0;
+        int64 BytesSentUnique = 0;
+        int64 BytesRetransmitted = 0;
+        int64 BytesDropped = 0;
+        double SendMbps = 0.0;              // 재전송 포함 선로 속도
+        double PayloadMbps = 0.0;           // 고유 데이터만
+        double RetransmitMbps = 0.0;
+        double LossPercent = 0.0;           // 손실 / 고유 송신
+        double RetransmitPercent = 0.0;     // 재전송 / 전체 송신
     };
-    bool GetStats(void* socket, Stats& stats);
-    bool SetNonBlocking(void* socket, bool nonblocking);
-    void* AcceptWithTimeout(void* socket, int timeout_ms);
     
-    // 정상 종료 및 상태 확인 함수들
-    bool GracefulShutdown(void* socket);
-    bool IsConnected(void* socket);
+    // 연결마다 Reset, 주기적으로 Sample해서 누적값과 직전 샘플 이후 구간 값을 얻음
+    struct StatsTracker
+    {
+        void Reset();
+        bool Sample(SRTSOCKET socket, Stats& outTotals, StatsInterval& outInterval);
+        
+    private:
+        Stats Last;
+        bool bHasLast = false;
+    };
+    // 논블로킹 리스너에서 대기 중인 연결 하나를 꺼냄 (없으면 빈 소켓, 기다리지 않음)
+    FSRTSocket AcceptPending(SRTSOCKET listenSocket, FString& OutPeerAddress);
+    
+    // ===== 소켓 그룹 (본딩) - SRT가 ENABLE_BONDING으로 빌드되어야 함 =====
+    // 그룹 ID는 소켓처럼 송신/epoll/통계/닫기에 그대로 사용 (옵션은 그룹에 설정하면 멤버가 물려받음)
+    struct GroupLink
+    {
+        FString LocalAddress;               // 비어 있으면 OS가 선택 (NIC를 고정하려면 해당 NIC의 IP)
+        int LocalPort = 0;
+        FString RemoteAddress;
+        int RemotePort = 0;
+        int Weight = 0;                     // 백업 모드: 높을수록 우선
+    };
+    // 그룹 생성은 FSRTSocket::CreateGroup(SRT_GTYPE_BROADCAST / SRT_GTYPE_BACKUP)
+    // Indices의 링크들을 그룹에 추가 - 링크 인덱스를 멤버 토큰으로 사용
+    // 블로킹 그룹이면 첫 멤버가 연결될 때까지 대기, 논블로킹이면 바로 반환 (연결은 백그라운드 - WaitConnected로 대기)
+    // 하나도 시작하지 못하면 false, OutErrors에 링크별 실패 사유
+    // RemoteAddress는 호스트 이름도 가능 (ResolveHost 캐시 사용), LocalAddress는 IP 리터럴
+    bool ConnectGroupLinks(SRTSOCKET group, const TArray<GroupLink>& links, const TArray<int32>& indices, TArray<FString>& OutErrors,
+                           TFunctionRef<bool()> shouldAbort);
+    
+    struct GroupMember
+    {
+        SRTSOCKET Socket = SRT_INVALID_SOCK;
+        int32 Token = -1;                   // ConnectGroupLinks의 링크 인덱스
+        FString PeerAddress;
+        int SocketState = 0;                // SRT_SOCKSTATUS
+        int MemberState = 0;                // SRT_MEMBERSTATUS (SRT_GST_*)
+        int Weight = 0;
+    };
+    bool GetGroupMembers(SRTSOCKET group, TArray<GroupMember>& OutMembers);
+    const TCHAR* MemberStateToString(int memberState);
 } 
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 인코더 과부하 조정기 - 인코딩 시간과 프레임 덮어쓰기(대기열 넘침)를 보고 인코딩 단계를 내리고 올린다
+ *
+ * 단계는 스트림 설정(0단계)에서 시작해 가벼운 순서로: x264/x265 프리셋을 한 단계씩 빠르게 → 해상도 → 프레임 속도.
+ * 각각 설정한 한계까지만 내려가고, 한계를 모두 1로 두면 단계가 하나뿐이라 아무것도 하지 않는다.
+ *
+ * 판단은 WindowSeconds 창마다:
+ *   내림  평균 인코딩 시간이 프레임 간격의 OverloadThreshold를 넘거나, 창 안의 프레임 10% 넘게 덮어써짐
+ *   올림  한 단계 위에서의 예상 부하(현재 부하 x 단계 비용 비)가 RecoverThreshold 아래로 RecoverSeconds 동안 유지
+ * 단계를 바꾼 뒤 CooldownSeconds 동안은 판단하지 않고 (새 인코더 워밍업), 올리자마자 다시 내려오면
+ * 다음 올림까지 기다리는 시간을 두 배로 늘린다 (최대 60초, 진동 방지).
+ *
+ * 한 스트림의 인코딩 쪽(워커 스레드 또는 풀 워커 - 동시에 하나만)에서만 호출. 시각은 호출자가 넘기므로
+ * 가짜 부하로도 그대로 돌릴 수 있다. 단계 목록은 Reset 뒤 바뀌지 않으므로 GetLevel은 어느 스레드에서든 읽어도 됨.
+ */
+class CINESRTSTREAM_API FSRTOverloadGovernor
+{
+public:
+    struct FLevel
+    {
+        int32 Width = 0;
+        int32 Height = 0;
+        int32 FPS = 0;
+        FString Preset;         // 비어 있으면 프리셋 없는 인코더 (하드웨어)
+        double Cost = 1.0;      // 0단계 대비 상대 인코딩 비용 (프레임당 시간 x fps)
+
+        FString ToString() const;
+    };
+
+    struct FConfig
+    {
+        // 0단계 = 스트림 설정
+        int32 Width = 1920;
+        int32 Height = 1080;
+        int32 FPS = 30;
+        FString Preset;                         // 비어 있으면 프리셋 단계 없음
+
+        // 내려갈 수 있는 한계
+        FString FastestPreset = TEXT("ultrafast");
+        float MinResolutionScale = 0.5f;        // 1이면 해상도 단계 없음
+        int32 MinFPS = 15;
+
+        float OverloadThreshold = 0.9f;         // 인코딩 시간 / 프레임 간격
+        float RecoverThreshold = 0.6f;
+        double WindowSeconds = 1.0;
+        double RecoverSeconds = 5.0;
+        double CooldownSeconds = 2.0;
+    };
+
+    /** 단계 목록을 새로 만들고 0단계에서 시작 */
+    void Reset(const FConfig& InConfig);
+
+    /**
+     * 인코딩한 프레임마다 호출 - EncodeMs는 변환 + 인코딩 시간, OverwrittenFrames는 FrameBuffer 누적 덮어쓰기 수
+     * 단계가 바뀌면 true (GetLevelIndex, GetLastReason)
+     */
+    bool AddSample(double EncodeMs, int32 OverwrittenFrames, double Now);
+
+    /** 인코더가 실제로 새 단계로 바뀐 시각 - 이때부터 CooldownSeconds 동안 판단 보류 */
+    void OnLevelApplied(double Now);
+
+    /** 인코더가 새 단계를 열지 못함 - Index 단계로 돌아가고 쿨다운 뒤 다시 판단 */
+    void RevertLevel(int32 Index, double Now);
+
+    bool IsEnabled() const { return Levels.Num() > 1; }
+    int32 GetLevelIndex() const { return Current; }
+    int32 GetLevelCount() const { return Levels.Num(); }
+    const FLevel& GetLevel(int32 Index) const { return Levels[FMath::Clamp(Index, 0, Levels.Num() - 1)]; }
+
+    /** 직전 창의 부하 (평균 인코딩 시간 / 프레임 간격) */
+    float GetLoad() const { return Load; }
+    const FString& GetLastReason() const { return LastReason; }
+
+private:
+    FConfig Config;
+    TArray<FLevel> Levels;
+    int32 Current = 0;
+    float Load = 0.0f;
+    FString LastReason;
+
+    // 판단 창
+    double WindowStart = 0.0;
+    double LastSampleTime = 0.0;
+    int32 WindowFrames = 0;
+    double WindowEncodeMs = 0.0;
+    int32 WindowOverwriteBase = 0;
+
+    double HoldUntil = 0.0;         // 쿨다운 끝
+    double RecoverStart = 0.0;      // 여유가 이어지기 시작한 시각 (0 = 여유 없음)
+    double RecoverHoldSeconds = 0.0;
+    double LastUpgradeTime = -1.0e9;
+
+    void ResetWindow(double Now, int32 OverwrittenFrames);
+    void ChangeLevel(int32 NewLevel, double Now);
+};
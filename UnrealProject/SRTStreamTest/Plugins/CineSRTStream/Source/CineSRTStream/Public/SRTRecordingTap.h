@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Containers/Queue.h"
+
+class IFileHandle;
+
+/**
+ * 다중화된 TS 출력을 로컬 디스크에 세그먼트 파일로 기록 (ISO 레코드)
+ *
+ * 송신 경로는 Submit()에서 복사 후 큐에 넣기만 하고, 파일 쓰기는 전용 I/O 스레드가
+ * 큰 정렬 블록 단위로 수행한다. 버퍼가 가득 차면 블록하지 않고 버리며,
+ * 버린 뒤에는 다음 키프레임부터 다시 기록해서 세그먼트가 디코딩 가능하게 유지된다.
+ */
+class CINESRTSTREAM_API FSRTRecordingTap : public FRunnable
+{
+public:
+    struct FConfig
+    {
+        FString OutputDirectory;               // 비어 있으면 Saved/SRTRecordings
+        FString FilePrefix = TEXT("SRTStream");
+        int32 SegmentDurationSec = 10;         // 키프레임에서만 분할
+        int32 MaxBufferedMB = 64;              // 이 이상 밀리면 드롭
+        int32 WriteBlockKB = 1024;             // 한 번에 쓰는 크기 (4KB 배수로 정렬)
+    };
+
+    struct FStats
+    {
+        int32 SegmentsWritten = 0;
+        int64 BytesWritten = 0;
+        int32 DroppedChunks = 0;
+        int64 DroppedBytes = 0;
+        int32 WriteErrors = 0;
+        int64 BufferedBytes = 0;
+    };
+
+    FSRTRecordingTap();
+    virtual ~FSRTRecordingTap();
+
+    bool Start(const FConfig& InConfig);
+    void Shutdown();
+    bool IsRecording() const { return bRecording.Load(); }
+
+    /**
+     * 다중화된 TS 패킷 제출 (송신 스레드에서 호출, 블록하지 않음)
+     * PTS: 90kHz, 세그먼트 길이 계산용. bKeyFrame: 세그먼트 분할/드롭 복구 지점
+     */
+    bool Submit(const TArray<uint8>& TSPackets, int64 PTS, bool bKeyFrame);
+
+    FStats GetStats() const;
+    FString GetCurrentSegmentPath() const;
+
+    // FRunnable interface
+    virtual bool Init() override;
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    struct FChunk
+    {
+        TArray<uint8> Data;
+        int64 PTS = 0;
+        bool bKeyFrame = false;
+        bool bDiscontinuity = false;  // 드롭 직후 첫 청크 → 새 세그먼트
+    };
+
+    FConfig Config;
+    FString OutputDirectory;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WorkEvent = nullptr;
+    TAtomic<bool> bShouldExit{false};
+    TAtomic<bool> bRecording{false};
+
+    // 송신 스레드(들) → I/O 스레드
+    TQueue<FChunk, EQueueMode::Mpsc> Chunks;
+    TAtomic<int64> BufferedBytes{0};
+    int64 MaxBufferedBytes = 0;
+    TAtomic<bool> bWaitForKeyFrame{true};  // 시작 시와 드롭 이후
+
+    // I/O 스레드 전용
+    IFileHandle* SegmentFile = nullptr;
+    uint8* WriteBlock = nullptr;           // 4KB 정렬 버퍼
+    int32 WriteBlockSize = 0;
+    int32 WriteBlockUsed = 0;
+    int64 SegmentStartPTS = 0;
+    int32 SegmentIndex = 0;
+
+    // 통계
+    TAtomic<int32> SegmentsWritten{0};
+    TAtomic<int64> BytesWritten{0};
+    TAtomic<int32> DroppedChunks{0};
+    TAtomic<int64> DroppedBytes{0};
+    TAtomic<int32> WriteErrors{0};
+
+    FString CurrentSegmentPath;
+    mutable FCriticalSection PathLock;
+
+    void WriteChunk(const FChunk& Chunk);
+    bool OpenSegment(int64 StartPTS);
+    void CloseSegment();
+    void FlushBlock();
+};
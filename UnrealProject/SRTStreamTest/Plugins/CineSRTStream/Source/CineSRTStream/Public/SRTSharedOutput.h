@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "Containers/Queue.h"
+
+#include "SRTVideoEncoder.h"
+#include "SRTTransportStream.h"
+#include "SRTRecordingTap.h"
+#include "SRTNetworkWorker.h"
+
+/**
+ * 여러 스트림 컴포넌트가 공유하는 MPTS 출력
+ *
+ * 같은 목적지(IP:Port)로 보내는 컴포넌트들의 인코딩된 프레임을
+ * 하나의 MPTS(프로그램별 PMT/PID)로 다중화해서 SRT 연결 하나로 전송한다.
+ * 소켓, 혼잡 제어, 송신 스레드가 컴포넌트 수와 관계없이 하나씩만 존재한다.
+ */
+class CINESRTSTREAM_API FSRTSharedOutput : public FRunnable
+{
+public:
+    struct FConfig
+    {
+        FString StreamIP = TEXT("127.0.0.1");
+        int32 StreamPort = 9001;
+        int32 LatencyMs = 120;
+        int32 MessageTTLMs = 0;  // 0 = 무제한 (첫 컴포넌트의 설정 사용)
+        SRTNetwork::EncryptionOptions Encryption;  // 첫 컴포넌트의 설정 사용
+        
+        // 재연결 (첫 컴포넌트의 설정 사용)
+        bool bAutoReconnect = true;
+        int32 ReconnectInitialDelayMs = 250;
+        int32 ReconnectMaxDelayMs = 8000;
+    };
+
+    // 프로그램별 통계 (컴포넌트가 자기 프로그램 값만 읽음)
+    struct FProgramStats
+    {
+        float BitrateKbps = 0.0f;
+        int64 FramesSent = 0;
+        int64 BytesSent = 0;
+        int32 QueueDrops = 0;
+        float CaptureSEIMicroseconds = 0.0f;  // 프레임당 캡처 SEI 삽입 비용 (누적 평균)
+    };
+
+    /** 목적지별 공유 출력 획득 (없으면 생성 후 송신 스레드 시작) */
+    static TSharedPtr<FSRTSharedOutput> Acquire(const FConfig& InConfig);
+
+    virtual ~FSRTSharedOutput();
+
+    // 프로그램 등록/해제 - PID는 TransportStream이 자동 할당
+    int32 RegisterProgram(const FString& ServiceName,
+                          bool bEnableSCTE35 = false,
+                          FSRTTransportStream::EMetadataFormat MetadataFormat = FSRTTransportStream::EMetadataFormat::None,
+                          uint8 VideoStreamType = TS_STREAM_TYPE_H264);
+    void UnregisterProgram(int32 ProgramIndex);
+    
+    // 프로그램별 SCTE-35/메타데이터 예약 (게임 스레드에서 호출)
+    bool ScheduleSpliceEvent(int32 ProgramIndex, const FSRTTransportStream::FSpliceEvent& Event);
+    bool ScheduleMetadata(int32 ProgramIndex, int64 PTS, const TArray<uint8>& Payload);
+
+    /** 인코딩된 프레임 제출 (컴포넌트 워커 스레드에서 호출) */
+    bool SubmitFrame(int32 ProgramIndex, FEncodedFrame&& Frame);
+
+    bool GetProgramStats(int32 ProgramIndex, FProgramStats& OutStats) const;
+    
+    // MPTS 전체를 로컬 디스크에 기록 (첫 요청의 설정 사용)
+    bool StartRecording(const FSRTRecordingTap::FConfig& RecordingConfig);
+    void StopRecording();
+    bool IsRecording() const { return RecordingTap.IsRecording(); }
+    FSRTRecordingTap::FStats GetRecordingStats() const { return RecordingTap.GetStats(); }
+    bool IsConnected() const { return bConnected.Load(); }
+    bool IsReconnecting() const { return bReconnecting.Load(); }
+    /** 연결될 때마다 증가 - 컴포넌트는 값이 바뀌면 IDR을 요청해서 재동기화 */
+    int32 GetConnectionEpoch() const { return ConnectionEpoch.Load(); }
+    float GetRTTMs() const { return RTTMs.Load(); }
+    int32 GetKeyMaterialState() const { return KeyMaterialState.Load(); }
+    int32 GetMessagesSent() const { return MessagesSent.Load(); }
+    int32 GetLastMessageNumber() const { return LastMessageNumber.Load(); }
+    const FConfig& GetConfig() const { return Config; }
+
+    // FRunnable interface
+    virtual bool Init() override;
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    explicit FSRTSharedOutput(const FConfig& InConfig);
+
+    static FString MakeKey(const FConfig& InConfig);
+
+    struct FPendingFrame
+    {
+        int32 ProgramIndex = INDEX_NONE;
+        FEncodedFrame Frame;
+    };
+
+    FConfig Config;
+
+    // 송신 스레드
+    FRunnableThread* Thread = nullptr;
+    FEvent* WorkEvent = nullptr;
+    TAtomic<bool> bShouldExit{false};
+    TAtomic<bool> bConnected{false};
+    TAtomic<bool> bReconnecting{false};
+    TAtomic<int32> ConnectionEpoch{0};
+    TAtomic<float> RTTMs{0.0f};
+    TAtomic<int32> KeyMaterialState{0};
+
+    FSRTSocket SRTSocket;
+    SRTNetwork::SourceClock SourceClock;  // 송신 스레드 전용
+    TAtomic<int32> MessagesSent{0};
+    TAtomic<int32> LastMessageNumber{-1};
+
+    // 컴포넌트 워커(다수) → 송신 스레드(하나)
+    TQueue<FPendingFrame, EQueueMode::Mpsc> PendingFrames;
+    TAtomic<int32> PendingCount{0};
+    static constexpr int32 MaxPendingFrames = 64;
+
+    // 다중화기 (프로그램 등록/해제와 송신 스레드가 공유)
+    FSRTTransportStream TransportStream;
+    mutable FCriticalSection MuxLock;
+    
+    // 로컬 기록 (송신 스레드가 다중화 직후 제출)
+    FSRTRecordingTap RecordingTap;
+    FCriticalSection RecordingLock;
+
+    // 통계
+    FProgramStats ProgramStats[TS_MAX_PROGRAMS];
+    int64 IntervalBytes[TS_MAX_PROGRAMS] = {0};
+    double LastStatsTime = 0.0;
+    mutable FCriticalSection StatsLock;
+
+    bool Connect(const FString& Key);
+    void Disconnect();
+    void DiscardPendingFrames();
+    bool SendPackets(const TArray<uint8>& TSPackets, double CaptureTime);
+    void UpdateStats();
+
+    // 목적지별 레지스트리
+    static TMap<FString, TWeakPtr<FSRTSharedOutput>> Registry;
+    static FCriticalSection RegistryLock;
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// srt.h는 winsock2.h를 포함하므로 UE의 Windows 타입 가드 안에서 포함
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#endif
+#include "srt.h"
+#if PLATFORM_WINDOWS
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+#include "SRTFrameTrace.h"
+
+#include <initializer_list>
+
+/**
+ * SRT 소켓/그룹 핸들 하나를 소유 (소멸 시 srt_close)
+ *
+ * 이동만 가능하고 복사는 안 됨. 옵션은 srt.h의 SRT_SOCKOPT를 그대로 받으므로 번호를 손으로 맞출 필요가 없고,
+ * 전송 경로(SendMessage/SendMessages)는 헤더에 인라인되어 srt_sendmsg2를 직접 호출한다.
+ * 그룹 ID도 소켓처럼 옵션/송신/epoll/통계/닫기에 그대로 사용한다.
+ */
+class FSRTSocket
+{
+public:
+    // 라이브 모드 메시지 하나 = TS 패킷 7개 = SRT 패킷 하나
+    static constexpr int32 LIVE_PAYLOAD_SIZE = 1316;
+
+    // SetOptions 일괄 적용용 정수 옵션
+    struct FIntOption
+    {
+        SRT_SOCKOPT Option;
+        int32 Value;
+    };
+
+    // SendMessages 결과 - 논블로킹 소켓에서 송신 버퍼가 차면 bWouldBlock = true, BytesSent까지만 전송됨
+    struct FSendResult
+    {
+        int32 MessagesSent = 0;
+        int32 LastMessageNumber = -1;
+        int32 BytesSent = 0;
+        bool bWouldBlock = false;
+    };
+
+    FSRTSocket() = default;
+    explicit FSRTSocket(SRTSOCKET InHandle) : Handle(InHandle) {}
+    ~FSRTSocket() { Close(); }
+
+    FSRTSocket(const FSRTSocket&) = delete;
+    FSRTSocket& operator=(const FSRTSocket&) = delete;
+
+    FSRTSocket(FSRTSocket&& Other) : Handle(Other.Release()) {}
+    FSRTSocket& operator=(FSRTSocket&& Other)
+    {
+        if (this != &Other)
+        {
+            Close();
+            Handle = Other.Release();
+        }
+        return *this;
+    }
+
+    // 실패하면 IsValid() == false (사유는 GetLastErrorString)
+    static FSRTSocket Create() { return FSRTSocket(srt_create_socket()); }
+    // 빌드가 본딩을 지원하지 않으면 실패 (SRT_EINVOP)
+    static FSRTSocket CreateGroup(SRT_GROUP_TYPE Type) { return FSRTSocket(srt_create_group(Type)); }
+
+    FORCEINLINE SRTSOCKET Get() const { return Handle; }
+    FORCEINLINE bool IsValid() const { return Handle != SRT_INVALID_SOCK; }
+    FORCEINLINE explicit operator bool() const { return IsValid(); }
+    FORCEINLINE bool IsGroup() const { return IsValid() && (Handle & SRTGROUP_MASK) != 0; }
+
+    // 소유권 포기 - 닫지 않고 핸들을 넘김
+    SRTSOCKET Release()
+    {
+        const SRTSOCKET Released = Handle;
+        Handle = SRT_INVALID_SOCK;
+        return Released;
+    }
+    void Close()
+    {
+        if (Handle != SRT_INVALID_SOCK)
+        {
+            srt_close(Handle);
+            Handle = SRT_INVALID_SOCK;
+        }
+    }
+
+    // ===== 옵션 =====
+    bool SetOption(SRT_SOCKOPT Option, const void* Value, int32 Length)
+    {
+        return srt_setsockflag(Handle, Option, Value, Length) != SRT_ERROR;
+    }
+    bool SetOption(SRT_SOCKOPT Option, int32 Value) { return SetOption(Option, &Value, sizeof(Value)); }
+    bool SetOption(SRT_SOCKOPT Option, int64 Value) { return SetOption(Option, &Value, sizeof(Value)); }
+    // 불리언 옵션도 SRT는 int로 받음 (bool 크기로 넘기면 SRT_EINVPARAM)
+    bool SetOption(SRT_SOCKOPT Option, bool Value) { return SetOption(Option, (int32)(Value ? 1 : 0)); }
+    bool SetOption(SRT_SOCKOPT Option, const TArray<ANSICHAR>& Value) { return SetOption(Option, Value.GetData(), Value.Num()); }
+
+    // 순서대로 적용, 처음 실패한 옵션에서 멈춤 (OutFailed에 그 옵션)
+    bool SetOptions(std::initializer_list<FIntOption> Options, SRT_SOCKOPT* OutFailed = nullptr)
+    {
+        for (const FIntOption& Option : Options)
+        {
+            if (!SetOption(Option.Option, Option.Value))
+            {
+                if (OutFailed) *OutFailed = Option.Option;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool GetOption(SRT_SOCKOPT Option, T& OutValue) const
+    {
+        int Length = sizeof(T);
+        return srt_getsockflag(Handle, Option, &OutValue, &Length) != SRT_ERROR;
+    }
+
+    // 송수신 모두 논블로킹 (수신 대기는 100ms로 제한)
+    bool SetNonBlocking(bool bNonBlocking)
+    {
+        bool bResult = SetOption(SRTO_SNDSYN, !bNonBlocking);
+        bResult &= SetOption(SRTO_RCVSYN, !bNonBlocking);
+        if (bNonBlocking)
+        {
+            SetOption(SRTO_RCVTIMEO, (int32)100);
+        }
+        return bResult;
+    }
+
+    // ===== 상태 =====
+    SRT_SOCKSTATUS GetState() const { return IsValid() ? srt_getsockstate(Handle) : SRTS_NONEXIST; }
+    bool IsConnected() const { return GetState() == SRTS_CONNECTED; }
+
+    // 송신 버퍼에 남아 있는 바이트 (아직 ACK되지 않은 데이터 포함)
+    int64 GetSendBufferBytes() const
+    {
+        size_t Blocks = 0;
+        size_t Bytes = 0;
+        if (srt_getsndbuffer(Handle, &Blocks, &Bytes) == SRT_ERROR) return 0;
+        return (int64)Bytes;
+    }
+
+    // ===== 송신 =====
+    // 메시지 하나 (LIVE_PAYLOAD_SIZE 이하) - 보낸 바이트 또는 SRT_ERROR, Control.msgno에 메시지 번호
+    FORCEINLINE int32 SendMessage(const uint8* Data, int32 Length, SRT_MSGCTRL& Control)
+    {
+        SRT_TRACE_SCOPE(CineSRT_srt_send);
+        return srt_sendmsg2(Handle, reinterpret_cast<const char*>(Data), Length, &Control);
+    }
+
+    // LIVE_PAYLOAD_SIZE 단위로 나눠 청크마다 srt_sendmsg2 한 번
+    // SourceTimeUs: SRT 시계 기준 원본 시각 (0 = 전송 시각), TTLMs: 이 시간 안에 못 보내면 버림 (-1 = 무제한)
+    FORCEINLINE bool SendMessages(const uint8* Data, int32 Length, int64 SourceTimeUs, int32 TTLMs, FSendResult& Out)
+    {
+        SRT_MSGCTRL Control = srt_msgctrl_default;
+
+        for (int32 Offset = 0; Offset < Length; Offset += LIVE_PAYLOAD_SIZE)
+        {
+            const int32 Chunk = FMath::Min(LIVE_PAYLOAD_SIZE, Length - Offset);
+
+            // 한 프레임의 청크는 모두 같은 캡처 시각 (수신 측에서 함께 전달됨)
+            Control.msgttl = TTLMs;
+            Control.inorder = 0;
+            Control.srctime = SourceTimeUs;
+
+            if (SendMessage(Data + Offset, Chunk, Control) == SRT_ERROR)
+            {
+                // 논블로킹 소켓의 버퍼 가득 참은 에러가 아님 - 호출자가 대기 또는 드롭 결정
+                if (GetLastErrorCode() == SRT_EASYNCSND)
+                {
+                    Out.bWouldBlock = true;
+                    return true;
+                }
+                return false;
+            }
+
+            Out.MessagesSent++;
+            Out.LastMessageNumber = Control.msgno;
+            Out.BytesSent += Chunk;
+        }
+        return true;
+    }
+
+    // ===== 에러 (호출 스레드의 마지막 SRT 에러) =====
+    static int32 GetLastErrorCode() { return srt_getlasterror(nullptr); }
+    static const char* GetLastErrorString() { return srt_getlasterror_str(); }
+
+private:
+    SRTSOCKET Handle = SRT_INVALID_SOCK;
+};
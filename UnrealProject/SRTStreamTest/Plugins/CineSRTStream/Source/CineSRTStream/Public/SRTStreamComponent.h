@@ -7,13 +7,28 @@
 #include "Camera/CameraComponent.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
+#include "Containers/TripleBuffer.h"
+#include "Containers/Queue.h"
 
 // 전방 선언 대신 헤더 포함!
 #include "SRTVideoEncoder.h"
 #include "SRTTransportStream.h"
+#include "SRTSharedOutput.h"
+#include "SRTListenerOutput.h"
+#include "SRTRecordingTap.h"
+#include "SRTNetworkWorker.h"
+#include "SRTStreamStats.h"
+#include "SRTFrameTrace.h"
+#include "SRTEncodePool.h"
+#include "SRTFrameSource.h"
+#include "SRTOverloadGovernor.h"
+#include "SRTEventChannel.h"
 
 #include "SRTStreamComponent.generated.h"
 
+class FRHIGPUTextureReadback;
+class FRHICommandListImmediate;
+
 // ===== ENUM 정의들을 여기에 먼저! =====
 
 UENUM(BlueprintType)
@@ -79,12 +94,45 @@ enum class EEncoderTune : uint8
     ZeroLatency UMETA(DisplayName = "Zero Latency (Live)")
 };
 
+UENUM(BlueprintType)
+enum class ESRTVideoCodec : uint8
+{
+    H264 UMETA(DisplayName = "H.264 (AVC)"),
+    HEVC UMETA(DisplayName = "H.265 (HEVC)")
+};
+
+/** 캡처 픽셀 배열 - YUV는 GPU가 변환해 리드백이 4 → 1.5바이트/픽셀 (패턴/파일 공급원은 같은 식의 CPU 변환) */
+UENUM(BlueprintType)
+enum class ESRTCaptureFormat : uint8
+{
+    BGRA UMETA(DisplayName = "BGRA (CPU converts to YUV)"),
+    NV12 UMETA(DisplayName = "NV12 (GPU converts)"),
+    I420 UMETA(DisplayName = "I420 (GPU converts)")
+};
+
+UENUM(BlueprintType)
+enum class ESRTColorMatrix : uint8
+{
+    BT709 UMETA(DisplayName = "BT.709 (HD)"),
+    BT601 UMETA(DisplayName = "BT.601 (SD)")
+};
+
+UENUM(BlueprintType)
+enum class ESRTTimedMetadataFormat : uint8
+{
+    None UMETA(DisplayName = "None"),
+    ID3 UMETA(DisplayName = "ID3 (Timed ID3)"),
+    KLV UMETA(DisplayName = "KLV (SMPTE 336)")
+};
+
 // 전방 선언 제거
 // class FSRTVideoEncoder;  <- 삭제
 // class FSRTTransportStream;  <- 삭제
 
 // Forward declarations
 class FSRTStreamWorker;
+struct FSRTWorkerEvent;
+class USRTStreamSubsystem;
 
 UENUM(BlueprintType)
 enum class ESRTStreamMode : uint8
@@ -102,9 +150,145 @@ enum class ESRTConnectionState : uint8
     Connecting UMETA(DisplayName = "Connecting"),
     Connected UMETA(DisplayName = "Connected"),
     Streaming UMETA(DisplayName = "Streaming"),
+    Reconnecting UMETA(DisplayName = "Reconnecting"),
     Error UMETA(DisplayName = "Error")
 };
 
+UENUM(BlueprintType)
+enum class ESRTReconnectPolicy : uint8
+{
+    KeepEncoding UMETA(DisplayName = "Keep Encoding (drop output)"),
+    PauseEncoding UMETA(DisplayName = "Pause Encoding (skip frames)")
+};
+
+UENUM(BlueprintType)
+enum class ESRTConnectionMode : uint8
+{
+    Caller UMETA(DisplayName = "Caller (connect to receiver)"),
+    Listener UMETA(DisplayName = "Listener (receivers connect here)")
+};
+
+UENUM(BlueprintType)
+enum class ESRTEncryptionKeyLength : uint8
+{
+    AES128 = 16 UMETA(DisplayName = "AES-128"),
+    AES192 = 24 UMETA(DisplayName = "AES-192"),
+    AES256 = 32 UMETA(DisplayName = "AES-256")
+};
+
+UENUM(BlueprintType)
+enum class ESRTCipherMode : uint8
+{
+    AES_CTR UMETA(DisplayName = "AES-CTR"),
+    AES_GCM UMETA(DisplayName = "AES-GCM (authenticated)")
+};
+
+UENUM(BlueprintType)
+enum class ESRTBondingMode : uint8
+{
+    None UMETA(DisplayName = "None (single link)"),
+    Broadcast UMETA(DisplayName = "Broadcast (all links)"),
+    MainBackup UMETA(DisplayName = "Main/Backup")
+};
+
+/** 본딩 링크 하나 (로컬 NIC → 수신기 주소) */
+USTRUCT(BlueprintType)
+struct FSRTBondingLink
+{
+    GENERATED_BODY()
+    
+    /** 이 링크가 나갈 NIC의 IP (비우면 OS 라우팅) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Bonding")
+    FString LocalAddress;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Bonding", meta = (ClampMin = "0", ClampMax = "65535"))
+    int32 LocalPort = 0;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Bonding")
+    FString RemoteAddress = TEXT("127.0.0.1");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Bonding", meta = (ClampMin = "1", ClampMax = "65535"))
+    int32 RemotePort = 9001;
+    
+    /** Main/Backup: 높을수록 우선 (가장 높은 링크가 메인) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Bonding", meta = (ClampMin = "0", ClampMax = "65535"))
+    int32 Weight = 0;
+};
+
+/** 본딩 멤버 링크 하나의 상태 */
+USTRUCT(BlueprintType)
+struct FSRTBondingMemberInfo
+{
+    GENERATED_BODY()
+    
+    /** BondingLinks 인덱스 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    int32 LinkIndex = -1;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    FString PeerAddress;
+    
+    /** Pending / Idle(대기 백업) / Running / Broken */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    FString State;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    int32 Weight = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    float RTTMs = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    float SendRateMbps = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    float LossPercent = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    int64 PacketsSent = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Bonding")
+    int64 PacketsRetransmitted = 0;
+};
+
+/** 리스너 모드 구독자 하나의 상태 */
+USTRUCT(BlueprintType)
+struct FSRTSubscriberInfo
+{
+    GENERATED_BODY()
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    FString PeerAddress;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    float ConnectedSeconds = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    int64 BytesSent = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    int64 FramesSent = 0;
+    
+    /** 키프레임 대기 또는 큐 초과로 건너뛴 프레임 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    int32 FramesSkipped = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    int32 KeyFrameResyncs = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    int32 QueuedFrames = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    float RTTMs = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    float SendRateMbps = 0.0f;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Subscriber")
+    FString EncryptionState;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
     FOnSRTStateChanged,
     ESRTConnectionState, NewState,
@@ -118,39 +302,55 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
     float, RTTms
 );
 
-// 단순한 프레임 버퍼 시스템
-class FrameBuffer {
+// 전용 GPU 읽기 매니저 (단순화된 버전) - 씬 캡처 공급원
+class FGPUReadbackManager : public FSRTFrameSource {
 public:
-    struct Frame {
-        TArray<uint8> Data;
-        uint32 FrameNumber;
-        double Timestamp;
-        int32 Width;
-        int32 Height;
+    // 리드백 하나 - 게임 스레드에서 만들고 렌더 스레드로 넘김
+    struct FReadbackRequest
+    {
+        TSharedPtr<FGPUReadbackManager> Manager;
+        FTextureRenderTargetResource* Resource = nullptr;
+        uint32 FrameNumber = 0;
+        int32 Width = 0;
+        int32 Height = 0;
+        double CaptureTime = 0.0;
+        FSRTFrameTrace Trace;
+        // Resource에서 읽을 영역 - 기본은 렌더 타깃 전체, 배치 캡처면 아틀라스 타일
+        FIntRect SourceRect;
+        // NV12/I420이면 GPU에서 변환한 평면(1.5바이트/픽셀)을 읽음 (SetOutputFormat)
+        EVideoPixelFormat Format = EVideoPixelFormat::BGRA;
+        FSRTYUVColorParams Color;
     };
     
-    void SetFrame(Frame&& frame);
-    bool GetFrame(Frame& OutFrame);
-    void Clear();
-    bool HasNewFrame() const;
-    
-private:
-    Frame CurrentFrame;
-    mutable FCriticalSection Mutex;
-    TAtomic<bool> bNewFrameReady{false};
-};
-
-// 전용 GPU 읽기 매니저 (단순화된 버전)
-class FGPUReadbackManager : public TSharedFromThis<FGPUReadbackManager> {
-public:
     FGPUReadbackManager(TSharedPtr<FrameBuffer> InFrameBuffer);
+    virtual ~FGPUReadbackManager();
     
-    void RequestReadback(UTextureRenderTarget2D* RenderTarget, uint32 FrameNumber);
-    void Shutdown();
+    virtual const TCHAR* GetName() const override { return TEXT("SceneCapture"); }
     
+    // 반드시 GameThread에서 호출 (CaptureScene 직후)
+    bool PrepareReadback(UTextureRenderTarget2D* RenderTarget, uint32 FrameNumber, FReadbackRequest& OutRequest);
+    // 여러 스트림의 리드백을 렌더 명령 하나로 - 복사는 스트림마다 백그라운드 태스크
+    // Resource가 같은 연속 요청(아틀라스 타일)은 한 번에 읽고 타일별로 나눔
+    static void SubmitReadbacks(TArray<FReadbackRequest>&& Requests);
+
 private:
-    TSharedPtr<FrameBuffer> MyFrameBuffer;  // 명확한 이름
-    TAtomic<bool> bShuttingDown{false};
+    // 복사를 넣어 둔 YUV 프레임 하나 - 이후 렌더 명령에서 IsReady로 확인해 꺼냄
+    struct FPendingYUVReadback
+    {
+        TUniquePtr<FRHIGPUTextureReadback> Readback;
+        FReadbackRequest Request;                                         // Manager는 비움 (순환 참조 방지)
+        TSharedPtr<TArray<FColor>, ESPMode::ThreadSafe> VerifyPixels;     // CineSRT.VerifyGPUYUV - 요청 시점에 읽은 BGRA
+    };
+    // 스트림당 동시에 GPU에 걸어 둘 수 있는 YUV 복사 수 - 다 차면 가장 오래된 복사의 펜스만 기다림
+    static constexpr int32 MaxYUVInFlight = 3;
+
+    // YUV 요청 - 변환 패스를 그래프 하나에 모아 실행하고 복사는 기다리지 않음 (다음 요청 때 전달)
+    static void ReadbackYUV(FRHICommandListImmediate& RHICmdList, TArray<FReadbackRequest*>& Requests);
+    // 렌더 스레드 - 복사가 끝난 YUV 프레임을 순서대로 전달하고, 새 복사 SlotsNeeded 개가 들어갈 때까지 오래된 것부터 대기
+    void DeliverYUVReadbacks(FRHICommandListImmediate& RHICmdList, int32 SlotsNeeded);
+
+    TArray<FPendingYUVReadback> YUVInFlight;                        // 렌더 스레드 전용, 오래된 순
+    TArray<TUniquePtr<FRHIGPUTextureReadback>> YUVReadbackPool;     // 렌더 스레드 전용, 다시 쓸 스테이징 버퍼
 };
 
 UCLASS(ClassGroup=(Streaming), meta=(BlueprintSpawnableComponent), DisplayName="SRT Stream Component")
@@ -185,7 +385,39 @@ public:
         meta = (EditCondition = "!bIsStreaming"))
     bool bUseHardwareAcceleration = true;
     
+    /** 비디오 코덱 - HEVC는 4K에서 H.264 대비 약 절반 비트레이트 (인코더가 없으면 H.264로 대체) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Advanced",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTVideoCodec VideoCodec = ESRTVideoCodec::H264;
+
+    /** 프레임마다 캡처 시각(UTC)과 프레임 번호를 SEI(user_data_unregistered)로 삽입 - srt_monitor가 glass-to-glass 지연을 잼 (디코더는 무시) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Advanced",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bEmbedCaptureTimestamp = true;
+
+    /** 캡처 픽셀 배열 - NV12/I420은 GPU 컴퓨트 셰이더가 YUV로 바꿔 리드백이 BGRA의 37.5%이고 인코더 색 변환이 없음
+     *  (테스트 패턴/파일 공급원은 같은 식의 CPU 변환, GPU가 SM5 미만이거나 -nullrhi면 씬 캡처는 BGRA로 대체) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Advanced",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTCaptureFormat CaptureFormat = ESRTCaptureFormat::BGRA;
+
+    /** RGB → YUV 행렬 - 캡처 형식과 관계없이 적용하고 비트스트림(VUI)에도 표기 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Advanced",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTColorMatrix ColorMatrix = ESRTColorMatrix::BT709;
+
+    /** 전체 범위 YUV (0-255) - 끄면 방송 표준 제한 범위 (Y 16-235) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Advanced",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bFullRangeColor = false;
+
     // ========== 네트워크 설정 ==========
+    /** Caller: StreamIP:StreamPort로 접속 / Listener: StreamPort에서 여러 수신기의 접속을 받음 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Network",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTConnectionMode ConnectionMode = ESRTConnectionMode::Caller;
+    
+    /** IPv4, IPv6("::1" 또는 "[::1]"), 호스트 이름 - 이름은 워커에서 해석하고 재연결 때는 캐시 사용 */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Network",
         meta = (EditCondition = "!bIsStreaming"))
     FString StreamIP = TEXT("127.0.0.1");
@@ -199,6 +431,232 @@ public:
                ToolTip = "SRT Latency in milliseconds. Lower = less delay but more packet loss"))
     int32 LatencyMs = 120;
     
+    /** 같은 IP:Port로 보내는 컴포넌트들과 SRT 연결 하나를 공유 (MPTS 프로그램으로 다중화) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Network",
+        meta = (EditCondition = "!bIsStreaming",
+               ToolTip = "Mux this camera as one program of a shared MPTS. Components with the same IP:Port share one SRT socket and sender thread"))
+    bool bUseSharedConnection = false;
+    
+    /** SRT 메시지 TTL - 이 시간 안에 보내지 못한 TS 청크는 송신 버퍼에서 버림 (0 = 무제한) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Network",
+        meta = (EditCondition = "!bIsStreaming", ClampMin = "0", ClampMax = "10000"))
+    int32 MessageTTLMs = 0;
+    
+    // ========== 송신 페이싱 ==========
+    /** 프레임 하나의 TS 청크를 프레임 간격의 일부에 걸쳐 나눠 보냄 (I-프레임 순간 폭주로 중간 장비 버퍼가 넘치는 것 방지, Caller 직접 연결 전용) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Pacing",
+        meta = (EditCondition = "!bIsStreaming && ConnectionMode == ESRTConnectionMode::Caller && !bUseSharedConnection"))
+    bool bEnablePacing = false;
+    
+    /** 프레임 간격 중 전송에 쓰는 비율 - 0.5면 30fps에서 프레임마다 약 17ms에 걸쳐 전송 (srctime은 캡처 시각이라 수신 측 재생 타이밍은 그대로) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Pacing",
+        meta = (EditCondition = "!bIsStreaming && bEnablePacing", ClampMin = "0.1", ClampMax = "1.0"))
+    float PacingWindowFraction = 0.5f;
+    
+    /** 한 번에 몰아 보낼 수 있는 최대 SRT 패킷 수 (토큰 버킷 깊이) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Pacing",
+        meta = (EditCondition = "!bIsStreaming && bEnablePacing", ClampMin = "1", ClampMax = "64"))
+    int32 PacingBurstPackets = 8;
+    
+    /** 페이서 최고 속도 Mbps (0 = 비트레이트의 8배) - SRT 송신 상한(SRTO_INPUTBW)도 이 값 + 25%로 설정됨 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Pacing",
+        meta = (EditCondition = "!bIsStreaming && bEnablePacing", ClampMin = "0", ClampMax = "1000"))
+    float PacingMaxRateMbps = 0.0f;
+    
+    // ========== 캡처 ==========
+    /** 해상도가 같은 다른 스트림 카메라와 뷰 패밀리 하나로 렌더 (그림자/조명 등 장면 단위 작업 공유, 아틀라스에서 스트림별로 나눠 읽음) - 스트리밍 중에도 전환 가능, 카메라당 GPU 시간은 USRTStreamSubsystem::GetCaptureStats */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Capture")
+    bool bBatchedCapture = false;
+    
+    /** 프레임 공급원 - 테스트 패턴/파일은 카메라와 GPU 없이 인코딩 → SRT 전체 경로를 돌림 (헤드리스 벤치마크, 송출 점검) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Capture",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTFrameSourceType FrameSource = ESRTFrameSourceType::SceneCapture;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Capture",
+        meta = (EditCondition = "!bIsStreaming && FrameSource == ESRTFrameSourceType::TestPattern"))
+    ESRTTestPattern TestPattern = ESRTTestPattern::MovingBars;
+    
+    /** .y4m (8비트 4:2:0) 또는 원시 BGRA 프레임 파일 - 해상도는 StreamMode와 같아야 함, 끝나면 반복 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Capture",
+        meta = (EditCondition = "!bIsStreaming && FrameSource == ESRTFrameSourceType::File"))
+    FString SourceFilePath;
+    
+    // ========== 과부하 조정 ==========
+    /** 인코딩이 프레임 간격을 못 따라가면 x264 프리셋 → 해상도 → 프레임 속도 순으로 낮추고, 여유가 생기면 되돌림 (단계마다 IDR부터 새 설정) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bEnableOverloadGovernor = false;
+    
+    /** 가장 빠른 쪽 한계 프리셋 (소프트웨어 인코더만, 스트림 프리셋보다 느리면 프리셋 단계 없음) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor"))
+    EEncoderPreset OverloadFastestPreset = EEncoderPreset::UltraFast;
+    
+    /** 해상도 하한 (StreamMode 대비, 1 = 해상도 유지) - 파일 공급원은 항상 1 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor", ClampMin = "0.25", ClampMax = "1.0"))
+    float OverloadMinResolutionScale = 0.5f;
+    
+    /** 프레임 속도 하한 (StreamFPS 이상이면 프레임 속도 유지) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor", ClampMin = "1", ClampMax = "60"))
+    int32 OverloadMinFPS = 15;
+    
+    /** 평균 인코딩 시간이 프레임 간격의 이 비율을 넘으면 한 단계 내림 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor", ClampMin = "0.5", ClampMax = "1.5"))
+    float OverloadThreshold = 0.9f;
+    
+    /** 한 단계 위의 예상 부하가 이 비율 아래로 OverloadRecoverSeconds 동안 유지되면 올림 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor", ClampMin = "0.1", ClampMax = "1.0"))
+    float OverloadRecoverThreshold = 0.6f;
+    
+    /** 올리기 전 여유를 지켜보는 시간 - 올리자마자 다시 내려오면 두 배씩 (최대 60초) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Overload",
+        meta = (EditCondition = "!bIsStreaming && bEnableOverloadGovernor", ClampMin = "1", ClampMax = "60"))
+    float OverloadRecoverSeconds = 5.0f;
+    
+    /** 지금 단계 (0 = 스트림 설정 그대로) - 바뀔 때마다 OnStatsUpdated */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Overload")
+    int32 OverloadLevel = 0;
+    
+    /** 지금 단계의 캡처/인코딩 설정 (예: "1280x720@30 ultrafast") */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Overload")
+    FString OverloadState;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Listener",
+        meta = (EditCondition = "!bIsStreaming && ConnectionMode == ESRTConnectionMode::Listener", ClampMin = "1", ClampMax = "64"))
+    int32 MaxSubscribers = 16;
+    
+    /** 구독자별 대기 프레임 한도 - 넘으면 그 구독자만 다음 키프레임까지 건너뜀 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Listener",
+        meta = (EditCondition = "!bIsStreaming && ConnectionMode == ESRTConnectionMode::Listener", ClampMin = "2", ClampMax = "300"))
+    int32 SubscriberQueueFrames = 30;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Listener")
+    int32 SubscriberCount = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Listener")
+    TArray<FSRTSubscriberInfo> SubscriberStats;
+    
+    // ========== 본딩 ==========
+    /** 여러 업링크로 SRT 소켓 그룹 전송 (Caller 직접 연결 전용, 수신 측은 groupconnect=1 리스너) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Bonding",
+        meta = (EditCondition = "!bIsStreaming && ConnectionMode == ESRTConnectionMode::Caller && !bUseSharedConnection"))
+    ESRTBondingMode BondingMode = ESRTBondingMode::None;
+    
+    /** 링크 목록 - 본딩 모드에서는 StreamIP/StreamPort 대신 사용 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Bonding",
+        meta = (EditCondition = "!bIsStreaming && BondingMode != ESRTBondingMode::None"))
+    TArray<FSRTBondingLink> BondingLinks;
+    
+    /** Main/Backup: 응답이 이 시간 넘게 없으면 메인을 불안정으로 보고 백업 활성화 (레이턴시보다 작게) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Bonding",
+        meta = (EditCondition = "!bIsStreaming && BondingMode == ESRTBondingMode::MainBackup", ClampMin = "60", ClampMax = "5000"))
+    int32 BackupStabilityTimeoutMs = 60;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Bonding")
+    int32 BondingActiveLinks = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Bonding")
+    TArray<FSRTBondingMemberInfo> BondingMembers;
+    
+    // ========== 암호화 ==========
+    /** SRT AES 암호화 - 수신 측에도 같은 비밀번호와 키 길이 필요 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Encryption",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bUseEncryption = false;
+    
+    /** 10~79자 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Encryption",
+        meta = (EditCondition = "!bIsStreaming && bUseEncryption", PasswordField = true))
+    FString EncryptionPassphrase;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Encryption",
+        meta = (EditCondition = "!bIsStreaming && bUseEncryption"))
+    ESRTEncryptionKeyLength EncryptionKeyLength = ESRTEncryptionKeyLength::AES128;
+    
+    /** AES-GCM은 패킷마다 무결성 태그를 검증 (수신 측 SRT 1.5.2 이상, AEAD 지원 빌드 필요) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Encryption",
+        meta = (EditCondition = "!bIsStreaming && bUseEncryption"))
+    ESRTCipherMode EncryptionCipher = ESRTCipherMode::AES_CTR;
+    
+    /** 비밀번호가 다르거나 한쪽만 암호화하면 연결 거부 (끄면 연결은 되지만 수신 측이 복호화하지 못함) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Encryption",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bEnforceEncryption = true;
+    
+    /** 키 교환 상태 (Secured = 정상) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Encryption")
+    FString EncryptionState;
+    
+    // ========== 재연결 ==========
+    /** 연결이 끊기면 인코더/캡처를 유지한 채 워커 안에서 재연결 (복구 시 IDR + PAT/PMT부터 전송) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Reconnect",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bAutoReconnect = true;
+    
+    /** 첫 재시도 지연 - 실패할 때마다 두 배 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Reconnect",
+        meta = (EditCondition = "!bIsStreaming && bAutoReconnect", ClampMin = "10", ClampMax = "10000"))
+    int32 ReconnectInitialDelayMs = 250;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Reconnect",
+        meta = (EditCondition = "!bIsStreaming && bAutoReconnect", ClampMin = "100", ClampMax = "60000"))
+    int32 ReconnectMaxDelayMs = 8000;
+    
+    /** 0 = 무제한 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Reconnect",
+        meta = (EditCondition = "!bIsStreaming && bAutoReconnect", ClampMin = "0"))
+    int32 MaxReconnectAttempts = 0;
+    
+    /** 끊긴 동안의 프레임 처리 (라이브이므로 버퍼링하지 않음 - 복구 후 늦은 프레임은 수신 측에서 어차피 버려짐) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Reconnect",
+        meta = (EditCondition = "!bIsStreaming && bAutoReconnect"))
+    ESRTReconnectPolicy ReconnectPolicy = ESRTReconnectPolicy::PauseEncoding;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Reconnect")
+    int32 ReconnectCount = 0;
+    
+    /** 마지막 끊김부터 재연결 후 첫 IDR 전송까지 걸린 시간 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Reconnect")
+    float LastRecoveryTimeMs = 0.0f;
+    
+    // ========== 로컬 기록 ==========
+    /** 송신과 별도로 TS 세그먼트를 로컬 디스크에 기록 (ISO 레코드) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Recording",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bRecordLocally = false;
+    
+    /** 비어 있으면 Saved/SRTRecordings */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Recording",
+        meta = (EditCondition = "!bIsStreaming && bRecordLocally"))
+    FString RecordingDirectory;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Recording",
+        meta = (EditCondition = "!bIsStreaming && bRecordLocally", ClampMin = "1", ClampMax = "3600"))
+    int32 RecordingSegmentSeconds = 10;
+    
+    /** 디스크가 따라오지 못해 버린 청크 수 (송신에는 영향 없음) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Recording")
+    int32 RecordingDroppedChunks = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stream|Recording")
+    int32 RecordingSegmentsWritten = 0;
+    
+    // ========== 메타데이터 (PMT에 PID가 들어가므로 스트리밍 전에만 변경) ==========
+    /** SCTE-35 스플라이스 PID 추가 (광고 마커) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Metadata",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bEnableSCTE35 = false;
+    
+    /** 타임드 메타데이터 PID 포맷 (렌즈/트래킹/타임코드 등) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Metadata",
+        meta = (EditCondition = "!bIsStreaming"))
+    ESRTTimedMetadataFormat TimedMetadataFormat = ESRTTimedMetadataFormat::None;
+    
     // ========== 읽기 전용 상태 ==========
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SRT Stream|Status")
     FString CurrentStatus = TEXT("Ready");
@@ -220,9 +678,40 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
     float RoundTripTimeMs = 0.0f;
     
+    /** 보낸 SRT 메시지 수 (1316바이트 TS 청크 하나 = 메시지 하나) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
+    int32 MessagesSent = 0;
+    
+    /** 마지막으로 보낸 메시지 번호 (수신 측 로그와 대조용) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
+    int32 LastMessageNumber = -1;
+    
+    /** 송신 버퍼 혼잡으로 버린 프레임 수 (이후 IDR부터 재개) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
+    int32 BackpressureDrops = 0;
+    
     UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
     FString LastErrorMessage;
     
+    /** 전체 통계 (누적/구간/순간값) - 1초마다 워커가 발행한 최신 스냅샷 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Status")
+    FSRTNetworkStats NetworkStats;
+    
+    // ========== 통계 기록 ==========
+    /** 통계 스냅샷을 1초마다 파일로 기록 (사후 분석용 시계열) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Stats",
+        meta = (EditCondition = "!bIsStreaming"))
+    bool bExportStats = false;
+    
+    /** 비어 있으면 Saved/SRTStats */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Stats",
+        meta = (EditCondition = "!bIsStreaming && bExportStats"))
+    FString StatsExportDirectory;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SRT Stream|Stats",
+        meta = (EditCondition = "!bIsStreaming && bExportStats"))
+    ESRTStatsExportFormat StatsExportFormat = ESRTStatsExportFormat::CSV;
+    
     // === 이벤트 ===
     
     UPROPERTY(BlueprintAssignable, Category = "SRT Events")
@@ -251,6 +740,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SRT Stream", meta = (CallInEditor = "true"))
     void TestConnection();
     
+    /** 최근 프레임 추적을 Chrome trace JSON으로 저장 (CineSRT.FrameTrace 1일 때 기록됨) - 쓴 파일 경로, 실패하면 빈 문자열 */
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Debug")
+    FString DumpFrameTrace(const FString& FilePath);
+    
+    /** 이번 세션의 프레임 공급원 (스트리밍 중이 아니면 null) */
+    TSharedPtr<FSRTFrameSource> GetFrameSource() const { return ActiveFrameSource; }
+    
+    /** 지금 캡처 프레임 속도 - 과부하 조정으로 StreamFPS보다 낮을 수 있음 */
+    float GetCaptureFPS() const { return CaptureFPS; }
+    
     UFUNCTION(BlueprintCallable, Category = "SRT Stream")
     bool IsReadyToStream() const 
     { 
@@ -299,6 +798,31 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SRT Stream|Runtime")
     void ApplyRuntimeSettings();
 
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream")
+    FSRTNetworkStats GetNetworkStats() const { return NetworkStats; }
+    
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Listener")
+    TArray<FSRTSubscriberInfo> GetSubscriberStats() const { return SubscriberStats; }
+
+    // 메타데이터 예약 - FramePTS는 GetFramePTS로 얻은 대상 프레임의 PTS (90kHz)
+    /** 다음에 인코딩될 프레임부터 FramesAhead 뒤 프레임의 PTS */
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Metadata")
+    int64 GetFramePTS(int32 FramesAhead = 0) const;
+
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Metadata")
+    bool ScheduleSpliceInsert(int64 FramePTS, int32 EventID, bool bOutOfNetwork = true, float BreakDurationSec = 0.0f);
+
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Metadata")
+    bool ScheduleTimeSignal(int64 FramePTS);
+
+    /** 원본 ID3 태그 또는 KLV 패킷을 그대로 전송 */
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Metadata")
+    bool ScheduleTimedMetadata(int64 FramePTS, const TArray<uint8>& Payload);
+
+    /** ID3 TXXX 텍스트 프레임으로 전송 (TimedMetadataFormat = ID3) */
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Metadata")
+    bool ScheduleID3Text(int64 FramePTS, const FString& Description, const FString& Value);
+
     // Details 패널에 버튼 추가
     UFUNCTION(BlueprintCallable, Category = "SRT Stream|Presets", 
         meta = (CallInEditor = "true", DisplayName = "Apply Gaming Preset"))
@@ -340,27 +864,70 @@ private:
     TUniquePtr<FSRTStreamWorker> StreamWorker;
     FRunnableThread* WorkerThread = nullptr;
     
+    // 공유 캡처/인코딩 (USRTStreamSubsystem) - 서브시스템이 없으면 직접 캡처, 풀이 없으면 워커가 인코딩
+    TWeakObjectPtr<USRTStreamSubsystem> StreamSubsystem;
+    TSharedPtr<FSRTEncodePool> EncodePool;
+    int32 EncodePoolHandle = INDEX_NONE;
+    
+    // 캡처 타이밍 (게임 스레드 전용, 인스턴스마다)
+    double LastCaptureTime = 0.0;
+    float CaptureFPS = 30.0f;              // 과부하 조정 단계의 프레임 속도 (조정이 없으면 StreamFPS)
+    int32 AppliedOverloadLevel = 0;        // 캡처 쪽에 반영한 단계
+    
     // 프레임 버퍼 시스템
     TSharedPtr<FrameBuffer> FrameBuffer;
     TSharedPtr<FGPUReadbackManager> GPUReadbackManager;
+    // 이번 세션의 공급원 - 씬 캡처면 GPUReadbackManager와 같은 객체
+    TSharedPtr<FSRTFrameSource> ActiveFrameSource;
     
     // Phase 3: 새로운 인코더 및 멀티플렉서
     TUniquePtr<FSRTVideoEncoder> VideoEncoder;
     TUniquePtr<FSRTTransportStream> TransportStream;
     
-    // 통계
+    // 공유 MPTS 출력 (bUseSharedConnection일 때만 유효)
+    TSharedPtr<FSRTSharedOutput> SharedOutput;
+    int32 SharedProgramIndex = INDEX_NONE;
+    
+    // 리스너 모드 팬아웃 출력 (워커가 InitializeSRT에서 생성)
+    TUniquePtr<FSRTListenerOutput> ListenerOutput;
+    
+    // StartStreaming에서 검증/변환한 암호화 옵션 (스트리밍 중에는 바뀌지 않음)
+    SRTNetwork::EncryptionOptions Encryption;
+    
+    // 로컬 기록 (공유 출력이면 공유 출력 쪽 탭 사용)
+    TUniquePtr<FSRTRecordingTap> RecordingTap;
+    
+    // 통계 - 워커가 쓰고 게임 스레드가 읽음 (락 없음, 최신 값만 유지)
+    TTripleBuffer<FSRTNetworkStats> StatsBuffer;
     double LastStatsUpdateTime = 0.0;
     const double StatsUpdateInterval = 1.0;
     
+    // 런타임 변경 알림 - 호출마다 로그/화면 메시지를 내지 않고 틱에서 한 번에 (게임 스레드 전용)
+    bool bBitrateChangePending = false;
+    int32 PendingForcedKeyFrames = 0;
+    
     // 내부 메서드
     void GetResolution(int32& OutWidth, int32& OutHeight) const;
     bool SetupSceneCapture();
     void CleanupSceneCapture();
     void CaptureFrame();
+    // bCaptureScene false = 서브시스템이 이미 아틀라스에 렌더함 (리드백 요청만 만듦)
+    bool PrepareCapture(FGPUReadbackManager::FReadbackRequest& OutRequest, bool bCaptureScene = true);
+    bool CreateFrameSource();
+    FSRTYUVColorParams GetYUVColorParams() const;
     void UpdateStats();
+    // 워커가 요청한 과부하 단계를 캡처 쪽(렌더 타깃/공급원 크기, 캡처 간격)에 반영 - 캡처 전에 호출
+    void ApplyOverloadLevel();
+    // 게임 스레드 전용 - 워커는 이벤트 채널로 보내고 ProcessWorkerEvents가 여기로 넘김
     void SetConnectionState(ESRTConnectionState NewState, const FString& Message = TEXT(""));
+    // 워커 이벤트(상태 변경, 로그)와 런타임 변경 알림 처리 - 틱마다 게임 스레드에서
+    void ProcessWorkerEvents();
+    void HandleWorkerEvent(const FSRTWorkerEvent& Event);
+    FSRTTransportStream::EMetadataFormat GetTSMetadataFormat() const;
+    bool ScheduleSplice(const FSRTTransportStream::FSpliceEvent& Event);
     
     friend class FSRTStreamWorker;
+    friend class USRTStreamSubsystem;
 
     // 품질 프리셋 내부 값들
     int32 InternalCRF = 23;
@@ -369,6 +936,53 @@ private:
     FString InternalProfile = TEXT("main");
 };
 
+/**
+ * 워커 → 게임 스레드 이벤트 - 문자열 대신 고정 크기라 보낼 때 할당이 없다
+ * 문장은 게임 스레드가 USRTStreamComponent::HandleWorkerEvent에서 만든다.
+ */
+struct FSRTWorkerEvent
+{
+    enum class EType : uint8
+    {
+        ConnectionState,        // State, Text = 메시지
+        StreamingStatus,        // A = 보낸 프레임, B = 보낸 메시지 (30프레임마다)
+        NoFrame,                // A = 새 프레임이 없던 누적 횟수 (30번마다)
+        EncoderMissing,
+        EncodeFailed,           // A = 프레임 번호
+        MuxFailed,              // A = 프레임 번호
+        EncoderLevelApplied,    // A = 인코더에 반영한 과부하 단계
+        OverloadDecision        // A = 이전 단계, B = 새 단계, Text = 사유
+    };
+
+    EType Type = EType::ConnectionState;
+    ESRTConnectionState State = ESRTConnectionState::Disconnected;
+    int32 A = 0;
+    int32 B = 0;
+    TCHAR Text[160];            // 넘치면 잘림
+
+    void SetText(const TCHAR* InText)
+    {
+        FCString::Strncpy(Text, InText ? InText : TEXT(""), UE_ARRAY_COUNT(Text));
+    }
+};
+
+using FSRTWorkerEventChannel = TSRTEventChannel<FSRTWorkerEvent, 64>;
+
+/** 생산자 쪽 - 슬롯을 제자리에서 채워 보냄 (가득 차면 버림). 할당 없음 */
+inline void PostWorkerEvent(FSRTWorkerEventChannel& Channel, FSRTWorkerEvent::EType Type,
+                            int32 A = 0, int32 B = 0, const TCHAR* Text = nullptr,
+                            ESRTConnectionState State = ESRTConnectionState::Disconnected)
+{
+    Channel.Push([&](FSRTWorkerEvent& Event)
+    {
+        Event.Type = Type;
+        Event.State = State;
+        Event.A = A;
+        Event.B = B;
+        Event.SetText(Text);
+    });
+}
+
 /**
  * SRT 스트리밍 워커 스레드
  */
@@ -386,18 +1000,146 @@ public:
     
     void ForceCloseSocket();
     
+    /** 인코딩 풀 작업 - FrameBuffer의 최신 프레임을 인코딩해서 송신 대기열에 넣음 (풀 워커에서 호출) */
+    void EncodeFromPool();
+    
+    /** 본딩 멤버별 상태 (게임 스레드에서 호출) */
+    void GetBondingMembers(TArray<FSRTBondingMemberInfo>& OutMembers) const;
+    
+    /** 과부하 조정 - 인코딩 쪽이 원하는 단계. 게임 스레드가 캡처를 바꾼 뒤 SetCaptureOverloadLevel로 알림 */
+    int32 GetRequestedOverloadLevel() const { return RequestedLevel.Load(); }
+    void SetCaptureOverloadLevel(int32 Level) { CaptureLevel = Level; }
+    /** 단계 목록은 생성 뒤 바뀌지 않으므로 어느 스레드에서든 */
+    const FSRTOverloadGovernor::FLevel& GetOverloadLevel(int32 Index) const { return Governor.GetLevel(Index); }
+    int32 GetOverloadLevelCount() const { return Governor.GetLevelCount(); }
+    
+    /** 게임 스레드 - 쌓인 이벤트를 Handler로 넘기고 비움 (두 채널, 채널 안에서는 순서대로). 가득 차서 버린 수 */
+    int32 DrainEvents(TFunctionRef<void(const FSRTWorkerEvent&)> Handler);
+    
 private:
     USRTStreamComponent* Owner;
-    void* SRTSocket = nullptr;
+    FSRTSocket SRTSocket;
+    
+    enum class ESendResult : uint8
+    {
+        Sent,
+        Dropped,    // 혼잡으로 버림 (연결은 정상)
+        Failed      // 소켓 에러
+    };
+    
+    enum class EEncodeResult : uint8
+    {
+        Encoded,
+        Skipped,    // 혼잡/키프레임 대기/출력 없음으로 인코딩 결과를 버림 (드롭은 이미 셈)
+        Failed
+    };
+    
+    // 인코딩 단계가 볼 출력 상태 - 워커 스레드가 갱신하고 풀 워커가 읽음
+    enum class EEncodeGate : uint8
+    {
+        Starting,       // 첫 연결 전 - 프레임을 꺼내지 않음
+        Open,
+        Idle,           // 리스너 구독자 없음 - 드롭으로 세지 않음
+        Disconnected    // ReconnectPolicy에 따라 버림
+    };
     
     // 추가된 멤버들
     TAtomic<bool> bShouldExit{false};      // 종료 플래그
     FCriticalSection SocketLock;           // 소켓 보호용
+    SRTNetwork::SourceClock SourceClock;   // 캡처 시각 → srctime
+    
+    // 논블로킹 송신 (Stop은 소켓을 닫지 않고 epoll 대기만 깨움)
+    TAtomic<int32> EpollID{-1};
+    TAtomic<bool> bWaitForKeyFrame{false}; // 드롭 이후 IDR까지 인코딩 결과를 보내지 않음 (송신/인코딩 양쪽에서 설정)
+    int64 SendBufferBudgetBytes = 0;       // 송신 버퍼가 이 이상이면 혼잡
+    SRTNetwork::TokenBucketPacer Pacer;    // bEnablePacing일 때만 사용
+    
+    // 인코딩 풀 (Owner->EncodePool이 있을 때) - 풀 워커가 인코딩, 이 스레드는 이벤트를 기다렸다가 송신
+    FEvent* WorkEvent = nullptr;
+    TQueue<FEncodedFrame, EQueueMode::Spsc> EncodedFrames;
+    TAtomic<EEncodeGate> EncodeGate{EEncodeGate::Starting};
+    TAtomic<bool> bSendCongested{false};
+    
+    // 인코딩 단계 카운터 (풀 워커도 씀 - 발행할 때 Counters에 더함)
+    TAtomic<int32> EncodeDroppedFrames{0};
+    TAtomic<int32> EncodeBackpressureDrops{0};
+    TAtomic<int64> EncodeCycles{0};        // 직전 발행 이후 인코딩에 쓴 시간
+    TAtomic<int32> EncodedFrameCount{0};   // 직전 발행 이후
+    
+    // 과부하 조정 - 인코딩 쪽이 판단해 RequestedLevel을 바꾸면 게임 스레드가 캡처를 바꾸고 CaptureLevel로 알림
+    // 그 단계 크기의 첫 프레임에서 인코더를 다시 엶 (EncoderLevel). 바꾸기 전 크기로 캡처된 프레임은 건너뜀
+    FSRTOverloadGovernor Governor;         // 판단은 인코딩 쪽 전용
+    TAtomic<int32> RequestedLevel{0};
+    TAtomic<int32> CaptureLevel{0};
+    TAtomic<int32> EncoderLevel{0};
+    TAtomic<int32> OverloadTransitions{0};
+    
+    // 재연결 상태 (워커 스레드 전용)
+    SRTNetwork::ReconnectBackoff Backoff;
+    bool bReconnecting = false;
+    int32 ReconnectAttempt = 0;
+    double DisconnectTime = 0.0;
+    double NextReconnectTime = 0.0;
+    bool bMeasuringRecovery = false;       // 재연결 후 첫 IDR 전송까지
+    int32 SharedConnectionEpoch = 0;       // 공유 출력이 재연결하면 증가
+    
+    // 통계 (워커 스레드 전용 - 1초마다 스냅샷으로 발행)
+    FSRTNetworkStats Counters;             // 파이프라인 카운터
+    SRTNetwork::StatsTracker StatsTracker; // 연결마다 Reset
+    FSRTStatsExporter StatsExporter;
+    double StreamStartTime = 0.0;
+    double LastPublishTime = 0.0;
+    int64 IntervalTSBytes = 0;             // 리스너 모드 비트레이트 계산용
+    
+    // 본딩 (워커 스레드 전용, 스냅샷만 락으로 공유)
+    struct FGroupLinkState
+    {
+        SRTNetwork::StatsTracker StatsTracker;
+        SRTSOCKET MemberSocket = SRT_INVALID_SOCK;  // 바뀌면 새 멤버 - 통계 기준점 리셋
+        bool bUp = false;
+        double RetryTime = 0.0;            // 빠진 링크를 다시 추가할 시각
+    };
+    TArray<SRTNetwork::GroupLink> GroupLinks;   // 비어 있으면 단일 소켓
+    TArray<FGroupLinkState> LinkStates;         // GroupLinks 인덱스별
+    TArray<FSRTBondingMemberInfo> BondingSnapshot;
+    mutable FCriticalSection BondingLock;
+    
+    // 게임 스레드로 보내는 이벤트 - 생산자마다 채널 하나 (워커 스레드 / 인코딩 쪽: 워커 스레드 또는 풀 워커)
+    FSRTWorkerEventChannel WorkerEvents;
+    FSRTWorkerEventChannel EncodeEvents;
+    
+    FString LastConnectError;              // ConnectSocket 실패 사유 (해석 실패, 거부 사유 등)
+    int32 NoFrameCount = 0;
+    double LastHealthCheck = 0.0;
     
+    void PostConnectionState(ESRTConnectionState NewState, const FString& Message);
     bool InitializeSRT();
+    bool ConnectInitial();
     void CleanupSRT();
+    bool HasOutput() const;
+    bool ConnectSocket(int32 ConnectTimeoutMs);
+    FSRTSocket CreateConfiguredSocket(bool bGroup, int32 ConnectTimeoutMs);
+    bool ConnectGroup(FSRTSocket& Group, int32 TimeoutMs);
+    void MaintainGroupLinks(const TArray<SRTNetwork::GroupMember>& Members, double Now);
+    void UpdateBondingStats(const TArray<SRTNetwork::GroupMember>& Members, FSRTNetworkStats& Snapshot);
+    void CloseConnection();
+    void BeginReconnect(const FString& Reason);
+    bool TryReconnect();
+    void OnReconnected();
+    void SyncSharedConnection();
+    void DiscardFrameWhileDisconnected(const FrameBuffer::Frame& Frame);
+    void OnKeyFrameSent();
     bool SendFrameData();
+    void UpdateEncodeGate();
+    EEncodeResult EncodeFrame(FrameBuffer::Frame& Frame, FEncodedFrame& OutFrame);
+    bool ApplyOverloadLevel(const FrameBuffer::Frame& Frame);   // false = 지금 인코더로 못 넣는 크기
+    void SampleOverload(double EncodeMs);
+    bool DeliverEncodedFrame(FEncodedFrame& EncodedFrame);
+    bool IsSendCongested() const;
+    int64 GetPacingMaxRate() const;
+    ESendResult SendWithBackpressure(const TArray<uint8>& TSPackets, int64 SourceTime);
     void UpdateSRTStats();
+    void PublishStats(FSRTNetworkStats& Snapshot);
     void HandleDisconnection();
     void CheckHealth();
     void CleanupConnection();
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SRTNetworkWorker.h"
+
+#include "SRTStreamStats.generated.h"
+
+class IFileHandle;
+
+/**
+ * 스트림 통계 스냅샷 - 워커가 1초마다 채워서 트리플 버퍼로 게임 스레드에 넘긴다
+ *
+ * 누적(연결 시작부터), 구간(직전 스냅샷 이후), 순간값을 구분한다.
+ * PacketsLost/PacketsDropped는 SRT 패킷 단위, DroppedFrames는 인코딩 파이프라인의 비디오 프레임 단위.
+ */
+USTRUCT(BlueprintType)
+struct CINESRTSTREAM_API FSRTNetworkStats
+{
+    GENERATED_BODY()
+
+    /** 스트리밍 시작부터 경과 (초) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats")
+    double StreamSeconds = 0.0;
+
+    // ===== 파이프라인 (비디오 프레임) =====
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 FramesSent = 0;
+
+    /** 인코딩/전송하지 못한 비디오 프레임 (연결 끊김, 인코딩 실패 등) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 DroppedFrames = 0;
+
+    /** 송신 혼잡으로 인코딩 전에 버린 프레임 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 BackpressureDrops = 0;
+
+    /** 프레임 하나 인코딩 평균 시간 (BGRA 복사 포함, 직전 스냅샷 이후) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    float EncodeMs = 0.0f;
+
+    /** 인코딩에 쓴 시간 비율 (1.0 = 인코딩 워커 하나를 내내 점유) - 풀 전체는 USRTStreamSubsystem::GetEncodePoolStats */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    float EncodeUtilization = 0.0f;
+
+    /** 과부하 조정 단계 (0 = 스트림 설정 그대로) - USRTStreamComponent::bEnableOverloadGovernor */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 OverloadLevel = 0;
+
+    /** 지금 인코더가 쓰는 해상도/프레임 속도 (과부하 조정으로 스트림 설정보다 낮을 수 있음) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 EncodeWidth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 EncodeHeight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    float EncodeFPS = 0.0f;
+
+    /** 과부하 조정으로 인코더를 다시 연 누적 횟수 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 OverloadTransitions = 0;
+
+    /** 프레임당 캡처 타임스탬프 SEI 삽입 비용 (마이크로초, 스트리밍 시작부터 평균, bEmbedCaptureTimestamp가 꺼져 있으면 0) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    float CaptureSEIMicroseconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 MessagesSent = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 LastMessageNumber = -1;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 ReconnectCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    float LastRecoveryTimeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 RecordingDroppedChunks = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Pipeline")
+    int32 RecordingSegmentsWritten = 0;
+
+    // ===== SRT 누적 (연결 시작부터) =====
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 PacketsSent = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 PacketsRetransmitted = 0;
+
+    /** 수신 측이 NAK로 보고한 손실 (재전송으로 복구됐을 수 있음) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 PacketsLost = 0;
+
+    /** 레이턴시 안에 못 보내서 송신 측이 버린 패킷 - 수신 측에서 실제로 빠진 데이터 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 PacketsDropped = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 BytesSent = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 BytesRetransmitted = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Total")
+    int64 BytesDropped = 0;
+
+    // ===== SRT 구간 (직전 스냅샷 이후) =====
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float IntervalSeconds = 0.0f;
+
+    /** 재전송 포함 선로 속도 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float SendRateMbps = 0.0f;
+
+    /** 고유 데이터 속도 (인코더 출력 + TS 오버헤드) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float PayloadRateMbps = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float RetransmitRateMbps = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float LossPercent = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    float RetransmitPercent = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    int32 IntervalPacketsLost = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    int32 IntervalPacketsDropped = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Interval")
+    int32 IntervalPacketsRetransmitted = 0;
+
+    // ===== SRT 순간값 =====
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    float RTTMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    float EstimatedBandwidthMbps = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    float MaxBandwidthMbps = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    float PacketSendPeriodUs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 FlowWindowPackets = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 CongestionWindowPackets = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 FlightSizePackets = 0;
+
+    /** ACK 안 된 송신 버퍼 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 SendBufferPackets = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 SendBufferBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 SendBufferMs = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 AvailableSendBufferBytes = 0;
+
+    /** 협상된 레이턴시 (수신 측 TSBPD 지연) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 PeerLatencyMs = 0;
+
+    /** 키 교환 상태 (SRT_KM_STATE: 0 암호화 안 함, 2 정상, 4 비밀번호 불일치) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    int32 KeyMaterialState = 0;
+    
+    /** 비디오 비트레이트 표시용 (공유 출력이면 자기 프로그램 몫) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Stats|Instant")
+    float BitrateKbps = 0.0f;
+
+    /** SRT 통계 블록을 SRT/구간 필드에 복사 */
+    void SetFromSRT(const SRTNetwork::Stats& Totals, const SRTNetwork::StatsInterval& Interval);
+};
+
+UENUM(BlueprintType)
+enum class ESRTStatsExportFormat : uint8
+{
+    CSV UMETA(DisplayName = "CSV"),
+    JSONLines UMETA(DisplayName = "JSON Lines")
+};
+
+/**
+ * 통계 스냅샷을 시계열 파일로 기록 (사후 분석용)
+ * 한 줄 = 스냅샷 하나. JSON Lines는 한 줄에 객체 하나라 기록 도중에 끊겨도 앞부분은 유효하다.
+ */
+class CINESRTSTREAM_API FSRTStatsExporter
+{
+public:
+    FSRTStatsExporter() = default;
+    ~FSRTStatsExporter();
+
+    /** Directory가 비어 있으면 Saved/SRTStats */
+    bool Open(const FString& Directory, const FString& FilePrefix, ESRTStatsExportFormat InFormat);
+    void Append(const FSRTNetworkStats& Stats);
+    void Close();
+    bool IsOpen() const { return File != nullptr; }
+    const FString& GetPath() const { return Path; }
+
+private:
+    IFileHandle* File = nullptr;
+    FString Path;
+    ESRTStatsExportFormat Format = ESRTStatsExportFormat::CSV;
+
+    void WriteLine(const FString& Line);
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SRTEncodePool.h"
+#include "SRTMultiViewCapture.h"
+#include "SRTStreamComponent.h"
+
+#include "SRTStreamSubsystem.generated.h"
+
+/** 월드 전체 인코딩 풀 상태 - 1초마다 갱신 */
+USTRUCT(BlueprintType)
+struct CINESRTSTREAM_API FSRTEncodePoolStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    int32 WorkerCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    int32 StreamCount = 0;
+
+    /** 스트림 인코더 하나의 FFmpeg 스레드 수 (코어 수 / 워커 수) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    int32 EncoderThreadsPerStream = 0;
+
+    /** 워커가 인코딩에 쓴 시간 비율 (0~1, 워커 전체 평균) - 1에 가까우면 워커를 늘리거나 스트림을 줄여야 함 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    float Utilization = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    float JobsPerSecond = 0.0f;
+
+    /** 새 프레임이 준비된 뒤 워커가 잡을 때까지 평균 대기 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    float AverageQueueWaitMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    int32 QueuedStreams = 0;
+
+    /** 직전 틱에서 렌더 명령 하나로 리드백한 캡처 수 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Encode Pool")
+    int32 LastReadbackBatchSize = 0;
+};
+
+/** 캡처 GPU 시간 - 1초마다 갱신, 그 모드로 캡처한 카메라가 없던 구간은 마지막 측정값 유지 */
+USTRUCT(BlueprintType)
+struct CINESRTSTREAM_API FSRTCaptureStats
+{
+    GENERATED_BODY()
+
+    /** 직전 틱에서 뷰 패밀리 하나로 함께 렌더한 카메라 수 (bBatchedCapture) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Capture")
+    int32 BatchedCameras = 0;
+
+    /** 직전 틱에서 렌더한 아틀라스 수 (해상도별 하나) */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Capture")
+    int32 Atlases = 0;
+
+    /** 배치 렌더 GPU 시간 / 카메라 수 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Capture")
+    float BatchedGPUMsPerCamera = 0.0f;
+
+    /** 카메라마다 CaptureScene한 경우의 GPU 시간 - 같은 장면에서 bBatchedCapture를 바꿔 가며 비교 */
+    UPROPERTY(BlueprintReadOnly, Category = "SRT Capture")
+    float IndividualGPUMsPerCamera = 0.0f;
+};
+
+/**
+ * 월드 안의 SRT 스트림 컴포넌트를 묶어서 처리하는 서브시스템
+ *
+ * 캡처: 게임 스레드 틱 한 번에 캡처 시점이 된 스트림을 모두 CaptureScene하고 리드백은 렌더 명령 하나로 요청.
+ * bBatchedCapture 스트림은 해상도별로 묶어 뷰 패밀리 하나로 아틀라스에 렌더한 뒤 타일별로 나눠 읽는다.
+ * 인코딩: 고정 크기 워커 풀(CineSRT.EncodeWorkers)이 스트림들을 돌아가며 인코딩하고,
+ * 스트림 워커 스레드는 연결/재연결, 다중화, 송신만 맡는다 (CineSRT.EncodePool 0이면 스트림별 인코딩).
+ */
+UCLASS()
+class CINESRTSTREAM_API USRTStreamSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** StartStreaming에서 호출 - 이후 캡처는 서브시스템이 수행 */
+    void RegisterStream(USRTStreamComponent* Stream);
+    void UnregisterStream(USRTStreamComponent* Stream);
+
+    /** 공유 인코딩 풀 (처음 요청할 때 생성) - CineSRT.EncodePool 0이면 nullptr */
+    TSharedPtr<FSRTEncodePool> AcquireEncodePool();
+
+    /** 풀을 쓰는 스트림의 인코더 스레드 수 - 동시에 도는 인코더 수 x 이 값 ≈ 코어 수 */
+    int32 GetEncoderThreadsPerStream() const;
+
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Encode Pool")
+    FSRTEncodePoolStats GetEncodePoolStats() const { return PoolStats; }
+
+    UFUNCTION(BlueprintCallable, Category = "SRT Stream|Capture")
+    FSRTCaptureStats GetCaptureStats() const { return CaptureStats; }
+
+private:
+    TArray<TWeakObjectPtr<USRTStreamComponent>> Streams;
+    TSharedPtr<FSRTEncodePool> EncodePool;
+
+    FSRTEncodePoolStats PoolStats;
+    FSRTEncodePool::FStats LastPoolSample;
+    double LastSampleTime = 0.0;
+
+    // 배치 캡처 아틀라스 - 타일 크기별 하나, 스트림이 늘면 다시 만듦 (줄이지는 않음)
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UTextureRenderTarget2D>> CaptureAtlases;
+    TArray<FIntPoint> CaptureAtlasTileSizes;
+
+    TSharedPtr<FSRTGPUTimer, ESPMode::ThreadSafe> BatchedCaptureTimer;
+    TSharedPtr<FSRTGPUTimer, ESPMode::ThreadSafe> IndividualCaptureTimer;
+    FSRTCaptureStats CaptureStats;
+
+    void CaptureDueStreams(double Now);
+    void CaptureIndividually(USRTStreamComponent* Stream, TArray<FGPUReadbackManager::FReadbackRequest>& OutBatch);
+    /** 같은 타일 크기 스트림들을 아틀라스 하나에 렌더 - 실패하면 false (호출하는 쪽이 개별 캡처) */
+    bool CaptureBatched(const TArray<USRTStreamComponent*>& Group, TArray<FGPUReadbackManager::FReadbackRequest>& OutBatch);
+    UTextureRenderTarget2D* GetCaptureAtlas(FIntPoint TileSize, int32 TileCount, int32& OutColumns);
+    void SampleStats(double Now);
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "HAL/PlatformTime.h"
+#include "HAL/CriticalSection.h"
 
 // MPEG-TS 상수
 #define TS_PACKET_SIZE 188
@@ -9,9 +10,28 @@
 #define TS_PAT_PID 0x0000
 #define TS_NULL_PID 0x1FFF
 
+// MPTS 최대 프로그램 수 (PAT 한 섹션이 한 TS 패킷에 들어가는 범위)
+#define TS_MAX_PROGRAMS 32
+
+// 비디오 스트림 타입 (PMT stream_type)
+#define TS_STREAM_TYPE_H264 0x1B
+#define TS_STREAM_TYPE_HEVC 0x24
+
+// 데이터 스트림 타입 (PMT stream_type)
+#define TS_STREAM_TYPE_SCTE35 0x86
+#define TS_STREAM_TYPE_METADATA 0x15  // Metadata in PES (ID3 / KLV)
+
 class CINESRTSTREAM_API FSRTTransportStream
 {
 public:
+    // 타임드 메타데이터 PID의 포맷 (PMT metadata_descriptor에 기록)
+    enum class EMetadataFormat : uint8
+    {
+        None,
+        ID3,    // ID3v2 태그 (HLS/플레이아웃 장비 호환)
+        KLV     // SMPTE 336 KLV (MISB 카메라/트래킹 데이터)
+    };
+
     struct FConfig
     {
         // PID 설정
@@ -20,6 +40,7 @@ public:
         int32 VideoPID = 0x0100; // 256
         int32 AudioPID = 0x0101; // 257 (향후)
         int32 PCRPID = 0x0100;  // 보통 비디오 PID와 동일
+        uint8 VideoStreamType = TS_STREAM_TYPE_H264;  // 인코더가 실제로 연 코덱과 일치해야 함
         
         // 서비스 정보
         FString ServiceName = TEXT("UnrealStream");
@@ -28,7 +49,64 @@ public:
         // 타이밍
         int32 PCRIntervalMs = 40;  // PCR 간격 (권장: 40ms)
         int32 PATIntervalMs = 100; // PAT/PMT 간격
+        
+        // MPTS 모드: Initialize 시 프로그램을 만들지 않고 AddProgram으로 등록
+        bool bMultiProgram = false;
+        
+        // 데이터 PID (단일 프로그램 모드). PID는 비디오 PID + 2/+3
+        bool bEnableSCTE35 = false;
+        EMetadataFormat MetadataFormat = EMetadataFormat::None;
+        int32 SCTE35PrerollMs = 4000;  // 스플라이스 지점보다 이만큼 앞서 섹션 전송
+    };
+
+    // MPTS 프로그램 하나의 PID 구성
+    struct FProgramConfig
+    {
+        int32 ServiceID = 1;
+        int32 PMTPID = 0x1000;
+        int32 VideoPID = 0x0100;
+        int32 PCRPID = 0x0100;
+        uint8 VideoStreamType = TS_STREAM_TYPE_H264;
+        int32 SCTE35PID = 0;    // 0 = 없음
+        int32 MetadataPID = 0;  // 0 = 없음
+        EMetadataFormat MetadataFormat = EMetadataFormat::None;
+        FString ServiceName;
+    };
+
+    // SCTE-35 splice_insert / time_signal 이벤트
+    struct FSpliceEvent
+    {
+        int64 PTS = 0;                // 스플라이스 지점 (90kHz, 해당 프레임의 PTS)
+        uint32 EventID = 0;
+        bool bTimeSignal = false;     // true면 time_signal(), false면 splice_insert()
+        bool bOutOfNetwork = true;    // true = 광고 진입 (cue-out), false = 복귀 (cue-in)
+        int64 BreakDuration = 0;      // 90kHz, 0이면 duration 없음
+        bool bAutoReturn = true;
+        uint16 UniqueProgramID = 0;
+        bool bCancel = false;
+    };
+
+    // 프로그램별 통계
+    struct FProgramStats
+    {
+        int64 PacketCount = 0;
+        int64 ByteCount = 0;
+        int64 FrameCount = 0;
+        int64 SCTE35Count = 0;
+        int64 MetadataCount = 0;
+        int64 LateEvents = 0;   // 대상 PTS가 이미 지난 뒤에 전송된 이벤트
+        int64 CaptureSEICount = 0;
+        int64 CaptureSEICycles = 0;  // SEI를 넣은 프레임의 접근 단위 재구성 시간 (복사 포함)
+    };
+    
+    // 캡처 타임스탬프 SEI (user_data_unregistered) - 수신 측 glass-to-glass 지연 측정용
+    // 형식은 TestPrograms/srt_monitor/capture_sei.h 참고 (UUID "CineSRT-Capture" + 0x01)
+    struct FCaptureStamp
+    {
+        int64 CaptureUtcUs = 0;   // 캡처 시각, 1970-01-01 UTC 기준 마이크로초
+        uint32 FrameNumber = 0;
     };
+    static const uint8 CaptureSEIUuid[16];
 
     FSRTTransportStream();
     ~FSRTTransportStream();
@@ -36,16 +114,49 @@ public:
     bool Initialize(const FConfig& InConfig);
     void Shutdown();
     
-    // 주요 기능
-    bool MuxH264Frame(const TArray<uint8>& H264Data, 
-                      int64 PTS,
-                      int64 DTS,
-                      bool bKeyFrame,
-                      TArray<uint8>& OutTSPackets);
+    // 주요 기능 (단일 프로그램 = 프로그램 0)
+    // VideoData: Annex B 접근 단위 (H.264 또는 HEVC, 프로그램의 VideoStreamType 기준)
+    // AUD가 없으면 붙이고, 키프레임에 파라미터 셋(VPS/SPS/PPS)이 없으면 마지막으로 본 것을 넣는다
+    // CaptureStamp가 있으면 첫 슬라이스 앞에 캡처 타임스탬프 SEI를 넣는다
+    bool MuxVideoFrame(const TArray<uint8>& VideoData, 
+                       int64 PTS,
+                       int64 DTS,
+                       bool bKeyFrame,
+                       TArray<uint8>& OutTSPackets,
+                       const FCaptureStamp* CaptureStamp = nullptr);
+    
+    // MPTS: 지정한 프로그램의 비디오 PID로 다중화
+    bool MuxVideoFrame(int32 ProgramIndex,
+                       const TArray<uint8>& VideoData,
+                       int64 PTS,
+                       int64 DTS,
+                       bool bKeyFrame,
+                       TArray<uint8>& OutTSPackets,
+                       const FCaptureStamp* CaptureStamp = nullptr);
+    
+    // MPTS 프로그램 관리 - PID는 Config 기준으로 자동 할당
+    // 반환값: 프로그램 인덱스 (실패 시 INDEX_NONE)
+    int32 AddProgram(const FString& ServiceName = FString(),
+                     bool bEnableSCTE35 = false,
+                     EMetadataFormat MetadataFormat = EMetadataFormat::None,
+                     uint8 VideoStreamType = TS_STREAM_TYPE_H264);
+    void RemoveProgram(int32 ProgramIndex);
+    int32 GetProgramCount() const { return Programs.Num(); }
+    bool GetProgramConfig(int32 ProgramIndex, FProgramConfig& OutConfig) const;
+    bool GetProgramStats(int32 ProgramIndex, FProgramStats& OutStats) const;
+    
+    // 데이터 이벤트 예약 - 어느 스레드에서든 호출 가능
+    // 해당 PTS의 비디오 프레임을 다중화할 때 비디오 패킷 뒤에 실린다 (비디오는 지연되지 않음)
+    bool ScheduleSpliceEvent(int32 ProgramIndex, const FSpliceEvent& Event);
+    bool ScheduleMetadata(int32 ProgramIndex, int64 PTS, const TArray<uint8>& Payload);
+    
+    // ID3v2.4 TXXX 프레임 하나로 된 태그 생성 (UTF-8)
+    static void BuildID3TextTag(const FString& Description, const FString& Value, TArray<uint8>& OutTag);
     
     // 시스템 정보 패킷
     void GeneratePAT(TArray<uint8>& OutPacket);
     void GeneratePMT(TArray<uint8>& OutPacket);
+    void GeneratePMT(int32 ProgramIndex, TArray<uint8>& OutPacket);
     void GenerateNullPacket(TArray<uint8>& OutPacket);
     
     // 통계
@@ -53,14 +164,45 @@ public:
     int64 GetByteCount() const { return TotalBytes; }
 
 private:
+    struct FPendingMetadata
+    {
+        int64 PTS = 0;
+        TArray<uint8> Payload;
+    };
+    
+    struct FProgram
+    {
+        FProgramConfig Config;
+        FProgramStats Stats;
+        int64 LastPCR = 0;  // 90kHz 단위
+        bool bActive = false;
+        
+        // PTS 순으로 정렬된 예약 이벤트 (EventLock 보호)
+        TArray<FSpliceEvent> PendingSplices;
+        TArray<FPendingMetadata> PendingMetadata;
+        
+        // 마지막 키프레임의 파라미터 셋 (시작 코드 포함, 다중화 스레드 전용)
+        TArray<uint8> ParameterSets;
+        TArray<uint8> AccessUnit;  // AUD/파라미터 셋/SEI 삽입용 재사용 버퍼
+    };
+    
     FConfig Config;
     bool bIsInitialized = false;
     
+    // 프로그램 목록 (인덱스 = 프로그램 핸들, 제거된 슬롯은 bActive = false)
+    TArray<FProgram> Programs;
+    
+    // PAT/PMT version_number (프로그램 구성이 바뀔 때마다 증가)
+    uint8 TableVersion = 0;
+    
+    // 예약 이벤트 보호 (게임 스레드에서 예약, 다중화 스레드에서 소비)
+    FCriticalSection EventLock;
+    static constexpr int32 MaxPendingEvents = 256;
+    
     // 패킷 카운터 (0-15 순환)
     uint8 ContinuityCounter[8192] = {0};
     
     // 타이밍
-    int64 LastPCR = 0;
     int64 LastPAT = 0;
     int64 LastPMT = 0;
     double StartTime = 0.0;
@@ -73,10 +215,21 @@ private:
     void WritePacketHeader(uint8* packet, int pid, bool payload_start, 
                           bool has_adaptation, bool has_payload);
     void WriteAdaptationField(uint8* packet, int size, bool pcr_flag, int64 pcr);
-    void WritePES(const uint8* data, int size, int64 pts, int64 dts, 
+    void WritePES(FProgram& program, const uint8* data, int size, int64 pts, int64 dts, 
                   bool key_frame, TArray<uint8>& out_packets);
     int64 GetCurrentPCR();
     
+    // 접근 단위 정리 (AUD, 키프레임 파라미터 셋, 캡처 SEI). 수정이 필요 없으면 입력을 그대로 반환
+    const TArray<uint8>& PrepareAccessUnit(FProgram& program, const TArray<uint8>& data, bool key_frame,
+                                           const FCaptureStamp* capture_stamp);
+    
+    // 데이터 PID
+    void AssignDataPIDs(FProgramConfig& ProgramConfig, bool bEnableSCTE35, EMetadataFormat MetadataFormat) const;
+    void EmitScheduledData(FProgram& program, int64 frame_pts, TArray<uint8>& out_packets);
+    void WriteSection(FProgram& program, int pid, const uint8* section, int size, TArray<uint8>& out_packets);
+    void WriteDataPES(FProgram& program, int pid, int64 pts, const uint8* data, int size, TArray<uint8>& out_packets);
+    void BuildSpliceInfoSection(const FSpliceEvent& Event, TArray<uint8>& OutSection);
+    
     // CRC32 계산 (PAT/PMT용)
     uint32 CalculateCRC32(const uint8* data, int length);
 }; 
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "HAL/ThreadSafeBool.h"
 #include "Containers/CircularQueue.h"
 #include "HAL/CriticalSection.h"
+#include "SRTFrameTrace.h"
+#include "SRTYUVConversion.h"
 
 // FFmpeg 전방 선언
 extern "C" {
@@ -15,6 +17,13 @@ extern "C" {
     struct AVBufferRef;
 }
 
+// 비디오 코덱 (TS stream_type: H.264 0x1B, HEVC 0x24)
+enum class EVideoCodec : uint8
+{
+    H264,
+    HEVC
+};
+
 // 인코딩된 프레임 데이터
 struct FEncodedFrame
 {
@@ -23,6 +32,10 @@ struct FEncodedFrame
     int64 DTS;
     bool bKeyFrame;
     uint32 FrameNumber;
+    double CaptureTime = 0.0;  // FPlatformTime::Seconds() 기준 캡처 시각 (SRT srctime 계산용)
+    int64 CaptureUtcUs = 0;    // 캡처 시각 UTC 마이크로초 - 0이 아니면 다중화 시 캡처 타임스탬프 SEI로 삽입
+    uint32 CaptureFrameNumber = 0;  // 캡처 순번 (SEI용, 인코더 FrameNumber와 달리 건너뛴 프레임도 셈)
+    FSRTFrameTrace Trace;      // 캡처부터 이어지는 단계별 타임스탬프 (EncodeFrame 전에 호출자가 채움)
 };
 
 class CINESRTSTREAM_API FSRTVideoEncoder
@@ -31,6 +44,7 @@ public:
     struct FConfig
     {
         // 비디오 설정
+        EVideoCodec VideoCodec = EVideoCodec::H264;  // HEVC는 4K에서 같은 화질을 약 절반 비트레이트로
         int32 Width = 1920;
         int32 Height = 1080;
         int32 FrameRate = 30;
@@ -44,7 +58,7 @@ public:
         // 인코더 설정
         FString Preset = TEXT("ultrafast");  // ultrafast, superfast, veryfast, faster, fast
         FString Tune = TEXT("zerolatency");  // zerolatency, film, animation
-        FString Profile = TEXT("baseline");  // baseline, main, high
+        FString Profile = TEXT("baseline");  // baseline, main, high (HEVC는 항상 main)
         int32 Level = 41;  // 4.1 = 1080p30
         
         // 하드웨어 가속
@@ -55,6 +69,9 @@ public:
         int32 ThreadCount = 4;
         bool bUseCBR = false;  // CBR vs VBR
         float CRF = 23.0f;  // Constant Rate Factor (VBR용)
+        
+        // BGRA 입력 변환 행렬/범위 - 비트스트림 VUI에도 표기 (YUV 입력은 이 값으로 변환된 것이어야 함)
+        FSRTYUVColorParams Color;
     };
 
     FSRTVideoEncoder();
@@ -64,8 +81,15 @@ public:
     bool Initialize(const FConfig& InConfig);
     void Shutdown();
     
+    // 해상도/프레임 속도/프리셋 변경 - 코덱을 새로 열고 다음 프레임은 IDR. 통계와 PTS 타임라인은 이어짐
+    // 실패하면 이전 설정으로 다시 열고 false
+    bool Reconfigure(const FConfig& InConfig);
+    const FConfig& GetConfig() const { return Config; }
+    
     // 인코딩
     bool EncodeFrame(const TArray<FColor>& BGRAData, FEncodedFrame& OutFrame);
+    // FrameBuffer 프레임 그대로 - BGRA는 변환, NV12/I420은 평면 복사만 (NumBytes = SRTYUV::GetFrameBytes)
+    bool EncodeFrame(const uint8* Data, int32 NumBytes, EVideoPixelFormat Format, FEncodedFrame& OutFrame);
     bool EncodeFrameAsync(const TArray<FColor>& BGRAData);
     bool GetEncodedFrame(FEncodedFrame& OutFrame);
     
@@ -73,15 +97,25 @@ public:
     bool IsInitialized() const { return bIsInitialized; }
     bool HasEncodedFrames() const { return !EncodedFrameQueue.IsEmpty(); }
     
+    // 실제로 열린 코덱 (HEVC 인코더가 없으면 H.264로 대체되므로 먹서는 이 값을 따라야 함)
+    EVideoCodec GetVideoCodec() const { return ActiveCodec; }
+    // Config.Preset을 쓰는 인코더인지 (libx264/libx265 - 하드웨어 인코더는 자체 저지연 프리셋 고정)
+    bool UsesPreset() const;
+    
     // 통계
     float GetLastEncodingTimeMs() const { return LastEncodingTimeMs; }
     int32 GetEncodedFrameCount() const { return EncodedFrameCount; }
     int32 GetDroppedFrameCount() const { return DroppedFrameCount; }
+    int64 GetNextFrameIndex() const { return NextFrameIndex.Load(); }  // 다음 프레임이 받을 PTS 인덱스
     float GetAverageBitrateKbps() const;
     
+    // 프레임 번호 → MPEG-TS PTS (90kHz). 메타데이터를 특정 프레임에 맞출 때 사용
+    int64 GetFramePTS(int64 FrameNumber) const;
+    
     // 동적 설정 변경
     bool SetBitrate(int32 NewBitrateKbps);
-    bool ForceKeyFrame();
+    bool ForceKeyFrame();  // 다음 프레임을 IDR로 (어느 스레드에서든 호출 가능)
+    void SkipFrame();      // 혼잡 등으로 인코딩하지 않은 프레임 (타임스탬프만 진행)
 
 private:
     FConfig Config;
@@ -92,6 +126,7 @@ private:
     
     // FFmpeg 객체
     const AVCodec* Codec = nullptr;  // const 추가!
+    EVideoCodec ActiveCodec = EVideoCodec::H264;
     AVCodecContext* CodecContext = nullptr;
     AVFrame* Frame = nullptr;
     AVPacket* Packet = nullptr;
@@ -102,6 +137,21 @@ private:
     TQueue<FEncodedFrame> EncodedFrameQueue;  // TCircularQueue가 아님!
     FCriticalSection QueueLock;
     
+    TAtomic<bool> bForceKeyFrame{false};
+    TAtomic<int64> NextFrameIndex{0};
+    
+    // PTS 타임라인 - 게임 스레드의 GetFramePTS가 인코딩을 기다리지 않도록 세 값을 TimelineLock 아래 한꺼번에 바꿈
+    // 바꾸는 곳은 모두 EncoderLock 안이라 인코딩 스레드는 잠그지 않고 읽음
+    struct FPTSTimeline
+    {
+        int64 IndexBase = 0;    // 마지막 Reconfigure 시점의 프레임 인덱스
+        int64 PTSBase = 0;      // 그 프레임의 PTS (90kHz)
+        int32 FrameRate = 0;    // 그 뒤의 프레임 간격 (Config.FrameRate)
+    };
+    FPTSTimeline Timeline;
+    mutable FCriticalSection TimelineLock;
+    void PublishTimeline(int64 InIndexBase, int64 InPTSBase);  // EncoderLock 안에서, Config를 정한 뒤
+    
     // 통계
     TAtomic<float> LastEncodingTimeMs;
     TAtomic<int32> EncodedFrameCount;
@@ -110,10 +160,14 @@ private:
     
     // 내부 메서드
     bool CheckFFmpegInstallation();
+    bool OpenCodec();
+    void ReleaseCodec();
     bool InitializeSoftwareEncoder();
     bool InitializeHardwareEncoder();
     bool SetupCodecContext();
-    bool ConvertAndEncode(const TArray<FColor>& BGRAData);
+    const AVCodec* FindEncoder(EVideoCodec InCodec) const;
+    bool ConvertAndEncode(const uint8* BGRAData);
+    bool CopyYUVPlanes(const uint8* Data, EVideoPixelFormat Format);
     void LogCodecInfo();
     
     // 하드웨어 가속 헬퍼
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// FrameBuffer 프레임의 픽셀 배열
+enum class EVideoPixelFormat : uint8
+{
+    BGRA,   // 8비트 BGRA - 인코더가 YUV로 변환 (4바이트/픽셀)
+    NV12,   // Y 평면 + UV 교차 평면 (4:2:0, 1.5바이트/픽셀)
+    I420    // Y, U, V 평면 (4:2:0, 1.5바이트/픽셀) - 인코더 입력(YUV420P)과 같아 복사만
+};
+
+// RGB → YUV 행렬
+enum class EVideoColorMatrix : uint8
+{
+    BT601,
+    BT709
+};
+
+/** RGB → YUV 변환 설정 - 인코더(BGRA 입력)와 GPU 변환, CPU 참조 변환이 같은 값을 쓴다 */
+struct CINESRTSTREAM_API FSRTYUVColorParams
+{
+    EVideoColorMatrix Matrix = EVideoColorMatrix::BT709;
+    bool bFullRange = false;    // false = 제한 범위 (Y 16-235, UV 16-240)
+
+    /** RGB(0~1) → 8비트 값: R*X + G*Y + B*Z + W (반올림 전) */
+    void GetCoefficients(FVector4f& OutY, FVector4f& OutU, FVector4f& OutV) const;
+
+    const TCHAR* ToString() const;
+};
+
+/**
+ * BGRA → 4:2:0 YUV CPU 참조 구현
+ *
+ * GPU 변환 셰이더(SRTYUVConvert.usf)와 같은 식: 휘도는 픽셀마다, 색차는 2x2 블록 RGB 평균에서.
+ * 값은 float로 계산해 0.5를 더하고 내림 → GPU 결과와 ±1 안에서 같다 (FMA 순서 차이).
+ * GPU 없는 공급원(테스트 패턴/파일)의 YUV 출력, GPU 변환 검증(CineSRT.VerifyGPUYUV),
+ * 벤치마크 -YUVTest가 이 구현을 쓴다.
+ */
+namespace SRTYUV
+{
+    /** 한 프레임 바이트 수 - 4:2:0은 너비/높이가 짝수여야 함 */
+    CINESRTSTREAM_API int32 GetFrameBytes(EVideoPixelFormat Format, int32 Width, int32 Height);
+
+    /** YUV 평면을 담는 R8 텍스처 크기 (Width x Height*3/2) - I420의 U/V도 이 폭으로 이어 붙임 */
+    CINESRTSTREAM_API FIntPoint GetPlaneTextureSize(int32 Width, int32 Height);
+
+    /**
+     * BGRA(행 간격 SourceStride 픽셀) → Out (GetFrameBytes 크기, 행 간격 없음)
+     * Format이 BGRA면 행 복사. 너비/높이가 홀수면 false
+     */
+    CINESRTSTREAM_API bool ConvertBGRA(const uint8* BGRA, int32 SourceStride, int32 Width, int32 Height,
+                                       EVideoPixelFormat Format, const FSRTYUVColorParams& Color, uint8* Out);
+
+    CINESRTSTREAM_API const TCHAR* GetFormatName(EVideoPixelFormat Format);
+}
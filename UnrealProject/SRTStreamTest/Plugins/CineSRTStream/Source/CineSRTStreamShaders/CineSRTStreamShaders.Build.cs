@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// 셰이더 경로 등록과 전역 셰이더 타입 (YUV 변환) - 셰이더 타입 초기화 전(PostConfigInit)에 로드되어야 해서 본 모듈과 분리
+public class CineSRTStreamShaders : ModuleRules
+{
+    public CineSRTStreamShaders(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "RenderCore",
+                "RHI"
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Projects"
+            }
+        );
+    }
+}
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
+
+/**
+ * /Plugin/CineSRTStream → Plugins/CineSRTStream/Shaders (SRTYUVConvert.usf)
+ * 셰이더 경로와 전역 셰이더 타입(FSRTYUVConvertCS)은 PostConfigInit 로딩 단계에서만 등록 가능
+ * - 본 모듈(CineSRTStream)은 Default 단계에 그대로 두고 이 모듈에 의존
+ */
+class FCineSRTStreamShadersModule : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override
+    {
+        if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("CineSRTStream")))
+        {
+            AddShaderSourceDirectoryMapping(TEXT("/Plugin/CineSRTStream"), FPaths::Combine(Plugin->GetBaseDir(), TEXT("Shaders")));
+        }
+    }
+};
+
+IMPLEMENT_MODULE(FCineSRTStreamShadersModule, CineSRTStreamShaders)
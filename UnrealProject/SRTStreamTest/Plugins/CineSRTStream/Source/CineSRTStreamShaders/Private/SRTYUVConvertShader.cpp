@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SRTYUVConvertShader.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "DataDrivenShaderPlatformInfo.h"
+#include "Misc/App.h"
+
+class FSRTYUVConvertCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSRTYUVConvertCS);
+    SHADER_USE_PARAMETER_STRUCT(FSRTYUVConvertCS, FGlobalShader);
+
+    class FI420 : SHADER_PERMUTATION_BOOL("YUV_I420");
+    using FPermutationDomain = TShaderPermutationDomain<FI420>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, InputTexture)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, OutputTexture)
+        SHADER_PARAMETER(FIntPoint, SourceOffset)
+        SHADER_PARAMETER(FIntPoint, Size)
+        SHADER_PARAMETER(FVector4f, YCoefficients)
+        SHADER_PARAMETER(FVector4f, UCoefficients)
+        SHADER_PARAMETER(FVector4f, VCoefficients)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static constexpr int32 ThreadGroupSize = 8;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    }
+};
+
+// 셰이더 경로는 FCineSRTStreamShadersModule::StartupModule에서 매핑 (Plugins/CineSRTStream/Shaders)
+IMPLEMENT_GLOBAL_SHADER(FSRTYUVConvertCS, "/Plugin/CineSRTStream/Private/SRTYUVConvert.usf", "MainCS", SF_Compute);
+
+namespace SRTYUV
+{
+    FRDGTextureRef AddConvertPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Input, const FIntRect& SourceRect,
+                                  bool bI420, const FVector4f& YCoefficients,
+                                  const FVector4f& UCoefficients, const FVector4f& VCoefficients)
+    {
+        if (!IsFeatureLevelSupported(GMaxRHIShaderPlatform, ERHIFeatureLevel::SM5))
+            return nullptr;
+
+        // 평면 배치는 SRTYUV::GetPlaneTextureSize와 같음 (Y 아래에 색차 절반 높이)
+        const FIntPoint Size = SourceRect.Size();
+        const FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(
+            FIntPoint(Size.X, Size.Y * 3 / 2), PF_R8, FClearValueBinding::None,
+            TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef Output = GraphBuilder.CreateTexture(Desc, TEXT("SRTYUVPlanes"));
+
+        FSRTYUVConvertCS::FParameters* Parameters = GraphBuilder.AllocParameters<FSRTYUVConvertCS::FParameters>();
+        Parameters->InputTexture = Input;
+        Parameters->OutputTexture = GraphBuilder.CreateUAV(Output);
+        Parameters->SourceOffset = SourceRect.Min;
+        Parameters->Size = Size;
+        Parameters->YCoefficients = YCoefficients;
+        Parameters->UCoefficients = UCoefficients;
+        Parameters->VCoefficients = VCoefficients;
+
+        FSRTYUVConvertCS::FPermutationDomain Permutation;
+        Permutation.Set<FSRTYUVConvertCS::FI420>(bI420);
+        TShaderMapRef<FSRTYUVConvertCS> Shader(GetGlobalShaderMap(GMaxRHIFeatureLevel), Permutation);
+
+        // 스레드 하나가 2x2 블록
+        FComputeShaderUtils::AddPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SRTYUVConvert %s %dx%d", bI420 ? TEXT("I420") : TEXT("NV12"), Size.X, Size.Y),
+            Shader,
+            Parameters,
+            FComputeShaderUtils::GetGroupCount(FIntPoint(Size.X / 2, Size.Y / 2), FSRTYUVConvertCS::ThreadGroupSize));
+        return Output;
+    }
+
+    bool IsGPUConversionSupported()
+    {
+        return GDynamicRHI != nullptr
+            && FApp::CanEverRender()
+            && IsFeatureLevelSupported(GMaxRHIShaderPlatform, ERHIFeatureLevel::SM5);
+    }
+}
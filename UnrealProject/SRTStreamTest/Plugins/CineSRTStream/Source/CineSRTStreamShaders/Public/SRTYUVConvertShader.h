@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphFwd.h"
+
+/**
+ * GPU BGRA → 4:2:0 YUV 변환 (SRTYUVConvert.usf)
+ *
+ * 전역 셰이더 타입은 셰이더 타입 초기화 전에 등록되어야 해서 PostConfigInit 모듈(CineSRTStreamShaders)에 둔다.
+ * 이 모듈은 CineSRTStream에 의존하지 않으므로 색 변환 계수는 FSRTYUVColorParams::GetCoefficients로 구해 넘긴다.
+ */
+namespace SRTYUV
+{
+    /**
+     * 렌더 스레드 - Input의 SourceRect 영역(BGRA)을 YUV 평면 텍스처(PF_R8, Width x Height*3/2)로 변환하는 컴퓨트 패스
+     * bI420이면 Y, U, V 평면, 아니면 NV12. 계수는 RGB(0~1) → 8비트 값 (R*X + G*Y + B*Z + W). SM5 미만이면 nullptr
+     */
+    CINESRTSTREAMSHADERS_API FRDGTextureRef AddConvertPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Input, const FIntRect& SourceRect,
+                                                           bool bI420, const FVector4f& YCoefficients,
+                                                           const FVector4f& UCoefficients, const FVector4f& VCoefficients);
+
+    /** 게임 스레드 - GPU 변환을 쓸 수 있는지 (셰이더 플랫폼이 SM5 이상, -nullrhi 아님) */
+    CINESRTSTREAMSHADERS_API bool IsGPUConversionSupported();
+}